@@ -0,0 +1,211 @@
+/**
+ * @file AclReset.h
+ * @brief Reset owner + DACL satu pohon direktori di bawah token Trusted Installer (/aclreset)
+ *
+ * Pengganti "takeown /R" + "icacls /reset /T" yang dijalankan lewat RasTI:
+ * - Root menerima owner dan DACL target (selalu protected, ACE eksplisit).
+ * - Setiap object di bawahnya menerima owner yang sama dan DACL yang hanya
+ *   berisi ACE turunan (ID), diturunkan dari DACL parent sesuai flag
+ *   OI/CI/NP/IO seperti yang dilakukan Windows saat object dibuat.
+ *
+ * Descriptor turunan hanya bergantung pada descriptor parent dan jenis
+ * object (file/direktori), sehingga seluruh pohon biasanya memakai 3-4
+ * descriptor berbeda. Descriptor di-intern: setiap descriptor unik disusun
+ * dan dikompilasi (BuildSecurityDescriptor) sekali, lalu dipakai ulang
+ * oleh semua worker. Object yang owner dan DACL-nya sudah sama dilewati
+ * tanpa menulis.
+ *
+ * Walk dan penerapan berjalan dalam satu pass paralel (work stealing).
+ * Direktori yang belum selesai diproses disimpan berkala ke file checkpoint;
+ * run berikutnya dengan root, SDDL, dan checkpoint yang sama melanjutkan
+ * dari direktori tersebut tanpa memindai ulang bagian yang sudah selesai.
+ *
+ * Header ini portable (tidak bergantung pada Windows.h maupun VCL).
+ *
+ * @author RasTI Development Team
+ * @version 1.2.0.0
+ * @date 2025
+ */
+
+#ifndef RASTI_ACL_RESET_H
+#define RASTI_ACL_RESET_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "Backend.h"
+
+//==============================================================================
+// CONSTANTS
+//==============================================================================
+
+/** @brief Flag ACE (nilai sama dengan winnt.h) */
+const uint8_t ACL_ACE_OBJECT_INHERIT = 0x01;     /**< OI: diturunkan ke file */
+const uint8_t ACL_ACE_CONTAINER_INHERIT = 0x02;  /**< CI: diturunkan ke direktori */
+const uint8_t ACL_ACE_NO_PROPAGATE = 0x04;       /**< NP: hanya ke child langsung */
+const uint8_t ACL_ACE_INHERIT_ONLY = 0x08;       /**< IO: tidak berlaku untuk object ini */
+const uint8_t ACL_ACE_INHERITED = 0x10;          /**< ID: hasil pewarisan */
+
+/** @brief Ukuran maksimum file checkpoint */
+const uint32_t ACLRESET_MAX_CHECKPOINT_SIZE = 256 * 1024 * 1024;
+
+/** @brief Interval default penulisan checkpoint (detik) */
+const double ACLRESET_CHECKPOINT_SECONDS = 5.0;
+
+/** @brief Jumlah error per object yang disimpan di report (sisanya hanya dihitung) */
+const size_t ACLRESET_MAX_REPORTED_ERRORS = 1000;
+
+//==============================================================================
+// SECURITY DESCRIPTOR MODEL
+//==============================================================================
+
+/**
+ * @brief Satu ACE allow/deny dari SDDL
+ */
+struct AclEntry {
+    bool deny = false;        /**< D (deny) atau A (allow) */
+    uint8_t flags = 0;        /**< Kombinasi ACL_ACE_* */
+    uint32_t mask = 0;        /**< Access mask numerik (alias SDDL seperti "FA" sudah dipetakan) */
+    std::wstring sid;         /**< SID atau alias SDDL ("SY", "BA", "S-1-5-...") */
+
+    bool operator==(const AclEntry& other) const {
+        return deny == other.deny && flags == other.flags && mask == other.mask && sid == other.sid;
+    }
+};
+
+/**
+ * @brief Owner + DACL yang sudah di-parse dari SDDL
+ */
+struct AclTemplate {
+    std::wstring owner;
+    bool isProtected = false;  /**< "D:P": tidak mewarisi dari parent */
+    std::vector<AclEntry> entries;
+};
+
+/**
+ * @brief Parse SDDL owner + DACL ("O:BAD:P(A;OICI;FA;;;SY)...")
+ *
+ * Hanya bagian O: dan D: yang diterima; ACE harus bertipe A atau D tanpa
+ * object GUID maupun kondisi. Flag DACL AI/AR diterima tetapi tidak
+ * disimpan (tidak ikut dibandingkan).
+ *
+ * @param sddl SDDL sumber
+ * @param acl Output owner + DACL
+ * @return false jika SDDL tidak valid atau memakai fitur yang tidak didukung
+ */
+bool ParseAclTemplate(std::wstring_view sddl, AclTemplate& acl);
+
+/**
+ * @brief Menyusun SDDL kanonik dari AclTemplate (access mask dalam hex)
+ *
+ * DACL yang tidak protected ditandai "AI" (auto-inherited).
+ */
+std::wstring FormatAclTemplate(const AclTemplate& acl);
+
+/**
+ * @brief Menurunkan owner + DACL child dari DACL parent
+ *
+ * Mengikuti aturan pewarisan Windows: file menerima ACE OI, direktori
+ * menerima ACE CI (efektif) dan ACE OI sebagai inherit-only, NP menghentikan
+ * propagasi, dan hak generic dipetakan ke hak file pada ACE efektif (ACE
+ * yang masih diwariskan lebih jauh dipecah menjadi ACE efektif + ACE
+ * inherit-only generic).
+ *
+ * @param parent Descriptor parent
+ * @param isDirectory true jika child berupa direktori
+ * @param child Output descriptor child (tidak protected, semua ACE bertanda ID)
+ */
+void DeriveInheritedAcl(const AclTemplate& parent, bool isDirectory, AclTemplate& child);
+
+//==============================================================================
+// ENGINE
+//==============================================================================
+
+/**
+ * @brief Langkah yang gagal untuk satu object
+ */
+enum AclResetStep {
+    ACLRESET_STEP_LIST = 0,   /**< ListDirectory */
+    ACLRESET_STEP_READ,       /**< ReadSecurity */
+    ACLRESET_STEP_WRITE,      /**< WriteSecurity */
+    ACLRESET_STEP_BUILD,      /**< BuildSecurityDescriptor untuk descriptor turunan */
+    ACLRESET_STEP_CHECKPOINT  /**< Tulis/baca checkpoint */
+};
+
+/**
+ * @brief Error per object
+ */
+struct AclResetError {
+    AclResetStep step = ACLRESET_STEP_READ;
+    std::wstring path;
+    uint32_t code = 0;        /**< Kode error Win32 */
+};
+
+/**
+ * @brief Opsi engine
+ */
+struct AclResetOptions {
+    unsigned threadCount = 0;                 /**< 0 = jumlah core */
+    OsHandle token = OS_INVALID_HANDLE;       /**< Token yang di-impersonate setiap worker (invalid = tanpa) */
+    std::wstring checkpointPath;              /**< Kosong = tanpa checkpoint */
+    double checkpointSeconds = ACLRESET_CHECKPOINT_SECONDS; /**< 0 = setiap direktori selesai */
+    const std::atomic<bool>* cancel = nullptr; /**< Di-set (misalnya Ctrl+C) untuk berhenti dan menyimpan checkpoint */
+};
+
+/**
+ * @brief Statistik dan error satu run
+ */
+struct AclResetReport {
+    bool completed = false;           /**< Seluruh pohon selesai diproses (checkpoint dihapus) */
+    bool interrupted = false;         /**< Berhenti karena cancel; checkpoint berisi sisa pekerjaan */
+    bool resumed = false;             /**< Dimulai dari checkpoint */
+    uint64_t directoriesResumed = 0;  /**< Direktori tertunda yang dimuat dari checkpoint */
+    uint64_t objectsVisited = 0;
+    uint64_t objectsUpdated = 0;      /**< Owner/DACL ditulis */
+    uint64_t objectsSkipped = 0;      /**< Owner/DACL sudah sesuai */
+    uint64_t objectsFailed = 0;
+    uint64_t linksSkipped = 0;        /**< Junction/symlink (tidak disentuh maupun diikuti) */
+    uint64_t directoriesScanned = 0;
+    uint64_t descriptorsBuilt = 0;    /**< Descriptor unik yang dikompilasi */
+    uint64_t checkpointsWritten = 0;
+    uint64_t tasksStolen = 0;
+    unsigned threadCount = 0;
+    double seconds = 0.0;
+    uint64_t errorCount = 0;          /**< Semua error, termasuk yang tidak disimpan */
+    std::vector<AclResetError> errors; /**< Maksimum ACLRESET_MAX_REPORTED_ERRORS */
+
+    /** @brief Object diproses per detik */
+    double ObjectsPerSecond() const {
+        return seconds > 0.0 ? objectsVisited / seconds : 0.0;
+    }
+};
+
+/**
+ * @brief Memasang owner + DACL target ke root dan semua object di bawahnya
+ *
+ * Jika checkpointPath berisi checkpoint untuk root dan SDDL yang sama, run
+ * dilanjutkan dari direktori tertunda di checkpoint. Checkpoint untuk root
+ * atau SDDL lain ditolak (tidak ditimpa). Checkpoint dihapus setelah pohon
+ * selesai, termasuk jika ada object yang gagal (error ada di report).
+ *
+ * @param root Path absolute root (file atau direktori, bukan junction/symlink)
+ * @param sddl Owner + DACL target
+ * @param options Opsi thread, token, checkpoint, dan cancel
+ * @param report Output statistik dan error
+ * @return true jika pohon selesai tanpa object gagal
+ */
+bool RunAclReset(const std::wstring& root, const std::wstring& sddl, const AclResetOptions& options,
+                 AclResetReport& report);
+
+/** @brief Nama langkah untuk report (misalnya "write") */
+const char* GetAclResetStepName(AclResetStep step);
+
+/**
+ * @brief Ringkasan report: jumlah object, throughput, lalu satu baris per error (UTF-8)
+ */
+std::string FormatAclResetReport(const AclResetReport& report);
+
+#endif
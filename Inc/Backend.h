@@ -0,0 +1,1211 @@
+/**
+ * @file Backend.h
+ * @brief Abstraksi backend OS untuk RasTI Core Engine
+ *
+ * Semua akses filesystem yang dilakukan pipeline validasi, semua operasi
+ * proses/token yang dilakukan akuisisi Trusted Installer, serta operasi
+ * file dan registry yang dijalankan di bawah token tersebut, melewati
+ * interface di file ini. Implementasi Win32 dapat diganti dengan backend
+ * palsu (mock) di unit test untuk menghitung jumlah syscall, mensimulasikan
+ * error, dan menjalankan benchmark secara deterministik di Linux.
+ *
+ * Header ini sengaja tidak meng-include Windows.h maupun VCL agar dapat
+ * digunakan oleh kode portable.
+ *
+ * @author RasTI Development Team
+ * @version 1.2.0.0
+ * @date 2025
+ */
+
+#ifndef RASTI_BACKEND_H
+#define RASTI_BACKEND_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+//==============================================================================
+// BASIC TYPES
+//==============================================================================
+
+/** @brief Handle opaque milik backend (HANDLE di Win32, id di backend palsu) */
+typedef uintptr_t OsHandle;
+
+/** @brief Nilai handle tidak valid - backend selalu mengembalikan 0 saat gagal */
+const OsHandle OS_INVALID_HANDLE = 0;
+
+/** @brief Kode error Win32 yang dipakai kode portable (nilai sama dengan winerror.h) */
+const uint32_t OS_ERROR_FILE_NOT_FOUND = 2;      /**< ERROR_FILE_NOT_FOUND */
+const uint32_t OS_ERROR_PATH_NOT_FOUND = 3;      /**< ERROR_PATH_NOT_FOUND */
+const uint32_t OS_ERROR_ACCESS_DENIED = 5;       /**< ERROR_ACCESS_DENIED */
+const uint32_t OS_ERROR_INVALID_HANDLE = 6;      /**< ERROR_INVALID_HANDLE */
+const uint32_t OS_ERROR_NOT_ENOUGH_MEMORY = 8;   /**< ERROR_NOT_ENOUGH_MEMORY */
+const uint32_t OS_ERROR_NOT_SUPPORTED = 50;      /**< ERROR_NOT_SUPPORTED */
+const uint32_t OS_ERROR_INVALID_PARAMETER = 87;  /**< ERROR_INVALID_PARAMETER */
+const uint32_t OS_ERROR_BROKEN_PIPE = 109;       /**< ERROR_BROKEN_PIPE */
+const uint32_t OS_ERROR_DIR_NOT_EMPTY = 145;     /**< ERROR_DIR_NOT_EMPTY */
+const uint32_t OS_ERROR_ALREADY_EXISTS = 183;    /**< ERROR_ALREADY_EXISTS */
+const uint32_t OS_ERROR_WAIT_TIMEOUT = 258;      /**< WAIT_TIMEOUT */
+const uint32_t OS_ERROR_OPERATION_ABORTED = 995; /**< ERROR_OPERATION_ABORTED */
+const uint32_t OS_ERROR_KEY_DELETED = 1018;      /**< ERROR_KEY_DELETED */
+const uint32_t OS_ERROR_PRIVILEGE_NOT_HELD = 1314; /**< ERROR_PRIVILEGE_NOT_HELD */
+
+/** @brief Jumlah proses maksimum per WaitForAnyProcessExit (MAXIMUM_WAIT_OBJECTS) */
+const size_t PROCESS_WAIT_MAX_OBJECTS = 64;
+
+/** @brief ProcessLaunchRequest::sessionId: session proses pemanggil */
+const uint32_t PROCESS_SESSION_CALLER = 0xFFFFFFFF;
+
+/**
+ * @brief Identitas unik sebuah file yang didapat dari handle terbuka
+ *
+ * Kombinasi volume serial + file index mengidentifikasi file secara unik
+ * di satu mesin, terlepas dari path yang digunakan untuk membukanya.
+ */
+struct FileIdentity {
+    uint64_t volumeSerial;  /**< Serial number volume tempat file berada */
+    uint64_t fileIndex;     /**< File index (NTFS file reference number) */
+    uint64_t fileSize;      /**< Ukuran file dalam bytes */
+    uint64_t lastWriteTime; /**< Waktu modifikasi terakhir (FILETIME 100ns) */
+    bool isDirectory;       /**< true jika handle menunjuk ke direktori */
+};
+
+/**
+ * @brief Satu entry hasil enumerasi direktori
+ */
+struct DirectoryEntry {
+    std::wstring name;   /**< Nama entry (tanpa path direktori) */
+    bool isDirectory;    /**< true untuk sub-direktori */
+    bool isReparsePoint; /**< true untuk junction/symlink (tidak diikuti saat walk) */
+};
+
+//==============================================================================
+// FILESYSTEM BACKEND INTERFACE
+//==============================================================================
+
+/**
+ * @brief Interface untuk operasi filesystem yang digunakan pipeline validasi
+ *
+ * Setiap method merepresentasikan satu syscall (atau satu panggilan API Win32)
+ * sehingga backend palsu dapat menghitung biaya validasi secara akurat.
+ * Semua path menggunakan UTF-16 (std::wstring).
+ */
+class IFileSystemBackend {
+public:
+    virtual ~IFileSystemBackend() {}
+
+    /**
+     * @brief Mengkonversi path ke bentuk absolute/canonical (GetFullPathNameW)
+     * @param path Path input (relative atau absolute)
+     * @param fullPath Output path absolute
+     * @return true jika berhasil
+     */
+    virtual bool GetFullPath(const std::wstring& path, std::wstring& fullPath) = 0;
+
+    /**
+     * @brief Membuka file untuk validasi (read-only, hanya share read)
+     *
+     * Handle yang dikembalikan menolak write dan delete dari proses lain,
+     * sehingga file tidak dapat ditukar selama handle masih terbuka.
+     *
+     * @param path Path absolute ke file
+     * @return Handle file, atau OS_INVALID_HANDLE jika gagal (tidak ada/akses ditolak)
+     */
+    virtual OsHandle OpenFileForValidation(const std::wstring& path) = 0;
+
+    /**
+     * @brief Query identitas file dari handle terbuka (GetFileInformationByHandle)
+     * @param file Handle dari OpenFileForValidation
+     * @param identity Output identitas file
+     * @return true jika berhasil
+     */
+    virtual bool QueryFileIdentity(OsHandle file, FileIdentity& identity) = 0;
+
+    /**
+     * @brief Membaca data dari offset tertentu tanpa mengubah file pointer
+     * @param file Handle dari OpenFileForValidation
+     * @param offset Offset dalam bytes dari awal file
+     * @param buffer Buffer tujuan
+     * @param size Jumlah bytes yang ingin dibaca
+     * @param bytesRead Output jumlah bytes yang benar-benar terbaca
+     * @return true jika operasi read berhasil (bytesRead bisa < size di EOF)
+     */
+    virtual bool ReadFileAt(OsHandle file, uint64_t offset, void* buffer,
+                            uint32_t size, uint32_t& bytesRead) = 0;
+
+    /**
+     * @brief Memetakan sebagian file ke memory (read-only)
+     *
+     * Digunakan untuk hashing streaming tanpa copy ke buffer user-mode.
+     * View tetap valid sampai UnmapFileView dipanggil.
+     *
+     * @param file Handle dari OpenFileForValidation
+     * @param offset Offset awal (kelipatan allocation granularity, 64KB)
+     * @param size Jumlah bytes yang dipetakan (> 0, tidak melewati akhir file)
+     * @return Pointer ke view, atau nullptr jika mapping gagal
+     */
+    virtual const uint8_t* MapFileView(OsHandle file, uint64_t offset, uint32_t size) = 0;
+
+    /**
+     * @brief Melepas view dari MapFileView
+     * @param view Pointer yang dikembalikan MapFileView (nullptr diabaikan)
+     * @param size Ukuran yang diberikan saat mapping
+     */
+    virtual void UnmapFileView(const uint8_t* view, uint32_t size) = 0;
+
+    /**
+     * @brief Menutup handle file
+     * @param file Handle yang akan ditutup (OS_INVALID_HANDLE diabaikan)
+     */
+    virtual void CloseFile(OsHandle file) = 0;
+
+    /**
+     * @brief Mendaftar isi satu direktori (FindFirstFileExW/FindNextFileW)
+     *
+     * Entry "." dan ".." tidak dikembalikan.
+     *
+     * @param directory Path absolute direktori
+     * @param entries Output entry direktori (dikosongkan terlebih dahulu)
+     * @return true jika direktori dapat dibaca
+     */
+    virtual bool EnumerateDirectory(const std::wstring& directory, std::vector<DirectoryEntry>& entries) = 0;
+
+    /**
+     * @brief Membaca environment variable (GetEnvironmentVariableW)
+     * @param name Nama variable (misalnya L"PATH")
+     * @param value Output nilai variable
+     * @return true jika variable ada
+     */
+    virtual bool GetEnvironmentValue(const std::wstring& name, std::wstring& value) = 0;
+
+    /**
+     * @brief Membaca current directory proses (GetCurrentDirectoryW)
+     * @param path Output path absolute tanpa separator akhir (kecuali root)
+     * @return true jika berhasil
+     */
+    virtual bool GetCurrentDirectoryPath(std::wstring& path) = 0;
+};
+
+//==============================================================================
+// PROCESS AND TOKEN BACKEND INTERFACE
+//==============================================================================
+
+/**
+ * @brief Parameter pembuatan proses untuk IProcessBackend::CreateProcessWithToken
+ */
+struct ProcessLaunchRequest {
+    std::wstring applicationName;              /**< lpApplicationName (kosong = ambil dari command line) */
+    std::wstring commandLine;                  /**< Command line lengkap (argv[0] sudah di-quote) */
+    uint32_t creationFlags = 0;                /**< Priority class + flag CREATE_* */
+    std::wstring desktop = L"winsta0\\default"; /**< STARTUPINFOW.lpDesktop */
+    uint32_t startupFlags = 0;                 /**< STARTUPINFOW.dwFlags (STARTF_*) */
+    uint16_t showWindow = 0;                   /**< STARTUPINFOW.wShowWindow (jika STARTF_USESHOWWINDOW) */
+    uint32_t sessionId = PROCESS_SESSION_CALLER; /**< Session proses baru (hanya CreateProcessAsUser) */
+};
+
+/**
+ * @brief Pengaturan proses yang dapat diubah setelah proses dibuat
+ */
+enum ProcessSetting {
+    PROCESS_SETTING_PRIORITY_CLASS = 0, /**< SetPriorityClass (nilai *_PRIORITY_CLASS) */
+    PROCESS_SETTING_AFFINITY,           /**< SetProcessAffinityMask (bitmask CPU) */
+    PROCESS_SETTING_IO_PRIORITY,        /**< NtSetInformationProcess(ProcessIoPriority): 0 = very low, 1 = low, 2 = normal */
+    PROCESS_SETTING_MEMORY_PRIORITY     /**< SetProcessInformation(ProcessMemoryPriority): 1 = very low .. 5 = normal */
+};
+
+/**
+ * @brief Limit job object untuk IProcessBackend::CreateJob (0 = tanpa limit)
+ */
+struct ProcessJobLimits {
+    uint64_t processMemoryLimit = 0;    /**< JOB_OBJECT_LIMIT_PROCESS_MEMORY (bytes commit per proses) */
+    uint32_t activeProcessLimit = 0;    /**< JOB_OBJECT_LIMIT_ACTIVE_PROCESS (proses sekaligus di job) */
+};
+
+/**
+ * @brief Satu entri tabel proses dari IProcessBackend::EnumerateProcesses
+ */
+struct ProcessEntry {
+    uint32_t processId = 0;
+    uint32_t parentProcessId = 0;
+    std::wstring imageName;                    /**< Nama file executable tanpa direktori (szExeFile) */
+};
+
+/**
+ * @brief Satu session Remote Desktop/console dari IProcessBackend::EnumerateSessions
+ */
+struct SessionEntry {
+    uint32_t sessionId = 0;
+    bool active = false;                       /**< WTSActive: user logon dan terhubung */
+    std::wstring stationName;                  /**< Nama WinStation (misalnya "Console", "RDP-Tcp#12") */
+    std::wstring userName;                     /**< Kosong jika belum ada user logon */
+};
+
+/**
+ * @brief Interface untuk operasi proses, token, dan privilege
+ *
+ * Algoritma akuisisi token Trusted Installer dan launch (TrustedInstaller.h)
+ * hanya memanggil method di sini, sehingga urutan langkahnya dapat diuji dan
+ * di-benchmark dengan backend palsu tanpa hak administrator. Sama seperti
+ * IFileSystemBackend, setiap method = satu langkah API Win32/NT.
+ *
+ * Method yang gagal mengembalikan false/OS_INVALID_HANDLE dan menyimpan kode
+ * error yang dapat dibaca dengan GetLastErrorCode (GetLastError di Win32).
+ */
+class IProcessBackend {
+public:
+    virtual ~IProcessBackend() {}
+
+    /**
+     * @brief Mengaktifkan privilege untuk process atau thread (RtlAdjustPrivilege)
+     * @param privilege Konstanta SE_*_PRIVILEGE
+     * @param threadScope true untuk token thread (saat impersonating)
+     * @return true jika privilege aktif
+     */
+    virtual bool AdjustPrivilege(int privilege, bool threadScope) = 0;
+
+    /**
+     * @brief Mencari proses berdasarkan nama image (ToolHelp32 snapshot)
+     * @param imageName Nama file executable, case-insensitive (misalnya L"winlogon.exe")
+     * @param processId Output PID proses pertama yang cocok
+     * @return true jika ditemukan
+     */
+    virtual bool FindProcessByName(const std::wstring& imageName, uint32_t& processId) = 0;
+
+    /**
+     * @brief Semua proses yang sedang berjalan dalam satu ToolHelp32 snapshot
+     * @param processes Output tabel proses (dikosongkan dulu)
+     * @return true jika snapshot berhasil
+     */
+    virtual bool EnumerateProcesses(std::vector<ProcessEntry>& processes) = 0;
+
+    /**
+     * @brief Membuka proses lain untuk diubah pengaturannya (OpenProcess)
+     * @param processId PID target
+     * @return Handle (PROCESS_SET_INFORMATION | PROCESS_QUERY_LIMITED_INFORMATION |
+     *         SYNCHRONIZE), ditutup dengan CloseObject, atau OS_INVALID_HANDLE
+     */
+    virtual OsHandle OpenProcessHandle(uint32_t processId) = 0;
+
+    /**
+     * @brief Path lengkap executable proses (QueryFullProcessImageNameW)
+     * @param process Handle dari OpenProcessHandle
+     * @param path Output path Win32
+     * @return true jika berhasil
+     */
+    virtual bool QueryProcessImagePath(OsHandle process, std::wstring& path) = 0;
+
+    /**
+     * @brief Semua session di host ini (WTSEnumerateSessionsW + WTSQuerySessionInformationW)
+     * @param sessions Output session dengan state dan nama user (dikosongkan dulu)
+     * @return true jika enumerasi berhasil
+     */
+    virtual bool EnumerateSessions(std::vector<SessionEntry>& sessions) = 0;
+
+    /**
+     * @brief Membuka token proses lain untuk impersonation (OpenProcess + OpenProcessToken)
+     * @param processId PID target
+     * @return Token (query/duplicate/impersonate), atau OS_INVALID_HANDLE
+     */
+    virtual OsHandle OpenProcessToken(uint32_t processId) = 0;
+
+    /**
+     * @brief Token impersonation thread saat ini (OpenThreadToken, dibuka sebagai proses)
+     * @param token Output token (query/impersonate), ditutup dengan CloseObject, atau
+     *        OS_INVALID_HANDLE jika thread tidak sedang impersonating
+     * @return true jika berhasil, termasuk thread tanpa token impersonation
+     */
+    virtual bool OpenThreadToken(OsHandle& token) = 0;
+
+    /**
+     * @brief Thread saat ini memakai security context token (ImpersonateLoggedOnUser)
+     * @param token Token dari OpenProcessToken
+     * @return true jika berhasil
+     */
+    virtual bool ImpersonateToken(OsHandle token) = 0;
+
+    /** @brief Kembali ke security context proses (RevertToSelf) */
+    virtual void RevertImpersonation() = 0;
+
+    /**
+     * @brief Membuat token logon SYSTEM dengan group Trusted Installer
+     *
+     * ConvertStringSidToSid, GetTokenInformation(TokenGroups) dari token
+     * thread/proses, lalu LogonUserExExW dengan group tambahan.
+     *
+     * @param useThreadToken true jika group dibaca dari token thread (impersonating)
+     * @return Token Trusted Installer, atau OS_INVALID_HANDLE
+     */
+    virtual OsHandle LogonTrustedInstaller(bool useThreadToken) = 0;
+
+    /**
+     * @brief Membuat proses dengan token (CreateProcessWithTokenW)
+     *
+     * @param token Token untuk proses baru
+     * @param request Application name, command line, flag, dan desktop
+     * @param processId Output PID proses baru
+     * @param process Output handle proses (ditutup pemanggil dengan CloseObject),
+     *        atau NULL agar handle proses langsung ditutup; handle thread selalu ditutup
+     * @return true jika proses dibuat
+     */
+    virtual bool CreateProcessWithToken(OsHandle token, const ProcessLaunchRequest& request, uint32_t& processId,
+                                        OsHandle* process) = 0;
+
+    /**
+     * @brief Membuat proses langsung di proses ini (CreateProcessAsUserW)
+     *
+     * Tanpa RPC ke service Secondary Logon. Token diduplikasi sebagai primary
+     * token dan dipindahkan ke request.sessionId, atau ke session proses
+     * pemanggil jika PROCESS_SESSION_CALLER (SetTokenInformation
+     * TokenSessionId), lalu CreateProcessAsUserW. Pemanggil (token thread
+     * jika impersonating) harus sudah mengaktifkan SeAssignPrimaryTokenPrivilege,
+     * SeIncreaseQuotaPrivilege, dan SeTcbPrivilege. Environment dan direktori
+     * kerja diwarisi dari proses ini.
+     *
+     * @param token Token untuk proses baru (diduplikasi, tidak diubah)
+     * @param request Application name, command line, flag, dan desktop
+     * @param processId Output PID proses baru
+     * @param process Output handle proses, atau NULL (sama dengan CreateProcessWithToken)
+     * @return true jika proses dibuat
+     */
+    virtual bool CreateProcessAsUser(OsHandle token, const ProcessLaunchRequest& request, uint32_t& processId,
+                                     OsHandle* process) = 0;
+
+    /**
+     * @brief Menunggu proses selesai (WaitForSingleObject + GetExitCodeProcess)
+     *
+     * @param process Handle dari CreateProcessWithToken
+     * @param timeoutMs Batas waktu tunggu (0xFFFFFFFF = INFINITE)
+     * @param exitCode Output exit code proses
+     * @return false jika timeout (kode error OS_ERROR_WAIT_TIMEOUT) atau gagal
+     */
+    virtual bool WaitForProcessExit(OsHandle process, uint32_t timeoutMs, uint32_t& exitCode) = 0;
+
+    /**
+     * @brief Menunggu salah satu dari beberapa proses selesai (WaitForMultipleObjects + GetExitCodeProcess)
+     *
+     * @param processes Handle proses (maksimum PROCESS_WAIT_MAX_OBJECTS)
+     * @param timeoutMs Batas waktu tunggu (0xFFFFFFFF = INFINITE)
+     * @param index Output indeks proses yang selesai (yang terendah jika beberapa sudah selesai)
+     * @param exitCode Output exit code proses tersebut
+     * @return false jika timeout (kode error OS_ERROR_WAIT_TIMEOUT) atau gagal
+     */
+    virtual bool WaitForAnyProcessExit(const std::vector<OsHandle>& processes, uint32_t timeoutMs, size_t& index,
+                                       uint32_t& exitCode) = 0;
+
+    /**
+     * @brief Menjalankan semua thread proses yang dibuat dengan CREATE_SUSPENDED (NtResumeProcess)
+     * @param process Handle dari CreateProcessWithToken/CreateProcessAsUser
+     * @return true jika berhasil
+     */
+    virtual bool ResumeProcess(OsHandle process) = 0;
+
+    /**
+     * @brief Menghentikan proses (TerminateProcess)
+     * @param process Handle proses
+     * @param exitCode Exit code proses yang dihentikan
+     * @return true jika berhasil
+     */
+    virtual bool TerminateProcess(OsHandle process, uint32_t exitCode) = 0;
+
+    /**
+     * @brief Mengubah satu pengaturan proses (lihat ProcessSetting)
+     * @param process Handle proses (PROCESS_SET_INFORMATION)
+     * @param setting Pengaturan yang diubah
+     * @param value Nilai baru
+     * @return true jika berhasil
+     */
+    virtual bool SetProcessSetting(OsHandle process, ProcessSetting setting, uint64_t value) = 0;
+
+    /**
+     * @brief Membuat job object anonim dengan limit (CreateJobObjectW + SetInformationJobObject)
+     * @param limits Limit job (semua 0 = job tanpa limit)
+     * @return Handle job (ditutup dengan CloseObject), atau OS_INVALID_HANDLE
+     *
+     * @note Job tidak memakai KILL_ON_JOB_CLOSE: proses tetap berjalan setelah handle ditutup
+     */
+    virtual OsHandle CreateJob(const ProcessJobLimits& limits) = 0;
+
+    /**
+     * @brief Memasukkan proses ke job (AssignProcessToJobObject)
+     * @param job Handle dari CreateJob
+     * @param process Handle proses
+     * @return true jika berhasil
+     */
+    virtual bool AssignProcessToJob(OsHandle job, OsHandle process) = 0;
+
+    /**
+     * @brief Mengecek privilege enabled di token proses (GetTokenInformation(TokenPrivileges))
+     * @param privilege Konstanta SE_*_PRIVILEGE
+     * @return true jika privilege ada dan enabled
+     */
+    virtual bool IsPrivilegeEnabled(int privilege) = 0;
+
+    /**
+     * @brief Mengecek member Administrators dengan token elevated (UAC)
+     * @return true jika kedua syarat terpenuhi
+     */
+    virtual bool IsElevatedAdministrator() = 0;
+
+    /**
+     * @brief Path executable proses saat ini (GetModuleFileNameW)
+     * @param path Output path lengkap
+     * @return true jika berhasil
+     */
+    virtual bool GetModuleFilePath(std::wstring& path) = 0;
+
+    /**
+     * @brief Menutup handle token/proses milik backend (CloseHandle)
+     * @param handle Handle yang akan ditutup (OS_INVALID_HANDLE diabaikan)
+     */
+    virtual void CloseObject(OsHandle handle) = 0;
+
+    /** @brief Kode error operasi terakhir di thread ini (GetLastError) */
+    virtual uint32_t GetLastErrorCode() = 0;
+
+    /** @brief Mengeset kode error thread ini (SetLastError) */
+    virtual void SetLastErrorCode(uint32_t error) = 0;
+};
+
+//==============================================================================
+// FILE OPERATION BACKEND INTERFACE
+//==============================================================================
+
+/**
+ * @brief Satu entry hasil enumerasi untuk operasi file massal (/fileops)
+ */
+struct FileOperationEntry {
+    std::wstring name;        /**< Nama entry (tanpa path direktori); kosong dari QueryPath */
+    bool isDirectory;         /**< true untuk direktori (termasuk junction) */
+    bool isReparsePoint;      /**< true untuk junction/symlink (tidak diikuti saat walk) */
+    uint64_t size;            /**< Ukuran file dalam bytes (0 untuk direktori) */
+};
+
+/**
+ * @brief Interface untuk operasi yang mengubah filesystem (copy, move, delete)
+ *
+ * Dipisahkan dari IFileSystemBackend yang hanya membaca: pipeline validasi
+ * tidak pernah menulis ke disk. Engine /fileops (FileOperations.h) memanggil
+ * method di sini dari beberapa thread sekaligus, masing-masing di bawah
+ * impersonation token Trusted Installer, sehingga implementasi harus
+ * thread-safe dan GetLastErrorCode harus per thread.
+ *
+ * Method yang gagal mengembalikan false dan menyimpan kode error Win32.
+ */
+class IFileOperationBackend {
+public:
+    virtual ~IFileOperationBackend() {}
+
+    /**
+     * @brief Mendaftar isi satu direktori beserta ukuran file (FindFirstFileExW/FindNextFileW)
+     *
+     * Entry "." dan ".." tidak dikembalikan.
+     *
+     * @param directory Path absolute direktori
+     * @param entries Output entry direktori (dikosongkan terlebih dahulu)
+     * @return true jika direktori dapat dibaca
+     */
+    virtual bool ListDirectory(const std::wstring& directory, std::vector<FileOperationEntry>& entries) = 0;
+
+    /**
+     * @brief Membaca tipe dan ukuran satu path (GetFileAttributesExW)
+     * @param path Path absolute
+     * @param entry Output atribut (name dikosongkan)
+     * @return false jika path tidak ada atau tidak dapat dibaca
+     */
+    virtual bool QueryPath(const std::wstring& path, FileOperationEntry& entry) = 0;
+
+    /**
+     * @brief Membuat satu direktori (CreateDirectoryW)
+     *
+     * Direktori parent harus sudah ada. Direktori yang sudah ada dianggap berhasil.
+     *
+     * @param path Path absolute direktori baru
+     * @return true jika direktori ada setelah pemanggilan
+     */
+    virtual bool MakeDirectory(const std::wstring& path) = 0;
+
+    /**
+     * @brief Menyalin isi dan atribut satu file (CopyFileExW), menimpa tujuan
+     *
+     * @param source File sumber
+     * @param destination File tujuan (file read-only ditimpa)
+     * @param unbuffered true untuk file besar: COPY_FILE_NO_BUFFERING (I/O
+     *        unbuffered tanpa mengisi cache sistem)
+     * @return true jika file tersalin
+     */
+    virtual bool CopyFileContents(const std::wstring& source, const std::wstring& destination, bool unbuffered) = 0;
+
+    /**
+     * @brief Memindahkan/rename file atau direktori (MoveFileExW), menimpa file tujuan
+     *
+     * File boleh berpindah volume (copy + delete oleh OS); direktori hanya
+     * dalam volume yang sama.
+     *
+     * @param source Path sumber
+     * @param destination Path tujuan
+     * @return true jika berhasil
+     */
+    virtual bool MovePath(const std::wstring& source, const std::wstring& destination) = 0;
+
+    /**
+     * @brief Menghapus file (DeleteFileW) atau direktori kosong/junction (RemoveDirectoryW)
+     *
+     * Atribut read-only dilepas jika menghalangi penghapusan.
+     *
+     * @param path Path absolute
+     * @param isDirectory true untuk RemoveDirectoryW
+     * @return true jika terhapus
+     */
+    virtual bool DeletePath(const std::wstring& path, bool isDirectory) = 0;
+
+    /**
+     * @brief Mengompilasi SDDL owner + DACL menjadi security descriptor self-relative
+     *
+     * (ConvertStringSecurityDescriptorToSecurityDescriptorW, lalu dikonversi
+     * balik agar alias SID dan hak akses memakai format yang sama dengan
+     * ReadSecurity.)
+     *
+     * @param sddl SDDL sumber ("O:...D:...")
+     * @param descriptor Output security descriptor untuk WriteSecurity
+     * @param normalized Output SDDL hasil konversi balik (owner + DACL)
+     * @return false jika SDDL tidak valid
+     */
+    virtual bool BuildSecurityDescriptor(const std::wstring& sddl, std::vector<uint8_t>& descriptor,
+                                         std::wstring& normalized) = 0;
+
+    /**
+     * @brief Membaca owner + DACL satu path sebagai SDDL (GetFileSecurityW)
+     * @param path Path absolute
+     * @param sddl Output SDDL owner + DACL
+     * @return false jika security descriptor tidak dapat dibaca
+     */
+    virtual bool ReadSecurity(const std::wstring& path, std::wstring& sddl) = 0;
+
+    /**
+     * @brief Memasang owner + DACL dari BuildSecurityDescriptor ke satu path (SetFileSecurityW)
+     *
+     * Tidak mempropagasi ACE ke child: pemanggil memasang descriptor setiap
+     * object secara eksplisit.
+     *
+     * @param path Path absolute
+     * @param descriptor Security descriptor self-relative
+     * @return true jika terpasang
+     */
+    virtual bool WriteSecurity(const std::wstring& path, const std::vector<uint8_t>& descriptor) = 0;
+
+    /**
+     * @brief Membaca seluruh isi file kecil (checkpoint)
+     * @param path Path absolute
+     * @param maxSize Ukuran maksimum yang diterima
+     * @param contents Output isi file
+     * @return false jika file tidak ada, melebihi maxSize, atau tidak terbaca penuh
+     */
+    virtual bool ReadFileContents(const std::wstring& path, uint32_t maxSize, std::string& contents) = 0;
+
+    /**
+     * @brief Menulis seluruh isi file (CREATE_ALWAYS + FlushFileBuffers)
+     * @param path Path absolute
+     * @param contents Isi file baru
+     * @return true jika seluruh isi tertulis ke disk
+     */
+    virtual bool WriteFileContents(const std::wstring& path, const std::string& contents) = 0;
+
+    /** @brief Kode error operasi terakhir di thread ini (GetLastError) */
+    virtual uint32_t GetLastErrorCode() = 0;
+};
+
+//==============================================================================
+// REGISTRY BACKEND INTERFACE
+//==============================================================================
+
+/**
+ * @brief Root key registry (predefined HKEY)
+ */
+enum RegistryRoot {
+    REGISTRY_ROOT_CLASSES_ROOT = 0, /**< HKEY_CLASSES_ROOT */
+    REGISTRY_ROOT_CURRENT_USER,     /**< HKEY_CURRENT_USER milik token thread (RegOpenCurrentUser) */
+    REGISTRY_ROOT_LOCAL_MACHINE,    /**< HKEY_LOCAL_MACHINE */
+    REGISTRY_ROOT_USERS,            /**< HKEY_USERS */
+    REGISTRY_ROOT_CURRENT_CONFIG    /**< HKEY_CURRENT_CONFIG */
+};
+
+/**
+ * @brief Interface untuk membaca dan mengubah registry (/regimport)
+ *
+ * Path key relative terhadap root, komponen dipisah '\' (kosong = root).
+ * Key selalu dibuka di view registry 64-bit (KEY_WOW64_64KEY) agar hasilnya
+ * sama dengan regedit.exe, termasuk dari build RasTI 32-bit. Engine
+ * memanggil backend dari satu worker thread yang meng-impersonate token
+ * Trusted Installer.
+ *
+ * Method yang gagal mengembalikan false/OS_INVALID_HANDLE dan menyimpan kode
+ * error Win32 (key/value yang tidak ada = OS_ERROR_FILE_NOT_FOUND).
+ */
+class IRegistryBackend {
+public:
+    virtual ~IRegistryBackend() {}
+
+    /**
+     * @brief Membuka key yang sudah ada (RegOpenKeyExW)
+     * @param root Root key
+     * @param path Path key di bawah root
+     * @param writable true untuk KEY_QUERY_VALUE | KEY_SET_VALUE, false untuk KEY_QUERY_VALUE
+     * @return Handle key (ditutup dengan CloseKey), atau OS_INVALID_HANDLE
+     */
+    virtual OsHandle OpenKey(RegistryRoot root, const std::wstring& path, bool writable) = 0;
+
+    /**
+     * @brief Membuka key untuk ditulis, membuat key dan parent-nya jika belum ada (RegCreateKeyExW)
+     * @param root Root key
+     * @param path Path key di bawah root
+     * @param created Output true jika key baru dibuat
+     * @return Handle key (ditutup dengan CloseKey), atau OS_INVALID_HANDLE
+     */
+    virtual OsHandle CreateKey(RegistryRoot root, const std::wstring& path, bool& created) = 0;
+
+    /**
+     * @brief Membaca tipe dan data satu value (RegQueryValueExW)
+     * @param key Handle dari OpenKey/CreateKey
+     * @param name Nama value (kosong = value default)
+     * @param type Output tipe REG_*
+     * @param data Output data mentah
+     * @return false jika value tidak ada atau tidak terbaca
+     */
+    virtual bool QueryValue(OsHandle key, const std::wstring& name, uint32_t& type, std::vector<uint8_t>& data) = 0;
+
+    /**
+     * @brief Menulis satu value (RegSetValueExW)
+     * @param key Handle writable
+     * @param name Nama value (kosong = value default)
+     * @param type Tipe REG_*
+     * @param data Data mentah (string sudah UTF-16LE dengan terminator)
+     * @return true jika tertulis
+     */
+    virtual bool SetValue(OsHandle key, const std::wstring& name, uint32_t type, const std::vector<uint8_t>& data) = 0;
+
+    /**
+     * @brief Menghapus satu value (RegDeleteValueW)
+     * @param key Handle writable
+     * @param name Nama value (kosong = value default)
+     * @return true jika terhapus
+     */
+    virtual bool DeleteValue(OsHandle key, const std::wstring& name) = 0;
+
+    /**
+     * @brief Menghapus key beserta semua subkey dan value-nya (RegDeleteTreeW + RegDeleteKeyExW)
+     * @param root Root key
+     * @param path Path key di bawah root (tidak kosong)
+     * @return true jika key terhapus
+     */
+    virtual bool DeleteKeyTree(RegistryRoot root, const std::wstring& path) = 0;
+
+    /**
+     * @brief Menutup handle key (RegCloseKey)
+     * @param key Handle yang akan ditutup (OS_INVALID_HANDLE diabaikan)
+     */
+    virtual void CloseKey(OsHandle key) = 0;
+
+    /** @brief Kode error operasi terakhir di thread ini */
+    virtual uint32_t GetLastErrorCode() = 0;
+};
+
+//==============================================================================
+// SCRIPT HOST BACKEND INTERFACE
+//==============================================================================
+
+/**
+ * @brief Interface untuk proses interpreter dengan stdin/stdout pipe (/scripthost)
+ *
+ * Satu host = satu proses cmd.exe/powershell.exe yang dibuat dengan token
+ * Trusted Installer; command ditulis ke stdin-nya, stdout dan stderr
+ * digabung ke satu pipe yang dibaca engine. Engine memanggil backend dari
+ * satu thread.
+ *
+ * Method yang gagal mengembalikan false/OS_INVALID_HANDLE dan menyimpan kode
+ * error Win32 (pipe ditutup host = OS_ERROR_BROKEN_PIPE).
+ */
+class IScriptHostBackend {
+public:
+    virtual ~IScriptHostBackend() {}
+
+    /**
+     * @brief Membuat proses host dengan stdin/stdout/stderr pipe (CreatePipe + CreateProcessWithTokenW)
+     * @param token Token untuk proses host
+     * @param request Application name, command line, dan flag (CREATE_NO_WINDOW ditambahkan backend)
+     * @return Handle host (ditutup dengan CloseHost), atau OS_INVALID_HANDLE
+     */
+    virtual OsHandle StartHost(OsHandle token, const ProcessLaunchRequest& request) = 0;
+
+    /**
+     * @brief Menulis ke stdin host (WriteFile)
+     * @param host Handle dari StartHost
+     * @param data Bytes yang ditulis seluruhnya
+     * @return false jika host sudah menutup stdin-nya
+     */
+    virtual bool WriteHostInput(OsHandle host, const std::string& data) = 0;
+
+    /**
+     * @brief Membaca output host yang tersedia (ReadFile overlapped + wait)
+     * @param host Handle dari StartHost
+     * @param timeoutMs Batas waktu tunggu jika belum ada output (0xFFFFFFFF = INFINITE)
+     * @param data Output ditambahkan di akhir (tidak dikosongkan)
+     * @return false jika timeout (OS_ERROR_WAIT_TIMEOUT), host menutup pipe
+     *         (OS_ERROR_BROKEN_PIPE), atau gagal
+     */
+    virtual bool ReadHostOutput(OsHandle host, uint32_t timeoutMs, std::string& data) = 0;
+
+    /**
+     * @brief Menunggu proses host selesai (WaitForSingleObject + GetExitCodeProcess)
+     * @param host Handle dari StartHost
+     * @param timeoutMs Batas waktu tunggu
+     * @param exitCode Output exit code host
+     * @return false jika timeout (OS_ERROR_WAIT_TIMEOUT) atau gagal
+     */
+    virtual bool WaitHostExit(OsHandle host, uint32_t timeoutMs, uint32_t& exitCode) = 0;
+
+    /**
+     * @brief Menutup pipe dan handle host; host yang masih berjalan di-terminate
+     * @param host Handle dari StartHost (OS_INVALID_HANDLE diabaikan)
+     */
+    virtual void CloseHost(OsHandle host) = 0;
+
+    /** @brief Kode error operasi terakhir di thread ini */
+    virtual uint32_t GetLastErrorCode() = 0;
+};
+
+//==============================================================================
+// OUTPUT CAPTURE BACKEND INTERFACE
+//==============================================================================
+
+/**
+ * @brief Stream output proses yang di-capture
+ */
+enum CaptureStream {
+    CAPTURE_STREAM_STDOUT = 0,
+    CAPTURE_STREAM_STDERR = 1
+};
+
+/**
+ * @brief Jenis event dari IOutputCaptureBackend::WaitCaptureEvent
+ */
+enum CaptureEventType {
+    CAPTURE_EVENT_OUTPUT = 0,     /**< Data baru di satu stream */
+    CAPTURE_EVENT_END_OF_STREAM,  /**< Semua penulis stream menutup pipe */
+    CAPTURE_EVENT_EXITED          /**< Proses utama keluar (notifikasi job) */
+};
+
+/**
+ * @brief Satu event dari completion port capture
+ */
+struct CaptureEvent {
+    CaptureEventType type = CAPTURE_EVENT_OUTPUT;
+    OsHandle process = OS_INVALID_HANDLE;     /**< Handle dari StartCapturedProcess */
+    CaptureStream stream = CAPTURE_STREAM_STDOUT;
+    const char* data = nullptr;               /**< OUTPUT: buffer milik backend, valid sampai WaitCaptureEvent berikutnya */
+    size_t size = 0;
+};
+
+/**
+ * @brief Pemakaian resource proses yang di-capture beserta semua turunannya (job accounting)
+ */
+struct ProcessAccounting {
+    uint64_t userMicroseconds = 0;            /**< Total CPU user mode semua proses di job */
+    uint64_t kernelMicroseconds = 0;          /**< Total CPU kernel mode semua proses di job */
+    uint64_t peakMemoryBytes = 0;             /**< Peak committed memory job (semua proses sekaligus) */
+    uint64_t readBytes = 0;                   /**< I/O read (file, pipe, device) */
+    uint64_t writeBytes = 0;                  /**< I/O write */
+    uint64_t otherBytes = 0;                  /**< I/O selain read/write (misalnya DeviceIoControl) */
+    uint32_t processCount = 0;                /**< Proses utama + semua turunan yang pernah ada di job */
+};
+
+/**
+ * @brief Interface untuk proses dengan stdout/stderr pipe yang dibaca satu pump (/capture, /batch)
+ *
+ * Semua pipe dan job object proses yang dibuat dengan port yang sama
+ * dilayani satu WaitCaptureEvent (I/O completion port di Win32), sehingga
+ * ratusan proses paralel tidak memerlukan thread per pipe. Data output
+ * diberikan langsung dari buffer read backend tanpa salinan. Log file
+ * (CreateLogFile dan seterusnya) ditulis dari thread pump yang sama.
+ * Satu port hanya dipakai satu thread.
+ *
+ * Method yang gagal mengembalikan false/OS_INVALID_HANDLE dan menyimpan kode
+ * error Win32 (timeout = OS_ERROR_WAIT_TIMEOUT).
+ */
+class IOutputCaptureBackend {
+public:
+    virtual ~IOutputCaptureBackend() {}
+
+    /**
+     * @brief Membuat completion port untuk satu run capture (CreateIoCompletionPort)
+     * @return Handle port (ditutup dengan CloseCapturePort), atau OS_INVALID_HANDLE
+     */
+    virtual OsHandle CreateCapturePort() = 0;
+
+    /**
+     * @brief Membuat proses dengan stdout/stderr pipe terhubung ke port (CreateProcessWithTokenW)
+     *
+     * Flag console dan STARTF_* di request berlaku seperti
+     * CreateProcessWithToken (lihat ApplyConsoleMode); handle standar selalu
+     * diganti pipe dan stdin proses adalah NUL. Read pertama kedua stream
+     * langsung di-issue.
+     *
+     * @param port Handle dari CreateCapturePort
+     * @param token Token untuk proses baru
+     * @param request Application name, command line, dan priority class
+     * @param processId Output PID proses baru
+     * @return Handle proses (ditutup dengan CloseCapturedProcess), atau OS_INVALID_HANDLE
+     */
+    virtual OsHandle StartCapturedProcess(OsHandle port, OsHandle token, const ProcessLaunchRequest& request,
+                                          uint32_t& processId) = 0;
+
+    /**
+     * @brief Menunggu event berikutnya dari proses mana pun di port (GetQueuedCompletionStatus)
+     *
+     * Buffer event OUTPUT sebelumnya dikembalikan ke stream-nya (read
+     * berikutnya di-issue) di awal pemanggilan ini.
+     *
+     * @param port Handle dari CreateCapturePort
+     * @param timeoutMs Batas waktu tunggu (0xFFFFFFFF = INFINITE)
+     * @param event Output event
+     * @return false jika timeout (OS_ERROR_WAIT_TIMEOUT) atau gagal
+     */
+    virtual bool WaitCaptureEvent(OsHandle port, uint32_t timeoutMs, CaptureEvent& event) = 0;
+
+    /**
+     * @brief Membaca exit code tanpa menunggu (GetExitCodeProcess)
+     * @param process Handle dari StartCapturedProcess
+     * @param exitCode Output exit code
+     * @return false jika proses masih berjalan (OS_ERROR_WAIT_TIMEOUT) atau gagal
+     */
+    virtual bool QueryCapturedExit(OsHandle process, uint32_t& exitCode) = 0;
+
+    /**
+     * @brief Membaca accounting job proses tanpa menunggu (QueryInformationJobObject)
+     *
+     * Satu panggilan per proses cukup: job mengakumulasi angka semua proses
+     * di dalamnya, termasuk turunan yang sudah keluar. Panggil sebelum
+     * CloseCapturedProcess.
+     *
+     * @param process Handle dari StartCapturedProcess
+     * @param accounting Output pemakaian resource sejauh ini
+     * @return false jika proses tidak berada di job atau query gagal
+     */
+    virtual bool QueryCapturedAccounting(OsHandle process, ProcessAccounting& accounting) = 0;
+
+    /**
+     * @brief Menutup pipe dan handle proses; proses yang masih berjalan di-terminate beserta turunannya
+     * @param process Handle dari StartCapturedProcess (OS_INVALID_HANDLE diabaikan)
+     */
+    virtual void CloseCapturedProcess(OsHandle process) = 0;
+
+    /**
+     * @brief Menutup port; read yang masih pending dibatalkan dan ditunggu
+     * @param port Handle dari CreateCapturePort (OS_INVALID_HANDLE diabaikan)
+     */
+    virtual void CloseCapturePort(OsHandle port) = 0;
+
+    /**
+     * @brief Membuat log file baru, menimpa file lama (CreateFileW CREATE_ALWAYS)
+     * @param path Path absolute
+     * @return Handle file, atau OS_INVALID_HANDLE
+     */
+    virtual OsHandle CreateLogFile(const std::wstring& path) = 0;
+
+    /**
+     * @brief Menulis seluruh data di akhir log file (WriteFile)
+     * @param file Handle dari CreateLogFile
+     * @param data Bytes yang ditulis
+     * @param size Jumlah bytes
+     * @return true jika semua bytes tertulis
+     */
+    virtual bool WriteLogFile(OsHandle file, const char* data, size_t size) = 0;
+
+    /** @brief Menutup log file (OS_INVALID_HANDLE diabaikan) */
+    virtual void CloseLogFile(OsHandle file) = 0;
+
+    /**
+     * @brief Rename log file untuk rotasi, menimpa tujuan (MoveFileExW)
+     * @return false jika gagal (source tidak ada = OS_ERROR_FILE_NOT_FOUND)
+     */
+    virtual bool RenameLogFile(const std::wstring& source, const std::wstring& destination) = 0;
+
+    /** @brief Kode error operasi terakhir di thread ini */
+    virtual uint32_t GetLastErrorCode() = 0;
+};
+
+//==============================================================================
+// BACKEND SELECTION
+//==============================================================================
+
+/**
+ * @brief Mendapatkan backend filesystem yang aktif
+ *
+ * @return Backend yang di-set melalui SetFileSystemBackend, atau backend default
+ *         platform (Win32) jika belum ada override
+ */
+IFileSystemBackend* GetFileSystemBackend();
+
+/**
+ * @brief Mengganti backend filesystem yang aktif
+ *
+ * @param backend Backend baru, atau NULL untuk kembali ke backend default
+ *
+ * @note Digunakan oleh unit test untuk memasang backend palsu. Pemanggil tetap
+ *       memiliki object backend dan harus menjaganya tetap hidup selama terpasang.
+ */
+void SetFileSystemBackend(IFileSystemBackend* backend);
+
+/**
+ * @brief Backend filesystem default untuk platform saat ini
+ *
+ * @note Diimplementasikan di BackendWin32.cpp (Windows) atau
+ *       BackendUnsupported.cpp (build portable)
+ */
+IFileSystemBackend* GetDefaultFileSystemBackend();
+
+/**
+ * @brief Mendapatkan backend proses/token yang aktif
+ *
+ * @return Backend yang di-set melalui SetProcessBackend, atau backend default
+ *         platform jika belum ada override
+ */
+IProcessBackend* GetProcessBackend();
+
+/**
+ * @brief Mengganti backend proses/token yang aktif
+ *
+ * @param backend Backend baru, atau NULL untuk kembali ke backend default
+ *
+ * @note Aturan kepemilikan sama dengan SetFileSystemBackend
+ */
+void SetProcessBackend(IProcessBackend* backend);
+
+/**
+ * @brief Backend proses/token default untuk platform saat ini
+ *
+ * @note Diimplementasikan di BackendWin32.cpp (Windows) atau
+ *       BackendUnsupported.cpp (build portable)
+ */
+IProcessBackend* GetDefaultProcessBackend();
+
+/**
+ * @brief Mendapatkan backend operasi file yang aktif
+ *
+ * @return Backend yang di-set melalui SetFileOperationBackend, atau backend
+ *         default platform jika belum ada override
+ */
+IFileOperationBackend* GetFileOperationBackend();
+
+/**
+ * @brief Mengganti backend operasi file yang aktif
+ *
+ * @param backend Backend baru, atau NULL untuk kembali ke backend default
+ *
+ * @note Aturan kepemilikan sama dengan SetFileSystemBackend
+ */
+void SetFileOperationBackend(IFileOperationBackend* backend);
+
+/**
+ * @brief Backend operasi file default untuk platform saat ini
+ *
+ * @note Diimplementasikan di BackendWin32.cpp (Windows) atau
+ *       BackendUnsupported.cpp (build portable)
+ */
+IFileOperationBackend* GetDefaultFileOperationBackend();
+
+/**
+ * @brief Mendapatkan backend registry yang aktif
+ *
+ * @return Backend yang di-set melalui SetRegistryBackend, atau backend
+ *         default platform jika belum ada override
+ */
+IRegistryBackend* GetRegistryBackend();
+
+/**
+ * @brief Mengganti backend registry yang aktif
+ *
+ * @param backend Backend baru, atau NULL untuk kembali ke backend default
+ *
+ * @note Aturan kepemilikan sama dengan SetFileSystemBackend
+ */
+void SetRegistryBackend(IRegistryBackend* backend);
+
+/**
+ * @brief Backend registry default untuk platform saat ini
+ *
+ * @note Diimplementasikan di BackendWin32.cpp (Windows) atau
+ *       BackendUnsupported.cpp (build portable)
+ */
+IRegistryBackend* GetDefaultRegistryBackend();
+
+/**
+ * @brief Mendapatkan backend script host yang aktif
+ *
+ * @return Backend yang di-set melalui SetScriptHostBackend, atau backend
+ *         default platform jika belum ada override
+ */
+IScriptHostBackend* GetScriptHostBackend();
+
+/**
+ * @brief Mengganti backend script host yang aktif
+ *
+ * @param backend Backend baru, atau NULL untuk kembali ke backend default
+ *
+ * @note Aturan kepemilikan sama dengan SetFileSystemBackend
+ */
+void SetScriptHostBackend(IScriptHostBackend* backend);
+
+/**
+ * @brief Backend script host default untuk platform saat ini
+ *
+ * @note Diimplementasikan di BackendWin32.cpp (Windows) atau
+ *       BackendUnsupported.cpp (build portable)
+ */
+IScriptHostBackend* GetDefaultScriptHostBackend();
+
+/**
+ * @brief Mendapatkan backend capture output yang aktif
+ *
+ * @return Backend yang di-set melalui SetOutputCaptureBackend, atau backend
+ *         default platform jika belum ada override
+ */
+IOutputCaptureBackend* GetOutputCaptureBackend();
+
+/**
+ * @brief Mengganti backend capture output yang aktif
+ *
+ * @param backend Backend baru, atau NULL untuk kembali ke backend default
+ *
+ * @note Aturan kepemilikan sama dengan SetFileSystemBackend
+ */
+void SetOutputCaptureBackend(IOutputCaptureBackend* backend);
+
+/**
+ * @brief Backend capture output default untuk platform saat ini
+ *
+ * @note Diimplementasikan di BackendWin32.cpp (Windows) atau
+ *       BackendUnsupported.cpp (build portable)
+ */
+IOutputCaptureBackend* GetDefaultOutputCaptureBackend();
+
+//==============================================================================
+// RAII WRAPPER
+//==============================================================================
+
+/**
+ * @brief RAII wrapper untuk handle file milik backend
+ *
+ * Mirip SmartHandle, tetapi menutup handle melalui backend yang membukanya
+ * sehingga bekerja untuk backend Win32 maupun backend palsu.
+ */
+class ScopedBackendFile {
+private:
+    IFileSystemBackend* backend_;
+    OsHandle handle_;
+
+public:
+    /** @brief Default constructor dengan handle invalid */
+    ScopedBackendFile() : backend_(nullptr), handle_(OS_INVALID_HANDLE) {}
+
+    /** @brief Constructor dengan handle yang sudah dibuka oleh backend */
+    ScopedBackendFile(IFileSystemBackend* backend, OsHandle handle)
+        : backend_(backend), handle_(handle) {}
+
+    /** @brief Move constructor */
+    ScopedBackendFile(ScopedBackendFile&& other) noexcept
+        : backend_(other.backend_), handle_(other.handle_) {
+        other.handle_ = OS_INVALID_HANDLE;
+    }
+
+    /** @brief Move assignment operator */
+    ScopedBackendFile& operator=(ScopedBackendFile&& other) noexcept {
+        if (this != &other) {
+            Reset();
+            backend_ = other.backend_;
+            handle_ = other.handle_;
+            other.handle_ = OS_INVALID_HANDLE;
+        }
+        return *this;
+    }
+
+    /** @brief Destructor - automatic cleanup */
+    ~ScopedBackendFile() { Reset(); }
+
+    /** @brief Check if handle is valid */
+    bool IsValid() const { return handle_ != OS_INVALID_HANDLE; }
+
+    /** @brief Get raw handle (use carefully) */
+    OsHandle Get() const { return handle_; }
+
+    /** @brief Tutup handle (jika ada) */
+    void Reset() {
+        if (IsValid() && backend_) {
+            backend_->CloseFile(handle_);
+        }
+        handle_ = OS_INVALID_HANDLE;
+    }
+
+    // Prevent copying for safety
+    ScopedBackendFile(const ScopedBackendFile&) = delete;
+    ScopedBackendFile& operator=(const ScopedBackendFile&) = delete;
+};
+
+/**
+ * @brief RAII wrapper untuk handle token/proses milik IProcessBackend
+ */
+class ScopedBackendObject {
+private:
+    IProcessBackend* backend_;
+    OsHandle handle_;
+
+public:
+    /** @brief Constructor dengan handle yang sudah dibuka oleh backend */
+    ScopedBackendObject(IProcessBackend* backend, OsHandle handle)
+        : backend_(backend), handle_(handle) {}
+
+    /** @brief Destructor - automatic cleanup */
+    ~ScopedBackendObject() { Reset(); }
+
+    /** @brief Check if handle is valid */
+    bool IsValid() const { return handle_ != OS_INVALID_HANDLE; }
+
+    /** @brief Get raw handle (use carefully) */
+    OsHandle Get() const { return handle_; }
+
+    /** @brief Release ownership tanpa cleanup */
+    OsHandle Release() {
+        OsHandle temp = handle_;
+        handle_ = OS_INVALID_HANDLE;
+        return temp;
+    }
+
+    /** @brief Tutup handle (jika ada) */
+    void Reset() {
+        if (IsValid() && backend_) {
+            backend_->CloseObject(handle_);
+        }
+        handle_ = OS_INVALID_HANDLE;
+    }
+
+    // Prevent copying for safety
+    ScopedBackendObject(const ScopedBackendObject&) = delete;
+    ScopedBackendObject& operator=(const ScopedBackendObject&) = delete;
+};
+
+//==============================================================================
+// HELPERS
+//==============================================================================
+
+/**
+ * @brief Membaca seluruh isi file kecil (allowlist, policy) melalui backend
+ *
+ * @param fs Backend filesystem
+ * @param path Path ke file
+ * @param maxSize Ukuran maksimum yang diterima
+ * @param contents Output isi file (bytes mentah)
+ * @return false jika file tidak dapat dibuka, berupa direktori, melebihi
+ *         maxSize, atau tidak terbaca penuh
+ */
+bool ReadSmallFile(IFileSystemBackend* fs, const std::wstring& path, uint32_t maxSize, std::string& contents);
+
+#endif
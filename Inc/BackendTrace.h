@@ -0,0 +1,380 @@
+/**
+ * @file BackendTrace.h
+ * @brief Record/replay trace biner untuk semua panggilan backend OS
+ *
+ * Mode record membungkus backend aktif dengan decorator yang mencatat setiap
+ * panggilan (argumen, hasil, kode error, durasi) ke trace biner ringkas.
+ * Trace dari mesin pelanggan (RasTI.exe /trace:FILE) dapat diputar ulang di
+ * Linux: TraceReplayBackend menggantikan backend palsu dan menjawab setiap
+ * panggilan dengan hasil dan durasi yang tercatat, sehingga urutan akuisisi
+ * yang lambat dapat direproduksi persis dan optimasi diukur terhadapnya.
+ *
+ * Format file (little-endian, integer = varint LEB128, string = UTF-8
+ * dengan prefix panjang varint):
+ *
+ *   header : "RTRC" | u8 versi | varint panjang session | session
+ *   session: operation | target | arguments | iterations | priority
+ *   record : u8 call | varint durasi ns | varint panjang key | key
+ *            | varint panjang result | result
+ *
+ * Key berisi argumen yang menentukan hasil (path, handle, pid, privilege);
+ * result berisi nilai kembali, output, dan kode error (backend proses).
+ * Saat replay, panggilan dicocokkan berdasarkan call + key dengan antrian per
+ * key, sehingga kode yang sudah dioptimasi boleh melewati panggilan yang
+ * tercatat; panggilan tanpa pasangan dihitung sebagai unmatched dan gagal
+ * dengan OS_ERROR_NOT_SUPPORTED.
+ *
+ * Isi file hanya disimpan sampai BACKEND_TRACE_INLINE_DATA_LIMIT bytes per
+ * panggilan (cukup untuk header PE), kecuali recordFileContents diaktifkan;
+ * data yang tidak disimpan diputar ulang sebagai bytes nol. Allowlist dan
+ * policy tidak termasuk trace karena tidak dimuat melalui backend.
+ *
+ * Header ini portable (tidak bergantung pada Windows.h maupun VCL).
+ *
+ * @author RasTI Development Team
+ * @version 1.2.0.0
+ * @date 2025
+ */
+
+#ifndef RASTI_BACKEND_TRACE_H
+#define RASTI_BACKEND_TRACE_H
+
+#include "Backend.h"
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+//==============================================================================
+// TRACE FORMAT
+//==============================================================================
+
+/** @brief Versi format trace yang ditulis dan dibaca */
+const uint8_t BACKEND_TRACE_VERSION = 1;
+
+/** @brief Batas bytes file yang disimpan per panggilan tanpa recordFileContents */
+const uint32_t BACKEND_TRACE_INLINE_DATA_LIMIT = 4096;
+
+/** @brief Jenis panggilan backend (satu method interface) */
+enum BackendTraceCall {
+    TRACE_FS_GET_FULL_PATH = 1,
+    TRACE_FS_OPEN_FILE,
+    TRACE_FS_QUERY_IDENTITY,
+    TRACE_FS_READ_FILE,
+    TRACE_FS_MAP_VIEW,
+    TRACE_FS_UNMAP_VIEW,
+    TRACE_FS_CLOSE_FILE,
+    TRACE_FS_ENUMERATE_DIRECTORY,
+    TRACE_FS_GET_ENVIRONMENT,
+    TRACE_FS_GET_CURRENT_DIRECTORY,
+
+    TRACE_PS_ADJUST_PRIVILEGE = 32,
+    TRACE_PS_FIND_PROCESS,
+    TRACE_PS_OPEN_PROCESS_TOKEN,
+    TRACE_PS_IMPERSONATE_TOKEN,
+    TRACE_PS_REVERT_IMPERSONATION,
+    TRACE_PS_LOGON_TRUSTED_INSTALLER,
+    TRACE_PS_CREATE_PROCESS,
+    TRACE_PS_IS_PRIVILEGE_ENABLED,
+    TRACE_PS_IS_ELEVATED_ADMINISTRATOR,
+    TRACE_PS_GET_MODULE_PATH,
+    TRACE_PS_CLOSE_OBJECT,
+    TRACE_PS_WAIT_PROCESS,
+    TRACE_PS_CREATE_PROCESS_AS_USER,
+    TRACE_PS_RESUME_PROCESS,
+    TRACE_PS_TERMINATE_PROCESS,
+    TRACE_PS_SET_PROCESS_SETTING,
+    TRACE_PS_CREATE_JOB,
+    TRACE_PS_ASSIGN_PROCESS_TO_JOB,
+    TRACE_PS_WAIT_ANY_PROCESS,
+    TRACE_PS_ENUMERATE_PROCESSES,
+    TRACE_PS_OPEN_PROCESS,
+    TRACE_PS_QUERY_PROCESS_PATH,
+    TRACE_PS_ENUMERATE_SESSIONS,
+    TRACE_PS_OPEN_THREAD_TOKEN
+};
+
+/** @brief Nama method untuk report (misalnya "LogonTrustedInstaller") */
+const char* GetBackendTraceCallName(BackendTraceCall call);
+
+/**
+ * @brief Operasi yang direkam, cukup untuk menjalankannya ulang saat replay
+ */
+struct BackendTraceSession {
+    std::wstring operation;      /**< "launch" (satu launch CLI) atau "bench" (/bench:N) */
+    std::wstring target;         /**< Path executable target */
+    std::wstring arguments;      /**< Argumen setelah path (bench) */
+    uint32_t iterations = 0;     /**< Siklus per jalur token (bench) */
+    uint32_t priority = 0x20;    /**< Priority class */
+    uint32_t console = 0;        /**< ConsoleMode (TrustedInstaller.h); trace tanpa field ini = 1 (new) */
+    uint32_t launchApi = 0;      /**< ProcessLaunchApi (TrustedInstaller.h); trace tanpa field ini = 1 (seclogon) */
+    uint64_t affinityMask = 0;   /**< LaunchStageSettings (LaunchPipeline.h); trace tanpa field ini = tanpa pipeline */
+    uint32_t ioPriority = 0xFFFFFFFF;     /**< LAUNCH_SETTING_UNSET = tidak diatur */
+    uint32_t memoryPriority = 0xFFFFFFFF; /**< LAUNCH_SETTING_UNSET = tidak diatur */
+    uint64_t jobMemoryLimit = 0; /**< Byte per proses, 0 = tanpa job */
+};
+
+/** @brief Satu panggilan yang tercatat */
+struct BackendTraceRecord {
+    BackendTraceCall call;
+    uint64_t durationNs;         /**< Durasi panggilan backend asli */
+    std::string key;             /**< Argumen ter-encode (kunci pencocokan replay) */
+    std::string result;          /**< Hasil ter-encode */
+};
+
+/**
+ * @brief Trace yang sudah di-parse
+ */
+struct BackendTrace {
+    BackendTraceSession session;
+    std::vector<BackendTraceRecord> records;
+
+    /**
+     * @brief Parse isi file trace
+     *
+     * @param data Isi file
+     * @param errorOffset Output offset byte pertama yang rusak (opsional)
+     * @return false jika magic/versi salah atau trace terpotong
+     */
+    bool Load(const std::string& data, size_t* errorOffset = NULL);
+
+    /** @brief Total durasi semua panggilan yang tercatat (ns) */
+    uint64_t GetTotalDurationNs() const;
+};
+
+/**
+ * @brief Tabel ringkasan per jenis panggilan: jumlah, total, rata-rata, maks
+ *
+ * Diurutkan dari total durasi terbesar sehingga langkah yang paling lambat di
+ * mesin pelanggan terlihat di baris pertama.
+ */
+std::string FormatBackendTraceSummary(const BackendTrace& trace);
+
+//==============================================================================
+// RECORDING
+//==============================================================================
+
+/**
+ * @brief Penulis trace thread-safe dengan buffer
+ *
+ * Header ditulis saat konstruksi; record dikirim ke sink per 64 KB dan saat
+ * Flush/destruktor.
+ */
+class BackendTraceWriter {
+public:
+    /** @brief Tujuan bytes trace (misalnya fwrite ke file) */
+    typedef std::function<void(const uint8_t* data, size_t size)> Sink;
+
+private:
+    std::mutex mutex_;
+    Sink sink_;
+    std::string buffer_;
+    uint64_t records_;
+
+public:
+    BackendTraceWriter(const BackendTraceSession& session, Sink sink);
+    ~BackendTraceWriter();
+
+    /** @brief Menambah satu record (dipanggil oleh decorator) */
+    void Append(BackendTraceCall call, uint64_t durationNs, const std::string& key, const std::string& result);
+
+    /** @brief Mengirim buffer ke sink */
+    void Flush();
+
+    /** @brief Jumlah record yang sudah ditulis */
+    uint64_t GetRecordCount();
+
+    BackendTraceWriter(const BackendTraceWriter&) = delete;
+    BackendTraceWriter& operator=(const BackendTraceWriter&) = delete;
+};
+
+/**
+ * @brief Decorator IFileSystemBackend yang mencatat setiap panggilan
+ */
+class TracingFileSystemBackend : public IFileSystemBackend {
+private:
+    IFileSystemBackend* inner_;
+    BackendTraceWriter& writer_;
+    bool recordFileContents_;
+
+public:
+    TracingFileSystemBackend(IFileSystemBackend* inner, BackendTraceWriter& writer, bool recordFileContents = false);
+
+    bool GetFullPath(const std::wstring& path, std::wstring& fullPath) override;
+    OsHandle OpenFileForValidation(const std::wstring& path) override;
+    bool QueryFileIdentity(OsHandle file, FileIdentity& identity) override;
+    bool ReadFileAt(OsHandle file, uint64_t offset, void* buffer, uint32_t size, uint32_t& bytesRead) override;
+    const uint8_t* MapFileView(OsHandle file, uint64_t offset, uint32_t size) override;
+    void UnmapFileView(const uint8_t* view, uint32_t size) override;
+    void CloseFile(OsHandle file) override;
+    bool EnumerateDirectory(const std::wstring& directory, std::vector<DirectoryEntry>& entries) override;
+    bool GetEnvironmentValue(const std::wstring& name, std::wstring& value) override;
+    bool GetCurrentDirectoryPath(std::wstring& path) override;
+};
+
+/**
+ * @brief Decorator IProcessBackend yang mencatat setiap panggilan
+ *
+ * GetLastErrorCode dibaca setelah setiap panggilan dan disimpan di result,
+ * lalu dipulihkan agar pemanggil tetap melihat kode error backend asli.
+ */
+class TracingProcessBackend : public IProcessBackend {
+private:
+    IProcessBackend* inner_;
+    BackendTraceWriter& writer_;
+
+public:
+    TracingProcessBackend(IProcessBackend* inner, BackendTraceWriter& writer);
+
+    bool AdjustPrivilege(int privilege, bool threadScope) override;
+    bool FindProcessByName(const std::wstring& imageName, uint32_t& processId) override;
+    bool EnumerateProcesses(std::vector<ProcessEntry>& processes) override;
+    OsHandle OpenProcessHandle(uint32_t processId) override;
+    bool QueryProcessImagePath(OsHandle process, std::wstring& path) override;
+    bool EnumerateSessions(std::vector<SessionEntry>& sessions) override;
+    OsHandle OpenProcessToken(uint32_t processId) override;
+    bool OpenThreadToken(OsHandle& token) override;
+    bool ImpersonateToken(OsHandle token) override;
+    void RevertImpersonation() override;
+    OsHandle LogonTrustedInstaller(bool useThreadToken) override;
+    bool CreateProcessWithToken(OsHandle token, const ProcessLaunchRequest& request, uint32_t& processId,
+                                OsHandle* process) override;
+    bool CreateProcessAsUser(OsHandle token, const ProcessLaunchRequest& request, uint32_t& processId,
+                             OsHandle* process) override;
+    bool WaitForProcessExit(OsHandle process, uint32_t timeoutMs, uint32_t& exitCode) override;
+    bool WaitForAnyProcessExit(const std::vector<OsHandle>& processes, uint32_t timeoutMs, size_t& index,
+                               uint32_t& exitCode) override;
+    bool ResumeProcess(OsHandle process) override;
+    bool TerminateProcess(OsHandle process, uint32_t exitCode) override;
+    bool SetProcessSetting(OsHandle process, ProcessSetting setting, uint64_t value) override;
+    OsHandle CreateJob(const ProcessJobLimits& limits) override;
+    bool AssignProcessToJob(OsHandle job, OsHandle process) override;
+    bool IsPrivilegeEnabled(int privilege) override;
+    bool IsElevatedAdministrator() override;
+    bool GetModuleFilePath(std::wstring& path) override;
+    void CloseObject(OsHandle handle) override;
+    uint32_t GetLastErrorCode() override;
+    void SetLastErrorCode(uint32_t error) override;
+};
+
+/**
+ * @brief Memasang decorator record di atas backend aktif selama scope hidup
+ *
+ * Destruktor memasang kembali backend sebelumnya dan mem-flush trace.
+ */
+class ScopedBackendTrace {
+private:
+    IFileSystemBackend* previousFileSystem_;
+    IProcessBackend* previousProcess_;
+    BackendTraceWriter writer_;
+    TracingFileSystemBackend fileSystem_;
+    TracingProcessBackend process_;
+
+public:
+    ScopedBackendTrace(const BackendTraceSession& session, BackendTraceWriter::Sink sink,
+                       bool recordFileContents = false);
+    ~ScopedBackendTrace();
+
+    /** @brief Jumlah panggilan yang sudah dicatat */
+    uint64_t GetRecordCount() { return writer_.GetRecordCount(); }
+
+    ScopedBackendTrace(const ScopedBackendTrace&) = delete;
+    ScopedBackendTrace& operator=(const ScopedBackendTrace&) = delete;
+};
+
+//==============================================================================
+// REPLAY
+//==============================================================================
+
+/** @brief Statistik replay */
+struct BackendReplayStats {
+    uint64_t matched = 0;        /**< Panggilan yang dijawab dari trace */
+    uint64_t unmatched = 0;      /**< Panggilan tanpa record dengan call + key sama */
+    uint64_t unconsumed = 0;     /**< Record yang tidak pernah diminta */
+    uint64_t replayedNs = 0;     /**< Total durasi tercatat dari record yang dijawab */
+};
+
+/**
+ * @brief Backend filesystem + proses yang menjawab panggilan dari trace
+ *
+ * Setiap panggilan mengambil record berikutnya dengan call + key yang sama
+ * dan menunggu durasi tercatat dikali timeScale (0 = tanpa menunggu). Handle
+ * yang dikembalikan adalah nilai handle asli dari trace.
+ */
+class TraceReplayBackend : public IFileSystemBackend, public IProcessBackend {
+private:
+    const BackendTrace& trace_;
+    double timeScale_;
+    std::mutex mutex_;
+    std::map<std::string, std::deque<size_t>> pending_;   /**< call + key -> index record */
+    std::map<const uint8_t*, std::vector<uint8_t>> views_; /**< View yang sedang di-map */
+    BackendReplayStats stats_;
+    uint32_t lastError_;
+
+    const BackendTraceRecord* Take(BackendTraceCall call, const std::string& key);
+    const BackendTraceRecord* TakeWithError(BackendTraceCall call, const std::string& key);
+
+public:
+    /**
+     * @param trace Trace sumber (harus hidup selama backend dipakai)
+     * @param timeScale Faktor durasi (1.0 = latency asli, 0.5 = dua kali lebih cepat)
+     */
+    explicit TraceReplayBackend(const BackendTrace& trace, double timeScale = 1.0);
+
+    /** @brief Memulai ulang dari awal trace (untuk replay berulang) */
+    void Rewind();
+
+    /** @brief Statistik sejak Rewind terakhir */
+    BackendReplayStats GetStats();
+
+    // IFileSystemBackend
+    bool GetFullPath(const std::wstring& path, std::wstring& fullPath) override;
+    OsHandle OpenFileForValidation(const std::wstring& path) override;
+    bool QueryFileIdentity(OsHandle file, FileIdentity& identity) override;
+    bool ReadFileAt(OsHandle file, uint64_t offset, void* buffer, uint32_t size, uint32_t& bytesRead) override;
+    const uint8_t* MapFileView(OsHandle file, uint64_t offset, uint32_t size) override;
+    void UnmapFileView(const uint8_t* view, uint32_t size) override;
+    void CloseFile(OsHandle file) override;
+    bool EnumerateDirectory(const std::wstring& directory, std::vector<DirectoryEntry>& entries) override;
+    bool GetEnvironmentValue(const std::wstring& name, std::wstring& value) override;
+    bool GetCurrentDirectoryPath(std::wstring& path) override;
+
+    // IProcessBackend
+    bool AdjustPrivilege(int privilege, bool threadScope) override;
+    bool FindProcessByName(const std::wstring& imageName, uint32_t& processId) override;
+    bool EnumerateProcesses(std::vector<ProcessEntry>& processes) override;
+    OsHandle OpenProcessHandle(uint32_t processId) override;
+    bool QueryProcessImagePath(OsHandle process, std::wstring& path) override;
+    bool EnumerateSessions(std::vector<SessionEntry>& sessions) override;
+    OsHandle OpenProcessToken(uint32_t processId) override;
+    bool OpenThreadToken(OsHandle& token) override;
+    bool ImpersonateToken(OsHandle token) override;
+    void RevertImpersonation() override;
+    OsHandle LogonTrustedInstaller(bool useThreadToken) override;
+    bool CreateProcessWithToken(OsHandle token, const ProcessLaunchRequest& request, uint32_t& processId,
+                                OsHandle* process) override;
+    bool CreateProcessAsUser(OsHandle token, const ProcessLaunchRequest& request, uint32_t& processId,
+                             OsHandle* process) override;
+    bool WaitForProcessExit(OsHandle process, uint32_t timeoutMs, uint32_t& exitCode) override;
+    bool WaitForAnyProcessExit(const std::vector<OsHandle>& processes, uint32_t timeoutMs, size_t& index,
+                               uint32_t& exitCode) override;
+    bool ResumeProcess(OsHandle process) override;
+    bool TerminateProcess(OsHandle process, uint32_t exitCode) override;
+    bool SetProcessSetting(OsHandle process, ProcessSetting setting, uint64_t value) override;
+    OsHandle CreateJob(const ProcessJobLimits& limits) override;
+    bool AssignProcessToJob(OsHandle job, OsHandle process) override;
+    bool IsPrivilegeEnabled(int privilege) override;
+    bool IsElevatedAdministrator() override;
+    bool GetModuleFilePath(std::wstring& path) override;
+    void CloseObject(OsHandle handle) override;
+    uint32_t GetLastErrorCode() override;
+    void SetLastErrorCode(uint32_t error) override;
+
+    TraceReplayBackend(const TraceReplayBackend&) = delete;
+    TraceReplayBackend& operator=(const TraceReplayBackend&) = delete;
+};
+
+#endif
@@ -0,0 +1,172 @@
+/**
+ * @file BulkValidation.h
+ * @brief Validasi massal executable untuk audit inventory (paralel, streaming)
+ *
+ * Menjalankan pipeline ValidateExecutable yang sama dengan launch biasa untuk
+ * daftar path atau seluruh isi direktori, sehingga hasilnya memprediksi
+ * executable mana yang akan diterima RasTI. Pekerjaan dibagi ke beberapa
+ * thread dengan work stealing: setiap worker memiliki antrian sendiri dan
+ * mengambil task dari antrian worker lain saat antriannya kosong.
+ * Sub-direktori yang ditemukan saat walk menjadi task baru, sehingga pohon
+ * direktori yang tidak seimbang tetap terbagi rata.
+ *
+ * Semua thread memakai index PATH, allowlist, policy, dan cache hash yang
+ * sama. Hasil ditulis sebagai CSV atau JSON segera setelah setiap file
+ * selesai divalidasi (urutan output tidak dijamin sama dengan input).
+ *
+ * Header ini portable (tidak bergantung pada Windows.h maupun VCL).
+ *
+ * @author RasTI Development Team
+ * @version 1.2.0.0
+ * @date 2025
+ */
+
+#ifndef RASTI_BULK_VALIDATION_H
+#define RASTI_BULK_VALIDATION_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "Validation.h"
+
+//==============================================================================
+// CONSTANTS
+//==============================================================================
+
+/** @brief Jumlah path per task saat membagi daftar input */
+const size_t BULK_PATHS_PER_TASK = 64;
+
+/** @brief Ukuran maksimum file daftar path yang dibaca */
+const uint32_t BULK_LIST_MAX_FILE_SIZE = 256 * 1024 * 1024;
+
+/** @brief Jumlah thread maksimum yang diterima */
+const unsigned BULK_MAX_THREADS = 256;
+
+//==============================================================================
+// OPTIONS AND RESULTS
+//==============================================================================
+
+/**
+ * @brief Format output hasil validasi massal
+ */
+enum BulkOutputFormat {
+    BULK_OUTPUT_CSV = 0, /**< Header + satu baris per file (RFC 4180) */
+    BULK_OUTPUT_JSON     /**< Satu array JSON, satu object per file */
+};
+
+/**
+ * @brief Opsi validasi massal
+ */
+struct BulkValidationOptions {
+    unsigned threadCount = 0;     /**< 0 = jumlah core (std::thread::hardware_concurrency) */
+    bool recursive = true;        /**< Walk masuk ke sub-direktori */
+    bool useSearchIndex = true;   /**< Bangun index PATH sekali untuk semua thread */
+};
+
+/**
+ * @brief Statistik hasil validasi massal
+ */
+struct BulkValidationStats {
+    uint64_t pathsValidated = 0;     /**< Jumlah path yang divalidasi */
+    uint64_t accepted = 0;           /**< VALIDATION_OK */
+    uint64_t rejected = 0;           /**< Kode error lain */
+    uint64_t directoriesScanned = 0; /**< Direktori yang dibaca saat walk */
+    uint64_t filesSkipped = 0;       /**< File non-executable yang dilewati saat walk */
+    uint64_t tasksStolen = 0;        /**< Task yang diambil dari antrian worker lain */
+    unsigned threadCount = 0;        /**< Jumlah worker yang dipakai */
+    double elapsedSeconds = 0.0;     /**< Waktu total (termasuk membangun index PATH) */
+
+    /** @brief Throughput dalam path per detik */
+    double PathsPerSecond() const {
+        return elapsedSeconds > 0.0 ? pathsValidated / elapsedSeconds : 0.0;
+    }
+};
+
+//==============================================================================
+// RESULT WRITER
+//==============================================================================
+
+/** @brief Tujuan output (file, stdout, atau buffer di test); dipanggil berurutan */
+typedef std::function<void(std::string_view)> BulkOutputSink;
+
+/**
+ * @brief Menulis hasil validasi sebagai CSV/JSON (UTF-8) ke sink
+ *
+ * Aman dipanggil dari beberapa thread: setiap record diformat di thread
+ * pemanggil, lalu dikirim utuh ke sink di bawah satu mutex.
+ *
+ * Kolom: input, path, result, kind, subsystem, machine, sha256, policy_rule
+ */
+class BulkResultWriter {
+private:
+    BulkOutputFormat format_;
+    BulkOutputSink sink_;
+    std::mutex mutex_;
+    uint64_t recordCount_ = 0;
+
+public:
+    BulkResultWriter(BulkOutputFormat format, BulkOutputSink sink)
+        : format_(format), sink_(std::move(sink)) {}
+
+    /** @brief Menulis header CSV atau pembuka array JSON */
+    void Begin();
+
+    /**
+     * @brief Menulis satu record hasil validasi
+     * @param input Path seperti yang diberikan (atau ditemukan saat walk)
+     * @param error Hasil ValidateExecutable
+     * @param validated Detail hasil validasi
+     */
+    void Write(std::wstring_view input, ValidationError error, const ValidatedExecutable& validated);
+
+    /** @brief Menutup array JSON (CSV tidak membutuhkan penutup) */
+    void End();
+
+    /** @brief Jumlah record yang sudah ditulis */
+    uint64_t RecordCount() const { return recordCount_; }
+};
+
+//==============================================================================
+// BULK VALIDATION API
+//==============================================================================
+
+/**
+ * @brief Memvalidasi daftar path secara paralel
+ *
+ * @param paths Daftar path (absolute, relative, atau nama file saja)
+ * @param options Opsi thread dan index PATH
+ * @param writer Tujuan hasil (Begin/End dipanggil oleh function ini)
+ * @return Statistik dan throughput
+ */
+BulkValidationStats ValidatePathList(const std::vector<std::wstring>& paths,
+                                     const BulkValidationOptions& options, BulkResultWriter& writer);
+
+/**
+ * @brief Memvalidasi semua executable (.exe/.com/.bat/.cmd) di bawah sebuah direktori
+ *
+ * Junction dan symlink direktori tidak diikuti untuk menghindari loop.
+ *
+ * @param root Direktori awal (absolute)
+ * @param options Opsi thread, rekursi, dan index PATH
+ * @param writer Tujuan hasil (Begin/End dipanggil oleh function ini)
+ * @return Statistik dan throughput
+ */
+BulkValidationStats ValidateDirectoryTree(const std::wstring& root,
+                                          const BulkValidationOptions& options, BulkResultWriter& writer);
+
+/**
+ * @brief Membaca file daftar path (UTF-8, satu path per baris) melalui backend aktif
+ *
+ * Baris kosong dan baris yang diawali '#' diabaikan.
+ *
+ * @param listFile Path ke file daftar
+ * @param paths Output daftar path
+ * @return false jika file tidak terbaca atau bukan UTF-8 valid
+ */
+bool ReadPathListFile(const std::wstring& listFile, std::vector<std::wstring>& paths);
+
+#endif
@@ -14,11 +14,21 @@
 #define RASTI_H
 
 #include <Windows.h>
+#include <assert.h>
 #include <stdio.h>
 #include <tlhelp32.h>
 #include <sddl.h>
 #include <tchar.h>
+#include <wtsapi32.h>
+#ifndef RASTI_NO_VCL
 #include <System.hpp>
+#endif
+#include "Validation.h"
+#include "HashAllowlist.h"
+#include "PathPolicy.h"
+#include "BulkValidation.h"
+#include "TrustedInstaller.h"
+#include "LaunchBenchmark.h"
 
 //==============================================================================
 // MACRO DEFINITIONS
@@ -30,60 +40,6 @@
 /** @brief Macro shortcut untuk GetLastError() */
 #define GLE GetLastError()
 
-//==============================================================================
-// WINDOWS PRIVILEGE CONSTANTS
-//==============================================================================
-
-/** @brief Konstanta privilege Windows untuk berbagai operasi sistem
- *
- * Privilege ini digunakan untuk mengontrol akses ke berbagai fitur sistem.
- * Hanya privilege yang relevan dengan aplikasi ini yang didefinisikan.
- */
-#define SE_CREATE_TOKEN_PRIVILEGE 1           /**< Membuat token akses */
-#define SE_ASSIGNPRIMARYTOKEN_PRIVILEGE 3     /**< Mengassign primary token */
-#define SE_LOCK_MEMORY_PRIVILEGE 4            /**< Mengunci memory */
-#define SE_INCREASE_QUOTA_PRIVILEGE 5         /**< Meningkatkan quota */
-#define SE_UNSOLICITED_INPUT_PRIVILEGE 6      /**< Input tidak diminta */
-#define SE_MACHINE_ACCOUNT_PRIVILEGE 11       /**< Akun mesin */
-#define SE_TCB_PRIVILEGE 7                    /**< Trusted Computing Base */
-#define SE_SECURITY_PRIVILEGE 8               /**< Operasi keamanan */
-#define SE_TAKE_OWNERSHIP_PRIVILEGE 9         /**< Mengambil ownership */
-#define SE_LOAD_DRIVER_PRIVILEGE 10           /**< Memuat driver */
-#define SE_SYSTEM_PROFILE_PRIVILEGE 12        /**< System profiling */
-#define SE_SYSTEMTIME_PRIVILEGE 12            /**< Mengubah waktu sistem */
-#define SE_PROF_SINGLE_PROCESS_PRIVILEGE 13   /**< Profile single process */
-#define SE_INC_BASE_PRIORITY_PRIVILEGE 14     /**< Meningkatkan base priority */
-#define SE_CREATE_PAGEFILE_PRIVILEGE 15       /**< Membuat pagefile */
-#define SE_CREATE_PERMANENT_PRIVILEGE 16      /**< Membuat objek permanent */
-#define SE_BACKUP_PRIVILEGE 17                /**< Backup operations */
-#define SE_RESTORE_PRIVILEGE 18               /**< Restore operations */
-#define SE_SHUTDOWN_PRIVILEGE 19              /**< Shutdown sistem */
-#define SE_DEBUG_PRIVILEGE 20                 /**< Debug privilege */
-#define SE_AUDIT_PRIVILEGE 21                 /**< Audit operations */
-#define SE_SYSTEM_ENVIRONMENT_PRIVILEGE 22    /**< System environment */
-#define SE_CHANGE_NOTIFY_PRIVILEGE 23         /**< Change notifications */
-#define SE_REMOTE_SHUTDOWN_PRIVILEGE 24       /**< Remote shutdown */
-#define SE_UNDOCK_PRIVILEGE 25                /**< Undock privilege */
-#define SE_SYNC_AGENT_PRIVILEGE 26            /**< Sync agent */
-#define SE_ENABLE_DELEGATION_PRIVILEGE 27     /**< Enable delegation */
-#define SE_MANAGE_VOLUME_PRIVILEGE 28         /**< Manage volume */
-#define SE_IMPERSONATE_PRIVILEGE 29           /**< Impersonate privilege */
-#define SE_CREATE_GLOBAL_PRIVILEGE 30         /**< Create global objects */
-#define SE_TRUSTED_CREDMAN_ACCESS_PRIVILEGE 31/**< Trusted credential manager */
-#define SE_RELABEL_PRIVILEGE 32               /**< Relabel privilege */
-#define SE_INC_WORKING_SET_PRIVILEGE 33       /**< Increase working set */
-#define SE_TIME_ZONE_PRIVILEGE 34             /**< Time zone privilege */
-#define SE_CREATE_SYMBOLIC_LINK_PRIVILEGE 35  /**< Create symbolic links */
-
-//==============================================================================
-// BACKWARD COMPATIBILITY ALIASES
-//==============================================================================
-
-/** @brief Alias untuk kompatibilitas backward dengan kode lama */
-#define SeTcbPrivilege SE_TCB_PRIVILEGE
-#define SeDebugPrivilege SE_DEBUG_PRIVILEGE
-#define SeImpersonatePrivilege SE_IMPERSONATE_PRIVILEGE
-
 //==============================================================================
 // SECURITY IDENTIFIERS
 //==============================================================================
@@ -130,6 +86,48 @@ typedef BOOL(WINAPI* _LogonUserExExW)(
     _Out_opt_ PQUOTA_LIMITS pQuotaLimits         /**< Output quota limits */
 );
 
+/**
+ * @brief Function pointer untuk NtResumeProcess dari ntdll.dll
+ *
+ * Menjalankan semua thread proses yang dibuat dengan CREATE_SUSPENDED tanpa
+ * memerlukan handle thread utama.
+ */
+typedef NTSTATUS(NTAPI* _NtResumeProcess)(HANDLE ProcessHandle);
+
+/**
+ * @brief Function pointer untuk NtSetInformationProcess dari ntdll.dll
+ *
+ * Digunakan untuk ProcessIoPriority (tidak ada API Win32 untuk proses lain).
+ */
+typedef NTSTATUS(NTAPI* _NtSetInformationProcess)(HANDLE ProcessHandle, ULONG ProcessInformationClass,
+                                                  PVOID ProcessInformation, ULONG ProcessInformationLength);
+
+/** @brief Function pointer untuk RtlNtStatusToDosError dari ntdll.dll */
+typedef ULONG(NTAPI* _RtlNtStatusToDosError)(NTSTATUS Status);
+
+/**
+ * @brief Function pointer untuk SetProcessInformation dari kernel32.dll
+ *
+ * Tersedia mulai Windows 8; digunakan untuk ProcessMemoryPriority.
+ */
+typedef BOOL(WINAPI* _SetProcessInformation)(HANDLE hProcess, int ProcessInformationClass,
+                                             LPVOID ProcessInformation, DWORD ProcessInformationSize);
+
+/**
+ * @brief Function pointer untuk WTSEnumerateSessionsW dari wtsapi32.dll
+ *
+ * wtsapi32.dll tidak di-link; dimuat oleh ResolveDynamicFunctions untuk /sessions.
+ */
+typedef BOOL(WINAPI* _WTSEnumerateSessionsW)(HANDLE hServer, DWORD Reserved, DWORD Version,
+                                             PWTS_SESSION_INFOW* ppSessionInfo, DWORD* pCount);
+
+/** @brief Function pointer untuk WTSQuerySessionInformationW dari wtsapi32.dll */
+typedef BOOL(WINAPI* _WTSQuerySessionInformationW)(HANDLE hServer, DWORD SessionId, WTS_INFO_CLASS WTSInfoClass,
+                                                   LPWSTR* ppBuffer, DWORD* pBytesReturned);
+
+/** @brief Function pointer untuk WTSFreeMemory dari wtsapi32.dll */
+typedef void(WINAPI* _WTSFreeMemory)(PVOID pMemory);
+
 //==============================================================================
 // RAII SMART HANDLE CLASSES FOR RESOURCE MANAGEMENT
 //==============================================================================
@@ -362,6 +360,27 @@ extern _RtlAdjustPrivilege pRtlAdjustPrivilege;
 /** @brief Global function pointer untuk LogonUserExExW dari advapi32.dll */
 extern _LogonUserExExW pLogonUserExExW;
 
+/** @brief Global function pointer untuk NtResumeProcess dari ntdll.dll */
+extern _NtResumeProcess pNtResumeProcess;
+
+/** @brief Global function pointer untuk NtSetInformationProcess dari ntdll.dll */
+extern _NtSetInformationProcess pNtSetInformationProcess;
+
+/** @brief Global function pointer untuk RtlNtStatusToDosError dari ntdll.dll */
+extern _RtlNtStatusToDosError pRtlNtStatusToDosError;
+
+/** @brief Global function pointer untuk SetProcessInformation dari kernel32.dll (NULL sebelum Windows 8) */
+extern _SetProcessInformation pSetProcessInformation;
+
+/** @brief Global function pointer untuk WTSEnumerateSessionsW dari wtsapi32.dll (NULL jika gagal dimuat) */
+extern _WTSEnumerateSessionsW pWTSEnumerateSessionsW;
+
+/** @brief Global function pointer untuk WTSQuerySessionInformationW dari wtsapi32.dll */
+extern _WTSQuerySessionInformationW pWTSQuerySessionInformationW;
+
+/** @brief Global function pointer untuk WTSFreeMemory dari wtsapi32.dll */
+extern _WTSFreeMemory pWTSFreeMemory;
+
 /**
  * @brief Menginisialisasi function pointers untuk dynamic linking
  *
@@ -423,6 +442,27 @@ HANDLE GetTrustedInstallerToken();
  */
 bool CreateProcessWithTIToken(LPCWSTR targetPath, DWORD priority);
 
+/**
+ * @brief Membuat proses baru dari executable yang sudah tervalidasi
+ *
+ * Handle file di dalam ValidatedExecutable tetap terbuka (deny write/delete)
+ * selama CreateProcessWithTokenW berjalan, sehingga file yang di-launch
+ * dijamin sama dengan file yang divalidasi.
+ *
+ * @param executable Hasil ValidateExecutablePath (handle harus masih terbuka)
+ * @param priority Class priority untuk proses baru (IDLE_PRIORITY_CLASS, etc.)
+ * @param console Mode console (/console); AUTO = tanpa console untuk image GUI
+ * @param api API launch (/launchapi); AUTO = CreateProcessAsUserW jika privilege tersedia
+ * @param usedApi Output API yang membuat proses (opsional)
+ * @param pipeline Tahap konfigurasi sebelum resume (/affinity, /iopriority, ...; NULL = tanpa)
+ * @param pipelineResult Output timing per tahap pipeline (opsional)
+ * @return true jika proses berhasil dibuat, false jika gagal
+ */
+bool CreateProcessWithTIToken(const ValidatedExecutable& executable, DWORD priority,
+                              ConsoleMode console = CONSOLE_MODE_AUTO, ProcessLaunchApi api = LAUNCH_API_AUTO,
+                              ProcessLaunchApi* usedApi = NULL, const LaunchPipeline* pipeline = NULL,
+                              LaunchPipelineResult* pipelineResult = NULL);
+
 //==============================================================================
 // ADMINISTRATOR PRIVILEGE CHECKING
 //==============================================================================
@@ -454,94 +494,119 @@ BOOL CheckAdministratorPrivileges();
  * - File existence check
  * - Extension validation (.exe, .bat, .cmd, .com)
  *
+ * Seluruh pipeline berjalan dalam UTF-16 tanpa konversi ANSI, dan menerima
+ * path sampai VALIDATION_MAX_PATH karakter (long path dengan prefix "\\?\").
+ *
  * @param path Path yang akan divalidasi
  * @return true jika path valid dan aman, false jika tidak
  *
- * @note Menggunakan FindExecutableInPath jika file tidak ditemukan di path spesifik
+ * @note Mencari di PATH jika file tidak ditemukan di path spesifik
+ * @see ValidateExecutable untuk detail pipeline satu handle
  */
-bool ValidateExecutablePath(const AnsiString& path);
+bool ValidateExecutablePath(std::wstring_view path);
 
 /**
- * @brief Membersihkan dan menormalkan path string
+ * @brief Validasi path executable dan simpan handle file tervalidasi
  *
- * Operasi yang dilakukan:
- * - Trim whitespace
- * - Normalize path separators (/ ke \)
- * - Remove duplicate separators
- * - Convert relative path ke absolute jika perlu
+ * @param path Path yang akan divalidasi
+ * @param validated Output hasil validasi; handle tetap terbuka untuk launch
+ * @return true jika path valid dan aman, false jika tidak
  *
- * @param path String path yang akan disanitasi (modified in-place)
- * @return true jika sanitasi berhasil, false jika path kosong setelah sanitasi
+ * @see CreateProcessWithTIToken(const ValidatedExecutable&, DWORD)
  */
-bool SanitizePath(AnsiString& path);
+bool ValidateExecutablePath(std::wstring_view path, ValidatedExecutable& validated);
 
 /**
- * @brief Mengkonversi path ke bentuk canonical (normalized)
+ * @brief Validasi nilai priority class Windows
  *
- * Menggunakan GetFullPathName() untuk mendapatkan canonical path yang:
- * - Resolve ".", "..", dan relative components
- * - Convert relative paths ke absolute paths
- * - Normalize path separators
- * - Handle symbolic links (jika ada)
+ * @param priority Nilai priority yang akan divalidasi
+ * @return true jika priority valid, false jika tidak
  *
- * @param path Input path (relative atau absolute)
- * @return Canonical path jika berhasil, empty string jika gagal
+ * @note Mendukung semua priority class standar Windows
  */
-AnsiString GetCanonicalPath(const AnsiString& path);
+bool ValidatePriorityValue(int priority);
+
+//==============================================================================
+// EXECUTABLE HASH ALLOWLIST
+//==============================================================================
+
+/** @brief Nama file allowlist default (di direktori yang sama dengan RasTI.exe) */
+#define DEFAULT_ALLOWLIST_FILE_NAME L"RasTI.allowlist"
 
 /**
- * @brief Mengecek apakah path mengandung path traversal attacks
+ * @brief Path allowlist default: direktori RasTI.exe + DEFAULT_ALLOWLIST_FILE_NAME
  *
- * Mencegah directory traversal dengan mendeteksi:
- * - "../" atau "..\" patterns
- * - Karakter berbahaya: < > | ? *
- *
- * @param path Path yang akan diperiksa
- * @return true jika path aman, false jika mengandung traversal
+ * @return Path lengkap, atau string kosong jika GetModuleFileNameW gagal
  */
-bool IsPathTraversalSafe(const AnsiString& path);
+std::wstring GetDefaultAllowlistPath();
 
 /**
- * @brief Validasi nilai priority class Windows
+ * @brief Memuat allowlist SHA-256 dan mengaktifkannya untuk ValidateExecutablePath
  *
- * @param priority Nilai priority yang akan divalidasi
- * @return true jika priority valid, false jika tidak
+ * @param path Path ke file allowlist
+ * @param errorLine Output nomor baris yang tidak valid (0 jika bukan parse error), boleh NULL
+ * @return true jika allowlist berhasil dimuat
  *
- * @note Mendukung semua priority class standar Windows
+ * @note Fail closed: jika file tidak terbaca atau rusak, allowlist kosong tetap
+ *       diaktifkan sehingga semua executable ditolak
  */
-bool ValidatePriorityValue(int priority);
+bool LoadExecutableAllowlist(std::wstring_view path, size_t* errorLine = NULL);
 
 /**
- * @brief Mengecek apakah file adalah executable yang valid
- *
- * @param path Path lengkap ke file
- * @return true jika file executable valid, false jika tidak
+ * @brief Jumlah hash di allowlist aktif
+ * @return 0 jika allowlist tidak aktif atau kosong
+ */
+size_t GetExecutableAllowlistSize();
+
+//==============================================================================
+// PATH POLICY (ALLOW/DENY RULES)
+//==============================================================================
+
+/** @brief Nama file policy default (di direktori yang sama dengan RasTI.exe) */
+#define DEFAULT_PATH_POLICY_FILE_NAME L"RasTI.policy"
+
+/**
+ * @brief Path policy default: direktori RasTI.exe + DEFAULT_PATH_POLICY_FILE_NAME
  *
- * @note Menggunakan CreateFile untuk verifikasi akses dan GetFileVersionInfoSize
+ * @return Path lengkap, atau string kosong jika GetModuleFileNameW gagal
  */
-bool IsValidExecutable(const AnsiString& path);
+std::wstring GetDefaultPathPolicyPath();
 
 /**
- * @brief Mencari executable dalam PATH environment variable
+ * @brief Memuat policy path dan mengaktifkannya untuk ValidateExecutablePath
  *
- * @param exeName Nama executable (dengan atau tanpa .exe extension)
- * @return Path lengkap jika ditemukan, string kosong jika tidak
+ * @param path Path ke file policy
+ * @param errorLine Output nomor baris yang tidak valid (0 jika bukan parse error), boleh NULL
+ * @return true jika policy berhasil dimuat
  *
- * @note Menambahkan .exe extension jika tidak ada
+ * @note Fail closed: jika file tidak terbaca atau rusak, policy "deny **"
+ *       diaktifkan sehingga semua executable ditolak
  */
-AnsiString FindExecutableInPath(const AnsiString& exeName);
+bool LoadPathPolicy(std::wstring_view path, size_t* errorLine = NULL);
+
+/**
+ * @brief Jumlah rule di policy aktif
+ * @return 0 jika policy tidak aktif
+ */
+size_t GetPathPolicyRuleCount();
 
 //==============================================================================
 // ERROR MESSAGE FORMATTING
 //==============================================================================
 
+/*
+ * Satu-satunya bagian Core yang memakai VCL String. Build library C ABI
+ * (RasTIApi.h, tanpa VCL) mendefinisikan RASTI_NO_VCL.
+ */
+#ifndef RASTI_NO_VCL
+
 /**
  * @brief Format pesan error standar
  *
  * @param message Pesan error yang akan diformat
  * @return String error yang telah diformat dengan prefix "Error: "
  */
-AnsiString GetErrorMessage(const AnsiString& message);
+String GetErrorMessage(const String& message);
 
 /**
  * @brief Format pesan error dengan kode error Windows
@@ -550,6 +615,8 @@ AnsiString GetErrorMessage(const AnsiString& message);
  * @param errorCode Kode error dari GetLastError() atau API lain
  * @return String error yang telah diformat dengan kode error
  */
-AnsiString GetErrorMessageCode(const AnsiString& message, DWORD errorCode);
+String GetErrorMessageCode(const String& message, DWORD errorCode);
+
+#endif // RASTI_NO_VCL
 
 #endif
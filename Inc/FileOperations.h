@@ -0,0 +1,335 @@
+/**
+ * @file FileOperations.h
+ * @brief Engine operasi file massal paralel di bawah token Trusted Installer (/fileops)
+ *
+ * Script berisi satu operasi per baris, dijalankan berurutan:
+ * @code
+ * # Ganti driver lama dengan build baru
+ * copy   "D:\Build\drivers"  "C:\Windows\System32\drivers\vendor"
+ * move   C:\Windows\System32\vendor.dll  C:\Windows\System32\vendor.dll.bak
+ * delete "C:\ProgramData\Vendor\Cache"
+ * @endcode
+ *
+ * Setiap baris dipecah menjadi dua lapisan yang dapat diuji terpisah:
+ * - Planning: walk direktori sumber secara paralel (work stealing), lalu
+ *   menyusun stage. Stage berjalan berurutan; task dalam satu stage berjalan
+ *   paralel. Pembuatan direktori diurutkan per kedalaman (parent dulu),
+ *   penghapusan direktori sebaliknya (child dulu).
+ * - Scheduling: operasi metadata (mkdir, delete) dikelompokkan per batch
+ *   agar satu task membawa banyak syscall kecil; file kecil dikelompokkan
+ *   per batch berdasarkan jumlah dan bytes, sedangkan file besar menjadi task
+ *   sendiri dengan I/O unbuffered dan dijadwalkan lebih dulu.
+ *
+ * Setiap worker thread meng-impersonate token Trusted Installer selama
+ * bekerja. Baris berikutnya hanya dijalankan jika baris sebelumnya berhasil
+ * penuh, sehingga "copy A B" lalu "delete A" tidak menghapus sumber yang
+ * gagal disalin.
+ *
+ * Header ini portable (tidak bergantung pada Windows.h maupun VCL).
+ *
+ * @author RasTI Development Team
+ * @version 1.2.0.0
+ * @date 2025
+ */
+
+#ifndef RASTI_FILE_OPERATIONS_H
+#define RASTI_FILE_OPERATIONS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+#include "Backend.h"
+
+//==============================================================================
+// CONSTANTS
+//==============================================================================
+
+/** @brief Ukuran maksimum file script yang dibaca */
+const uint32_t FILEOPS_MAX_SCRIPT_SIZE = 16 * 1024 * 1024;
+
+/** @brief File dengan ukuran >= nilai ini disalin unbuffered sebagai task sendiri */
+const uint64_t FILEOPS_LARGE_FILE_SIZE = 8 * 1024 * 1024;
+
+/** @brief Operasi metadata (mkdir, delete) per task */
+const size_t FILEOPS_METADATA_BATCH = 256;
+
+/** @brief Jumlah file kecil maksimum per task copy */
+const size_t FILEOPS_COPY_BATCH = 64;
+
+/** @brief Total bytes file kecil maksimum per task copy */
+const uint64_t FILEOPS_COPY_BATCH_BYTES = 4 * 1024 * 1024;
+
+/** @brief Jumlah error per item yang disimpan di report (sisanya hanya dihitung) */
+const size_t FILEOPS_MAX_REPORTED_ERRORS = 1000;
+
+/** @brief Jumlah thread maksimum yang diterima */
+const unsigned FILEOPS_MAX_THREADS = 256;
+
+//==============================================================================
+// SCRIPT
+//==============================================================================
+
+/**
+ * @brief Jenis operasi satu baris script
+ */
+enum FileOperationKind {
+    FILEOPS_COPY = 0, /**< copy SRC DST: file, atau isi direktori secara rekursif */
+    FILEOPS_MOVE,     /**< move SRC DST: rename (file boleh antar volume) */
+    FILEOPS_DELETE    /**< delete PATH: file, atau direktori beserta isinya */
+};
+
+/**
+ * @brief Satu baris script yang sudah di-parse
+ */
+struct FileOperationCommand {
+    FileOperationKind kind = FILEOPS_COPY;
+    std::wstring source;      /**< Path absolute sumber (tanpa separator akhir) */
+    std::wstring destination; /**< Path absolute tujuan (kosong untuk delete) */
+    uint32_t line = 0;        /**< Nomor baris di script (1-based) */
+};
+
+/**
+ * @brief Parse isi script (UTF-8) menjadi daftar operasi
+ *
+ * Format baris: keyword (copy/move/delete, case-insensitive) lalu satu atau
+ * dua path, masing-masing boleh diapit tanda kutip. Baris kosong dan baris
+ * yang diawali '#' diabaikan. Path harus absolute ("X:\..." atau UNC) dan
+ * tidak boleh mengandung komponen "." atau "..". Root volume tidak dapat
+ * di-copy/move/delete, dan tujuan copy/move tidak boleh berada di dalam sumber.
+ *
+ * @param text Isi script
+ * @param commands Output operasi (dikosongkan jika script tidak valid)
+ * @param errorLine Output nomor baris yang tidak valid (0 jika valid)
+ * @return false jika ada baris yang tidak valid (tidak ada operasi yang dijalankan)
+ */
+bool ParseFileOperationScript(std::string_view text, std::vector<FileOperationCommand>& commands,
+                              size_t* errorLine = nullptr);
+
+/**
+ * @brief Membaca dan parse file script melalui backend filesystem aktif
+ *
+ * @param path File script
+ * @param commands Output operasi
+ * @param errorLine Output nomor baris yang tidak valid (0 jika file tidak terbaca)
+ */
+bool LoadFileOperationScript(std::wstring_view path, std::vector<FileOperationCommand>& commands,
+                             size_t* errorLine = nullptr);
+
+/**
+ * @brief Normalisasi path script: '/' menjadi '\', tolak path relative/root/berbahaya
+ *
+ * Dipakai juga untuk path root /aclreset.
+ *
+ * @param path Path yang dinormalisasi di tempat
+ * @return true jika path absolute dengan minimal satu komponen di bawah root volume/share
+ */
+bool NormalizeFileOperationPath(std::wstring& path);
+
+//==============================================================================
+// WORKER THREADS
+//==============================================================================
+
+/** @brief Jumlah worker efektif (0 = jumlah core, dibatasi FILEOPS_MAX_THREADS) */
+unsigned ResolveFileOperationThreadCount(unsigned requested);
+
+/**
+ * @brief Menjalankan work(worker, impersonationError) di threadCount worker
+ *
+ * Dengan token, setiap worker adalah thread baru yang meng-impersonate token
+ * lalu revert sebelum selesai. Jika impersonation gagal, work tetap dipanggil
+ * dengan kode error-nya agar setiap item yang diambil worker tersebut
+ * dilaporkan gagal, bukan dijalankan dengan security context proses.
+ * Tanpa token, worker 0 berjalan di thread pemanggil.
+ */
+template <typename Function>
+void RunImpersonatedWorkers(unsigned threadCount, OsHandle token, Function&& work)
+{
+    auto body = [&](unsigned worker) {
+        if (token == OS_INVALID_HANDLE) {
+            work(worker, 0u);
+            return;
+        }
+
+        IProcessBackend* ps = GetProcessBackend();
+        if (!ps->ImpersonateToken(token)) {
+            uint32_t error = ps->GetLastErrorCode();
+            work(worker, error != 0 ? error : OS_ERROR_ACCESS_DENIED);
+            return;
+        }
+        work(worker, 0u);
+        ps->RevertImpersonation();
+    };
+
+    unsigned first = (token == OS_INVALID_HANDLE) ? 1 : 0;
+    std::vector<std::thread> threads;
+    for (unsigned i = first; i < threadCount; i++) {
+        threads.emplace_back(body, i);
+    }
+    if (first == 1) {
+        body(0);
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+}
+
+//==============================================================================
+// PLAN
+//==============================================================================
+
+/**
+ * @brief Satu langkah OS (satu panggilan IFileOperationBackend)
+ */
+enum FileOperationStep {
+    FILEOPS_STEP_LIST = 0,          /**< ListDirectory/QueryPath saat planning */
+    FILEOPS_STEP_MAKE_DIRECTORY,    /**< MakeDirectory(destination) */
+    FILEOPS_STEP_COPY_FILE,         /**< CopyFileContents(source, destination) */
+    FILEOPS_STEP_MOVE,              /**< MovePath(source, destination) */
+    FILEOPS_STEP_DELETE_FILE,       /**< DeletePath(source, false) */
+    FILEOPS_STEP_REMOVE_DIRECTORY   /**< DeletePath(source, true) */
+};
+
+/**
+ * @brief Satu item kerja dalam plan
+ */
+struct FileOperationItem {
+    FileOperationStep step = FILEOPS_STEP_COPY_FILE;
+    std::wstring source;
+    std::wstring destination;
+    uint64_t size = 0;        /**< Bytes yang disalin (COPY_FILE) */
+    bool unbuffered = false;  /**< COPY_FILE untuk file besar */
+};
+
+/**
+ * @brief Sekelompok item yang dijalankan berurutan oleh satu worker
+ */
+struct FileOperationTask {
+    std::vector<FileOperationItem> items;
+    uint64_t bytes = 0;       /**< Total bytes copy (untuk urutan penjadwalan) */
+};
+
+/**
+ * @brief Task yang boleh berjalan paralel; stage berikutnya menunggu stage ini selesai
+ */
+struct FileOperationStage {
+    std::vector<FileOperationTask> tasks;
+};
+
+/**
+ * @brief Error per item (planning atau eksekusi)
+ */
+struct FileOperationError {
+    uint32_t line = 0;        /**< Baris script */
+    FileOperationStep step = FILEOPS_STEP_LIST;
+    std::wstring path;        /**< Sumber (atau direktori tujuan untuk MAKE_DIRECTORY) */
+    uint32_t code = 0;        /**< Kode error Win32 */
+};
+
+/**
+ * @brief Hasil planning satu baris script
+ */
+struct FileOperationPlan {
+    uint32_t line = 0;
+    std::vector<FileOperationStage> stages;
+    uint64_t itemCount = 0;
+    uint64_t totalBytes = 0;
+    uint64_t directoriesScanned = 0;
+    uint64_t reparsePointsSkipped = 0;        /**< Junction/symlink direktori yang tidak di-copy */
+    uint64_t tasksStolen = 0;                 /**< Direktori yang dicuri worker lain saat walk */
+    std::vector<FileOperationError> errors;   /**< Direktori yang tidak dapat dibaca */
+};
+
+/**
+ * @brief Opsi engine
+ */
+struct FileOperationOptions {
+    unsigned threadCount = 0;                 /**< 0 = jumlah core */
+    OsHandle token = OS_INVALID_HANDLE;       /**< Token yang di-impersonate setiap worker (invalid = tanpa) */
+    uint64_t largeFileThreshold = FILEOPS_LARGE_FILE_SIZE;
+    size_t metadataBatchSize = FILEOPS_METADATA_BATCH;
+    size_t copyBatchSize = FILEOPS_COPY_BATCH;
+    uint64_t copyBatchBytes = FILEOPS_COPY_BATCH_BYTES;
+};
+
+/**
+ * @brief Menyusun plan satu baris script (walk direktori sumber secara paralel)
+ *
+ * Untuk copy/move file ke direktori yang sudah ada, file ditempatkan di
+ * dalam direktori tersebut dengan nama yang sama. Copy direktori menyalin
+ * isinya ke tujuan (dibuat jika belum ada). Delete junction/symlink hanya
+ * menghapus link-nya, tidak pernah isi target.
+ *
+ * @param command Operasi
+ * @param options Opsi thread, token, dan ukuran batch
+ * @param plan Output plan
+ * @return false jika sumber tidak ada/tidak dapat dibaca (plan.errors berisi detail)
+ */
+bool PlanFileOperation(const FileOperationCommand& command, const FileOperationOptions& options,
+                       FileOperationPlan& plan);
+
+//==============================================================================
+// EXECUTION AND REPORT
+//==============================================================================
+
+/**
+ * @brief Statistik dan error seluruh script
+ */
+struct FileOperationReport {
+    uint32_t commandsTotal = 0;
+    uint32_t commandsCompleted = 0;   /**< Baris yang berhasil penuh (eksekusi berhenti di baris gagal pertama) */
+    uint64_t itemsPlanned = 0;
+    uint64_t itemsSucceeded = 0;
+    uint64_t itemsFailed = 0;
+    uint64_t bytesCopied = 0;
+    uint64_t unbufferedCopies = 0;
+    uint64_t directoriesScanned = 0;
+    uint64_t reparsePointsSkipped = 0;
+    uint64_t tasksStolen = 0;
+    unsigned threadCount = 0;
+    double planSeconds = 0.0;         /**< Waktu walk + penyusunan plan */
+    double executeSeconds = 0.0;      /**< Waktu eksekusi stage */
+    uint64_t errorCount = 0;          /**< Semua error, termasuk yang tidak disimpan */
+    std::vector<FileOperationError> errors; /**< Maksimum FILEOPS_MAX_REPORTED_ERRORS */
+
+    /** @brief Throughput copy dalam bytes per detik eksekusi */
+    double BytesPerSecond() const {
+        return executeSeconds > 0.0 ? bytesCopied / executeSeconds : 0.0;
+    }
+
+    /** @brief Item selesai (berhasil atau gagal) per detik eksekusi */
+    double ItemsPerSecond() const {
+        return executeSeconds > 0.0 ? (itemsSucceeded + itemsFailed) / executeSeconds : 0.0;
+    }
+};
+
+/**
+ * @brief Menjalankan semua stage plan dan menambahkan hasilnya ke report
+ *
+ * Item yang gagal tidak menghentikan item lain di stage yang sama.
+ */
+void ExecuteFileOperationPlan(const FileOperationPlan& plan, const FileOperationOptions& options,
+                              FileOperationReport& report);
+
+/**
+ * @brief Plan + eksekusi setiap baris script secara berurutan
+ *
+ * @param commands Hasil ParseFileOperationScript
+ * @param options Opsi engine (token diisi pemanggil setelah akuisisi)
+ * @param report Output statistik dan error
+ * @return true jika semua baris berhasil penuh
+ */
+bool RunFileOperations(const std::vector<FileOperationCommand>& commands, const FileOperationOptions& options,
+                       FileOperationReport& report);
+
+/** @brief Nama langkah untuk report (misalnya "copy") */
+const char* GetFileOperationStepName(FileOperationStep step);
+
+/**
+ * @brief Ringkasan report: jumlah item, throughput, lalu satu baris per error (UTF-8)
+ */
+std::string FormatFileOperationReport(const FileOperationReport& report);
+
+#endif
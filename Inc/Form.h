@@ -8,6 +8,12 @@
 #include <Vcl.StdCtrls.hpp>
 #include <Vcl.Forms.hpp>
 #include <Vcl.Dialogs.hpp>
+#include <string>
+//---------------------------------------------------------------------------
+/** @brief Chunk output capture dari worker (LParam = std::string*, dilepas oleh handler) */
+#define WM_RASTI_CAPTURE_OUTPUT (WM_APP + 1)
+/** @brief Capture selesai (WParam = berhasil, LParam = std::string* report) */
+#define WM_RASTI_CAPTURE_DONE (WM_APP + 2)
 //---------------------------------------------------------------------------
 class TMain : public TForm
 {
@@ -26,11 +32,21 @@ __published:	// IDE-managed Components
 	TLabel *Label4;
 	TLabel *Label5;
 	TLabel *Label6;
+	TCheckBox *CaptureCheck;
 	void __fastcall BrowseButtonClick(TObject *Sender);
 	void __fastcall RunButtonClick(TObject *Sender);
 	void __fastcall ClearButtonClick(TObject *Sender);
 	void __fastcall PathEditKeyPress(TObject *Sender, System::WideChar &Key);
 private:	// User declarations
+	void StartCapturedLaunch(const std::wstring& path, DWORD priority);
+	void AppendCapturedOutput(const std::string& data, UINT codePage = CP_OEMCP);
+	void __fastcall WMCaptureOutput(TMessage& Message);
+	void __fastcall WMCaptureDone(TMessage& Message);
+protected:
+	BEGIN_MESSAGE_MAP
+		VCL_MESSAGE_HANDLER(WM_RASTI_CAPTURE_OUTPUT, TMessage, WMCaptureOutput)
+		VCL_MESSAGE_HANDLER(WM_RASTI_CAPTURE_DONE, TMessage, WMCaptureDone)
+	END_MESSAGE_MAP(TForm)
 public:		// User declarations
 	__fastcall TMain(TComponent* Owner);
 };
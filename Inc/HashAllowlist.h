@@ -0,0 +1,206 @@
+/**
+ * @file HashAllowlist.h
+ * @brief Allowlist SHA-256 executable dan cache hash berbasis identitas file
+ *
+ * Jika allowlist aktif, pipeline validasi menghitung SHA-256 executable dari
+ * handle yang sama dengan yang dipakai untuk launch, lalu menolak file yang
+ * hash-nya tidak terdaftar. Hash disimpan di cache berdasarkan identitas file
+ * (volume + file index + ukuran + waktu modifikasi) sehingga launch ulang
+ * binary yang tidak berubah tidak perlu membaca ulang seluruh isi file.
+ *
+ * Format file allowlist (satu hash per baris, kompatibel dengan output sha256sum):
+ * @code
+ * # Komentar
+ * 3f1c...e9a0  C:\Tools\installer.exe
+ * @endcode
+ *
+ * Header ini portable (tidak bergantung pada Windows.h maupun VCL).
+ *
+ * @author RasTI Development Team
+ * @version 1.2.0.0
+ * @date 2025
+ */
+
+#ifndef RASTI_HASH_ALLOWLIST_H
+#define RASTI_HASH_ALLOWLIST_H
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include "Backend.h"
+#include "Sha256.h"
+
+//==============================================================================
+// CONSTANTS
+//==============================================================================
+
+/** @brief Ukuran view per mapping saat hashing (kelipatan 64KB allocation granularity) */
+const uint32_t HASH_MAP_CHUNK_SIZE = 64 * 1024 * 1024;
+
+/** @brief Ukuran buffer fallback jika memory mapping tidak tersedia */
+const uint32_t HASH_READ_CHUNK_SIZE = 1024 * 1024;
+
+/** @brief Ukuran maksimum file allowlist yang dibaca */
+const uint32_t ALLOWLIST_MAX_FILE_SIZE = 16 * 1024 * 1024;
+
+/** @brief Jumlah entry maksimum cache hash sebelum dikosongkan */
+const size_t HASH_CACHE_MAX_ENTRIES = 4096;
+
+//==============================================================================
+// HASH ALLOWLIST
+//==============================================================================
+
+/**
+ * @brief Index in-memory hash SHA-256 yang diizinkan (lookup O(1))
+ */
+class HashAllowlist {
+private:
+    std::unordered_set<Sha256Digest, Sha256DigestHash> digests_;
+
+public:
+    /**
+     * @brief Parse isi file allowlist dan tambahkan ke index
+     *
+     * Baris kosong dan baris yang diawali '#' diabaikan. Token pertama setiap
+     * baris harus 64 karakter hex; sisa baris (nama file) diabaikan.
+     *
+     * @param text Isi file allowlist
+     * @param errorLine Output nomor baris (1-based) yang tidak valid, boleh NULL
+     * @return true jika semua baris valid
+     *
+     * @note Jika gagal, index dikosongkan (fail closed)
+     */
+    bool LoadFromText(std::string_view text, size_t* errorLine = nullptr);
+
+    /**
+     * @brief Membaca file allowlist melalui backend filesystem aktif
+     *
+     * @param path Path ke file allowlist
+     * @param errorLine Output nomor baris yang tidak valid, boleh NULL
+     * @return true jika file terbaca dan semua baris valid
+     */
+    bool LoadFromFile(std::wstring_view path, size_t* errorLine = nullptr);
+
+    /** @brief Menambahkan satu hash ke index */
+    void Add(const Sha256Digest& digest) { digests_.insert(digest); }
+
+    /** @brief Mengecek apakah hash terdaftar */
+    bool Contains(const Sha256Digest& digest) const { return digests_.count(digest) != 0; }
+
+    /** @brief Jumlah hash di index */
+    size_t Size() const { return digests_.size(); }
+
+    /** @brief Mengosongkan index */
+    void Clear() { digests_.clear(); }
+};
+
+/**
+ * @brief Memasang allowlist yang diterapkan oleh pipeline validasi
+ *
+ * @param allowlist Allowlist aktif, atau NULL untuk menonaktifkan pemeriksaan hash
+ *
+ * @note Pemanggil tetap memiliki object dan harus menjaganya tetap hidup
+ *       selama terpasang (sama seperti SetFileSystemBackend)
+ */
+void SetExecutableAllowlist(const HashAllowlist* allowlist);
+
+/**
+ * @brief Allowlist yang sedang aktif
+ * @return NULL jika pemeriksaan hash tidak aktif
+ */
+const HashAllowlist* GetExecutableAllowlist();
+
+//==============================================================================
+// FILE HASH CACHE
+//==============================================================================
+
+/**
+ * @brief Cache SHA-256 berdasarkan identitas file
+ *
+ * Key mencakup ukuran dan waktu modifikasi sehingga file yang ditulis ulang
+ * otomatis di-hash ulang. Aman dipakai dari beberapa thread.
+ */
+class FileHashCache {
+private:
+    struct Key {
+        uint64_t volumeSerial;
+        uint64_t fileIndex;
+        uint64_t fileSize;
+        uint64_t lastWriteTime;
+
+        bool operator==(const Key& other) const {
+            return volumeSerial == other.volumeSerial && fileIndex == other.fileIndex &&
+                   fileSize == other.fileSize && lastWriteTime == other.lastWriteTime;
+        }
+    };
+
+    struct KeyHash {
+        size_t operator()(const Key& key) const {
+            uint64_t value = key.fileIndex * 0x9E3779B97F4A7C15ULL;
+            value ^= key.volumeSerial + (value << 6) + (value >> 2);
+            value ^= key.lastWriteTime + (value << 6) + (value >> 2);
+            value ^= key.fileSize + (value << 6) + (value >> 2);
+            return static_cast<size_t>(value);
+        }
+    };
+
+    static Key MakeKey(const FileIdentity& identity) {
+        Key key = { identity.volumeSerial, identity.fileIndex, identity.fileSize, identity.lastWriteTime };
+        return key;
+    }
+
+    mutable std::mutex mutex_;
+    std::unordered_map<Key, Sha256Digest, KeyHash> entries_;
+
+public:
+    /** @brief Mencari hash untuk identitas file; true jika ditemukan */
+    bool Lookup(const FileIdentity& identity, Sha256Digest& digest) const;
+
+    /** @brief Menyimpan hash untuk identitas file */
+    void Store(const FileIdentity& identity, const Sha256Digest& digest);
+
+    /** @brief Jumlah entry di cache */
+    size_t Size() const;
+
+    /** @brief Mengosongkan cache */
+    void Clear();
+};
+
+/** @brief Cache hash global yang dipakai pipeline validasi */
+FileHashCache& GetFileHashCache();
+
+//==============================================================================
+// FILE HASHING
+//==============================================================================
+
+/**
+ * @brief Menghitung SHA-256 seluruh isi file dari handle terbuka
+ *
+ * File dipetakan per HASH_MAP_CHUNK_SIZE dan di-hash langsung dari view.
+ * Jika mapping gagal, dibaca per HASH_READ_CHUNK_SIZE dengan ReadFileAt.
+ *
+ * @param fs Backend yang membuka handle
+ * @param file Handle dari OpenFileForValidation
+ * @param fileSize Ukuran file (dari QueryFileIdentity)
+ * @param digest Output hash
+ * @return true jika seluruh file berhasil dibaca
+ */
+bool ComputeFileSha256(IFileSystemBackend* fs, OsHandle file, uint64_t fileSize, Sha256Digest& digest);
+
+/**
+ * @brief Hash file dari handle terbuka, memakai cache jika identitas sama
+ *
+ * @param fs Backend yang membuka handle
+ * @param file Handle dari OpenFileForValidation
+ * @param identity Identitas file dari handle yang sama
+ * @param digest Output hash
+ * @param fromCache Output: true jika hash diambil dari cache, boleh NULL
+ * @return true jika hash tersedia
+ */
+bool GetCachedFileSha256(IFileSystemBackend* fs, OsHandle file, const FileIdentity& identity,
+                         Sha256Digest& digest, bool* fromCache = nullptr);
+
+#endif
@@ -0,0 +1,133 @@
+/**
+ * @file LaunchBenchmark.h
+ * @brief Benchmark latency launch end-to-end (validate + acquire + launch)
+ *
+ * Menjalankan N siklus launch terhadap target trivial dan melaporkan
+ * p50/p90/p99/max per fase, terpisah untuk dua jalur token:
+ * - Cold: setiap siklus menjalankan rantai akuisisi penuh dan validasi
+ *   dengan hash cache kosong (seperti satu kali RasTI.exe dijalankan)
+ * - Warm: token dari TrustedInstallerTokenCache dan hash cache terisi
+ *   (seperti proses yang melakukan banyak launch)
+ *
+ * Dengan commitProbe, setiap siklus juga mencatat pertambahan commit charge
+ * sistem selama launch, sehingga biaya conhost per launch dapat
+ * dibandingkan antar mode console (/console:new vs /console:none).
+ *
+ * Fase launch memakai TrustedInstallerLauncher: baru per siklus di jalur
+ * cold (probe API setiap kali), satu launcher untuk seluruh jalur warm.
+ * Report mencatat API yang membuat setiap proses (asuser atau seclogon).
+ *
+ * Semua panggilan OS melewati backend aktif, sehingga benchmark yang sama
+ * berjalan di Windows (/bench:N) dan di Linux dengan backend palsu yang
+ * diberi latency buatan (rasti_launch_bench).
+ *
+ * Header ini portable (tidak bergantung pada Windows.h maupun VCL).
+ *
+ * @author RasTI Development Team
+ * @version 1.2.0.0
+ * @date 2025
+ */
+
+#ifndef RASTI_LAUNCH_BENCHMARK_H
+#define RASTI_LAUNCH_BENCHMARK_H
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+#include "TrustedInstaller.h"
+
+//==============================================================================
+// PHASES AND PERCENTILES
+//==============================================================================
+
+/** @brief Fase satu siklus launch */
+enum LaunchPhase {
+    LAUNCH_PHASE_VALIDATE = 0,   /**< ValidateExecutable (canonical, open, PE, policy, hash) */
+    LAUNCH_PHASE_ACQUIRE,        /**< Privilege + token Trusted Installer (atau cache hit) */
+    LAUNCH_PHASE_LAUNCH,         /**< CreateProcessAsUserW atau CreateProcessWithTokenW */
+    LAUNCH_PHASE_TOTAL,          /**< Satu siklus penuh */
+    LAUNCH_PHASE_COUNT
+};
+
+/** @brief Nama fase untuk report */
+const char* GetLaunchPhaseName(LaunchPhase phase);
+
+/** @brief Ringkasan distribusi latency (mikrodetik) */
+struct LatencyPercentiles {
+    size_t samples = 0;
+    double p50Us = 0.0;
+    double p90Us = 0.0;
+    double p99Us = 0.0;
+    double maxUs = 0.0;
+};
+
+/**
+ * @brief Menghitung p50/p90/p99/max dengan metode nearest-rank
+ *
+ * @param samplesUs Sampel latency (mikrodetik); diurutkan di tempat
+ */
+LatencyPercentiles ComputeLatencyPercentiles(std::vector<double>& samplesUs);
+
+//==============================================================================
+// BENCHMARK
+//==============================================================================
+
+/** @brief Opsi benchmark launch */
+struct LaunchBenchmarkOptions {
+    std::wstring targetPath;     /**< Executable target (divalidasi setiap siklus) */
+    std::wstring arguments;      /**< Argumen setelah path yang di-quote (opsional) */
+    uint32_t iterations = 100;   /**< Siklus per jalur token (cold dan warm) */
+    uint32_t priority = 0x20;    /**< Priority class (NORMAL_PRIORITY_CLASS) */
+    ConsoleMode console = CONSOLE_MODE_AUTO; /**< Console proses target (AUTO = dari subsystem PE) */
+    ProcessLaunchApi launchApi = LAUNCH_API_AUTO; /**< API launch (lihat TrustedInstallerLauncher) */
+
+    /**
+     * @brief Commit charge sistem saat ini dalam bytes (opsional)
+     *
+     * Dibaca sebelum dan sesudah fase launch; selisihnya mencakup proses
+     * target dan conhost yang sudah dibuat saat launch kembali. Nilai
+     * sistem-wide, sehingga aktivitas lain ikut terukur sebagai noise.
+     */
+    std::function<bool(uint64_t& bytes)> commitProbe;
+};
+
+/** @brief Hasil satu jalur token */
+struct LaunchBenchmarkPath {
+    LatencyPercentiles phases[LAUNCH_PHASE_COUNT];
+    LatencyPercentiles commitKb; /**< Selisih commit per launch dalam KB (field *Us berisi KB); kosong tanpa commitProbe */
+    uint32_t completed = 0;      /**< Siklus yang selesai */
+    uint32_t launchesByApi[LAUNCH_API_COUNT] = {}; /**< Siklus terukur per API yang membuat proses */
+};
+
+/** @brief Hasil benchmark lengkap */
+struct LaunchBenchmarkReport {
+    LaunchBenchmarkPath cold;
+    LaunchBenchmarkPath warm;
+    bool failed = false;
+    LaunchPhase failedPhase = LAUNCH_PHASE_TOTAL; /**< Fase yang gagal (jika failed) */
+    uint32_t errorCode = 0;      /**< Kode error backend, atau ValidationError untuk fase validate */
+    double elapsedSeconds = 0.0;
+};
+
+/**
+ * @brief Menjalankan siklus cold lalu warm dan mengisi report
+ *
+ * Jalur warm didahului satu siklus pemanasan yang tidak diukur untuk mengisi
+ * cache token dan hash cache. Benchmark berhenti pada kegagalan pertama;
+ * fase dan kode error dicatat di report.
+ *
+ * @param options Target dan jumlah siklus
+ * @param report Output
+ * @return true jika semua siklus berhasil
+ *
+ * @warning Setiap siklus benar-benar membuat proses (2 x iterations + 1 proses)
+ */
+bool RunLaunchBenchmark(const LaunchBenchmarkOptions& options, LaunchBenchmarkReport& report);
+
+/**
+ * @brief Format report sebagai tabel teks (satu baris per jalur dan fase)
+ */
+std::string FormatLaunchBenchmarkReport(const LaunchBenchmarkReport& report);
+
+#endif
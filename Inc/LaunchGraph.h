@@ -0,0 +1,206 @@
+/**
+ * @file LaunchGraph.h
+ * @brief Launch banyak proses TI sebagai graf dependensi (/graph)
+ *
+ * Servicing biasanya berurutan: hentikan service dengan A, patch dengan B
+ * dan C paralel, lalu start ulang dengan D. Tanpa graf, urutan tersebut
+ * dirangkai di luar RasTI dengan polling dan setiap langkah mengakuisisi
+ * token sendiri. Manifest /graph mendeskripsikan graf asiklik:
+ * - after-success: node hanya berjalan jika dependensi keluar dengan exit
+ *   code 0; jika tidak, node (dan turunannya lewat after-success) di-skip.
+ * - after-exit: node berjalan setelah dependensi selesai apa pun hasilnya
+ *   (termasuk di-skip, ditolak, atau timeout) - untuk langkah pemulihan.
+ * - timeout per node: proses di-terminate setelah batas waktu.
+ *
+ * Scheduler berjalan di satu thread dengan satu token: node yang siap
+ * dijalankan dalam urutan manifest sampai batas maxRunning, lalu thread
+ * menunggu proses mana pun keluar (IProcessBackend::WaitForAnyProcessExit)
+ * dengan timeout = deadline node terdekat. Report berisi waktu siap, mulai,
+ * dan selesai per node serta critical path: rantai dependensi yang
+ * menentukan total durasi graf.
+ *
+ * Header ini portable (tidak bergantung pada Windows.h maupun VCL).
+ *
+ * @author RasTI Development Team
+ * @version 1.2.0.0
+ * @date 2025
+ */
+
+#ifndef RASTI_LAUNCH_GRAPH_H
+#define RASTI_LAUNCH_GRAPH_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "Backend.h"
+#include "TrustedInstaller.h"
+#include "Validation.h"
+
+//==============================================================================
+// CONSTANTS
+//==============================================================================
+
+/** @brief Ukuran maksimum file manifest */
+const uint32_t LAUNCH_GRAPH_MAX_FILE_SIZE = 16 * 1024 * 1024;
+
+/** @brief Panjang maksimum nama node */
+const size_t LAUNCH_GRAPH_MAX_NAME = 64;
+
+/** @brief Indeks "tidak ada node" (gatedBy node tanpa dependensi) */
+const size_t LAUNCH_GRAPH_NO_NODE = static_cast<size_t>(-1);
+
+//==============================================================================
+// MANIFEST
+//==============================================================================
+
+/**
+ * @brief Jenis edge dependensi
+ */
+enum LaunchDependencyKind {
+    LAUNCH_AFTER_SUCCESS = 0, /**< Dependensi harus keluar dengan exit code 0 */
+    LAUNCH_AFTER_EXIT         /**< Dependensi cukup selesai, apa pun hasilnya */
+};
+
+/**
+ * @brief Satu edge: node bergantung pada node lain
+ */
+struct LaunchDependency {
+    size_t node = 0;                        /**< Indeks node dependensi di LaunchGraph::nodes */
+    LaunchDependencyKind kind = LAUNCH_AFTER_SUCCESS;
+    uint32_t line = 0;                      /**< Baris manifest yang mendeklarasikan edge */
+};
+
+/**
+ * @brief Satu node: executable, argumen, timeout, dan dependensinya
+ */
+struct LaunchGraphNode {
+    std::string name;                       /**< Nama unik di manifest ([A-Za-z0-9_.-]) */
+    uint32_t line = 0;                      /**< Baris "node" di manifest */
+    std::wstring path;                      /**< Path executable (divalidasi saat dijalankan) */
+    std::vector<std::wstring> arguments;
+    uint32_t timeoutMs = 0;                 /**< 0 = LaunchGraphOptions::timeoutMs */
+    std::vector<LaunchDependency> dependencies;
+};
+
+/**
+ * @brief Graf hasil parse
+ */
+struct LaunchGraph {
+    std::vector<LaunchGraphNode> nodes;     /**< Urutan manifest */
+    std::vector<size_t> order;              /**< Urutan topologis (dependensi lebih dulu) */
+};
+
+/**
+ * @brief Parse manifest graf (UTF-8, satu perintah per baris)
+ *
+ * Perintah:
+ *   node NAME EXECUTABLE [ARG...]
+ *   after-success NAME DEPENDENCY [DEPENDENCY...]
+ *   after-exit NAME DEPENDENCY [DEPENDENCY...]
+ *   timeout NAME SECONDS
+ *
+ * Token yang berisi spasi diapit kutip dua; baris kosong dan baris yang
+ * diawali '#' diabaikan. Edge dan timeout boleh merujuk node yang
+ * dideklarasikan di baris berikutnya. Aturan executable dan argumen sama
+ * dengan daftar /batch. Nama duplikat, node yang tidak ada, timeout di luar
+ * 1-86400 detik, dan siklus ditolak.
+ *
+ * @param text Isi file mentah
+ * @param graph Output graf (dikosongkan jika manifest tidak valid)
+ * @param errorLine Output nomor baris yang tidak valid (0 jika valid)
+ * @return false jika manifest tidak valid (tidak ada yang dijalankan)
+ */
+bool ParseLaunchGraph(std::string_view text, LaunchGraph& graph, size_t* errorLine = nullptr);
+
+/**
+ * @brief Membaca manifest melalui backend filesystem aktif dan mem-parse-nya
+ *
+ * @param path File manifest
+ * @param graph Output graf
+ * @param errorLine Output nomor baris yang tidak valid (0 jika file tidak terbaca)
+ */
+bool LoadLaunchGraph(std::wstring_view path, LaunchGraph& graph, size_t* errorLine = nullptr);
+
+//==============================================================================
+// SCHEDULER
+//==============================================================================
+
+/**
+ * @brief Hasil satu node
+ */
+enum LaunchNodeStatus {
+    LAUNCH_NODE_COMPLETED = 0, /**< Proses keluar - exitCode valid */
+    LAUNCH_NODE_SKIPPED,       /**< Dependensi after-success tidak berhasil - tidak dijalankan */
+    LAUNCH_NODE_REJECTED,      /**< Validasi gagal - tidak dijalankan */
+    LAUNCH_NODE_FAILED,        /**< Proses tidak dapat dibuat atau ditunggu (errorCode) */
+    LAUNCH_NODE_TIMED_OUT      /**< Melebihi timeout - proses di-terminate */
+};
+
+/**
+ * @brief Status dan timing satu node (detik sejak graf dimulai)
+ */
+struct LaunchNodeResult {
+    LaunchNodeStatus status = LAUNCH_NODE_SKIPPED;
+    ValidationError validation = VALIDATION_OK; /**< Alasan REJECTED */
+    uint32_t processId = 0;
+    uint32_t exitCode = 0;
+    uint32_t errorCode = 0;                 /**< Kode error Win32 untuk FAILED */
+    double readySeconds = 0.0;              /**< Semua dependensi selesai */
+    double startSeconds = 0.0;              /**< Proses dibuat (> ready jika tertahan maxRunning) */
+    double endSeconds = 0.0;                /**< Proses keluar atau node diputuskan */
+    size_t gatedBy = LAUNCH_GRAPH_NO_NODE;  /**< Dependensi yang selesai terakhir */
+
+    /** @brief true jika proses keluar dengan exit code 0 */
+    bool Succeeded() const { return status == LAUNCH_NODE_COMPLETED && exitCode == 0; }
+};
+
+/**
+ * @brief Opsi scheduler
+ */
+struct LaunchGraphOptions {
+    OsHandle token = OS_INVALID_HANDLE;     /**< Token untuk semua node */
+    uint32_t creationFlags = 0;             /**< Priority class */
+    ConsoleMode console = CONSOLE_MODE_AUTO; /**< AUTO = dari subsystem PE */
+    ProcessLaunchApi api = LAUNCH_API_AUTO;
+    unsigned maxRunning = 0;                /**< Proses bersamaan (0 = PROCESS_WAIT_MAX_OBJECTS) */
+    uint32_t timeoutMs = 0;                 /**< Timeout node tanpa "timeout" (0 = tanpa batas) */
+};
+
+/**
+ * @brief Statistik, hasil per node, dan critical path
+ */
+struct LaunchGraphReport {
+    uint64_t nodesSucceeded = 0;
+    uint64_t nodesFailed = 0;               /**< Ditolak, gagal, timeout, atau exit code != 0 */
+    uint64_t nodesSkipped = 0;
+    uint64_t peakRunning = 0;
+    double seconds = 0.0;
+    std::vector<LaunchNodeResult> results;  /**< Urutan sama dengan LaunchGraph::nodes */
+    std::vector<size_t> criticalPath;       /**< Node dari awal sampai node yang selesai terakhir */
+};
+
+/**
+ * @brief Menjalankan graf sampai semua node selesai atau di-skip
+ *
+ * Node yang gagal tidak menghentikan cabang lain. Jika menunggu proses
+ * gagal, proses yang masih berjalan di-terminate dan node yang belum
+ * dimulai di-skip.
+ *
+ * @param graph Hasil ParseLaunchGraph/LoadLaunchGraph
+ * @param options Token, priority, console, API, paralelisme, dan timeout
+ * @param report Output statistik, hasil per node, dan critical path
+ * @return true jika semua node keluar dengan exit code 0
+ */
+bool RunLaunchGraph(const LaunchGraph& graph, const LaunchGraphOptions& options, LaunchGraphReport& report);
+
+/** @brief Nama status untuk report (misalnya "skipped") */
+const char* GetLaunchNodeStatusName(LaunchNodeStatus status);
+
+/**
+ * @brief Satu baris per node, ringkasan, lalu critical path (UTF-8)
+ */
+std::string FormatLaunchGraphReport(const LaunchGraph& graph, const LaunchGraphReport& report);
+
+#endif
@@ -0,0 +1,203 @@
+/**
+ * @file LaunchPipeline.h
+ * @brief Launch suspended + tahap konfigurasi ber-timing sebelum resume
+ *
+ * Tanpa pipeline, proses TI langsung berjalan setelah CreateProcess*W dan
+ * pengaturan apa pun (job, affinity, prioritas I/O) hanya dapat diterapkan
+ * setelah proses sempat berjalan - child yang dibuat di jendela itu tidak
+ * ikut ter-assign ke job. Pipeline membuat proses dengan CREATE_SUSPENDED,
+ * menjalankan tahap-tahap konfigurasi berurutan, lalu me-resume thread utama:
+ * - Setiap tahap (ILaunchStage) diukur sendiri sehingga biaya per tahap
+ *   terlihat di report (/affinity, /iopriority, ... di CLI).
+ * - Jika satu tahap gagal, tahap yang sudah berjalan di-rollback dalam urutan
+ *   terbalik, proses di-terminate sebelum pernah berjalan, semua object
+ *   milik pipeline ditutup, dan kode error tahap yang gagal dipertahankan.
+ * - Object yang dibuat tahap (misalnya job) didaftarkan ke context dan
+ *   ditutup setelah resume; job dibuat tanpa KILL_ON_JOB_CLOSE sehingga
+ *   limit tetap berlaku selama proses hidup.
+ *
+ * Pembersihan handle warisan tidak memerlukan tahap: kedua API launch
+ * dipanggil dengan bInheritHandles = FALSE.
+ *
+ * Header ini portable (tidak bergantung pada Windows.h maupun VCL).
+ *
+ * @author RasTI Development Team
+ * @version 1.2.0.0
+ * @date 2025
+ */
+
+#ifndef RASTI_LAUNCH_PIPELINE_H
+#define RASTI_LAUNCH_PIPELINE_H
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "Backend.h"
+#include "TrustedInstaller.h"
+
+//==============================================================================
+// STAGES
+//==============================================================================
+
+/**
+ * @brief State satu launch yang dibagi antar tahap
+ */
+struct LaunchStageContext {
+    IProcessBackend* backend = NULL;
+    OsHandle process = OS_INVALID_HANDLE;  /**< Proses suspended */
+    uint32_t processId = 0;
+    std::vector<OsHandle> objects;         /**< Object milik pipeline, ditutup di akhir launch */
+
+    /** @brief Mendaftarkan object untuk ditutup setelah resume atau rollback */
+    void Own(OsHandle object) { objects.push_back(object); }
+};
+
+/**
+ * @brief Satu tahap konfigurasi proses suspended
+ *
+ * Apply dipanggil sebelum resume; jika gagal, kode error tetap di
+ * GetLastErrorCode backend. Rollback hanya dipanggil untuk tahap yang Apply-nya
+ * berhasil, ketika tahap berikutnya gagal. Tahap tidak menyimpan state per
+ * launch sehingga satu pipeline dapat dipakai banyak thread.
+ */
+class ILaunchStage {
+public:
+    virtual ~ILaunchStage() {}
+
+    /** @brief Nama tahap untuk report (misalnya "affinity") */
+    virtual const char* GetName() const = 0;
+
+    virtual bool Apply(LaunchStageContext& context) const = 0;
+
+    virtual void Rollback(LaunchStageContext&) const {}
+};
+
+/**
+ * @brief Membuat job dengan limit lalu meng-assign proses ke job tersebut
+ */
+class JobLaunchStage : public ILaunchStage {
+public:
+    explicit JobLaunchStage(const ProcessJobLimits& limits) : limits_(limits) {}
+
+    const char* GetName() const override { return "job"; }
+    bool Apply(LaunchStageContext& context) const override;
+
+private:
+    ProcessJobLimits limits_;
+};
+
+/**
+ * @brief Satu SetProcessSetting (affinity, prioritas I/O, prioritas memori, ...)
+ */
+class ProcessSettingLaunchStage : public ILaunchStage {
+public:
+    ProcessSettingLaunchStage(ProcessSetting setting, uint64_t value) : setting_(setting), value_(value) {}
+
+    const char* GetName() const override;
+    bool Apply(LaunchStageContext& context) const override;
+
+private:
+    ProcessSetting setting_;
+    uint64_t value_;
+};
+
+/** @brief Nama setting untuk report (misalnya "io-priority") */
+const char* GetProcessSettingName(ProcessSetting setting);
+
+//==============================================================================
+// PIPELINE
+//==============================================================================
+
+/** @brief Durasi satu tahap ("create" dan "resume" juga dicatat) */
+struct LaunchStageTiming {
+    std::string name;
+    double microseconds = 0.0;
+    bool succeeded = false;
+};
+
+/**
+ * @brief Hasil satu launch melalui pipeline
+ */
+struct LaunchPipelineResult {
+    std::vector<LaunchStageTiming> stages; /**< Urutan eksekusi, berhenti di tahap yang gagal */
+    std::string failedStage;               /**< Kosong jika launch berhasil */
+    uint32_t errorCode = 0;                /**< Kode error tahap yang gagal */
+    bool rolledBack = false;               /**< Proses di-terminate sebelum berjalan */
+};
+
+/**
+ * @brief Daftar tahap yang dijalankan di antara create suspended dan resume
+ */
+class LaunchPipeline {
+public:
+    /** @brief Menambahkan tahap di akhir pipeline */
+    void Add(std::unique_ptr<ILaunchStage> stage) { stages_.push_back(std::move(stage)); }
+
+    bool IsEmpty() const { return stages_.empty(); }
+
+    size_t GetStageCount() const { return stages_.size(); }
+
+    /**
+     * @brief Create suspended, jalankan semua tahap, lalu resume
+     *
+     * @param launcher Launcher yang memilih API (sama seperti LaunchWithToken)
+     * @param token Token Trusted Installer
+     * @param request Request launch; PROCESS_CREATE_SUSPENDED ditambahkan
+     * @param processId Output PID (opsional)
+     * @param process Output handle proses (opsional; ditutup pemanggil)
+     * @param usedApi Output API yang membuat proses (opsional)
+     * @param result Output timing per tahap (opsional)
+     * @return true jika proses dibuat, dikonfigurasi, dan berjalan
+     *
+     * @note Jika gagal, proses tidak pernah berjalan dan kode error tahap
+     *       yang gagal dipertahankan di GetLastErrorCode backend
+     */
+    bool Launch(TrustedInstallerLauncher& launcher, OsHandle token, const ProcessLaunchRequest& request,
+                uint32_t* processId = NULL, OsHandle* process = NULL, ProcessLaunchApi* usedApi = NULL,
+                LaunchPipelineResult* result = NULL) const;
+
+private:
+    std::vector<std::unique_ptr<ILaunchStage>> stages_;
+};
+
+//==============================================================================
+// SETTINGS
+//==============================================================================
+
+/** @brief Nilai "tidak diatur" untuk LaunchStageSettings */
+const uint32_t LAUNCH_SETTING_UNSET = 0xFFFFFFFF;
+
+/**
+ * @brief Pengaturan launch dari CLI atau trace session
+ */
+struct LaunchStageSettings {
+    uint64_t affinityMask = 0;                    /**< 0 = tidak diatur */
+    uint32_t ioPriority = LAUNCH_SETTING_UNSET;   /**< 0 very low, 1 low, 2 normal */
+    uint32_t memoryPriority = LAUNCH_SETTING_UNSET; /**< 1 (very low) - 5 (normal) */
+    uint64_t jobMemoryLimit = 0;                  /**< Byte per proses, 0 = tanpa job */
+
+    bool IsEmpty() const {
+        return affinityMask == 0 && ioPriority == LAUNCH_SETTING_UNSET &&
+               memoryPriority == LAUNCH_SETTING_UNSET && jobMemoryLimit == 0;
+    }
+};
+
+/**
+ * @brief Mengisi pipeline dari pengaturan
+ *
+ * Job ditambahkan pertama agar limit berlaku sebelum tahap lain, lalu
+ * affinity, prioritas I/O, dan prioritas memori.
+ */
+void ConfigureLaunchPipeline(const LaunchStageSettings& settings, LaunchPipeline& pipeline);
+
+/** @brief Parse "verylow", "low", atau "normal" (case-insensitive) ke nilai prioritas I/O */
+bool ParseIoPriority(std::string_view name, uint32_t& ioPriority);
+
+/**
+ * @brief Satu baris per tahap dengan durasi, lalu tahap yang gagal (UTF-8)
+ */
+std::string FormatLaunchPipelineResult(const LaunchPipelineResult& result);
+
+#endif
@@ -0,0 +1,326 @@
+/**
+ * @file OutputCapture.h
+ * @brief Capture stdout/stderr proses Trusted Installer (/capture, /batch)
+ *
+ * Launch biasa memakai CREATE_NEW_CONSOLE sehingga output proses TI muncul
+ * di window terpisah dan hilang saat proses keluar. Engine capture membuat
+ * proses dengan stdout dan stderr berupa pipe, lalu satu pump
+ * (IOutputCaptureBackend::WaitCaptureEvent di atas satu completion port)
+ * melayani pipe dan notifikasi exit semua proses sekaligus:
+ * - Setiap chunk output diberikan ke callback sebagai string_view ke buffer
+ *   read backend; engine tidak menyalin maupun memecah output per baris.
+ * - CaptureConsoleWriter meneruskan chunk ke console (dengan tag "[N] " di
+ *   awal baris jika banyak proses berjalan), CaptureLogWriter ke satu log
+ *   file per launch yang dirotasi berdasarkan ukuran.
+ * - /batch menjalankan banyak executable paralel dengan satu token;
+ *   maxRunning membatasi jumlah proses yang berjalan bersamaan.
+ * - CaptureOptions::single melewati (atau menunggu) executable yang sudah
+ *   berjalan, termasuk yang di-launch lebih awal di batch yang sama.
+ * - CaptureOptions::accounting membaca CPU time, peak memory, I/O, dan
+ *   jumlah proses dari job setiap launch saat selesai (satu query per
+ *   launch, tanpa sampling selama proses berjalan).
+ *
+ * Setiap executable divalidasi dengan ValidateExecutable (policy dan
+ * allowlist tetap berlaku) dan handle-nya tetap terbuka sampai proses
+ * dibuat.
+ *
+ * Header ini portable (tidak bergantung pada Windows.h maupun VCL).
+ *
+ * @author RasTI Development Team
+ * @version 1.2.0.0
+ * @date 2025
+ */
+
+#ifndef RASTI_OUTPUT_CAPTURE_H
+#define RASTI_OUTPUT_CAPTURE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "Backend.h"
+#include "SingleInstance.h"
+#include "TrustedInstaller.h"
+#include "Validation.h"
+
+//==============================================================================
+// CONSTANTS
+//==============================================================================
+
+/** @brief Ukuran maksimum file daftar launch (/batch) */
+const uint32_t CAPTURE_MAX_LIST_FILE_SIZE = 16 * 1024 * 1024;
+
+/** @brief Ukuran log file sebelum dirotasi (default /logsize) */
+const uint64_t CAPTURE_DEFAULT_LOG_SIZE = 16 * 1024 * 1024;
+
+/** @brief Jumlah log lama yang disimpan per launch (NAME.1.log .. NAME.4.log) */
+const unsigned CAPTURE_LOG_ROTATIONS = 4;
+
+/** @brief Setelah proses keluar, batas waktu menunggu pipe yang masih dipegang proses turunan */
+const uint32_t CAPTURE_DRAIN_TIMEOUT_MS = 2000;
+
+/** @brief Interval pengecekan exit langsung (cadangan jika notifikasi job tidak tersedia) */
+const uint32_t CAPTURE_EXIT_CHECK_MS = 1000;
+
+//==============================================================================
+// LAUNCH LIST
+//==============================================================================
+
+/**
+ * @brief Satu baris daftar launch: EXECUTABLE [ARG...]
+ */
+struct CaptureLaunch {
+    uint32_t line = 0;                  /**< Nomor baris di file daftar (0 = bukan dari file) */
+    std::wstring path;                  /**< Path executable (divalidasi saat dijalankan) */
+    std::vector<std::wstring> arguments;
+};
+
+/**
+ * @brief Parse daftar launch (UTF-8, satu executable per baris)
+ *
+ * Path dan argumen dipisah blank; token yang berisi spasi diapit kutip
+ * dua. Baris kosong dan baris yang diawali '#' diabaikan. Extension harus
+ * .exe/.com/.bat/.cmd. Karakter kontrol ditolak, dan argumen script
+ * .bat/.cmd tidak boleh berisi %, ^, atau kutip (diekspansi ulang oleh cmd.exe).
+ *
+ * @param text Isi file mentah
+ * @param launches Output launch (dikosongkan jika file tidak valid)
+ * @param errorLine Output nomor baris yang tidak valid (0 jika valid)
+ * @return false jika ada baris yang tidak valid (tidak ada yang dijalankan)
+ */
+bool ParseCaptureLaunchList(std::string_view text, std::vector<CaptureLaunch>& launches, size_t* errorLine = nullptr);
+
+/**
+ * @brief Membaca daftar launch melalui backend filesystem aktif dan mem-parse-nya
+ *
+ * @param path File daftar launch
+ * @param launches Output launch
+ * @param errorLine Output nomor baris yang tidak valid (0 jika file tidak terbaca)
+ */
+bool LoadCaptureLaunchList(std::wstring_view path, std::vector<CaptureLaunch>& launches, size_t* errorLine = nullptr);
+
+//==============================================================================
+// ENGINE
+//==============================================================================
+
+/**
+ * @brief Hasil satu launch
+ */
+enum CaptureLaunchStatus {
+    CAPTURE_LAUNCH_COMPLETED = 0, /**< Proses keluar - exitCode valid */
+    CAPTURE_LAUNCH_REJECTED,      /**< Validasi gagal - tidak dijalankan */
+    CAPTURE_LAUNCH_FAILED,        /**< Proses tidak dapat dibuat atau pump gagal (errorCode) */
+    CAPTURE_LAUNCH_TIMED_OUT,     /**< Melebihi timeout - proses dan turunannya di-terminate (instance attach tidak) */
+    CAPTURE_LAUNCH_SKIPPED,       /**< /single: instance sudah berjalan (processId) - tidak dijalankan */
+    CAPTURE_LAUNCH_ATTACHED       /**< /single:attach: instance yang ada ditunggu - exitCode valid, tanpa output */
+};
+
+/**
+ * @brief Status, exit code, dan volume output satu launch
+ */
+struct CaptureLaunchResult {
+    uint32_t line = 0;
+    std::wstring path;                          /**< Canonical path jika validasi berhasil */
+    ExecutableKind kind = EXECUTABLE_KIND_UNKNOWN;
+    CaptureLaunchStatus status = CAPTURE_LAUNCH_REJECTED;
+    ValidationError validation = VALIDATION_OK; /**< Alasan REJECTED */
+    uint32_t processId = 0;                     /**< SKIPPED/ATTACHED = PID instance yang sudah berjalan */
+    uint32_t exitCode = 0;
+    uint32_t errorCode = 0;                     /**< Kode error Win32 untuk FAILED */
+    uint64_t stdoutBytes = 0;
+    uint64_t stderrBytes = 0;
+    bool outputDetached = false;                /**< Pipe masih dipegang proses turunan saat capture dihentikan */
+    double seconds = 0.0;
+    bool hasAccounting = false;                 /**< accounting valid (CaptureOptions::accounting dan job tersedia) */
+    ProcessAccounting accounting;               /**< Total job proses dan turunannya saat selesai */
+
+    /** @brief true jika proses (atau instance yang ditunggu) keluar dengan exit code 0, atau di-skip */
+    bool Succeeded() const {
+        return status == CAPTURE_LAUNCH_SKIPPED ||
+               ((status == CAPTURE_LAUNCH_COMPLETED || status == CAPTURE_LAUNCH_ATTACHED) && exitCode == 0);
+    }
+};
+
+/**
+ * @brief Penerima chunk output: indeks launch, stream, dan data
+ *
+ * Data menunjuk ke buffer backend dan hanya valid selama callback berjalan.
+ * Callback dipanggil dari thread yang memanggil RunCapturedLaunches.
+ */
+typedef std::function<void(size_t launch, CaptureStream stream, std::string_view data)> CaptureOutputCallback;
+
+/**
+ * @brief Opsi engine
+ */
+struct CaptureOptions {
+    OsHandle token = OS_INVALID_HANDLE;   /**< Token untuk semua proses */
+    uint32_t creationFlags = 0;           /**< Priority class */
+    ConsoleMode console = CONSOLE_MODE_AUTO; /**< AUTO = hidden untuk console/script, none untuk GUI */
+    unsigned maxRunning = 0;              /**< Proses yang berjalan bersamaan (0 = semua sekaligus) */
+    uint32_t timeoutMs = 0;               /**< Batas waktu per launch (0 = tanpa batas) */
+    SingleInstanceMode single = SINGLE_INSTANCE_OFF; /**< Perilaku jika executable sudah berjalan */
+    bool accounting = false;              /**< Baca accounting job setiap launch saat selesai */
+};
+
+/**
+ * @brief Statistik dan hasil per launch
+ */
+struct CaptureReport {
+    uint64_t launchesSucceeded = 0;
+    uint64_t launchesFailed = 0;
+    uint64_t launchesSkipped = 0;         /**< SKIPPED + ATTACHED (juga dihitung di succeeded/failed) */
+    uint64_t peakRunning = 0;             /**< Proses terbanyak yang berjalan bersamaan */
+    uint64_t bytesCaptured = 0;
+    uint64_t events = 0;                  /**< Event yang dilayani pump */
+    double seconds = 0.0;
+    RunningImageStats singleInstance;     /**< Biaya pemeriksaan /single (kosong jika OFF) */
+    uint64_t launchesAccounted = 0;       /**< Launch dengan hasAccounting */
+    ProcessAccounting accounting;         /**< Jumlah semua launch (peakMemoryBytes = maksimum) */
+    std::vector<CaptureLaunchResult> results; /**< Urutan sama dengan daftar launch */
+};
+
+/**
+ * @brief Menjalankan launch dengan output di-capture oleh satu pump
+ *
+ * Launch yang gagal dilaporkan tanpa menghentikan launch berikutnya.
+ * Fungsi kembali setelah semua proses keluar (atau timeout) dan semua
+ * output diteruskan ke callback. Dengan options.single, satu snapshot
+ * proses diambil sebelum launch pertama; instance yang di-attach ditunggu
+ * setelah semua proses yang di-capture selesai. Dengan options.accounting,
+ * job setiap proses yang di-capture di-query tepat sebelum handle-nya
+ * ditutup (instance yang di-attach bukan milik RasTI dan tidak di-query).
+ *
+ * @param launches Hasil ParseCaptureLaunchList/LoadCaptureLaunchList
+ * @param options Token, priority, paralelisme, dan timeout
+ * @param output Penerima chunk output (kosong = output dibuang)
+ * @param report Output statistik dan hasil per launch
+ * @return true jika semua proses keluar dengan exit code 0
+ */
+bool RunCapturedLaunches(const std::vector<CaptureLaunch>& launches, const CaptureOptions& options,
+                         const CaptureOutputCallback& output, CaptureReport& report);
+
+/** @brief Nama status untuk report (misalnya "timed-out") */
+const char* GetCaptureLaunchStatusName(CaptureLaunchStatus status);
+
+/**
+ * @brief Satu baris per launch lalu ringkasan (UTF-8)
+ */
+std::string FormatCaptureReport(const CaptureReport& report);
+
+/**
+ * @brief Hasil per launch dan ringkasan sebagai satu objek JSON (/batch /out:FILE)
+ *
+ * Field "accounting" hanya ada untuk launch dengan hasAccounting.
+ */
+std::string FormatCaptureReportJson(const CaptureReport& report);
+
+/**
+ * @brief Ringkasan accounting satu baris tanpa newline
+ *        (misalnya "cpu 1.250 s user + 0.130 s kernel, peak 42.0 MB, ...")
+ */
+std::string FormatProcessAccounting(const ProcessAccounting& accounting);
+
+//==============================================================================
+// OUTPUT WRITERS
+//==============================================================================
+
+/**
+ * @brief Meneruskan chunk output ke console
+ *
+ * Tanpa tag, chunk diteruskan apa adanya. Dengan tag, setiap baris diberi
+ * prefix "[N] " (N = nomor launch, mulai dari 1) dan baris yang belum
+ * selesai ditutup dengan newline sebelum launch lain menulis, sehingga
+ * output proses paralel tidak bercampur di satu baris. Data ditulis
+ * sebagai potongan dari chunk asli tanpa salinan.
+ *
+ * @note Tidak thread-safe; dipanggil dari callback RunCapturedLaunches
+ */
+class CaptureConsoleWriter {
+public:
+    /** @brief Tujuan tulis: stream asal (stdout/stderr) dan bytes */
+    typedef std::function<void(CaptureStream stream, std::string_view data)> Sink;
+
+    CaptureConsoleWriter(Sink sink, bool tagLines);
+
+    /** @brief Meneruskan satu chunk dari launch ke-launch (indeks mulai dari 0) */
+    void Write(size_t launch, CaptureStream stream, std::string_view data);
+
+    /** @brief Menutup baris terakhir yang belum diakhiri newline */
+    void Finish();
+
+private:
+    Sink sink_;
+    bool tagLines_;
+    bool atLineStart_ = true;
+    size_t lastLaunch_ = 0;
+    CaptureStream lastStream_ = CAPTURE_STREAM_STDOUT;
+};
+
+/**
+ * @brief Satu log file per launch dengan rotasi berdasarkan ukuran
+ *
+ * Log launch ke-N (mulai dari 1) adalah DIR\N-NAMA.log, dengan NAMA = nama
+ * file executable. stdout dan stderr ditulis ke file yang sama sesuai urutan
+ * kedatangan. File dibuat saat output pertama tiba (launch tanpa output
+ * tidak membuat file). Jika file akan melebihi maxBytes, file dirotasi ke
+ * N-NAMA.1.log (yang lama bergeser sampai .rotations.log) di batas baris
+ * terakhir yang muat. Semua file ditulis langsung dari chunk melalui
+ * IOutputCaptureBackend.
+ *
+ * @note Tidak thread-safe; dipanggil dari callback RunCapturedLaunches
+ */
+class CaptureLogWriter {
+public:
+    /**
+     * @param directory Direktori log (harus sudah ada)
+     * @param launches Daftar launch yang sama dengan RunCapturedLaunches
+     * @param maxBytes Ukuran maksimum satu file (minimal 1)
+     * @param rotations File lama yang disimpan (0 = file di-truncate saat penuh)
+     */
+    CaptureLogWriter(const std::wstring& directory, const std::vector<CaptureLaunch>& launches,
+                     uint64_t maxBytes = CAPTURE_DEFAULT_LOG_SIZE, unsigned rotations = CAPTURE_LOG_ROTATIONS);
+    ~CaptureLogWriter();
+
+    /**
+     * @brief Menambahkan chunk ke log launch
+     * @return false jika log launch ini gagal dibuat/ditulis (output berikutnya dibuang)
+     */
+    bool Write(size_t launch, std::string_view data);
+
+    /** @brief Menutup semua log file */
+    void Close();
+
+    /** @brief Path log file aktif launch (indeks mulai dari 0) */
+    std::wstring GetLogPath(size_t launch) const;
+
+    /** @brief Jumlah rotasi yang sudah dilakukan */
+    uint64_t GetRotationCount() const { return rotationCount_; }
+
+    /** @brief Kode error pertama (0 = tidak ada kegagalan) */
+    uint32_t GetErrorCode() const { return error_; }
+
+    CaptureLogWriter(const CaptureLogWriter&) = delete;
+    CaptureLogWriter& operator=(const CaptureLogWriter&) = delete;
+
+private:
+    struct LogFile {
+        std::wstring base;                  /**< DIR\N-NAMA tanpa ".log" */
+        OsHandle file = OS_INVALID_HANDLE;
+        uint64_t size = 0;
+        bool failed = false;
+    };
+
+    bool Rotate(LogFile& log);
+    bool Fail(LogFile& log);
+
+    IOutputCaptureBackend* backend_;
+    std::vector<LogFile> logs_;
+    uint64_t maxBytes_;
+    unsigned rotations_;
+    uint64_t rotationCount_ = 0;
+    uint32_t error_ = 0;
+};
+
+#endif
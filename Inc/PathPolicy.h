@@ -0,0 +1,201 @@
+/**
+ * @file PathPolicy.h
+ * @brief Engine policy path (allow/deny) yang dikompilasi ke trie + glob automata
+ *
+ * Rule policy menentukan direktori mana yang boleh dijalankan, misalnya:
+ * @code
+ * # Hanya tools yang sudah disetujui
+ * allow C:\Tools\**
+ * allow C:\Windows\System32\*.exe
+ * # Folder yang dapat ditulis user selalu ditolak
+ * deny  C:\Users\*\AppData\**
+ * deny  **\Temp\**
+ * @endcode
+ *
+ * Semua rule dikompilasi satu kali menjadi trie per komponen path
+ * (case-insensitive). Komponen literal disimpan di hash map per node,
+ * komponen dengan wildcard ('*', '?') menjadi edge glob kecil, dan "**"
+ * menjadi state yang dapat menerima nol atau lebih komponen. Evaluasi
+ * berjalan sekali dari kiri ke kanan pada path, sehingga biayanya sebanding
+ * dengan panjang path - bukan jumlah rule.
+ *
+ * Keputusan:
+ * - Rule deny yang cocok selalu menang (deny mengalahkan allow)
+ * - Jika ada minimal satu rule allow, path harus cocok dengan salah satunya
+ * - Tanpa rule allow, semua path yang tidak di-deny diizinkan
+ *
+ * Header ini portable (tidak bergantung pada Windows.h maupun VCL).
+ *
+ * @author RasTI Development Team
+ * @version 1.2.0.0
+ * @date 2025
+ */
+
+#ifndef RASTI_PATH_POLICY_H
+#define RASTI_PATH_POLICY_H
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+//==============================================================================
+// CONSTANTS
+//==============================================================================
+
+/** @brief Ukuran maksimum file policy yang dibaca */
+const uint32_t PATH_POLICY_MAX_FILE_SIZE = 16 * 1024 * 1024;
+
+//==============================================================================
+// RESULT TYPES
+//==============================================================================
+
+/**
+ * @brief Aksi sebuah rule policy
+ */
+enum PathPolicyAction {
+    POLICY_ACTION_ALLOW = 0, /**< Path yang cocok boleh dijalankan */
+    POLICY_ACTION_DENY       /**< Path yang cocok selalu ditolak */
+};
+
+/**
+ * @brief Hasil evaluasi policy untuk satu path
+ */
+enum PathPolicyDecision {
+    POLICY_DECISION_ALLOWED = 0, /**< Tidak ada deny dan (jika ada allow) cocok dengan allow */
+    POLICY_DECISION_DENIED,      /**< Cocok dengan rule deny */
+    POLICY_DECISION_NOT_ALLOWED  /**< Ada rule allow tetapi tidak satu pun cocok */
+};
+
+/**
+ * @brief Detail hasil evaluasi policy
+ */
+struct PathPolicyMatch {
+    PathPolicyDecision decision = POLICY_DECISION_ALLOWED; /**< Keputusan akhir */
+    uint32_t ruleLine = 0;  /**< Baris rule (file) atau urutan rule (AddRule) yang menentukan, 0 jika tidak ada */
+};
+
+//==============================================================================
+// PATH POLICY
+//==============================================================================
+
+/**
+ * @brief Kumpulan rule allow/deny yang sudah dikompilasi
+ *
+ * Object ini tidak dapat di-copy (key hash map menunjuk ke string pool
+ * milik object), tetapi aman dibaca dari beberapa thread sekaligus setelah
+ * selesai dimuat.
+ */
+class PathPolicy {
+private:
+    /** @brief Nilai "tidak ada" untuk index node dan rule */
+    static const uint32_t NONE = 0xFFFFFFFFu;
+
+    /** @brief Satu state di trie komponen path */
+    struct Node {
+        std::unordered_map<std::wstring_view, uint32_t> literals; /**< Komponen literal (uppercase) -> node */
+        std::vector<std::pair<std::wstring_view, uint32_t>> globs; /**< Komponen dengan '*'/'?' -> node */
+        uint32_t recursive = NONE;  /**< Child untuk komponen "**" */
+        bool isRecursive = false;   /**< Node ini adalah state "**" (menerima komponen apa pun) */
+        uint32_t allowRule = NONE;  /**< Rule allow pertama yang berakhir di node ini */
+        uint32_t denyRule = NONE;   /**< Rule deny pertama yang berakhir di node ini */
+    };
+
+    std::vector<Node> nodes_;             /**< nodes_[0] adalah root */
+    std::deque<std::wstring> segments_;   /**< Pool string komponen (alamat stabil) */
+    std::vector<uint32_t> ruleLines_;     /**< Nomor baris/urutan setiap rule */
+    size_t allowCount_ = 0;
+
+    uint32_t AddChild(uint32_t parent, std::wstring_view segment);
+    bool AddRuleAtLine(PathPolicyAction action, std::wstring_view pattern, uint32_t line);
+    void AddState(std::vector<uint32_t>& states, uint32_t node) const;
+
+public:
+    PathPolicy() { Clear(); }
+
+    PathPolicy(const PathPolicy&) = delete;
+    PathPolicy& operator=(const PathPolicy&) = delete;
+
+    /**
+     * @brief Menambahkan dan mengkompilasi satu rule
+     *
+     * Pattern adalah path absolute dengan wildcard per komponen:
+     * '*' (nol atau lebih karakter), '?' (satu karakter), dan komponen "**"
+     * (nol atau lebih direktori). Separator akhir ("C:\Tools\") berarti
+     * "C:\Tools\**".
+     *
+     * @param action Allow atau deny
+     * @param pattern Pattern path
+     * @return false jika pattern kosong atau mengandung komponen "." / ".."
+     */
+    bool AddRule(PathPolicyAction action, std::wstring_view pattern);
+
+    /**
+     * @brief Parse isi file policy (UTF-8) dan tambahkan rule-nya
+     *
+     * Format per baris: "allow <pattern>" atau "deny <pattern>" (keyword
+     * case-insensitive, pattern boleh diberi tanda kutip). Baris kosong dan
+     * baris yang diawali '#' diabaikan.
+     *
+     * @param text Isi file policy
+     * @param errorLine Output nomor baris (1-based) yang tidak valid, boleh NULL
+     * @return true jika semua baris valid
+     *
+     * @note Jika gagal, policy dikosongkan lalu diisi satu rule "deny **" (fail closed)
+     */
+    bool LoadFromText(std::string_view text, size_t* errorLine = nullptr);
+
+    /**
+     * @brief Membaca file policy melalui backend filesystem aktif
+     *
+     * @param path Path ke file policy
+     * @param errorLine Output nomor baris yang tidak valid, boleh NULL
+     * @return true jika file terbaca dan semua baris valid
+     */
+    bool LoadFromFile(std::wstring_view path, size_t* errorLine = nullptr);
+
+    /**
+     * @brief Mengevaluasi path terhadap semua rule
+     *
+     * @param path Path absolute (canonical); prefix "\\?\" dan "\\?\UNC\" dinormalisasi
+     * @param match Output detail keputusan, boleh NULL
+     * @return Keputusan policy
+     */
+    PathPolicyDecision Evaluate(std::wstring_view path, PathPolicyMatch* match = nullptr) const;
+
+    /** @brief Jumlah rule yang sudah dikompilasi */
+    size_t RuleCount() const { return ruleLines_.size(); }
+
+    /** @brief Jumlah state di trie (untuk diagnostik/benchmark) */
+    size_t NodeCount() const { return nodes_.size(); }
+
+    /** @brief Menghapus semua rule */
+    void Clear();
+};
+
+/**
+ * @brief Memasang policy path yang diterapkan oleh pipeline validasi
+ *
+ * @param policy Policy aktif, atau NULL untuk menonaktifkan pemeriksaan policy
+ *
+ * @note Pemanggil tetap memiliki object dan harus menjaganya tetap hidup
+ *       selama terpasang (sama seperti SetExecutableAllowlist)
+ */
+void SetPathPolicy(const PathPolicy* policy);
+
+/**
+ * @brief Policy path yang sedang aktif
+ * @return NULL jika pemeriksaan policy tidak aktif
+ */
+const PathPolicy* GetPathPolicy();
+
+/**
+ * @brief Nama singkat untuk keputusan policy (untuk logging/report)
+ */
+const char* GetPathPolicyDecisionName(PathPolicyDecision decision);
+
+#endif
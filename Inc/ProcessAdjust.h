@@ -0,0 +1,178 @@
+/**
+ * @file ProcessAdjust.h
+ * @brief Mengubah prioritas dan affinity proses yang sudah berjalan secara massal (/adjust)
+ *
+ * Mengubah proses yang sedang berjalan (misalnya menurunkan prioritas semua
+ * instance scanner) sebelumnya memerlukan tool lain atau launch ulang lewat
+ * RasTI. /adjust mencocokkan proses dengan selector lalu menerapkan
+ * pengaturan yang sama dengan tahap launch pipeline:
+ * - Satu ToolHelp32 snapshot (IProcessBackend::EnumerateProcesses) diindeks
+ *   berdasarkan PID dan nama image, sehingga ratusan selector dan ratusan
+ *   proses yang cocok dilayani tanpa snapshot atau pencarian linear ulang.
+ * - Selector path hanya membuka kandidat dengan nama file yang sama;
+ *   handle yang dibuka untuk verifikasi path dipakai ulang untuk mengubah
+ *   pengaturan (satu OpenProcess per proses).
+ * - Setiap pengaturan diterapkan terpisah: kegagalan satu pengaturan atau
+ *   satu proses tidak menghentikan yang lain, dan kode error dicatat per
+ *   proses per pengaturan.
+ *
+ * Engine tidak mengakuisisi token: pemanggil menjalankannya di bawah
+ * impersonation Trusted Installer (RunAsTrustedInstaller) agar proses yang
+ * dilindungi DACL juga dapat dibuka.
+ *
+ * Header ini portable (tidak bergantung pada Windows.h maupun VCL).
+ *
+ * @author RasTI Development Team
+ * @version 1.2.0.0
+ * @date 2025
+ */
+
+#ifndef RASTI_PROCESS_ADJUST_H
+#define RASTI_PROCESS_ADJUST_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "Backend.h"
+#include "LaunchPipeline.h"
+
+//==============================================================================
+// SELECTORS
+//==============================================================================
+
+/**
+ * @brief Cara selector mencocokkan proses
+ */
+enum ProcessSelectorKind {
+    PROCESS_SELECT_ID = 0, /**< PID persis */
+    PROCESS_SELECT_NAME,   /**< Nama image, case-insensitive (misalnya "svchost.exe") */
+    PROCESS_SELECT_PATH    /**< Path lengkap executable, case-insensitive */
+};
+
+/**
+ * @brief Satu selector dari command line
+ */
+struct ProcessSelector {
+    ProcessSelectorKind kind = PROCESS_SELECT_NAME;
+    uint32_t processId = 0;  /**< Untuk PROCESS_SELECT_ID */
+    std::wstring text;       /**< Teks asli (nama atau path) */
+};
+
+/**
+ * @brief Parse satu selector
+ *
+ * Hanya digit = PID, mengandung '\' atau '/' = path executable, selain itu
+ * nama image. PID 0 dan nama/path kosong ditolak.
+ */
+bool ParseProcessSelector(std::wstring_view text, ProcessSelector& selector);
+
+//==============================================================================
+// PROCESS TABLE
+//==============================================================================
+
+/**
+ * @brief Snapshot proses dengan indeks PID dan nama image
+ */
+class ProcessTable {
+public:
+    /**
+     * @brief Mengambil snapshot baru dan membangun ulang indeks
+     * @return false jika EnumerateProcesses gagal (tabel kosong)
+     */
+    bool Load(IProcessBackend* backend);
+
+    const std::vector<ProcessEntry>& GetEntries() const { return entries_; }
+
+    /** @brief Indeks entri dengan PID tersebut, atau SIZE_MAX */
+    size_t FindById(uint32_t processId) const;
+
+    /** @brief Indeks semua entri dengan nama image tersebut (case-insensitive, urutan snapshot) */
+    const std::vector<size_t>& FindByName(std::wstring_view imageName) const;
+
+private:
+    std::vector<ProcessEntry> entries_;
+    std::unordered_map<uint32_t, size_t> byId_;
+    std::unordered_map<std::wstring, std::vector<size_t>> byName_; /**< Nama uppercase -> entri */
+    std::vector<size_t> none_;
+};
+
+//==============================================================================
+// ENGINE
+//==============================================================================
+
+/**
+ * @brief Pengaturan yang diterapkan ke setiap proses yang cocok
+ *
+ * Pengaturan yang tidak diatur tidak disentuh. Jika semuanya tidak diatur,
+ * AdjustProcesses hanya melaporkan proses yang cocok.
+ */
+struct ProcessAdjustment {
+    uint32_t priorityClass = 0;                   /**< *_PRIORITY_CLASS, 0 = tidak diatur */
+    uint64_t affinityMask = 0;                    /**< 0 = tidak diatur */
+    uint32_t ioPriority = LAUNCH_SETTING_UNSET;   /**< 0 very low, 1 low, 2 normal */
+    uint32_t memoryPriority = LAUNCH_SETTING_UNSET; /**< 1 (very low) - 5 (normal) */
+
+    bool IsEmpty() const {
+        return priorityClass == 0 && affinityMask == 0 && ioPriority == LAUNCH_SETTING_UNSET &&
+               memoryPriority == LAUNCH_SETTING_UNSET;
+    }
+};
+
+/**
+ * @brief Hasil satu pengaturan pada satu proses
+ */
+struct ProcessSettingResult {
+    ProcessSetting setting = PROCESS_SETTING_PRIORITY_CLASS;
+    uint32_t errorCode = 0;                 /**< 0 = berhasil */
+};
+
+/**
+ * @brief Hasil satu proses yang cocok
+ */
+struct ProcessAdjustResult {
+    uint32_t processId = 0;
+    std::wstring imageName;
+    std::wstring path;                      /**< Diisi jika dicocokkan lewat selector path */
+    uint32_t openError = 0;                 /**< Kode error OpenProcessHandle (0 = terbuka) */
+    std::vector<ProcessSettingResult> settings; /**< Urutan: priority, affinity, I/O, memori */
+
+    /** @brief true jika proses terbuka dan semua pengaturan berhasil */
+    bool Succeeded() const;
+};
+
+/**
+ * @brief Statistik dan hasil per proses
+ */
+struct ProcessAdjustReport {
+    uint64_t processesScanned = 0;          /**< Entri di snapshot */
+    uint64_t matched = 0;
+    uint64_t adjusted = 0;                  /**< Semua pengaturan berhasil */
+    uint64_t failed = 0;                    /**< Tidak dapat dibuka atau satu pengaturan gagal */
+    uint32_t errorCode = 0;                 /**< Kode error snapshot (0 = berhasil) */
+    double scanSeconds = 0.0;               /**< Snapshot + indeks */
+    double seconds = 0.0;
+    std::vector<size_t> unmatchedSelectors; /**< Indeks selector tanpa proses yang cocok */
+    std::vector<ProcessAdjustResult> results; /**< Urutan snapshot; proses yang cocok dengan beberapa selector hanya sekali */
+};
+
+/**
+ * @brief Mencocokkan selector dengan proses yang berjalan lalu menerapkan pengaturan
+ *
+ * @param selectors Hasil ParseProcessSelector
+ * @param adjustment Pengaturan (kosong = hanya daftar proses yang cocok)
+ * @param report Output statistik dan hasil per proses
+ * @return true jika setiap selector cocok dan setiap proses yang cocok berhasil diubah
+ */
+bool AdjustProcesses(const std::vector<ProcessSelector>& selectors, const ProcessAdjustment& adjustment,
+                     ProcessAdjustReport& report);
+
+/**
+ * @brief Satu baris per proses, selector yang tidak cocok, lalu ringkasan (UTF-8)
+ */
+std::string FormatProcessAdjustReport(const std::vector<ProcessSelector>& selectors,
+                                      const ProcessAdjustReport& report);
+
+#endif
@@ -0,0 +1,205 @@
+/**
+ * @file RasTIApi.h
+ * @brief C ABI stabil untuk embedding RasTI Core (static library / DLL)
+ *
+ * Host non-RAD-Studio (C, C++, C# P/Invoke) dapat memakai pipeline yang sama
+ * dengan RasTI.exe tanpa membuat proses RasTI per operasi: akuisisi token
+ * Trusted Installer sekali, validasi executable, launch dengan argumen dan
+ * priority, lalu menunggu proses selesai.
+ *
+ * Aturan ABI:
+ * - Hanya tipe C (integer lebar tetap, pointer opaque, struct POD); tidak ada
+ *   tipe VCL maupun STL yang melewati batas library.
+ * - String berupa UTF-8 yang diakhiri NUL.
+ * - Function yang gagal mengembalikan 0; detail (tahap + kode error Win32)
+ *   tersedia per thread melalui RastiGetLastError. Setiap function yang
+ *   mengembalikan int menimpa detail tersebut, termasuk saat berhasil.
+ * - Struct input/output diawali field size (sizeof struct versi pemanggil)
+ *   sehingga field baru dapat ditambahkan di akhir tanpa memutus ABI.
+ *
+ * Build: CMake target rasti (static) dan rasti_shared (DLL / shared object).
+ * Definisikan RASTI_USE_DLL sebelum include saat memakai DLL di Windows.
+ *
+ * @author RasTI Development Team
+ * @version 1.2.0.0
+ * @date 2025
+ */
+
+#ifndef RASTI_API_H
+#define RASTI_API_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+//==============================================================================
+// EXPORT MACROS
+//==============================================================================
+
+#if defined(_WIN32)
+    #if defined(RASTI_BUILD_DLL)
+        #define RASTI_API __declspec(dllexport)
+    #elif defined(RASTI_USE_DLL)
+        #define RASTI_API __declspec(dllimport)
+    #else
+        #define RASTI_API
+    #endif
+    #define RASTI_CALL __stdcall   /**< Default P/Invoke (CallingConvention.Winapi) */
+#else
+    #if defined(RASTI_BUILD_DLL)
+        #define RASTI_API __attribute__((visibility("default")))
+    #else
+        #define RASTI_API
+    #endif
+    #define RASTI_CALL
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//==============================================================================
+// TYPES
+//==============================================================================
+
+/** @brief Versi ABI; naik hanya jika ada perubahan yang tidak kompatibel */
+#define RASTI_API_VERSION 1
+
+/** @brief Timeout RastiWait tanpa batas (INFINITE) */
+#define RASTI_WAIT_INFINITE 0xFFFFFFFFu
+
+/** @brief Token Trusted Installer milik pemanggil (RastiReleaseToken) */
+typedef struct RastiToken_* RastiToken;
+
+/** @brief Handle proses hasil RastiLaunch (RastiCloseProcess) */
+typedef struct RastiProcess_* RastiProcess;
+
+/** @brief Tahap tempat operasi terakhir gagal */
+typedef enum RastiPhase {
+    RASTI_PHASE_NONE = 0,       /**< Operasi terakhir berhasil */
+    RASTI_PHASE_ARGUMENT,       /**< Parameter NULL, UTF-8 tidak valid, atau priority tidak dikenal */
+    RASTI_PHASE_CONFIG,         /**< Allowlist atau policy tidak dapat dimuat */
+    RASTI_PHASE_VALIDATE,       /**< Pipeline validasi executable (lihat validation) */
+    RASTI_PHASE_PRIVILEGE,      /**< SeImpersonatePrivilege tidak dapat diaktifkan */
+    RASTI_PHASE_ACQUIRE,        /**< Rantai akuisisi token Trusted Installer */
+    RASTI_PHASE_LAUNCH,         /**< CreateProcessWithTokenW */
+    RASTI_PHASE_WAIT            /**< WaitForSingleObject / GetExitCodeProcess */
+} RastiPhase;
+
+/** @brief Detail kegagalan terakhir di thread pemanggil */
+typedef struct RastiError {
+    uint32_t phase;             /**< RastiPhase */
+    uint32_t code;              /**< Kode error Win32 (GetLastError); 0 untuk kegagalan validasi */
+    uint32_t validation;        /**< ValidationError (RASTI_PHASE_VALIDATE), 0 jika tidak relevan */
+} RastiError;
+
+/** @brief Hasil RastiValidate */
+typedef struct RastiValidationInfo {
+    uint32_t size;              /**< sizeof(RastiValidationInfo), diisi pemanggil */
+    uint32_t kind;              /**< 1 = PE image (.exe/.com), 2 = script (.bat/.cmd) */
+    uint16_t machine;           /**< IMAGE_FILE_HEADER.Machine (PE image) */
+    uint16_t subsystem;         /**< IMAGE_OPTIONAL_HEADER.Subsystem (PE image) */
+    uint32_t is64Bit;           /**< 1 untuk PE32+ */
+    char path[1024];            /**< Canonical path final (UTF-8, terpotong jika lebih panjang) */
+} RastiValidationInfo;
+
+/** @brief Parameter RastiLaunch */
+typedef struct RastiLaunchOptions {
+    uint32_t size;              /**< sizeof(RastiLaunchOptions), diisi pemanggil */
+    const char* path;           /**< Executable (relative, absolute, atau nama file di PATH) */
+    const char* arguments;      /**< Argumen setelah path (boleh NULL) */
+    uint32_t priority;          /**< Priority class Win32; 0 = NORMAL_PRIORITY_CLASS */
+} RastiLaunchOptions;
+
+//==============================================================================
+// API
+//==============================================================================
+
+/** @brief RASTI_API_VERSION yang dipakai saat library dibangun */
+RASTI_API uint32_t RASTI_CALL RastiGetApiVersion(void);
+
+/**
+ * @brief Mengaktifkan SeImpersonatePrivilege dan mengakuisisi token Trusted Installer
+ *
+ * Token dapat dipakai ulang untuk banyak RastiLaunch dari thread mana pun.
+ *
+ * @param token Output token (NULL jika gagal)
+ * @return 1 jika berhasil, 0 jika gagal (RASTI_PHASE_PRIVILEGE / RASTI_PHASE_ACQUIRE)
+ */
+RASTI_API int RASTI_CALL RastiAcquireToken(RastiToken* token);
+
+/** @brief Menutup token dari RastiAcquireToken (NULL diabaikan) */
+RASTI_API void RASTI_CALL RastiReleaseToken(RastiToken token);
+
+/**
+ * @brief Memuat allowlist SHA-256 untuk validasi berikutnya (format sama dengan /allowlist)
+ *
+ * Fail closed: jika gagal, allowlist kosong tetap aktif dan semua executable ditolak.
+ * Panggil saat inisialisasi, sebelum thread lain memanggil RastiValidate/RastiLaunch.
+ *
+ * @param path File allowlist; NULL menonaktifkan allowlist
+ * @param errorLine Output nomor baris yang tidak valid (boleh NULL)
+ */
+RASTI_API int RASTI_CALL RastiLoadAllowlist(const char* path, size_t* errorLine);
+
+/**
+ * @brief Memuat policy path allow/deny (format sama dengan /policy)
+ *
+ * Fail closed: jika gagal, policy "deny **" aktif. Aturan thread sama dengan
+ * RastiLoadAllowlist.
+ *
+ * @param path File policy; NULL menonaktifkan policy
+ * @param errorLine Output nomor baris yang tidak valid (boleh NULL)
+ */
+RASTI_API int RASTI_CALL RastiLoadPolicy(const char* path, size_t* errorLine);
+
+/**
+ * @brief Menjalankan pipeline validasi tanpa launch
+ *
+ * @param path Executable yang divalidasi
+ * @param info Output detail executable (boleh NULL; size harus diisi)
+ * @return 1 jika valid, 0 jika ditolak (RASTI_PHASE_VALIDATE)
+ */
+RASTI_API int RASTI_CALL RastiValidate(const char* path, RastiValidationInfo* info);
+
+/**
+ * @brief Validasi lalu launch executable dengan token Trusted Installer
+ *
+ * Handle file tervalidasi tetap terbuka sampai proses dibuat, sama seperti
+ * RasTI.exe, sehingga file tidak dapat ditukar di antara validasi dan launch.
+ *
+ * @param token Token dari RastiAcquireToken
+ * @param options Path, argumen, dan priority
+ * @param process Output handle untuk RastiWait (boleh NULL jika tidak ditunggu)
+ * @param processId Output PID (boleh NULL)
+ * @return 1 jika proses dibuat
+ */
+RASTI_API int RASTI_CALL RastiLaunch(RastiToken token, const RastiLaunchOptions* options,
+                                     RastiProcess* process, uint32_t* processId);
+
+/**
+ * @brief Menunggu proses hasil RastiLaunch selesai
+ *
+ * @param process Handle dari RastiLaunch
+ * @param timeoutMs Batas waktu (RASTI_WAIT_INFINITE = tanpa batas)
+ * @param exitCode Output exit code (boleh NULL)
+ * @return 1 jika proses selesai; 0 jika timeout (code WAIT_TIMEOUT = 258) atau gagal
+ */
+RASTI_API int RASTI_CALL RastiWait(RastiProcess process, uint32_t timeoutMs, uint32_t* exitCode);
+
+/** @brief Menutup handle proses (proses tetap berjalan; NULL diabaikan) */
+RASTI_API void RASTI_CALL RastiCloseProcess(RastiProcess process);
+
+/** @brief Detail operasi terakhir di thread ini (phase RASTI_PHASE_NONE jika berhasil) */
+RASTI_API void RASTI_CALL RastiGetLastError(RastiError* error);
+
+/** @brief Nama tahap untuk log (misalnya "acquire"); tidak perlu di-free */
+RASTI_API const char* RASTI_CALL RastiGetPhaseName(uint32_t phase);
+
+/** @brief Nama ValidationError untuk log (misalnya "not-allowlisted"); tidak perlu di-free */
+RASTI_API const char* RASTI_CALL RastiGetValidationErrorName(uint32_t validation);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,312 @@
+/**
+ * @file RegistryImport.h
+ * @brief Import file .reg in-process di bawah token Trusted Installer (/regimport)
+ *
+ * Pengganti "regedit /s file.reg" yang dijalankan lewat CreateProcessWithTIToken:
+ * tidak ada proses baru dan tidak ada parser regedit. Dua lapisan yang dapat
+ * diuji terpisah:
+ * - Parser streaming: byte file (UTF-16LE "Windows Registry Editor Version
+ *   5.00" atau REGEDIT4 UTF-8/ASCII) diumpankan per chunk dan dipecah
+ *   menjadi blok key + value tanpa memuat seluruh file sebagai teks.
+ *   Hasilnya sama persis di mana pun chunk dipotong (diperiksa fuzzer
+ *   rasti_regimport_fuzz).
+ * - Engine: menerapkan blok secara berurutan di satu worker thread yang
+ *   meng-impersonate token. Handle key dibuka sekali lalu disimpan di cache
+ *   LRU, dan semua value satu blok ditulis melalui handle yang sama. Value
+ *   yang datanya sudah sama tidak ditulis ulang.
+ *
+ * Mode dry run hanya membuka key read-only dan melaporkan key/value yang
+ * akan dibuat, diubah, atau dihapus, termasuk efek baris sebelumnya di file
+ * yang sama (misalnya [-KEY] lalu [KEY]).
+ *
+ * Header ini portable (tidak bergantung pada Windows.h maupun VCL).
+ *
+ * @author RasTI Development Team
+ * @version 1.2.0.0
+ * @date 2025
+ */
+
+#ifndef RASTI_REGISTRY_IMPORT_H
+#define RASTI_REGISTRY_IMPORT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "Backend.h"
+
+//==============================================================================
+// CONSTANTS
+//==============================================================================
+
+/** @brief Ukuran maksimum file .reg yang dibaca */
+const uint32_t REGIMPORT_MAX_FILE_SIZE = 256 * 1024 * 1024;
+
+/** @brief Ukuran chunk saat membaca file .reg */
+const uint32_t REGIMPORT_READ_CHUNK = 1024 * 1024;
+
+/** @brief Handle key terbuka maksimum di cache */
+const size_t REGIMPORT_KEY_CACHE_SIZE = 64;
+
+/** @brief Panjang maksimum satu komponen nama key */
+const size_t REGIMPORT_MAX_KEY_NAME = 255;
+
+/** @brief Kedalaman maksimum path key */
+const size_t REGIMPORT_MAX_KEY_DEPTH = 512;
+
+/** @brief Panjang maksimum nama value */
+const size_t REGIMPORT_MAX_VALUE_NAME = 16383;
+
+/** @brief Jumlah error yang disimpan di report (sisanya hanya dihitung) */
+const size_t REGIMPORT_MAX_REPORTED_ERRORS = 1000;
+
+/** @brief Jumlah perubahan dry run yang disimpan di report (sisanya hanya dihitung) */
+const size_t REGIMPORT_MAX_REPORTED_CHANGES = 100000;
+
+/** @brief Tipe value registry (nilai sama dengan winnt.h) */
+const uint32_t REGISTRY_TYPE_NONE = 0;
+const uint32_t REGISTRY_TYPE_SZ = 1;
+const uint32_t REGISTRY_TYPE_EXPAND_SZ = 2;
+const uint32_t REGISTRY_TYPE_BINARY = 3;
+const uint32_t REGISTRY_TYPE_DWORD = 4;
+const uint32_t REGISTRY_TYPE_MULTI_SZ = 7;
+const uint32_t REGISTRY_TYPE_QWORD = 11;
+
+//==============================================================================
+// PARSER
+//==============================================================================
+
+/**
+ * @brief Satu baris value di bawah key
+ */
+struct RegistryValue {
+    std::wstring name;          /**< Nama value (kosong = value default "@") */
+    bool remove = false;        /**< "name"=- */
+    uint32_t type = REGISTRY_TYPE_NONE;
+    std::vector<uint8_t> data;  /**< Data mentah untuk SetValue (string: UTF-16LE + terminator) */
+    uint32_t line = 0;          /**< Nomor baris (1-based) */
+
+    bool operator==(const RegistryValue& other) const {
+        return name == other.name && remove == other.remove && type == other.type &&
+               data == other.data && line == other.line;
+    }
+};
+
+/**
+ * @brief Satu baris [KEY] atau [-KEY] beserta value di bawahnya
+ */
+struct RegistryKeyBlock {
+    RegistryRoot root = REGISTRY_ROOT_LOCAL_MACHINE;
+    std::wstring path;          /**< Path di bawah root tanpa '\' awal/akhir (kosong = root) */
+    bool remove = false;        /**< [-KEY]: hapus key beserta isinya */
+    uint32_t line = 0;
+    std::vector<RegistryValue> values;
+
+    bool operator==(const RegistryKeyBlock& other) const {
+        return root == other.root && path == other.path && remove == other.remove &&
+               line == other.line && values == other.values;
+    }
+};
+
+/**
+ * @brief Parser .reg streaming
+ *
+ * Encoding ditentukan dari BOM di awal file (FF FE = UTF-16LE, EF BB BF atau
+ * tanpa BOM = UTF-8). Baris pertama yang tidak kosong harus header
+ * "Windows Registry Editor Version 5.00" atau "REGEDIT4". Data hex yang
+ * berlanjut ke baris berikutnya dengan '\' di akhir baris digabung; baris
+ * yang diawali ';' adalah komentar.
+ *
+ * Format value: @ atau "nama" (escape \\ dan \"), lalu '=' dan salah satu
+ * dari "string", dword:XXXXXXXX, hex:aa,bb, hex(N):aa,bb, atau - (hapus).
+ * Di REGEDIT4, data hex(1)/hex(2)/hex(7) berupa byte ANSI dan diperlebar
+ * menjadi UTF-16LE seperti yang dilakukan regedit.
+ *
+ * [-KEY] tidak boleh menunjuk root atau key langsung di bawah
+ * HKEY_LOCAL_MACHINE/HKEY_USERS (hive yang di-mount sistem).
+ */
+class RegistryFileParser {
+public:
+    /**
+     * @brief Mengumpankan potongan byte file berikutnya
+     * @return false jika parser sudah menemukan baris yang tidak valid
+     */
+    bool Feed(const char* data, size_t size);
+
+    /**
+     * @brief Memproses sisa byte setelah chunk terakhir
+     * @return false jika file tidak valid (termasuk file tanpa header)
+     */
+    bool Finish();
+
+    /**
+     * @brief Memindahkan blok yang sudah lengkap ke blocks (ditambahkan di akhir)
+     *
+     * Blok terakhir baru lengkap setelah Finish.
+     */
+    void TakeBlocks(std::vector<RegistryKeyBlock>& blocks);
+
+    /** @brief Nomor baris yang tidak valid (0 jika belum ada error) */
+    uint32_t GetErrorLine() const { return errorLine_; }
+
+private:
+    enum Encoding { ENCODING_UNKNOWN, ENCODING_UTF8, ENCODING_UTF16LE };
+
+    bool DetectEncoding(bool final);
+    bool ProcessPhysicalLine(const char* data, size_t size);
+    bool ProcessLogicalLine();
+    bool ParseKeyLine(std::wstring_view text);
+    bool ParseValueLine(std::wstring_view text);
+    bool Fail(uint32_t line);
+    void FlushBlock();
+
+    Encoding encoding_ = ENCODING_UNKNOWN;
+    std::string pending_;           /**< Byte yang belum membentuk baris lengkap */
+    size_t scanned_ = 0;            /**< Byte pending_ yang sudah dicari newline-nya */
+    std::wstring decoded_;          /**< Buffer decode satu baris fisik */
+    std::wstring logical_;          /**< Baris logis (gabungan baris lanjutan) */
+    uint32_t lineNumber_ = 0;       /**< Baris fisik terakhir yang diproses */
+    uint32_t logicalLine_ = 0;      /**< Baris fisik awal baris logis */
+    bool continuing_ = false;
+    bool headerSeen_ = false;
+    bool regedit4_ = false;
+    bool hasBlock_ = false;
+    bool finished_ = false;
+    uint32_t errorLine_ = 0;
+    RegistryKeyBlock block_;
+    std::vector<RegistryKeyBlock> blocks_;
+};
+
+/**
+ * @brief Parse isi file .reg dalam satu panggilan (Feed + Finish)
+ *
+ * @param bytes Isi file mentah
+ * @param blocks Output blok key (dikosongkan jika file tidak valid)
+ * @param errorLine Output nomor baris yang tidak valid (0 jika valid)
+ * @return false jika ada baris yang tidak valid (tidak ada yang diterapkan)
+ */
+bool ParseRegistryFile(std::string_view bytes, std::vector<RegistryKeyBlock>& blocks, size_t* errorLine = nullptr);
+
+/**
+ * @brief Membaca file .reg per chunk melalui backend filesystem aktif dan mem-parse-nya
+ *
+ * @param path File .reg
+ * @param blocks Output blok key
+ * @param errorLine Output nomor baris yang tidak valid (0 jika file tidak terbaca)
+ */
+bool LoadRegistryFile(std::wstring_view path, std::vector<RegistryKeyBlock>& blocks, size_t* errorLine = nullptr);
+
+/** @brief Nama root untuk report (misalnya L"HKEY_LOCAL_MACHINE") */
+const wchar_t* GetRegistryRootName(RegistryRoot root);
+
+/** @brief Nama tipe untuk report (misalnya "REG_SZ"), atau nullptr untuk tipe lain */
+const char* GetRegistryTypeName(uint32_t type);
+
+//==============================================================================
+// ENGINE
+//==============================================================================
+
+/**
+ * @brief Langkah yang gagal
+ */
+enum RegistryImportStep {
+    REGIMPORT_STEP_OPEN_KEY = 0,  /**< OpenKey/CreateKey atau impersonation worker */
+    REGIMPORT_STEP_DELETE_KEY,    /**< DeleteKeyTree */
+    REGIMPORT_STEP_QUERY_VALUE,   /**< QueryValue (dry run) */
+    REGIMPORT_STEP_SET_VALUE,     /**< SetValue */
+    REGIMPORT_STEP_DELETE_VALUE   /**< DeleteValue */
+};
+
+/**
+ * @brief Jenis perubahan yang dilaporkan dry run
+ */
+enum RegistryChangeKind {
+    REGIMPORT_CHANGE_CREATE_KEY = 0,
+    REGIMPORT_CHANGE_DELETE_KEY,
+    REGIMPORT_CHANGE_ADD_VALUE,     /**< Value belum ada */
+    REGIMPORT_CHANGE_MODIFY_VALUE,  /**< Value ada dengan tipe/data lain */
+    REGIMPORT_CHANGE_DELETE_VALUE
+};
+
+/**
+ * @brief Satu perubahan (dry run)
+ */
+struct RegistryImportChange {
+    RegistryChangeKind kind = REGIMPORT_CHANGE_CREATE_KEY;
+    uint32_t line = 0;
+    std::wstring key;           /**< Nama lengkap key ("HKEY_LOCAL_MACHINE\...") */
+    std::wstring name;          /**< Nama value (value saja) */
+    uint32_t type = REGISTRY_TYPE_NONE; /**< Tipe baru (ADD/MODIFY) */
+};
+
+/**
+ * @brief Error per key/value
+ */
+struct RegistryImportError {
+    uint32_t line = 0;
+    RegistryImportStep step = REGIMPORT_STEP_OPEN_KEY;
+    std::wstring key;           /**< Nama lengkap key */
+    std::wstring name;          /**< Nama value (kosong untuk langkah key) */
+    uint32_t code = 0;          /**< Kode error Win32 */
+};
+
+/**
+ * @brief Opsi engine
+ */
+struct RegistryImportOptions {
+    OsHandle token = OS_INVALID_HANDLE;       /**< Token yang di-impersonate worker (invalid = tanpa) */
+    bool dryRun = false;                      /**< Hanya baca registry dan laporkan perubahan */
+    size_t keyCacheSize = REGIMPORT_KEY_CACHE_SIZE;
+};
+
+/**
+ * @brief Statistik, perubahan (dry run), dan error satu import
+ */
+struct RegistryImportReport {
+    bool dryRun = false;
+    uint64_t keyBlocks = 0;           /**< Blok [KEY]/[-KEY] yang diproses */
+    uint64_t keysCreated = 0;
+    uint64_t keysDeleted = 0;
+    uint64_t keysFailed = 0;          /**< Blok yang key-nya tidak dapat dibuka/dihapus */
+    uint64_t valuesSet = 0;           /**< Value ditambah atau diubah */
+    uint64_t valuesUnchanged = 0;     /**< Value sudah sama (atau sudah tidak ada untuk "=-") */
+    uint64_t valuesDeleted = 0;
+    uint64_t valuesFailed = 0;
+    uint64_t keyOpens = 0;            /**< Panggilan OpenKey/CreateKey ke backend */
+    uint64_t keyCacheHits = 0;        /**< Blok yang memakai handle dari cache */
+    double seconds = 0.0;
+    uint64_t changeCount = 0;         /**< Semua perubahan dry run, termasuk yang tidak disimpan */
+    std::vector<RegistryImportChange> changes; /**< Dry run saja, maksimum REGIMPORT_MAX_REPORTED_CHANGES */
+    uint64_t errorCount = 0;          /**< Semua error, termasuk yang tidak disimpan */
+    std::vector<RegistryImportError> errors; /**< Maksimum REGIMPORT_MAX_REPORTED_ERRORS */
+
+    /** @brief Value diproses per detik */
+    double ValuesPerSecond() const {
+        return seconds > 0.0 ? (valuesSet + valuesUnchanged + valuesDeleted + valuesFailed) / seconds : 0.0;
+    }
+};
+
+/**
+ * @brief Menerapkan blok .reg secara berurutan (atau mensimulasikannya untuk dry run)
+ *
+ * Key/value yang gagal dilaporkan tanpa menghentikan blok berikutnya.
+ * Menghapus key/value yang tidak ada bukan error.
+ *
+ * @param blocks Hasil ParseRegistryFile/LoadRegistryFile
+ * @param options Opsi token, dry run, dan ukuran cache
+ * @param report Output statistik, perubahan, dan error
+ * @return true jika tidak ada key/value yang gagal
+ */
+bool RunRegistryImport(const std::vector<RegistryKeyBlock>& blocks, const RegistryImportOptions& options,
+                       RegistryImportReport& report);
+
+/** @brief Nama langkah untuk report (misalnya "set value") */
+const char* GetRegistryImportStepName(RegistryImportStep step);
+
+/**
+ * @brief Ringkasan report, perubahan dry run, lalu satu baris per error (UTF-8)
+ */
+std::string FormatRegistryImportReport(const RegistryImportReport& report);
+
+#endif
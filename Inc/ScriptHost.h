@@ -0,0 +1,183 @@
+/**
+ * @file ScriptHost.h
+ * @brief Script host persisten di bawah token Trusted Installer (/scripthost)
+ *
+ * Menjalankan "RasTI.exe script.bat" berulang kali berarti satu
+ * CreateProcessWithTokenW dan satu startup interpreter per script; untuk
+ * PowerShell startup saja memakan ratusan milidetik. Script host menjalankan
+ * satu interpreter per jenis (cmd.exe untuk .bat/.cmd, powershell.exe untuk
+ * .ps1) dengan token Trusted Installer lalu mengumpankan banyak script
+ * secara berurutan melalui stdin pipe:
+ * - Setiap script divalidasi dengan ValidateScript (policy dan allowlist
+ *   tetap berlaku) dan handle-nya tetap terbuka selama script berjalan.
+ * - Setelah command script, host mencetak marker unik (nonce acak per host
+ *   + nomor urut) beserta exit code. Output sebelum marker adalah output
+ *   script; stdout dan stderr digabung.
+ * - Host di-recycle setelah N job atau setelah job yang gagal (exit code
+ *   bukan 0, host keluar, timeout), sehingga state yang bocor antar script
+ *   (environment variable, modul PowerShell, variable global) dibatasi.
+ *   Direktori kerja di-reset sebelum setiap job.
+ *
+ * Script tidak mendapat stdin (cmd: <nul).
+ *
+ * Header ini portable (tidak bergantung pada Windows.h maupun VCL).
+ *
+ * @author RasTI Development Team
+ * @version 1.2.0.0
+ * @date 2025
+ */
+
+#ifndef RASTI_SCRIPT_HOST_H
+#define RASTI_SCRIPT_HOST_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "Backend.h"
+#include "Validation.h"
+
+//==============================================================================
+// CONSTANTS
+//==============================================================================
+
+/** @brief Ukuran maksimum file daftar job */
+const uint32_t SCRIPTHOST_MAX_JOB_FILE_SIZE = 16 * 1024 * 1024;
+
+/** @brief Job per host sebelum host di-recycle (default /recycle) */
+const unsigned SCRIPTHOST_DEFAULT_JOBS_PER_HOST = 50;
+
+/** @brief Output per job yang disimpan di report; sisanya hanya dihitung */
+const size_t SCRIPTHOST_MAX_OUTPUT = 1024 * 1024;
+
+/** @brief Batas waktu host siap (startup + marker pertama) */
+const uint32_t SCRIPTHOST_START_TIMEOUT_MS = 30000;
+
+/** @brief Batas waktu host keluar setelah "exit" sebelum di-terminate */
+const uint32_t SCRIPTHOST_EXIT_TIMEOUT_MS = 2000;
+
+/** @brief Interval pengecekan host yang keluar saat menunggu output */
+const uint32_t SCRIPTHOST_POLL_INTERVAL_MS = 250;
+
+//==============================================================================
+// JOB LIST
+//==============================================================================
+
+/**
+ * @brief Satu baris daftar job: SCRIPT [ARG...]
+ */
+struct ScriptJob {
+    uint32_t line = 0;                  /**< Nomor baris di file daftar job */
+    std::wstring path;                  /**< Path script (divalidasi saat dijalankan) */
+    std::vector<std::wstring> arguments;
+};
+
+/**
+ * @brief Parse daftar job (UTF-8, satu script per baris)
+ *
+ * Path dan argumen dipisah blank; token yang berisi spasi diapit kutip
+ * dua. Baris kosong dan baris yang diawali '#' diabaikan. Extension harus
+ * .bat/.cmd/.ps1. Karakter kontrol ditolak, dan argumen script cmd tidak
+ * boleh berisi % atau ^ (diekspansi ulang oleh cmd.exe).
+ *
+ * @param text Isi file mentah
+ * @param jobs Output job (dikosongkan jika file tidak valid)
+ * @param errorLine Output nomor baris yang tidak valid (0 jika valid)
+ * @return false jika ada baris yang tidak valid (tidak ada job yang dijalankan)
+ */
+bool ParseScriptJobList(std::string_view text, std::vector<ScriptJob>& jobs, size_t* errorLine = nullptr);
+
+/**
+ * @brief Membaca daftar job melalui backend filesystem aktif dan mem-parse-nya
+ *
+ * @param path File daftar job
+ * @param jobs Output job
+ * @param errorLine Output nomor baris yang tidak valid (0 jika file tidak terbaca)
+ */
+bool LoadScriptJobList(std::wstring_view path, std::vector<ScriptJob>& jobs, size_t* errorLine = nullptr);
+
+//==============================================================================
+// ENGINE
+//==============================================================================
+
+/**
+ * @brief Hasil satu job
+ */
+enum ScriptJobStatus {
+    SCRIPTJOB_COMPLETED = 0,  /**< Marker diterima - exitCode dari script */
+    SCRIPTJOB_REJECTED,       /**< Validasi gagal - script tidak dijalankan */
+    SCRIPTJOB_HOST_EXITED,    /**< Host keluar sebelum marker (misalnya "exit 3") - exitCode dari host */
+    SCRIPTJOB_TIMED_OUT,      /**< Melebihi timeout - host di-terminate */
+    SCRIPTJOB_HOST_FAILED     /**< Host tidak dapat dijalankan atau pipe gagal (errorCode) */
+};
+
+/**
+ * @brief Status, exit code, dan output satu job
+ */
+struct ScriptJobResult {
+    uint32_t line = 0;
+    std::wstring path;                          /**< Canonical path jika validasi berhasil */
+    ExecutableKind kind = EXECUTABLE_KIND_UNKNOWN;
+    ScriptJobStatus status = SCRIPTJOB_REJECTED;
+    ValidationError validation = VALIDATION_OK; /**< Alasan REJECTED */
+    uint32_t exitCode = 0;
+    uint32_t errorCode = 0;                     /**< Kode error Win32 untuk HOST_FAILED */
+    std::string output;                         /**< stdout+stderr mentah, maksimum SCRIPTHOST_MAX_OUTPUT */
+    uint64_t outputBytes = 0;                   /**< Semua output, termasuk yang tidak disimpan */
+    double seconds = 0.0;
+
+    /** @brief true jika script selesai dengan exit code 0 */
+    bool Succeeded() const {
+        return (status == SCRIPTJOB_COMPLETED || status == SCRIPTJOB_HOST_EXITED) && exitCode == 0;
+    }
+};
+
+/**
+ * @brief Opsi engine
+ */
+struct ScriptHostOptions {
+    OsHandle token = OS_INVALID_HANDLE;   /**< Token untuk proses host */
+    std::wstring cmdPath;                 /**< Path lengkap cmd.exe */
+    std::wstring powershellPath;          /**< Path lengkap powershell.exe */
+    std::wstring workingDirectory;        /**< Direktori kerja setiap job (kosong = tidak di-reset) */
+    uint32_t creationFlags = 0;           /**< Priority class host */
+    unsigned jobsPerHost = SCRIPTHOST_DEFAULT_JOBS_PER_HOST; /**< 0 = tidak pernah di-recycle karena jumlah */
+    uint32_t timeoutMs = 0;               /**< Batas waktu per job (0 = tanpa batas) */
+};
+
+/**
+ * @brief Statistik dan hasil per job
+ */
+struct ScriptHostReport {
+    uint64_t jobsSucceeded = 0;
+    uint64_t jobsFailed = 0;
+    uint64_t hostsStarted = 0;
+    uint64_t hostsRecycled = 0;           /**< Host yang dihentikan sebelum daftar job selesai */
+    double hostStartSeconds = 0.0;        /**< Total waktu startup host sampai siap */
+    double seconds = 0.0;
+    std::vector<ScriptJobResult> results; /**< Urutan sama dengan daftar job */
+};
+
+/**
+ * @brief Menjalankan job secara berurutan di host persisten
+ *
+ * Host per jenis dijalankan saat job pertama jenis itu muncul. Job yang
+ * gagal dilaporkan tanpa menghentikan job berikutnya.
+ *
+ * @param jobs Hasil ParseScriptJobList/LoadScriptJobList
+ * @param options Token, path interpreter, recycle, dan timeout
+ * @param report Output statistik dan hasil per job
+ * @return true jika semua job selesai dengan exit code 0
+ */
+bool RunScriptHost(const std::vector<ScriptJob>& jobs, const ScriptHostOptions& options, ScriptHostReport& report);
+
+/** @brief Nama status untuk report (misalnya "timed-out") */
+const char* GetScriptJobStatusName(ScriptJobStatus status);
+
+/**
+ * @brief Satu baris per job diikuti output-nya (diberi indent), lalu ringkasan (UTF-8)
+ */
+std::string FormatScriptHostReport(const ScriptHostReport& report);
+
+#endif
@@ -0,0 +1,146 @@
+/**
+ * @file SessionLaunch.h
+ * @brief Launch satu executable TI ke setiap session user yang logon (/sessions)
+ *
+ * Di host multi-session (RDS, VDI, fast user switching) tool TI yang sama
+ * sebelumnya harus di-launch sekali per user dari session masing-masing,
+ * dan setiap launch mengakuisisi token Trusted Installer sendiri. /sessions
+ * menjalankan satu executable di banyak session sekaligus:
+ * - Token diakuisisi sekali oleh pemanggil. Setiap launch menduplikasi token
+ *   itu sebagai primary token dan memindahkan salinannya ke session tujuan
+ *   (IProcessBackend::CreateProcessAsUser dengan ProcessLaunchRequest::sessionId).
+ * - Session dipilih dari satu enumerasi (IProcessBackend::EnumerateSessions):
+ *   "all" = semua session aktif dengan user logon (session 0 tidak pernah
+ *   interaktif), atau daftar ID eksplisit.
+ * - Launch berjalan paralel di worker bersama satu TrustedInstallerLauncher
+ *   (LAUNCH_API_AS_USER): seclogon tidak dapat membuat proses di session lain.
+ * - Hasil dicatat per session: PID atau kode error, tanpa menghentikan
+ *   session lain.
+ *
+ * Header ini portable (tidak bergantung pada Windows.h maupun VCL).
+ *
+ * @author RasTI Development Team
+ * @version 1.2.0.0
+ * @date 2025
+ */
+
+#ifndef RASTI_SESSION_LAUNCH_H
+#define RASTI_SESSION_LAUNCH_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "Backend.h"
+#include "TrustedInstaller.h"
+#include "Validation.h"
+
+//==============================================================================
+// CONSTANTS
+//==============================================================================
+
+/** @brief Worker launch bersamaan maksimum (default SessionLaunchOptions::maxParallel) */
+const unsigned SESSION_LAUNCH_MAX_THREADS = 16;
+
+/** @brief Jumlah maksimum ID di daftar /sessions:ID,ID */
+const size_t SESSION_LAUNCH_MAX_IDS = 256;
+
+//==============================================================================
+// SELECTION
+//==============================================================================
+
+/**
+ * @brief Session tujuan dari command line
+ */
+struct SessionSelection {
+    bool all = false;                   /**< Semua session aktif selain session 0 */
+    std::vector<uint32_t> sessionIds;   /**< Daftar eksplisit (urutan command line) jika !all */
+};
+
+/**
+ * @brief Parse "all" atau daftar ID desimal dipisah koma (misalnya "1,3,5")
+ *
+ * ID duplikat, ID kosong, dan daftar yang melebihi SESSION_LAUNCH_MAX_IDS
+ * ditolak.
+ */
+bool ParseSessionSelection(std::wstring_view text, SessionSelection& selection);
+
+//==============================================================================
+// ENGINE
+//==============================================================================
+
+/**
+ * @brief Hasil satu session
+ */
+enum SessionLaunchStatus {
+    SESSION_LAUNCH_STARTED = 0, /**< Proses dibuat - processId valid */
+    SESSION_LAUNCH_FAILED,      /**< Launch gagal (errorCode) */
+    SESSION_LAUNCH_NOT_FOUND    /**< ID eksplisit tidak ada di enumerasi - tidak dijalankan */
+};
+
+/**
+ * @brief Status dan timing satu session
+ */
+struct SessionLaunchResult {
+    uint32_t sessionId = 0;
+    std::wstring stationName;
+    std::wstring userName;
+    SessionLaunchStatus status = SESSION_LAUNCH_NOT_FOUND;
+    uint32_t processId = 0;
+    uint32_t errorCode = 0;             /**< Kode error Win32 untuk FAILED */
+    double seconds = 0.0;               /**< Durasi launch session ini */
+};
+
+/**
+ * @brief Opsi launch
+ */
+struct SessionLaunchOptions {
+    OsHandle token = OS_INVALID_HANDLE;     /**< Token TI untuk semua session */
+    uint32_t creationFlags = 0;             /**< Priority class */
+    ConsoleMode console = CONSOLE_MODE_AUTO; /**< AUTO = dari subsystem PE; INHERIT diperlakukan sebagai NEW */
+    unsigned maxParallel = 0;               /**< Worker bersamaan (0 = SESSION_LAUNCH_MAX_THREADS) */
+};
+
+/**
+ * @brief Statistik dan hasil per session
+ */
+struct SessionLaunchReport {
+    uint64_t sessionsFound = 0;             /**< Entri enumerasi */
+    uint64_t launched = 0;
+    uint64_t failed = 0;
+    uint64_t notFound = 0;
+    uint32_t errorCode = 0;                 /**< Kode error enumerasi (0 = berhasil) */
+    unsigned threadCount = 0;
+    double enumerateSeconds = 0.0;
+    double seconds = 0.0;
+    std::vector<SessionLaunchResult> results; /**< "all" = urutan enumerasi, daftar = urutan ID */
+};
+
+/**
+ * @brief Launch executable yang sudah divalidasi ke setiap session terpilih
+ *
+ * Session yang disebut eksplisit dijalankan apa pun state-nya (misalnya
+ * disconnected); "all" hanya memilih session aktif.
+ *
+ * @param executable Hasil ValidateExecutable (handle file tetap terbuka)
+ * @param arguments Argumen setelah argv[0]
+ * @param selection Hasil ParseSessionSelection
+ * @param options Token, priority, console, dan paralelisme
+ * @param report Output statistik dan hasil per session
+ * @return true jika minimal satu session dipilih dan semua session terpilih
+ *         berhasil di-launch
+ */
+bool LaunchInSessions(const ValidatedExecutable& executable, const std::vector<std::wstring>& arguments,
+                      const SessionSelection& selection, const SessionLaunchOptions& options,
+                      SessionLaunchReport& report);
+
+/** @brief Nama status untuk report (misalnya "not-found") */
+const char* GetSessionLaunchStatusName(SessionLaunchStatus status);
+
+/**
+ * @brief Satu baris per session lalu ringkasan (UTF-8)
+ */
+std::string FormatSessionLaunchReport(const SessionLaunchReport& report);
+
+#endif
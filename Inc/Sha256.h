@@ -0,0 +1,128 @@
+/**
+ * @file Sha256.h
+ * @brief Implementasi SHA-256 streaming untuk hash allowlist RasTI
+ *
+ * Hash dihitung secara incremental (Update berkali-kali, lalu Final) sehingga
+ * file besar dapat diproses per chunk tanpa dimuat seluruhnya ke memory.
+ * Kompresi blok memakai instruksi SHA-NI (x86 SHA extensions) jika CPU
+ * mendukung, dengan fallback implementasi scalar portable.
+ *
+ * Header ini portable (tidak bergantung pada Windows.h maupun VCL).
+ *
+ * @author RasTI Development Team
+ * @version 1.2.0.0
+ * @date 2025
+ */
+
+#ifndef RASTI_SHA256_H
+#define RASTI_SHA256_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+//==============================================================================
+// TYPES
+//==============================================================================
+
+/** @brief Ukuran digest SHA-256 dalam bytes */
+const size_t SHA256_DIGEST_SIZE = 32;
+
+/** @brief Ukuran blok kompresi SHA-256 dalam bytes */
+const size_t SHA256_BLOCK_SIZE = 64;
+
+/** @brief Digest SHA-256 (big-endian, urutan byte standar) */
+typedef std::array<uint8_t, SHA256_DIGEST_SIZE> Sha256Digest;
+
+/**
+ * @brief Hash functor untuk Sha256Digest di unordered container
+ *
+ * Digest kriptografis sudah terdistribusi merata, sehingga 8 byte pertama
+ * cukup sebagai nilai hash tanpa perhitungan tambahan.
+ */
+struct Sha256DigestHash {
+    size_t operator()(const Sha256Digest& digest) const {
+        uint64_t value = 0;
+        for (size_t i = 0; i < sizeof(value); i++) {
+            value = (value << 8) | digest[i];
+        }
+        return static_cast<size_t>(value);
+    }
+};
+
+//==============================================================================
+// STREAMING HASHER
+//==============================================================================
+
+/**
+ * @brief Hasher SHA-256 incremental
+ *
+ * Contoh:
+ * @code
+ * Sha256 hasher;
+ * hasher.Update(chunk1, size1);
+ * hasher.Update(chunk2, size2);
+ * Sha256Digest digest = hasher.Final();
+ * @endcode
+ */
+class Sha256 {
+private:
+    uint32_t state_[8];
+    uint8_t buffer_[SHA256_BLOCK_SIZE];
+    size_t bufferLength_;
+    uint64_t totalLength_;
+
+public:
+    /** @brief Constructor - langsung siap menerima data */
+    Sha256() { Reset(); }
+
+    /** @brief Kembali ke state awal (hash kosong) */
+    void Reset();
+
+    /**
+     * @brief Menambahkan data ke hash
+     * @param data Pointer ke data (boleh NULL jika size == 0)
+     * @param size Jumlah bytes
+     */
+    void Update(const void* data, size_t size);
+
+    /**
+     * @brief Menyelesaikan hash (padding + panjang) dan mengembalikan digest
+     *
+     * @note Setelah Final, object harus di-Reset sebelum dipakai lagi
+     */
+    Sha256Digest Final();
+
+    /**
+     * @brief Mengecek apakah kompresi blok memakai instruksi SHA-NI
+     * @return true jika CPU mendukung SHA extensions dan build menyertakannya
+     */
+    static bool IsHardwareAccelerated();
+};
+
+//==============================================================================
+// HELPERS
+//==============================================================================
+
+/**
+ * @brief Hash satu buffer secara langsung
+ */
+Sha256Digest ComputeSha256(const void* data, size_t size);
+
+/**
+ * @brief Format digest sebagai 64 karakter hex lowercase
+ */
+std::string Sha256ToHex(const Sha256Digest& digest);
+
+/**
+ * @brief Parse 64 karakter hex (case-insensitive) menjadi digest
+ *
+ * @param hex String hex tanpa prefix/spasi
+ * @param digest Output digest
+ * @return true jika hex tepat 64 karakter valid
+ */
+bool ParseSha256Hex(std::string_view hex, Sha256Digest& digest);
+
+#endif
@@ -0,0 +1,157 @@
+/**
+ * @file SingleInstance.h
+ * @brief Launch single-instance (/single): skip atau attach jika image yang sama sudah berjalan
+ *
+ * Launch ulang tool TI yang masih berjalan (misalnya agent atau scanner yang
+ * dijadwalkan dari banyak /batch) membuat instance ganda yang saling
+ * berebut file dan registry. /single memeriksa proses yang berjalan sebelum
+ * setiap launch dan, jika executable dengan path yang sama sudah berjalan,
+ * tidak membuat proses baru:
+ * - SKIP: launch dilaporkan sebagai skipped dengan PID instance yang ada.
+ * - ATTACH: menunggu instance yang ada selesai dan melaporkan exit code-nya
+ *   seolah-olah proses itu yang di-launch.
+ *
+ * Pemeriksaan dilakukan terhadap RunningImageIndex agar cukup murah untuk
+ * setiap launch di batch besar:
+ * - Satu ToolHelp32 snapshot per batch (ProcessTable), bukan per launch.
+ * - Hanya proses dengan nama file yang sama yang dibuka untuk membaca path
+ *   image-nya, dan identitas file per PID di-cache sehingga setiap proses
+ *   dibuka paling banyak sekali per batch.
+ * - Proses yang di-launch selama batch dicatat langsung di indeks (Add) dan
+ *   dihapus saat selesai (Remove), tanpa snapshot ulang.
+ *
+ * Identitas instance = identitas file image (volume serial + file index,
+ * sama seperti cache hash validasi), bukan string path. Path yang sama
+ * dapat ditulis dengan nama pendek 8.3, drive subst atau mapped, maupun
+ * case non-ASCII yang berbeda; perbandingan string melewatkan instance
+ * tersebut dan launch ganda terjadi diam-diam. Nama image di snapshot hanya
+ * dipakai sebagai saringan kandidat, dan nama yang tidak dapat dibandingkan
+ * dengan lipatan ASCII (mengandung '~' atau karakter non-ASCII) selalu
+ * menjadi kandidat. Named mutex atau tag job tidak dipakai: keduanya hanya
+ * mengenali instance yang dibuat atau dikooperasikan sendiri, sedangkan
+ * identitas image juga mengenali instance yang di-launch di luar RasTI.
+ *
+ * Header ini portable (tidak bergantung pada Windows.h maupun VCL).
+ *
+ * @author RasTI Development Team
+ * @version 1.2.0.0
+ * @date 2025
+ */
+
+#ifndef RASTI_SINGLE_INSTANCE_H
+#define RASTI_SINGLE_INSTANCE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "Backend.h"
+#include "ProcessAdjust.h"
+#include "Validation.h"
+
+//==============================================================================
+// MODE
+//==============================================================================
+
+/**
+ * @brief Perilaku launch jika instance dengan file yang sama sudah berjalan
+ */
+enum SingleInstanceMode {
+    SINGLE_INSTANCE_OFF = 0, /**< Selalu launch (default) */
+    SINGLE_INSTANCE_SKIP,    /**< Tidak launch, laporkan PID instance yang ada */
+    SINGLE_INSTANCE_ATTACH   /**< Tidak launch, tunggu instance yang ada dan pakai exit code-nya */
+};
+
+/**
+ * @brief Parse nilai /single (kosong atau "skip" = SKIP, "attach" = ATTACH, case-insensitive)
+ */
+bool ParseSingleInstanceMode(std::wstring_view text, SingleInstanceMode& mode);
+
+/** @brief Nama mode untuk report (misalnya "attach") */
+const char* GetSingleInstanceModeName(SingleInstanceMode mode);
+
+//==============================================================================
+// RUNNING IMAGE INDEX
+//==============================================================================
+
+/**
+ * @brief Biaya pemeriksaan single-instance selama satu batch
+ */
+struct RunningImageStats {
+    uint64_t processesIndexed = 0;  /**< Entri snapshot */
+    uint64_t lookups = 0;           /**< Panggilan Find */
+    uint64_t candidatesOpened = 0;  /**< Kandidat yang dibuka untuk membaca identitas image */
+    uint64_t unverified = 0;        /**< Kandidat yang proses atau file image-nya tidak dapat dibuka */
+    uint64_t hits = 0;              /**< Find yang menemukan instance */
+    double scanSeconds = 0.0;       /**< Snapshot + indeks */
+};
+
+/**
+ * @brief Indeks proses yang berjalan berdasarkan identitas file image
+ *
+ * Kandidat yang tidak dapat dibuka (misalnya proses protected) atau yang
+ * file image-nya tidak dapat dibuka dihitung sebagai unverified dan tidak
+ * dianggap cocok: pemeriksaan tidak pernah memblokir launch karena proses
+ * yang image-nya tidak diketahui.
+ *
+ * @note Tidak thread-safe; satu indeks dipakai oleh satu thread launch
+ */
+class RunningImageIndex {
+public:
+    RunningImageIndex() : backend_(NULL), files_(NULL) {}
+
+    /**
+     * @brief Mengambil snapshot baru dan mengosongkan cache identitas serta proses yang dicatat
+     * @param backend Backend proses (snapshot, path image)
+     * @param files Backend filesystem (identitas file image kandidat)
+     * @return false jika EnumerateProcesses gagal
+     */
+    bool Load(IProcessBackend* backend, IFileSystemBackend* files);
+
+    /**
+     * @brief Mencari instance yang berjalan dari file executable yang sama
+     * @param executable Hasil ValidateExecutable (path untuk nama file, identity untuk pencocokan)
+     * @param processId Output PID instance yang ditemukan
+     * @return true jika ditemukan (proses yang dicatat lewat Add didahulukan)
+     */
+    bool Find(const ValidatedExecutable& executable, uint32_t& processId);
+
+    /** @brief Mencatat proses yang baru di-launch agar launch berikutnya melihatnya */
+    void Add(uint32_t processId, const FileIdentity& identity);
+
+    /** @brief Menghapus proses yang dicatat lewat Add setelah proses itu selesai */
+    void Remove(uint32_t processId);
+
+    const RunningImageStats& GetStats() const { return stats_; }
+
+private:
+    /** @brief Volume serial + file index (tanpa ukuran/waktu: file yang sama tetap cocok) */
+    typedef std::pair<uint64_t, uint64_t> ImageKey;
+
+    struct ImageKeyHash {
+        size_t operator()(const ImageKey& key) const {
+            return static_cast<size_t>(key.second * 0x9E3779B97F4A7C15ULL ^ key.first);
+        }
+    };
+
+    /** @brief Identitas image satu PID snapshot */
+    struct SnapshotImage {
+        bool verified = false;      /**< false = proses atau file image tidak dapat dibuka */
+        ImageKey key;
+    };
+
+    bool ResolveImage(uint32_t processId, SnapshotImage& image);
+
+    IProcessBackend* backend_;
+    IFileSystemBackend* files_;
+    ProcessTable table_;
+    std::vector<size_t> unfoldedNames_;                        /**< Entri bernama '~'/non-ASCII (selalu kandidat) */
+    std::unordered_map<uint32_t, SnapshotImage> snapshotImages_; /**< PID -> identitas image */
+    std::unordered_map<ImageKey, uint32_t, ImageKeyHash> launched_; /**< Identitas -> PID dari Add */
+    RunningImageStats stats_;
+};
+
+#endif
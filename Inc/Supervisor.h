@@ -0,0 +1,212 @@
+/**
+ * @file Supervisor.h
+ * @brief Menjaga proses TI berumur panjang tetap hidup (/supervise)
+ *
+ * Helper TI yang berjalan terus (watcher, agent) sebelumnya harus di-launch
+ * ulang manual lewat GUI setiap kali crash. Supervisor menjalankan daftar
+ * program (format sama dengan /batch) dan me-restart program yang keluar:
+ * - Exit dideteksi dari notifikasi job di completion port capture
+ *   (IOutputCaptureBackend::WaitCaptureEvent) tanpa polling; pipe yang
+ *   tertutup menjadi cadangan jika notifikasi job tidak tersedia.
+ * - Restart memakai token dari TrustedInstallerTokenCache sehingga biayanya
+ *   hanya CreateProcessWithTokenW; token di-invalidate jika launch gagal dan
+ *   diakuisisi ulang pada percobaan berikutnya.
+ * - Delay restart naik eksponensial (initialBackoffMs, 2x, 4x, ... sampai
+ *   maxBackoffMs). Run yang bertahan minimal stableRunMs mereset hitungan;
+ *   setelah crashLoopLimit kegagalan beruntun program dihentikan (GAVE_UP).
+ * - Jumlah restart, uptime, dan state setiap program dipublikasikan ke
+ *   SupervisorMetrics yang dapat dibaca thread lain kapan saja.
+ *
+ * Header ini portable (tidak bergantung pada Windows.h maupun VCL).
+ *
+ * @author RasTI Development Team
+ * @version 1.2.0.0
+ * @date 2025
+ */
+
+#ifndef RASTI_SUPERVISOR_H
+#define RASTI_SUPERVISOR_H
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "Backend.h"
+#include "OutputCapture.h"
+#include "TrustedInstaller.h"
+#include "Validation.h"
+
+//==============================================================================
+// CONSTANTS
+//==============================================================================
+
+/** @brief Delay restart pertama (default /backoff) */
+const uint32_t SUPERVISOR_DEFAULT_BACKOFF_MS = 1000;
+
+/** @brief Batas atas delay restart */
+const uint32_t SUPERVISOR_DEFAULT_MAX_BACKOFF_MS = 60000;
+
+/** @brief Run yang bertahan selama ini dianggap stabil (hitungan kegagalan direset) */
+const uint32_t SUPERVISOR_DEFAULT_STABLE_RUN_MS = 60000;
+
+/** @brief Kegagalan beruntun sebelum program dihentikan (default /crashloop) */
+const unsigned SUPERVISOR_DEFAULT_CRASH_LOOP_LIMIT = 5;
+
+/** @brief Interval pengecekan flag cancel selama pump menunggu */
+const uint32_t SUPERVISOR_CANCEL_CHECK_MS = 200;
+
+//==============================================================================
+// METRICS
+//==============================================================================
+
+/**
+ * @brief State satu program yang diawasi
+ */
+enum SupervisedState {
+    SUPERVISED_STARTING = 0, /**< Belum pernah dijalankan */
+    SUPERVISED_RUNNING,      /**< Proses hidup */
+    SUPERVISED_BACKOFF,      /**< Menunggu delay sebelum restart */
+    SUPERVISED_GAVE_UP,      /**< Melebihi crashLoopLimit - tidak di-restart lagi */
+    SUPERVISED_STOPPED       /**< Supervisor berhenti (cancel) */
+};
+
+/**
+ * @brief Snapshot metrics satu program
+ */
+struct SupervisedProgramMetrics {
+    std::wstring path;                        /**< Canonical path jika validasi pernah berhasil */
+    SupervisedState state = SUPERVISED_STARTING;
+    uint32_t processId = 0;                   /**< PID run terakhir */
+    uint64_t starts = 0;                      /**< Proses yang berhasil dibuat */
+    uint64_t restarts = 0;                    /**< Percobaan launch setelah yang pertama */
+    unsigned consecutiveFailures = 0;         /**< Run gagal beruntun (direset oleh run stabil) */
+    uint32_t lastExitCode = 0;
+    uint32_t lastErrorCode = 0;               /**< Kode error Win32 launch terakhir yang gagal */
+    ValidationError validation = VALIDATION_OK; /**< Alasan validasi terakhir yang gagal */
+    double uptimeSeconds = 0.0;               /**< Run saat ini (0 jika tidak berjalan) */
+    double lastRunSeconds = 0.0;              /**< Durasi run terakhir yang sudah selesai */
+    double totalUptimeSeconds = 0.0;          /**< Semua run termasuk run saat ini */
+    double backoffSeconds = 0.0;              /**< Delay restart yang sedang berjalan */
+};
+
+/**
+ * @brief Permukaan metrics supervisor yang thread-safe
+ *
+ * Engine memanggil Publish setiap kali state program berubah; thread lain
+ * (CLI, GUI, atau test) membaca Snapshot. Uptime run yang masih berjalan
+ * dihitung saat snapshot diambil sehingga engine tidak perlu mempublikasikan
+ * ulang secara berkala.
+ */
+class SupervisorMetrics {
+public:
+    /**
+     * @brief Menyimpan state program ke-index
+     * @param runStarted Waktu proses dibuat (dipakai jika state RUNNING)
+     */
+    void Publish(size_t index, const SupervisedProgramMetrics& metrics,
+                 std::chrono::steady_clock::time_point runStarted);
+
+    /** @brief Salinan metrics semua program dengan uptime saat ini */
+    std::vector<SupervisedProgramMetrics> Snapshot() const;
+
+private:
+    struct Entry {
+        SupervisedProgramMetrics metrics;
+        std::chrono::steady_clock::time_point runStarted;
+    };
+
+    mutable std::mutex mutex_;
+    std::vector<Entry> entries_;
+};
+
+/** @brief Nama state untuk report (misalnya "backoff") */
+const char* GetSupervisedStateName(SupervisedState state);
+
+/**
+ * @brief Satu baris per program: state, PID, restart, dan uptime (UTF-8)
+ */
+std::string FormatSupervisorMetrics(const std::vector<SupervisedProgramMetrics>& programs);
+
+/**
+ * @brief Snapshot metrics sebagai satu objek JSON ({"programs":[...]}, UTF-8)
+ */
+std::string FormatSupervisorMetricsJson(const std::vector<SupervisedProgramMetrics>& programs);
+
+//==============================================================================
+// ENGINE
+//==============================================================================
+
+/**
+ * @brief Dipanggil setiap kali state program berubah (start, exit, give up)
+ *
+ * Dipanggil dari thread RunSupervisor setelah metrics dipublikasikan.
+ */
+typedef std::function<void(size_t program, const SupervisedProgramMetrics& metrics)> SupervisorEventCallback;
+
+/**
+ * @brief Opsi supervisor
+ */
+struct SupervisorOptions {
+    TrustedInstallerTokenCache* tokens = NULL; /**< Sumber token untuk setiap start (wajib) */
+    uint32_t creationFlags = 0;                /**< Priority class */
+    ConsoleMode console = CONSOLE_MODE_AUTO;   /**< AUTO = hidden untuk console/script, none untuk GUI */
+    uint32_t initialBackoffMs = SUPERVISOR_DEFAULT_BACKOFF_MS;
+    uint32_t maxBackoffMs = SUPERVISOR_DEFAULT_MAX_BACKOFF_MS;
+    uint32_t stableRunMs = SUPERVISOR_DEFAULT_STABLE_RUN_MS;
+    unsigned crashLoopLimit = SUPERVISOR_DEFAULT_CRASH_LOOP_LIMIT; /**< 0 = restart tanpa batas */
+    const std::atomic<bool>* cancel = NULL;    /**< Di-set thread lain untuk menghentikan supervisor */
+    SupervisorMetrics* metrics = NULL;         /**< Permukaan metrics (opsional) */
+};
+
+/**
+ * @brief Delay sebelum restart setelah sejumlah kegagalan beruntun
+ *
+ * @return initialBackoffMs * 2^(failures-1), dibatasi maxBackoffMs
+ *         (0 jika failures == 0)
+ */
+uint32_t GetSupervisorBackoffMs(const SupervisorOptions& options, unsigned consecutiveFailures);
+
+/**
+ * @brief Ringkasan setelah supervisor berhenti
+ */
+struct SupervisorReport {
+    uint64_t starts = 0;
+    uint64_t restarts = 0;
+    uint64_t gaveUp = 0;                        /**< Program yang melebihi crashLoopLimit */
+    uint64_t events = 0;                        /**< Event yang dilayani pump */
+    bool cancelled = false;
+    uint32_t errorCode = 0;                     /**< Kode error port/pump (0 = tidak ada kegagalan) */
+    double seconds = 0.0;
+    std::vector<SupervisedProgramMetrics> programs; /**< Urutan sama dengan daftar program */
+};
+
+/**
+ * @brief Menjalankan dan me-restart program sampai cancel atau semua program menyerah
+ *
+ * Kegagalan validasi dan launch dihitung sebagai run gagal (dengan backoff
+ * yang sama) sehingga file yang sementara terkunci atau belum ada tidak
+ * menghentikan supervisor. Saat berhenti, proses yang masih berjalan
+ * di-terminate beserta turunannya.
+ *
+ * @param programs Hasil ParseCaptureLaunchList/LoadCaptureLaunchList
+ * @param options Token cache, backoff, batas crash loop, dan cancel
+ * @param output Penerima chunk output (kosong = output dibuang)
+ * @param events Penerima perubahan state (opsional)
+ * @param report Output ringkasan dan metrics akhir
+ * @return true jika dihentikan lewat cancel tanpa program yang menyerah
+ *         dan tanpa kegagalan pump
+ */
+bool RunSupervisor(const std::vector<CaptureLaunch>& programs, const SupervisorOptions& options,
+                   const CaptureOutputCallback& output, const SupervisorEventCallback& events,
+                   SupervisorReport& report);
+
+/**
+ * @brief Metrics akhir per program lalu ringkasan (UTF-8)
+ */
+std::string FormatSupervisorReport(const SupervisorReport& report);
+
+#endif
@@ -0,0 +1,50 @@
+/**
+ * @file TextEncoding.h
+ * @brief Konversi UTF-8 <-> wide string untuk file teks (policy, daftar path, report)
+ *
+ * Semua path di RasTI berupa std::wstring (UTF-16 di Windows), sedangkan file
+ * konfigurasi dan report ditulis sebagai UTF-8. Helper ini portable dan tidak
+ * bergantung pada code page sistem (tidak memakai MultiByteToWideChar).
+ *
+ * @author RasTI Development Team
+ * @version 1.2.0.0
+ * @date 2025
+ */
+
+#ifndef RASTI_TEXT_ENCODING_H
+#define RASTI_TEXT_ENCODING_H
+
+#include <string>
+#include <string_view>
+
+/**
+ * @brief Decode UTF-8 ke wide string (UTF-16 atau UTF-32 sesuai ukuran wchar_t)
+ *
+ * @param text Bytes UTF-8 (tanpa BOM)
+ * @param decoded Output wide string (ditimpa)
+ * @return false jika ada byte sequence tidak valid, overlong, atau surrogate
+ */
+bool DecodeUtf8(std::string_view text, std::wstring& decoded);
+
+/**
+ * @brief Menambahkan wide string sebagai UTF-8 ke akhir output
+ *
+ * Surrogate UTF-16 yang tidak berpasangan diganti U+FFFD.
+ *
+ * @param text Wide string sumber
+ * @param output Buffer UTF-8 tujuan (tidak dikosongkan)
+ */
+void AppendUtf8(std::wstring_view text, std::string& output);
+
+/**
+ * @brief Menambahkan wide string sebagai string JSON (UTF-8, dengan kutip) ke akhir output
+ *
+ * Kutip, backslash, dan karakter kontrol di-escape; dipakai report JSON
+ * (bulk validation, supervisor metrics, output capture).
+ *
+ * @param value Wide string sumber
+ * @param line Buffer UTF-8 tujuan (tidak dikosongkan)
+ */
+void AppendJsonString(std::wstring_view value, std::string& line);
+
+#endif
@@ -0,0 +1,558 @@
+/**
+ * @file TrustedInstaller.h
+ * @brief Algoritma akuisisi token Trusted Installer dan launch (portable)
+ *
+ * Urutan langkah privilege escalation ditulis di atas IProcessBackend:
+ * 1. Aktifkan SeTcbPrivilege; jika gagal, aktifkan SeDebugPrivilege,
+ *    impersonate token winlogon.exe, lalu aktifkan SeTcbPrivilege di thread
+ * 2. Logon SYSTEM dengan group Trusted Installer (LogonUserExExW)
+ * 3. Revert impersonation
+ * 4. CreateProcessAsUserW dengan token tersebut jika privilege-nya tersedia,
+ *    jika tidak CreateProcessWithTokenW (TrustedInstallerLauncher)
+ *
+ * Operasi kecil (file, registry) dapat dijalankan in-process tanpa membuat
+ * proses baru: RunAsTrustedInstaller menjalankan callback di worker thread
+ * yang meng-impersonate token TI dari cache.
+ *
+ * Karena tidak ada panggilan Win32 langsung, logika ini dapat diuji dan
+ * di-benchmark di Linux dengan backend palsu. Core.cpp membungkus function
+ * di sini dengan tipe Win32 (HANDLE, DWORD) untuk GUI dan CLI.
+ *
+ * Header ini portable (tidak bergantung pada Windows.h maupun VCL).
+ *
+ * @author RasTI Development Team
+ * @version 1.2.0.0
+ * @date 2025
+ */
+
+#ifndef RASTI_TRUSTED_INSTALLER_H
+#define RASTI_TRUSTED_INSTALLER_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include "Backend.h"
+#include "Validation.h"
+
+//==============================================================================
+// WINDOWS PRIVILEGE CONSTANTS
+//==============================================================================
+
+/** @brief Konstanta privilege Windows untuk berbagai operasi sistem
+ *
+ * Privilege ini digunakan untuk mengontrol akses ke berbagai fitur sistem.
+ * Hanya privilege yang relevan dengan aplikasi ini yang didefinisikan.
+ */
+#define SE_CREATE_TOKEN_PRIVILEGE 1           /**< Membuat token akses */
+#define SE_ASSIGNPRIMARYTOKEN_PRIVILEGE 3     /**< Mengassign primary token */
+#define SE_LOCK_MEMORY_PRIVILEGE 4            /**< Mengunci memory */
+#define SE_INCREASE_QUOTA_PRIVILEGE 5         /**< Meningkatkan quota */
+#define SE_UNSOLICITED_INPUT_PRIVILEGE 6      /**< Input tidak diminta */
+#define SE_MACHINE_ACCOUNT_PRIVILEGE 11       /**< Akun mesin */
+#define SE_TCB_PRIVILEGE 7                    /**< Trusted Computing Base */
+#define SE_SECURITY_PRIVILEGE 8               /**< Operasi keamanan */
+#define SE_TAKE_OWNERSHIP_PRIVILEGE 9         /**< Mengambil ownership */
+#define SE_LOAD_DRIVER_PRIVILEGE 10           /**< Memuat driver */
+#define SE_SYSTEM_PROFILE_PRIVILEGE 12        /**< System profiling */
+#define SE_SYSTEMTIME_PRIVILEGE 12            /**< Mengubah waktu sistem */
+#define SE_PROF_SINGLE_PROCESS_PRIVILEGE 13   /**< Profile single process */
+#define SE_INC_BASE_PRIORITY_PRIVILEGE 14     /**< Meningkatkan base priority */
+#define SE_CREATE_PAGEFILE_PRIVILEGE 15       /**< Membuat pagefile */
+#define SE_CREATE_PERMANENT_PRIVILEGE 16      /**< Membuat objek permanent */
+#define SE_BACKUP_PRIVILEGE 17                /**< Backup operations */
+#define SE_RESTORE_PRIVILEGE 18               /**< Restore operations */
+#define SE_SHUTDOWN_PRIVILEGE 19              /**< Shutdown sistem */
+#define SE_DEBUG_PRIVILEGE 20                 /**< Debug privilege */
+#define SE_AUDIT_PRIVILEGE 21                 /**< Audit operations */
+#define SE_SYSTEM_ENVIRONMENT_PRIVILEGE 22    /**< System environment */
+#define SE_CHANGE_NOTIFY_PRIVILEGE 23         /**< Change notifications */
+#define SE_REMOTE_SHUTDOWN_PRIVILEGE 24       /**< Remote shutdown */
+#define SE_UNDOCK_PRIVILEGE 25                /**< Undock privilege */
+#define SE_SYNC_AGENT_PRIVILEGE 26            /**< Sync agent */
+#define SE_ENABLE_DELEGATION_PRIVILEGE 27     /**< Enable delegation */
+#define SE_MANAGE_VOLUME_PRIVILEGE 28         /**< Manage volume */
+#define SE_IMPERSONATE_PRIVILEGE 29           /**< Impersonate privilege */
+#define SE_CREATE_GLOBAL_PRIVILEGE 30         /**< Create global objects */
+#define SE_TRUSTED_CREDMAN_ACCESS_PRIVILEGE 31/**< Trusted credential manager */
+#define SE_RELABEL_PRIVILEGE 32               /**< Relabel privilege */
+#define SE_INC_WORKING_SET_PRIVILEGE 33       /**< Increase working set */
+#define SE_TIME_ZONE_PRIVILEGE 34             /**< Time zone privilege */
+#define SE_CREATE_SYMBOLIC_LINK_PRIVILEGE 35  /**< Create symbolic links */
+
+//==============================================================================
+// BACKWARD COMPATIBILITY ALIASES
+//==============================================================================
+
+/** @brief Alias untuk kompatibilitas backward dengan kode lama */
+#define SeTcbPrivilege SE_TCB_PRIVILEGE
+#define SeDebugPrivilege SE_DEBUG_PRIVILEGE
+#define SeImpersonatePrivilege SE_IMPERSONATE_PRIVILEGE
+#define SeBackupPrivilege SE_BACKUP_PRIVILEGE
+#define SeRestorePrivilege SE_RESTORE_PRIVILEGE
+#define SeTakeOwnershipPrivilege SE_TAKE_OWNERSHIP_PRIVILEGE
+
+//==============================================================================
+// LAUNCH CONSTANTS
+//==============================================================================
+
+/** @brief CREATE_NEW_CONSOLE - setiap proses TI mendapat console sendiri */
+const uint32_t PROCESS_CREATE_NEW_CONSOLE = 0x00000010;
+
+/** @brief DETACHED_PROCESS - proses console tanpa console (tanpa conhost) */
+const uint32_t PROCESS_DETACHED = 0x00000008;
+
+/** @brief CREATE_SUSPENDED - thread utama belum berjalan sampai ResumeProcess (launch pipeline) */
+const uint32_t PROCESS_CREATE_SUSPENDED = 0x00000004;
+
+/** @brief STARTF_USESHOWWINDOW - wShowWindow berlaku untuk window pertama/console */
+const uint32_t PROCESS_STARTF_USESHOWWINDOW = 0x00000001;
+
+/** @brief SW_HIDE */
+const uint16_t PROCESS_SHOW_HIDDEN = 0;
+
+/** @brief IMAGE_SUBSYSTEM_WINDOWS_GUI */
+const uint16_t PROCESS_SUBSYSTEM_GUI = 2;
+
+/** @brief Nama image proses LocalSystem yang tokennya di-impersonate */
+const wchar_t SYSTEM_TOKEN_SOURCE_PROCESS[] = L"winlogon.exe";
+
+//==============================================================================
+// CONSOLE MODE
+//==============================================================================
+
+/**
+ * @brief Console untuk proses yang dibuat (/console)
+ *
+ * Setiap console baru berarti satu proses conhost.exe tambahan; untuk banyak
+ * launch (misalnya /batch) biaya startup dan memorinya ikut dihitung.
+ */
+enum ConsoleMode {
+    CONSOLE_MODE_AUTO = 0,  /**< Dari subsystem PE: GUI = none, console dan script = new */
+    CONSOLE_MODE_NEW,       /**< CREATE_NEW_CONSOLE - window console baru (perilaku lama) */
+    CONSOLE_MODE_INHERIT,   /**< Tanpa flag console - memakai console pemanggil jika ada */
+    CONSOLE_MODE_NONE,      /**< DETACHED_PROCESS - tanpa console dan tanpa conhost */
+    CONSOLE_MODE_HIDDEN     /**< CREATE_NEW_CONSOLE dengan window console tersembunyi */
+};
+
+/**
+ * @brief Parse nama mode: "auto", "new", "inherit", "none", atau "hidden"
+ *
+ * @param name Nama mode (case-insensitive)
+ * @param mode Output mode
+ * @return false jika nama tidak dikenal
+ */
+bool ParseConsoleMode(std::string_view name, ConsoleMode& mode);
+
+/** @brief Nama mode untuk report (misalnya "hidden") */
+const char* GetConsoleModeName(ConsoleMode mode);
+
+/**
+ * @brief Mengganti CONSOLE_MODE_AUTO dengan mode konkret untuk executable
+ *
+ * PE image dengan subsystem GUI tidak pernah memakai console sehingga
+ * mendapat none; image console dan script (.bat/.cmd melalui cmd.exe)
+ * mendapat new. Mode selain AUTO dikembalikan apa adanya.
+ */
+ConsoleMode ResolveConsoleMode(ConsoleMode mode, const ValidatedExecutable& executable);
+
+/**
+ * @brief Mengisi flag CREATE_* dan STARTUPINFOW di request sesuai mode
+ *
+ * Flag console lama di creationFlags dihapus lebih dulu; priority class
+ * tidak diubah. Desktop tetap winsta0\default untuk semua mode agar window
+ * GUI terlihat. AUTO yang belum di-resolve diperlakukan sebagai NEW.
+ */
+void ApplyConsoleMode(ConsoleMode mode, ProcessLaunchRequest& request);
+
+//==============================================================================
+// LAUNCH API
+//==============================================================================
+
+/**
+ * @brief API pembuatan proses dengan token Trusted Installer (/launchapi)
+ *
+ * CreateProcessWithTokenW meneruskan setiap launch ke service Secondary
+ * Logon (seclogon) melalui RPC, yang menambah latency dan menserialisasi
+ * launch paralel. CreateProcessAsUserW membuat proses langsung, tetapi
+ * pemanggil harus memegang SeAssignPrimaryTokenPrivilege,
+ * SeIncreaseQuotaPrivilege, dan SeTcbPrivilege: tersedia di token proses
+ * jika RasTI berjalan sebagai SYSTEM, atau di token thread saat
+ * meng-impersonate winlogon.exe.
+ */
+enum ProcessLaunchApi {
+    LAUNCH_API_AUTO = 0,    /**< CreateProcessAsUserW jika memungkinkan, jika tidak seclogon */
+    LAUNCH_API_SECLOGON,    /**< Selalu CreateProcessWithTokenW (perilaku lama) */
+    LAUNCH_API_AS_USER,     /**< Selalu CreateProcessAsUserW, tanpa fallback */
+    LAUNCH_API_COUNT
+};
+
+/**
+ * @brief Parse nama API: "auto", "seclogon", atau "asuser"
+ *
+ * @param name Nama API (case-insensitive)
+ * @param api Output API
+ * @return false jika nama tidak dikenal
+ */
+bool ParseProcessLaunchApi(std::string_view name, ProcessLaunchApi& api);
+
+/** @brief Nama API untuk report (misalnya "asuser") */
+const char* GetProcessLaunchApiName(ProcessLaunchApi api);
+
+/**
+ * @brief Memilih API launch tercepat yang tersedia di host dan mengingatnya
+ *
+ * Launch pertama (AUTO) mencoba CreateProcessAsUserW: privilege diaktifkan
+ * di token proses, atau di token thread setelah meng-impersonate
+ * winlogon.exe (token winlogon dibuka sekali dan disimpan). Jika privilege
+ * tidak tersedia, atau CreateProcessAsUserW gagal sementara
+ * CreateProcessWithTokenW berhasil, launcher beralih permanen ke seclogon.
+ * Launch berikutnya langsung memakai jalur yang sudah dipilih.
+ *
+ * Thread-safe. Jalur impersonation memakai thread pemanggil; token
+ * impersonation thread sebelumnya (misalnya callback RunAsTrustedInstaller
+ * atau thread host C ABI) dipasang kembali setelah launch, thread tanpa
+ * impersonation di-revert.
+ */
+class TrustedInstallerLauncher {
+private:
+    /** @brief Lokasi privilege CreateProcessAsUserW hasil probe */
+    enum PrivilegeScope {
+        SCOPE_UNKNOWN = 0,      /**< Belum ada launch AUTO/AS_USER */
+        SCOPE_PROCESS,          /**< Token proses (RasTI berjalan sebagai SYSTEM) */
+        SCOPE_SYSTEM_THREAD,    /**< Token thread saat impersonating winlogon.exe */
+        SCOPE_UNAVAILABLE       /**< Tidak tersedia - selalu seclogon */
+    };
+
+    mutable std::mutex mutex_;
+    IProcessBackend* backend_;  /**< Backend yang membuka systemToken_ */
+    ProcessLaunchApi api_;
+    PrivilegeScope scope_;
+    OsHandle systemToken_;      /**< Token winlogon.exe untuk SCOPE_SYSTEM_THREAD (ditutup hanya oleh Reset) */
+
+    static bool LaunchAsUser(IProcessBackend* ps, PrivilegeScope scope, OsHandle systemToken, OsHandle token,
+                             const ProcessLaunchRequest& request, uint32_t& processId, OsHandle* process);
+    OsHandle OpenSystemToken(IProcessBackend* ps);
+    void ResetLocked();
+
+public:
+    TrustedInstallerLauncher()
+        : backend_(NULL), api_(LAUNCH_API_AUTO), scope_(SCOPE_UNKNOWN), systemToken_(OS_INVALID_HANDLE) {}
+    explicit TrustedInstallerLauncher(ProcessLaunchApi api)
+        : backend_(NULL), api_(api), scope_(SCOPE_UNKNOWN), systemToken_(OS_INVALID_HANDLE) {}
+    ~TrustedInstallerLauncher() { Reset(); }
+
+    TrustedInstallerLauncher(const TrustedInstallerLauncher&) = delete;
+    TrustedInstallerLauncher& operator=(const TrustedInstallerLauncher&) = delete;
+
+    /**
+     * @brief Membuat proses dengan token melalui API yang dipilih
+     *
+     * @param token Token Trusted Installer
+     * @param request Application name, command line, flag, dan desktop
+     * @param processId Output PID proses baru (opsional)
+     * @param process Output handle proses (opsional; ditutup pemanggil dengan CloseObject)
+     * @param usedApi Output API yang membuat proses (opsional; SECLOGON atau AS_USER)
+     * @return true jika proses dibuat; jika gagal, kode error launch terakhir
+     *         dipertahankan di GetLastErrorCode backend
+     */
+    bool Launch(OsHandle token, const ProcessLaunchRequest& request, uint32_t* processId = NULL,
+                OsHandle* process = NULL, ProcessLaunchApi* usedApi = NULL);
+
+    /** @brief API yang akan dipakai launch berikutnya (AUTO jika belum di-probe) */
+    ProcessLaunchApi GetSelectedApi() const;
+
+    /**
+     * @brief Menutup token winlogon.exe dan melupakan hasil probe
+     * @warning Tidak boleh dipanggil selama Launch lain berjalan
+     */
+    void Reset();
+};
+
+//==============================================================================
+// TRUSTED INSTALLER ACQUISITION
+//==============================================================================
+
+/**
+ * @brief Mengaktifkan privilege yang diizinkan melalui backend proses aktif
+ *
+ * Hanya SeTcbPrivilege, SeDebugPrivilege, SeImpersonatePrivilege,
+ * SeAssignPrimaryTokenPrivilege dan SeIncreaseQuotaPrivilege (untuk
+ * CreateProcessAsUserW), serta SeBackupPrivilege, SeRestorePrivilege, dan
+ * SeTakeOwnershipPrivilege (untuk /aclreset) yang diterima; privilege lain
+ * ditolak tanpa memanggil backend.
+ *
+ * @param impersonating true jika privilege diaktifkan di token thread
+ * @param privilege Konstanta SE_*_PRIVILEGE
+ * @return true jika privilege aktif
+ */
+bool EnableSupportedPrivilege(bool impersonating, int privilege);
+
+/**
+ * @brief Impersonate token winlogon.exe (LocalSystem) di thread saat ini
+ *
+ * @return true jika thread sekarang berjalan sebagai LocalSystem
+ *
+ * @warning Memerlukan SeDebugPrivilege; panggil RevertImpersonation setelahnya
+ */
+bool ImpersonateSystemToken();
+
+class LaunchPipeline;
+struct LaunchPipelineResult;
+
+/**
+ * @brief Menjalankan seluruh rantai akuisisi token Trusted Installer
+ *
+ * @return Token Trusted Installer milik backend proses aktif, atau
+ *         OS_INVALID_HANDLE jika gagal. Tutup dengan CloseObject.
+ *
+ * @note Impersonation (jika dipakai) selalu di-revert sebelum kembali
+ */
+OsHandle AcquireTrustedInstallerToken();
+
+/**
+ * @brief Akuisisi token lalu membuat proses dengan token tersebut
+ *
+ * @param applicationName lpApplicationName (kosong = ambil dari command line)
+ * @param commandLine Command line lengkap
+ * @param priority Priority class proses baru
+ * @param console Console proses baru (lihat ApplyConsoleMode)
+ * @param api API launch (lihat TrustedInstallerLauncher)
+ * @param usedApi Output API yang membuat proses (opsional)
+ * @param pipeline Tahap konfigurasi sebelum resume (NULL/kosong = launch langsung)
+ * @param pipelineResult Output timing per tahap pipeline (opsional)
+ * @return true jika proses berhasil dibuat
+ *
+ * @note Jika gagal, kode error tahap yang gagal dipertahankan di
+ *       GetLastErrorCode backend (GetLastError di Win32)
+ */
+bool LaunchWithTrustedInstaller(const std::wstring& applicationName,
+                                const std::wstring& commandLine, uint32_t priority,
+                                ConsoleMode console = CONSOLE_MODE_NEW, ProcessLaunchApi api = LAUNCH_API_AUTO,
+                                ProcessLaunchApi* usedApi = NULL, const LaunchPipeline* pipeline = NULL,
+                                LaunchPipelineResult* pipelineResult = NULL);
+
+/**
+ * @brief Membuat proses dengan token Trusted Installer yang sudah dimiliki
+ *
+ * Tidak mengakuisisi token dan tidak mengaktifkan privilege; pemanggil harus
+ * sudah mengaktifkan SeImpersonatePrivilege (lihat LaunchWithTrustedInstaller).
+ * Pemanggil yang melakukan banyak launch memberikan launcher sendiri agar
+ * pilihan API dan token winlogon.exe dipakai ulang.
+ *
+ * @param token Token dari AcquireTrustedInstallerToken atau TrustedInstallerTokenCache
+ * @param applicationName lpApplicationName (kosong = ambil dari command line)
+ * @param commandLine Command line lengkap
+ * @param priority Priority class proses baru
+ * @param processId Output PID proses baru (opsional)
+ * @param process Output handle proses untuk WaitForProcessExit (opsional;
+ *        ditutup pemanggil dengan CloseObject)
+ * @param console Console proses baru (lihat ApplyConsoleMode)
+ * @param launcher Launcher yang memilih API (NULL = launcher sementara dengan AUTO)
+ * @param usedApi Output API yang membuat proses (opsional)
+ * @param pipeline Tahap konfigurasi sebelum resume (NULL/kosong = launch langsung, lihat LaunchPipeline)
+ * @param pipelineResult Output timing per tahap pipeline (opsional)
+ * @return true jika proses berhasil dibuat
+ */
+bool LaunchWithToken(OsHandle token, const std::wstring& applicationName,
+                     const std::wstring& commandLine, uint32_t priority, uint32_t* processId = NULL,
+                     OsHandle* process = NULL, ConsoleMode console = CONSOLE_MODE_NEW,
+                     TrustedInstallerLauncher* launcher = NULL, ProcessLaunchApi* usedApi = NULL,
+                     const LaunchPipeline* pipeline = NULL, LaunchPipelineResult* pipelineResult = NULL);
+
+/**
+ * @brief Launch executable yang sudah tervalidasi sebagai Trusted Installer
+ *
+ * Path di-quote di command line. PE image diberikan sebagai
+ * lpApplicationName (dengan prefix "\\?\" bila perlu) sehingga Windows tidak
+ * mencari ulang file; script dijalankan melalui command line (cmd.exe).
+ *
+ * @param executable Hasil ValidateExecutable (handle harus masih terbuka)
+ * @param priority Priority class proses baru
+ * @param console Console proses baru (AUTO = dari subsystem PE)
+ * @param api API launch (lihat TrustedInstallerLauncher)
+ * @param usedApi Output API yang membuat proses (opsional)
+ * @param pipeline Tahap konfigurasi sebelum resume (NULL/kosong = launch langsung)
+ * @param pipelineResult Output timing per tahap pipeline (opsional)
+ * @return true jika proses berhasil dibuat
+ */
+bool LaunchValidatedExecutable(const ValidatedExecutable& executable, uint32_t priority,
+                               ConsoleMode console = CONSOLE_MODE_AUTO, ProcessLaunchApi api = LAUNCH_API_AUTO,
+                               ProcessLaunchApi* usedApi = NULL, const LaunchPipeline* pipeline = NULL,
+                               LaunchPipelineResult* pipelineResult = NULL);
+
+/**
+ * @brief Request launch untuk executable tervalidasi dengan argumen tambahan
+ *
+ * Sama dengan LaunchValidatedExecutable: path di-quote, PE image lewat
+ * lpApplicationName. Argumen PE di-quote menurut aturan CommandLineToArgvW;
+ * argumen script hanya diberi kutip bila berisi pemisah/operator cmd.
+ * Console belum diterapkan - pemanggil memanggil ApplyConsoleMode.
+ *
+ * @param executable Hasil ValidateExecutable
+ * @param arguments Argumen setelah argv[0]
+ * @param creationFlags Priority class + flag CREATE_*
+ */
+ProcessLaunchRequest BuildValidatedLaunchRequest(const ValidatedExecutable& executable,
+                                                 const std::vector<std::wstring>& arguments,
+                                                 uint32_t creationFlags);
+
+/**
+ * @brief Mengecek apakah proses sudah memiliki privilege TI atau admin elevated
+ *
+ * @return true jika SeTcbPrivilege enabled, atau member Administrators dengan
+ *         token elevated
+ */
+bool HasElevatedPrivileges();
+
+//==============================================================================
+// TOKEN CACHE
+//==============================================================================
+
+/**
+ * @brief Menyimpan satu token Trusted Installer untuk dipakai ulang
+ *
+ * Akuisisi penuh (privilege, impersonation winlogon, LogonUserExExW) jauh
+ * lebih mahal daripada CreateProcessWithTokenW. Proses yang melakukan banyak
+ * launch (benchmark, batch) memakai cache ini sehingga rantai akuisisi hanya
+ * berjalan sekali. Token ditutup oleh Invalidate atau destructor melalui
+ * backend yang membuatnya.
+ *
+ * Thread-safe; handle yang dikembalikan Acquire dipinjam (jangan ditutup)
+ * dan valid sampai Invalidate berikutnya.
+ */
+class TrustedInstallerTokenCache {
+private:
+    mutable std::mutex mutex_;
+    IProcessBackend* backend_;   /**< Backend yang membuat token_ */
+    OsHandle token_;
+
+public:
+    TrustedInstallerTokenCache() : backend_(NULL), token_(OS_INVALID_HANDLE) {}
+    ~TrustedInstallerTokenCache() { Invalidate(); }
+
+    TrustedInstallerTokenCache(const TrustedInstallerTokenCache&) = delete;
+    TrustedInstallerTokenCache& operator=(const TrustedInstallerTokenCache&) = delete;
+
+    /**
+     * @brief Token dari cache, atau akuisisi baru jika cache kosong
+     *
+     * @param cacheHit Output true jika token berasal dari cache (opsional)
+     * @return Token pinjaman, atau OS_INVALID_HANDLE jika akuisisi gagal
+     */
+    OsHandle Acquire(bool* cacheHit = NULL);
+
+    /** @brief Menutup token yang tersimpan (akuisisi berikutnya dari awal) */
+    void Invalidate();
+
+    /** @brief true jika cache menyimpan token */
+    bool HasToken() const;
+};
+
+//==============================================================================
+// IN-PROCESS EXECUTION
+//==============================================================================
+
+/**
+ * @brief Worker thread yang menjalankan callback di bawah token Trusted Installer
+ *
+ * Callback dijalankan berurutan di satu thread khusus. Sebelum callback
+ * pertama, worker mengaktifkan SeImpersonatePrivilege (tanpa privilege ini
+ * Windows hanya memberi impersonation level Identification), mengambil token
+ * dari cache, lalu meng-impersonate token tersebut. Impersonation dipakai
+ * ulang untuk callback berikutnya sampai token di cache berganti, dan
+ * di-revert saat worker berhenti, sehingga satu callback hanya berbiaya satu
+ * serah-terima antar thread (ribuan operasi per detik).
+ *
+ * Exception dari callback diteruskan ke pemanggil melalui future. Callback
+ * tidak boleh mengubah impersonation thread (RevertToSelf, SetThreadToken).
+ */
+class TrustedInstallerWorker {
+private:
+    /** @brief Satu callback dalam antrian */
+    struct Task {
+        std::function<void()> callback;
+        std::promise<uint32_t> done;        /**< 0 = callback dijalankan, selain itu kode error */
+    };
+
+    TrustedInstallerTokenCache& cache_;
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    std::deque<Task> queue_;
+    bool stopping_;
+    OsHandle impersonated_;                 /**< Token yang sedang di-impersonate (milik cache) */
+    std::atomic<std::thread::id> workerId_; /**< Dicatat WorkerLoop sebelum task pertama (thread_ dapat berubah saat join) */
+    std::thread thread_;
+
+    void WorkerLoop();
+    uint32_t PrepareToken();
+
+public:
+    /**
+     * @param cache Sumber token; harus hidup lebih lama dari worker
+     */
+    explicit TrustedInstallerWorker(TrustedInstallerTokenCache& cache);
+
+    /** @brief Menjalankan sisa antrian, revert impersonation, lalu join */
+    ~TrustedInstallerWorker();
+
+    TrustedInstallerWorker(const TrustedInstallerWorker&) = delete;
+    TrustedInstallerWorker& operator=(const TrustedInstallerWorker&) = delete;
+
+    /**
+     * @brief Memasukkan callback ke antrian tanpa menunggu
+     *
+     * @return Future berisi 0 jika callback dijalankan, atau kode error
+     *         akuisisi/impersonation (callback tidak dijalankan)
+     */
+    std::future<uint32_t> Submit(std::function<void()> callback);
+
+    /**
+     * @brief Menjalankan callback dan menunggu selesai
+     *
+     * Dipanggil dari callback worker yang sama, callback langsung dijalankan
+     * di thread tersebut (tidak deadlock).
+     *
+     * @return true jika callback dijalankan; jika false, kode error tersedia
+     *         di GetLastErrorCode backend thread pemanggil
+     */
+    bool Run(const std::function<void()>& callback);
+
+    /**
+     * @brief Menghentikan worker (sama dengan destructor; Submit setelahnya gagal)
+     *
+     * Dipanggil dari callback worker itu sendiri, Stop menandai worker berhenti
+     * dan menyelesaikan sisa antrian dengan OS_ERROR_OPERATION_ABORTED tanpa
+     * menjalankannya; join dilakukan destructor di thread lain.
+     */
+    void Stop();
+};
+
+/**
+ * @brief Menjalankan callback in-process sebagai Trusted Installer
+ *
+ * Memakai worker dan TrustedInstallerTokenCache bersama milik proses (dibuat
+ * saat pemanggilan pertama), sehingga rantai akuisisi hanya berjalan sekali.
+ *
+ * @param callback Operasi yang dijalankan di bawah token TI
+ * @return true jika callback dijalankan; jika false, kode error tahap yang
+ *         gagal tersedia di GetLastErrorCode backend (GetLastError di Win32)
+ */
+bool RunAsTrustedInstaller(const std::function<void()>& callback);
+
+/**
+ * @brief Menghentikan worker bersama dan menutup token cache-nya
+ *
+ * Panggil sebelum keluar dari aplikasi atau sebelum mengganti backend proses.
+ * Worker bersama sengaja tidak dihancurkan oleh destructor static karena
+ * thread lain sudah dihentikan OS saat itu.
+ */
+void ShutdownTrustedInstallerWorker();
+
+#endif
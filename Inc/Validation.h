@@ -0,0 +1,308 @@
+/**
+ * @file Validation.h
+ * @brief Pipeline validasi executable berbasis satu handle untuk RasTI
+ *
+ * Pipeline ini melakukan canonicalization satu kali, membuka file satu kali,
+ * lalu menjalankan seluruh pemeriksaan (identitas file, PE header) dari handle
+ * yang sama. Handle tetap terbuka di dalam ValidatedExecutable sampai proses
+ * di-launch, sehingga file tidak dapat ditukar di antara validasi dan
+ * CreateProcessWithTokenW (TOCTOU).
+ *
+ * Header ini portable (tidak bergantung pada Windows.h maupun VCL).
+ *
+ * @author RasTI Development Team
+ * @version 1.2.0.0
+ * @date 2025
+ */
+
+#ifndef RASTI_VALIDATION_H
+#define RASTI_VALIDATION_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include "Backend.h"
+#include "PathPolicy.h"
+#include "Sha256.h"
+
+//==============================================================================
+// CONSTANTS
+//==============================================================================
+
+/** @brief Panjang path maksimum yang diterima pipeline (batas path NT/UNICODE_STRING) */
+const size_t VALIDATION_MAX_PATH = 32767;
+
+/** @brief MAX_PATH klasik Win32 - path sepanjang ini atau lebih butuh prefix \\?\ */
+const size_t LEGACY_MAX_PATH = 260;
+
+/** @brief Prefix extended-length path Win32 */
+const wchar_t EXTENDED_PATH_PREFIX[] = L"\\\\?\\";
+
+/** @brief Jumlah bytes yang dibaca dari awal file untuk pemeriksaan PE header */
+const uint32_t PE_HEADER_PROBE_SIZE = 1024;
+
+//==============================================================================
+// RESULT TYPES
+//==============================================================================
+
+/**
+ * @brief Jenis executable yang ditentukan dari extension file
+ */
+enum ExecutableKind {
+    EXECUTABLE_KIND_UNKNOWN = 0, /**< Extension tidak diizinkan */
+    EXECUTABLE_KIND_PE_IMAGE,    /**< .exe / .com - harus berupa PE image */
+    EXECUTABLE_KIND_SCRIPT,      /**< .bat / .cmd - dijalankan oleh cmd.exe */
+    EXECUTABLE_KIND_POWERSHELL   /**< .ps1 - hanya melalui script host (ValidateScript) */
+};
+
+/**
+ * @brief Kode hasil validasi - menunjukkan tahap pipeline yang gagal
+ */
+enum ValidationError {
+    VALIDATION_OK = 0,              /**< Semua validasi berhasil */
+    VALIDATION_EMPTY_PATH,          /**< Path kosong */
+    VALIDATION_PATH_TOO_LONG,       /**< Path melebihi VALIDATION_MAX_PATH */
+    VALIDATION_UNSAFE_PATH,         /**< Path traversal atau karakter berbahaya */
+    VALIDATION_CANONICALIZE_FAILED, /**< GetFullPath gagal */
+    VALIDATION_BAD_EXTENSION,       /**< Extension bukan .exe/.bat/.cmd/.com */
+    VALIDATION_NOT_FOUND,           /**< File tidak ditemukan di path maupun PATH */
+    VALIDATION_IS_DIRECTORY,        /**< Path menunjuk ke direktori */
+    VALIDATION_IO_ERROR,            /**< Query identitas atau read header gagal */
+    VALIDATION_NOT_PE_IMAGE,        /**< .exe/.com tetapi bukan PE executable yang valid */
+    VALIDATION_NOT_ALLOWLISTED,     /**< Allowlist aktif dan SHA-256 file tidak terdaftar */
+    VALIDATION_POLICY_DENIED        /**< Policy path aktif menolak lokasi file */
+};
+
+/**
+ * @brief Informasi PE header yang dibaca dari handle file
+ */
+struct PeImageInfo {
+    uint16_t machine;         /**< IMAGE_FILE_HEADER.Machine */
+    uint16_t characteristics; /**< IMAGE_FILE_HEADER.Characteristics */
+    uint16_t subsystem;       /**< IMAGE_OPTIONAL_HEADER.Subsystem (GUI/CUI) */
+    bool is64Bit;             /**< true untuk PE32+ */
+};
+
+/**
+ * @brief Hasil validasi yang memegang handle file tervalidasi
+ *
+ * Object ini move-only. Selama masih hidup, file yang tervalidasi tetap
+ * terbuka dengan share mode read-only sehingga tidak dapat ditulis, dihapus,
+ * atau di-rename oleh proses lain.
+ */
+struct ValidatedExecutable {
+    std::wstring path;                                /**< Canonical path final */
+    FileIdentity identity = {};                       /**< Identitas dari handle */
+    ExecutableKind kind = EXECUTABLE_KIND_UNKNOWN;    /**< Jenis executable */
+    PeImageInfo image = {};                           /**< Valid jika kind == PE_IMAGE */
+    PathPolicyMatch policy;                           /**< Hasil policy path (ALLOWED jika tidak aktif) */
+    Sha256Digest sha256 = {};                         /**< Valid jika hasSha256 */
+    bool hasSha256 = false;                           /**< true jika hash dihitung (allowlist aktif) */
+    ScopedBackendFile file;                           /**< Handle yang tetap terbuka */
+};
+
+//==============================================================================
+// VALIDATION PIPELINE
+//==============================================================================
+
+/**
+ * @brief Validasi executable dengan pipeline satu handle
+ *
+ * Tahapan (setiap tahap hanya dijalankan jika tahap sebelumnya berhasil):
+ * 1. Pemeriksaan string: kosong, panjang, traversal, extension (tanpa syscall)
+ * 2. Canonicalization satu kali (GetFullPath)
+ * 3. Open file satu kali - sekaligus berfungsi sebagai existence check;
+ *    jika gagal, cari nama file di direktori PATH
+ * 4. Jika policy path aktif: rule allow/deny untuk lokasi final (tanpa syscall)
+ * 5. Identitas file dari handle (menolak direktori)
+ * 6. PE header check dari handle yang sama (.exe/.com)
+ * 7. Jika allowlist aktif: SHA-256 dari handle yang sama (dengan cache)
+ *
+ * @param path Path input (relative, absolute, atau nama file saja)
+ * @param result Output hasil validasi beserta handle yang tetap terbuka
+ * @return VALIDATION_OK jika berhasil, kode error tahap yang gagal jika tidak
+ */
+ValidationError ValidateExecutable(std::wstring_view path, ValidatedExecutable& result);
+
+/**
+ * @brief Membuka dan memeriksa file executable tanpa canonicalization/PATH search
+ *
+ * @param canonicalPath Path absolute ke file
+ * @param result Output hasil validasi beserta handle yang tetap terbuka
+ * @return VALIDATION_OK jika file ada, bukan direktori, dan sesuai jenisnya
+ */
+ValidationError InspectExecutableFile(std::wstring_view canonicalPath, ValidatedExecutable& result);
+
+/**
+ * @brief Validasi script untuk script host (.bat/.cmd/.ps1)
+ *
+ * Tahapan sama dengan ValidateExecutable (string check, canonicalization
+ * satu kali, open satu kali, policy, identitas, allowlist) tetapi tanpa
+ * pencarian PATH dan hanya menerima extension script. Hanya jalur ini yang
+ * menerima .ps1; ValidateExecutable tetap menolaknya karena .ps1 tidak
+ * dapat dijalankan langsung oleh CreateProcessWithTokenW.
+ *
+ * @param path Path script (relative atau absolute)
+ * @param result Output hasil validasi (kind SCRIPT atau POWERSHELL)
+ * @return VALIDATION_OK jika berhasil, kode error tahap yang gagal jika tidak
+ */
+ValidationError ValidateScript(std::wstring_view path, ValidatedExecutable& result);
+
+/**
+ * @brief Mengecek apakah path mengandung path traversal attacks
+ *
+ * Mencegah directory traversal dengan mendeteksi:
+ * - "../" atau "..\" patterns
+ * - Karakter berbahaya: < > " | ? *
+ *
+ * Prefix extended-length "\\?\" di awal path diizinkan.
+ *
+ * @param path Path yang akan diperiksa
+ * @return true jika path aman, false jika mengandung traversal
+ */
+bool IsPathTraversalSafe(std::wstring_view path);
+
+/**
+ * @brief Membersihkan dan menormalkan path string
+ *
+ * Operasi yang dilakukan:
+ * - Trim whitespace
+ * - Normalize path separators (/ ke \)
+ * - Remove duplicate separators (prefix UNC "\\" dan "\\?\" dipertahankan)
+ * - Convert relative path ke absolute jika perlu (current directory dari backend)
+ *
+ * @param path String path yang akan disanitasi (modified in-place)
+ * @return true jika sanitasi berhasil, false jika path kosong setelah sanitasi
+ */
+bool SanitizePath(std::wstring& path);
+
+/**
+ * @brief Mengkonversi path ke bentuk canonical (normalized)
+ *
+ * Menggunakan GetFullPath backend (GetFullPathNameW) satu kali untuk:
+ * - Resolve ".", "..", dan relative components
+ * - Convert relative paths ke absolute paths
+ * - Normalize path separators dan hapus trailing backslash (kecuali root)
+ *
+ * @param path Input path (relative atau absolute, boleh lebih dari MAX_PATH)
+ * @return Canonical path jika berhasil, string kosong jika gagal
+ */
+std::wstring GetCanonicalPath(std::wstring_view path);
+
+/**
+ * @brief Menambahkan prefix "\\?\" jika path terlalu panjang untuk API Win32 klasik
+ *
+ * - "C:\..." menjadi "\\?\C:\..."
+ * - "\\server\share\..." menjadi "\\?\UNC\server\share\..."
+ * - Path yang lebih pendek dari LEGACY_MAX_PATH atau sudah ber-prefix tidak diubah
+ *
+ * @param path Path absolute
+ * @return Path yang aman untuk CreateFileW/CreateProcessW tanpa batas MAX_PATH
+ */
+std::wstring ToExtendedLengthPath(std::wstring_view path);
+
+/**
+ * @brief Mengecek apakah file adalah executable yang valid
+ *
+ * @param path Path lengkap ke file
+ * @return true jika file executable valid, false jika tidak
+ *
+ * @note Membuka file satu kali lalu memeriksa identitas dan PE header dari handle
+ */
+bool IsValidExecutable(std::wstring_view path);
+
+/**
+ * @brief Mencari executable dalam PATH environment variable
+ *
+ * @param exeName Nama executable (dengan atau tanpa .exe extension)
+ * @return Path lengkap jika ditemukan, string kosong jika tidak
+ *
+ * @note Menambahkan .exe extension jika tidak ada
+ */
+std::wstring FindExecutableInPath(std::wstring_view exeName);
+
+/**
+ * @brief Menentukan jenis executable dari extension path (case-insensitive)
+ *
+ * @param path Path atau nama file
+ * @return EXECUTABLE_KIND_UNKNOWN jika extension tidak diizinkan
+ */
+ExecutableKind GetExecutableKind(std::wstring_view path);
+
+/**
+ * @brief Menentukan jenis script yang diterima script host dari extension (case-insensitive)
+ *
+ * @param path Path atau nama file
+ * @return EXECUTABLE_KIND_SCRIPT (.bat/.cmd), EXECUTABLE_KIND_POWERSHELL (.ps1),
+ *         atau EXECUTABLE_KIND_UNKNOWN
+ */
+ExecutableKind GetScriptKind(std::wstring_view path);
+
+/**
+ * @brief Parse PE header dari buffer yang dimulai di offset 0 file
+ *
+ * @param data Buffer berisi awal file
+ * @param size Ukuran buffer
+ * @param info Output informasi PE
+ * @return true jika buffer berisi PE executable image (bukan DLL)
+ */
+bool ParsePeImageHeader(const uint8_t* data, size_t size, PeImageInfo& info);
+
+//==============================================================================
+// PATH SEARCH INDEX
+//==============================================================================
+
+/**
+ * @brief Snapshot isi direktori PATH: nama executable -> lokasi pertama
+ *
+ * Tanpa index, setiap pencarian nama file membaca PATH lalu mencoba open di
+ * setiap direktori. Untuk validasi massal (audit), index dibangun sekali lalu
+ * dipakai bersama oleh semua thread sehingga pencarian cukup satu open.
+ */
+class PathSearchIndex {
+private:
+    std::unordered_map<std::wstring, std::wstring> entries_; /**< Nama lowercase -> path lengkap */
+
+public:
+    /**
+     * @brief Membaca PATH dan mendaftar executable di setiap direktorinya
+     * @param fs Backend filesystem
+     * @return false jika PATH tidak ada
+     */
+    bool Build(IFileSystemBackend* fs);
+
+    /**
+     * @brief Mencari lokasi nama file (case-insensitive)
+     * @param fileName Nama file dengan extension
+     * @param fullPath Output path lengkap di direktori PATH pertama yang memuatnya
+     * @return true jika ditemukan
+     */
+    bool Find(std::wstring_view fileName, std::wstring& fullPath) const;
+
+    /** @brief Jumlah executable di index */
+    size_t Size() const { return entries_.size(); }
+};
+
+/**
+ * @brief Memasang index PATH yang dipakai pencarian executable
+ *
+ * @param index Index aktif, atau NULL untuk kembali membaca PATH setiap pencarian
+ *
+ * @note Pemanggil tetap memiliki object dan harus menjaganya tetap hidup
+ *       selama terpasang
+ */
+void SetPathSearchIndex(const PathSearchIndex* index);
+
+/**
+ * @brief Index PATH yang sedang aktif (NULL jika tidak ada)
+ */
+const PathSearchIndex* GetPathSearchIndex();
+
+/**
+ * @brief Nama singkat untuk kode hasil validasi (untuk logging/report)
+ */
+const char* GetValidationErrorName(ValidationError error);
+
+#endif
@@ -0,0 +1,175 @@
+/**
+ * @file WorkStealingScheduler.h
+ * @brief Antrian task per worker dengan work stealing (dipakai bulk audit dan /fileops)
+ *
+ * Setiap worker memiliki deque task sendiri. Worker mengambil task terbaru
+ * dari ujung belakang antriannya (data yang baru dibaca masih hangat di
+ * cache), dan mencuri task tertua dari ujung depan antrian worker lain saat
+ * antriannya kosong. Saat walk direktori, task tertua biasanya direktori
+ * yang lebih dekat ke root, sehingga satu pencurian membawa banyak pekerjaan.
+ *
+ * Header ini portable (tidak bergantung pada Windows.h maupun VCL).
+ *
+ * @author RasTI Development Team
+ * @version 1.2.0.0
+ * @date 2025
+ */
+
+#ifndef RASTI_WORK_STEALING_SCHEDULER_H
+#define RASTI_WORK_STEALING_SCHEDULER_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+/**
+ * @brief Antrian per worker dengan pencurian task dari worker lain
+ *
+ * @tparam Task Tipe unit kerja (movable)
+ */
+template <typename Task>
+class WorkStealingScheduler {
+private:
+    struct WorkerQueue {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    std::vector<std::unique_ptr<WorkerQueue>> queues_;
+    std::atomic<uint64_t> outstanding_; /**< Task yang sudah di-push tetapi belum selesai */
+    std::atomic<uint64_t> stolen_;
+    std::atomic<unsigned> sleepers_;    /**< Worker yang menunggu di idleWake_ */
+    std::mutex idleMutex_;
+    std::condition_variable idleWake_;
+    uint64_t signal_;                   /**< Dinaikkan (di bawah idleMutex_) saat ada task baru atau semua selesai */
+
+    /** @brief Membangunkan worker yang parkir (Push ke worker yang sedang tidur, atau Complete terakhir) */
+    void Signal() {
+        {
+            std::lock_guard<std::mutex> lock(idleMutex_);
+            signal_++;
+        }
+        idleWake_.notify_all();
+    }
+
+    /**
+     * @brief Parkir sampai ada task baru atau semua task selesai
+     *
+     * Pop diulang setelah sleepers_ dinaikkan: Push yang terjadi sebelum itu
+     * terlihat oleh Pop ini, dan Push sesudahnya melihat sleepers_ != 0 lalu
+     * memanggil Signal.
+     *
+     * @return true jika task berhasil diambil
+     */
+    bool WaitForTask(unsigned worker, Task& task) {
+        std::unique_lock<std::mutex> lock(idleMutex_);
+        sleepers_++;
+        uint64_t seen = signal_;
+        bool popped = Pop(worker, task);
+        if (!popped && !Idle()) {
+            idleWake_.wait(lock, [&] { return signal_ != seen || Idle(); });
+        }
+        sleepers_--;
+        return popped;
+    }
+
+    /** @brief Complete saat scope berakhir, termasuk saat run melempar exception */
+    struct CompleteGuard {
+        WorkStealingScheduler& scheduler;
+        ~CompleteGuard() { scheduler.Complete(); }
+    };
+
+public:
+    explicit WorkStealingScheduler(unsigned workerCount) : outstanding_(0), stolen_(0), sleepers_(0), signal_(0) {
+        for (unsigned i = 0; i < workerCount; i++) {
+            queues_.push_back(std::unique_ptr<WorkerQueue>(new WorkerQueue()));
+        }
+    }
+
+    /** @brief Menambahkan task ke antrian worker (worker itu sendiri, atau sebelum worker berjalan) */
+    void Push(unsigned worker, Task&& task) {
+        outstanding_++;
+        {
+            WorkerQueue& queue = *queues_[worker];
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            queue.tasks.push_back(std::move(task));
+        }
+        if (sleepers_.load() != 0) {
+            Signal();
+        }
+    }
+
+    /** @brief Mengambil task sendiri (LIFO) atau mencuri dari worker lain (FIFO) */
+    bool Pop(unsigned worker, Task& task) {
+        {
+            WorkerQueue& own = *queues_[worker];
+            std::lock_guard<std::mutex> lock(own.mutex);
+            if (!own.tasks.empty()) {
+                task = std::move(own.tasks.back());
+                own.tasks.pop_back();
+                return true;
+            }
+        }
+
+        size_t count = queues_.size();
+        for (size_t offset = 1; offset < count; offset++) {
+            WorkerQueue& victim = *queues_[(worker + offset) % count];
+            std::lock_guard<std::mutex> lock(victim.mutex);
+            if (!victim.tasks.empty()) {
+                task = std::move(victim.tasks.front());
+                victim.tasks.pop_front();
+                stolen_++;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /** @brief Menandai task selesai (setelah semua child task di-push) */
+    void Complete() {
+        if (--outstanding_ == 0) {
+            Signal();
+        }
+    }
+
+    /** @brief true jika tidak ada task tersisa maupun yang sedang berjalan */
+    bool Idle() const { return outstanding_.load() == 0; }
+
+    /**
+     * @brief Menjalankan worker sampai semua task (termasuk yang dibuat worker lain) selesai
+     *
+     * Worker tanpa task parkir di condition variable selama worker lain masih
+     * memproses task yang bisa menghasilkan task baru (misalnya satu copy file
+     * besar), bukan berputar di yield. Task yang melempar exception tetap
+     * di-Complete sehingga worker lain tidak menunggu selamanya; exception
+     * diteruskan ke pemanggil RunWorker.
+     *
+     * @param worker Index worker pemanggil
+     * @param run Dipanggil untuk setiap task; boleh Push task baru ke worker ini
+     */
+    template <typename Function>
+    void RunWorker(unsigned worker, Function&& run) {
+        Task task;
+        for (;;) {
+            if (Pop(worker, task) || WaitForTask(worker, task)) {
+                CompleteGuard done = { *this };
+                run(task);
+                continue;
+            }
+
+            if (Idle()) {
+                return;
+            }
+        }
+    }
+
+    unsigned WorkerCount() const { return static_cast<unsigned>(queues_.size()); }
+
+    uint64_t StolenCount() const { return stolen_.load(); }
+};
+
+#endif
@@ -0,0 +1,976 @@
+/**
+ * @file AclReset.cpp
+ * @brief Implementasi /aclreset: model SDDL, pewarisan ACE, descriptor intern, dan checkpoint
+ *
+ * Satu task = satu direktori: pasang descriptor direktori itu, daftar isinya,
+ * pasang descriptor turunan ke setiap file, lalu push setiap sub-direktori
+ * sebagai task baru. Direktori yang sudah di-push tetapi belum selesai
+ * dicatat di set pending; set inilah yang disimpan ke checkpoint.
+ *
+ * @author RasTI Development Team
+ * @version 1.2.0.0
+ * @date 2025
+ */
+
+#include "AclReset.h"
+#include "FileOperations.h"
+#include "TextEncoding.h"
+#include "TrustedInstaller.h"
+#include "WorkStealingScheduler.h"
+#include <chrono>
+#include <cstdio>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+//==============================================================================
+// SDDL MODEL
+//==============================================================================
+
+/**
+ * @brief Alias hak akses SDDL (dua huruf) dan access mask-nya
+ */
+struct AccessRightAlias {
+    const wchar_t* name;
+    uint32_t mask;
+};
+
+static const AccessRightAlias kAccessRights[] = {
+    { L"GA", 0x10000000 }, { L"GX", 0x20000000 }, { L"GW", 0x40000000 }, { L"GR", 0x80000000 },
+    { L"FA", 0x001F01FF }, { L"FR", 0x00120089 }, { L"FW", 0x00120116 }, { L"FX", 0x001200A0 },
+    { L"KA", 0x000F003F }, { L"KR", 0x00020019 }, { L"KW", 0x00020006 }, { L"KX", 0x00020019 },
+    { L"SD", 0x00010000 }, { L"RC", 0x00020000 }, { L"WD", 0x00040000 }, { L"WO", 0x00080000 },
+    { L"CC", 0x00000001 }, { L"DC", 0x00000002 }, { L"LC", 0x00000004 }, { L"SW", 0x00000008 },
+    { L"RP", 0x00000010 }, { L"WP", 0x00000020 }, { L"DT", 0x00000040 }, { L"LO", 0x00000080 },
+    { L"CR", 0x00000100 }
+};
+
+/** @brief Flag ACE SDDL dalam urutan penulisan kanonik */
+struct AceFlagAlias {
+    const wchar_t* name;
+    uint8_t flag;
+};
+
+static const AceFlagAlias kAceFlags[] = {
+    { L"OI", ACL_ACE_OBJECT_INHERIT }, { L"CI", ACL_ACE_CONTAINER_INHERIT }, { L"NP", ACL_ACE_NO_PROPAGATE },
+    { L"IO", ACL_ACE_INHERIT_ONLY }, { L"ID", ACL_ACE_INHERITED }
+};
+
+/** @brief Bit GENERIC_* (GA/GX/GW/GR) */
+const uint32_t ACL_GENERIC_MASK = 0xF0000000;
+
+static bool ParseAccessMask(std::wstring_view text, uint32_t& mask)
+{
+    mask = 0;
+    if (text.empty()) {
+        return false;
+    }
+
+    // Numerik: "0x1200a9" (format ConvertSecurityDescriptorToStringSecurityDescriptorW) atau desimal
+    bool hex = text.size() > 2 && text[0] == L'0' && (text[1] == L'x' || text[1] == L'X');
+    if (hex || (text[0] >= L'0' && text[0] <= L'9')) {
+        size_t start = hex ? 2 : 0;
+        uint64_t value = 0;
+        for (size_t i = start; i < text.size(); i++) {
+            wchar_t ch = text[i];
+            unsigned digit;
+            if (ch >= L'0' && ch <= L'9') digit = ch - L'0';
+            else if (hex && ch >= L'a' && ch <= L'f') digit = ch - L'a' + 10;
+            else if (hex && ch >= L'A' && ch <= L'F') digit = ch - L'A' + 10;
+            else return false;
+            value = value * (hex ? 16 : 10) + digit;
+            if (value > 0xFFFFFFFFull) return false;
+        }
+        mask = static_cast<uint32_t>(value);
+        return true;
+    }
+
+    if (text.size() % 2 != 0) {
+        return false;
+    }
+    for (size_t i = 0; i < text.size(); i += 2) {
+        std::wstring_view token = text.substr(i, 2);
+        bool known = false;
+        for (const AccessRightAlias& alias : kAccessRights) {
+            if (token == alias.name) {
+                mask |= alias.mask;
+                known = true;
+                break;
+            }
+        }
+        if (!known) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static bool ParseAceFlags(std::wstring_view text, uint8_t& flags)
+{
+    flags = 0;
+    if (text.size() % 2 != 0) {
+        return false;
+    }
+    for (size_t i = 0; i < text.size(); i += 2) {
+        std::wstring_view token = text.substr(i, 2);
+        bool known = false;
+        for (const AceFlagAlias& alias : kAceFlags) {
+            if (token == alias.name) {
+                flags |= alias.flag;
+                known = true;
+                break;
+            }
+        }
+        if (!known) {
+            return false; // SA/FA (audit) tidak berlaku untuk DACL
+        }
+    }
+    return true;
+}
+
+/** @brief SID ("S-1-5-18") atau alias SDDL ("SY"); validasi penuh dilakukan BuildSecurityDescriptor */
+static bool IsSidText(std::wstring_view text)
+{
+    if (text.empty()) {
+        return false;
+    }
+    for (wchar_t ch : text) {
+        bool valid = (ch >= L'A' && ch <= L'Z') || (ch >= L'a' && ch <= L'z') || (ch >= L'0' && ch <= L'9') ||
+                     ch == L'-';
+        if (!valid) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/** @brief Parse isi satu ACE "A;OICI;FA;;;SY" (tanpa kurung) */
+static bool ParseAce(std::wstring_view text, AclEntry& entry)
+{
+    std::wstring_view fields[6];
+    size_t count = 0;
+    while (count < 6) {
+        size_t end = text.find(L';');
+        fields[count++] = text.substr(0, end);
+        if (end == std::wstring_view::npos) {
+            text = std::wstring_view();
+            break;
+        }
+        text.remove_prefix(end + 1);
+    }
+    if (count != 6 || !text.empty()) {
+        return false; // ACE kondisional/resource attribute memiliki field tambahan
+    }
+
+    if (fields[0] == L"A") entry.deny = false;
+    else if (fields[0] == L"D") entry.deny = true;
+    else return false;
+
+    // Object GUID hanya untuk ACE object (OA/OD) milik Active Directory
+    if (!fields[3].empty() || !fields[4].empty() || !IsSidText(fields[5])) {
+        return false;
+    }
+    entry.sid.assign(fields[5]);
+    return ParseAceFlags(fields[1], entry.flags) && ParseAccessMask(fields[2], entry.mask);
+}
+
+static bool ParseDacl(std::wstring_view text, AclTemplate& acl)
+{
+    // Flag DACL sebelum ACE pertama
+    while (!text.empty() && text.front() != L'(') {
+        if (text.front() == L'P') {
+            acl.isProtected = true;
+            text.remove_prefix(1);
+        } else if (text.substr(0, 2) == L"AI" || text.substr(0, 2) == L"AR") {
+            text.remove_prefix(2);
+        } else {
+            return false; // Termasuk NO_ACCESS_CONTROL (DACL NULL)
+        }
+    }
+
+    while (!text.empty()) {
+        size_t end = text.find(L')');
+        if (text.front() != L'(' || end == std::wstring_view::npos) {
+            return false;
+        }
+        AclEntry entry;
+        if (!ParseAce(text.substr(1, end - 1), entry)) {
+            return false;
+        }
+        acl.entries.push_back(std::move(entry));
+        text.remove_prefix(end + 1);
+    }
+    return true;
+}
+
+bool ParseAclTemplate(std::wstring_view sddl, AclTemplate& acl)
+{
+    acl = AclTemplate();
+    while (!sddl.empty() && (sddl.front() == L' ' || sddl.front() == L'\t')) sddl.remove_prefix(1);
+    while (!sddl.empty() && (sddl.back() == L' ' || sddl.back() == L'\t' || sddl.back() == L'\r')) sddl.remove_suffix(1);
+
+    bool hasOwner = false;
+    bool hasDacl = false;
+    while (!sddl.empty()) {
+        if (sddl.size() < 2 || sddl[1] != L':') {
+            return false;
+        }
+        wchar_t tag = sddl[0];
+        sddl.remove_prefix(2);
+
+        // Bagian berikutnya dimulai dengan "X:" di luar kurung
+        size_t end = 0;
+        int depth = 0;
+        while (end < sddl.size()) {
+            wchar_t ch = sddl[end];
+            if (ch == L'(') depth++;
+            else if (ch == L')') depth--;
+            else if (depth == 0 && end + 1 < sddl.size() && sddl[end + 1] == L':' &&
+                     (ch == L'O' || ch == L'G' || ch == L'D' || ch == L'S')) break;
+            end++;
+        }
+        std::wstring_view section = sddl.substr(0, end);
+        sddl.remove_prefix(end);
+
+        if (tag == L'O' && !hasOwner && IsSidText(section)) {
+            acl.owner.assign(section);
+            hasOwner = true;
+        } else if (tag == L'D' && !hasDacl) {
+            if (!ParseDacl(section, acl)) {
+                return false;
+            }
+            hasDacl = true;
+        } else {
+            return false; // Group dan SACL tidak diubah oleh /aclreset
+        }
+    }
+    return hasOwner && hasDacl;
+}
+
+std::wstring FormatAclTemplate(const AclTemplate& acl)
+{
+    std::wstring text = L"O:" + acl.owner + L"D:" + (acl.isProtected ? L"P" : L"AI");
+    wchar_t mask[16];
+    for (const AclEntry& entry : acl.entries) {
+        text += entry.deny ? L"(D;" : L"(A;";
+        for (const AceFlagAlias& alias : kAceFlags) {
+            if (entry.flags & alias.flag) text += alias.name;
+        }
+        swprintf(mask, sizeof(mask) / sizeof(mask[0]), L";0x%x;;;", static_cast<unsigned>(entry.mask));
+        text += mask;
+        text += entry.sid;
+        text += L')';
+    }
+    return text;
+}
+
+/** @brief Memetakan GENERIC_* ke hak file (FILE_GENERIC_*, FILE_ALL_ACCESS) */
+static uint32_t MapGenericFileRights(uint32_t mask)
+{
+    uint32_t mapped = mask & ~ACL_GENERIC_MASK;
+    if (mask & 0x80000000) mapped |= 0x00120089; // GENERIC_READ -> FILE_GENERIC_READ
+    if (mask & 0x40000000) mapped |= 0x00120116; // GENERIC_WRITE -> FILE_GENERIC_WRITE
+    if (mask & 0x20000000) mapped |= 0x001200A0; // GENERIC_EXECUTE -> FILE_GENERIC_EXECUTE
+    if (mask & 0x10000000) mapped |= 0x001F01FF; // GENERIC_ALL -> FILE_ALL_ACCESS
+    return mapped;
+}
+
+void DeriveInheritedAcl(const AclTemplate& parent, bool isDirectory, AclTemplate& child)
+{
+    child = AclTemplate();
+    child.owner = parent.owner;
+
+    for (const AclEntry& entry : parent.entries) {
+        bool objectInherit = (entry.flags & ACL_ACE_OBJECT_INHERIT) != 0;
+        bool containerInherit = (entry.flags & ACL_ACE_CONTAINER_INHERIT) != 0;
+        bool noPropagate = (entry.flags & ACL_ACE_NO_PROPAGATE) != 0;
+
+        AclEntry inherited = entry;
+        if (!isDirectory) {
+            if (!objectInherit) continue;
+            inherited.flags = ACL_ACE_INHERITED;
+            inherited.mask = MapGenericFileRights(entry.mask);
+            child.entries.push_back(inherited);
+            continue;
+        }
+
+        if (containerInherit) {
+            uint8_t propagate = entry.flags & (ACL_ACE_OBJECT_INHERIT | ACL_ACE_CONTAINER_INHERIT);
+            if (noPropagate) {
+                inherited.flags = ACL_ACE_INHERITED;
+                inherited.mask = MapGenericFileRights(entry.mask);
+                child.entries.push_back(inherited);
+            } else if (entry.mask & ACL_GENERIC_MASK) {
+                // Hak generic: ACE efektif yang dipetakan + ACE inherit-only untuk turunan berikutnya
+                inherited.flags = ACL_ACE_INHERITED;
+                inherited.mask = MapGenericFileRights(entry.mask);
+                child.entries.push_back(inherited);
+                inherited.flags = propagate | ACL_ACE_INHERIT_ONLY | ACL_ACE_INHERITED;
+                inherited.mask = entry.mask;
+                child.entries.push_back(inherited);
+            } else {
+                inherited.flags = propagate | ACL_ACE_INHERITED;
+                child.entries.push_back(inherited);
+            }
+        } else if (objectInherit && !noPropagate) {
+            // Hanya untuk file di bawah direktori ini: inherit-only di direktori
+            inherited.flags = ACL_ACE_OBJECT_INHERIT | ACL_ACE_INHERIT_ONLY | ACL_ACE_INHERITED;
+            child.entries.push_back(inherited);
+        }
+    }
+}
+
+/** @brief Owner + DACL sama (flag AI/AR tidak dibandingkan) */
+static bool SameAcl(const AclTemplate& a, const AclTemplate& b)
+{
+    return a.owner == b.owner && a.isProtected == b.isProtected && a.entries == b.entries;
+}
+
+//==============================================================================
+// DESCRIPTOR TABLE
+//==============================================================================
+
+/**
+ * @brief Descriptor unik yang sudah dikompilasi
+ */
+struct AclDescriptor {
+    std::wstring key;              /**< FormatAclTemplate (kunci intern, disimpan di checkpoint) */
+    AclTemplate target;            /**< Hasil normalisasi backend, pembanding ReadSecurity */
+    std::vector<uint8_t> bytes;    /**< Untuk WriteSecurity */
+    int64_t fileChild = -1;        /**< Id descriptor turunan untuk file (-1 = belum dihitung) */
+    int64_t directoryChild = -1;   /**< Id descriptor turunan untuk direktori */
+};
+
+/**
+ * @brief Tabel intern descriptor yang dipakai bersama semua worker
+ *
+ * Descriptor tidak pernah dihapus; pointer dari Get tetap valid sampai
+ * tabel dihancurkan. Field target dan bytes tidak berubah setelah Intern.
+ */
+class AclDescriptorTable {
+private:
+    std::mutex mutex_;
+    std::vector<std::unique_ptr<AclDescriptor>> descriptors_;
+    std::unordered_map<std::wstring, uint32_t> index_;
+
+    bool InternLocked(const AclTemplate& acl, uint32_t& id, uint32_t& error) {
+        std::wstring key = FormatAclTemplate(acl);
+        auto found = index_.find(key);
+        if (found != index_.end()) {
+            id = found->second;
+            return true;
+        }
+
+        IFileOperationBackend* fo = GetFileOperationBackend();
+        std::unique_ptr<AclDescriptor> descriptor(new AclDescriptor());
+        std::wstring normalized;
+        if (!fo->BuildSecurityDescriptor(key, descriptor->bytes, normalized)) {
+            error = fo->GetLastErrorCode();
+            return false;
+        }
+        if (!ParseAclTemplate(normalized, descriptor->target)) {
+            descriptor->target = acl; // Tidak dapat dibandingkan: object selalu ditulis ulang
+        }
+        descriptor->key = key;
+
+        id = static_cast<uint32_t>(descriptors_.size());
+        descriptors_.push_back(std::move(descriptor));
+        index_.emplace(std::move(key), id);
+        return true;
+    }
+
+public:
+    /** @brief Id descriptor untuk acl; dikompilasi hanya jika belum ada */
+    bool Intern(const AclTemplate& acl, uint32_t& id, uint32_t& error) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return InternLocked(acl, id, error);
+    }
+
+    /** @brief Id descriptor turunan (dihitung sekali per pasangan parent + jenis) */
+    bool Child(uint32_t parent, bool isDirectory, uint32_t& id, uint32_t& error) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        AclDescriptor& descriptor = *descriptors_[parent];
+        int64_t& cached = isDirectory ? descriptor.directoryChild : descriptor.fileChild;
+        if (cached >= 0) {
+            id = static_cast<uint32_t>(cached);
+            return true;
+        }
+
+        AclTemplate source;
+        if (!ParseAclTemplate(descriptor.key, source)) {
+            error = OS_ERROR_INVALID_PARAMETER;
+            return false;
+        }
+        AclTemplate derived;
+        DeriveInheritedAcl(source, isDirectory, derived);
+        if (!InternLocked(derived, id, error)) {
+            return false;
+        }
+        // descriptors_ bisa bertambah di InternLocked; unique_ptr menjaga alamat descriptor
+        cached = id;
+        return true;
+    }
+
+    const AclDescriptor* Get(uint32_t id) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return descriptors_[id].get();
+    }
+
+    size_t Size() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return descriptors_.size();
+    }
+
+    /** @brief Kunci semua descriptor sesuai urutan id (untuk checkpoint) */
+    std::vector<std::wstring> Keys() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        std::vector<std::wstring> keys;
+        for (const std::unique_ptr<AclDescriptor>& descriptor : descriptors_) {
+            keys.push_back(descriptor->key);
+        }
+        return keys;
+    }
+};
+
+//==============================================================================
+// CHECKPOINT
+//==============================================================================
+
+/** @brief Baris pertama file checkpoint */
+static const char kCheckpointHeader[] = "RASTI-ACLRESET 1";
+
+/**
+ * @brief Isi checkpoint: direktori tertunda dan descriptor yang dirujuknya
+ */
+struct AclCheckpoint {
+    std::wstring root;
+    std::wstring sddl;
+    std::vector<std::wstring> descriptors;       /**< Index = id descriptor */
+    std::map<std::wstring, uint32_t> pending;    /**< Path relative -> id descriptor direktori */
+};
+
+/**
+ * @brief Format teks UTF-8, satu record per baris, field dipisah tab
+ *
+ * Tab dan newline tidak valid di nama file Win32 sehingga aman sebagai pemisah.
+ */
+static std::string FormatCheckpoint(const AclCheckpoint& checkpoint)
+{
+    std::string text = kCheckpointHeader;
+    text += "\nroot\t";
+    AppendUtf8(checkpoint.root, text);
+    text += "\nsddl\t";
+    AppendUtf8(checkpoint.sddl, text);
+    text += '\n';
+    for (const std::wstring& key : checkpoint.descriptors) {
+        text += "descriptor\t";
+        AppendUtf8(key, text);
+        text += '\n';
+    }
+    for (const auto& entry : checkpoint.pending) {
+        text += "pending\t" + std::to_string(entry.second) + '\t';
+        AppendUtf8(entry.first, text);
+        text += '\n';
+    }
+    text += "end\n"; // Penanda file tidak terpotong
+    return text;
+}
+
+static bool ParseCheckpoint(std::string_view text, AclCheckpoint& checkpoint)
+{
+    checkpoint = AclCheckpoint();
+    bool header = false;
+    bool ended = false;
+    std::wstring value;
+
+    size_t start = 0;
+    while (start < text.size()) {
+        size_t end = text.find('\n', start);
+        if (end == std::string_view::npos) end = text.size();
+        std::string_view line = text.substr(start, end - start);
+        start = end + 1;
+
+        if (!header) {
+            if (line != kCheckpointHeader) return false;
+            header = true;
+            continue;
+        }
+        if (ended) {
+            return false;
+        }
+        if (line == "end") {
+            ended = true;
+            continue;
+        }
+
+        size_t tab = line.find('\t');
+        if (tab == std::string_view::npos) {
+            return false;
+        }
+        std::string_view field = line.substr(0, tab);
+        std::string_view rest = line.substr(tab + 1);
+
+        if (field == "pending") {
+            size_t second = rest.find('\t');
+            if (second == std::string_view::npos || second == 0 || second > 9) return false;
+            uint32_t id = 0;
+            for (char ch : rest.substr(0, second)) {
+                if (ch < '0' || ch > '9') return false;
+                id = id * 10 + static_cast<uint32_t>(ch - '0');
+            }
+            if (id >= checkpoint.descriptors.size() || !DecodeUtf8(rest.substr(second + 1), value)) return false;
+            checkpoint.pending[value] = id;
+        } else if (!DecodeUtf8(rest, value)) {
+            return false;
+        } else if (field == "root") {
+            checkpoint.root = value;
+        } else if (field == "sddl") {
+            checkpoint.sddl = value;
+        } else if (field == "descriptor") {
+            checkpoint.descriptors.push_back(value);
+        } else {
+            return false;
+        }
+    }
+    return header && ended;
+}
+
+//==============================================================================
+// ENGINE
+//==============================================================================
+
+/** @brief Task walk: satu direktori relative terhadap root */
+struct AclTask {
+    std::wstring relative;
+    uint32_t descriptor = 0;
+};
+
+/**
+ * @brief State bersama satu run
+ */
+struct AclResetRun {
+    std::wstring root;
+    std::wstring sddl;
+    const AclResetOptions* options = nullptr;
+    AclDescriptorTable table;
+
+    std::mutex pendingMutex;
+    std::map<std::wstring, uint32_t> pending;
+
+    std::mutex checkpointMutex;
+    std::chrono::steady_clock::time_point lastCheckpoint;
+
+    std::atomic<uint64_t> visited{0};
+    std::atomic<uint64_t> updated{0};
+    std::atomic<uint64_t> skipped{0};
+    std::atomic<uint64_t> failed{0};
+    std::atomic<uint64_t> links{0};
+    std::atomic<uint64_t> scanned{0};
+    std::atomic<uint64_t> checkpoints{0};
+
+    bool Cancelled() const {
+        return options->cancel && options->cancel->load(std::memory_order_relaxed);
+    }
+};
+
+static void AddError(std::vector<AclResetError>& errors, AclResetStep step, const std::wstring& path, uint32_t code)
+{
+    AclResetError error;
+    error.step = step;
+    error.path = path;
+    error.code = code;
+    errors.push_back(std::move(error));
+}
+
+/**
+ * @brief Memasang descriptor ke satu object jika owner/DACL-nya berbeda
+ *
+ * Jika ReadSecurity gagal (misalnya tanpa READ_CONTROL), descriptor tetap
+ * ditulis; error hanya dicatat jika penulisan juga gagal.
+ */
+static void ApplyDescriptor(AclResetRun& run, const std::wstring& path, const AclDescriptor& descriptor,
+                            std::vector<AclResetError>& errors)
+{
+    IFileOperationBackend* fo = GetFileOperationBackend();
+    run.visited++;
+
+    std::wstring current;
+    AclTemplate existing;
+    if (fo->ReadSecurity(path, current) && ParseAclTemplate(current, existing) &&
+        SameAcl(existing, descriptor.target)) {
+        run.skipped++;
+        return;
+    }
+
+    if (!fo->WriteSecurity(path, descriptor.bytes)) {
+        run.failed++;
+        AddError(errors, ACLRESET_STEP_WRITE, path, fo->GetLastErrorCode());
+        return;
+    }
+    run.updated++;
+}
+
+static std::wstring JoinRelative(const std::wstring& root, const std::wstring& relative)
+{
+    return relative.empty() ? root : root + L'\\' + relative;
+}
+
+/** @brief Menulis checkpoint secara atomik (file sementara lalu rename) */
+static bool WriteCheckpoint(AclResetRun& run, uint32_t& error)
+{
+    AclCheckpoint checkpoint;
+    checkpoint.root = run.root;
+    checkpoint.sddl = run.sddl;
+    {
+        std::lock_guard<std::mutex> lock(run.pendingMutex);
+        checkpoint.pending = run.pending;
+    }
+    // Setelah pending: setiap id di pending sudah ada di tabel
+    checkpoint.descriptors = run.table.Keys();
+
+    IFileOperationBackend* fo = GetFileOperationBackend();
+    std::wstring temporary = run.options->checkpointPath + L".tmp";
+    if (!fo->WriteFileContents(temporary, FormatCheckpoint(checkpoint)) ||
+        !fo->MovePath(temporary, run.options->checkpointPath)) {
+        error = fo->GetLastErrorCode();
+        return false;
+    }
+    run.checkpoints++;
+    return true;
+}
+
+/** @brief Menulis checkpoint jika interval sudah lewat (paling banyak satu worker sekaligus) */
+static void MaybeWriteCheckpoint(AclResetRun& run, std::vector<AclResetError>& errors)
+{
+    if (run.options->checkpointPath.empty()) {
+        return;
+    }
+    std::unique_lock<std::mutex> lock(run.checkpointMutex, std::try_to_lock);
+    if (!lock.owns_lock()) {
+        return;
+    }
+    auto now = std::chrono::steady_clock::now();
+    if (std::chrono::duration<double>(now - run.lastCheckpoint).count() < run.options->checkpointSeconds) {
+        return;
+    }
+
+    uint32_t error = 0;
+    if (!WriteCheckpoint(run, error)) {
+        AddError(errors, ACLRESET_STEP_CHECKPOINT, run.options->checkpointPath, error);
+    }
+    run.lastCheckpoint = now;
+}
+
+/** @brief Privilege yang dibutuhkan worker di token impersonation */
+static void EnableAclPrivileges(const AclResetOptions& options)
+{
+    if (options.token != OS_INVALID_HANDLE) {
+        // Owner bebas (restore), akses tanpa melihat DACL object (backup/restore), take ownership
+        EnableSupportedPrivilege(true, SeBackupPrivilege);
+        EnableSupportedPrivilege(true, SeRestorePrivilege);
+        EnableSupportedPrivilege(true, SeTakeOwnershipPrivilege);
+    }
+}
+
+/**
+ * @brief Memproses satu direktori; false jika dihentikan oleh cancel (tetap pending)
+ */
+static bool ProcessDirectory(AclResetRun& run, WorkStealingScheduler<AclTask>& scheduler, unsigned worker,
+                             const AclTask& task, std::vector<FileOperationEntry>& entries,
+                             std::vector<AclResetError>& errors)
+{
+    IFileOperationBackend* fo = GetFileOperationBackend();
+    std::wstring directory = JoinRelative(run.root, task.relative);
+    ApplyDescriptor(run, directory, *run.table.Get(task.descriptor), errors);
+
+    uint32_t fileChild = 0;
+    uint32_t directoryChild = 0;
+    uint32_t error = 0;
+    if (!fo->ListDirectory(directory, entries)) {
+        run.failed++;
+        AddError(errors, ACLRESET_STEP_LIST, directory, fo->GetLastErrorCode());
+        return true;
+    }
+    if (!run.table.Child(task.descriptor, false, fileChild, error) ||
+        !run.table.Child(task.descriptor, true, directoryChild, error)) {
+        run.failed++;
+        AddError(errors, ACLRESET_STEP_BUILD, directory, error);
+        return true;
+    }
+    run.scanned++;
+
+    const AclDescriptor& fileDescriptor = *run.table.Get(fileChild);
+    for (const FileOperationEntry& entry : entries) {
+        if (run.Cancelled()) {
+            return false; // Direktori diulang saat resume; object yang sudah sesuai dilewati
+        }
+
+        std::wstring relative = task.relative.empty() ? entry.name : task.relative + L'\\' + entry.name;
+        if (entry.isReparsePoint) {
+            run.links++; // SetFileSecurity pada link bisa mengenai target di luar pohon
+        } else if (!entry.isDirectory) {
+            ApplyDescriptor(run, JoinRelative(run.root, relative), fileDescriptor, errors);
+        } else {
+            bool inserted;
+            {
+                std::lock_guard<std::mutex> lock(run.pendingMutex);
+                inserted = run.pending.emplace(relative, directoryChild).second;
+            }
+            // Sudah pending: dimuat dari checkpoint dan masih menunggu di antrian
+            if (inserted) {
+                AclTask child;
+                child.relative = std::move(relative);
+                child.descriptor = directoryChild;
+                scheduler.Push(worker, std::move(child));
+            }
+        }
+    }
+    return true;
+}
+
+/** @brief Membaca checkpoint; false jika ada tetapi tidak dapat dipakai */
+static bool LoadCheckpoint(AclResetRun& run, AclResetReport& report)
+{
+    IFileOperationBackend* fo = GetFileOperationBackend();
+    const std::wstring& path = run.options->checkpointPath;
+
+    std::string text;
+    bool read = false;
+    uint32_t error = 0;
+    RunImpersonatedWorkers(1, run.options->token, [&](unsigned, uint32_t impersonationError) {
+        read = impersonationError == 0 && fo->ReadFileContents(path, ACLRESET_MAX_CHECKPOINT_SIZE, text);
+        error = impersonationError != 0 ? impersonationError : (read ? 0 : fo->GetLastErrorCode());
+    });
+    if (!read) {
+        if (error == OS_ERROR_FILE_NOT_FOUND || error == OS_ERROR_PATH_NOT_FOUND) {
+            return true; // Run baru
+        }
+        AddError(report.errors, ACLRESET_STEP_CHECKPOINT, path, error);
+        return false;
+    }
+
+    // Checkpoint untuk root/SDDL lain tidak boleh dilanjutkan maupun ditimpa
+    AclCheckpoint checkpoint;
+    if (!ParseCheckpoint(text, checkpoint) || checkpoint.root != run.root || checkpoint.sddl != run.sddl) {
+        AddError(report.errors, ACLRESET_STEP_CHECKPOINT, path, OS_ERROR_INVALID_PARAMETER);
+        return false;
+    }
+
+    bool interned = true;
+    RunImpersonatedWorkers(1, run.options->token, [&](unsigned, uint32_t impersonationError) {
+        for (size_t i = 0; interned && i < checkpoint.descriptors.size(); i++) {
+            AclTemplate acl;
+            uint32_t id = 0;
+            interned = impersonationError == 0 && ParseAclTemplate(checkpoint.descriptors[i], acl) &&
+                       run.table.Intern(acl, id, error) && id == i;
+        }
+    });
+    if (!interned) {
+        AddError(report.errors, ACLRESET_STEP_CHECKPOINT, path, error != 0 ? error : OS_ERROR_INVALID_PARAMETER);
+        return false;
+    }
+
+    run.pending = std::move(checkpoint.pending);
+    report.resumed = true;
+    report.directoriesResumed = run.pending.size();
+    return true;
+}
+
+bool RunAclReset(const std::wstring& root, const std::wstring& sddl, const AclResetOptions& options,
+                 AclResetReport& report)
+{
+    auto start = std::chrono::steady_clock::now();
+    report = AclResetReport();
+    unsigned threadCount = ResolveFileOperationThreadCount(options.threadCount);
+    report.threadCount = threadCount;
+
+    AclResetRun run;
+    run.root = root;
+    run.sddl = sddl;
+    run.options = &options;
+    run.lastCheckpoint = start;
+
+    AclTemplate target;
+    if (!NormalizeFileOperationPath(run.root) || !ParseAclTemplate(sddl, target)) {
+        AddError(report.errors, ACLRESET_STEP_BUILD, root, OS_ERROR_INVALID_PARAMETER);
+        report.errorCount = report.errors.size();
+        return false;
+    }
+    target.isProtected = true; // Root tidak mewarisi apa pun dari parent-nya
+
+    if (!options.checkpointPath.empty() && !LoadCheckpoint(run, report)) {
+        report.errorCount = report.errors.size();
+        return false;
+    }
+
+    IFileOperationBackend* fo = GetFileOperationBackend();
+    std::vector<AclResetError> setupErrors;
+    if (!report.resumed) {
+        // Root: descriptor target, lalu root sebagai task pertama (atau satu file)
+        FileOperationEntry entry = {};
+        bool found = false;
+        bool interned = false;
+        uint32_t id = 0;
+        uint32_t error = 0;
+        RunImpersonatedWorkers(1, options.token, [&](unsigned, uint32_t impersonationError) {
+            found = impersonationError == 0 && fo->QueryPath(run.root, entry);
+            error = impersonationError != 0 ? impersonationError : (found ? 0 : fo->GetLastErrorCode());
+            if (found && !entry.isReparsePoint) {
+                interned = run.table.Intern(target, id, error);
+            }
+            if (interned && !entry.isDirectory) {
+                EnableAclPrivileges(options);
+                ApplyDescriptor(run, run.root, *run.table.Get(id), setupErrors);
+            }
+        });
+
+        if (!found) {
+            AddError(setupErrors, ACLRESET_STEP_READ, run.root, error);
+        } else if (entry.isReparsePoint) {
+            AddError(setupErrors, ACLRESET_STEP_READ, run.root, OS_ERROR_NOT_SUPPORTED);
+        } else if (!interned) {
+            AddError(setupErrors, ACLRESET_STEP_BUILD, run.root, error);
+        } else if (entry.isDirectory) {
+            run.pending.emplace(std::wstring(), id);
+        }
+        if (!found || entry.isReparsePoint || !interned) {
+            run.failed++;
+        }
+    }
+
+    // Task awal dibagi rata; sisanya tersebar lewat work stealing
+    WorkStealingScheduler<AclTask> scheduler(threadCount);
+    unsigned next = 0;
+    for (const auto& entry : run.pending) {
+        AclTask task;
+        task.relative = entry.first;
+        task.descriptor = entry.second;
+        scheduler.Push(next++ % threadCount, std::move(task));
+    }
+
+    std::vector<std::vector<AclResetError>> errors(threadCount);
+    RunImpersonatedWorkers(threadCount, options.token, [&](unsigned worker, uint32_t impersonationError) {
+        std::vector<AclResetError>& own = errors[worker];
+        if (impersonationError != 0) {
+            // Tidak mengambil task: worker lain menyelesaikannya, atau tetap pending di checkpoint
+            AddError(own, ACLRESET_STEP_READ, run.root, impersonationError);
+            return;
+        }
+        EnableAclPrivileges(options);
+
+        std::vector<FileOperationEntry> entries;
+        scheduler.RunWorker(worker, [&](const AclTask& task) {
+            if (run.Cancelled() || !ProcessDirectory(run, scheduler, worker, task, entries, own)) {
+                return;
+            }
+            {
+                std::lock_guard<std::mutex> lock(run.pendingMutex);
+                run.pending.erase(task.relative);
+            }
+            MaybeWriteCheckpoint(run, own);
+        });
+    });
+
+    // Checkpoint akhir: dihapus jika selesai, ditulis jika masih ada direktori tertunda
+    report.completed = run.pending.empty();
+    report.interrupted = !report.completed && run.Cancelled();
+    if (!options.checkpointPath.empty()) {
+        RunImpersonatedWorkers(1, options.token, [&](unsigned, uint32_t impersonationError) {
+            uint32_t error = impersonationError;
+            FileOperationEntry existing = {};
+            if (error == 0 && report.completed) {
+                if (fo->QueryPath(options.checkpointPath, existing) &&
+                    !fo->DeletePath(options.checkpointPath, false)) {
+                    error = fo->GetLastErrorCode();
+                }
+            } else if (error == 0) {
+                WriteCheckpoint(run, error);
+            }
+            if (error != 0) {
+                AddError(setupErrors, ACLRESET_STEP_CHECKPOINT, options.checkpointPath, error);
+            }
+        });
+    }
+
+    errors.push_back(std::move(setupErrors));
+    for (std::vector<AclResetError>& own : errors) {
+        report.errorCount += own.size();
+        for (AclResetError& error : own) {
+            if (report.errors.size() >= ACLRESET_MAX_REPORTED_ERRORS) break;
+            report.errors.push_back(std::move(error));
+        }
+    }
+
+    report.objectsVisited = run.visited.load();
+    report.objectsUpdated = run.updated.load();
+    report.objectsSkipped = run.skipped.load();
+    report.objectsFailed = run.failed.load();
+    report.linksSkipped = run.links.load();
+    report.directoriesScanned = run.scanned.load();
+    report.descriptorsBuilt = run.table.Size();
+    report.checkpointsWritten = run.checkpoints.load();
+    report.tasksStolen = scheduler.StolenCount();
+    report.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return report.completed && report.errorCount == 0;
+}
+
+//==============================================================================
+// REPORT
+//==============================================================================
+
+const char* GetAclResetStepName(AclResetStep step)
+{
+    switch (step) {
+    case ACLRESET_STEP_LIST:       return "list";
+    case ACLRESET_STEP_READ:       return "read";
+    case ACLRESET_STEP_WRITE:      return "write";
+    case ACLRESET_STEP_BUILD:      return "build";
+    case ACLRESET_STEP_CHECKPOINT: return "checkpoint";
+    default:                       return "unknown";
+    }
+}
+
+std::string FormatAclResetReport(const AclResetReport& report)
+{
+    std::string text;
+    char line[256];
+
+    snprintf(line, sizeof(line), "%s%s, %u threads\n",
+             report.completed ? "completed" : (report.interrupted ? "interrupted" : "incomplete"),
+             report.resumed ? " (resumed)" : "", report.threadCount);
+    text += line;
+    if (report.resumed) {
+        snprintf(line, sizeof(line), "%llu pending directories loaded from checkpoint\n",
+                 static_cast<unsigned long long>(report.directoriesResumed));
+        text += line;
+    }
+    snprintf(line, sizeof(line), "%llu objects: %llu updated, %llu already matching, %llu failed, "
+             "%llu links skipped, %llu directories scanned\n",
+             static_cast<unsigned long long>(report.objectsVisited),
+             static_cast<unsigned long long>(report.objectsUpdated),
+             static_cast<unsigned long long>(report.objectsSkipped),
+             static_cast<unsigned long long>(report.objectsFailed),
+             static_cast<unsigned long long>(report.linksSkipped),
+             static_cast<unsigned long long>(report.directoriesScanned));
+    text += line;
+    snprintf(line, sizeof(line), "%llu distinct descriptors, %llu checkpoints, %.0f objects/s, %.3f s\n",
+             static_cast<unsigned long long>(report.descriptorsBuilt),
+             static_cast<unsigned long long>(report.checkpointsWritten),
+             report.ObjectsPerSecond(), report.seconds);
+    text += line;
+
+    for (const AclResetError& error : report.errors) {
+        snprintf(line, sizeof(line), "%s failed (error %u): ", GetAclResetStepName(error.step),
+                 static_cast<unsigned>(error.code));
+        text += line;
+        AppendUtf8(error.path, text);
+        text += '\n';
+    }
+    if (report.errorCount > report.errors.size()) {
+        snprintf(line, sizeof(line), "... %llu more errors\n",
+                 static_cast<unsigned long long>(report.errorCount - report.errors.size()));
+        text += line;
+    }
+    return text;
+}
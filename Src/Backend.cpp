@@ -0,0 +1,126 @@
+/**
+ * @file Backend.cpp
+ * @brief Pemilihan backend OS yang aktif untuk RasTI Core Engine
+ *
+ * File ini menyimpan override backend (dipasang oleh unit test), meneruskan
+ * ke backend default platform jika tidak ada override, dan menyediakan
+ * helper kecil yang dibangun di atas interface backend.
+ *
+ * @author RasTI Development Team
+ * @version 1.2.0.0
+ * @date 2025
+ */
+
+#include "Backend.h"
+
+//==============================================================================
+// GLOBAL BACKEND OVERRIDE
+//==============================================================================
+
+/** @brief Backend filesystem yang dipasang secara eksplisit (NULL = default) */
+static IFileSystemBackend* gFileSystemBackend = nullptr;
+
+IFileSystemBackend* GetFileSystemBackend()
+{
+    return gFileSystemBackend ? gFileSystemBackend : GetDefaultFileSystemBackend();
+}
+
+void SetFileSystemBackend(IFileSystemBackend* backend)
+{
+    gFileSystemBackend = backend;
+}
+
+/** @brief Backend proses/token yang dipasang secara eksplisit (NULL = default) */
+static IProcessBackend* gProcessBackend = nullptr;
+
+IProcessBackend* GetProcessBackend()
+{
+    return gProcessBackend ? gProcessBackend : GetDefaultProcessBackend();
+}
+
+void SetProcessBackend(IProcessBackend* backend)
+{
+    gProcessBackend = backend;
+}
+
+/** @brief Backend operasi file yang dipasang secara eksplisit (NULL = default) */
+static IFileOperationBackend* gFileOperationBackend = nullptr;
+
+IFileOperationBackend* GetFileOperationBackend()
+{
+    return gFileOperationBackend ? gFileOperationBackend : GetDefaultFileOperationBackend();
+}
+
+void SetFileOperationBackend(IFileOperationBackend* backend)
+{
+    gFileOperationBackend = backend;
+}
+
+/** @brief Backend registry yang dipasang secara eksplisit (NULL = default) */
+static IRegistryBackend* gRegistryBackend = nullptr;
+
+IRegistryBackend* GetRegistryBackend()
+{
+    return gRegistryBackend ? gRegistryBackend : GetDefaultRegistryBackend();
+}
+
+void SetRegistryBackend(IRegistryBackend* backend)
+{
+    gRegistryBackend = backend;
+}
+
+/** @brief Backend script host yang dipasang secara eksplisit (NULL = default) */
+static IScriptHostBackend* gScriptHostBackend = nullptr;
+
+IScriptHostBackend* GetScriptHostBackend()
+{
+    return gScriptHostBackend ? gScriptHostBackend : GetDefaultScriptHostBackend();
+}
+
+void SetScriptHostBackend(IScriptHostBackend* backend)
+{
+    gScriptHostBackend = backend;
+}
+
+/** @brief Backend capture output yang dipasang secara eksplisit (NULL = default) */
+static IOutputCaptureBackend* gOutputCaptureBackend = nullptr;
+
+IOutputCaptureBackend* GetOutputCaptureBackend()
+{
+    return gOutputCaptureBackend ? gOutputCaptureBackend : GetDefaultOutputCaptureBackend();
+}
+
+void SetOutputCaptureBackend(IOutputCaptureBackend* backend)
+{
+    gOutputCaptureBackend = backend;
+}
+
+//==============================================================================
+// HELPERS
+//==============================================================================
+
+bool ReadSmallFile(IFileSystemBackend* fs, const std::wstring& path, uint32_t maxSize, std::string& contents)
+{
+    contents.clear();
+
+    ScopedBackendFile file(fs, fs->OpenFileForValidation(path));
+    if (!file.IsValid()) {
+        return false;
+    }
+
+    FileIdentity identity;
+    if (!fs->QueryFileIdentity(file.Get(), identity) || identity.isDirectory ||
+        identity.fileSize > maxSize) {
+        return false;
+    }
+
+    contents.resize(static_cast<size_t>(identity.fileSize));
+    uint32_t bytesRead = 0;
+    if (!contents.empty() &&
+        (!fs->ReadFileAt(file.Get(), 0, &contents[0], static_cast<uint32_t>(contents.size()), bytesRead) ||
+         bytesRead != contents.size())) {
+        contents.clear();
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,1566 @@
+/**
+ * @file BackendTrace.cpp
+ * @brief Implementasi record/replay trace biner panggilan backend
+ *
+ * @author RasTI Development Team
+ * @version 1.2.0.0
+ * @date 2025
+ */
+
+#include "BackendTrace.h"
+#include "TextEncoding.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <thread>
+
+//==============================================================================
+// ENCODING
+//==============================================================================
+
+/** @brief Magic di awal setiap file trace */
+static const char TRACE_MAGIC[4] = { 'R', 'T', 'R', 'C' };
+
+/** @brief Ukuran buffer writer sebelum dikirim ke sink */
+static const size_t TRACE_FLUSH_THRESHOLD = 64 * 1024;
+
+/** @brief Menambahkan integer sebagai varint LEB128 */
+static void PutVarint(std::string& out, uint64_t value)
+{
+    while (value >= 0x80) {
+        out.push_back(static_cast<char>((value & 0x7F) | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<char>(value));
+}
+
+/** @brief Menambahkan bytes dengan prefix panjang */
+static void PutBytes(std::string& out, const void* data, size_t size)
+{
+    PutVarint(out, size);
+    out.append(static_cast<const char*>(data), size);
+}
+
+/** @brief Menambahkan wide string sebagai UTF-8 dengan prefix panjang */
+static void PutString(std::string& out, const std::wstring& text)
+{
+    std::string utf8;
+    AppendUtf8(text, utf8);
+    PutBytes(out, utf8.data(), utf8.size());
+}
+
+/**
+ * @brief Pembaca sekuensial untuk field ter-encode
+ *
+ * Setelah satu pembacaan gagal (data terpotong), semua pembacaan berikutnya
+ * mengembalikan nilai kosong dan ok bernilai false.
+ */
+struct TraceReader {
+    const char* data;
+    size_t size;
+    size_t position;
+    bool ok;
+
+    TraceReader(const char* begin, size_t length) : data(begin), size(length), position(0), ok(true) {}
+    explicit TraceReader(const std::string& text) : data(text.data()), size(text.size()), position(0), ok(true) {}
+
+    bool AtEnd() const { return position >= size; }
+
+    uint64_t Varint() {
+        uint64_t value = 0;
+        for (int shift = 0; ok && shift < 64; shift += 7) {
+            if (position >= size) {
+                break;
+            }
+            uint8_t byte = static_cast<uint8_t>(data[position++]);
+            value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+            if ((byte & 0x80) == 0) {
+                return value;
+            }
+        }
+        ok = false;
+        return 0;
+    }
+
+    bool Bytes(const char*& begin, size_t& length) {
+        uint64_t declared = Varint();
+        if (!ok || declared > size - position) {
+            ok = false;
+            begin = NULL;
+            length = 0;
+            return false;
+        }
+        begin = data + position;
+        length = static_cast<size_t>(declared);
+        position += length;
+        return true;
+    }
+
+    std::wstring String() {
+        const char* begin = NULL;
+        size_t length = 0;
+        std::wstring text;
+        if (Bytes(begin, length) && !DecodeUtf8(std::string_view(begin, length), text)) {
+            ok = false;
+        }
+        return text;
+    }
+};
+
+const char* GetBackendTraceCallName(BackendTraceCall call)
+{
+    switch (call) {
+    case TRACE_FS_GET_FULL_PATH:             return "GetFullPath";
+    case TRACE_FS_OPEN_FILE:                 return "OpenFileForValidation";
+    case TRACE_FS_QUERY_IDENTITY:            return "QueryFileIdentity";
+    case TRACE_FS_READ_FILE:                 return "ReadFileAt";
+    case TRACE_FS_MAP_VIEW:                  return "MapFileView";
+    case TRACE_FS_UNMAP_VIEW:                return "UnmapFileView";
+    case TRACE_FS_CLOSE_FILE:                return "CloseFile";
+    case TRACE_FS_ENUMERATE_DIRECTORY:       return "EnumerateDirectory";
+    case TRACE_FS_GET_ENVIRONMENT:           return "GetEnvironmentValue";
+    case TRACE_FS_GET_CURRENT_DIRECTORY:     return "GetCurrentDirectoryPath";
+    case TRACE_PS_ADJUST_PRIVILEGE:          return "AdjustPrivilege";
+    case TRACE_PS_FIND_PROCESS:              return "FindProcessByName";
+    case TRACE_PS_OPEN_PROCESS_TOKEN:        return "OpenProcessToken";
+    case TRACE_PS_IMPERSONATE_TOKEN:         return "ImpersonateToken";
+    case TRACE_PS_REVERT_IMPERSONATION:      return "RevertImpersonation";
+    case TRACE_PS_LOGON_TRUSTED_INSTALLER:   return "LogonTrustedInstaller";
+    case TRACE_PS_CREATE_PROCESS:            return "CreateProcessWithToken";
+    case TRACE_PS_IS_PRIVILEGE_ENABLED:      return "IsPrivilegeEnabled";
+    case TRACE_PS_IS_ELEVATED_ADMINISTRATOR: return "IsElevatedAdministrator";
+    case TRACE_PS_GET_MODULE_PATH:           return "GetModuleFilePath";
+    case TRACE_PS_CLOSE_OBJECT:              return "CloseObject";
+    case TRACE_PS_WAIT_PROCESS:              return "WaitForProcessExit";
+    case TRACE_PS_CREATE_PROCESS_AS_USER:    return "CreateProcessAsUser";
+    case TRACE_PS_RESUME_PROCESS:            return "ResumeProcess";
+    case TRACE_PS_TERMINATE_PROCESS:         return "TerminateProcess";
+    case TRACE_PS_SET_PROCESS_SETTING:       return "SetProcessSetting";
+    case TRACE_PS_CREATE_JOB:                return "CreateJob";
+    case TRACE_PS_ASSIGN_PROCESS_TO_JOB:     return "AssignProcessToJob";
+    case TRACE_PS_WAIT_ANY_PROCESS:          return "WaitForAnyProcessExit";
+    case TRACE_PS_ENUMERATE_PROCESSES:       return "EnumerateProcesses";
+    case TRACE_PS_OPEN_PROCESS:              return "OpenProcessHandle";
+    case TRACE_PS_QUERY_PROCESS_PATH:        return "QueryProcessImagePath";
+    case TRACE_PS_ENUMERATE_SESSIONS:        return "EnumerateSessions";
+    case TRACE_PS_OPEN_THREAD_TOKEN:         return "OpenThreadToken";
+    default:                                 return "unknown";
+    }
+}
+
+//==============================================================================
+// TRACE FILE
+//==============================================================================
+
+/** @brief Serialisasi session (bagian header) */
+static std::string EncodeSession(const BackendTraceSession& session)
+{
+    std::string encoded;
+    PutString(encoded, session.operation);
+    PutString(encoded, session.target);
+    PutString(encoded, session.arguments);
+    PutVarint(encoded, session.iterations);
+    PutVarint(encoded, session.priority);
+    PutVarint(encoded, session.console);
+    PutVarint(encoded, session.launchApi);
+    PutVarint(encoded, session.affinityMask);
+    PutVarint(encoded, session.ioPriority);
+    PutVarint(encoded, session.memoryPriority);
+    PutVarint(encoded, session.jobMemoryLimit);
+    return encoded;
+}
+
+bool BackendTrace::Load(const std::string& data, size_t* errorOffset)
+{
+    session = BackendTraceSession();
+    records.clear();
+    if (errorOffset) {
+        *errorOffset = 0;
+    }
+
+    if (data.size() < sizeof(TRACE_MAGIC) + 1 || memcmp(data.data(), TRACE_MAGIC, sizeof(TRACE_MAGIC)) != 0 ||
+        static_cast<uint8_t>(data[sizeof(TRACE_MAGIC)]) != BACKEND_TRACE_VERSION) {
+        return false;
+    }
+
+    TraceReader reader(data.data() + sizeof(TRACE_MAGIC) + 1, data.size() - sizeof(TRACE_MAGIC) - 1);
+    const size_t base = sizeof(TRACE_MAGIC) + 1;
+
+    const char* sessionData = NULL;
+    size_t sessionSize = 0;
+    if (reader.Bytes(sessionData, sessionSize)) {
+        TraceReader fields(sessionData, sessionSize);
+        session.operation = fields.String();
+        session.target = fields.String();
+        session.arguments = fields.String();
+        session.iterations = static_cast<uint32_t>(fields.Varint());
+        session.priority = static_cast<uint32_t>(fields.Varint());
+        // Trace sebelum /console selalu memakai CREATE_NEW_CONSOLE
+        session.console = fields.AtEnd() ? 1 : static_cast<uint32_t>(fields.Varint());
+        // Trace sebelum fast path CreateProcessAsUserW selalu melalui seclogon
+        session.launchApi = fields.AtEnd() ? 1 : static_cast<uint32_t>(fields.Varint());
+        // Trace sebelum launch pipeline tidak memiliki tahap konfigurasi
+        if (!fields.AtEnd()) {
+            session.affinityMask = fields.Varint();
+            session.ioPriority = static_cast<uint32_t>(fields.Varint());
+            session.memoryPriority = static_cast<uint32_t>(fields.Varint());
+            session.jobMemoryLimit = fields.Varint();
+        }
+        reader.ok = fields.ok;
+    }
+
+    while (reader.ok && !reader.AtEnd()) {
+        size_t recordStart = reader.position;
+        BackendTraceRecord record;
+        record.call = static_cast<BackendTraceCall>(static_cast<uint8_t>(reader.data[reader.position++]));
+        record.durationNs = reader.Varint();
+
+        const char* begin = NULL;
+        size_t length = 0;
+        if (reader.Bytes(begin, length)) {
+            record.key.assign(begin, length);
+        }
+        if (reader.Bytes(begin, length)) {
+            record.result.assign(begin, length);
+        }
+        if (!reader.ok) {
+            reader.position = recordStart;
+            break;
+        }
+        records.push_back(std::move(record));
+    }
+
+    if (!reader.ok) {
+        if (errorOffset) {
+            *errorOffset = base + reader.position;
+        }
+        session = BackendTraceSession();
+        records.clear();
+        return false;
+    }
+    return true;
+}
+
+uint64_t BackendTrace::GetTotalDurationNs() const
+{
+    uint64_t total = 0;
+    for (const BackendTraceRecord& record : records) {
+        total += record.durationNs;
+    }
+    return total;
+}
+
+std::string FormatBackendTraceSummary(const BackendTrace& trace)
+{
+    struct CallSummary {
+        BackendTraceCall call;
+        uint64_t count;
+        uint64_t totalNs;
+        uint64_t maxNs;
+    };
+
+    std::vector<CallSummary> summary;
+    for (const BackendTraceRecord& record : trace.records) {
+        auto it = std::find_if(summary.begin(), summary.end(), [&](const CallSummary& entry) {
+            return entry.call == record.call;
+        });
+        if (it == summary.end()) {
+            summary.push_back(CallSummary{ record.call, 0, 0, 0 });
+            it = summary.end() - 1;
+        }
+        it->count++;
+        it->totalNs += record.durationNs;
+        it->maxNs = std::max(it->maxNs, record.durationNs);
+    }
+    std::sort(summary.begin(), summary.end(), [](const CallSummary& a, const CallSummary& b) {
+        return a.totalNs > b.totalNs;
+    });
+
+    std::string text;
+    char line[160];
+    snprintf(line, sizeof(line), "%-26s %8s %12s %12s %12s\n", "call", "count", "total (ms)", "avg (us)", "max (us)");
+    text += line;
+    for (const CallSummary& entry : summary) {
+        snprintf(line, sizeof(line), "%-26s %8llu %12.3f %12.1f %12.1f\n",
+                 GetBackendTraceCallName(entry.call), static_cast<unsigned long long>(entry.count),
+                 entry.totalNs / 1e6, entry.totalNs / 1e3 / entry.count, entry.maxNs / 1e3);
+        text += line;
+    }
+    snprintf(line, sizeof(line), "%llu calls, %.3f ms in backend\n",
+             static_cast<unsigned long long>(trace.records.size()), trace.GetTotalDurationNs() / 1e6);
+    text += line;
+    return text;
+}
+
+//==============================================================================
+// WRITER
+//==============================================================================
+
+BackendTraceWriter::BackendTraceWriter(const BackendTraceSession& session, Sink sink)
+    : sink_(std::move(sink)), records_(0)
+{
+    buffer_.append(TRACE_MAGIC, sizeof(TRACE_MAGIC));
+    buffer_.push_back(static_cast<char>(BACKEND_TRACE_VERSION));
+    std::string encoded = EncodeSession(session);
+    PutBytes(buffer_, encoded.data(), encoded.size());
+}
+
+BackendTraceWriter::~BackendTraceWriter()
+{
+    Flush();
+}
+
+void BackendTraceWriter::Append(BackendTraceCall call, uint64_t durationNs, const std::string& key,
+                                const std::string& result)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    buffer_.push_back(static_cast<char>(call));
+    PutVarint(buffer_, durationNs);
+    PutBytes(buffer_, key.data(), key.size());
+    PutBytes(buffer_, result.data(), result.size());
+    records_++;
+
+    if (buffer_.size() >= TRACE_FLUSH_THRESHOLD && sink_) {
+        sink_(reinterpret_cast<const uint8_t*>(buffer_.data()), buffer_.size());
+        buffer_.clear();
+    }
+}
+
+void BackendTraceWriter::Flush()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!buffer_.empty() && sink_) {
+        sink_(reinterpret_cast<const uint8_t*>(buffer_.data()), buffer_.size());
+    }
+    buffer_.clear();
+}
+
+uint64_t BackendTraceWriter::GetRecordCount()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return records_;
+}
+
+//==============================================================================
+// RECORDING DECORATORS
+//==============================================================================
+
+typedef std::chrono::steady_clock TraceClock;
+
+/** @brief Durasi sejak start dalam nanodetik */
+static uint64_t NanosecondsSince(TraceClock::time_point start)
+{
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(TraceClock::now() - start).count());
+}
+
+/** @brief Menyimpan data file jika diizinkan: flag 0/1 lalu bytes */
+static void PutFileData(std::string& out, const void* data, uint32_t size, bool recordFileContents)
+{
+    bool inlineData = data != NULL && (recordFileContents || size <= BACKEND_TRACE_INLINE_DATA_LIMIT);
+    PutVarint(out, inlineData ? 1 : 0);
+    if (inlineData) {
+        PutBytes(out, data, size);
+    }
+}
+
+TracingFileSystemBackend::TracingFileSystemBackend(IFileSystemBackend* inner, BackendTraceWriter& writer,
+                                                   bool recordFileContents)
+    : inner_(inner), writer_(writer), recordFileContents_(recordFileContents)
+{
+}
+
+bool TracingFileSystemBackend::GetFullPath(const std::wstring& path, std::wstring& fullPath)
+{
+    TraceClock::time_point start = TraceClock::now();
+    bool ok = inner_->GetFullPath(path, fullPath);
+    uint64_t duration = NanosecondsSince(start);
+
+    std::string key, result;
+    PutString(key, path);
+    PutVarint(result, ok);
+    if (ok) {
+        PutString(result, fullPath);
+    }
+    writer_.Append(TRACE_FS_GET_FULL_PATH, duration, key, result);
+    return ok;
+}
+
+OsHandle TracingFileSystemBackend::OpenFileForValidation(const std::wstring& path)
+{
+    TraceClock::time_point start = TraceClock::now();
+    OsHandle handle = inner_->OpenFileForValidation(path);
+    uint64_t duration = NanosecondsSince(start);
+
+    std::string key, result;
+    PutString(key, path);
+    PutVarint(result, handle);
+    writer_.Append(TRACE_FS_OPEN_FILE, duration, key, result);
+    return handle;
+}
+
+bool TracingFileSystemBackend::QueryFileIdentity(OsHandle file, FileIdentity& identity)
+{
+    TraceClock::time_point start = TraceClock::now();
+    bool ok = inner_->QueryFileIdentity(file, identity);
+    uint64_t duration = NanosecondsSince(start);
+
+    std::string key, result;
+    PutVarint(key, file);
+    PutVarint(result, ok);
+    if (ok) {
+        PutVarint(result, identity.volumeSerial);
+        PutVarint(result, identity.fileIndex);
+        PutVarint(result, identity.fileSize);
+        PutVarint(result, identity.lastWriteTime);
+        PutVarint(result, identity.isDirectory);
+    }
+    writer_.Append(TRACE_FS_QUERY_IDENTITY, duration, key, result);
+    return ok;
+}
+
+bool TracingFileSystemBackend::ReadFileAt(OsHandle file, uint64_t offset, void* buffer, uint32_t size,
+                                          uint32_t& bytesRead)
+{
+    TraceClock::time_point start = TraceClock::now();
+    bool ok = inner_->ReadFileAt(file, offset, buffer, size, bytesRead);
+    uint64_t duration = NanosecondsSince(start);
+
+    std::string key, result;
+    PutVarint(key, file);
+    PutVarint(key, offset);
+    PutVarint(key, size);
+    PutVarint(result, ok);
+    if (ok) {
+        PutVarint(result, bytesRead);
+        PutFileData(result, buffer, bytesRead, recordFileContents_);
+    }
+    writer_.Append(TRACE_FS_READ_FILE, duration, key, result);
+    return ok;
+}
+
+const uint8_t* TracingFileSystemBackend::MapFileView(OsHandle file, uint64_t offset, uint32_t size)
+{
+    TraceClock::time_point start = TraceClock::now();
+    const uint8_t* view = inner_->MapFileView(file, offset, size);
+    uint64_t duration = NanosecondsSince(start);
+
+    std::string key, result;
+    PutVarint(key, file);
+    PutVarint(key, offset);
+    PutVarint(key, size);
+    PutVarint(result, view != NULL);
+    if (view) {
+        PutFileData(result, view, size, recordFileContents_);
+    }
+    writer_.Append(TRACE_FS_MAP_VIEW, duration, key, result);
+    return view;
+}
+
+void TracingFileSystemBackend::UnmapFileView(const uint8_t* view, uint32_t size)
+{
+    TraceClock::time_point start = TraceClock::now();
+    inner_->UnmapFileView(view, size);
+    uint64_t duration = NanosecondsSince(start);
+
+    // Alamat view berbeda setiap run; cukup ukuran sebagai kunci
+    std::string key;
+    PutVarint(key, size);
+    writer_.Append(TRACE_FS_UNMAP_VIEW, duration, key, std::string());
+}
+
+void TracingFileSystemBackend::CloseFile(OsHandle file)
+{
+    TraceClock::time_point start = TraceClock::now();
+    inner_->CloseFile(file);
+    uint64_t duration = NanosecondsSince(start);
+
+    std::string key;
+    PutVarint(key, file);
+    writer_.Append(TRACE_FS_CLOSE_FILE, duration, key, std::string());
+}
+
+bool TracingFileSystemBackend::EnumerateDirectory(const std::wstring& directory, std::vector<DirectoryEntry>& entries)
+{
+    TraceClock::time_point start = TraceClock::now();
+    bool ok = inner_->EnumerateDirectory(directory, entries);
+    uint64_t duration = NanosecondsSince(start);
+
+    std::string key, result;
+    PutString(key, directory);
+    PutVarint(result, ok);
+    if (ok) {
+        PutVarint(result, entries.size());
+        for (const DirectoryEntry& entry : entries) {
+            PutString(result, entry.name);
+            PutVarint(result, (entry.isDirectory ? 1 : 0) | (entry.isReparsePoint ? 2 : 0));
+        }
+    }
+    writer_.Append(TRACE_FS_ENUMERATE_DIRECTORY, duration, key, result);
+    return ok;
+}
+
+bool TracingFileSystemBackend::GetEnvironmentValue(const std::wstring& name, std::wstring& value)
+{
+    TraceClock::time_point start = TraceClock::now();
+    bool ok = inner_->GetEnvironmentValue(name, value);
+    uint64_t duration = NanosecondsSince(start);
+
+    std::string key, result;
+    PutString(key, name);
+    PutVarint(result, ok);
+    if (ok) {
+        PutString(result, value);
+    }
+    writer_.Append(TRACE_FS_GET_ENVIRONMENT, duration, key, result);
+    return ok;
+}
+
+bool TracingFileSystemBackend::GetCurrentDirectoryPath(std::wstring& path)
+{
+    TraceClock::time_point start = TraceClock::now();
+    bool ok = inner_->GetCurrentDirectoryPath(path);
+    uint64_t duration = NanosecondsSince(start);
+
+    std::string result;
+    PutVarint(result, ok);
+    if (ok) {
+        PutString(result, path);
+    }
+    writer_.Append(TRACE_FS_GET_CURRENT_DIRECTORY, duration, std::string(), result);
+    return ok;
+}
+
+TracingProcessBackend::TracingProcessBackend(IProcessBackend* inner, BackendTraceWriter& writer)
+    : inner_(inner), writer_(writer)
+{
+}
+
+/**
+ * @brief Menulis record proses: kode error di depan result, lalu memulihkan
+ *        GetLastError yang mungkin tertimpa oleh alokasi selama encoding
+ */
+static void AppendProcessRecord(IProcessBackend* inner, BackendTraceWriter& writer, BackendTraceCall call,
+                                uint64_t duration, uint32_t error, const std::string& key, const std::string& values)
+{
+    std::string result;
+    PutVarint(result, error);
+    result += values;
+    writer.Append(call, duration, key, result);
+    inner->SetLastErrorCode(error);
+}
+
+/** @brief Key launch: token dan bagian request yang dicocokkan saat replay */
+static std::string EncodeLaunchKey(OsHandle token, const ProcessLaunchRequest& request)
+{
+    std::string key;
+    PutVarint(key, token);
+    PutString(key, request.applicationName);
+    PutString(key, request.commandLine);
+    PutVarint(key, request.creationFlags);
+    PutString(key, request.desktop);
+    if (request.sessionId != PROCESS_SESSION_CALLER) {
+        PutVarint(key, request.sessionId); // Trace lama tanpa session tetap cocok
+    }
+    return key;
+}
+
+/** @brief Result launch: ok, lalu PID dan handle proses (jika diminta) */
+static std::string EncodeLaunchValues(bool ok, uint32_t processId, const OsHandle* process)
+{
+    std::string values;
+    PutVarint(values, ok);
+    if (ok) {
+        PutVarint(values, processId);
+        if (process) {
+            PutVarint(values, *process); // Trace lama tanpa handle tetap dapat diputar
+        }
+    }
+    return values;
+}
+
+bool TracingProcessBackend::AdjustPrivilege(int privilege, bool threadScope)
+{
+    TraceClock::time_point start = TraceClock::now();
+    bool ok = inner_->AdjustPrivilege(privilege, threadScope);
+    uint64_t duration = NanosecondsSince(start);
+    uint32_t error = inner_->GetLastErrorCode();
+
+    std::string key, values;
+    PutVarint(key, static_cast<uint32_t>(privilege));
+    PutVarint(key, threadScope);
+    PutVarint(values, ok);
+    AppendProcessRecord(inner_, writer_, TRACE_PS_ADJUST_PRIVILEGE, duration, error, key, values);
+    return ok;
+}
+
+bool TracingProcessBackend::FindProcessByName(const std::wstring& imageName, uint32_t& processId)
+{
+    TraceClock::time_point start = TraceClock::now();
+    bool ok = inner_->FindProcessByName(imageName, processId);
+    uint64_t duration = NanosecondsSince(start);
+    uint32_t error = inner_->GetLastErrorCode();
+
+    std::string key, values;
+    PutString(key, imageName);
+    PutVarint(values, ok);
+    if (ok) {
+        PutVarint(values, processId);
+    }
+    AppendProcessRecord(inner_, writer_, TRACE_PS_FIND_PROCESS, duration, error, key, values);
+    return ok;
+}
+
+bool TracingProcessBackend::EnumerateProcesses(std::vector<ProcessEntry>& processes)
+{
+    TraceClock::time_point start = TraceClock::now();
+    bool ok = inner_->EnumerateProcesses(processes);
+    uint64_t duration = NanosecondsSince(start);
+    uint32_t error = inner_->GetLastErrorCode();
+
+    std::string values;
+    PutVarint(values, ok);
+    if (ok) {
+        PutVarint(values, processes.size());
+        for (const ProcessEntry& entry : processes) {
+            PutVarint(values, entry.processId);
+            PutVarint(values, entry.parentProcessId);
+            PutString(values, entry.imageName);
+        }
+    }
+    AppendProcessRecord(inner_, writer_, TRACE_PS_ENUMERATE_PROCESSES, duration, error, std::string(), values);
+    return ok;
+}
+
+OsHandle TracingProcessBackend::OpenProcessHandle(uint32_t processId)
+{
+    TraceClock::time_point start = TraceClock::now();
+    OsHandle process = inner_->OpenProcessHandle(processId);
+    uint64_t duration = NanosecondsSince(start);
+    uint32_t error = inner_->GetLastErrorCode();
+
+    std::string key, values;
+    PutVarint(key, processId);
+    PutVarint(values, process);
+    AppendProcessRecord(inner_, writer_, TRACE_PS_OPEN_PROCESS, duration, error, key, values);
+    return process;
+}
+
+bool TracingProcessBackend::QueryProcessImagePath(OsHandle process, std::wstring& path)
+{
+    TraceClock::time_point start = TraceClock::now();
+    bool ok = inner_->QueryProcessImagePath(process, path);
+    uint64_t duration = NanosecondsSince(start);
+    uint32_t error = inner_->GetLastErrorCode();
+
+    std::string key, values;
+    PutVarint(key, process);
+    PutVarint(values, ok);
+    if (ok) {
+        PutString(values, path);
+    }
+    AppendProcessRecord(inner_, writer_, TRACE_PS_QUERY_PROCESS_PATH, duration, error, key, values);
+    return ok;
+}
+
+bool TracingProcessBackend::EnumerateSessions(std::vector<SessionEntry>& sessions)
+{
+    TraceClock::time_point start = TraceClock::now();
+    bool ok = inner_->EnumerateSessions(sessions);
+    uint64_t duration = NanosecondsSince(start);
+    uint32_t error = inner_->GetLastErrorCode();
+
+    std::string values;
+    PutVarint(values, ok);
+    if (ok) {
+        PutVarint(values, sessions.size());
+        for (const SessionEntry& session : sessions) {
+            PutVarint(values, session.sessionId);
+            PutVarint(values, session.active);
+            PutString(values, session.stationName);
+            PutString(values, session.userName);
+        }
+    }
+    AppendProcessRecord(inner_, writer_, TRACE_PS_ENUMERATE_SESSIONS, duration, error, std::string(), values);
+    return ok;
+}
+
+OsHandle TracingProcessBackend::OpenProcessToken(uint32_t processId)
+{
+    TraceClock::time_point start = TraceClock::now();
+    OsHandle token = inner_->OpenProcessToken(processId);
+    uint64_t duration = NanosecondsSince(start);
+    uint32_t error = inner_->GetLastErrorCode();
+
+    std::string key, values;
+    PutVarint(key, processId);
+    PutVarint(values, token);
+    AppendProcessRecord(inner_, writer_, TRACE_PS_OPEN_PROCESS_TOKEN, duration, error, key, values);
+    return token;
+}
+
+bool TracingProcessBackend::OpenThreadToken(OsHandle& token)
+{
+    TraceClock::time_point start = TraceClock::now();
+    bool ok = inner_->OpenThreadToken(token);
+    uint64_t duration = NanosecondsSince(start);
+    uint32_t error = inner_->GetLastErrorCode();
+
+    std::string values;
+    PutVarint(values, ok);
+    if (ok) {
+        PutVarint(values, token);
+    }
+    AppendProcessRecord(inner_, writer_, TRACE_PS_OPEN_THREAD_TOKEN, duration, error, std::string(), values);
+    return ok;
+}
+
+bool TracingProcessBackend::ImpersonateToken(OsHandle token)
+{
+    TraceClock::time_point start = TraceClock::now();
+    bool ok = inner_->ImpersonateToken(token);
+    uint64_t duration = NanosecondsSince(start);
+    uint32_t error = inner_->GetLastErrorCode();
+
+    std::string key, values;
+    PutVarint(key, token);
+    PutVarint(values, ok);
+    AppendProcessRecord(inner_, writer_, TRACE_PS_IMPERSONATE_TOKEN, duration, error, key, values);
+    return ok;
+}
+
+void TracingProcessBackend::RevertImpersonation()
+{
+    TraceClock::time_point start = TraceClock::now();
+    inner_->RevertImpersonation();
+    uint64_t duration = NanosecondsSince(start);
+    uint32_t error = inner_->GetLastErrorCode();
+
+    AppendProcessRecord(inner_, writer_, TRACE_PS_REVERT_IMPERSONATION, duration, error, std::string(), std::string());
+}
+
+OsHandle TracingProcessBackend::LogonTrustedInstaller(bool useThreadToken)
+{
+    TraceClock::time_point start = TraceClock::now();
+    OsHandle token = inner_->LogonTrustedInstaller(useThreadToken);
+    uint64_t duration = NanosecondsSince(start);
+    uint32_t error = inner_->GetLastErrorCode();
+
+    std::string key, values;
+    PutVarint(key, useThreadToken);
+    PutVarint(values, token);
+    AppendProcessRecord(inner_, writer_, TRACE_PS_LOGON_TRUSTED_INSTALLER, duration, error, key, values);
+    return token;
+}
+
+bool TracingProcessBackend::CreateProcessWithToken(OsHandle token, const ProcessLaunchRequest& request,
+                                                   uint32_t& processId, OsHandle* process)
+{
+    TraceClock::time_point start = TraceClock::now();
+    bool ok = inner_->CreateProcessWithToken(token, request, processId, process);
+    uint64_t duration = NanosecondsSince(start);
+    uint32_t error = inner_->GetLastErrorCode();
+
+    AppendProcessRecord(inner_, writer_, TRACE_PS_CREATE_PROCESS, duration, error,
+                        EncodeLaunchKey(token, request), EncodeLaunchValues(ok, processId, process));
+    return ok;
+}
+
+bool TracingProcessBackend::CreateProcessAsUser(OsHandle token, const ProcessLaunchRequest& request,
+                                                uint32_t& processId, OsHandle* process)
+{
+    TraceClock::time_point start = TraceClock::now();
+    bool ok = inner_->CreateProcessAsUser(token, request, processId, process);
+    uint64_t duration = NanosecondsSince(start);
+    uint32_t error = inner_->GetLastErrorCode();
+
+    AppendProcessRecord(inner_, writer_, TRACE_PS_CREATE_PROCESS_AS_USER, duration, error,
+                        EncodeLaunchKey(token, request), EncodeLaunchValues(ok, processId, process));
+    return ok;
+}
+
+bool TracingProcessBackend::WaitForProcessExit(OsHandle process, uint32_t timeoutMs, uint32_t& exitCode)
+{
+    TraceClock::time_point start = TraceClock::now();
+    bool ok = inner_->WaitForProcessExit(process, timeoutMs, exitCode);
+    uint64_t duration = NanosecondsSince(start);
+    uint32_t error = inner_->GetLastErrorCode();
+
+    std::string key, values;
+    PutVarint(key, process);
+    PutVarint(key, timeoutMs);
+    PutVarint(values, ok);
+    if (ok) {
+        PutVarint(values, exitCode);
+    }
+    AppendProcessRecord(inner_, writer_, TRACE_PS_WAIT_PROCESS, duration, error, key, values);
+    return ok;
+}
+
+/** @brief Key WaitForAnyProcessExit: jumlah handle, handle, timeout */
+static std::string EncodeWaitAnyKey(const std::vector<OsHandle>& processes, uint32_t timeoutMs)
+{
+    std::string key;
+    PutVarint(key, processes.size());
+    for (OsHandle process : processes) {
+        PutVarint(key, process);
+    }
+    PutVarint(key, timeoutMs);
+    return key;
+}
+
+bool TracingProcessBackend::WaitForAnyProcessExit(const std::vector<OsHandle>& processes, uint32_t timeoutMs,
+                                                  size_t& index, uint32_t& exitCode)
+{
+    TraceClock::time_point start = TraceClock::now();
+    bool ok = inner_->WaitForAnyProcessExit(processes, timeoutMs, index, exitCode);
+    uint64_t duration = NanosecondsSince(start);
+    uint32_t error = inner_->GetLastErrorCode();
+
+    std::string values;
+    PutVarint(values, ok);
+    if (ok) {
+        PutVarint(values, index);
+        PutVarint(values, exitCode);
+    }
+    AppendProcessRecord(inner_, writer_, TRACE_PS_WAIT_ANY_PROCESS, duration, error,
+                        EncodeWaitAnyKey(processes, timeoutMs), values);
+    return ok;
+}
+
+bool TracingProcessBackend::ResumeProcess(OsHandle process)
+{
+    TraceClock::time_point start = TraceClock::now();
+    bool ok = inner_->ResumeProcess(process);
+    uint64_t duration = NanosecondsSince(start);
+    uint32_t error = inner_->GetLastErrorCode();
+
+    std::string key, values;
+    PutVarint(key, process);
+    PutVarint(values, ok);
+    AppendProcessRecord(inner_, writer_, TRACE_PS_RESUME_PROCESS, duration, error, key, values);
+    return ok;
+}
+
+bool TracingProcessBackend::TerminateProcess(OsHandle process, uint32_t exitCode)
+{
+    TraceClock::time_point start = TraceClock::now();
+    bool ok = inner_->TerminateProcess(process, exitCode);
+    uint64_t duration = NanosecondsSince(start);
+    uint32_t error = inner_->GetLastErrorCode();
+
+    std::string key, values;
+    PutVarint(key, process);
+    PutVarint(key, exitCode);
+    PutVarint(values, ok);
+    AppendProcessRecord(inner_, writer_, TRACE_PS_TERMINATE_PROCESS, duration, error, key, values);
+    return ok;
+}
+
+bool TracingProcessBackend::SetProcessSetting(OsHandle process, ProcessSetting setting, uint64_t value)
+{
+    TraceClock::time_point start = TraceClock::now();
+    bool ok = inner_->SetProcessSetting(process, setting, value);
+    uint64_t duration = NanosecondsSince(start);
+    uint32_t error = inner_->GetLastErrorCode();
+
+    std::string key, values;
+    PutVarint(key, process);
+    PutVarint(key, static_cast<uint32_t>(setting));
+    PutVarint(key, value);
+    PutVarint(values, ok);
+    AppendProcessRecord(inner_, writer_, TRACE_PS_SET_PROCESS_SETTING, duration, error, key, values);
+    return ok;
+}
+
+OsHandle TracingProcessBackend::CreateJob(const ProcessJobLimits& limits)
+{
+    TraceClock::time_point start = TraceClock::now();
+    OsHandle job = inner_->CreateJob(limits);
+    uint64_t duration = NanosecondsSince(start);
+    uint32_t error = inner_->GetLastErrorCode();
+
+    std::string key, values;
+    PutVarint(key, limits.processMemoryLimit);
+    PutVarint(key, limits.activeProcessLimit);
+    PutVarint(values, job);
+    AppendProcessRecord(inner_, writer_, TRACE_PS_CREATE_JOB, duration, error, key, values);
+    return job;
+}
+
+bool TracingProcessBackend::AssignProcessToJob(OsHandle job, OsHandle process)
+{
+    TraceClock::time_point start = TraceClock::now();
+    bool ok = inner_->AssignProcessToJob(job, process);
+    uint64_t duration = NanosecondsSince(start);
+    uint32_t error = inner_->GetLastErrorCode();
+
+    std::string key, values;
+    PutVarint(key, job);
+    PutVarint(key, process);
+    PutVarint(values, ok);
+    AppendProcessRecord(inner_, writer_, TRACE_PS_ASSIGN_PROCESS_TO_JOB, duration, error, key, values);
+    return ok;
+}
+
+bool TracingProcessBackend::IsPrivilegeEnabled(int privilege)
+{
+    TraceClock::time_point start = TraceClock::now();
+    bool enabled = inner_->IsPrivilegeEnabled(privilege);
+    uint64_t duration = NanosecondsSince(start);
+    uint32_t error = inner_->GetLastErrorCode();
+
+    std::string key, values;
+    PutVarint(key, static_cast<uint32_t>(privilege));
+    PutVarint(values, enabled);
+    AppendProcessRecord(inner_, writer_, TRACE_PS_IS_PRIVILEGE_ENABLED, duration, error, key, values);
+    return enabled;
+}
+
+bool TracingProcessBackend::IsElevatedAdministrator()
+{
+    TraceClock::time_point start = TraceClock::now();
+    bool elevated = inner_->IsElevatedAdministrator();
+    uint64_t duration = NanosecondsSince(start);
+    uint32_t error = inner_->GetLastErrorCode();
+
+    std::string values;
+    PutVarint(values, elevated);
+    AppendProcessRecord(inner_, writer_, TRACE_PS_IS_ELEVATED_ADMINISTRATOR, duration, error, std::string(), values);
+    return elevated;
+}
+
+bool TracingProcessBackend::GetModuleFilePath(std::wstring& path)
+{
+    TraceClock::time_point start = TraceClock::now();
+    bool ok = inner_->GetModuleFilePath(path);
+    uint64_t duration = NanosecondsSince(start);
+    uint32_t error = inner_->GetLastErrorCode();
+
+    std::string values;
+    PutVarint(values, ok);
+    if (ok) {
+        PutString(values, path);
+    }
+    AppendProcessRecord(inner_, writer_, TRACE_PS_GET_MODULE_PATH, duration, error, std::string(), values);
+    return ok;
+}
+
+void TracingProcessBackend::CloseObject(OsHandle handle)
+{
+    TraceClock::time_point start = TraceClock::now();
+    inner_->CloseObject(handle);
+    uint64_t duration = NanosecondsSince(start);
+    uint32_t error = inner_->GetLastErrorCode();
+
+    std::string key;
+    PutVarint(key, handle);
+    AppendProcessRecord(inner_, writer_, TRACE_PS_CLOSE_OBJECT, duration, error, key, std::string());
+}
+
+uint32_t TracingProcessBackend::GetLastErrorCode()
+{
+    return inner_->GetLastErrorCode();
+}
+
+void TracingProcessBackend::SetLastErrorCode(uint32_t error)
+{
+    inner_->SetLastErrorCode(error);
+}
+
+ScopedBackendTrace::ScopedBackendTrace(const BackendTraceSession& session, BackendTraceWriter::Sink sink,
+                                       bool recordFileContents)
+    : previousFileSystem_(GetFileSystemBackend()),
+      previousProcess_(GetProcessBackend()),
+      writer_(session, std::move(sink)),
+      fileSystem_(previousFileSystem_, writer_, recordFileContents),
+      process_(previousProcess_, writer_)
+{
+    SetFileSystemBackend(&fileSystem_);
+    SetProcessBackend(&process_);
+}
+
+ScopedBackendTrace::~ScopedBackendTrace()
+{
+    SetProcessBackend(previousProcess_);
+    SetFileSystemBackend(previousFileSystem_);
+    writer_.Flush();
+}
+
+//==============================================================================
+// REPLAY
+//==============================================================================
+
+/** @brief Menunggu durasi tercatat: sleep untuk sisa panjang, spin untuk presisi */
+static void WaitNanoseconds(double nanoseconds)
+{
+    TraceClock::time_point deadline = TraceClock::now() +
+        std::chrono::duration_cast<TraceClock::duration>(std::chrono::duration<double, std::nano>(nanoseconds));
+
+    // sleep_for di Linux terlambat puluhan mikrodetik; sisakan 200 us untuk spin
+    const std::chrono::microseconds spinWindow(200);
+    TraceClock::time_point now = TraceClock::now();
+    if (deadline - now > spinWindow) {
+        std::this_thread::sleep_for(deadline - now - spinWindow);
+    }
+    while (TraceClock::now() < deadline) {
+        std::this_thread::yield();
+    }
+}
+
+TraceReplayBackend::TraceReplayBackend(const BackendTrace& trace, double timeScale)
+    : trace_(trace), timeScale_(timeScale), lastError_(0)
+{
+    Rewind();
+}
+
+void TraceReplayBackend::Rewind()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    pending_.clear();
+    for (size_t i = 0; i < trace_.records.size(); i++) {
+        const BackendTraceRecord& record = trace_.records[i];
+        pending_[std::string(1, static_cast<char>(record.call)) + record.key].push_back(i);
+    }
+    views_.clear();
+    stats_ = BackendReplayStats();
+    lastError_ = 0;
+}
+
+BackendReplayStats TraceReplayBackend::GetStats()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    BackendReplayStats stats = stats_;
+    for (const auto& entry : pending_) {
+        stats.unconsumed += entry.second.size();
+    }
+    return stats;
+}
+
+/**
+ * @brief Mengambil record berikutnya dengan call + key yang sama
+ *
+ * @return Record (setelah menunggu durasinya), atau NULL jika tidak ada pasangan
+ */
+const BackendTraceRecord* TraceReplayBackend::Take(BackendTraceCall call, const std::string& key)
+{
+    const BackendTraceRecord* record = NULL;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = pending_.find(std::string(1, static_cast<char>(call)) + key);
+        if (it != pending_.end() && !it->second.empty()) {
+            record = &trace_.records[it->second.front()];
+            it->second.pop_front();
+            stats_.matched++;
+            stats_.replayedNs += record->durationNs;
+        } else {
+            stats_.unmatched++;
+        }
+    }
+
+    if (record && timeScale_ > 0.0 && record->durationNs > 0) {
+        WaitNanoseconds(record->durationNs * timeScale_);
+    }
+    return record;
+}
+
+/**
+ * @brief Take untuk backend proses: memulihkan kode error tercatat
+ *
+ * @return Record, atau NULL jika tidak ada pasangan (error = OS_ERROR_NOT_SUPPORTED)
+ */
+const BackendTraceRecord* TraceReplayBackend::TakeWithError(BackendTraceCall call, const std::string& key)
+{
+    const BackendTraceRecord* record = Take(call, key);
+    lastError_ = OS_ERROR_NOT_SUPPORTED;
+    if (record) {
+        TraceReader reader(record->result);
+        lastError_ = static_cast<uint32_t>(reader.Varint());
+    }
+    return record;
+}
+
+/** @brief Pembaca result proses yang sudah melewati kode error */
+static TraceReader ProcessValues(const BackendTraceRecord* record)
+{
+    TraceReader reader(record->result);
+    reader.Varint();
+    return reader;
+}
+
+/** @brief Membaca result launch (lihat EncodeLaunchValues) */
+static bool DecodeLaunchValues(const BackendTraceRecord* record, uint32_t& processId, OsHandle* process)
+{
+    TraceReader reader = ProcessValues(record);
+    bool ok = reader.Varint() != 0;
+    if (ok) {
+        processId = static_cast<uint32_t>(reader.Varint());
+        if (process) {
+            *process = static_cast<OsHandle>(reader.Varint());
+        }
+    }
+    return ok && reader.ok;
+}
+
+/** @brief Menyalin data file tercatat, atau nol jika tidak disimpan */
+static void ReadFileData(TraceReader& reader, uint8_t* buffer, size_t size)
+{
+    const char* data = NULL;
+    size_t length = 0;
+    if (reader.Varint() == 1 && reader.Bytes(data, length)) {
+        length = std::min(length, size);
+        memcpy(buffer, data, length);
+        memset(buffer + length, 0, size - length);
+    } else {
+        memset(buffer, 0, size);
+    }
+}
+
+bool TraceReplayBackend::GetFullPath(const std::wstring& path, std::wstring& fullPath)
+{
+    std::string key;
+    PutString(key, path);
+    const BackendTraceRecord* record = Take(TRACE_FS_GET_FULL_PATH, key);
+    if (!record) {
+        return false;
+    }
+
+    TraceReader reader(record->result);
+    bool ok = reader.Varint() != 0;
+    if (ok) {
+        fullPath = reader.String();
+    }
+    return ok && reader.ok;
+}
+
+OsHandle TraceReplayBackend::OpenFileForValidation(const std::wstring& path)
+{
+    std::string key;
+    PutString(key, path);
+    const BackendTraceRecord* record = Take(TRACE_FS_OPEN_FILE, key);
+    if (!record) {
+        return OS_INVALID_HANDLE;
+    }
+
+    TraceReader reader(record->result);
+    return static_cast<OsHandle>(reader.Varint());
+}
+
+bool TraceReplayBackend::QueryFileIdentity(OsHandle file, FileIdentity& identity)
+{
+    std::string key;
+    PutVarint(key, file);
+    const BackendTraceRecord* record = Take(TRACE_FS_QUERY_IDENTITY, key);
+    if (!record) {
+        return false;
+    }
+
+    TraceReader reader(record->result);
+    bool ok = reader.Varint() != 0;
+    if (ok) {
+        identity.volumeSerial = reader.Varint();
+        identity.fileIndex = reader.Varint();
+        identity.fileSize = reader.Varint();
+        identity.lastWriteTime = reader.Varint();
+        identity.isDirectory = reader.Varint() != 0;
+    }
+    return ok && reader.ok;
+}
+
+bool TraceReplayBackend::ReadFileAt(OsHandle file, uint64_t offset, void* buffer, uint32_t size, uint32_t& bytesRead)
+{
+    std::string key;
+    PutVarint(key, file);
+    PutVarint(key, offset);
+    PutVarint(key, size);
+    const BackendTraceRecord* record = Take(TRACE_FS_READ_FILE, key);
+    bytesRead = 0;
+    if (!record) {
+        return false;
+    }
+
+    TraceReader reader(record->result);
+    bool ok = reader.Varint() != 0;
+    if (ok) {
+        bytesRead = std::min(static_cast<uint32_t>(reader.Varint()), size);
+        ReadFileData(reader, static_cast<uint8_t*>(buffer), bytesRead);
+    }
+    return ok && reader.ok;
+}
+
+const uint8_t* TraceReplayBackend::MapFileView(OsHandle file, uint64_t offset, uint32_t size)
+{
+    std::string key;
+    PutVarint(key, file);
+    PutVarint(key, offset);
+    PutVarint(key, size);
+    const BackendTraceRecord* record = Take(TRACE_FS_MAP_VIEW, key);
+    if (!record) {
+        return NULL;
+    }
+
+    TraceReader reader(record->result);
+    if (reader.Varint() == 0) {
+        return NULL;
+    }
+
+    std::vector<uint8_t> view(std::max<uint32_t>(size, 1));
+    ReadFileData(reader, view.data(), size);
+    const uint8_t* address = view.data();
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    views_[address] = std::move(view);
+    return address;
+}
+
+void TraceReplayBackend::UnmapFileView(const uint8_t* view, uint32_t size)
+{
+    std::string key;
+    PutVarint(key, size);
+    Take(TRACE_FS_UNMAP_VIEW, key);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    views_.erase(view);
+}
+
+void TraceReplayBackend::CloseFile(OsHandle file)
+{
+    std::string key;
+    PutVarint(key, file);
+    Take(TRACE_FS_CLOSE_FILE, key);
+}
+
+bool TraceReplayBackend::EnumerateDirectory(const std::wstring& directory, std::vector<DirectoryEntry>& entries)
+{
+    std::string key;
+    PutString(key, directory);
+    const BackendTraceRecord* record = Take(TRACE_FS_ENUMERATE_DIRECTORY, key);
+    entries.clear();
+    if (!record) {
+        return false;
+    }
+
+    TraceReader reader(record->result);
+    bool ok = reader.Varint() != 0;
+    uint64_t count = ok ? reader.Varint() : 0;
+    for (uint64_t i = 0; reader.ok && i < count; i++) {
+        DirectoryEntry entry;
+        entry.name = reader.String();
+        uint64_t flags = reader.Varint();
+        entry.isDirectory = (flags & 1) != 0;
+        entry.isReparsePoint = (flags & 2) != 0;
+        entries.push_back(entry);
+    }
+    return ok && reader.ok;
+}
+
+bool TraceReplayBackend::GetEnvironmentValue(const std::wstring& name, std::wstring& value)
+{
+    std::string key;
+    PutString(key, name);
+    const BackendTraceRecord* record = Take(TRACE_FS_GET_ENVIRONMENT, key);
+    if (!record) {
+        return false;
+    }
+
+    TraceReader reader(record->result);
+    bool ok = reader.Varint() != 0;
+    if (ok) {
+        value = reader.String();
+    }
+    return ok && reader.ok;
+}
+
+bool TraceReplayBackend::GetCurrentDirectoryPath(std::wstring& path)
+{
+    const BackendTraceRecord* record = Take(TRACE_FS_GET_CURRENT_DIRECTORY, std::string());
+    if (!record) {
+        return false;
+    }
+
+    TraceReader reader(record->result);
+    bool ok = reader.Varint() != 0;
+    if (ok) {
+        path = reader.String();
+    }
+    return ok && reader.ok;
+}
+
+bool TraceReplayBackend::AdjustPrivilege(int privilege, bool threadScope)
+{
+    std::string key;
+    PutVarint(key, static_cast<uint32_t>(privilege));
+    PutVarint(key, threadScope);
+    const BackendTraceRecord* record = TakeWithError(TRACE_PS_ADJUST_PRIVILEGE, key);
+    return record && ProcessValues(record).Varint() != 0;
+}
+
+bool TraceReplayBackend::FindProcessByName(const std::wstring& imageName, uint32_t& processId)
+{
+    std::string key;
+    PutString(key, imageName);
+    const BackendTraceRecord* record = TakeWithError(TRACE_PS_FIND_PROCESS, key);
+    if (!record) {
+        return false;
+    }
+
+    TraceReader reader = ProcessValues(record);
+    bool ok = reader.Varint() != 0;
+    if (ok) {
+        processId = static_cast<uint32_t>(reader.Varint());
+    }
+    return ok && reader.ok;
+}
+
+bool TraceReplayBackend::EnumerateProcesses(std::vector<ProcessEntry>& processes)
+{
+    const BackendTraceRecord* record = TakeWithError(TRACE_PS_ENUMERATE_PROCESSES, std::string());
+    processes.clear();
+    if (!record) {
+        return false;
+    }
+
+    TraceReader reader = ProcessValues(record);
+    bool ok = reader.Varint() != 0;
+    uint64_t count = ok ? reader.Varint() : 0;
+    for (uint64_t i = 0; reader.ok && i < count; i++) {
+        ProcessEntry entry;
+        entry.processId = static_cast<uint32_t>(reader.Varint());
+        entry.parentProcessId = static_cast<uint32_t>(reader.Varint());
+        entry.imageName = reader.String();
+        processes.push_back(entry);
+    }
+    return ok && reader.ok;
+}
+
+OsHandle TraceReplayBackend::OpenProcessHandle(uint32_t processId)
+{
+    std::string key;
+    PutVarint(key, processId);
+    const BackendTraceRecord* record = TakeWithError(TRACE_PS_OPEN_PROCESS, key);
+    return record ? static_cast<OsHandle>(ProcessValues(record).Varint()) : OS_INVALID_HANDLE;
+}
+
+bool TraceReplayBackend::QueryProcessImagePath(OsHandle process, std::wstring& path)
+{
+    std::string key;
+    PutVarint(key, process);
+    const BackendTraceRecord* record = TakeWithError(TRACE_PS_QUERY_PROCESS_PATH, key);
+    if (!record) {
+        return false;
+    }
+
+    TraceReader reader = ProcessValues(record);
+    bool ok = reader.Varint() != 0;
+    if (ok) {
+        path = reader.String();
+    }
+    return ok && reader.ok;
+}
+
+bool TraceReplayBackend::EnumerateSessions(std::vector<SessionEntry>& sessions)
+{
+    const BackendTraceRecord* record = TakeWithError(TRACE_PS_ENUMERATE_SESSIONS, std::string());
+    sessions.clear();
+    if (!record) {
+        return false;
+    }
+
+    TraceReader reader = ProcessValues(record);
+    bool ok = reader.Varint() != 0;
+    uint64_t count = ok ? reader.Varint() : 0;
+    for (uint64_t i = 0; reader.ok && i < count; i++) {
+        SessionEntry session;
+        session.sessionId = static_cast<uint32_t>(reader.Varint());
+        session.active = reader.Varint() != 0;
+        session.stationName = reader.String();
+        session.userName = reader.String();
+        sessions.push_back(session);
+    }
+    return ok && reader.ok;
+}
+
+OsHandle TraceReplayBackend::OpenProcessToken(uint32_t processId)
+{
+    std::string key;
+    PutVarint(key, processId);
+    const BackendTraceRecord* record = TakeWithError(TRACE_PS_OPEN_PROCESS_TOKEN, key);
+    return record ? static_cast<OsHandle>(ProcessValues(record).Varint()) : OS_INVALID_HANDLE;
+}
+
+bool TraceReplayBackend::OpenThreadToken(OsHandle& token)
+{
+    const BackendTraceRecord* record = TakeWithError(TRACE_PS_OPEN_THREAD_TOKEN, std::string());
+    token = OS_INVALID_HANDLE;
+    if (!record) {
+        return false;
+    }
+
+    TraceReader reader = ProcessValues(record);
+    bool ok = reader.Varint() != 0;
+    if (ok) {
+        token = static_cast<OsHandle>(reader.Varint());
+    }
+    return ok && reader.ok;
+}
+
+bool TraceReplayBackend::ImpersonateToken(OsHandle token)
+{
+    std::string key;
+    PutVarint(key, token);
+    const BackendTraceRecord* record = TakeWithError(TRACE_PS_IMPERSONATE_TOKEN, key);
+    return record && ProcessValues(record).Varint() != 0;
+}
+
+void TraceReplayBackend::RevertImpersonation()
+{
+    TakeWithError(TRACE_PS_REVERT_IMPERSONATION, std::string());
+}
+
+OsHandle TraceReplayBackend::LogonTrustedInstaller(bool useThreadToken)
+{
+    std::string key;
+    PutVarint(key, useThreadToken);
+    const BackendTraceRecord* record = TakeWithError(TRACE_PS_LOGON_TRUSTED_INSTALLER, key);
+    return record ? static_cast<OsHandle>(ProcessValues(record).Varint()) : OS_INVALID_HANDLE;
+}
+
+bool TraceReplayBackend::CreateProcessWithToken(OsHandle token, const ProcessLaunchRequest& request,
+                                                uint32_t& processId, OsHandle* process)
+{
+    const BackendTraceRecord* record = TakeWithError(TRACE_PS_CREATE_PROCESS, EncodeLaunchKey(token, request));
+    return record && DecodeLaunchValues(record, processId, process);
+}
+
+bool TraceReplayBackend::CreateProcessAsUser(OsHandle token, const ProcessLaunchRequest& request,
+                                             uint32_t& processId, OsHandle* process)
+{
+    const BackendTraceRecord* record = TakeWithError(TRACE_PS_CREATE_PROCESS_AS_USER, EncodeLaunchKey(token, request));
+    return record && DecodeLaunchValues(record, processId, process);
+}
+
+bool TraceReplayBackend::WaitForProcessExit(OsHandle process, uint32_t timeoutMs, uint32_t& exitCode)
+{
+    std::string key;
+    PutVarint(key, process);
+    PutVarint(key, timeoutMs);
+    const BackendTraceRecord* record = TakeWithError(TRACE_PS_WAIT_PROCESS, key);
+    if (!record) {
+        return false;
+    }
+
+    TraceReader reader = ProcessValues(record);
+    bool ok = reader.Varint() != 0;
+    if (ok) {
+        exitCode = static_cast<uint32_t>(reader.Varint());
+    }
+    return ok && reader.ok;
+}
+
+bool TraceReplayBackend::WaitForAnyProcessExit(const std::vector<OsHandle>& processes, uint32_t timeoutMs,
+                                               size_t& index, uint32_t& exitCode)
+{
+    const BackendTraceRecord* record = TakeWithError(TRACE_PS_WAIT_ANY_PROCESS, EncodeWaitAnyKey(processes, timeoutMs));
+    if (!record) {
+        return false;
+    }
+
+    TraceReader reader = ProcessValues(record);
+    bool ok = reader.Varint() != 0;
+    if (ok) {
+        index = static_cast<size_t>(reader.Varint());
+        exitCode = static_cast<uint32_t>(reader.Varint());
+    }
+    return ok && reader.ok && index < processes.size();
+}
+
+bool TraceReplayBackend::ResumeProcess(OsHandle process)
+{
+    std::string key;
+    PutVarint(key, process);
+    const BackendTraceRecord* record = TakeWithError(TRACE_PS_RESUME_PROCESS, key);
+    return record && ProcessValues(record).Varint() != 0;
+}
+
+bool TraceReplayBackend::TerminateProcess(OsHandle process, uint32_t exitCode)
+{
+    std::string key;
+    PutVarint(key, process);
+    PutVarint(key, exitCode);
+    const BackendTraceRecord* record = TakeWithError(TRACE_PS_TERMINATE_PROCESS, key);
+    return record && ProcessValues(record).Varint() != 0;
+}
+
+bool TraceReplayBackend::SetProcessSetting(OsHandle process, ProcessSetting setting, uint64_t value)
+{
+    std::string key;
+    PutVarint(key, process);
+    PutVarint(key, static_cast<uint32_t>(setting));
+    PutVarint(key, value);
+    const BackendTraceRecord* record = TakeWithError(TRACE_PS_SET_PROCESS_SETTING, key);
+    return record && ProcessValues(record).Varint() != 0;
+}
+
+OsHandle TraceReplayBackend::CreateJob(const ProcessJobLimits& limits)
+{
+    std::string key;
+    PutVarint(key, limits.processMemoryLimit);
+    PutVarint(key, limits.activeProcessLimit);
+    const BackendTraceRecord* record = TakeWithError(TRACE_PS_CREATE_JOB, key);
+    return record ? static_cast<OsHandle>(ProcessValues(record).Varint()) : OS_INVALID_HANDLE;
+}
+
+bool TraceReplayBackend::AssignProcessToJob(OsHandle job, OsHandle process)
+{
+    std::string key;
+    PutVarint(key, job);
+    PutVarint(key, process);
+    const BackendTraceRecord* record = TakeWithError(TRACE_PS_ASSIGN_PROCESS_TO_JOB, key);
+    return record && ProcessValues(record).Varint() != 0;
+}
+
+bool TraceReplayBackend::IsPrivilegeEnabled(int privilege)
+{
+    std::string key;
+    PutVarint(key, static_cast<uint32_t>(privilege));
+    const BackendTraceRecord* record = TakeWithError(TRACE_PS_IS_PRIVILEGE_ENABLED, key);
+    return record && ProcessValues(record).Varint() != 0;
+}
+
+bool TraceReplayBackend::IsElevatedAdministrator()
+{
+    const BackendTraceRecord* record = TakeWithError(TRACE_PS_IS_ELEVATED_ADMINISTRATOR, std::string());
+    return record && ProcessValues(record).Varint() != 0;
+}
+
+bool TraceReplayBackend::GetModuleFilePath(std::wstring& path)
+{
+    const BackendTraceRecord* record = TakeWithError(TRACE_PS_GET_MODULE_PATH, std::string());
+    if (!record) {
+        return false;
+    }
+
+    TraceReader reader = ProcessValues(record);
+    bool ok = reader.Varint() != 0;
+    if (ok) {
+        path = reader.String();
+    }
+    return ok && reader.ok;
+}
+
+void TraceReplayBackend::CloseObject(OsHandle handle)
+{
+    std::string key;
+    PutVarint(key, handle);
+    TakeWithError(TRACE_PS_CLOSE_OBJECT, key);
+}
+
+uint32_t TraceReplayBackend::GetLastErrorCode()
+{
+    return lastError_;
+}
+
+void TraceReplayBackend::SetLastErrorCode(uint32_t error)
+{
+    lastError_ = error;
+}
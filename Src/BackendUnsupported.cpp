@@ -0,0 +1,202 @@
+/**
+ * @file BackendUnsupported.cpp
+ * @brief Backend OS default untuk build portable (Linux/GCC/Clang)
+ *
+ * Di luar Windows tidak ada filesystem dengan semantik path Win32 maupun
+ * token Trusted Installer, sehingga setiap operasi gagal dengan
+ * OS_ERROR_NOT_SUPPORTED. Test dan benchmark portable memasang backend palsu
+ * dengan SetFileSystemBackend/SetProcessBackend (dan backend direktori
+ * sementara dengan SetFileOperationBackend, registry in-memory dengan
+ * SetRegistryBackend, host script simulasi dengan SetScriptHostBackend,
+ * proses capture simulasi dengan SetOutputCaptureBackend)
+ * sebelum memanggil Core.
+ *
+ * File ini menggantikan BackendWin32.cpp di build CMake.
+ *
+ * @author RasTI Development Team
+ * @version 1.2.0.0
+ * @date 2025
+ */
+
+#include "Backend.h"
+
+//==============================================================================
+// UNSUPPORTED BACKENDS
+//==============================================================================
+
+/** @brief Kode error terakhir per thread (pengganti GetLastError) */
+static thread_local uint32_t gLastError = 0;
+
+/**
+ * @brief Backend filesystem yang selalu gagal
+ */
+class UnsupportedFileSystemBackend : public IFileSystemBackend {
+public:
+    bool GetFullPath(const std::wstring&, std::wstring&) override { return Fail(); }
+    OsHandle OpenFileForValidation(const std::wstring&) override { Fail(); return OS_INVALID_HANDLE; }
+    bool QueryFileIdentity(OsHandle, FileIdentity&) override { return Fail(); }
+    bool ReadFileAt(OsHandle, uint64_t, void*, uint32_t, uint32_t& bytesRead) override { bytesRead = 0; return Fail(); }
+    const uint8_t* MapFileView(OsHandle, uint64_t, uint32_t) override { Fail(); return nullptr; }
+    void UnmapFileView(const uint8_t*, uint32_t) override {}
+    void CloseFile(OsHandle) override {}
+    bool EnumerateDirectory(const std::wstring&, std::vector<DirectoryEntry>& entries) override { entries.clear(); return Fail(); }
+    bool GetEnvironmentValue(const std::wstring&, std::wstring&) override { return Fail(); }
+    bool GetCurrentDirectoryPath(std::wstring&) override { return Fail(); }
+
+private:
+    static bool Fail() { gLastError = OS_ERROR_NOT_SUPPORTED; return false; }
+};
+
+/**
+ * @brief Backend proses/token yang selalu gagal
+ */
+class UnsupportedProcessBackend : public IProcessBackend {
+public:
+    bool AdjustPrivilege(int, bool) override { return Fail(); }
+    bool FindProcessByName(const std::wstring&, uint32_t&) override { return Fail(); }
+    bool EnumerateProcesses(std::vector<ProcessEntry>& processes) override { processes.clear(); return Fail(); }
+    OsHandle OpenProcessHandle(uint32_t) override { Fail(); return OS_INVALID_HANDLE; }
+    bool QueryProcessImagePath(OsHandle, std::wstring&) override { return Fail(); }
+    bool EnumerateSessions(std::vector<SessionEntry>& sessions) override { sessions.clear(); return Fail(); }
+    OsHandle OpenProcessToken(uint32_t) override { Fail(); return OS_INVALID_HANDLE; }
+    bool OpenThreadToken(OsHandle& token) override { token = OS_INVALID_HANDLE; return Fail(); }
+    bool ImpersonateToken(OsHandle) override { return Fail(); }
+    void RevertImpersonation() override {}
+    OsHandle LogonTrustedInstaller(bool) override { Fail(); return OS_INVALID_HANDLE; }
+    bool CreateProcessWithToken(OsHandle, const ProcessLaunchRequest&, uint32_t&, OsHandle*) override { return Fail(); }
+    bool CreateProcessAsUser(OsHandle, const ProcessLaunchRequest&, uint32_t&, OsHandle*) override { return Fail(); }
+    bool WaitForProcessExit(OsHandle, uint32_t, uint32_t&) override { return Fail(); }
+    bool WaitForAnyProcessExit(const std::vector<OsHandle>&, uint32_t, size_t&, uint32_t&) override { return Fail(); }
+    bool ResumeProcess(OsHandle) override { return Fail(); }
+    bool TerminateProcess(OsHandle, uint32_t) override { return Fail(); }
+    bool SetProcessSetting(OsHandle, ProcessSetting, uint64_t) override { return Fail(); }
+    OsHandle CreateJob(const ProcessJobLimits&) override { Fail(); return OS_INVALID_HANDLE; }
+    bool AssignProcessToJob(OsHandle, OsHandle) override { return Fail(); }
+    bool IsPrivilegeEnabled(int) override { return Fail(); }
+    bool IsElevatedAdministrator() override { return Fail(); }
+    bool GetModuleFilePath(std::wstring&) override { return Fail(); }
+    void CloseObject(OsHandle) override {}
+    uint32_t GetLastErrorCode() override { return gLastError; }
+    void SetLastErrorCode(uint32_t error) override { gLastError = error; }
+
+private:
+    static bool Fail() { gLastError = OS_ERROR_NOT_SUPPORTED; return false; }
+};
+
+/**
+ * @brief Backend operasi file yang selalu gagal
+ */
+class UnsupportedFileOperationBackend : public IFileOperationBackend {
+public:
+    bool ListDirectory(const std::wstring&, std::vector<FileOperationEntry>& entries) override { entries.clear(); return Fail(); }
+    bool QueryPath(const std::wstring&, FileOperationEntry&) override { return Fail(); }
+    bool MakeDirectory(const std::wstring&) override { return Fail(); }
+    bool CopyFileContents(const std::wstring&, const std::wstring&, bool) override { return Fail(); }
+    bool MovePath(const std::wstring&, const std::wstring&) override { return Fail(); }
+    bool DeletePath(const std::wstring&, bool) override { return Fail(); }
+    bool BuildSecurityDescriptor(const std::wstring&, std::vector<uint8_t>& descriptor, std::wstring&) override { descriptor.clear(); return Fail(); }
+    bool ReadSecurity(const std::wstring&, std::wstring&) override { return Fail(); }
+    bool WriteSecurity(const std::wstring&, const std::vector<uint8_t>&) override { return Fail(); }
+    bool ReadFileContents(const std::wstring&, uint32_t, std::string& contents) override { contents.clear(); return Fail(); }
+    bool WriteFileContents(const std::wstring&, const std::string&) override { return Fail(); }
+    uint32_t GetLastErrorCode() override { return gLastError; }
+
+private:
+    static bool Fail() { gLastError = OS_ERROR_NOT_SUPPORTED; return false; }
+};
+
+/**
+ * @brief Backend registry yang selalu gagal
+ */
+class UnsupportedRegistryBackend : public IRegistryBackend {
+public:
+    OsHandle OpenKey(RegistryRoot, const std::wstring&, bool) override { Fail(); return OS_INVALID_HANDLE; }
+    OsHandle CreateKey(RegistryRoot, const std::wstring&, bool& created) override { created = false; Fail(); return OS_INVALID_HANDLE; }
+    bool QueryValue(OsHandle, const std::wstring&, uint32_t&, std::vector<uint8_t>& data) override { data.clear(); return Fail(); }
+    bool SetValue(OsHandle, const std::wstring&, uint32_t, const std::vector<uint8_t>&) override { return Fail(); }
+    bool DeleteValue(OsHandle, const std::wstring&) override { return Fail(); }
+    bool DeleteKeyTree(RegistryRoot, const std::wstring&) override { return Fail(); }
+    void CloseKey(OsHandle) override {}
+    uint32_t GetLastErrorCode() override { return gLastError; }
+
+private:
+    static bool Fail() { gLastError = OS_ERROR_NOT_SUPPORTED; return false; }
+};
+
+/**
+ * @brief Backend script host yang selalu gagal
+ */
+class UnsupportedScriptHostBackend : public IScriptHostBackend {
+public:
+    OsHandle StartHost(OsHandle, const ProcessLaunchRequest&) override { Fail(); return OS_INVALID_HANDLE; }
+    bool WriteHostInput(OsHandle, const std::string&) override { return Fail(); }
+    bool ReadHostOutput(OsHandle, uint32_t, std::string&) override { return Fail(); }
+    bool WaitHostExit(OsHandle, uint32_t, uint32_t&) override { return Fail(); }
+    void CloseHost(OsHandle) override {}
+    uint32_t GetLastErrorCode() override { return gLastError; }
+
+private:
+    static bool Fail() { gLastError = OS_ERROR_NOT_SUPPORTED; return false; }
+};
+
+/**
+ * @brief Backend capture output yang selalu gagal
+ */
+class UnsupportedOutputCaptureBackend : public IOutputCaptureBackend {
+public:
+    OsHandle CreateCapturePort() override { Fail(); return OS_INVALID_HANDLE; }
+    OsHandle StartCapturedProcess(OsHandle, OsHandle, const ProcessLaunchRequest&, uint32_t&) override { Fail(); return OS_INVALID_HANDLE; }
+    bool WaitCaptureEvent(OsHandle, uint32_t, CaptureEvent&) override { return Fail(); }
+    bool QueryCapturedExit(OsHandle, uint32_t&) override { return Fail(); }
+    bool QueryCapturedAccounting(OsHandle, ProcessAccounting&) override { return Fail(); }
+    void CloseCapturedProcess(OsHandle) override {}
+    void CloseCapturePort(OsHandle) override {}
+    OsHandle CreateLogFile(const std::wstring&) override { Fail(); return OS_INVALID_HANDLE; }
+    bool WriteLogFile(OsHandle, const char*, size_t) override { return Fail(); }
+    void CloseLogFile(OsHandle) override {}
+    bool RenameLogFile(const std::wstring&, const std::wstring&) override { return Fail(); }
+    uint32_t GetLastErrorCode() override { return gLastError; }
+
+private:
+    static bool Fail() { gLastError = OS_ERROR_NOT_SUPPORTED; return false; }
+};
+
+//==============================================================================
+// DEFAULT BACKEND
+//==============================================================================
+
+IFileSystemBackend* GetDefaultFileSystemBackend()
+{
+    static UnsupportedFileSystemBackend backend;
+    return &backend;
+}
+
+IProcessBackend* GetDefaultProcessBackend()
+{
+    static UnsupportedProcessBackend backend;
+    return &backend;
+}
+
+IFileOperationBackend* GetDefaultFileOperationBackend()
+{
+    static UnsupportedFileOperationBackend backend;
+    return &backend;
+}
+
+IRegistryBackend* GetDefaultRegistryBackend()
+{
+    static UnsupportedRegistryBackend backend;
+    return &backend;
+}
+
+IScriptHostBackend* GetDefaultScriptHostBackend()
+{
+    static UnsupportedScriptHostBackend backend;
+    return &backend;
+}
+
+IOutputCaptureBackend* GetDefaultOutputCaptureBackend()
+{
+    static UnsupportedOutputCaptureBackend backend;
+    return &backend;
+}
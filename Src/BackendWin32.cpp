@@ -0,0 +1,1978 @@
+/**
+ * @file BackendWin32.cpp
+ * @brief Implementasi backend OS menggunakan Win32 API
+ *
+ * Setiap method memetakan langsung ke satu panggilan Win32 API sehingga
+ * jumlah panggilan backend sama dengan jumlah syscall yang dilakukan.
+ * Backend proses memakai function pointer dari ResolveDynamicFunctions
+ * (RtlAdjustPrivilege, LogonUserExExW, NtResumeProcess, NtSetInformationProcess,
+ * SetProcessInformation) dan gagal dengan aman jika NULL.
+ *
+ * @author RasTI Development Team
+ * @version 1.2.0.0
+ * @date 2025
+ */
+
+#include <Windows.h>
+#include <sddl.h>
+#include <algorithm>
+#include <map>
+#include <new>
+#include <vector>
+#include "Core.h"
+
+//==============================================================================
+// WIN32 FILESYSTEM BACKEND
+//==============================================================================
+
+/**
+ * @brief Backend filesystem berbasis Win32 API (wide-character)
+ */
+class Win32FileSystemBackend : public IFileSystemBackend {
+public:
+    bool GetFullPath(const std::wstring& path, std::wstring& fullPath) override
+    {
+        // Buffer awal cukup untuk sebagian besar path; ulangi jika terlalu kecil
+        std::vector<wchar_t> buffer(MAX_PATH + 1);
+        DWORD length = GetFullPathNameW(path.c_str(), static_cast<DWORD>(buffer.size()), buffer.data(), NULL);
+        if (length == 0) {
+            return false;
+        }
+
+        if (length >= buffer.size()) {
+            buffer.resize(length + 1);
+            length = GetFullPathNameW(path.c_str(), static_cast<DWORD>(buffer.size()), buffer.data(), NULL);
+            if (length == 0 || length >= buffer.size()) {
+                return false;
+            }
+        }
+
+        fullPath.assign(buffer.data(), length);
+        return true;
+    }
+
+    OsHandle OpenFileForValidation(const std::wstring& path) override
+    {
+        // Path >= MAX_PATH dibuka melalui prefix "\\?\" (tanpa batas MAX_PATH)
+        std::wstring openPath = ToExtendedLengthPath(path);
+
+        // SECURITY: FILE_SHARE_READ saja - write/delete/rename ditolak selama
+        // handle terbuka, sehingga file tidak dapat ditukar sebelum launch
+        HANDLE hFile = CreateFileW(openPath.c_str(), GENERIC_READ, FILE_SHARE_READ,
+                                   NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+        if (hFile == INVALID_HANDLE_VALUE) {
+            return OS_INVALID_HANDLE;
+        }
+        return reinterpret_cast<OsHandle>(hFile);
+    }
+
+    bool QueryFileIdentity(OsHandle file, FileIdentity& identity) override
+    {
+        BY_HANDLE_FILE_INFORMATION info;
+        if (!GetFileInformationByHandle(reinterpret_cast<HANDLE>(file), &info)) {
+            return false;
+        }
+
+        identity.volumeSerial = info.dwVolumeSerialNumber;
+        identity.fileIndex = (static_cast<uint64_t>(info.nFileIndexHigh) << 32) | info.nFileIndexLow;
+        identity.fileSize = (static_cast<uint64_t>(info.nFileSizeHigh) << 32) | info.nFileSizeLow;
+        identity.lastWriteTime = (static_cast<uint64_t>(info.ftLastWriteTime.dwHighDateTime) << 32) |
+                                 info.ftLastWriteTime.dwLowDateTime;
+        identity.isDirectory = (info.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) != 0;
+        return true;
+    }
+
+    bool ReadFileAt(OsHandle file, uint64_t offset, void* buffer,
+                    uint32_t size, uint32_t& bytesRead) override
+    {
+        // Positional read melalui OVERLAPPED - tidak perlu SetFilePointer terpisah
+        OVERLAPPED overlapped = { 0 };
+        overlapped.Offset = static_cast<DWORD>(offset & 0xFFFFFFFF);
+        overlapped.OffsetHigh = static_cast<DWORD>(offset >> 32);
+
+        DWORD read = 0;
+        if (!ReadFile(reinterpret_cast<HANDLE>(file), buffer, size, &read, &overlapped)) {
+            if (GetLastError() != ERROR_HANDLE_EOF) {
+                return false;
+            }
+        }
+
+        bytesRead = read;
+        return true;
+    }
+
+    const uint8_t* MapFileView(OsHandle file, uint64_t offset, uint32_t size) override
+    {
+        HANDLE mapping = CreateFileMappingW(reinterpret_cast<HANDLE>(file), NULL, PAGE_READONLY, 0, 0, NULL);
+        if (!mapping) {
+            return nullptr;
+        }
+
+        void* view = MapViewOfFile(mapping, FILE_MAP_READ, static_cast<DWORD>(offset >> 32),
+                                   static_cast<DWORD>(offset & 0xFFFFFFFF), size);
+
+        // View menahan section tetap hidup - handle mapping boleh langsung ditutup
+        CloseHandle(mapping);
+        return static_cast<const uint8_t*>(view);
+    }
+
+    void UnmapFileView(const uint8_t* view, uint32_t) override
+    {
+        if (view) {
+            UnmapViewOfFile(view);
+        }
+    }
+
+    void CloseFile(OsHandle file) override
+    {
+        if (file != OS_INVALID_HANDLE) {
+            CloseHandle(reinterpret_cast<HANDLE>(file));
+        }
+    }
+
+    bool EnumerateDirectory(const std::wstring& directory, std::vector<DirectoryEntry>& entries) override
+    {
+        entries.clear();
+
+        std::wstring pattern = directory;
+        if (!pattern.empty() && pattern.back() != L'\\') {
+            pattern += L'\\';
+        }
+        pattern += L'*';
+
+        // FindExInfoBasic melewati short name 8.3; LARGE_FETCH mengurangi round-trip ke kernel
+        WIN32_FIND_DATAW data;
+        HANDLE find = FindFirstFileExW(ToExtendedLengthPath(pattern).c_str(), FindExInfoBasic, &data,
+                                       FindExSearchNameMatch, NULL, FIND_FIRST_EX_LARGE_FETCH);
+        if (find == INVALID_HANDLE_VALUE) {
+            return false;
+        }
+
+        do {
+            if (wcscmp(data.cFileName, L".") == 0 || wcscmp(data.cFileName, L"..") == 0) {
+                continue;
+            }
+            DirectoryEntry entry;
+            entry.name = data.cFileName;
+            entry.isDirectory = (data.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) != 0;
+            entry.isReparsePoint = (data.dwFileAttributes & FILE_ATTRIBUTE_REPARSE_POINT) != 0;
+            entries.push_back(std::move(entry));
+        } while (FindNextFileW(find, &data));
+
+        DWORD error = GetLastError();
+        FindClose(find);
+        return error == ERROR_NO_MORE_FILES;
+    }
+
+    bool GetEnvironmentValue(const std::wstring& name, std::wstring& value) override
+    {
+        DWORD length = GetEnvironmentVariableW(name.c_str(), NULL, 0);
+        if (length == 0) {
+            return false;
+        }
+
+        std::vector<wchar_t> buffer(length);
+        DWORD copied = GetEnvironmentVariableW(name.c_str(), buffer.data(), length);
+        if (copied == 0 || copied >= length) {
+            return false;
+        }
+
+        value.assign(buffer.data(), copied);
+        return true;
+    }
+
+    bool GetCurrentDirectoryPath(std::wstring& path) override
+    {
+        DWORD length = GetCurrentDirectoryW(0, NULL);
+        if (length == 0) {
+            return false;
+        }
+
+        std::vector<wchar_t> buffer(length);
+        DWORD copied = GetCurrentDirectoryW(length, buffer.data());
+        if (copied == 0 || copied >= length) {
+            return false;
+        }
+
+        path.assign(buffer.data(), copied);
+        return true;
+    }
+};
+
+//==============================================================================
+// WIN32 PROCESS AND TOKEN BACKEND
+//==============================================================================
+
+/**
+ * @brief Backend proses/token berbasis Win32 dan NT API
+ */
+class Win32ProcessBackend : public IProcessBackend {
+public:
+    bool AdjustPrivilege(int privilege, bool threadScope) override
+    {
+        // CRITICAL SECURITY FIX: Validate function pointer before usage
+        if (!pRtlAdjustPrivilege) {
+            SetLastError(ERROR_PROC_NOT_FOUND);
+            return false;
+        }
+
+        // Parameter: privilege, enable=true, thread_privilege, previous_value
+        bool previous = false;
+        NTSTATUS status = pRtlAdjustPrivilege(privilege, true, threadScope, &previous);
+        if (!NT_SUCCESS(status)) {
+            SetLastError(ERROR_PRIVILEGE_NOT_HELD);
+            return false;
+        }
+        return true;
+    }
+
+    bool FindProcessByName(const std::wstring& imageName, uint32_t& processId) override
+    {
+        SmartSnapshotHandle snapshot(CreateToolhelp32Snapshot(TH32CS_SNAPPROCESS, 0));
+        if (!snapshot.IsValid()) {
+            return false;
+        }
+
+        PROCESSENTRY32W entry = { 0 };
+        entry.dwSize = sizeof(entry); // Wajib diisi untuk Process32First/Next
+        if (!Process32FirstW(snapshot.Get(), &entry)) {
+            return false;
+        }
+
+        do {
+            // Bandingkan nama executable (case-insensitive)
+            if (!_wcsicmp(imageName.c_str(), entry.szExeFile)) {
+                processId = entry.th32ProcessID;
+                return true;
+            }
+        } while (Process32NextW(snapshot.Get(), &entry));
+
+        SetLastError(ERROR_NOT_FOUND);
+        return false;
+    }
+
+    bool EnumerateProcesses(std::vector<ProcessEntry>& processes) override
+    {
+        processes.clear();
+        SmartSnapshotHandle snapshot(CreateToolhelp32Snapshot(TH32CS_SNAPPROCESS, 0));
+        if (!snapshot.IsValid()) {
+            return false;
+        }
+
+        PROCESSENTRY32W entry = { 0 };
+        entry.dwSize = sizeof(entry);
+        if (!Process32FirstW(snapshot.Get(), &entry)) {
+            return false;
+        }
+
+        do {
+            ProcessEntry process;
+            process.processId = entry.th32ProcessID;
+            process.parentProcessId = entry.th32ParentProcessID;
+            process.imageName = entry.szExeFile;
+            processes.push_back(process);
+        } while (Process32NextW(snapshot.Get(), &entry));
+
+        // Process32NextW berakhir dengan ERROR_NO_MORE_FILES
+        return GetLastError() == ERROR_NO_MORE_FILES;
+    }
+
+    OsHandle OpenProcessHandle(uint32_t processId) override
+    {
+        // Cukup untuk SetPriorityClass, SetProcessAffinityMask, NtSetInformationProcess,
+        // SetProcessInformation, QueryFullProcessImageNameW, dan WaitForProcessExit
+        HANDLE process = OpenProcess(PROCESS_SET_INFORMATION | PROCESS_QUERY_LIMITED_INFORMATION | SYNCHRONIZE,
+                                     FALSE, processId);
+        return process ? reinterpret_cast<OsHandle>(process) : OS_INVALID_HANDLE;
+    }
+
+    bool QueryProcessImagePath(OsHandle process, std::wstring& path) override
+    {
+        std::vector<wchar_t> buffer(VALIDATION_MAX_PATH);
+        DWORD length = static_cast<DWORD>(buffer.size());
+        if (!QueryFullProcessImageNameW(reinterpret_cast<HANDLE>(process), 0, buffer.data(), &length)) {
+            return false;
+        }
+        path.assign(buffer.data(), length);
+        return true;
+    }
+
+    bool EnumerateSessions(std::vector<SessionEntry>& sessions) override
+    {
+        sessions.clear();
+        if (!pWTSEnumerateSessionsW || !pWTSQuerySessionInformationW || !pWTSFreeMemory) {
+            SetLastError(ERROR_PROC_NOT_FOUND);
+            return false;
+        }
+
+        PWTS_SESSION_INFOW info = NULL;
+        DWORD count = 0;
+        if (!pWTSEnumerateSessionsW(WTS_CURRENT_SERVER_HANDLE, 0, 1, &info, &count)) {
+            return false;
+        }
+
+        for (DWORD i = 0; i < count; i++) {
+            SessionEntry session;
+            session.sessionId = info[i].SessionId;
+            session.active = info[i].State == WTSActive;
+            session.stationName = info[i].pWinStationName ? info[i].pWinStationName : L"";
+
+            // Session tanpa user (misalnya listener) mengembalikan string kosong
+            LPWSTR userName = NULL;
+            DWORD bytes = 0;
+            if (pWTSQuerySessionInformationW(WTS_CURRENT_SERVER_HANDLE, info[i].SessionId, WTSUserName,
+                                             &userName, &bytes) && userName) {
+                session.userName = userName;
+                pWTSFreeMemory(userName);
+            }
+            sessions.push_back(session);
+        }
+        pWTSFreeMemory(info);
+        return true;
+    }
+
+    OsHandle OpenProcessToken(uint32_t processId) override
+    {
+        SmartProcessHandle process(OpenProcess(PROCESS_QUERY_INFORMATION, FALSE, processId));
+        if (!process.IsValid()) {
+            return OS_INVALID_HANDLE;
+        }
+
+        HANDLE token = NULL;
+        if (!::OpenProcessToken(process.Get(), TOKEN_QUERY | TOKEN_DUPLICATE | TOKEN_IMPERSONATE, &token)) {
+            return OS_INVALID_HANDLE;
+        }
+        return reinterpret_cast<OsHandle>(token);
+    }
+
+    bool OpenThreadToken(OsHandle& token) override
+    {
+        // OpenAsSelf: akses diperiksa dengan token proses, bukan identitas yang di-impersonate
+        HANDLE rawToken = NULL;
+        token = OS_INVALID_HANDLE;
+        if (!::OpenThreadToken(GetCurrentThread(), TOKEN_QUERY | TOKEN_IMPERSONATE, TRUE, &rawToken)) {
+            if (GetLastError() != ERROR_NO_TOKEN) {
+                return false;
+            }
+            SetLastError(ERROR_SUCCESS);
+            return true;
+        }
+        token = reinterpret_cast<OsHandle>(rawToken);
+        return true;
+    }
+
+    bool ImpersonateToken(OsHandle token) override
+    {
+        return ImpersonateLoggedOnUser(reinterpret_cast<HANDLE>(token)) != FALSE;
+    }
+
+    void RevertImpersonation() override
+    {
+        RevertToSelf();
+    }
+
+    OsHandle LogonTrustedInstaller(bool useThreadToken) override
+    {
+        // CRITICAL SECURITY FIX: Validate LogonUserExExW function pointer sebelum usage
+        if (!pLogonUserExExW) {
+            SetLastError(ERROR_PROC_NOT_FOUND);
+            return OS_INVALID_HANDLE;
+        }
+
+        // Token saat ini: thread (impersonating winlogon) atau process
+        HANDLE rawToken = NULL;
+        BOOL opened = useThreadToken
+            ? OpenThreadToken(GetCurrentThread(), TOKEN_QUERY, FALSE, &rawToken)
+            : ::OpenProcessToken(GetCurrentProcess(), TOKEN_QUERY, &rawToken);
+        if (!opened) {
+            return OS_INVALID_HANDLE;
+        }
+        SmartTokenHandle currentToken(rawToken);
+
+        // Query ukuran buffer token groups
+        DWORD tokenGroupsSize = 0;
+        if (!GetTokenInformation(currentToken.Get(), TokenGroups, NULL, 0, &tokenGroupsSize) &&
+            GetLastError() != ERROR_INSUFFICIENT_BUFFER) {
+            return OS_INVALID_HANDLE;
+        }
+
+        // BUG FIX: Comprehensive buffer size validation to prevent integer overflow attacks
+        if (tokenGroupsSize < sizeof(TOKEN_GROUPS) || tokenGroupsSize > 65536) {
+            SetLastError(ERROR_INVALID_DATA);
+            return OS_INVALID_HANDLE;
+        }
+
+        // Buffer sebesar yang diminta GetTokenInformation (SID berada setelah array)
+        SmartLocalMemory<BYTE> tokenGroupsMemory;
+        if (!tokenGroupsMemory.Allocate(tokenGroupsSize)) {
+            return OS_INVALID_HANDLE;
+        }
+        PTOKEN_GROUPS tokenGroups = reinterpret_cast<PTOKEN_GROUPS>(tokenGroupsMemory.Get());
+        if (!GetTokenInformation(currentToken.Get(), TokenGroups, tokenGroups, tokenGroupsSize, &tokenGroupsSize) ||
+            tokenGroups->GroupCount == 0) {
+            return OS_INVALID_HANDLE;
+        }
+
+        // TRUSTED_INSTALLER_SID = "S-1-5-80-956008885-3418522649-1831038044-1853292631-2271478464"
+        PSID rawSid = NULL;
+        if (!ConvertStringSidToSidA(TRUSTED_INSTALLER_SID, &rawSid)) {
+            return OS_INVALID_HANDLE;
+        }
+
+        // Timpa group terakhir dengan TI SID
+        DWORD lastGroupIndex = tokenGroups->GroupCount - 1;
+        tokenGroups->Groups[lastGroupIndex].Sid = rawSid;
+        tokenGroups->Groups[lastGroupIndex].Attributes = SE_GROUP_OWNER | SE_GROUP_ENABLED;
+
+        // LogonUserExExW dengan custom groups membuat token SYSTEM + Trusted Installer
+        HANDLE trustedInstallerToken = NULL;
+        BOOL logonSuccess = pLogonUserExExW(
+            (LPWSTR)L"SYSTEM",                    // Username: SYSTEM
+            (LPWSTR)L"NT_AUTHORITY",              // Domain: NT AUTHORITY
+            NULL,                                 // Password: NULL (service logon)
+            LOGON32_LOGON_SERVICE,                // Logon type: Service
+            LOGON32_PROVIDER_WINNT50,             // Provider: WinNT 5.0
+            tokenGroups,                          // Custom token groups dengan TI SID
+            &trustedInstallerToken,               // Output: TI token handle
+            NULL, NULL, NULL, NULL                // Parameter lainnya tidak digunakan
+        );
+        DWORD logonError = GetLastError();
+        LocalFree(rawSid); // SID dari ConvertStringSidToSid dialokasikan dengan LocalAlloc
+        SetLastError(logonError);
+
+        return logonSuccess ? reinterpret_cast<OsHandle>(trustedInstallerToken) : OS_INVALID_HANDLE;
+    }
+
+    bool CreateProcessWithToken(OsHandle token, const ProcessLaunchRequest& request, uint32_t& processId,
+                                OsHandle* process) override
+    {
+        // Seclogon selalu membuat proses di session pemanggil
+        if (request.sessionId != PROCESS_SESSION_CALLER) {
+            SetLastError(ERROR_NOT_SUPPORTED);
+            return false;
+        }
+
+        STARTUPINFOW si = { 0 };
+        si.cb = sizeof(si);
+        std::wstring desktop = request.desktop;
+        si.lpDesktop = desktop.empty() ? NULL : &desktop[0];
+        si.dwFlags = request.startupFlags;     // Misalnya STARTF_USESHOWWINDOW untuk /console:hidden
+        si.wShowWindow = request.showWindow;
+
+        // BUG FIX: lpCommandLine boleh dimodifikasi oleh API - gunakan buffer milik sendiri
+        std::wstring commandLine = request.commandLine;
+        PROCESS_INFORMATION pi = { 0 };
+        BOOL success = CreateProcessWithTokenW(
+            reinterpret_cast<HANDLE>(token),  // Token untuk menjalankan proses
+            0,                                // Logon flags (tidak digunakan)
+            request.applicationName.empty() ? NULL : request.applicationName.c_str(),
+            &commandLine[0],                  // Command line (quoted path)
+            request.creationFlags,            // Priority + creation flags
+            NULL,                             // Environment (inherit dari parent)
+            NULL,                             // Current directory (inherit dari parent)
+            &si,
+            &pi
+        );
+        if (!success) {
+            return false;
+        }
+
+        // Tanpa process, proses berjalan independen - handle tidak dibutuhkan
+        processId = pi.dwProcessId;
+        if (process) {
+            *process = reinterpret_cast<OsHandle>(pi.hProcess);
+        } else {
+            CloseHandle(pi.hProcess);
+        }
+        CloseHandle(pi.hThread);
+        return true;
+    }
+
+    bool CreateProcessAsUser(OsHandle token, const ProcessLaunchRequest& request, uint32_t& processId,
+                             OsHandle* process) override
+    {
+        // Token logon service berada di session 0; proses harus muncul di session pemanggil
+        // atau session yang diminta (/sessions)
+        DWORD sessionId = request.sessionId;
+        if (sessionId == PROCESS_SESSION_CALLER && !ProcessIdToSessionId(GetCurrentProcessId(), &sessionId)) {
+            return false;
+        }
+
+        HANDLE rawPrimary = NULL;
+        if (!DuplicateTokenEx(reinterpret_cast<HANDLE>(token),
+                              TOKEN_ASSIGN_PRIMARY | TOKEN_DUPLICATE | TOKEN_QUERY |
+                              TOKEN_ADJUST_DEFAULT | TOKEN_ADJUST_SESSIONID,
+                              NULL, SecurityImpersonation, TokenPrimary, &rawPrimary)) {
+            return false;
+        }
+        SmartTokenHandle primary(rawPrimary);
+
+        // Memerlukan SeTcbPrivilege di token pemanggil
+        if (!SetTokenInformation(primary.Get(), TokenSessionId, &sessionId, sizeof(sessionId))) {
+            return false;
+        }
+
+        STARTUPINFOW si = { 0 };
+        si.cb = sizeof(si);
+        std::wstring desktop = request.desktop;
+        si.lpDesktop = desktop.empty() ? NULL : &desktop[0];
+        si.dwFlags = request.startupFlags;
+        si.wShowWindow = request.showWindow;
+
+        // lpCommandLine boleh dimodifikasi oleh API - gunakan buffer milik sendiri
+        std::wstring commandLine = request.commandLine;
+        PROCESS_INFORMATION pi = { 0 };
+        BOOL success = CreateProcessAsUserW(
+            primary.Get(),                    // Primary token di session tujuan
+            request.applicationName.empty() ? NULL : request.applicationName.c_str(),
+            &commandLine[0],                  // Command line (quoted path)
+            NULL, NULL,                       // Security attributes proses/thread default
+            FALSE,                            // Tanpa pewarisan handle
+            request.creationFlags,            // Priority + creation flags
+            NULL,                             // Environment (inherit dari parent)
+            NULL,                             // Current directory (inherit dari parent)
+            &si,
+            &pi
+        );
+        if (!success) {
+            // Pertahankan error CreateProcessAsUserW melewati CloseHandle token primary
+            DWORD error = GetLastError();
+            primary.Reset();
+            SetLastError(error);
+            return false;
+        }
+
+        processId = pi.dwProcessId;
+        if (process) {
+            *process = reinterpret_cast<OsHandle>(pi.hProcess);
+        } else {
+            CloseHandle(pi.hProcess);
+        }
+        CloseHandle(pi.hThread);
+        return true;
+    }
+
+    bool WaitForProcessExit(OsHandle process, uint32_t timeoutMs, uint32_t& exitCode) override
+    {
+        DWORD wait = WaitForSingleObject(reinterpret_cast<HANDLE>(process), timeoutMs);
+        if (wait == WAIT_TIMEOUT) {
+            SetLastError(WAIT_TIMEOUT);
+            return false;
+        }
+        if (wait != WAIT_OBJECT_0) {
+            return false;
+        }
+
+        DWORD code = 0;
+        if (!GetExitCodeProcess(reinterpret_cast<HANDLE>(process), &code)) {
+            return false;
+        }
+        exitCode = code;
+        return true;
+    }
+
+    bool WaitForAnyProcessExit(const std::vector<OsHandle>& processes, uint32_t timeoutMs, size_t& index,
+                               uint32_t& exitCode) override
+    {
+        if (processes.empty() || processes.size() > MAXIMUM_WAIT_OBJECTS) {
+            SetLastError(ERROR_INVALID_PARAMETER);
+            return false;
+        }
+
+        HANDLE handles[MAXIMUM_WAIT_OBJECTS];
+        for (size_t i = 0; i < processes.size(); i++) {
+            handles[i] = reinterpret_cast<HANDLE>(processes[i]);
+        }
+        DWORD wait = WaitForMultipleObjects(static_cast<DWORD>(processes.size()), handles, FALSE, timeoutMs);
+        if (wait == WAIT_TIMEOUT) {
+            SetLastError(WAIT_TIMEOUT);
+            return false;
+        }
+        if (wait >= WAIT_OBJECT_0 + processes.size()) {
+            return false;
+        }
+
+        DWORD code = 0;
+        index = wait - WAIT_OBJECT_0;
+        if (!GetExitCodeProcess(handles[index], &code)) {
+            return false;
+        }
+        exitCode = code;
+        return true;
+    }
+
+    bool ResumeProcess(OsHandle process) override
+    {
+        if (!pNtResumeProcess) {
+            SetLastError(ERROR_PROC_NOT_FOUND);
+            return false;
+        }
+        return SucceededNt(pNtResumeProcess(reinterpret_cast<HANDLE>(process)));
+    }
+
+    bool TerminateProcess(OsHandle process, uint32_t exitCode) override
+    {
+        return ::TerminateProcess(reinterpret_cast<HANDLE>(process), exitCode) != FALSE;
+    }
+
+    bool SetProcessSetting(OsHandle process, ProcessSetting setting, uint64_t value) override
+    {
+        HANDLE handle = reinterpret_cast<HANDLE>(process);
+        switch (setting) {
+        case PROCESS_SETTING_PRIORITY_CLASS:
+            return SetPriorityClass(handle, static_cast<DWORD>(value)) != FALSE;
+        case PROCESS_SETTING_AFFINITY:
+            return SetProcessAffinityMask(handle, static_cast<DWORD_PTR>(value)) != FALSE;
+        case PROCESS_SETTING_IO_PRIORITY: {
+            if (!pNtSetInformationProcess) {
+                SetLastError(ERROR_PROC_NOT_FOUND);
+                return false;
+            }
+            ULONG ioPriority = static_cast<ULONG>(value);
+            return SucceededNt(pNtSetInformationProcess(handle, PROCESS_IO_PRIORITY_CLASS, &ioPriority,
+                                                        sizeof(ioPriority)));
+        }
+        case PROCESS_SETTING_MEMORY_PRIORITY: {
+            if (!pSetProcessInformation) {
+                SetLastError(ERROR_NOT_SUPPORTED); // Sebelum Windows 8
+                return false;
+            }
+            ULONG memoryPriority = static_cast<ULONG>(value); // MEMORY_PRIORITY_INFORMATION
+            return pSetProcessInformation(handle, PROCESS_MEMORY_PRIORITY_CLASS, &memoryPriority,
+                                          sizeof(memoryPriority)) != FALSE;
+        }
+        }
+        SetLastError(ERROR_INVALID_PARAMETER);
+        return false;
+    }
+
+    OsHandle CreateJob(const ProcessJobLimits& limits) override
+    {
+        SmartHandle job(CreateJobObjectW(NULL, NULL));
+        if (!job.IsValid()) {
+            return OS_INVALID_HANDLE;
+        }
+
+        JOBOBJECT_EXTENDED_LIMIT_INFORMATION info = { 0 };
+        if (limits.processMemoryLimit > 0) {
+            info.BasicLimitInformation.LimitFlags |= JOB_OBJECT_LIMIT_PROCESS_MEMORY;
+            info.ProcessMemoryLimit = static_cast<SIZE_T>(limits.processMemoryLimit);
+        }
+        if (limits.activeProcessLimit > 0) {
+            info.BasicLimitInformation.LimitFlags |= JOB_OBJECT_LIMIT_ACTIVE_PROCESS;
+            info.BasicLimitInformation.ActiveProcessLimit = limits.activeProcessLimit;
+        }
+        if (info.BasicLimitInformation.LimitFlags != 0 &&
+            !SetInformationJobObject(job.Get(), JobObjectExtendedLimitInformation, &info, sizeof(info))) {
+            DWORD error = GetLastError();
+            job.Reset();
+            SetLastError(error);
+            return OS_INVALID_HANDLE;
+        }
+        return reinterpret_cast<OsHandle>(job.Release());
+    }
+
+    bool AssignProcessToJob(OsHandle job, OsHandle process) override
+    {
+        return AssignProcessToJobObject(reinterpret_cast<HANDLE>(job), reinterpret_cast<HANDLE>(process)) != FALSE;
+    }
+
+    bool IsPrivilegeEnabled(int privilege) override
+    {
+        HANDLE rawToken = NULL;
+        if (!::OpenProcessToken(GetCurrentProcess(), TOKEN_QUERY, &rawToken)) {
+            return false;
+        }
+        SmartTokenHandle token(rawToken);
+
+        DWORD privilegesSize = 0;
+        if (!GetTokenInformation(token.Get(), TokenPrivileges, NULL, 0, &privilegesSize) &&
+            GetLastError() != ERROR_INSUFFICIENT_BUFFER) {
+            return false;
+        }
+
+        // Validate buffer size to prevent memory exhaustion attacks
+        const DWORD MAX_PRIVILEGES_SIZE = 1024 * 1024;
+        if (privilegesSize < sizeof(TOKEN_PRIVILEGES) || privilegesSize > MAX_PRIVILEGES_SIZE) {
+            return false;
+        }
+
+        SmartLocalMemory<BYTE> privilegesMemory;
+        if (!privilegesMemory.Allocate(privilegesSize)) {
+            return false;
+        }
+        PTOKEN_PRIVILEGES privileges = reinterpret_cast<PTOKEN_PRIVILEGES>(privilegesMemory.Get());
+        if (!GetTokenInformation(token.Get(), TokenPrivileges, privileges, privilegesSize, &privilegesSize)) {
+            return false;
+        }
+
+        for (DWORD i = 0; i < privileges->PrivilegeCount; i++) {
+            const LUID_AND_ATTRIBUTES& entry = privileges->Privileges[i];
+            if (entry.Luid.HighPart == 0 && entry.Luid.LowPart == static_cast<DWORD>(privilege)) {
+                return (entry.Attributes & SE_PRIVILEGE_ENABLED) != 0;
+            }
+        }
+        return false;
+    }
+
+    bool IsElevatedAdministrator() override
+    {
+        // S-1-5-32-544 = Built-in Administrators
+        SID_IDENTIFIER_AUTHORITY ntAuthority = SECURITY_NT_AUTHORITY;
+        PSID administratorsGroup = NULL;
+        if (!AllocateAndInitializeSid(&ntAuthority, 2,
+            SECURITY_BUILTIN_DOMAIN_RID, DOMAIN_ALIAS_RID_ADMINS,
+            0, 0, 0, 0, 0, 0, &administratorsGroup)) {
+            return false;
+        }
+
+        // CheckTokenMembership mengembalikan BOOL (bukan kode error)
+        BOOL isMember = FALSE;
+        if (!CheckTokenMembership(NULL, administratorsGroup, &isMember)) {
+            isMember = FALSE;
+        }
+        FreeSid(administratorsGroup);
+        if (!isMember) {
+            return false;
+        }
+
+        // Admin tanpa UAC elevation hanya memegang filtered token
+        HANDLE rawToken = NULL;
+        if (!::OpenProcessToken(GetCurrentProcess(), TOKEN_QUERY, &rawToken)) {
+            return false;
+        }
+        SmartTokenHandle token(rawToken);
+
+        TOKEN_ELEVATION elevation = { 0 };
+        DWORD size = 0;
+        return GetTokenInformation(token.Get(), TokenElevation, &elevation, sizeof(elevation), &size) &&
+               elevation.TokenIsElevated;
+    }
+
+    bool GetModuleFilePath(std::wstring& path) override
+    {
+        std::vector<wchar_t> buffer(MAX_PATH);
+        for (;;) {
+            DWORD length = GetModuleFileNameW(NULL, buffer.data(), static_cast<DWORD>(buffer.size()));
+            if (length == 0) {
+                return false;
+            }
+            if (length < buffer.size()) {
+                path.assign(buffer.data(), length);
+                return true;
+            }
+            if (buffer.size() >= VALIDATION_MAX_PATH) {
+                return false;
+            }
+            buffer.resize(buffer.size() * 2); // Path terpotong - ulangi dengan buffer lebih besar
+        }
+    }
+
+    void CloseObject(OsHandle handle) override
+    {
+        if (handle != OS_INVALID_HANDLE) {
+            CloseHandle(reinterpret_cast<HANDLE>(handle));
+        }
+    }
+
+    uint32_t GetLastErrorCode() override
+    {
+        return GetLastError();
+    }
+
+    void SetLastErrorCode(uint32_t error) override
+    {
+        SetLastError(error);
+    }
+
+private:
+    /** @brief PROCESSINFOCLASS ProcessIoPriority (NtSetInformationProcess) */
+    static const ULONG PROCESS_IO_PRIORITY_CLASS = 33;
+
+    /** @brief PROCESS_INFORMATION_CLASS ProcessMemoryPriority (SetProcessInformation) */
+    static const int PROCESS_MEMORY_PRIORITY_CLASS = 0;
+
+    /** @brief NTSTATUS -> true, atau SetLastError dengan kode Win32 padanannya */
+    static bool SucceededNt(NTSTATUS status)
+    {
+        if (NT_SUCCESS(status)) {
+            return true;
+        }
+        SetLastError(pRtlNtStatusToDosError ? pRtlNtStatusToDosError(status) : ERROR_ACCESS_DENIED);
+        return false;
+    }
+};
+
+//==============================================================================
+// WIN32 FILE OPERATION BACKEND
+//==============================================================================
+
+#ifndef COPY_FILE_NO_BUFFERING
+#define COPY_FILE_NO_BUFFERING 0x00001000 /**< Vista+: I/O unbuffered untuk file besar */
+#endif
+
+/**
+ * @brief Backend operasi file berbasis Win32 API (copy/move/delete untuk /fileops,
+ *        owner/DACL untuk /aclreset)
+ *
+ * Semua path melewati ToExtendedLengthPath sehingga pohon direktori yang
+ * dalam tidak terpotong di MAX_PATH. GetLastError sudah per thread.
+ */
+class Win32FileOperationBackend : public IFileOperationBackend {
+private:
+    /** @brief Melepas FILE_ATTRIBUTE_READONLY jika itu penyebab ERROR_ACCESS_DENIED */
+    static bool ClearReadOnly(const std::wstring& extendedPath)
+    {
+        DWORD attributes = GetFileAttributesW(extendedPath.c_str());
+        if (attributes == INVALID_FILE_ATTRIBUTES || !(attributes & FILE_ATTRIBUTE_READONLY)) {
+            SetLastError(ERROR_ACCESS_DENIED); // Pertahankan error asli
+            return false;
+        }
+        return SetFileAttributesW(extendedPath.c_str(), attributes & ~FILE_ATTRIBUTE_READONLY) != FALSE;
+    }
+
+public:
+    bool ListDirectory(const std::wstring& directory, std::vector<FileOperationEntry>& entries) override
+    {
+        entries.clear();
+
+        std::wstring pattern = directory;
+        if (!pattern.empty() && pattern.back() != L'\\') {
+            pattern += L'\\';
+        }
+        pattern += L'*';
+
+        WIN32_FIND_DATAW data;
+        HANDLE find = FindFirstFileExW(ToExtendedLengthPath(pattern).c_str(), FindExInfoBasic, &data,
+                                       FindExSearchNameMatch, NULL, FIND_FIRST_EX_LARGE_FETCH);
+        if (find == INVALID_HANDLE_VALUE) {
+            return false;
+        }
+
+        do {
+            if (wcscmp(data.cFileName, L".") == 0 || wcscmp(data.cFileName, L"..") == 0) {
+                continue;
+            }
+            FileOperationEntry entry;
+            entry.name = data.cFileName;
+            entry.isDirectory = (data.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) != 0;
+            entry.isReparsePoint = (data.dwFileAttributes & FILE_ATTRIBUTE_REPARSE_POINT) != 0;
+            entry.size = entry.isDirectory ? 0 :
+                (static_cast<uint64_t>(data.nFileSizeHigh) << 32) | data.nFileSizeLow;
+            entries.push_back(std::move(entry));
+        } while (FindNextFileW(find, &data));
+
+        DWORD error = GetLastError();
+        FindClose(find);
+        if (error != ERROR_NO_MORE_FILES) {
+            SetLastError(error);
+            return false;
+        }
+        return true;
+    }
+
+    bool QueryPath(const std::wstring& path, FileOperationEntry& entry) override
+    {
+        WIN32_FILE_ATTRIBUTE_DATA data;
+        if (!GetFileAttributesExW(ToExtendedLengthPath(path).c_str(), GetFileExInfoStandard, &data)) {
+            return false;
+        }
+        entry.name.clear();
+        entry.isDirectory = (data.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) != 0;
+        entry.isReparsePoint = (data.dwFileAttributes & FILE_ATTRIBUTE_REPARSE_POINT) != 0;
+        entry.size = entry.isDirectory ? 0 :
+            (static_cast<uint64_t>(data.nFileSizeHigh) << 32) | data.nFileSizeLow;
+        return true;
+    }
+
+    bool MakeDirectory(const std::wstring& path) override
+    {
+        std::wstring extended = ToExtendedLengthPath(path);
+        if (CreateDirectoryW(extended.c_str(), NULL)) {
+            return true;
+        }
+        if (GetLastError() != ERROR_ALREADY_EXISTS) {
+            return false;
+        }
+
+        // Sudah ada: berhasil hanya jika berupa direktori
+        DWORD attributes = GetFileAttributesW(extended.c_str());
+        if (attributes == INVALID_FILE_ATTRIBUTES || !(attributes & FILE_ATTRIBUTE_DIRECTORY)) {
+            SetLastError(ERROR_ALREADY_EXISTS);
+            return false;
+        }
+        return true;
+    }
+
+    bool CopyFileContents(const std::wstring& source, const std::wstring& destination, bool unbuffered) override
+    {
+        std::wstring extendedSource = ToExtendedLengthPath(source);
+        std::wstring extendedDestination = ToExtendedLengthPath(destination);
+        DWORD flags = unbuffered ? COPY_FILE_NO_BUFFERING : 0;
+
+        if (CopyFileExW(extendedSource.c_str(), extendedDestination.c_str(), NULL, NULL, NULL, flags)) {
+            return true;
+        }
+        if (GetLastError() != ERROR_ACCESS_DENIED || !ClearReadOnly(extendedDestination)) {
+            return false;
+        }
+        return CopyFileExW(extendedSource.c_str(), extendedDestination.c_str(), NULL, NULL, NULL, flags) != FALSE;
+    }
+
+    bool MovePath(const std::wstring& source, const std::wstring& destination) override
+    {
+        return MoveFileExW(ToExtendedLengthPath(source).c_str(), ToExtendedLengthPath(destination).c_str(),
+                           MOVEFILE_REPLACE_EXISTING | MOVEFILE_COPY_ALLOWED) != FALSE;
+    }
+
+    bool DeletePath(const std::wstring& path, bool isDirectory) override
+    {
+        std::wstring extended = ToExtendedLengthPath(path);
+        BOOL deleted = isDirectory ? RemoveDirectoryW(extended.c_str()) : DeleteFileW(extended.c_str());
+        if (deleted) {
+            return true;
+        }
+        if (GetLastError() != ERROR_ACCESS_DENIED || !ClearReadOnly(extended)) {
+            return false;
+        }
+        return (isDirectory ? RemoveDirectoryW(extended.c_str()) : DeleteFileW(extended.c_str())) != FALSE;
+    }
+
+    bool BuildSecurityDescriptor(const std::wstring& sddl, std::vector<uint8_t>& descriptor,
+                                 std::wstring& normalized) override
+    {
+        descriptor.clear();
+        PSECURITY_DESCRIPTOR converted = NULL;
+        ULONG size = 0;
+        if (!ConvertStringSecurityDescriptorToSecurityDescriptorW(sddl.c_str(), SDDL_REVISION_1, &converted, &size)) {
+            return false;
+        }
+
+        // NTFS hanya menyimpan flag DACL auto-inherited jika AUTO_INHERIT_REQ ikut di-set
+        SECURITY_DESCRIPTOR_CONTROL control = 0;
+        DWORD revision = 0;
+        if (GetSecurityDescriptorControl(converted, &control, &revision) && (control & SE_DACL_AUTO_INHERITED)) {
+            SetSecurityDescriptorControl(converted, SE_DACL_AUTO_INHERIT_REQ, SE_DACL_AUTO_INHERIT_REQ);
+        }
+
+        LPWSTR text = NULL;
+        BOOL formatted = ConvertSecurityDescriptorToStringSecurityDescriptorW(converted, SDDL_REVISION_1,
+            OWNER_SECURITY_INFORMATION | DACL_SECURITY_INFORMATION, &text, NULL);
+        DWORD error = GetLastError();
+        if (formatted) {
+            normalized = text;
+            LocalFree(text);
+            const uint8_t* bytes = static_cast<const uint8_t*>(converted);
+            descriptor.assign(bytes, bytes + size);
+        }
+        LocalFree(converted);
+        SetLastError(error);
+        return formatted != FALSE;
+    }
+
+    bool ReadSecurity(const std::wstring& path, std::wstring& sddl) override
+    {
+        const SECURITY_INFORMATION information = OWNER_SECURITY_INFORMATION | DACL_SECURITY_INFORMATION;
+        std::wstring extended = ToExtendedLengthPath(path);
+
+        // Buffer per thread: descriptor umumnya < 1 KB, diperbesar sekali jika kurang
+        static thread_local std::vector<uint8_t> buffer(1024);
+        DWORD needed = 0;
+        while (!GetFileSecurityW(extended.c_str(), information, buffer.data(),
+                                 static_cast<DWORD>(buffer.size()), &needed)) {
+            if (GetLastError() != ERROR_INSUFFICIENT_BUFFER || needed <= buffer.size()) {
+                return false;
+            }
+            buffer.resize(needed);
+        }
+
+        LPWSTR text = NULL;
+        if (!ConvertSecurityDescriptorToStringSecurityDescriptorW(buffer.data(), SDDL_REVISION_1, information,
+                                                                  &text, NULL)) {
+            return false;
+        }
+        sddl = text;
+        LocalFree(text);
+        return true;
+    }
+
+    bool WriteSecurity(const std::wstring& path, const std::vector<uint8_t>& descriptor) override
+    {
+        if (descriptor.empty()) {
+            SetLastError(ERROR_INVALID_PARAMETER);
+            return false;
+        }
+        PSECURITY_DESCRIPTOR security = const_cast<uint8_t*>(descriptor.data());
+        return SetFileSecurityW(ToExtendedLengthPath(path).c_str(),
+                                OWNER_SECURITY_INFORMATION | DACL_SECURITY_INFORMATION, security) != FALSE;
+    }
+
+    bool ReadFileContents(const std::wstring& path, uint32_t maxSize, std::string& contents) override
+    {
+        contents.clear();
+        SmartHandle file(CreateFileW(ToExtendedLengthPath(path).c_str(), GENERIC_READ, FILE_SHARE_READ, NULL,
+                                     OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL));
+        if (!file.IsValid()) {
+            return false;
+        }
+
+        LARGE_INTEGER size;
+        if (!GetFileSizeEx(file.Get(), &size)) {
+            return false;
+        }
+        if (size.QuadPart > maxSize) {
+            SetLastError(ERROR_FILE_TOO_LARGE);
+            return false;
+        }
+
+        contents.resize(static_cast<size_t>(size.QuadPart));
+        DWORD offset = 0;
+        while (offset < contents.size()) {
+            DWORD read = 0;
+            if (!ReadFile(file.Get(), &contents[offset], static_cast<DWORD>(contents.size()) - offset, &read, NULL)) {
+                return false;
+            }
+            if (read == 0) {
+                SetLastError(ERROR_HANDLE_EOF); // File menyusut saat dibaca
+                return false;
+            }
+            offset += read;
+        }
+        return true;
+    }
+
+    bool WriteFileContents(const std::wstring& path, const std::string& contents) override
+    {
+        SmartHandle file(CreateFileW(ToExtendedLengthPath(path).c_str(), GENERIC_WRITE, 0, NULL,
+                                     CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL));
+        if (!file.IsValid()) {
+            return false;
+        }
+
+        size_t offset = 0;
+        while (offset < contents.size()) {
+            DWORD written = 0;
+            DWORD chunk = static_cast<DWORD>(std::min<size_t>(contents.size() - offset, 1024 * 1024));
+            if (!WriteFile(file.Get(), contents.data() + offset, chunk, &written, NULL) || written == 0) {
+                return false;
+            }
+            offset += written;
+        }
+        return FlushFileBuffers(file.Get()) != FALSE;
+    }
+
+    uint32_t GetLastErrorCode() override
+    {
+        return GetLastError();
+    }
+};
+
+//==============================================================================
+// WIN32 REGISTRY BACKEND
+//==============================================================================
+
+/**
+ * @brief Backend registry berbasis Win32 API (/regimport)
+ *
+ * Fungsi Reg* mengembalikan kode error alih-alih memanggil SetLastError;
+ * kode tersebut disalin ke GetLastError agar GetLastErrorCode sama dengan
+ * backend lain. HKEY_CURRENT_USER dibuka dengan RegOpenCurrentUser sehingga
+ * mengikuti token yang di-impersonate, bukan user proses yang di-cache oleh
+ * predefined handle.
+ */
+class Win32RegistryBackend : public IRegistryBackend {
+private:
+    /** @brief Akses dasar setiap key: view 64-bit seperti regedit.exe */
+    static const REGSAM kView = KEY_WOW64_64KEY;
+
+    static bool Check(LONG result)
+    {
+        if (result != ERROR_SUCCESS) {
+            SetLastError(static_cast<DWORD>(result));
+            return false;
+        }
+        return true;
+    }
+
+    /**
+     * @brief Handle root; CURRENT_USER dibuka per panggilan (owned = true, ditutup pemanggil)
+     */
+    static bool OpenRoot(RegistryRoot root, HKEY& key, bool& owned)
+    {
+        owned = false;
+        switch (root) {
+        case REGISTRY_ROOT_CLASSES_ROOT: key = HKEY_CLASSES_ROOT; return true;
+        case REGISTRY_ROOT_LOCAL_MACHINE: key = HKEY_LOCAL_MACHINE; return true;
+        case REGISTRY_ROOT_USERS: key = HKEY_USERS; return true;
+        case REGISTRY_ROOT_CURRENT_CONFIG: key = HKEY_CURRENT_CONFIG; return true;
+        case REGISTRY_ROOT_CURRENT_USER:
+            owned = true;
+            return Check(RegOpenCurrentUser(KEY_READ, &key));
+        }
+        SetLastError(ERROR_INVALID_PARAMETER);
+        return false;
+    }
+
+    static OsHandle ToHandle(HKEY key) { return reinterpret_cast<OsHandle>(key); }
+    static HKEY FromHandle(OsHandle key) { return reinterpret_cast<HKEY>(key); }
+
+public:
+    OsHandle OpenKey(RegistryRoot root, const std::wstring& path, bool writable) override
+    {
+        HKEY base = NULL;
+        bool owned = false;
+        if (!OpenRoot(root, base, owned)) {
+            return OS_INVALID_HANDLE;
+        }
+
+        HKEY key = NULL;
+        REGSAM access = KEY_QUERY_VALUE | (writable ? KEY_SET_VALUE : 0) | kView;
+        bool opened = Check(RegOpenKeyExW(base, path.c_str(), 0, access, &key));
+        if (owned) {
+            DWORD error = GetLastError();
+            RegCloseKey(base);
+            SetLastError(error);
+        }
+        return opened ? ToHandle(key) : OS_INVALID_HANDLE;
+    }
+
+    OsHandle CreateKey(RegistryRoot root, const std::wstring& path, bool& created) override
+    {
+        created = false;
+        HKEY base = NULL;
+        bool owned = false;
+        if (!OpenRoot(root, base, owned)) {
+            return OS_INVALID_HANDLE;
+        }
+
+        HKEY key = NULL;
+        DWORD disposition = 0;
+        bool opened = Check(RegCreateKeyExW(base, path.c_str(), 0, NULL, REG_OPTION_NON_VOLATILE,
+                                            KEY_QUERY_VALUE | KEY_SET_VALUE | kView, NULL, &key, &disposition));
+        if (owned) {
+            DWORD error = GetLastError();
+            RegCloseKey(base);
+            SetLastError(error);
+        }
+        if (!opened) {
+            return OS_INVALID_HANDLE;
+        }
+        created = (disposition == REG_CREATED_NEW_KEY);
+        return ToHandle(key);
+    }
+
+    bool QueryValue(OsHandle key, const std::wstring& name, uint32_t& type, std::vector<uint8_t>& data) override
+    {
+        // Buffer pemanggil dipakai ulang; ERROR_MORE_DATA memberi ukuran yang dibutuhkan
+        if (data.capacity() < 256) data.reserve(256);
+        data.resize(data.capacity());
+        while (true) {
+            DWORD valueType = 0;
+            DWORD size = static_cast<DWORD>(data.size());
+            LONG result = RegQueryValueExW(FromHandle(key), name.c_str(), NULL, &valueType, data.data(), &size);
+            if (result == ERROR_SUCCESS) {
+                data.resize(size);
+                type = valueType;
+                return true;
+            }
+            if (result != ERROR_MORE_DATA) {
+                data.clear();
+                return Check(result);
+            }
+            data.resize(size);
+        }
+    }
+
+    bool SetValue(OsHandle key, const std::wstring& name, uint32_t type, const std::vector<uint8_t>& data) override
+    {
+        return Check(RegSetValueExW(FromHandle(key), name.c_str(), 0, type,
+                                    data.empty() ? NULL : data.data(), static_cast<DWORD>(data.size())));
+    }
+
+    bool DeleteValue(OsHandle key, const std::wstring& name) override
+    {
+        return Check(RegDeleteValueW(FromHandle(key), name.c_str()));
+    }
+
+    bool DeleteKeyTree(RegistryRoot root, const std::wstring& path) override
+    {
+        if (path.empty()) {
+            SetLastError(ERROR_ACCESS_DENIED);
+            return false;
+        }
+
+        HKEY base = NULL;
+        bool owned = false;
+        if (!OpenRoot(root, base, owned)) {
+            return false;
+        }
+
+        // Kosongkan lewat handle di view 64-bit, lalu hapus key-nya sendiri
+        HKEY key = NULL;
+        bool deleted = Check(RegOpenKeyExW(base, path.c_str(), 0,
+                                           DELETE | KEY_ENUMERATE_SUB_KEYS | KEY_QUERY_VALUE | KEY_SET_VALUE | kView,
+                                           &key));
+        if (deleted) {
+            deleted = Check(RegDeleteTreeW(key, NULL));
+            RegCloseKey(key);
+        }
+        if (deleted) {
+            deleted = Check(RegDeleteKeyExW(base, path.c_str(), kView, 0));
+        }
+        if (owned) {
+            DWORD error = GetLastError();
+            RegCloseKey(base);
+            SetLastError(error);
+        }
+        return deleted;
+    }
+
+    void CloseKey(OsHandle key) override
+    {
+        if (key != OS_INVALID_HANDLE) {
+            RegCloseKey(FromHandle(key));
+        }
+    }
+
+    uint32_t GetLastErrorCode() override
+    {
+        return GetLastError();
+    }
+};
+
+//==============================================================================
+// WIN32 SCRIPT HOST BACKEND
+//==============================================================================
+
+/**
+ * @brief Backend script host berbasis pipe + CreateProcessWithTokenW (/scripthost)
+ *
+ * stdout dan stderr host memakai satu named pipe overlapped (sisi server
+ * dibaca RasTI) agar ReadHostOutput dapat memakai timeout; stdin memakai
+ * anonymous pipe biasa. Proses dibuat suspended lalu dimasukkan ke job
+ * object sehingga host yang timeout dapat di-terminate beserta proses
+ * turunannya. Proses turunan host yang normal tidak ikut dihentikan.
+ */
+class Win32ScriptHostBackend : public IScriptHostBackend {
+private:
+    /** @brief State satu host - OsHandle menunjuk ke object ini */
+    struct Host {
+        HANDLE process = NULL;
+        HANDLE job = NULL;             /**< NULL jika proses tidak dapat dimasukkan ke job */
+        HANDLE input = NULL;           /**< Sisi tulis stdin */
+        HANDLE output = NULL;          /**< Sisi server pipe stdout/stderr */
+        HANDLE readEvent = NULL;
+        OVERLAPPED overlapped;
+        bool readPending = false;
+        char buffer[16 * 1024];
+    };
+
+    static Host* FromHandle(OsHandle host) { return reinterpret_cast<Host*>(host); }
+
+    static void CloseIfValid(HANDLE& handle)
+    {
+        if (handle != NULL && handle != INVALID_HANDLE_VALUE) {
+            CloseHandle(handle);
+        }
+        handle = NULL;
+    }
+
+    static void Release(Host* host)
+    {
+        CloseIfValid(host->input);
+        CloseIfValid(host->output);
+        CloseIfValid(host->readEvent);
+        CloseIfValid(host->job);
+        CloseIfValid(host->process);
+        delete host;
+    }
+
+public:
+    OsHandle StartHost(OsHandle token, const ProcessLaunchRequest& request) override
+    {
+        Host* host = new (std::nothrow) Host();
+        if (!host) {
+            SetLastError(ERROR_NOT_ENOUGH_MEMORY);
+            return OS_INVALID_HANDLE;
+        }
+        ZeroMemory(&host->overlapped, sizeof(host->overlapped));
+
+        // Nama unik per proses + urutan; FIRST_PIPE_INSTANCE menolak nama yang sudah dipakai
+        static volatile LONG pipeSequence = 0;
+        wchar_t pipeName[96];
+        swprintf(pipeName, 96, L"\\\\.\\pipe\\RasTI.ScriptHost.%lu.%ld",
+                 GetCurrentProcessId(), InterlockedIncrement(&pipeSequence));
+
+        SECURITY_ATTRIBUTES inheritable = { sizeof(SECURITY_ATTRIBUTES), NULL, TRUE };
+        HANDLE childInput = NULL;
+        HANDLE childOutput = INVALID_HANDLE_VALUE;
+        host->output = CreateNamedPipeW(pipeName,
+            PIPE_ACCESS_INBOUND | FILE_FLAG_OVERLAPPED | FILE_FLAG_FIRST_PIPE_INSTANCE,
+            PIPE_TYPE_BYTE | PIPE_READMODE_BYTE | PIPE_WAIT | PIPE_REJECT_REMOTE_CLIENTS,
+            1, 0, sizeof(host->buffer), 0, NULL);
+        if (host->output == INVALID_HANDLE_VALUE) {
+            host->output = NULL;
+        } else {
+            childOutput = CreateFileW(pipeName, GENERIC_WRITE, 0, &inheritable, OPEN_EXISTING,
+                                      FILE_ATTRIBUTE_NORMAL, NULL);
+        }
+
+        bool pipesReady = host->output != NULL && childOutput != INVALID_HANDLE_VALUE &&
+            CreatePipe(&childInput, &host->input, &inheritable, 64 * 1024) &&
+            SetHandleInformation(host->input, HANDLE_FLAG_INHERIT, 0) &&
+            (host->readEvent = CreateEventW(NULL, TRUE, FALSE, NULL)) != NULL;
+
+        PROCESS_INFORMATION pi = { 0 };
+        BOOL created = FALSE;
+        if (pipesReady) {
+            STARTUPINFOW si = { 0 };
+            si.cb = sizeof(si);
+            std::wstring desktop = request.desktop;
+            si.lpDesktop = desktop.empty() ? NULL : &desktop[0];
+            si.dwFlags = STARTF_USESTDHANDLES | STARTF_USESHOWWINDOW;
+            si.wShowWindow = SW_HIDE; // Console host tidak terlihat
+            si.hStdInput = childInput;
+            si.hStdOutput = childOutput;
+            si.hStdError = childOutput;
+
+            std::wstring commandLine = request.commandLine;
+            created = CreateProcessWithTokenW(
+                reinterpret_cast<HANDLE>(token),
+                0,
+                request.applicationName.empty() ? NULL : request.applicationName.c_str(),
+                &commandLine[0],
+                request.creationFlags | CREATE_SUSPENDED,
+                NULL,
+                NULL,                         // Direktori awal = direktori RasTI
+                &si,
+                &pi
+            );
+        }
+        DWORD error = GetLastError();
+
+        // Sisi pipe milik host sudah diduplikasi ke proses baru
+        CloseIfValid(childInput);
+        CloseIfValid(childOutput);
+
+        if (!created) {
+            Release(host);
+            SetLastError(pipesReady ? error : (error ? error : ERROR_INVALID_HANDLE));
+            return OS_INVALID_HANDLE;
+        }
+
+        host->process = pi.hProcess;
+        host->job = CreateJobObjectW(NULL, NULL);
+        if (host->job && !AssignProcessToJobObject(host->job, pi.hProcess)) {
+            CloseIfValid(host->job); // Fallback: TerminateProcess hanya untuk host
+        }
+        ResumeThread(pi.hThread);
+        CloseHandle(pi.hThread);
+        return reinterpret_cast<OsHandle>(host);
+    }
+
+    bool WriteHostInput(OsHandle handle, const std::string& data) override
+    {
+        Host* host = FromHandle(handle);
+        size_t written = 0;
+        while (written < data.size()) {
+            DWORD chunk = 0;
+            DWORD size = static_cast<DWORD>(std::min<size_t>(data.size() - written, 64 * 1024));
+            if (!WriteFile(host->input, data.data() + written, size, &chunk, NULL)) {
+                return false; // ERROR_BROKEN_PIPE / ERROR_NO_DATA jika host sudah keluar
+            }
+            written += chunk;
+        }
+        return true;
+    }
+
+    bool ReadHostOutput(OsHandle handle, uint32_t timeoutMs, std::string& data) override
+    {
+        Host* host = FromHandle(handle);
+        DWORD bytesRead = 0;
+
+        // Read yang pending dari panggilan sebelumnya (timeout) dilanjutkan, bukan diulang
+        if (!host->readPending) {
+            ResetEvent(host->readEvent);
+            ZeroMemory(&host->overlapped, sizeof(host->overlapped));
+            host->overlapped.hEvent = host->readEvent;
+            if (ReadFile(host->output, host->buffer, sizeof(host->buffer), &bytesRead, &host->overlapped)) {
+                data.append(host->buffer, bytesRead);
+                return true;
+            }
+            if (GetLastError() != ERROR_IO_PENDING) {
+                return false;
+            }
+            host->readPending = true;
+        }
+
+        DWORD wait = WaitForSingleObject(host->readEvent, timeoutMs);
+        if (wait == WAIT_TIMEOUT) {
+            SetLastError(WAIT_TIMEOUT);
+            return false;
+        }
+        if (wait != WAIT_OBJECT_0) {
+            return false;
+        }
+
+        host->readPending = false;
+        if (!GetOverlappedResult(host->output, &host->overlapped, &bytesRead, FALSE)) {
+            return false; // ERROR_BROKEN_PIPE setelah semua penulis menutup pipe
+        }
+        data.append(host->buffer, bytesRead);
+        return true;
+    }
+
+    bool WaitHostExit(OsHandle handle, uint32_t timeoutMs, uint32_t& exitCode) override
+    {
+        Host* host = FromHandle(handle);
+        DWORD wait = WaitForSingleObject(host->process, timeoutMs);
+        if (wait == WAIT_TIMEOUT) {
+            SetLastError(WAIT_TIMEOUT);
+            return false;
+        }
+        if (wait != WAIT_OBJECT_0) {
+            return false;
+        }
+
+        DWORD code = 0;
+        if (!GetExitCodeProcess(host->process, &code)) {
+            return false;
+        }
+        exitCode = code;
+        return true;
+    }
+
+    void CloseHost(OsHandle handle) override
+    {
+        if (handle == OS_INVALID_HANDLE) {
+            return;
+        }
+        Host* host = FromHandle(handle);
+
+        if (WaitForSingleObject(host->process, 0) == WAIT_TIMEOUT) {
+            if (host->job) {
+                TerminateJobObject(host->job, 1);
+            } else {
+                TerminateProcess(host->process, 1);
+            }
+        }
+
+        // Buffer milik Host tidak boleh dibebaskan selama read masih pending
+        if (host->readPending) {
+            DWORD bytesRead = 0;
+            CancelIoEx(host->output, &host->overlapped);
+            GetOverlappedResult(host->output, &host->overlapped, &bytesRead, TRUE);
+            host->readPending = false;
+        }
+        Release(host);
+    }
+
+    uint32_t GetLastErrorCode() override
+    {
+        return GetLastError();
+    }
+};
+
+//==============================================================================
+// WIN32 OUTPUT CAPTURE BACKEND
+//==============================================================================
+
+/**
+ * @brief Backend capture berbasis I/O completion port (/capture, /batch)
+ *
+ * Setiap proses mendapat dua named pipe overlapped (stdout, stderr) yang
+ * sisi server-nya diasosiasikan ke satu completion port dengan key 0. Job
+ * object proses diasosiasikan ke port yang sama dengan key = nomor urut
+ * proses, sehingga exit proses juga datang melalui GetQueuedCompletionStatus
+ * tanpa polling. Nomor urut (bukan pointer) dipakai karena notifikasi job
+ * dapat tiba setelah proses ditutup. CreateProcessWithTokenW tidak mengenal
+ * CREATE_NO_WINDOW; console diatur dengan CREATE_NEW_CONSOLE + SW_HIDE
+ * (hidden) atau DETACHED_PROCESS (none) dari request.
+ */
+class Win32OutputCaptureBackend : public IOutputCaptureBackend {
+private:
+    struct Process;
+
+    /** @brief Satu pipe stream; OVERLAPPED dari completion packet menunjuk kembali ke sini */
+    struct Stream {
+        OVERLAPPED overlapped;
+        HANDLE pipe = NULL;
+        Process* owner = nullptr;
+        CaptureStream kind = CAPTURE_STREAM_STDOUT;
+        bool pending = false;          /**< ReadFile menunggu completion packet */
+        char buffer[64 * 1024];
+    };
+
+    struct Port;
+
+    /** @brief State satu proses - OsHandle proses menunjuk ke object ini */
+    struct Process {
+        HANDLE process = NULL;
+        HANDLE job = NULL;             /**< NULL jika proses tidak dapat dimasukkan ke job */
+        DWORD processId = 0;
+        ULONG_PTR sequence = 0;        /**< Completion key notifikasi job */
+        Port* port = nullptr;
+        bool closed = false;           /**< Sudah ditutup pemanggil; dibebaskan setelah read pending selesai */
+        Stream streams[2];
+    };
+
+    /** @brief State satu completion port - OsHandle port menunjuk ke object ini */
+    struct Port {
+        HANDLE port = NULL;
+        Stream* lent = nullptr;        /**< Stream yang buffernya sedang dibaca pemanggil */
+        std::vector<CaptureEvent> ready; /**< END_OF_STREAM dari read yang gagal tanpa completion packet */
+        std::map<ULONG_PTR, Process*> processes;
+        ULONG_PTR nextSequence = 1;
+    };
+
+    static Port* FromPort(OsHandle port) { return reinterpret_cast<Port*>(port); }
+    static Process* FromProcess(OsHandle process) { return reinterpret_cast<Process*>(process); }
+
+    static void CloseIfValid(HANDLE& handle)
+    {
+        if (handle != NULL && handle != INVALID_HANDLE_VALUE) {
+            CloseHandle(handle);
+        }
+        handle = NULL;
+    }
+
+    /** @brief Named pipe inbound overlapped + sisi tulis inheritable untuk proses baru */
+    static bool CreateStreamPipe(Stream& stream, HANDLE& childEnd, SECURITY_ATTRIBUTES& inheritable)
+    {
+        static volatile LONG pipeSequence = 0;
+        wchar_t pipeName[96];
+        swprintf(pipeName, 96, L"\\\\.\\pipe\\RasTI.Capture.%lu.%ld",
+                 GetCurrentProcessId(), InterlockedIncrement(&pipeSequence));
+
+        stream.pipe = CreateNamedPipeW(pipeName,
+            PIPE_ACCESS_INBOUND | FILE_FLAG_OVERLAPPED | FILE_FLAG_FIRST_PIPE_INSTANCE,
+            PIPE_TYPE_BYTE | PIPE_READMODE_BYTE | PIPE_WAIT | PIPE_REJECT_REMOTE_CLIENTS,
+            1, 0, sizeof(stream.buffer), 0, NULL);
+        if (stream.pipe == INVALID_HANDLE_VALUE) {
+            stream.pipe = NULL;
+            return false;
+        }
+        childEnd = CreateFileW(pipeName, GENERIC_WRITE, 0, &inheritable, OPEN_EXISTING,
+                               FILE_ATTRIBUTE_NORMAL, NULL);
+        return childEnd != INVALID_HANDLE_VALUE;
+    }
+
+    /**
+     * @brief Issue ReadFile overlapped; hasilnya selalu datang sebagai completion packet
+     * @return false jika read gagal langsung (pipe sudah ditutup penulis) - pipe ditutup
+     */
+    static bool IssueRead(Stream& stream)
+    {
+        ZeroMemory(&stream.overlapped, sizeof(stream.overlapped));
+        if (ReadFile(stream.pipe, stream.buffer, sizeof(stream.buffer), NULL, &stream.overlapped) ||
+            GetLastError() == ERROR_IO_PENDING) {
+            stream.pending = true;
+            return true;
+        }
+        CloseIfValid(stream.pipe);
+        return false;
+    }
+
+    static CaptureEvent EndOfStream(Stream& stream)
+    {
+        CaptureEvent event;
+        event.type = CAPTURE_EVENT_END_OF_STREAM;
+        event.process = reinterpret_cast<OsHandle>(stream.owner);
+        event.stream = stream.kind;
+        return event;
+    }
+
+    /** @brief Membebaskan proses yang sudah ditutup setelah read terakhirnya selesai */
+    static void ReleaseIfIdle(Process* process)
+    {
+        if (!process->closed || process->streams[0].pending || process->streams[1].pending) {
+            return;
+        }
+        process->port->processes.erase(process->sequence);
+        CloseIfValid(process->streams[0].pipe);
+        CloseIfValid(process->streams[1].pipe);
+        delete process;
+    }
+
+public:
+    OsHandle CreateCapturePort() override
+    {
+        Port* port = new (std::nothrow) Port();
+        if (!port) {
+            SetLastError(ERROR_NOT_ENOUGH_MEMORY);
+            return OS_INVALID_HANDLE;
+        }
+        port->port = CreateIoCompletionPort(INVALID_HANDLE_VALUE, NULL, 0, 1);
+        if (!port->port) {
+            DWORD error = GetLastError();
+            delete port;
+            SetLastError(error);
+            return OS_INVALID_HANDLE;
+        }
+        return reinterpret_cast<OsHandle>(port);
+    }
+
+    OsHandle StartCapturedProcess(OsHandle portHandle, OsHandle token, const ProcessLaunchRequest& request,
+                                  uint32_t& processId) override
+    {
+        Port* port = FromPort(portHandle);
+        Process* process = new (std::nothrow) Process();
+        if (!process) {
+            SetLastError(ERROR_NOT_ENOUGH_MEMORY);
+            return OS_INVALID_HANDLE;
+        }
+        process->port = port;
+        process->sequence = port->nextSequence++;
+        for (int i = 0; i < 2; i++) {
+            ZeroMemory(&process->streams[i].overlapped, sizeof(process->streams[i].overlapped));
+            process->streams[i].owner = process;
+            process->streams[i].kind = static_cast<CaptureStream>(i);
+        }
+
+        SECURITY_ATTRIBUTES inheritable = { sizeof(SECURITY_ATTRIBUTES), NULL, TRUE };
+        HANDLE childOutput = INVALID_HANDLE_VALUE;
+        HANDLE childError = INVALID_HANDLE_VALUE;
+        HANDLE childInput = INVALID_HANDLE_VALUE;
+        bool pipesReady =
+            CreateStreamPipe(process->streams[CAPTURE_STREAM_STDOUT], childOutput, inheritable) &&
+            CreateStreamPipe(process->streams[CAPTURE_STREAM_STDERR], childError, inheritable) &&
+            (childInput = CreateFileW(L"NUL", GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE, &inheritable,
+                                      OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL)) != INVALID_HANDLE_VALUE &&
+            CreateIoCompletionPort(process->streams[0].pipe, port->port, 0, 0) != NULL &&
+            CreateIoCompletionPort(process->streams[1].pipe, port->port, 0, 0) != NULL;
+
+        PROCESS_INFORMATION pi = { 0 };
+        BOOL created = FALSE;
+        if (pipesReady) {
+            STARTUPINFOW si = { 0 };
+            si.cb = sizeof(si);
+            std::wstring desktop = request.desktop;
+            si.lpDesktop = desktop.empty() ? NULL : &desktop[0];
+            si.dwFlags = request.startupFlags | STARTF_USESTDHANDLES;
+            si.wShowWindow = request.showWindow;
+            si.hStdInput = childInput;
+            si.hStdOutput = childOutput;
+            si.hStdError = childError;
+
+            std::wstring commandLine = request.commandLine;
+            created = CreateProcessWithTokenW(
+                reinterpret_cast<HANDLE>(token),
+                0,
+                request.applicationName.empty() ? NULL : request.applicationName.c_str(),
+                &commandLine[0],
+                request.creationFlags | CREATE_SUSPENDED,
+                NULL,
+                NULL,
+                &si,
+                &pi
+            );
+        }
+        DWORD error = GetLastError();
+
+        // Sisi pipe milik proses sudah diduplikasi ke proses baru
+        CloseIfValid(childInput);
+        CloseIfValid(childOutput);
+        CloseIfValid(childError);
+
+        if (!created) {
+            CloseIfValid(process->streams[0].pipe);
+            CloseIfValid(process->streams[1].pipe);
+            delete process;
+            SetLastError(pipesReady ? error : (error ? error : ERROR_INVALID_HANDLE));
+            return OS_INVALID_HANDLE;
+        }
+
+        // Job diasosiasikan ke port sebelum resume: notifikasi exit tidak mungkin terlewat
+        process->process = pi.hProcess;
+        process->processId = pi.dwProcessId;
+        process->job = CreateJobObjectW(NULL, NULL);
+        if (process->job) {
+            JOBOBJECT_ASSOCIATE_COMPLETION_PORT_INFORMATION association;
+            association.CompletionKey = reinterpret_cast<PVOID>(process->sequence);
+            association.CompletionPort = port->port;
+            if (!SetInformationJobObject(process->job, JobObjectAssociateCompletionPortInformation,
+                                         &association, sizeof(association)) ||
+                !AssignProcessToJobObject(process->job, pi.hProcess)) {
+                CloseIfValid(process->job); // Fallback: exit dideteksi pemanggil dengan QueryCapturedExit
+            }
+        }
+        ResumeThread(pi.hThread);
+        CloseHandle(pi.hThread);
+
+        port->processes[process->sequence] = process;
+        for (int i = 0; i < 2; i++) {
+            if (!IssueRead(process->streams[i])) {
+                port->ready.push_back(EndOfStream(process->streams[i]));
+            }
+        }
+
+        processId = pi.dwProcessId;
+        return reinterpret_cast<OsHandle>(process);
+    }
+
+    bool WaitCaptureEvent(OsHandle portHandle, uint32_t timeoutMs, CaptureEvent& event) override
+    {
+        Port* port = FromPort(portHandle);
+
+        // Buffer event sebelumnya sudah selesai dipakai - read berikutnya ke buffer yang sama
+        if (port->lent) {
+            Stream* stream = port->lent;
+            port->lent = nullptr;
+            if (!IssueRead(*stream)) {
+                port->ready.push_back(EndOfStream(*stream));
+            }
+        }
+        if (!port->ready.empty()) {
+            event = port->ready.front();
+            port->ready.erase(port->ready.begin());
+            return true;
+        }
+
+        ULONGLONG deadline = GetTickCount64() + timeoutMs;
+        for (;;) {
+            DWORD wait = INFINITE;
+            if (timeoutMs != INFINITE) {
+                ULONGLONG now = GetTickCount64();
+                wait = now >= deadline ? 0 : static_cast<DWORD>(deadline - now);
+            }
+
+            DWORD bytes = 0;
+            ULONG_PTR key = 0;
+            OVERLAPPED* overlapped = NULL;
+            BOOL ok = GetQueuedCompletionStatus(port->port, &bytes, &key, &overlapped, wait);
+            if (!ok && !overlapped) {
+                return false; // WAIT_TIMEOUT atau port rusak
+            }
+
+            if (key != 0) {
+                // Notifikasi job: bytes = JOB_OBJECT_MSG_*, overlapped = PID
+                std::map<ULONG_PTR, Process*>::iterator it = port->processes.find(key);
+                bool exited = bytes == JOB_OBJECT_MSG_EXIT_PROCESS || bytes == JOB_OBJECT_MSG_ABNORMAL_EXIT_PROCESS;
+                if (exited && it != port->processes.end() && !it->second->closed &&
+                    static_cast<DWORD>(reinterpret_cast<ULONG_PTR>(overlapped)) == it->second->processId) {
+                    event = CaptureEvent();
+                    event.type = CAPTURE_EVENT_EXITED;
+                    event.process = reinterpret_cast<OsHandle>(it->second);
+                    return true;
+                }
+                continue; // Exit proses turunan atau notifikasi proses yang sudah ditutup
+            }
+
+            Stream* stream = CONTAINING_RECORD(overlapped, Stream, overlapped);
+            stream->pending = false;
+            if (stream->owner->closed) {
+                ReleaseIfIdle(stream->owner);
+                continue;
+            }
+
+            if (ok && bytes > 0) {
+                event = CaptureEvent();
+                event.type = CAPTURE_EVENT_OUTPUT;
+                event.process = reinterpret_cast<OsHandle>(stream->owner);
+                event.stream = stream->kind;
+                event.data = stream->buffer;
+                event.size = bytes;
+                port->lent = stream;
+                return true;
+            }
+            if (ok && IssueRead(*stream)) {
+                continue; // Read 0 byte (penulis menulis 0 byte)
+            }
+
+            // ERROR_BROKEN_PIPE: semua penulis (proses dan turunannya) menutup pipe
+            CloseIfValid(stream->pipe);
+            event = EndOfStream(*stream);
+            return true;
+        }
+    }
+
+    bool QueryCapturedExit(OsHandle handle, uint32_t& exitCode) override
+    {
+        Process* process = FromProcess(handle);
+        DWORD wait = WaitForSingleObject(process->process, 0);
+        if (wait == WAIT_TIMEOUT) {
+            SetLastError(WAIT_TIMEOUT);
+            return false;
+        }
+        DWORD code = 0;
+        if (wait != WAIT_OBJECT_0 || !GetExitCodeProcess(process->process, &code)) {
+            return false;
+        }
+        exitCode = code;
+        return true;
+    }
+
+    bool QueryCapturedAccounting(OsHandle handle, ProcessAccounting& accounting) override
+    {
+        Process* process = FromProcess(handle);
+        if (!process->job) {
+            SetLastError(ERROR_NOT_SUPPORTED); // Proses tidak dapat dimasukkan ke job saat dibuat
+            return false;
+        }
+
+        // Dua query untuk seluruh job: CPU + I/O, lalu peak memory
+        JOBOBJECT_BASIC_AND_IO_ACCOUNTING_INFORMATION usage;
+        JOBOBJECT_EXTENDED_LIMIT_INFORMATION limits;
+        if (!QueryInformationJobObject(process->job, JobObjectBasicAndIoAccountingInformation,
+                                       &usage, sizeof(usage), NULL) ||
+            !QueryInformationJobObject(process->job, JobObjectExtendedLimitInformation,
+                                       &limits, sizeof(limits), NULL)) {
+            return false;
+        }
+
+        // TotalUserTime/TotalKernelTime dalam satuan 100 ns
+        accounting.userMicroseconds = static_cast<uint64_t>(usage.BasicInfo.TotalUserTime.QuadPart) / 10;
+        accounting.kernelMicroseconds = static_cast<uint64_t>(usage.BasicInfo.TotalKernelTime.QuadPart) / 10;
+        accounting.peakMemoryBytes = limits.PeakJobMemoryUsed;
+        accounting.readBytes = usage.IoInfo.ReadTransferCount;
+        accounting.writeBytes = usage.IoInfo.WriteTransferCount;
+        accounting.otherBytes = usage.IoInfo.OtherTransferCount;
+        accounting.processCount = usage.BasicInfo.TotalProcesses;
+        return true;
+    }
+
+    void CloseCapturedProcess(OsHandle handle) override
+    {
+        if (handle == OS_INVALID_HANDLE) {
+            return;
+        }
+        Process* process = FromProcess(handle);
+        Port* port = process->port;
+
+        if (WaitForSingleObject(process->process, 0) == WAIT_TIMEOUT) {
+            if (process->job) {
+                TerminateJobObject(process->job, 1);
+            } else {
+                TerminateProcess(process->process, 1);
+            }
+        }
+
+        process->closed = true;
+        if (port->lent && port->lent->owner == process) {
+            port->lent = nullptr;
+        }
+        port->ready.erase(std::remove_if(port->ready.begin(), port->ready.end(),
+            [handle](const CaptureEvent& event) { return event.process == handle; }), port->ready.end());
+
+        // Buffer tidak boleh dibebaskan sebelum read yang dibatalkan mengirim completion packet
+        for (int i = 0; i < 2; i++) {
+            if (process->streams[i].pending) {
+                CancelIoEx(process->streams[i].pipe, &process->streams[i].overlapped);
+            }
+        }
+        CloseIfValid(process->job);
+        CloseIfValid(process->process);
+        ReleaseIfIdle(process);
+    }
+
+    void CloseCapturePort(OsHandle handle) override
+    {
+        if (handle == OS_INVALID_HANDLE) {
+            return;
+        }
+        Port* port = FromPort(handle);
+
+        std::vector<Process*> open;
+        for (std::map<ULONG_PTR, Process*>::iterator it = port->processes.begin(); it != port->processes.end(); ++it) {
+            if (!it->second->closed) open.push_back(it->second);
+        }
+        for (size_t i = 0; i < open.size(); i++) {
+            CloseCapturedProcess(reinterpret_cast<OsHandle>(open[i]));
+        }
+
+        // Read yang dibatalkan selalu selesai; tunggu packet-nya sebelum membebaskan buffer
+        while (!port->processes.empty()) {
+            DWORD bytes = 0;
+            ULONG_PTR key = 0;
+            OVERLAPPED* overlapped = NULL;
+            GetQueuedCompletionStatus(port->port, &bytes, &key, &overlapped, INFINITE);
+            if (key == 0 && overlapped) {
+                Stream* stream = CONTAINING_RECORD(overlapped, Stream, overlapped);
+                stream->pending = false;
+                ReleaseIfIdle(stream->owner);
+            }
+        }
+        CloseIfValid(port->port);
+        delete port;
+    }
+
+    OsHandle CreateLogFile(const std::wstring& path) override
+    {
+        HANDLE file = CreateFileW(ToExtendedLengthPath(path).c_str(), GENERIC_WRITE, FILE_SHARE_READ, NULL,
+                                  CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+        return file == INVALID_HANDLE_VALUE ? OS_INVALID_HANDLE : reinterpret_cast<OsHandle>(file);
+    }
+
+    bool WriteLogFile(OsHandle file, const char* data, size_t size) override
+    {
+        size_t written = 0;
+        while (written < size) {
+            DWORD chunk = 0;
+            DWORD request = static_cast<DWORD>(std::min<size_t>(size - written, 1024 * 1024));
+            if (!WriteFile(reinterpret_cast<HANDLE>(file), data + written, request, &chunk, NULL)) {
+                return false;
+            }
+            written += chunk;
+        }
+        return true;
+    }
+
+    void CloseLogFile(OsHandle file) override
+    {
+        if (file != OS_INVALID_HANDLE) {
+            CloseHandle(reinterpret_cast<HANDLE>(file));
+        }
+    }
+
+    bool RenameLogFile(const std::wstring& source, const std::wstring& destination) override
+    {
+        return MoveFileExW(ToExtendedLengthPath(source).c_str(), ToExtendedLengthPath(destination).c_str(),
+                           MOVEFILE_REPLACE_EXISTING) != FALSE;
+    }
+
+    uint32_t GetLastErrorCode() override
+    {
+        return GetLastError();
+    }
+};
+
+//==============================================================================
+// DEFAULT BACKEND
+//==============================================================================
+
+IFileSystemBackend* GetDefaultFileSystemBackend()
+{
+    // Function-local static: thread-safe initialization (C++11)
+    static Win32FileSystemBackend backend;
+    return &backend;
+}
+
+IProcessBackend* GetDefaultProcessBackend()
+{
+    static Win32ProcessBackend backend;
+    return &backend;
+}
+
+IFileOperationBackend* GetDefaultFileOperationBackend()
+{
+    static Win32FileOperationBackend backend;
+    return &backend;
+}
+
+IRegistryBackend* GetDefaultRegistryBackend()
+{
+    static Win32RegistryBackend backend;
+    return &backend;
+}
+
+IScriptHostBackend* GetDefaultScriptHostBackend()
+{
+    static Win32ScriptHostBackend backend;
+    return &backend;
+}
+
+IOutputCaptureBackend* GetDefaultOutputCaptureBackend()
+{
+    static Win32OutputCaptureBackend backend;
+    return &backend;
+}
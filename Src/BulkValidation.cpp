@@ -0,0 +1,377 @@
+/**
+ * @file BulkValidation.cpp
+ * @brief Implementasi validasi massal paralel dengan work stealing
+ *
+ * Daftar path dibagi menjadi batch dan walk direktori dipecah per direktori,
+ * lalu dijadwalkan lewat WorkStealingScheduler (lihat WorkStealingScheduler.h
+ * untuk alasan urutan ambil/curi). Hasil tiap path ditulis ke report CSV atau
+ * array JSON oleh BulkResultWriter.
+ *
+ * @author RasTI Development Team
+ * @version 1.2.0.0
+ * @date 2025
+ */
+
+#include "BulkValidation.h"
+#include "Sha256.h"
+#include "TextEncoding.h"
+#include "WorkStealingScheduler.h"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <thread>
+
+//==============================================================================
+// WORK-STEALING SCHEDULER
+//==============================================================================
+
+/**
+ * @brief Satu unit kerja: direktori yang harus dibaca, atau sekelompok path
+ */
+struct BulkTask {
+    std::wstring directory;          /**< Tidak kosong: enumerasi direktori ini */
+    std::vector<std::wstring> paths; /**< Path yang harus divalidasi */
+};
+
+/** @brief Scheduler bulk audit */
+typedef WorkStealingScheduler<BulkTask> BulkScheduler;
+
+/**
+ * @brief Counter bersama antar worker
+ */
+struct BulkCounters {
+    std::atomic<uint64_t> validated{0};
+    std::atomic<uint64_t> accepted{0};
+    std::atomic<uint64_t> directories{0};
+    std::atomic<uint64_t> skipped{0};
+};
+
+//==============================================================================
+// INTERNAL HELPERS
+//==============================================================================
+
+static unsigned ResolveThreadCount(unsigned requested)
+{
+    unsigned count = requested ? requested : std::thread::hardware_concurrency();
+    if (count == 0) count = 1;
+    return (count > BULK_MAX_THREADS) ? BULK_MAX_THREADS : count;
+}
+
+static void ValidateBatch(const std::vector<std::wstring>& paths, BulkResultWriter& writer, BulkCounters& counters)
+{
+    for (const std::wstring& path : paths) {
+        ValidatedExecutable validated;
+        ValidationError error = ValidateExecutable(path, validated);
+        writer.Write(path, error, validated);
+
+        counters.validated++;
+        if (error == VALIDATION_OK) counters.accepted++;
+        // validated keluar scope di sini - handle file langsung ditutup
+    }
+}
+
+static void ScanDirectory(unsigned worker, const std::wstring& directory, bool recursive,
+                          BulkScheduler& scheduler, BulkCounters& counters)
+{
+    std::vector<DirectoryEntry> entries;
+    if (!GetFileSystemBackend()->EnumerateDirectory(directory, entries)) {
+        return;
+    }
+    counters.directories++;
+
+    std::wstring prefix = directory;
+    if (!prefix.empty() && prefix.back() != L'\\') {
+        prefix += L'\\';
+    }
+
+    BulkTask batch;
+    for (const DirectoryEntry& entry : entries) {
+        if (entry.isDirectory) {
+            // Junction/symlink tidak diikuti: bisa membentuk loop
+            if (recursive && !entry.isReparsePoint) {
+                BulkTask child;
+                child.directory = prefix + entry.name;
+                scheduler.Push(worker, std::move(child));
+            }
+            continue;
+        }
+
+        if (GetExecutableKind(entry.name) == EXECUTABLE_KIND_UNKNOWN) {
+            counters.skipped++;
+            continue;
+        }
+
+        batch.paths.push_back(prefix + entry.name);
+        if (batch.paths.size() == BULK_PATHS_PER_TASK) {
+            scheduler.Push(worker, std::move(batch));
+            batch = BulkTask();
+        }
+    }
+
+    if (!batch.paths.empty()) {
+        scheduler.Push(worker, std::move(batch));
+    }
+}
+
+/**
+ * @brief Menjalankan worker sampai semua task (termasuk yang dibuat worker lain) selesai
+ */
+static void RunWorker(unsigned worker, bool recursive, BulkScheduler& scheduler,
+                      BulkResultWriter& writer, BulkCounters& counters)
+{
+    scheduler.RunWorker(worker, [&](const BulkTask& task) {
+        if (!task.directory.empty()) {
+            ScanDirectory(worker, task.directory, recursive, scheduler, counters);
+        } else {
+            ValidateBatch(task.paths, writer, counters);
+        }
+    });
+}
+
+/**
+ * @brief Menjalankan scheduler dengan task awal yang sudah di-push, lalu mengisi statistik
+ */
+static BulkValidationStats RunScheduler(BulkScheduler& scheduler, unsigned threadCount, bool recursive,
+                                        BulkResultWriter& writer,
+                                        std::chrono::steady_clock::time_point start)
+{
+    BulkCounters counters;
+
+    // Worker 0 berjalan di thread pemanggil
+    std::vector<std::thread> threads;
+    for (unsigned i = 1; i < threadCount; i++) {
+        threads.emplace_back(RunWorker, i, recursive, std::ref(scheduler), std::ref(writer), std::ref(counters));
+    }
+    RunWorker(0, recursive, scheduler, writer, counters);
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
+    BulkValidationStats stats;
+    stats.pathsValidated = counters.validated.load();
+    stats.accepted = counters.accepted.load();
+    stats.rejected = stats.pathsValidated - stats.accepted;
+    stats.directoriesScanned = counters.directories.load();
+    stats.filesSkipped = counters.skipped.load();
+    stats.tasksStolen = scheduler.StolenCount();
+    stats.threadCount = threadCount;
+    stats.elapsedSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return stats;
+}
+
+static bool HasPathSeparator(std::wstring_view path)
+{
+    return path.find_first_of(L"\\/:") != std::wstring_view::npos;
+}
+
+//==============================================================================
+// BULK VALIDATION API
+//==============================================================================
+
+BulkValidationStats ValidatePathList(const std::vector<std::wstring>& paths,
+                                     const BulkValidationOptions& options, BulkResultWriter& writer)
+{
+    auto start = std::chrono::steady_clock::now();
+
+    // Index PATH dibangun sekali jika ada input berupa nama file saja
+    PathSearchIndex searchIndex;
+    const PathSearchIndex* previousIndex = GetPathSearchIndex();
+    bool installIndex = false;
+    if (options.useSearchIndex && !previousIndex) {
+        for (const std::wstring& path : paths) {
+            if (!HasPathSeparator(path)) {
+                installIndex = searchIndex.Build(GetFileSystemBackend());
+                break;
+            }
+        }
+    }
+    if (installIndex) SetPathSearchIndex(&searchIndex);
+
+    unsigned threadCount = ResolveThreadCount(options.threadCount);
+    BulkScheduler scheduler(threadCount);
+
+    // Bagi input round-robin agar setiap worker langsung punya pekerjaan
+    unsigned worker = 0;
+    for (size_t first = 0; first < paths.size(); first += BULK_PATHS_PER_TASK) {
+        size_t last = (paths.size() - first < BULK_PATHS_PER_TASK) ? paths.size() : first + BULK_PATHS_PER_TASK;
+        BulkTask task;
+        task.paths.assign(paths.begin() + first, paths.begin() + last);
+        scheduler.Push(worker, std::move(task));
+        worker = (worker + 1) % threadCount;
+    }
+
+    writer.Begin();
+    BulkValidationStats stats = RunScheduler(scheduler, threadCount, options.recursive, writer, start);
+    writer.End();
+
+    if (installIndex) SetPathSearchIndex(previousIndex);
+    return stats;
+}
+
+BulkValidationStats ValidateDirectoryTree(const std::wstring& root,
+                                          const BulkValidationOptions& options, BulkResultWriter& writer)
+{
+    auto start = std::chrono::steady_clock::now();
+
+    unsigned threadCount = ResolveThreadCount(options.threadCount);
+    BulkScheduler scheduler(threadCount);
+
+    BulkTask task;
+    task.directory = root;
+    scheduler.Push(0, std::move(task));
+
+    writer.Begin();
+    BulkValidationStats stats = RunScheduler(scheduler, threadCount, options.recursive, writer, start);
+    writer.End();
+    return stats;
+}
+
+bool ReadPathListFile(const std::wstring& listFile, std::vector<std::wstring>& paths)
+{
+    paths.clear();
+
+    std::string text;
+    if (!ReadSmallFile(GetFileSystemBackend(), listFile, BULK_LIST_MAX_FILE_SIZE, text)) {
+        return false;
+    }
+
+    std::string_view bytes(text);
+    if (bytes.substr(0, 3) == "\xEF\xBB\xBF") {
+        bytes.remove_prefix(3); // UTF-8 BOM
+    }
+
+    std::wstring decoded;
+    if (!DecodeUtf8(bytes, decoded)) {
+        return false;
+    }
+
+    size_t start = 0;
+    while (start < decoded.size()) {
+        size_t end = decoded.find(L'\n', start);
+        if (end == std::wstring::npos) end = decoded.size();
+        std::wstring_view line = std::wstring_view(decoded).substr(start, end - start);
+        start = end + 1;
+
+        while (!line.empty() && (line.front() == L' ' || line.front() == L'\t')) line.remove_prefix(1);
+        while (!line.empty() && (line.back() == L' ' || line.back() == L'\t' || line.back() == L'\r')) line.remove_suffix(1);
+        if (line.size() >= 2 && line.front() == L'"' && line.back() == L'"') {
+            line = line.substr(1, line.size() - 2);
+        }
+        if (line.empty() || line.front() == L'#') continue;
+
+        paths.emplace_back(line);
+    }
+    return true;
+}
+
+//==============================================================================
+// RESULT WRITER
+//==============================================================================
+
+static const char* GetExecutableKindName(ExecutableKind kind)
+{
+    switch (kind)
+    {
+    case EXECUTABLE_KIND_PE_IMAGE: return "pe-image";
+    case EXECUTABLE_KIND_SCRIPT:   return "script";
+    default:                       return "";
+    }
+}
+
+static void AppendCsvField(std::wstring_view value, std::string& line)
+{
+    std::string utf8;
+    AppendUtf8(value, utf8);
+
+    if (utf8.find_first_of(",\"\r\n") == std::string::npos) {
+        line += utf8;
+        return;
+    }
+
+    line.push_back('"');
+    for (char ch : utf8) {
+        if (ch == '"') line.push_back('"');
+        line.push_back(ch);
+    }
+    line.push_back('"');
+}
+
+void BulkResultWriter::Begin()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    recordCount_ = 0;
+    if (format_ == BULK_OUTPUT_CSV) {
+        sink_("input,path,result,kind,subsystem,machine,sha256,policy_rule\n");
+    } else {
+        sink_("[\n");
+    }
+}
+
+void BulkResultWriter::Write(std::wstring_view input, ValidationError error, const ValidatedExecutable& validated)
+{
+    // Format di luar lock - hanya pengiriman ke sink yang diserialisasi
+    bool isImage = (validated.kind == EXECUTABLE_KIND_PE_IMAGE) && (validated.image.machine != 0);
+    char number[32];
+    std::string line;
+    line.reserve(256);
+
+    if (format_ == BULK_OUTPUT_CSV) {
+        AppendCsvField(input, line);
+        line.push_back(',');
+        AppendCsvField(validated.path, line);
+        line.push_back(',');
+        line += GetValidationErrorName(error);
+        line.push_back(',');
+        line += GetExecutableKindName(validated.kind);
+        line.push_back(',');
+        if (isImage) {
+            snprintf(number, sizeof(number), "%u,0x%04x", validated.image.subsystem, validated.image.machine);
+            line += number;
+        } else {
+            line.push_back(',');
+        }
+        line.push_back(',');
+        if (validated.hasSha256) line += Sha256ToHex(validated.sha256);
+        line.push_back(',');
+        if (validated.policy.ruleLine) line += std::to_string(validated.policy.ruleLine);
+        line.push_back('\n');
+    } else {
+        line += "{\"input\":";
+        AppendJsonString(input, line);
+        line += ",\"path\":";
+        AppendJsonString(validated.path, line);
+        line += ",\"result\":\"";
+        line += GetValidationErrorName(error);
+        line += "\",\"kind\":";
+        line += (validated.kind == EXECUTABLE_KIND_UNKNOWN) ? std::string("null") :
+                "\"" + std::string(GetExecutableKindName(validated.kind)) + "\"";
+        if (isImage) {
+            snprintf(number, sizeof(number), ",\"subsystem\":%u", validated.image.subsystem);
+            line += number;
+            snprintf(number, sizeof(number), ",\"machine\":\"0x%04x\"", validated.image.machine);
+            line += number;
+        } else {
+            line += ",\"subsystem\":null,\"machine\":null";
+        }
+        line += ",\"sha256\":";
+        line += validated.hasSha256 ? "\"" + Sha256ToHex(validated.sha256) + "\"" : std::string("null");
+        line += ",\"policyRule\":";
+        line += validated.policy.ruleLine ? std::to_string(validated.policy.ruleLine) : std::string("null");
+        line += "}";
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (format_ == BULK_OUTPUT_JSON && recordCount_ > 0) {
+        sink_(",\n");
+    }
+    sink_(line);
+    recordCount_++;
+}
+
+void BulkResultWriter::End()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (format_ == BULK_OUTPUT_JSON) {
+        sink_(recordCount_ > 0 ? "\n]\n" : "]\n");
+    }
+}
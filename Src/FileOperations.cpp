@@ -0,0 +1,743 @@
+/**
+ * @file FileOperations.cpp
+ * @brief Implementasi engine /fileops: parser script, planner paralel, dan executor per stage
+ *
+ * Walk dan eksekusi memakai WorkStealingScheduler yang sama dengan bulk
+ * audit. Worker thread dibuat per fase (walk, setiap stage) dan masing-masing
+ * meng-impersonate token yang diberikan; thread pemanggil tidak pernah
+ * berganti security context kecuali saat berjalan tanpa token.
+ *
+ * @author RasTI Development Team
+ * @version 1.2.0.0
+ * @date 2025
+ */
+
+#include "FileOperations.h"
+#include "TextEncoding.h"
+#include "WorkStealingScheduler.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <thread>
+
+//==============================================================================
+// SCRIPT PARSER
+//==============================================================================
+
+static bool IsBlank(wchar_t ch)
+{
+    return ch == L' ' || ch == L'\t' || ch == L'\r';
+}
+
+static wchar_t FoldCase(wchar_t ch)
+{
+    return (ch >= L'a' && ch <= L'z') ? static_cast<wchar_t>(ch - L'a' + L'A') : ch;
+}
+
+/** @brief Mengambil satu token (diapit kutip atau dipisah blank) dari awal line */
+static bool NextToken(std::wstring_view& line, std::wstring& token)
+{
+    while (!line.empty() && IsBlank(line.front())) line.remove_prefix(1);
+    if (line.empty()) {
+        return false;
+    }
+
+    size_t end = 0;
+    if (line.front() == L'"') {
+        end = line.find(L'"', 1);
+        if (end == std::wstring_view::npos || end == 1) {
+            return false; // Kutip tidak ditutup atau path kosong
+        }
+        token.assign(line.substr(1, end - 1));
+        line.remove_prefix(end + 1);
+        return line.empty() || IsBlank(line.front());
+    }
+
+    while (end < line.size() && !IsBlank(line[end])) end++;
+    token.assign(line.substr(0, end));
+    line.remove_prefix(end);
+    return token.find(L'"') == std::wstring::npos;
+}
+
+bool NormalizeFileOperationPath(std::wstring& path)
+{
+    std::replace(path.begin(), path.end(), L'/', L'\\');
+    while (path.size() > 1 && path.back() == L'\\') path.pop_back();
+
+    size_t pos = 0;
+    size_t rootComponents = 0;
+    if (path.size() >= 2 && path[0] == L'\\' && path[1] == L'\\') {
+        pos = 2;
+        rootComponents = 2; // \\server\share
+    } else if (path.size() >= 3 && FoldCase(path[0]) >= L'A' && FoldCase(path[0]) <= L'Z' &&
+               path[1] == L':' && path[2] == L'\\') {
+        pos = 3;
+    } else {
+        return false;
+    }
+
+    size_t components = 0;
+    while (pos <= path.size()) {
+        size_t end = path.find(L'\\', pos);
+        if (end == std::wstring::npos) end = path.size();
+        std::wstring_view component(path.data() + pos, end - pos);
+
+        // Komponen kosong ("a\\b"), ".", "..", wildcard, ADS, dan karakter kontrol ditolak
+        if (component.empty() || component == L"." || component == L"..") {
+            return false;
+        }
+        for (wchar_t ch : component) {
+            if (ch < 0x20 || ch == L':' || ch == L'*' || ch == L'?' || ch == L'<' || ch == L'>' ||
+                ch == L'|' || ch == L'"') {
+                return false;
+            }
+        }
+        components++;
+        pos = end + 1;
+    }
+    return components > rootComponents;
+}
+
+/** @brief true jika path sama dengan parent atau berada di bawahnya (case-insensitive) */
+static bool IsSameOrInside(const std::wstring& path, const std::wstring& parent)
+{
+    if (path.size() < parent.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < parent.size(); i++) {
+        if (FoldCase(path[i]) != FoldCase(parent[i])) {
+            return false;
+        }
+    }
+    return path.size() == parent.size() || path[parent.size()] == L'\\';
+}
+
+bool ParseFileOperationScript(std::string_view text, std::vector<FileOperationCommand>& commands,
+                              size_t* errorLine)
+{
+    commands.clear();
+    size_t lineNumber = 0;
+    size_t start = 0;
+    bool valid = true;
+    std::wstring decoded;
+
+    // UTF-8 BOM dari editor Windows
+    if (text.substr(0, 3) == "\xEF\xBB\xBF") {
+        start = 3;
+    }
+
+    while (valid && start < text.size()) {
+        size_t end = text.find('\n', start);
+        if (end == std::string_view::npos) end = text.size();
+        std::string_view rawLine = text.substr(start, end - start);
+        start = end + 1;
+        lineNumber++;
+
+        if (!DecodeUtf8(rawLine, decoded)) {
+            valid = false;
+            break;
+        }
+
+        std::wstring_view line(decoded);
+        while (!line.empty() && IsBlank(line.front())) line.remove_prefix(1);
+        if (line.empty() || line.front() == L'#') continue;
+
+        std::wstring keyword;
+        NextToken(line, keyword);
+        for (wchar_t& ch : keyword) ch = FoldCase(ch);
+
+        FileOperationCommand command;
+        command.line = static_cast<uint32_t>(lineNumber);
+        size_t pathCount = 2;
+        if (keyword == L"COPY") {
+            command.kind = FILEOPS_COPY;
+        } else if (keyword == L"MOVE") {
+            command.kind = FILEOPS_MOVE;
+        } else if (keyword == L"DELETE") {
+            command.kind = FILEOPS_DELETE;
+            pathCount = 1;
+        } else {
+            valid = false;
+            break;
+        }
+
+        valid = NextToken(line, command.source) && NormalizeFileOperationPath(command.source) &&
+                (pathCount == 1 || (NextToken(line, command.destination) &&
+                                    NormalizeFileOperationPath(command.destination) &&
+                                    !IsSameOrInside(command.destination, command.source)));
+
+        // Tidak boleh ada token tambahan setelah path
+        while (!line.empty() && IsBlank(line.front())) line.remove_prefix(1);
+        valid = valid && line.empty();
+        if (valid) {
+            commands.push_back(std::move(command));
+        }
+    }
+
+    if (!valid) {
+        // Script rusak tidak boleh dijalankan sebagian
+        commands.clear();
+        if (errorLine) *errorLine = lineNumber;
+        return false;
+    }
+
+    if (errorLine) *errorLine = 0;
+    return true;
+}
+
+bool LoadFileOperationScript(std::wstring_view path, std::vector<FileOperationCommand>& commands,
+                             size_t* errorLine)
+{
+    commands.clear();
+    if (errorLine) *errorLine = 0;
+
+    std::string text;
+    if (!ReadSmallFile(GetFileSystemBackend(), std::wstring(path), FILEOPS_MAX_SCRIPT_SIZE, text)) {
+        return false;
+    }
+    return ParseFileOperationScript(text, commands, errorLine);
+}
+
+//==============================================================================
+// WORKER THREADS
+//==============================================================================
+
+unsigned ResolveFileOperationThreadCount(unsigned requested)
+{
+    unsigned count = requested ? requested : std::thread::hardware_concurrency();
+    if (count == 0) count = 1;
+    return (count > FILEOPS_MAX_THREADS) ? FILEOPS_MAX_THREADS : count;
+}
+
+//==============================================================================
+// PARALLEL WALK
+//==============================================================================
+
+/**
+ * @brief Entry yang ditemukan saat walk, relative terhadap root
+ */
+struct WalkEntry {
+    std::wstring relative;    /**< "sub\file.txt" (tanpa separator di awal) */
+    uint32_t depth;           /**< 1 untuk child langsung root */
+    uint64_t size;
+    bool isReparsePoint;
+};
+
+/**
+ * @brief Hasil walk satu worker (digabung setelah semua worker selesai)
+ */
+struct WalkResult {
+    std::vector<WalkEntry> directories;   /**< Direktori biasa (di-walk) */
+    std::vector<WalkEntry> links;         /**< Junction/symlink direktori (tidak di-walk) */
+    std::vector<WalkEntry> files;
+    std::vector<FileOperationError> errors;
+    uint64_t scanned = 0;
+};
+
+/** @brief Task walk: satu direktori relative terhadap root */
+struct WalkTask {
+    std::wstring relative;
+    uint32_t depth = 0;
+};
+
+static std::wstring JoinPath(const std::wstring& directory, const std::wstring& name)
+{
+    if (name.empty()) return directory;
+    return directory + L'\\' + name;
+}
+
+/**
+ * @brief Walk paralel seluruh pohon di bawah root; hasil per worker digabung ke result
+ */
+static void WalkTree(const std::wstring& root, uint32_t line, unsigned threadCount, OsHandle token,
+                     WalkResult& result, uint64_t& stolen)
+{
+    IFileOperationBackend* fo = GetFileOperationBackend();
+    WorkStealingScheduler<WalkTask> scheduler(threadCount);
+    std::vector<WalkResult> partial(threadCount);
+
+    WalkTask rootTask;
+    scheduler.Push(0, std::move(rootTask));
+
+    RunImpersonatedWorkers(threadCount, token, [&](unsigned worker, uint32_t impersonationError) {
+        WalkResult& own = partial[worker];
+        std::vector<FileOperationEntry> entries;
+
+        scheduler.RunWorker(worker, [&](const WalkTask& task) {
+            std::wstring directory = JoinPath(root, task.relative);
+            if (impersonationError != 0 || !fo->ListDirectory(directory, entries)) {
+                FileOperationError error;
+                error.line = line;
+                error.step = FILEOPS_STEP_LIST;
+                error.path = directory;
+                error.code = impersonationError != 0 ? impersonationError : fo->GetLastErrorCode();
+                own.errors.push_back(std::move(error));
+                return;
+            }
+            own.scanned++;
+
+            for (const FileOperationEntry& entry : entries) {
+                WalkEntry found;
+                found.relative = task.relative.empty() ? entry.name : task.relative + L'\\' + entry.name;
+                found.depth = task.depth + 1;
+                found.size = entry.size;
+                found.isReparsePoint = entry.isReparsePoint;
+
+                if (!entry.isDirectory) {
+                    own.files.push_back(std::move(found));
+                } else if (entry.isReparsePoint) {
+                    own.links.push_back(std::move(found)); // Tidak diikuti: bisa keluar pohon atau membentuk loop
+                } else {
+                    WalkTask child;
+                    child.relative = found.relative;
+                    child.depth = found.depth;
+                    scheduler.Push(worker, std::move(child));
+                    own.directories.push_back(std::move(found));
+                }
+            }
+        });
+    });
+
+    for (WalkResult& own : partial) {
+        result.directories.insert(result.directories.end(), own.directories.begin(), own.directories.end());
+        result.links.insert(result.links.end(), own.links.begin(), own.links.end());
+        result.files.insert(result.files.end(), own.files.begin(), own.files.end());
+        result.errors.insert(result.errors.end(), own.errors.begin(), own.errors.end());
+        result.scanned += own.scanned;
+    }
+    stolen = scheduler.StolenCount();
+
+    // Urutan antar worker tidak deterministik; urutkan agar plan stabil dan
+    // file satu direktori berdekatan dalam batch
+    auto byPath = [](const WalkEntry& a, const WalkEntry& b) { return a.relative < b.relative; };
+    std::sort(result.directories.begin(), result.directories.end(), byPath);
+    std::sort(result.links.begin(), result.links.end(), byPath);
+    std::sort(result.files.begin(), result.files.end(), byPath);
+}
+
+//==============================================================================
+// PLANNING
+//==============================================================================
+
+/**
+ * @brief Menyusun stage metadata: satu stage per kedalaman, item dibagi per batch
+ *
+ * @param items Item per kedalaman (index = kedalaman)
+ * @param parentsFirst true: kedalaman kecil dulu (mkdir); false: terdalam dulu (rmdir)
+ */
+static void AddDepthStages(std::vector<std::vector<FileOperationItem>>& items, bool parentsFirst,
+                           size_t batchSize, FileOperationPlan& plan)
+{
+    if (batchSize == 0) batchSize = 1;
+    for (size_t i = 0; i < items.size(); i++) {
+        std::vector<FileOperationItem>& level = items[parentsFirst ? i : items.size() - 1 - i];
+        if (level.empty()) continue;
+
+        FileOperationStage stage;
+        for (size_t first = 0; first < level.size(); first += batchSize) {
+            size_t last = std::min(level.size(), first + batchSize);
+            FileOperationTask task;
+            task.items.assign(std::make_move_iterator(level.begin() + first),
+                              std::make_move_iterator(level.begin() + last));
+            stage.tasks.push_back(std::move(task));
+        }
+        plan.itemCount += level.size();
+        plan.stages.push_back(std::move(stage));
+    }
+}
+
+/** @brief Satu item copy file (unbuffered untuk file besar) */
+static FileOperationItem MakeCopyItem(const std::wstring& source, const std::wstring& destination,
+                                      uint64_t size, const FileOperationOptions& options)
+{
+    FileOperationItem item;
+    item.step = FILEOPS_STEP_COPY_FILE;
+    item.source = source;
+    item.destination = destination;
+    item.size = size;
+    item.unbuffered = size >= options.largeFileThreshold;
+    return item;
+}
+
+/** @brief Stage berisi satu task dengan satu item */
+static void AddSingleItemStage(FileOperationItem&& item, FileOperationPlan& plan)
+{
+    FileOperationTask task;
+    task.bytes = item.step == FILEOPS_STEP_COPY_FILE ? item.size : 0;
+    plan.totalBytes += task.bytes;
+    task.items.push_back(std::move(item));
+
+    FileOperationStage stage;
+    stage.tasks.push_back(std::move(task));
+    plan.stages.push_back(std::move(stage));
+    plan.itemCount++;
+}
+
+/** @brief Nama komponen terakhir path */
+static std::wstring FileNameOf(const std::wstring& path)
+{
+    size_t separator = path.rfind(L'\\');
+    return separator == std::wstring::npos ? path : path.substr(separator + 1);
+}
+
+static void PlanDirectoryCopy(const FileOperationCommand& command, const FileOperationOptions& options,
+                              const WalkResult& walk, FileOperationPlan& plan)
+{
+    // Stage mkdir per kedalaman: root tujuan di kedalaman 0
+    std::vector<std::vector<FileOperationItem>> directories(1);
+    FileOperationItem root;
+    root.step = FILEOPS_STEP_MAKE_DIRECTORY;
+    root.destination = command.destination;
+    directories[0].push_back(std::move(root));
+
+    for (const WalkEntry& entry : walk.directories) {
+        if (directories.size() <= entry.depth) directories.resize(entry.depth + 1);
+        FileOperationItem item;
+        item.step = FILEOPS_STEP_MAKE_DIRECTORY;
+        item.destination = JoinPath(command.destination, entry.relative);
+        directories[entry.depth].push_back(std::move(item));
+    }
+    AddDepthStages(directories, true, options.metadataBatchSize, plan);
+    plan.reparsePointsSkipped += walk.links.size();
+
+    // Stage copy: file besar sendiri-sendiri, file kecil per batch (urutan path = lokalitas direktori)
+    FileOperationStage copies;
+    FileOperationTask batch;
+    for (const WalkEntry& entry : walk.files) {
+        FileOperationItem item = MakeCopyItem(JoinPath(command.source, entry.relative),
+                                              JoinPath(command.destination, entry.relative), entry.size, options);
+        plan.totalBytes += entry.size;
+        plan.itemCount++;
+
+        if (item.unbuffered) {
+            FileOperationTask large;
+            large.bytes = entry.size;
+            large.items.push_back(std::move(item));
+            copies.tasks.push_back(std::move(large));
+            continue;
+        }
+
+        if (!batch.items.empty() &&
+            (batch.items.size() >= options.copyBatchSize || batch.bytes + entry.size > options.copyBatchBytes)) {
+            copies.tasks.push_back(std::move(batch));
+            batch = FileOperationTask();
+        }
+        batch.bytes += entry.size;
+        batch.items.push_back(std::move(item));
+    }
+    if (!batch.items.empty()) {
+        copies.tasks.push_back(std::move(batch));
+    }
+    if (!copies.tasks.empty()) {
+        plan.stages.push_back(std::move(copies));
+    }
+}
+
+static void PlanDirectoryDelete(const FileOperationCommand& command, const FileOperationOptions& options,
+                                const WalkResult& walk, FileOperationPlan& plan)
+{
+    // Kedalaman 0: semua file dan link direktori (link dihapus, targetnya tidak disentuh)
+    std::vector<std::vector<FileOperationItem>> levels(1);
+    for (const WalkEntry& entry : walk.files) {
+        FileOperationItem item;
+        item.step = FILEOPS_STEP_DELETE_FILE;
+        item.source = JoinPath(command.source, entry.relative);
+        levels[0].push_back(std::move(item));
+    }
+    for (const WalkEntry& entry : walk.links) {
+        FileOperationItem item;
+        item.step = FILEOPS_STEP_REMOVE_DIRECTORY;
+        item.source = JoinPath(command.source, entry.relative);
+        levels[0].push_back(std::move(item));
+    }
+
+    // Direktori: index = kedalaman, dijalankan terdalam dulu; root paling akhir
+    std::vector<std::vector<FileOperationItem>> directories(1);
+    FileOperationItem root;
+    root.step = FILEOPS_STEP_REMOVE_DIRECTORY;
+    root.source = command.source;
+    directories[0].push_back(std::move(root));
+    for (const WalkEntry& entry : walk.directories) {
+        if (directories.size() <= entry.depth) directories.resize(entry.depth + 1);
+        FileOperationItem item;
+        item.step = FILEOPS_STEP_REMOVE_DIRECTORY;
+        item.source = JoinPath(command.source, entry.relative);
+        directories[entry.depth].push_back(std::move(item));
+    }
+
+    AddDepthStages(levels, true, options.metadataBatchSize, plan);
+    AddDepthStages(directories, false, options.metadataBatchSize, plan);
+}
+
+bool PlanFileOperation(const FileOperationCommand& command, const FileOperationOptions& options,
+                       FileOperationPlan& plan)
+{
+    plan = FileOperationPlan();
+    plan.line = command.line;
+    IFileOperationBackend* fo = GetFileOperationBackend();
+
+    // Sumber dibaca di bawah token yang sama dengan eksekusi
+    FileOperationEntry source = {};
+    bool found = false;
+    uint32_t error = 0;
+    RunImpersonatedWorkers(1, options.token, [&](unsigned, uint32_t impersonationError) {
+        found = impersonationError == 0 && fo->QueryPath(command.source, source);
+        error = impersonationError != 0 ? impersonationError : (found ? 0 : fo->GetLastErrorCode());
+    });
+    if (!found) {
+        FileOperationError failure;
+        failure.line = command.line;
+        failure.step = FILEOPS_STEP_LIST;
+        failure.path = command.source;
+        failure.code = error;
+        plan.errors.push_back(std::move(failure));
+        return false;
+    }
+
+    // File (atau link direktori untuk move/delete): satu item tanpa walk
+    if (!source.isDirectory || command.kind == FILEOPS_MOVE ||
+        (command.kind == FILEOPS_DELETE && source.isReparsePoint)) {
+        std::wstring destination = command.destination;
+        if (command.kind != FILEOPS_DELETE) {
+            FileOperationEntry target = {};
+            bool targetIsDirectory = false;
+            RunImpersonatedWorkers(1, options.token, [&](unsigned, uint32_t impersonationError) {
+                targetIsDirectory = impersonationError == 0 && fo->QueryPath(destination, target) &&
+                                    target.isDirectory;
+            });
+            if (targetIsDirectory) {
+                destination = JoinPath(destination, FileNameOf(command.source));
+            }
+        }
+
+        FileOperationItem item;
+        if (command.kind == FILEOPS_COPY) {
+            item = MakeCopyItem(command.source, destination, source.size, options);
+        } else {
+            item.step = command.kind == FILEOPS_MOVE ? FILEOPS_STEP_MOVE :
+                        (source.isDirectory ? FILEOPS_STEP_REMOVE_DIRECTORY : FILEOPS_STEP_DELETE_FILE);
+            item.source = command.source;
+            item.destination = destination;
+        }
+        AddSingleItemStage(std::move(item), plan);
+        return true;
+    }
+
+    WalkResult walk;
+    WalkTree(command.source, command.line, ResolveFileOperationThreadCount(options.threadCount), options.token,
+             walk, plan.tasksStolen);
+    plan.directoriesScanned = walk.scanned;
+    plan.errors = std::move(walk.errors);
+
+    if (command.kind == FILEOPS_COPY) {
+        PlanDirectoryCopy(command, options, walk, plan);
+    } else {
+        PlanDirectoryDelete(command, options, walk, plan);
+    }
+    return true;
+}
+
+//==============================================================================
+// EXECUTION
+//==============================================================================
+
+/**
+ * @brief Counter bersama antar worker eksekusi
+ */
+struct ExecuteCounters {
+    std::atomic<uint64_t> succeeded{0};
+    std::atomic<uint64_t> failed{0};
+    std::atomic<uint64_t> bytes{0};
+    std::atomic<uint64_t> unbuffered{0};
+};
+
+static bool ExecuteItem(IFileOperationBackend* fo, const FileOperationItem& item)
+{
+    switch (item.step) {
+    case FILEOPS_STEP_MAKE_DIRECTORY:   return fo->MakeDirectory(item.destination);
+    case FILEOPS_STEP_COPY_FILE:        return fo->CopyFileContents(item.source, item.destination, item.unbuffered);
+    case FILEOPS_STEP_MOVE:             return fo->MovePath(item.source, item.destination);
+    case FILEOPS_STEP_DELETE_FILE:      return fo->DeletePath(item.source, false);
+    case FILEOPS_STEP_REMOVE_DIRECTORY: return fo->DeletePath(item.source, true);
+    default:                            return false;
+    }
+}
+
+/** @brief Menambahkan error ke report (hanya dihitung setelah batas tercapai) */
+static void AddErrors(std::vector<FileOperationError>& errors, FileOperationReport& report)
+{
+    report.errorCount += errors.size();
+    for (FileOperationError& error : errors) {
+        if (report.errors.size() >= FILEOPS_MAX_REPORTED_ERRORS) break;
+        report.errors.push_back(std::move(error));
+    }
+}
+
+/**
+ * @brief Menjalankan satu stage: task dibagi round-robin, task terbesar diambil lebih dulu
+ */
+static void ExecuteStage(const FileOperationStage& stage, uint32_t line, const FileOperationOptions& options,
+                         ExecuteCounters& counters, FileOperationReport& report)
+{
+    unsigned threadCount = ResolveFileOperationThreadCount(options.threadCount);
+    if (stage.tasks.size() < threadCount) {
+        threadCount = static_cast<unsigned>(stage.tasks.size());
+    }
+    if (threadCount == 0) {
+        return;
+    }
+
+    // Push urut bytes naik: Pop mengambil dari belakang, jadi setiap worker
+    // mulai dari task terbesarnya dan file besar tidak tertinggal di akhir
+    std::vector<size_t> order(stage.tasks.size());
+    for (size_t i = 0; i < order.size(); i++) order[i] = i;
+    std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+        return stage.tasks[a].bytes < stage.tasks[b].bytes;
+    });
+
+    WorkStealingScheduler<size_t> scheduler(threadCount);
+    for (size_t i = 0; i < order.size(); i++) {
+        scheduler.Push(static_cast<unsigned>(i % threadCount), size_t(order[i]));
+    }
+
+    IFileOperationBackend* fo = GetFileOperationBackend();
+    std::vector<std::vector<FileOperationError>> errors(threadCount);
+
+    RunImpersonatedWorkers(threadCount, options.token, [&](unsigned worker, uint32_t impersonationError) {
+        scheduler.RunWorker(worker, [&](size_t index) {
+            for (const FileOperationItem& item : stage.tasks[index].items) {
+                if (impersonationError == 0 && ExecuteItem(fo, item)) {
+                    counters.succeeded++;
+                    if (item.step == FILEOPS_STEP_COPY_FILE) {
+                        counters.bytes += item.size;
+                        if (item.unbuffered) counters.unbuffered++;
+                    }
+                    continue;
+                }
+
+                counters.failed++;
+                FileOperationError error;
+                error.line = line;
+                error.step = item.step;
+                error.path = item.step == FILEOPS_STEP_MAKE_DIRECTORY ? item.destination : item.source;
+                error.code = impersonationError != 0 ? impersonationError : fo->GetLastErrorCode();
+                errors[worker].push_back(std::move(error));
+            }
+        });
+    });
+
+    report.tasksStolen += scheduler.StolenCount();
+    for (std::vector<FileOperationError>& own : errors) {
+        AddErrors(own, report);
+    }
+}
+
+void ExecuteFileOperationPlan(const FileOperationPlan& plan, const FileOperationOptions& options,
+                              FileOperationReport& report)
+{
+    auto start = std::chrono::steady_clock::now();
+
+    ExecuteCounters counters;
+    for (const FileOperationStage& stage : plan.stages) {
+        ExecuteStage(stage, plan.line, options, counters, report);
+    }
+
+    report.itemsSucceeded += counters.succeeded.load();
+    report.itemsFailed += counters.failed.load();
+    report.bytesCopied += counters.bytes.load();
+    report.unbufferedCopies += counters.unbuffered.load();
+    report.executeSeconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+bool RunFileOperations(const std::vector<FileOperationCommand>& commands, const FileOperationOptions& options,
+                       FileOperationReport& report)
+{
+    report = FileOperationReport();
+    report.commandsTotal = static_cast<uint32_t>(commands.size());
+    report.threadCount = ResolveFileOperationThreadCount(options.threadCount);
+
+    for (const FileOperationCommand& command : commands) {
+        auto start = std::chrono::steady_clock::now();
+        FileOperationPlan plan;
+        bool planned = PlanFileOperation(command, options, plan);
+        report.planSeconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        report.itemsPlanned += plan.itemCount;
+        report.directoriesScanned += plan.directoriesScanned;
+        report.reparsePointsSkipped += plan.reparsePointsSkipped;
+        report.tasksStolen += plan.tasksStolen;
+        bool clean = planned && plan.errors.empty();
+        AddErrors(plan.errors, report);
+
+        if (planned) {
+            uint64_t failedBefore = report.itemsFailed;
+            ExecuteFileOperationPlan(plan, options, report);
+            clean = clean && report.itemsFailed == failedBefore;
+        }
+
+        // Baris berikutnya bisa bergantung pada hasil baris ini (copy lalu delete sumber)
+        if (!clean) {
+            return false;
+        }
+        report.commandsCompleted++;
+    }
+    return true;
+}
+
+//==============================================================================
+// REPORT
+//==============================================================================
+
+const char* GetFileOperationStepName(FileOperationStep step)
+{
+    switch (step) {
+    case FILEOPS_STEP_LIST:             return "list";
+    case FILEOPS_STEP_MAKE_DIRECTORY:   return "mkdir";
+    case FILEOPS_STEP_COPY_FILE:        return "copy";
+    case FILEOPS_STEP_MOVE:             return "move";
+    case FILEOPS_STEP_DELETE_FILE:      return "delete";
+    case FILEOPS_STEP_REMOVE_DIRECTORY: return "rmdir";
+    default:                            return "unknown";
+    }
+}
+
+std::string FormatFileOperationReport(const FileOperationReport& report)
+{
+    std::string text;
+    char line[256];
+
+    snprintf(line, sizeof(line), "%u/%u commands completed, %u threads\n",
+             static_cast<unsigned>(report.commandsCompleted), static_cast<unsigned>(report.commandsTotal),
+             report.threadCount);
+    text += line;
+    snprintf(line, sizeof(line), "%llu items planned, %llu succeeded, %llu failed, %llu directories scanned, "
+             "%llu links skipped\n",
+             static_cast<unsigned long long>(report.itemsPlanned),
+             static_cast<unsigned long long>(report.itemsSucceeded),
+             static_cast<unsigned long long>(report.itemsFailed),
+             static_cast<unsigned long long>(report.directoriesScanned),
+             static_cast<unsigned long long>(report.reparsePointsSkipped));
+    text += line;
+    snprintf(line, sizeof(line), "%.1f MB copied (%llu unbuffered files), %.1f MB/s, %.0f items/s, "
+             "plan %.3f s, execute %.3f s\n",
+             report.bytesCopied / (1024.0 * 1024.0), static_cast<unsigned long long>(report.unbufferedCopies),
+             report.BytesPerSecond() / (1024.0 * 1024.0), report.ItemsPerSecond(),
+             report.planSeconds, report.executeSeconds);
+    text += line;
+
+    for (const FileOperationError& error : report.errors) {
+        snprintf(line, sizeof(line), "line %u: %s failed (error %u): ",
+                 static_cast<unsigned>(error.line), GetFileOperationStepName(error.step),
+                 static_cast<unsigned>(error.code));
+        text += line;
+        AppendUtf8(error.path, text);
+        text += '\n';
+    }
+    if (report.errorCount > report.errors.size()) {
+        snprintf(line, sizeof(line), "... %llu more errors\n",
+                 static_cast<unsigned long long>(report.errorCount - report.errors.size()));
+        text += line;
+    }
+    return text;
+}
@@ -14,10 +14,12 @@
 #include <vcl.h>
 #pragma hdrstop
 
-#include <string>
-
+#include <memory>
+#include <thread>
+#include <vector>
 #include "Form.h"
 #include "Core.h"
+#include "OutputCapture.h"
 
 #pragma package(smart_init)
 #pragma resource "*.dfm"
@@ -51,6 +53,42 @@ __fastcall TMain::TMain(TComponent* Owner)
 	// Tampilkan pesan inisialisasi di status memo
 	// Memberi tahu user bahwa aplikasi siap digunakan
 	StatusMemo->Lines->Add("RasTI initialized. Ready to run executables as TrustedInstaller.");
+
+	// Allowlist SHA-256 opsional: RasTI.allowlist di direktori yang sama dengan exe
+	std::wstring allowlistPath = GetDefaultAllowlistPath();
+	if (!allowlistPath.empty() && FileExists(allowlistPath.c_str()))
+	{
+		size_t errorLine = 0;
+		if (LoadExecutableAllowlist(allowlistPath, &errorLine))
+		{
+			StatusMemo->Lines->Add("Hash allowlist aktif: " + IntToStr(static_cast<int>(GetExecutableAllowlistSize())) + " SHA-256");
+		}
+		else
+		{
+			// Fail closed: allowlist kosong tetap aktif sehingga semua executable ditolak
+			String reason = (errorLine > 0) ? "Allowlist tidak valid di baris " + IntToStr(static_cast<int>(errorLine))
+			                                : String("Allowlist tidak dapat dibaca");
+			StatusMemo->Lines->Add(GetErrorMessage(reason + " - semua executable akan ditolak"));
+		}
+	}
+
+	// Policy path opsional: RasTI.policy di direktori yang sama dengan exe
+	std::wstring policyPath = GetDefaultPathPolicyPath();
+	if (!policyPath.empty() && FileExists(policyPath.c_str()))
+	{
+		size_t errorLine = 0;
+		if (LoadPathPolicy(policyPath, &errorLine))
+		{
+			StatusMemo->Lines->Add("Policy path aktif: " + IntToStr(static_cast<int>(GetPathPolicyRuleCount())) + " rule");
+		}
+		else
+		{
+			// Fail closed: policy gagal berisi "deny **" sehingga semua executable ditolak
+			String reason = (errorLine > 0) ? "Policy tidak valid di baris " + IntToStr(static_cast<int>(errorLine))
+			                                : String("Policy tidak dapat dibaca");
+			StatusMemo->Lines->Add(GetErrorMessage(reason + " - semua executable akan ditolak"));
+		}
+	}
 }
 
 
@@ -90,9 +128,10 @@ void __fastcall TMain::RunButtonClick(TObject *Sender)
 	// STEP 1: INPUT VALIDATION - Path executable
 	//======================================================================
 
-	// Ambil dan trim path dari input user
-	AnsiString path = PathEdit->Text.Trim();
-	if (path.IsEmpty())
+	// Ambil path dari input user langsung sebagai UTF-16 (tanpa konversi ANSI)
+	String text = PathEdit->Text.Trim();
+	std::wstring path(text.c_str(), text.Length());
+	if (path.empty())
 	{
 		// VALIDATION FAILED: Path kosong
 		StatusMemo->Lines->Add(GetErrorMessage("Path executable tidak boleh kosong"));
@@ -114,10 +153,24 @@ void __fastcall TMain::RunButtonClick(TObject *Sender)
 	// STEP 3: COMPREHENSIVE EXECUTABLE VALIDATION
 	//======================================================================
 
-	if (!ValidateExecutablePath(path))
+	// Handle file tervalidasi tetap terbuka sampai launch (STEP 6)
+	ValidatedExecutable validated;
+	if (!ValidateExecutablePath(path, validated))
 	{
 		// VALIDATION FAILED: Path tidak aman atau executable tidak valid
-		StatusMemo->Lines->Add(GetErrorMessage("Path executable tidak aman atau tidak valid: " + path));
+		StatusMemo->Lines->Add(GetErrorMessage("Path executable tidak aman atau tidak valid: " + String(path.c_str())));
+		if (validated.policy.decision == POLICY_DECISION_DENIED)
+		{
+			StatusMemo->Lines->Add("Lokasi ditolak oleh rule policy baris " + IntToStr(static_cast<int>(validated.policy.ruleLine)));
+		}
+		else if (validated.policy.decision == POLICY_DECISION_NOT_ALLOWED)
+		{
+			StatusMemo->Lines->Add("Lokasi tidak cocok dengan rule allow di policy");
+		}
+		else if (validated.hasSha256)
+		{
+			StatusMemo->Lines->Add("SHA-256 tidak terdaftar di allowlist: " + String(Sha256ToHex(validated.sha256).c_str()));
+		}
 		StatusMemo->Lines->Add("Pastikan file executable valid dan path tidak mengandung karakter berbahaya");
 		return;
 	}
@@ -156,46 +209,29 @@ void __fastcall TMain::RunButtonClick(TObject *Sender)
 
 	// Tampilkan header operasi
 	StatusMemo->Lines->Add("=========================================");
-	StatusMemo->Lines->Add("Menjalankan: " + path);
+	StatusMemo->Lines->Add("Menjalankan: " + String(validated.path.c_str()));
 	StatusMemo->Lines->Add("Priority: " + PriorityCombo->Text);
 	StatusMemo->Lines->Add(""); // Baris kosong untuk readability
 
-	//======================================================================
-	// STEP 6: STRING CONVERSION - ANSI ke Unicode
-	//======================================================================
-
-	// Hitung ukuran buffer yang dibutuhkan untuk konversi ke wide string
-	int wPathLen = MultiByteToWideChar(CP_ACP, 0, path.c_str(), -1, NULL, 0);
-	if (wPathLen == 0 || wPathLen > MAX_PATH) {
-		StatusMemo->Lines->Add(GetErrorMessage("Failed to convert path to wide string or path too long"));
-		return;
-	}
-
-	// Alokasikan buffer untuk wide string
-	std::wstring wPath(wPathLen, 0);
-
-	// Lakukan konversi ANSI ke Unicode
-	int result = MultiByteToWideChar(CP_ACP, 0, path.c_str(), -1, &wPath[0], wPathLen);
-	if (result == 0) {
-		StatusMemo->Lines->Add(GetErrorMessage("Failed to convert path to wide string"));
+	// Capture output: proses berjalan di worker, output masuk ke StatusMemo
+	if (CaptureCheck->Checked)
+	{
+		StartCapturedLaunch(validated.path, priority);
 		return;
 	}
 
-	// Remove null terminator dari akhir string
-	wPath.resize(wPathLen - 1);
-
 	//======================================================================
-	// STEP 7: EXECUTE PRIVILEGE ESCALATION
+	// STEP 6: EXECUTE PRIVILEGE ESCALATION
 	//======================================================================
 
 	// Log status: mulai mendapatkan Trusted Installer token
 	StatusMemo->Lines->Add("[+] Mendapatkan TrustedInstaller token...");
 
-	// EXECUTE: Jalankan proses dengan Trusted Installer privileges
-	bool success = CreateProcessWithTIToken(wPath.c_str(), priority);
+	// EXECUTE: Jalankan file yang sama persis dengan yang sudah divalidasi
+	bool success = CreateProcessWithTIToken(validated, priority);
 
 	//======================================================================
-	// STEP 8: REPORT RESULTS
+	// STEP 7: REPORT RESULTS
 	//======================================================================
 
 	if (success)
@@ -216,6 +252,128 @@ void __fastcall TMain::RunButtonClick(TObject *Sender)
 }
 
 
+/**
+ * @brief Menjalankan executable dengan stdout/stderr di-capture ke StatusMemo
+ *
+ * Akuisisi token dan pump capture berjalan di worker thread agar UI tetap
+ * responsif selama proses berjalan. Worker hanya memegang HWND form; setiap
+ * chunk dikirim sebagai satu salinan lewat PostMessage (bukan per baris) dan
+ * ditambahkan ke memo oleh WMCaptureOutput. Executable divalidasi ulang oleh
+ * engine capture sehingga policy dan allowlist tetap berlaku.
+ *
+ * @param path Canonical path hasil validasi
+ * @param priority Priority class proses
+ */
+void TMain::StartCapturedLaunch(const std::wstring& path, DWORD priority)
+{
+	RunButton->Enabled = false;
+	StatusMemo->Lines->Add("[+] Mendapatkan TrustedInstaller token (output di-capture)...");
+
+	HWND window = Handle;
+	std::thread([window, path, priority]() {
+		std::string summary;
+		bool succeeded = false;
+		if (!EnableSupportedPrivilege(false, SeImpersonatePrivilege))
+		{
+			summary = "[-] Gagal mengaktifkan SeImpersonatePrivilege (Error Code: " + std::to_string(GetLastError()) + ")\n";
+		}
+		else
+		{
+			IProcessBackend* ps = GetProcessBackend();
+			ScopedBackendObject token(ps, AcquireTrustedInstallerToken());
+			if (!token.IsValid())
+			{
+				summary = "[-] Gagal mendapatkan TrustedInstaller token (Error Code: " + std::to_string(ps->GetLastErrorCode()) + ")\n";
+			}
+			else
+			{
+				std::vector<CaptureLaunch> launches(1);
+				launches[0].path = path;
+				CaptureOptions options;
+				options.token = token.Get();
+				options.creationFlags = priority;
+
+				CaptureReport report;
+				succeeded = RunCapturedLaunches(launches, options,
+					[window](size_t, CaptureStream, std::string_view data) {
+						std::string* chunk = new std::string(data);
+						if (!PostMessage(window, WM_RASTI_CAPTURE_OUTPUT, 0, reinterpret_cast<LPARAM>(chunk))) {
+							delete chunk; // Form sudah ditutup
+						}
+					}, report);
+				summary = FormatCaptureReport(report);
+			}
+		}
+
+		std::string* text = new std::string(summary);
+		if (!PostMessage(window, WM_RASTI_CAPTURE_DONE, succeeded ? 1 : 0, reinterpret_cast<LPARAM>(text))) {
+			delete text;
+		}
+	}).detach();
+}
+
+/**
+ * @brief Menambahkan output mentah ke akhir StatusMemo
+ *
+ * @param data Bytes output apa adanya dari pipe
+ * @param codePage Code page data (output console memakai OEM, report memakai UTF-8)
+ */
+void TMain::AppendCapturedOutput(const std::string& data, UINT codePage)
+{
+	int length = MultiByteToWideChar(codePage, 0, data.data(), static_cast<int>(data.size()), NULL, 0);
+	if (length <= 0)
+	{
+		return;
+	}
+
+	String text;
+	text.SetLength(length);
+	MultiByteToWideChar(codePage, 0, data.data(), static_cast<int>(data.size()), text.c_str(), length);
+
+	// SelText menambahkan di tempat tanpa membangun ulang seluruh isi memo
+	StatusMemo->SelStart = StatusMemo->GetTextLen();
+	StatusMemo->SelLength = 0;
+	StatusMemo->SelText = AdjustLineBreaks(text);
+}
+
+/**
+ * @brief Handler WM_RASTI_CAPTURE_OUTPUT: satu chunk output dari worker capture
+ */
+void __fastcall TMain::WMCaptureOutput(TMessage& Message)
+{
+	std::unique_ptr<std::string> chunk(reinterpret_cast<std::string*>(Message.LParam));
+	AppendCapturedOutput(*chunk);
+}
+
+/**
+ * @brief Handler WM_RASTI_CAPTURE_DONE: report capture dan status akhir
+ */
+void __fastcall TMain::WMCaptureDone(TMessage& Message)
+{
+	std::unique_ptr<std::string> summary(reinterpret_cast<std::string*>(Message.LParam));
+
+	// Output terakhir mungkin tidak diakhiri newline
+	String current = StatusMemo->Text;
+	if (!current.IsEmpty() && current[current.Length()] != L'\n')
+	{
+		AppendCapturedOutput("\r\n");
+	}
+	AppendCapturedOutput(*summary, CP_UTF8);
+
+	if (Message.WParam)
+	{
+		StatusMemo->Lines->Add("[+] Proses selesai dengan exit code 0");
+	}
+	else
+	{
+		StatusMemo->Lines->Add(GetErrorMessage("Proses gagal dijalankan atau keluar dengan exit code bukan 0"));
+	}
+	StatusMemo->Lines->Add("=========================================");
+	StatusMemo->Lines->Add("");
+	RunButton->Enabled = true;
+}
+
+
 /**
  * @brief Event handler untuk tombol Clear Log
  *
@@ -0,0 +1,194 @@
+/**
+ * @file HashAllowlist.cpp
+ * @brief Implementasi allowlist SHA-256, cache hash, dan hashing file streaming
+ *
+ * @author RasTI Development Team
+ * @version 1.2.0.0
+ * @date 2025
+ */
+
+#include "HashAllowlist.h"
+#include <vector>
+
+//==============================================================================
+// ACTIVE ALLOWLIST
+//==============================================================================
+
+/** @brief Allowlist yang dipasang secara eksplisit (NULL = tidak ada pemeriksaan hash) */
+static const HashAllowlist* gExecutableAllowlist = nullptr;
+
+void SetExecutableAllowlist(const HashAllowlist* allowlist)
+{
+    gExecutableAllowlist = allowlist;
+}
+
+const HashAllowlist* GetExecutableAllowlist()
+{
+    return gExecutableAllowlist;
+}
+
+//==============================================================================
+// ALLOWLIST PARSING
+//==============================================================================
+
+static bool IsBlank(char ch)
+{
+    return ch == ' ' || ch == '\t' || ch == '\r';
+}
+
+bool HashAllowlist::LoadFromText(std::string_view text, size_t* errorLine)
+{
+    size_t lineNumber = 0;
+    size_t start = 0;
+
+    // UTF-8 BOM dari editor Windows
+    if (text.substr(0, 3) == "\xEF\xBB\xBF") {
+        start = 3;
+    }
+
+    while (start < text.size()) {
+        size_t end = text.find('\n', start);
+        if (end == std::string_view::npos) end = text.size();
+        std::string_view line = text.substr(start, end - start);
+        start = end + 1;
+        lineNumber++;
+
+        size_t first = 0;
+        while (first < line.size() && IsBlank(line[first])) first++;
+        if (first == line.size() || line[first] == '#') continue;
+
+        size_t last = first;
+        while (last < line.size() && !IsBlank(line[last])) last++;
+
+        Sha256Digest digest;
+        if (!ParseSha256Hex(line.substr(first, last - first), digest)) {
+            // SECURITY: Allowlist rusak tidak boleh diterapkan sebagian
+            digests_.clear();
+            if (errorLine) *errorLine = lineNumber;
+            return false;
+        }
+        digests_.insert(digest);
+    }
+
+    if (errorLine) *errorLine = 0;
+    return true;
+}
+
+bool HashAllowlist::LoadFromFile(std::wstring_view path, size_t* errorLine)
+{
+    if (errorLine) *errorLine = 0;
+
+    std::string text;
+    if (!ReadSmallFile(GetFileSystemBackend(), std::wstring(path), ALLOWLIST_MAX_FILE_SIZE, text)) {
+        digests_.clear();
+        return false;
+    }
+
+    return LoadFromText(text, errorLine);
+}
+
+//==============================================================================
+// FILE HASH CACHE
+//==============================================================================
+
+bool FileHashCache::Lookup(const FileIdentity& identity, Sha256Digest& digest) const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = entries_.find(MakeKey(identity));
+    if (it == entries_.end()) {
+        return false;
+    }
+    digest = it->second;
+    return true;
+}
+
+void FileHashCache::Store(const FileIdentity& identity, const Sha256Digest& digest)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    // Batas sederhana: versi lama file yang sama tidak pernah dipakai lagi,
+    // jadi cukup kosongkan cache saat penuh
+    if (entries_.size() >= HASH_CACHE_MAX_ENTRIES) {
+        entries_.clear();
+    }
+    entries_[MakeKey(identity)] = digest;
+}
+
+size_t FileHashCache::Size() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return entries_.size();
+}
+
+void FileHashCache::Clear()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    entries_.clear();
+}
+
+FileHashCache& GetFileHashCache()
+{
+    static FileHashCache cache;
+    return cache;
+}
+
+//==============================================================================
+// FILE HASHING
+//==============================================================================
+
+bool ComputeFileSha256(IFileSystemBackend* fs, OsHandle file, uint64_t fileSize, Sha256Digest& digest)
+{
+    Sha256 hasher;
+    uint64_t offset = 0;
+
+    // Jalur utama: hash langsung dari view memory-mapped
+    while (offset < fileSize) {
+        uint64_t remaining = fileSize - offset;
+        uint32_t chunk = (remaining < HASH_MAP_CHUNK_SIZE) ? static_cast<uint32_t>(remaining) : HASH_MAP_CHUNK_SIZE;
+
+        const uint8_t* view = fs->MapFileView(file, offset, chunk);
+        if (!view) {
+            break; // Lanjutkan dari offset ini dengan ReadFileAt
+        }
+        hasher.Update(view, chunk);
+        fs->UnmapFileView(view, chunk);
+        offset += chunk;
+    }
+
+    // Fallback: read biasa dengan buffer tetap
+    if (offset < fileSize) {
+        std::vector<uint8_t> buffer(HASH_READ_CHUNK_SIZE);
+        while (offset < fileSize) {
+            uint64_t remaining = fileSize - offset;
+            uint32_t chunk = (remaining < HASH_READ_CHUNK_SIZE) ? static_cast<uint32_t>(remaining) : HASH_READ_CHUNK_SIZE;
+
+            uint32_t bytesRead = 0;
+            if (!fs->ReadFileAt(file, offset, buffer.data(), chunk, bytesRead) || bytesRead != chunk) {
+                return false; // File berubah ukuran atau read gagal
+            }
+            hasher.Update(buffer.data(), bytesRead);
+            offset += bytesRead;
+        }
+    }
+
+    digest = hasher.Final();
+    return true;
+}
+
+bool GetCachedFileSha256(IFileSystemBackend* fs, OsHandle file, const FileIdentity& identity,
+                         Sha256Digest& digest, bool* fromCache)
+{
+    FileHashCache& cache = GetFileHashCache();
+    if (cache.Lookup(identity, digest)) {
+        if (fromCache) *fromCache = true;
+        return true;
+    }
+
+    if (fromCache) *fromCache = false;
+    if (!ComputeFileSha256(fs, file, identity.fileSize, digest)) {
+        return false;
+    }
+
+    cache.Store(identity, digest);
+    return true;
+}
@@ -0,0 +1,268 @@
+/**
+ * @file LaunchBenchmark.cpp
+ * @brief Implementasi benchmark latency launch end-to-end
+ *
+ * @author RasTI Development Team
+ * @version 1.2.0.0
+ * @date 2025
+ */
+
+#include "LaunchBenchmark.h"
+#include "HashAllowlist.h"
+#include "TrustedInstaller.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+
+//==============================================================================
+// PERCENTILES
+//==============================================================================
+
+const char* GetLaunchPhaseName(LaunchPhase phase)
+{
+    switch (phase) {
+    case LAUNCH_PHASE_VALIDATE: return "validate";
+    case LAUNCH_PHASE_ACQUIRE:  return "acquire";
+    case LAUNCH_PHASE_LAUNCH:   return "launch";
+    case LAUNCH_PHASE_TOTAL:    return "total";
+    default:                    return "unknown";
+    }
+}
+
+/** @brief Nilai rank ke-ceil(p * n) (nearest-rank) dari sampel terurut */
+static double NearestRank(const std::vector<double>& sorted, double percentile)
+{
+    size_t rank = static_cast<size_t>(std::ceil(percentile / 100.0 * sorted.size()));
+    return sorted[std::min(std::max<size_t>(rank, 1), sorted.size()) - 1];
+}
+
+LatencyPercentiles ComputeLatencyPercentiles(std::vector<double>& samplesUs)
+{
+    LatencyPercentiles result;
+    result.samples = samplesUs.size();
+    if (samplesUs.empty()) {
+        return result;
+    }
+
+    std::sort(samplesUs.begin(), samplesUs.end());
+    result.p50Us = NearestRank(samplesUs, 50.0);
+    result.p90Us = NearestRank(samplesUs, 90.0);
+    result.p99Us = NearestRank(samplesUs, 99.0);
+    result.maxUs = samplesUs.back();
+    return result;
+}
+
+//==============================================================================
+// BENCHMARK
+//==============================================================================
+
+typedef std::chrono::steady_clock BenchmarkClock;
+
+/** @brief Durasi dalam mikrodetik */
+static double MicrosecondsBetween(BenchmarkClock::time_point start, BenchmarkClock::time_point end)
+{
+    return std::chrono::duration<double, std::micro>(end - start).count();
+}
+
+/** @brief Sampel latency satu jalur, satu vector per fase */
+struct PhaseSamples {
+    std::vector<double> phases[LAUNCH_PHASE_COUNT];
+    std::vector<double> commitKb;
+    uint32_t launchesByApi[LAUNCH_API_COUNT] = {};
+};
+
+/**
+ * @brief Satu siklus validate + acquire + launch
+ *
+ * @param cache NULL = jalur cold (akuisisi penuh, token ditutup di akhir siklus)
+ * @param launcher NULL = jalur cold (launcher baru, probe API di setiap siklus)
+ * @param samples Output sampel (NULL = siklus pemanasan, tidak dicatat)
+ */
+static bool RunLaunchCycle(const LaunchBenchmarkOptions& options, TrustedInstallerTokenCache* cache,
+                           TrustedInstallerLauncher* launcher, PhaseSamples* samples, LaunchBenchmarkReport& report)
+{
+    IProcessBackend* ps = GetProcessBackend();
+    BenchmarkClock::time_point start = BenchmarkClock::now();
+
+    // FASE 1: Validasi (handle tetap terbuka sampai launch, seperti CLI)
+    ValidatedExecutable validated;
+    ValidationError validation = ValidateExecutable(options.targetPath, validated);
+    BenchmarkClock::time_point validatedAt = BenchmarkClock::now();
+    if (validation != VALIDATION_OK) {
+        report.failedPhase = LAUNCH_PHASE_VALIDATE;
+        report.errorCode = static_cast<uint32_t>(validation);
+        return false;
+    }
+
+    // FASE 2: Token - rantai penuh (cold) atau cache (warm)
+    OsHandle token = OS_INVALID_HANDLE;
+    if (cache) {
+        token = cache->Acquire();
+    } else if (EnableSupportedPrivilege(false, SeImpersonatePrivilege)) {
+        token = AcquireTrustedInstallerToken();
+    }
+    ScopedBackendObject ownedToken(ps, cache ? OS_INVALID_HANDLE : token); // Token cache milik cache
+    BenchmarkClock::time_point acquiredAt = BenchmarkClock::now();
+    if (token == OS_INVALID_HANDLE) {
+        report.failedPhase = LAUNCH_PHASE_ACQUIRE;
+        report.errorCode = ps->GetLastErrorCode();
+        return false;
+    }
+
+    // FASE 3: Launch dengan argumen yang sama seperti LaunchValidatedExecutable
+    std::wstring commandLine = L"\"" + validated.path + L"\"";
+    if (!options.arguments.empty()) {
+        commandLine += L" " + options.arguments;
+    }
+    std::wstring applicationName;
+    if (validated.kind == EXECUTABLE_KIND_PE_IMAGE) {
+        applicationName = ToExtendedLengthPath(validated.path);
+    }
+
+    ConsoleMode console = ResolveConsoleMode(options.console, validated);
+    uint64_t commitBefore = 0;
+    bool hasCommit = options.commitProbe && options.commitProbe(commitBefore);
+    BenchmarkClock::time_point launchStart = BenchmarkClock::now(); // Probe di luar fase launch
+
+    TrustedInstallerLauncher coldLauncher(options.launchApi);
+    ProcessLaunchApi usedApi = LAUNCH_API_AUTO;
+    bool launched = LaunchWithToken(token, applicationName, commandLine, options.priority, NULL, NULL, console,
+                                    launcher ? launcher : &coldLauncher, &usedApi);
+    BenchmarkClock::time_point launchedAt = BenchmarkClock::now();
+    uint64_t commitAfter = 0;
+    hasCommit = hasCommit && launched && options.commitProbe(commitAfter);
+    if (!launched) {
+        report.failedPhase = LAUNCH_PHASE_LAUNCH;
+        report.errorCode = ps->GetLastErrorCode();
+        return false;
+    }
+
+    coldLauncher.Reset();
+    ownedToken.Reset();
+    BenchmarkClock::time_point end = BenchmarkClock::now();
+
+    if (samples) {
+        samples->phases[LAUNCH_PHASE_VALIDATE].push_back(MicrosecondsBetween(start, validatedAt));
+        samples->phases[LAUNCH_PHASE_ACQUIRE].push_back(MicrosecondsBetween(validatedAt, acquiredAt));
+        samples->phases[LAUNCH_PHASE_LAUNCH].push_back(MicrosecondsBetween(launchStart, launchedAt));
+        samples->phases[LAUNCH_PHASE_TOTAL].push_back(MicrosecondsBetween(start, end));
+        if (hasCommit) {
+            samples->commitKb.push_back((static_cast<double>(commitAfter) - static_cast<double>(commitBefore)) / 1024.0);
+        }
+        samples->launchesByApi[usedApi]++;
+    }
+    return true;
+}
+
+/** @brief Mengisi ringkasan jalur dari sampel */
+static void SummarizePath(PhaseSamples& samples, LaunchBenchmarkPath& path)
+{
+    for (int phase = 0; phase < LAUNCH_PHASE_COUNT; phase++) {
+        path.phases[phase] = ComputeLatencyPercentiles(samples.phases[phase]);
+    }
+    path.commitKb = ComputeLatencyPercentiles(samples.commitKb);
+    path.completed = static_cast<uint32_t>(path.phases[LAUNCH_PHASE_TOTAL].samples);
+    for (int api = 0; api < LAUNCH_API_COUNT; api++) {
+        path.launchesByApi[api] = samples.launchesByApi[api];
+    }
+}
+
+bool RunLaunchBenchmark(const LaunchBenchmarkOptions& options, LaunchBenchmarkReport& report)
+{
+    report = LaunchBenchmarkReport();
+    BenchmarkClock::time_point start = BenchmarkClock::now();
+
+    PhaseSamples coldSamples;
+    PhaseSamples warmSamples;
+    TrustedInstallerTokenCache cache;
+    TrustedInstallerLauncher launcher(options.launchApi);
+    bool success = true;
+
+    // JALUR COLD: hash cache kosong dan akuisisi token penuh setiap siklus
+    for (uint32_t i = 0; success && i < options.iterations; i++) {
+        GetFileHashCache().Clear();
+        success = RunLaunchCycle(options, NULL, NULL, &coldSamples, report);
+    }
+
+    // JALUR WARM: satu siklus pemanasan mengisi cache, lalu siklus terukur
+    if (success && options.iterations > 0) {
+        success = EnableSupportedPrivilege(false, SeImpersonatePrivilege);
+        if (!success) {
+            report.failedPhase = LAUNCH_PHASE_ACQUIRE;
+            report.errorCode = GetProcessBackend()->GetLastErrorCode();
+        }
+        success = success && RunLaunchCycle(options, &cache, &launcher, NULL, report);
+    }
+    for (uint32_t i = 0; success && i < options.iterations; i++) {
+        success = RunLaunchCycle(options, &cache, &launcher, &warmSamples, report);
+    }
+    launcher.Reset();
+    cache.Invalidate();
+
+    SummarizePath(coldSamples, report.cold);
+    SummarizePath(warmSamples, report.warm);
+    report.failed = !success;
+    report.elapsedSeconds = std::chrono::duration<double>(BenchmarkClock::now() - start).count();
+    return success;
+}
+
+std::string FormatLaunchBenchmarkReport(const LaunchBenchmarkReport& report)
+{
+    std::string text;
+    char line[160];
+
+    snprintf(line, sizeof(line), "%-6s %-9s %8s %12s %12s %12s %12s\n",
+             "path", "phase", "samples", "p50 (us)", "p90 (us)", "p99 (us)", "max (us)");
+    text += line;
+
+    const LaunchBenchmarkPath* paths[] = { &report.cold, &report.warm };
+    const char* pathNames[] = { "cold", "warm" };
+    for (int p = 0; p < 2; p++) {
+        for (int phase = 0; phase < LAUNCH_PHASE_COUNT; phase++) {
+            const LatencyPercentiles& stats = paths[p]->phases[phase];
+            snprintf(line, sizeof(line), "%-6s %-9s %8u %12.1f %12.1f %12.1f %12.1f\n",
+                     pathNames[p], GetLaunchPhaseName(static_cast<LaunchPhase>(phase)),
+                     static_cast<unsigned>(stats.samples), stats.p50Us, stats.p90Us, stats.p99Us, stats.maxUs);
+            text += line;
+        }
+    }
+
+    // Tabel memori hanya jika commitProbe dipasang
+    if (report.cold.commitKb.samples > 0 || report.warm.commitKb.samples > 0) {
+        snprintf(line, sizeof(line), "%-6s %-9s %8s %12s %12s %12s %12s\n",
+                 "path", "memory", "samples", "p50 (KB)", "p90 (KB)", "p99 (KB)", "max (KB)");
+        text += line;
+        for (int p = 0; p < 2; p++) {
+            const LatencyPercentiles& stats = paths[p]->commitKb;
+            snprintf(line, sizeof(line), "%-6s %-9s %8u %12.1f %12.1f %12.1f %12.1f\n",
+                     pathNames[p], "commit", static_cast<unsigned>(stats.samples),
+                     stats.p50Us, stats.p90Us, stats.p99Us, stats.maxUs);
+            text += line;
+        }
+    }
+
+    // API yang membuat proses: seclogon menambah satu RPC per launch
+    for (int p = 0; p < 2; p++) {
+        if (paths[p]->completed == 0) {
+            continue;
+        }
+        snprintf(line, sizeof(line), "%-6s launch api: %s %u, %s %u\n", pathNames[p],
+                 GetProcessLaunchApiName(LAUNCH_API_AS_USER),
+                 static_cast<unsigned>(paths[p]->launchesByApi[LAUNCH_API_AS_USER]),
+                 GetProcessLaunchApiName(LAUNCH_API_SECLOGON),
+                 static_cast<unsigned>(paths[p]->launchesByApi[LAUNCH_API_SECLOGON]));
+        text += line;
+    }
+
+    if (report.failed) {
+        snprintf(line, sizeof(line), "FAILED in %s phase (error %u)\n",
+                 GetLaunchPhaseName(report.failedPhase), static_cast<unsigned>(report.errorCode));
+        text += line;
+    }
+    snprintf(line, sizeof(line), "%u cold + %u warm cycles in %.2f s\n",
+             static_cast<unsigned>(report.cold.completed), static_cast<unsigned>(report.warm.completed),
+             report.elapsedSeconds);
+    text += line;
+    return text;
+}
@@ -0,0 +1,606 @@
+/**
+ * @file LaunchGraph.cpp
+ * @brief Implementasi /graph: parser manifest, scheduler graf, dan report critical path
+ *
+ * Scheduler tidak memakai thread: node diputuskan (selesai, gagal, atau
+ * di-skip) satu per satu, dan setiap keputusan mengurangi jumlah dependensi
+ * yang belum selesai pada node turunannya. Node yang dependensinya habis
+ * masuk antrian siap (urutan manifest); node dengan dependensi after-success
+ * yang tidak berhasil langsung di-skip dan keputusan itu diteruskan.
+ *
+ * @author RasTI Development Team
+ * @version 1.2.0.0
+ * @date 2025
+ */
+
+#include "LaunchGraph.h"
+#include "TextEncoding.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <map>
+#include <set>
+
+//==============================================================================
+// MANIFEST PARSER
+//==============================================================================
+
+static bool IsBlank(wchar_t ch)
+{
+    return ch == L' ' || ch == L'\t' || ch == L'\r';
+}
+
+/** @brief Mengambil satu token (diapit kutip atau dipisah blank) dari awal line */
+static bool NextToken(std::wstring_view& line, std::wstring& token)
+{
+    while (!line.empty() && IsBlank(line.front())) line.remove_prefix(1);
+    if (line.empty()) {
+        return false;
+    }
+
+    size_t end = 0;
+    if (line.front() == L'"') {
+        end = line.find(L'"', 1);
+        if (end == std::wstring_view::npos) {
+            return false; // Kutip tidak ditutup
+        }
+        token.assign(line.substr(1, end - 1));
+        line.remove_prefix(end + 1);
+        return line.empty() || IsBlank(line.front());
+    }
+
+    while (end < line.size() && !IsBlank(line[end])) end++;
+    token.assign(line.substr(0, end));
+    line.remove_prefix(end);
+    return token.find(L'"') == std::wstring::npos;
+}
+
+static bool HasControlCharacter(std::wstring_view text)
+{
+    for (wchar_t ch : text) {
+        if (ch < 0x20 || ch == 0x7F) return true;
+    }
+    return false;
+}
+
+/** @brief Argumen script: cmd.exe mengekspansi % dan ^ bahkan di dalam kutip */
+static bool IsCmdSafe(std::wstring_view text)
+{
+    return text.find_first_of(L"%^\"") == std::wstring_view::npos;
+}
+
+/** @brief Nama node: [A-Za-z0-9_.-], 1-LAUNCH_GRAPH_MAX_NAME karakter */
+static bool ToNodeName(const std::wstring& token, std::string& name)
+{
+    if (token.empty() || token.size() > LAUNCH_GRAPH_MAX_NAME) {
+        return false;
+    }
+    name.clear();
+    for (wchar_t ch : token) {
+        bool valid = (ch >= L'A' && ch <= L'Z') || (ch >= L'a' && ch <= L'z') || (ch >= L'0' && ch <= L'9') ||
+                     ch == L'_' || ch == L'.' || ch == L'-';
+        if (!valid) {
+            return false;
+        }
+        name += static_cast<char>(ch);
+    }
+    return true;
+}
+
+/** @brief Detik 1-86400 (hanya digit) */
+static bool ParseTimeoutSeconds(const std::wstring& token, uint32_t& seconds)
+{
+    if (token.empty() || token.size() > 5) {
+        return false;
+    }
+    seconds = 0;
+    for (wchar_t ch : token) {
+        if (ch < L'0' || ch > L'9') return false;
+        seconds = seconds * 10 + static_cast<uint32_t>(ch - L'0');
+    }
+    return seconds >= 1 && seconds <= 86400;
+}
+
+namespace {
+
+/** @brief Edge atau timeout yang namanya di-resolve setelah semua node terbaca */
+struct PendingReference {
+    uint32_t line = 0;
+    std::string node;
+    std::string target;                     /**< Nama dependensi (edge) */
+    LaunchDependencyKind kind = LAUNCH_AFTER_SUCCESS;
+    uint32_t seconds = 0;                   /**< Timeout (target kosong) */
+};
+
+} // namespace
+
+/** @brief Parse satu baris manifest yang sudah di-decode */
+static bool ParseGraphLine(std::wstring_view line, uint32_t lineNumber, LaunchGraph& graph,
+                           std::map<std::string, size_t>& names, std::vector<PendingReference>& references)
+{
+    std::wstring verb;
+    std::wstring token;
+    std::string name;
+    if (!NextToken(line, verb) || !NextToken(line, token) || !ToNodeName(token, name)) {
+        return false;
+    }
+
+    if (verb == L"node") {
+        LaunchGraphNode node;
+        node.name = name;
+        node.line = lineNumber;
+        if (names.count(name) || !NextToken(line, node.path) || node.path.empty() ||
+            HasControlCharacter(node.path)) {
+            return false;
+        }
+        ExecutableKind kind = GetExecutableKind(node.path);
+        if (kind == EXECUTABLE_KIND_UNKNOWN) {
+            return false;
+        }
+
+        std::wstring argument;
+        while (true) {
+            while (!line.empty() && IsBlank(line.front())) line.remove_prefix(1);
+            if (line.empty()) break;
+            if (!NextToken(line, argument) || HasControlCharacter(argument) ||
+                (kind == EXECUTABLE_KIND_SCRIPT && !IsCmdSafe(argument))) {
+                return false;
+            }
+            node.arguments.push_back(argument);
+        }
+        names[name] = graph.nodes.size();
+        graph.nodes.push_back(std::move(node));
+        return true;
+    }
+
+    if (verb == L"after-success" || verb == L"after-exit") {
+        PendingReference reference;
+        reference.line = lineNumber;
+        reference.node = name;
+        reference.kind = (verb == L"after-exit") ? LAUNCH_AFTER_EXIT : LAUNCH_AFTER_SUCCESS;
+        size_t count = 0;
+        while (true) {
+            while (!line.empty() && IsBlank(line.front())) line.remove_prefix(1);
+            if (line.empty()) break;
+            if (!NextToken(line, token) || !ToNodeName(token, reference.target)) {
+                return false;
+            }
+            references.push_back(reference);
+            count++;
+        }
+        return count > 0;
+    }
+
+    if (verb == L"timeout") {
+        PendingReference reference;
+        reference.line = lineNumber;
+        reference.node = name;
+        if (!NextToken(line, token) || !ParseTimeoutSeconds(token, reference.seconds)) {
+            return false;
+        }
+        while (!line.empty() && IsBlank(line.front())) line.remove_prefix(1);
+        references.push_back(reference);
+        return line.empty();
+    }
+
+    return false;
+}
+
+/**
+ * @brief Urutan topologis (Kahn); false jika ada siklus
+ *
+ * @param errorLine Output baris edge pertama yang ikut siklus
+ */
+static bool SortLaunchGraph(LaunchGraph& graph, uint32_t& errorLine)
+{
+    size_t count = graph.nodes.size();
+    std::vector<size_t> remaining(count, 0);
+    std::vector<std::vector<size_t>> dependents(count);
+    for (size_t i = 0; i < count; i++) {
+        remaining[i] = graph.nodes[i].dependencies.size();
+        for (const LaunchDependency& dependency : graph.nodes[i].dependencies) {
+            dependents[dependency.node].push_back(i);
+        }
+    }
+
+    std::set<size_t> ready;
+    for (size_t i = 0; i < count; i++) {
+        if (remaining[i] == 0) ready.insert(i);
+    }
+    graph.order.clear();
+    while (!ready.empty()) {
+        size_t node = *ready.begin();
+        ready.erase(ready.begin());
+        graph.order.push_back(node);
+        for (size_t dependent : dependents[node]) {
+            if (--remaining[dependent] == 0) ready.insert(dependent);
+        }
+    }
+    if (graph.order.size() == count) {
+        return true;
+    }
+
+    // Node yang tersisa berada di siklus atau di belakangnya; laporkan edge
+    // paling awal di antara node tersisa
+    errorLine = 0;
+    for (size_t i = 0; i < count; i++) {
+        if (remaining[i] == 0) continue;
+        for (const LaunchDependency& dependency : graph.nodes[i].dependencies) {
+            if (remaining[dependency.node] != 0 && (errorLine == 0 || dependency.line < errorLine)) {
+                errorLine = dependency.line;
+            }
+        }
+    }
+    return false;
+}
+
+bool ParseLaunchGraph(std::string_view text, LaunchGraph& graph, size_t* errorLine)
+{
+    graph = LaunchGraph();
+    std::map<std::string, size_t> names;
+    std::vector<PendingReference> references;
+    uint32_t lineNumber = 0;
+    uint32_t invalidLine = 0;
+    size_t start = 0;
+    std::wstring decoded;
+
+    // UTF-8 BOM dari editor Windows
+    if (text.substr(0, 3) == "\xEF\xBB\xBF") {
+        start = 3;
+    }
+
+    while (invalidLine == 0 && start < text.size()) {
+        size_t end = text.find('\n', start);
+        if (end == std::string_view::npos) end = text.size();
+        std::string_view rawLine = text.substr(start, end - start);
+        start = end + 1;
+        lineNumber++;
+
+        if (!DecodeUtf8(rawLine, decoded)) {
+            invalidLine = lineNumber;
+            break;
+        }
+
+        std::wstring_view line(decoded);
+        while (!line.empty() && IsBlank(line.front())) line.remove_prefix(1);
+        if (line.empty() || line.front() == L'#') continue;
+
+        if (!ParseGraphLine(line, lineNumber, graph, names, references)) {
+            invalidLine = lineNumber;
+        }
+    }
+
+    // Edge dan timeout boleh merujuk node yang dideklarasikan belakangan
+    std::set<size_t> timedNodes;
+    for (size_t i = 0; invalidLine == 0 && i < references.size(); i++) {
+        const PendingReference& reference = references[i];
+        auto node = names.find(reference.node);
+        if (node == names.end()) {
+            invalidLine = reference.line;
+        } else if (reference.target.empty()) {
+            if (!timedNodes.insert(node->second).second) {
+                invalidLine = reference.line; // Timeout ganda
+            }
+            graph.nodes[node->second].timeoutMs = reference.seconds * 1000;
+        } else {
+            auto target = names.find(reference.target);
+            if (target == names.end() || target->second == node->second) {
+                invalidLine = reference.line;
+            } else {
+                LaunchDependency dependency;
+                dependency.node = target->second;
+                dependency.kind = reference.kind;
+                dependency.line = reference.line;
+                graph.nodes[node->second].dependencies.push_back(dependency);
+            }
+        }
+    }
+
+    if (invalidLine == 0 && graph.nodes.empty()) {
+        invalidLine = lineNumber + 1; // Manifest tanpa node
+    }
+    if (invalidLine == 0) {
+        SortLaunchGraph(graph, invalidLine);
+    }
+
+    if (invalidLine != 0) {
+        // Graf rusak tidak boleh dijalankan sebagian
+        graph = LaunchGraph();
+        if (errorLine) *errorLine = invalidLine;
+        return false;
+    }
+
+    if (errorLine) *errorLine = 0;
+    return true;
+}
+
+bool LoadLaunchGraph(std::wstring_view path, LaunchGraph& graph, size_t* errorLine)
+{
+    graph = LaunchGraph();
+    if (errorLine) *errorLine = 0;
+
+    std::string text;
+    if (!ReadSmallFile(GetFileSystemBackend(), std::wstring(path), LAUNCH_GRAPH_MAX_FILE_SIZE, text)) {
+        return false;
+    }
+    return ParseLaunchGraph(text, graph, errorLine);
+}
+
+//==============================================================================
+// SCHEDULER
+//==============================================================================
+
+namespace {
+
+typedef std::chrono::steady_clock Clock;
+
+double SecondsBetween(Clock::time_point start, Clock::time_point end)
+{
+    return std::chrono::duration<double>(end - start).count();
+}
+
+/** @brief Proses node yang sedang berjalan */
+struct RunningNode {
+    size_t node = 0;
+    OsHandle process = OS_INVALID_HANDLE;
+    Clock::time_point deadline = Clock::time_point::max();
+};
+
+} // namespace
+
+bool RunLaunchGraph(const LaunchGraph& graph, const LaunchGraphOptions& options, LaunchGraphReport& report)
+{
+    IProcessBackend* ps = GetProcessBackend();
+    Clock::time_point started = Clock::now();
+    size_t count = graph.nodes.size();
+    report = LaunchGraphReport();
+    report.results.resize(count);
+
+    std::vector<std::vector<std::pair<size_t, LaunchDependencyKind>>> dependents(count);
+    std::vector<size_t> remaining(count, 0);
+    std::vector<bool> blocked(count, false);   // Ada dependensi after-success yang tidak berhasil
+    std::vector<bool> decided(count, false);
+    std::set<size_t> ready;                    // Urutan manifest
+    for (size_t i = 0; i < count; i++) {
+        remaining[i] = graph.nodes[i].dependencies.size();
+        for (const LaunchDependency& dependency : graph.nodes[i].dependencies) {
+            dependents[dependency.node].push_back(std::make_pair(i, dependency.kind));
+        }
+        if (remaining[i] == 0) ready.insert(i);
+    }
+
+    // Lebih dari PROCESS_WAIT_MAX_OBJECTS proses tidak dapat ditunggu dengan satu wait
+    size_t maxRunning = PROCESS_WAIT_MAX_OBJECTS;
+    if (options.maxRunning != 0 && options.maxRunning < maxRunning) {
+        maxRunning = options.maxRunning;
+    }
+
+    // Keputusan satu node diteruskan ke turunannya; turunan yang terblokir
+    // langsung di-skip dan diteruskan lagi
+    auto decide = [&](size_t node, LaunchNodeStatus status, Clock::time_point now) {
+        double seconds = SecondsBetween(started, now);
+        report.results[node].status = status;
+        report.results[node].endSeconds = seconds;
+        std::vector<size_t> pending(1, node);
+        while (!pending.empty()) {
+            size_t current = pending.back();
+            pending.pop_back();
+            decided[current] = true;
+            const LaunchNodeResult& result = report.results[current];
+            if (result.Succeeded()) {
+                report.nodesSucceeded++;
+            } else if (result.status == LAUNCH_NODE_SKIPPED) {
+                report.nodesSkipped++;
+            } else {
+                report.nodesFailed++;
+            }
+
+            for (const auto& edge : dependents[current]) {
+                LaunchNodeResult& next = report.results[edge.first];
+                if (edge.second == LAUNCH_AFTER_SUCCESS && !result.Succeeded()) {
+                    blocked[edge.first] = true;
+                }
+                next.gatedBy = current;
+                next.readySeconds = seconds;
+                if (--remaining[edge.first] != 0) continue;
+                if (blocked[edge.first]) {
+                    next.status = LAUNCH_NODE_SKIPPED;
+                    next.startSeconds = seconds;
+                    next.endSeconds = seconds;
+                    pending.push_back(edge.first);
+                } else {
+                    ready.insert(edge.first);
+                }
+            }
+        }
+    };
+
+    TrustedInstallerLauncher launcher(options.api);
+    std::vector<RunningNode> running;
+    auto startReady = [&]() {
+        while (!ready.empty() && running.size() < maxRunning) {
+            size_t node = *ready.begin();
+            ready.erase(ready.begin());
+            const LaunchGraphNode& spec = graph.nodes[node];
+            LaunchNodeResult& result = report.results[node];
+            Clock::time_point now = Clock::now();
+            result.startSeconds = SecondsBetween(started, now);
+
+            // Handle validasi tetap terbuka sampai proses dibuat
+            ValidatedExecutable validated;
+            result.validation = ValidateExecutable(spec.path, validated);
+            if (result.validation != VALIDATION_OK) {
+                decide(node, LAUNCH_NODE_REJECTED, now);
+                continue;
+            }
+
+            ProcessLaunchRequest request = BuildValidatedLaunchRequest(validated, spec.arguments,
+                                                                       options.creationFlags);
+            ApplyConsoleMode(ResolveConsoleMode(options.console, validated), request);
+            RunningNode state;
+            state.node = node;
+            if (!launcher.Launch(options.token, request, &result.processId, &state.process)) {
+                result.errorCode = ps->GetLastErrorCode();
+                decide(node, LAUNCH_NODE_FAILED, Clock::now());
+                continue;
+            }
+
+            uint32_t timeoutMs = spec.timeoutMs ? spec.timeoutMs : options.timeoutMs;
+            if (timeoutMs) {
+                state.deadline = now + std::chrono::milliseconds(timeoutMs);
+            }
+            running.push_back(state);
+            report.peakRunning = std::max<uint64_t>(report.peakRunning, running.size());
+        }
+    };
+
+    startReady();
+    std::vector<OsHandle> handles;
+    while (!running.empty()) {
+        // Timeout tunggu = deadline node terdekat
+        Clock::time_point deadline = Clock::time_point::max();
+        handles.clear();
+        for (const RunningNode& state : running) {
+            deadline = std::min(deadline, state.deadline);
+            handles.push_back(state.process);
+        }
+        uint32_t waitMs = 0xFFFFFFFF;
+        if (deadline != Clock::time_point::max()) {
+            Clock::time_point now = Clock::now();
+            int64_t left = deadline > now ? std::chrono::ceil<std::chrono::milliseconds>(deadline - now).count() : 0;
+            waitMs = static_cast<uint32_t>(std::min<int64_t>(left, 0xFFFFFFFE));
+        }
+
+        size_t index = 0;
+        uint32_t exitCode = 0;
+        bool exited = ps->WaitForAnyProcessExit(handles, waitMs, index, exitCode);
+        uint32_t error = exited ? 0 : ps->GetLastErrorCode();
+        Clock::time_point now = Clock::now();
+
+        if (exited) {
+            RunningNode state = running[index];
+            running.erase(running.begin() + index);
+            ps->CloseObject(state.process);
+            report.results[state.node].exitCode = exitCode;
+            decide(state.node, LAUNCH_NODE_COMPLETED, now);
+        } else if (error == OS_ERROR_WAIT_TIMEOUT) {
+            for (auto it = running.begin(); it != running.end();) {
+                if (it->deadline > now) {
+                    ++it;
+                    continue;
+                }
+                RunningNode state = *it;
+                it = running.erase(it);
+                ps->TerminateProcess(state.process, OS_ERROR_WAIT_TIMEOUT);
+                ps->CloseObject(state.process);
+                decide(state.node, LAUNCH_NODE_TIMED_OUT, now);
+            }
+        } else {
+            // Tanpa wait tidak ada node yang dapat diputuskan: hentikan semua
+            // proses dan jangan mulai node baru
+            for (const RunningNode& state : running) {
+                ps->TerminateProcess(state.process, error);
+                ps->CloseObject(state.process);
+                report.results[state.node].errorCode = error;
+            }
+            for (const RunningNode& state : running) {
+                decide(state.node, LAUNCH_NODE_FAILED, now);
+            }
+            running.clear();
+            ready.clear();
+            break;
+        }
+        startReady();
+    }
+
+    // Hanya tersisa setelah wait gagal: node yang belum dimulai di-skip
+    for (size_t i = 0; i < count; i++) {
+        if (!decided[i]) {
+            report.results[i].status = LAUNCH_NODE_SKIPPED;
+            report.results[i].endSeconds = SecondsBetween(started, Clock::now());
+            report.nodesSkipped++;
+        }
+    }
+
+    // Critical path: mundur dari node yang selesai terakhir lewat dependensi
+    // yang selesai terakhir (gatedBy)
+    size_t last = LAUNCH_GRAPH_NO_NODE;
+    for (size_t i = 0; i < count; i++) {
+        if (last == LAUNCH_GRAPH_NO_NODE || report.results[i].endSeconds > report.results[last].endSeconds) {
+            last = i;
+        }
+    }
+    for (size_t node = last; node != LAUNCH_GRAPH_NO_NODE; node = report.results[node].gatedBy) {
+        report.criticalPath.push_back(node);
+    }
+    std::reverse(report.criticalPath.begin(), report.criticalPath.end());
+
+    report.seconds = SecondsBetween(started, Clock::now());
+    return report.nodesSucceeded == count;
+}
+
+//==============================================================================
+// REPORT
+//==============================================================================
+
+const char* GetLaunchNodeStatusName(LaunchNodeStatus status)
+{
+    switch (status)
+    {
+    case LAUNCH_NODE_COMPLETED: return "completed";
+    case LAUNCH_NODE_SKIPPED:   return "skipped";
+    case LAUNCH_NODE_REJECTED:  return "rejected";
+    case LAUNCH_NODE_FAILED:    return "failed";
+    case LAUNCH_NODE_TIMED_OUT: return "timed-out";
+    default:                    return "unknown";
+    }
+}
+
+std::string FormatLaunchGraphReport(const LaunchGraph& graph, const LaunchGraphReport& report)
+{
+    std::string text;
+    char line[256];
+
+    for (size_t i = 0; i < report.results.size() && i < graph.nodes.size(); i++) {
+        const LaunchNodeResult& result = report.results[i];
+        const char* name = graph.nodes[i].name.c_str();
+        if (result.status == LAUNCH_NODE_SKIPPED) {
+            snprintf(line, sizeof(line), "[%s] skipped at %.3f s\n", name, result.endSeconds);
+        } else if (result.status == LAUNCH_NODE_REJECTED) {
+            snprintf(line, sizeof(line), "[%s] rejected (%s)\n", name, GetValidationErrorName(result.validation));
+        } else if (result.status == LAUNCH_NODE_FAILED) {
+            snprintf(line, sizeof(line), "[%s] failed (error %u)\n", name, static_cast<unsigned>(result.errorCode));
+        } else if (result.status == LAUNCH_NODE_TIMED_OUT) {
+            snprintf(line, sizeof(line), "[%s] timed-out after %.3f s, pid %u\n", name,
+                     result.endSeconds - result.startSeconds, static_cast<unsigned>(result.processId));
+        } else {
+            snprintf(line, sizeof(line), "[%s] exit %u, pid %u, ready %.3f s, ran %.3f-%.3f s\n", name,
+                     static_cast<unsigned>(result.exitCode), static_cast<unsigned>(result.processId),
+                     result.readySeconds, result.startSeconds, result.endSeconds);
+        }
+        text += line;
+    }
+
+    snprintf(line, sizeof(line), "%llu/%llu nodes succeeded, %llu failed, %llu skipped, %.3f s, peak %llu running\n",
+             static_cast<unsigned long long>(report.nodesSucceeded),
+             static_cast<unsigned long long>(report.results.size()),
+             static_cast<unsigned long long>(report.nodesFailed),
+             static_cast<unsigned long long>(report.nodesSkipped), report.seconds,
+             static_cast<unsigned long long>(report.peakRunning));
+    text += line;
+
+    // Per node di critical path: antri = tertahan maxRunning, jalan = durasi proses
+    if (!report.criticalPath.empty()) {
+        const LaunchNodeResult& end = report.results[report.criticalPath.back()];
+        snprintf(line, sizeof(line), "critical path %.3f s:\n", end.endSeconds);
+        text += line;
+        for (size_t node : report.criticalPath) {
+            const LaunchNodeResult& result = report.results[node];
+            snprintf(line, sizeof(line), "  %-24s queued %.3f s, ran %.3f s (%s)\n", graph.nodes[node].name.c_str(),
+                     result.startSeconds - result.readySeconds, result.endSeconds - result.startSeconds,
+                     GetLaunchNodeStatusName(result.status));
+            text += line;
+        }
+    }
+    return text;
+}
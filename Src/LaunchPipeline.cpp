@@ -0,0 +1,215 @@
+/**
+ * @file LaunchPipeline.cpp
+ * @brief Implementasi launch suspended dengan tahap konfigurasi ber-timing
+ *
+ * @author RasTI Development Team
+ * @version 1.2.0.0
+ * @date 2025
+ */
+
+#include "LaunchPipeline.h"
+#include <chrono>
+#include <cstdio>
+
+//==============================================================================
+// STAGES
+//==============================================================================
+
+const char* GetProcessSettingName(ProcessSetting setting)
+{
+    switch (setting) {
+    case PROCESS_SETTING_PRIORITY_CLASS:  return "priority";
+    case PROCESS_SETTING_AFFINITY:        return "affinity";
+    case PROCESS_SETTING_IO_PRIORITY:     return "io-priority";
+    case PROCESS_SETTING_MEMORY_PRIORITY: return "memory-priority";
+    default:                              return "unknown";
+    }
+}
+
+bool JobLaunchStage::Apply(LaunchStageContext& context) const
+{
+    OsHandle job = context.backend->CreateJob(limits_);
+    if (job == OS_INVALID_HANDLE) {
+        return false;
+    }
+    // Job ditutup pipeline; tanpa KILL_ON_JOB_CLOSE proses tetap di job setelahnya
+    context.Own(job);
+    return context.backend->AssignProcessToJob(job, context.process);
+}
+
+const char* ProcessSettingLaunchStage::GetName() const
+{
+    return GetProcessSettingName(setting_);
+}
+
+bool ProcessSettingLaunchStage::Apply(LaunchStageContext& context) const
+{
+    return context.backend->SetProcessSetting(context.process, setting_, value_);
+}
+
+//==============================================================================
+// PIPELINE
+//==============================================================================
+
+typedef std::chrono::steady_clock PipelineClock;
+
+/** @brief Mencatat durasi satu tahap sejak start */
+static void AppendTiming(LaunchPipelineResult& result, const char* name, PipelineClock::time_point start,
+                         bool succeeded)
+{
+    LaunchStageTiming timing;
+    timing.name = name;
+    timing.microseconds = std::chrono::duration<double, std::micro>(PipelineClock::now() - start).count();
+    timing.succeeded = succeeded;
+    result.stages.push_back(timing);
+}
+
+/** @brief Menutup semua object milik pipeline (job, ...) */
+static void CloseOwnedObjects(LaunchStageContext& context)
+{
+    for (OsHandle object : context.objects) {
+        context.backend->CloseObject(object);
+    }
+    context.objects.clear();
+}
+
+bool LaunchPipeline::Launch(TrustedInstallerLauncher& launcher, OsHandle token, const ProcessLaunchRequest& request,
+                            uint32_t* processId, OsHandle* process, ProcessLaunchApi* usedApi,
+                            LaunchPipelineResult* result) const
+{
+    IProcessBackend* ps = GetProcessBackend();
+    LaunchPipelineResult local;
+    LaunchPipelineResult& report = result ? *result : local;
+    report = LaunchPipelineResult();
+
+    // STEP 1: Buat proses suspended - thread utama belum menjalankan satu instruksi pun
+    ProcessLaunchRequest suspendedRequest = request;
+    suspendedRequest.creationFlags |= PROCESS_CREATE_SUSPENDED;
+
+    LaunchStageContext context;
+    context.backend = ps;
+    PipelineClock::time_point start = PipelineClock::now();
+    bool success = launcher.Launch(token, suspendedRequest, &context.processId, &context.process, usedApi);
+    AppendTiming(report, "create", start, success);
+    if (!success) {
+        report.failedStage = "create";
+        report.errorCode = ps->GetLastErrorCode();
+        return false;
+    }
+
+    // STEP 2: Tahap konfigurasi berurutan, masing-masing diukur
+    size_t completed = 0;
+    for (; completed < stages_.size(); completed++) {
+        const ILaunchStage& stage = *stages_[completed];
+        start = PipelineClock::now();
+        success = stage.Apply(context);
+        AppendTiming(report, stage.GetName(), start, success);
+        if (!success) {
+            report.failedStage = stage.GetName();
+            break;
+        }
+    }
+
+    // STEP 3: Resume thread utama
+    if (success) {
+        start = PipelineClock::now();
+        success = ps->ResumeProcess(context.process);
+        AppendTiming(report, "resume", start, success);
+        if (!success) {
+            report.failedStage = "resume";
+        }
+    }
+
+    if (!success) {
+        // Rollback tahap yang berhasil (urutan terbalik), terminate proses yang
+        // belum pernah berjalan, lalu kembalikan error tahap yang gagal
+        uint32_t error = ps->GetLastErrorCode();
+        while (completed > 0) {
+            stages_[--completed]->Rollback(context);
+        }
+        ps->TerminateProcess(context.process, error);
+        report.rolledBack = true;
+        CloseOwnedObjects(context);
+        ps->CloseObject(context.process);
+        report.errorCode = error;
+        ps->SetLastErrorCode(error);
+        return false;
+    }
+
+    CloseOwnedObjects(context);
+    if (processId) {
+        *processId = context.processId;
+    }
+    if (process) {
+        *process = context.process;
+    } else {
+        ps->CloseObject(context.process);
+    }
+    return true;
+}
+
+//==============================================================================
+// SETTINGS
+//==============================================================================
+
+void ConfigureLaunchPipeline(const LaunchStageSettings& settings, LaunchPipeline& pipeline)
+{
+    if (settings.jobMemoryLimit != 0) {
+        ProcessJobLimits limits;
+        limits.processMemoryLimit = settings.jobMemoryLimit;
+        pipeline.Add(std::unique_ptr<ILaunchStage>(new JobLaunchStage(limits)));
+    }
+    if (settings.affinityMask != 0) {
+        pipeline.Add(std::unique_ptr<ILaunchStage>(
+            new ProcessSettingLaunchStage(PROCESS_SETTING_AFFINITY, settings.affinityMask)));
+    }
+    if (settings.ioPriority != LAUNCH_SETTING_UNSET) {
+        pipeline.Add(std::unique_ptr<ILaunchStage>(
+            new ProcessSettingLaunchStage(PROCESS_SETTING_IO_PRIORITY, settings.ioPriority)));
+    }
+    if (settings.memoryPriority != LAUNCH_SETTING_UNSET) {
+        pipeline.Add(std::unique_ptr<ILaunchStage>(
+            new ProcessSettingLaunchStage(PROCESS_SETTING_MEMORY_PRIORITY, settings.memoryPriority)));
+    }
+}
+
+/** @brief Nama prioritas I/O; index = nilai IoPriorityHint */
+static const char* const IO_PRIORITY_NAMES[] = {"verylow", "low", "normal"};
+
+bool ParseIoPriority(std::string_view name, uint32_t& ioPriority)
+{
+    for (size_t i = 0; i < sizeof(IO_PRIORITY_NAMES) / sizeof(IO_PRIORITY_NAMES[0]); i++) {
+        std::string_view candidate(IO_PRIORITY_NAMES[i]);
+        if (name.size() != candidate.size()) {
+            continue;
+        }
+        bool equal = true;
+        for (size_t j = 0; equal && j < name.size(); j++) {
+            char ch = name[j];
+            if (ch >= 'A' && ch <= 'Z') ch = ch - 'A' + 'a';
+            equal = (ch == candidate[j]);
+        }
+        if (equal) {
+            ioPriority = static_cast<uint32_t>(i);
+            return true;
+        }
+    }
+    return false;
+}
+
+std::string FormatLaunchPipelineResult(const LaunchPipelineResult& result)
+{
+    std::string text;
+    char line[160];
+    for (const LaunchStageTiming& stage : result.stages) {
+        snprintf(line, sizeof(line), "  %-16s %10.1f us%s\n", stage.name.c_str(), stage.microseconds,
+                 stage.succeeded ? "" : "  FAILED");
+        text += line;
+    }
+    if (!result.failedStage.empty()) {
+        snprintf(line, sizeof(line), "FAILED in %s stage (error %u)%s\n", result.failedStage.c_str(),
+                 result.errorCode, result.rolledBack ? ", process terminated before running" : "");
+        text += line;
+    }
+    return text;
+}
@@ -5,6 +5,18 @@
  * File ini berisi WinMain function dan logika dual-mode aplikasi:
  * - GUI Mode: Menampilkan form utama dengan interface VCL
  * - CLI Mode: Menjalankan executable langsung dari command line
+ * - Audit Mode: Validasi massal paralel (/audit) dengan report CSV/JSON
+ * - Benchmark Mode: Latency launch end-to-end per fase (/bench)
+ * - Trace: Rekam semua panggilan backend launch/bench ke file (/trace)
+ * - File Operations: Copy/move/delete massal paralel sebagai Trusted Installer (/fileops)
+ * - ACL Reset: Reset owner + DACL satu pohon sebagai Trusted Installer (/aclreset)
+ * - Registry Import: Import file .reg in-process sebagai Trusted Installer (/regimport)
+ * - Script Host: Banyak script .bat/.cmd/.ps1 per interpreter sebagai Trusted Installer (/scripthost)
+ * - Capture: stdout/stderr proses TI ke console atau log file (/capture, /batch)
+ * - Launch pipeline: job, affinity, prioritas I/O dan memori sebelum resume (/affinity, ...)
+ * - Launch graph: banyak proses TI dengan dependensi, timeout, dan batas paralel (/graph)
+ * - Adjust: prioritas, affinity, dan prioritas I/O/memori proses yang sudah berjalan (/adjust)
+ * - Sessions: satu executable TI ke setiap session user yang logon dengan satu token (/sessions)
  *
  * Aplikasi dapat berjalan dalam dua mode tergantung parameter command line.
  *
@@ -16,9 +28,26 @@
 #include <vcl.h>
 #pragma hdrstop
 #include <tchar.h>
+#include <algorithm>
 #include <string>
 #include <cctype>
+#include <cstdio>
+#include <memory>
+#include <atomic>
+#include <vector>
 #include "Core.h"
+#include "BackendTrace.h"
+#include "FileOperations.h"
+#include "AclReset.h"
+#include "RegistryImport.h"
+#include "ScriptHost.h"
+#include "OutputCapture.h"
+#include "LaunchPipeline.h"
+#include "LaunchGraph.h"
+#include "Supervisor.h"
+#include "ProcessAdjust.h"
+#include "SessionLaunch.h"
+#include "SingleInstance.h"
 //---------------------------------------------------------------------------
 USEFORM("GUI.cpp", Main);  /**< Form utama untuk GUI mode */
 //---------------------------------------------------------------------------
@@ -28,7 +57,133 @@ USEFORM("GUI.cpp", Main);  /**< Form utama untuk GUI mode */
 //==============================================================================
 
 /** @brief Forward declaration untuk function CLI execution */
-bool RunExecutableFromCommandLine(const AnsiString& exePath, int priority);
+bool RunExecutableFromCommandLine(const String& exePath, int priority, ConsoleMode console,
+	ProcessLaunchApi launchApi, const LaunchStageSettings& stageSettings, const String& tracePath,
+	SingleInstanceMode single);
+
+/** @brief Forward declaration untuk function audit massal */
+bool RunAuditFromCommandLine(const String& target, BulkOutputFormat format,
+	const String& outputPath, unsigned threadCount);
+
+/** @brief Forward declaration untuk function benchmark latency launch */
+bool RunBenchmarkFromCommandLine(unsigned iterations, const String& target, int priority,
+	ConsoleMode console, ProcessLaunchApi launchApi, const String& tracePath);
+
+/** @brief Forward declaration untuk function operasi file massal */
+bool RunFileOperationsFromCommandLine(const String& scriptPath, unsigned threadCount);
+
+/** @brief Forward declaration untuk function reset owner + DACL */
+bool RunAclResetFromCommandLine(const String& root, const String& sddl, const String& checkpointPath,
+	unsigned threadCount);
+
+/** @brief Forward declaration untuk function import registry */
+bool RunRegistryImportFromCommandLine(const std::vector<String>& files, bool dryRun);
+
+/** @brief Forward declaration untuk function script host persisten */
+bool RunScriptHostFromCommandLine(const String& jobFile, unsigned jobsPerHost, unsigned timeoutSeconds,
+	int priority);
+
+/** @brief Forward declaration untuk function launch dengan output di-capture */
+bool RunCaptureFromCommandLine(const String& target, bool listFile, const String& logDirectory,
+	unsigned logSizeMb, unsigned maxRunning, unsigned timeoutSeconds, int priority, ConsoleMode console,
+	SingleInstanceMode single, bool accounting, const String& outputPath);
+
+/** @brief Forward declaration untuk function graf dependensi launch */
+bool RunLaunchGraphFromCommandLine(const String& manifestPath, unsigned maxRunning, unsigned timeoutSeconds,
+	int priority, ConsoleMode console, ProcessLaunchApi launchApi);
+
+/** @brief Forward declaration untuk function supervisor restart */
+bool RunSupervisorFromCommandLine(const String& listPath, const String& logDirectory, unsigned logSizeMb,
+	unsigned backoffSeconds, unsigned crashLoopLimit, const String& metricsPath, int priority, ConsoleMode console);
+
+/** @brief Forward declaration untuk function adjust proses yang berjalan */
+bool RunProcessAdjustFromCommandLine(const std::vector<String>& selectors, const ProcessAdjustment& adjustment);
+
+/** @brief Forward declaration untuk function launch ke banyak session */
+bool RunSessionLaunchFromCommandLine(const String& exePath, const SessionSelection& selection, int priority,
+	ConsoleMode console);
+
+//==============================================================================
+// COMMAND LINE HELPERS
+//==============================================================================
+
+/**
+ * @brief Mode CLI yang ditentukan oleh argumen pertama
+ *
+ * Nilai berupa bit agar pemeriksaan "parameter ini tidak boleh dipakai
+ * dengan mode X, Y, Z" cukup satu mask (lihat CommandModeIn).
+ */
+enum CommandMode {
+	COMMAND_MODE_LAUNCH     = 0x000, /**< "path\to\executable" (termasuk /sessions) */
+	COMMAND_MODE_AUDIT      = 0x001, /**< /audit:DIR|LISTFILE */
+	COMMAND_MODE_FILEOPS    = 0x002, /**< /fileops:SCRIPT */
+	COMMAND_MODE_ACLRESET   = 0x004, /**< /aclreset:DIR */
+	COMMAND_MODE_REGIMPORT  = 0x008, /**< /regimport:FILE */
+	COMMAND_MODE_SCRIPTHOST = 0x010, /**< /scripthost:JOBFILE */
+	COMMAND_MODE_BATCH      = 0x020, /**< /batch:LISTFILE */
+	COMMAND_MODE_GRAPH      = 0x040, /**< /graph:MANIFEST */
+	COMMAND_MODE_SUPERVISE  = 0x080, /**< /supervise:LISTFILE */
+	COMMAND_MODE_ADJUST     = 0x100, /**< /adjust:SELECTOR */
+	COMMAND_MODE_BENCH      = 0x200  /**< /bench:N */
+};
+
+/** @brief Mode massal yang tidak me-launch proses (tanpa /priority) */
+static const unsigned COMMAND_MODES_BULK =
+	COMMAND_MODE_AUDIT | COMMAND_MODE_FILEOPS | COMMAND_MODE_ACLRESET | COMMAND_MODE_REGIMPORT;
+
+/** @brief Mode tanpa output yang dapat di-capture (tanpa /capture dan /logsize) */
+static const unsigned COMMAND_MODES_NO_CAPTURE =
+	COMMAND_MODES_BULK | COMMAND_MODE_SCRIPTHOST | COMMAND_MODE_BENCH | COMMAND_MODE_GRAPH | COMMAND_MODE_ADJUST;
+
+/** @brief Tentukan mode CLI dari prefix argumen pertama (/mode: atau -mode:) */
+static CommandMode GetCommandMode(const AnsiString& firstParam)
+{
+	static const struct { const char* prefix; CommandMode mode; } modes[] = {
+		{ "audit:", COMMAND_MODE_AUDIT },           { "fileops:", COMMAND_MODE_FILEOPS },
+		{ "aclreset:", COMMAND_MODE_ACLRESET },     { "regimport:", COMMAND_MODE_REGIMPORT },
+		{ "scripthost:", COMMAND_MODE_SCRIPTHOST }, { "batch:", COMMAND_MODE_BATCH },
+		{ "graph:", COMMAND_MODE_GRAPH },           { "supervise:", COMMAND_MODE_SUPERVISE },
+		{ "adjust:", COMMAND_MODE_ADJUST },         { "bench:", COMMAND_MODE_BENCH }
+	};
+	for (size_t i = 0; i < sizeof(modes) / sizeof(modes[0]); i++) {
+		if (firstParam.Pos(AnsiString("/") + modes[i].prefix) == 1 ||
+			firstParam.Pos(AnsiString("-") + modes[i].prefix) == 1) {
+			return modes[i].mode;
+		}
+	}
+	return COMMAND_MODE_LAUNCH;
+}
+
+/** @brief true jika mode termasuk salah satu mode di mask */
+static bool CommandModeIn(CommandMode mode, unsigned mask)
+{
+	return (static_cast<unsigned>(mode) & mask) != 0;
+}
+
+/**
+ * @brief Parse angka desimal setelah ':' pada parameter (misalnya /threads:8)
+ *
+ * @param param     Parameter lengkap termasuk nama
+ * @param maxDigits Panjang maksimum nilai (mencegah overflow StrToIntDef)
+ * @param minValue  Nilai minimum yang diterima
+ * @param maxValue  Nilai maksimum yang diterima
+ * @param value     Output: nilai jika berhasil, tidak diubah jika gagal
+ * @return false jika nilai kosong, bukan digit, terlalu panjang, atau di luar rentang
+ */
+static bool ParseBoundedNumber(const AnsiString& param, int maxDigits, int minValue, int maxValue, int& value)
+{
+	AnsiString valueStr = param.SubString(param.Pos(":") + 1, param.Length());
+	bool isValid = !valueStr.IsEmpty() && valueStr.Length() <= maxDigits;
+	for (int j = 1; isValid && j <= valueStr.Length(); j++) {
+		isValid = isdigit(static_cast<unsigned char>(valueStr[j])) != 0;
+	}
+	int number = isValid ? StrToIntDef(valueStr, 0) : 0;
+	if (!isValid || number < minValue || number > maxValue) {
+		return false;
+	}
+	value = number;
+	return true;
+}
 
 //---------------------------------------------------------------------------
 /**
@@ -39,7 +194,28 @@ bool RunExecutableFromCommandLine(const AnsiString& exePath, int priority);
  * - GUI Mode: Jika tidak ada arguments, tampilkan form utama VCL
  *
  * Command Line Syntax:
- *   RasTI.exe "path\to\executable" [/priority:N]
+ *   RasTI.exe "path\to\executable" [/priority:N] [/allowlist:FILE] [/policy:FILE]
+ *             [/console:auto|new|inherit|none|hidden] [/launchapi:auto|seclogon|asuser]
+ *             [/affinity:HEX] [/iopriority:verylow|low|normal] [/mempriority:1-5] [/jobmemory:MB]
+ *             [/trace:FILE | /capture[:console|DIR] [/logsize:MB] [/accounting]] [/single[:skip|attach]]
+ *   RasTI.exe "path\to\executable" /sessions:all|ID[,ID...] [/priority:N] [/console:MODE]
+ *   RasTI.exe /audit:DIR|LISTFILE [/format:csv|json] [/out:FILE] [/threads:N]
+ *             [/allowlist:FILE] [/policy:FILE]
+ *   RasTI.exe /bench:N [/target:FILE] [/priority:N] [/console:MODE] [/launchapi:API]
+ *             [/allowlist:FILE] [/policy:FILE] [/trace:FILE]
+ *   RasTI.exe /fileops:SCRIPT [/threads:N]
+ *   RasTI.exe /aclreset:DIR /sddl:SDDL [/checkpoint:FILE] [/threads:N]
+ *   RasTI.exe /regimport:FILE [FILE...] [/dryrun]
+ *   RasTI.exe /scripthost:JOBFILE [/recycle:N] [/timeout:SECONDS] [/priority:N]
+ *   RasTI.exe /batch:LISTFILE [/capture:console|DIR] [/logsize:MB] [/parallel:N]
+ *             [/timeout:SECONDS] [/priority:N] [/console:MODE] [/single[:skip|attach]]
+ *             [/accounting] [/out:FILE]
+ *   RasTI.exe /graph:MANIFEST [/parallel:N] [/timeout:SECONDS] [/priority:N] [/console:MODE]
+ *             [/launchapi:API]
+ *   RasTI.exe /supervise:LISTFILE [/capture:console|DIR] [/logsize:MB] [/backoff:SECONDS]
+ *             [/crashloop:N] [/metrics:FILE] [/priority:N] [/console:MODE]
+ *   RasTI.exe /adjust:PID|NAME|PATH [PID|NAME|PATH...] [/priority:N] [/affinity:HEX]
+ *             [/iopriority:verylow|low|normal] [/mempriority:1-5]
  *
  * @param hInstanceCurrent  Handle ke instance aplikasi saat ini
  * @param hInstancePrevious Handle ke instance aplikasi sebelumnya (selalu NULL di modern Windows)
@@ -65,8 +241,136 @@ int WINAPI _tWinMain(HINSTANCE, HINSTANCE, LPTSTR, int)
 			//==================================================================
 
 			// Ambil executable path dari argument pertama
-			AnsiString exePath = ParamStr(1);
+			// Path tetap UTF-16 agar nama file non-ANSI tidak rusak
+			String exePath = ParamStr(1);
 			int priority = NORMAL_PRIORITY_CLASS; // Default priority
+			String allowlistPath; // Kosong = RasTI.allowlist di samping exe (jika ada)
+			String policyPath;    // Kosong = RasTI.policy di samping exe (jika ada)
+			String tracePath;     // Kosong = tanpa rekaman trace backend
+			ConsoleMode consoleMode = CONSOLE_MODE_AUTO; // AUTO = dari subsystem PE (GUI tanpa console)
+			ProcessLaunchApi launchApi = LAUNCH_API_AUTO; // AUTO = CreateProcessAsUserW jika privilege tersedia
+			bool launchApiSet = false;
+			LaunchStageSettings stageSettings; // Kosong = launch langsung tanpa CREATE_SUSPENDED
+			SessionSelection sessionSelection; // /sessions: launch ke session user lain
+			bool sessionsSet = false;
+			SingleInstanceMode singleMode = SINGLE_INSTANCE_OFF; // /single: jangan launch jika image sudah berjalan
+			bool captureAccounting = false; // /accounting: CPU, memory, dan I/O job setiap launch /capture atau /batch
+
+			// Mode dari argumen pertama; tanpa prefix mode = launch executable
+			AnsiString firstParam = exePath;
+			CommandMode commandMode = GetCommandMode(firstParam);
+
+			// Audit mode: argumen pertama /audit:DIR atau /audit:LISTFILE
+			bool auditMode = (commandMode == COMMAND_MODE_AUDIT);
+			String auditTarget = auditMode ? exePath.SubString(exePath.Pos(":") + 1, exePath.Length()) : String();
+			BulkOutputFormat auditFormat = BULK_OUTPUT_CSV;
+			String auditOutput;        // Kosong = stdout
+			unsigned workerThreads = 0; // 0 = semua core (audit, fileops, dan aclreset)
+			if (auditMode && auditTarget.IsEmpty()) {
+				printf("Error: /audit requires a directory or list file.\n");
+				return 1;
+			}
+
+			// File operations mode: /fileops:SCRIPT (copy/move/delete sebagai Trusted Installer)
+			bool fileopsMode = (commandMode == COMMAND_MODE_FILEOPS);
+			String fileopsScript = fileopsMode ? exePath.SubString(exePath.Pos(":") + 1, exePath.Length()) : String();
+			if (fileopsMode && fileopsScript.IsEmpty()) {
+				printf("Error: /fileops requires a script file.\n");
+				return 1;
+			}
+
+			// ACL reset mode: /aclreset:DIR /sddl:SDDL (takeown + icacls /reset sebagai Trusted Installer)
+			bool aclresetMode = (commandMode == COMMAND_MODE_ACLRESET);
+			String aclresetRoot = aclresetMode ? exePath.SubString(exePath.Pos(":") + 1, exePath.Length()) : String();
+			String aclresetSddl;       // Wajib untuk /aclreset
+			String aclresetCheckpoint; // Kosong = tanpa checkpoint
+			if (aclresetMode && aclresetRoot.IsEmpty()) {
+				printf("Error: /aclreset requires a directory.\n");
+				return 1;
+			}
+
+			// Registry import mode: /regimport:FILE [FILE...] (regedit /s tanpa proses baru)
+			bool regimportMode = (commandMode == COMMAND_MODE_REGIMPORT);
+			std::vector<String> regimportFiles;
+			bool regimportDryRun = false;
+			if (regimportMode) {
+				String file = exePath.SubString(exePath.Pos(":") + 1, exePath.Length());
+				if (file.IsEmpty()) {
+					printf("Error: /regimport requires a .reg file.\n");
+					return 1;
+				}
+				regimportFiles.push_back(file);
+			}
+
+			// Script host mode: /scripthost:JOBFILE (satu interpreter per jenis untuk banyak script)
+			bool scripthostMode = (commandMode == COMMAND_MODE_SCRIPTHOST);
+			String scripthostJobs = scripthostMode ? exePath.SubString(exePath.Pos(":") + 1, exePath.Length()) : String();
+			unsigned scripthostRecycle = SCRIPTHOST_DEFAULT_JOBS_PER_HOST;
+			unsigned jobTimeout = 0; // Detik per job (/scripthost), launch (/batch), atau node (/graph), 0 = tanpa batas
+			if (scripthostMode && scripthostJobs.IsEmpty()) {
+				printf("Error: /scripthost requires a job list file.\n");
+				return 1;
+			}
+
+			// Batch mode: /batch:LISTFILE (banyak executable paralel, output selalu di-capture)
+			bool batchMode = (commandMode == COMMAND_MODE_BATCH);
+			String batchList = batchMode ? exePath.SubString(exePath.Pos(":") + 1, exePath.Length()) : String();
+			unsigned batchParallel = 0; // 0 = semua launch sekaligus (/batch dan /graph)
+			String batchOutput;         // Kosong = hasil JSON tidak ditulis
+			if (batchMode && batchList.IsEmpty()) {
+				printf("Error: /batch requires a launch list file.\n");
+				return 1;
+			}
+
+			// Graph mode: /graph:MANIFEST (launch dengan dependensi after-success/after-exit)
+			bool graphMode = (commandMode == COMMAND_MODE_GRAPH);
+			String graphManifest = graphMode ? exePath.SubString(exePath.Pos(":") + 1, exePath.Length()) : String();
+			if (graphMode && graphManifest.IsEmpty()) {
+				printf("Error: /graph requires a manifest file.\n");
+				return 1;
+			}
+
+			// Supervise mode: /supervise:LISTFILE (program di-restart dengan backoff sampai Ctrl+C)
+			bool superviseMode = (commandMode == COMMAND_MODE_SUPERVISE);
+			String superviseList = superviseMode ? exePath.SubString(exePath.Pos(":") + 1, exePath.Length()) : String();
+			unsigned superviseBackoff = 0;    // Detik, 0 = SUPERVISOR_DEFAULT_BACKOFF_MS
+			unsigned superviseCrashLoop = SUPERVISOR_DEFAULT_CRASH_LOOP_LIMIT;
+			String superviseMetrics;          // Kosong = tanpa file snapshot metrics
+			if (superviseMode && superviseList.IsEmpty()) {
+				printf("Error: /supervise requires a program list file.\n");
+				return 1;
+			}
+
+			// Adjust mode: /adjust:SELECTOR [SELECTOR...] (pengaturan proses yang sudah berjalan)
+			bool adjustMode = (commandMode == COMMAND_MODE_ADJUST);
+			std::vector<String> adjustSelectors;
+			bool prioritySet = false; // /adjust hanya mengubah priority class jika /priority diberikan
+			if (adjustMode) {
+				String selector = exePath.SubString(exePath.Pos(":") + 1, exePath.Length());
+				if (selector.IsEmpty()) {
+					printf("Error: /adjust requires a process ID, image name, or executable path.\n");
+					return 1;
+				}
+				adjustSelectors.push_back(selector);
+			}
+
+			// Capture stdout/stderr: /capture[:console] ke console, /capture:DIR ke log per launch
+			bool captureMode = batchMode;
+			String captureDirectory;      // Kosong = console
+			unsigned captureLogSize = 0;  // MB, 0 = CAPTURE_DEFAULT_LOG_SIZE
+
+			// Benchmark mode: /bench:N siklus validate+acquire+launch per jalur token
+			bool benchMode = (commandMode == COMMAND_MODE_BENCH);
+			unsigned benchIterations = 0;
+			String benchTarget; // Kosong = cmd.exe /c exit di direktori system
+			if (benchMode) {
+				int iterationsValue = 0;
+				if (!ParseBoundedNumber(firstParam, 5, 1, 10000, iterationsValue)) {
+					printf("Error: /bench requires a cycle count between 1 and 10000.\n");
+					return 1;
+				}
+				benchIterations = static_cast<unsigned>(iterationsValue);
+			}
 
 			//==================================================================
 			// PARSE COMMAND LINE ARGUMENTS
@@ -75,11 +379,17 @@ int WINAPI _tWinMain(HINSTANCE, HINSTANCE, LPTSTR, int)
 			// Parse additional arguments untuk priority (mulai dari argumen ke-2)
 			for (int i = 2; i <= ParamCount(); i++)
 			{
-				AnsiString param = ParamStr(i);
+				String rawParam = ParamStr(i);
+				AnsiString param = rawParam;
 
 				// Cek apakah parameter adalah priority flag (/priority:N atau -priority:N)
 				if (param.Pos("/priority:") == 1 || param.Pos("-priority:") == 1)
 				{
+					if (CommandModeIn(commandMode, COMMAND_MODES_BULK)) {
+						printf("Error: /priority cannot be used with /audit, /fileops, /aclreset, or /regimport.\n");
+						return 1;
+					}
+
 					// Extract nilai priority setelah colon
 					AnsiString priorityStr = param.SubString(param.Pos(":") + 1, param.Length());
 
@@ -157,62 +467,673 @@ int WINAPI _tWinMain(HINSTANCE, HINSTANCE, LPTSTR, int)
 					case 6: priority = REALTIME_PRIORITY_CLASS; break;
 					default: priority = NORMAL_PRIORITY_CLASS; break;
 					}
+					prioritySet = true;
+				}
+				else if (param.Pos("/allowlist:") == 1 || param.Pos("-allowlist:") == 1)
+				{
+					// Path allowlist diambil dari parameter asli (UTF-16)
+					allowlistPath = rawParam.SubString(rawParam.Pos(":") + 1, rawParam.Length());
+					if (allowlistPath.IsEmpty()) {
+						printf("Error: /allowlist requires a file path.\n");
+						return 1;
+					}
+				}
+				else if (auditMode && (param.Pos("/format:") == 1 || param.Pos("-format:") == 1))
+				{
+					AnsiString format = param.SubString(param.Pos(":") + 1, param.Length()).LowerCase();
+					if (format == "csv") {
+						auditFormat = BULK_OUTPUT_CSV;
+					} else if (format == "json") {
+						auditFormat = BULK_OUTPUT_JSON;
+					} else {
+						printf("Error: Invalid format. Use csv or json.\n");
+						return 1;
+					}
+				}
+				else if (auditMode && (param.Pos("/out:") == 1 || param.Pos("-out:") == 1))
+				{
+					auditOutput = rawParam.SubString(rawParam.Pos(":") + 1, rawParam.Length());
+					if (auditOutput.IsEmpty()) {
+						printf("Error: /out requires a file path.\n");
+						return 1;
+					}
+				}
+				else if (batchMode && (param.Pos("/out:") == 1 || param.Pos("-out:") == 1))
+				{
+					// Path hasil JSON diambil dari parameter asli (UTF-16)
+					batchOutput = rawParam.SubString(rawParam.Pos(":") + 1, rawParam.Length());
+					if (batchOutput.IsEmpty()) {
+						printf("Error: /out requires a file path.\n");
+						return 1;
+					}
+				}
+				else if (CommandModeIn(commandMode, COMMAND_MODE_AUDIT | COMMAND_MODE_FILEOPS | COMMAND_MODE_ACLRESET) &&
+					(param.Pos("/threads:") == 1 || param.Pos("-threads:") == 1))
+				{
+					int threadsValue = 0;
+					if (!ParseBoundedNumber(param, 3, 1, static_cast<int>(BULK_MAX_THREADS), threadsValue)) {
+						printf("Error: Threads must be between 1 and %u.\n", BULK_MAX_THREADS);
+						return 1;
+					}
+					workerThreads = static_cast<unsigned>(threadsValue);
+				}
+				else if (aclresetMode && (param.Pos("/sddl:") == 1 || param.Pos("-sddl:") == 1))
+				{
+					// SDDL diambil dari parameter asli (SID akun bisa berisi karakter non-ANSI)
+					aclresetSddl = rawParam.SubString(rawParam.Pos(":") + 1, rawParam.Length());
+					if (aclresetSddl.IsEmpty()) {
+						printf("Error: /sddl requires an owner and DACL (O:...D:...).\n");
+						return 1;
+					}
+				}
+				else if (aclresetMode && (param.Pos("/checkpoint:") == 1 || param.Pos("-checkpoint:") == 1))
+				{
+					aclresetCheckpoint = rawParam.SubString(rawParam.Pos(":") + 1, rawParam.Length());
+					if (aclresetCheckpoint.IsEmpty()) {
+						printf("Error: /checkpoint requires a file path.\n");
+						return 1;
+					}
+				}
+				else if (regimportMode && (param == "/dryrun" || param == "-dryrun"))
+				{
+					regimportDryRun = true;
+				}
+				else if (regimportMode && param.Pos("/") != 1 && param.Pos("-") != 1)
+				{
+					// File .reg berikutnya, diterapkan berurutan setelah file sebelumnya
+					regimportFiles.push_back(rawParam);
+				}
+				else if (adjustMode && param.Pos("/") != 1 && param.Pos("-") != 1)
+				{
+					// Selector berikutnya; proses yang cocok dengan beberapa selector diubah sekali
+					adjustSelectors.push_back(rawParam);
+				}
+				else if (scripthostMode && (param.Pos("/recycle:") == 1 || param.Pos("-recycle:") == 1))
+				{
+					// 0 = host hanya di-recycle setelah job yang gagal
+					int recycleValue = 0;
+					if (!ParseBoundedNumber(param, 5, 0, 10000, recycleValue)) {
+						printf("Error: /recycle requires a job count between 0 and 10000.\n");
+						return 1;
+					}
+					scripthostRecycle = static_cast<unsigned>(recycleValue);
+				}
+				else if (CommandModeIn(commandMode, COMMAND_MODE_SCRIPTHOST | COMMAND_MODE_BATCH | COMMAND_MODE_GRAPH) &&
+					(param.Pos("/timeout:") == 1 || param.Pos("-timeout:") == 1))
+				{
+					int timeoutValue = 0;
+					if (!ParseBoundedNumber(param, 5, 1, 86400, timeoutValue)) {
+						printf("Error: /timeout requires seconds between 1 and 86400.\n");
+						return 1;
+					}
+					jobTimeout = static_cast<unsigned>(timeoutValue);
+				}
+				else if (CommandModeIn(commandMode, COMMAND_MODE_BATCH | COMMAND_MODE_GRAPH) &&
+					(param.Pos("/parallel:") == 1 || param.Pos("-parallel:") == 1))
+				{
+					int parallelValue = 0;
+					if (!ParseBoundedNumber(param, 4, 1, 1000, parallelValue)) {
+						printf("Error: /parallel requires a process count between 1 and 1000.\n");
+						return 1;
+					}
+					batchParallel = static_cast<unsigned>(parallelValue);
+				}
+				else if (superviseMode && (param.Pos("/backoff:") == 1 || param.Pos("-backoff:") == 1))
+				{
+					// Delay restart pertama; berlipat dua per kegagalan beruntun
+					int backoffValue = 0;
+					if (!ParseBoundedNumber(param, 4, 1, 3600, backoffValue)) {
+						printf("Error: /backoff requires seconds between 1 and 3600.\n");
+						return 1;
+					}
+					superviseBackoff = static_cast<unsigned>(backoffValue);
+				}
+				else if (superviseMode && (param.Pos("/crashloop:") == 1 || param.Pos("-crashloop:") == 1))
+				{
+					// 0 = program tidak pernah dihentikan karena crash loop
+					int crashValue = 0;
+					if (!ParseBoundedNumber(param, 4, 0, 1000, crashValue)) {
+						printf("Error: /crashloop requires a failure count between 0 and 1000.\n");
+						return 1;
+					}
+					superviseCrashLoop = static_cast<unsigned>(crashValue);
+				}
+				else if (superviseMode && (param.Pos("/metrics:") == 1 || param.Pos("-metrics:") == 1))
+				{
+					// Path metrics diambil dari parameter asli (UTF-16)
+					superviseMetrics = rawParam.SubString(rawParam.Pos(":") + 1, rawParam.Length());
+					if (superviseMetrics.IsEmpty()) {
+						printf("Error: /metrics requires a file path.\n");
+						return 1;
+					}
+				}
+				else if (param == "/capture" || param == "-capture" || param.Pos("/capture:") == 1 || param.Pos("-capture:") == 1)
+				{
+					if (CommandModeIn(commandMode, COMMAND_MODES_NO_CAPTURE)) {
+						printf("Error: /capture can only be used when running an executable or with /batch or /supervise.\n");
+						return 1;
+					}
+
+					// Direktori log diambil dari parameter asli (UTF-16)
+					captureMode = true;
+					captureDirectory = (param.Pos(":") > 0) ? rawParam.SubString(rawParam.Pos(":") + 1, rawParam.Length()) : String();
+					if (param.Pos(":") > 0 && captureDirectory.IsEmpty()) {
+						printf("Error: /capture requires console or a log directory.\n");
+						return 1;
+					}
+					if (captureDirectory.LowerCase() == "console") {
+						captureDirectory = String();
+					}
+				}
+				else if (param.Pos("/logsize:") == 1 || param.Pos("-logsize:") == 1)
+				{
+					if (CommandModeIn(commandMode, COMMAND_MODES_NO_CAPTURE)) {
+						printf("Error: /logsize can only be used with /capture:DIR.\n");
+						return 1;
+					}
+
+					int sizeValue = 0;
+					if (!ParseBoundedNumber(param, 4, 1, 4096, sizeValue)) {
+						printf("Error: /logsize requires megabytes between 1 and 4096.\n");
+						return 1;
+					}
+					captureLogSize = static_cast<unsigned>(sizeValue);
+				}
+				else if (param.Pos("/console:") == 1 || param.Pos("-console:") == 1)
+				{
+					if (CommandModeIn(commandMode, COMMAND_MODES_BULK | COMMAND_MODE_SCRIPTHOST | COMMAND_MODE_ADJUST)) {
+						printf("Error: /console cannot be used with /audit, /fileops, /aclreset, /regimport, /scripthost, or /adjust.\n");
+						return 1;
+					}
+
+					AnsiString modeStr = param.SubString(param.Pos(":") + 1, param.Length());
+					if (!ParseConsoleMode(std::string(modeStr.c_str(), modeStr.Length()), consoleMode)) {
+						printf("Error: /console requires auto, new, inherit, none, or hidden.\n");
+						return 1;
+					}
+				}
+				else if (param.Pos("/launchapi:") == 1 || param.Pos("-launchapi:") == 1)
+				{
+					// Capture, batch, dan script host membuat proses melalui backend masing-masing
+					if (CommandModeIn(commandMode, COMMAND_MODES_BULK | COMMAND_MODE_SCRIPTHOST | COMMAND_MODE_BATCH |
+						COMMAND_MODE_SUPERVISE | COMMAND_MODE_ADJUST)) {
+						printf("Error: /launchapi cannot be used with /audit, /fileops, /aclreset, /regimport, /scripthost, /batch, /supervise, or /adjust.\n");
+						return 1;
+					}
+
+					AnsiString apiStr = param.SubString(param.Pos(":") + 1, param.Length());
+					if (!ParseProcessLaunchApi(std::string(apiStr.c_str(), apiStr.Length()), launchApi)) {
+						printf("Error: /launchapi requires auto, seclogon, or asuser.\n");
+						return 1;
+					}
+					launchApiSet = true;
+				}
+				else if (param.Pos("/affinity:") == 1 || param.Pos("-affinity:") == 1 ||
+					param.Pos("/iopriority:") == 1 || param.Pos("-iopriority:") == 1 ||
+					param.Pos("/mempriority:") == 1 || param.Pos("-mempriority:") == 1 ||
+					param.Pos("/jobmemory:") == 1 || param.Pos("-jobmemory:") == 1)
+				{
+					// Tahap launch pipeline hanya untuk satu launch langsung
+					if (CommandModeIn(commandMode, COMMAND_MODES_BULK | COMMAND_MODE_SCRIPTHOST | COMMAND_MODE_BATCH |
+						COMMAND_MODE_BENCH | COMMAND_MODE_GRAPH | COMMAND_MODE_SUPERVISE)) {
+						printf("Error: /affinity, /iopriority, /mempriority, and /jobmemory cannot be used with /audit, /fileops, /aclreset, /regimport, /scripthost, /batch, /bench, /graph, or /supervise.\n");
+						return 1;
+					}
+
+					AnsiString name = param.SubString(2, param.Pos(":") - 2).LowerCase();
+					AnsiString valueStr = param.SubString(param.Pos(":") + 1, param.Length());
+					if (adjustMode && name == "jobmemory") {
+						// Proses yang sudah berjalan mungkin sudah berada di job lain
+						printf("Error: /jobmemory cannot be used with /adjust.\n");
+						return 1;
+					}
+					if (name == "affinity")
+					{
+						// Mask hex (misalnya 0x3 atau 3 = CPU 0 dan 1)
+						if (valueStr.Pos("0x") == 1 || valueStr.Pos("0X") == 1) {
+							valueStr = valueStr.SubString(3, valueStr.Length());
+						}
+						bool isValidMask = !valueStr.IsEmpty() && valueStr.Length() <= 16;
+						uint64_t mask = 0;
+						for (int j = 1; isValidMask && j <= valueStr.Length(); j++) {
+							isValidMask = isxdigit(static_cast<unsigned char>(valueStr[j])) != 0;
+							int digit = tolower(static_cast<unsigned char>(valueStr[j]));
+							mask = (mask << 4) | static_cast<uint64_t>(isdigit(digit) ? digit - '0' : digit - 'a' + 10);
+						}
+						if (!isValidMask || mask == 0) {
+							printf("Error: /affinity requires a non-zero hexadecimal CPU mask.\n");
+							return 1;
+						}
+						stageSettings.affinityMask = mask;
+					}
+					else if (name == "iopriority")
+					{
+						if (!ParseIoPriority(std::string(valueStr.c_str(), valueStr.Length()), stageSettings.ioPriority)) {
+							printf("Error: /iopriority requires verylow, low, or normal.\n");
+							return 1;
+						}
+					}
+					else
+					{
+						// /mempriority:1-5 atau /jobmemory:MB
+						bool isMemoryPriority = (name == "mempriority");
+						int number = 0;
+						bool isValidNumber = ParseBoundedNumber(param, 7, 1, isMemoryPriority ? 5 : 1048576, number);
+						if (isMemoryPriority && !isValidNumber) {
+							printf("Error: /mempriority requires a value between 1 (very low) and 5 (normal).\n");
+							return 1;
+						}
+						if (!isMemoryPriority && !isValidNumber) {
+							printf("Error: /jobmemory requires megabytes between 1 and 1048576.\n");
+							return 1;
+						}
+						if (isMemoryPriority) {
+							stageSettings.memoryPriority = static_cast<uint32_t>(number);
+						} else {
+							stageSettings.jobMemoryLimit = static_cast<uint64_t>(number) * 1024 * 1024;
+						}
+					}
+				}
+				else if (benchMode && (param.Pos("/target:") == 1 || param.Pos("-target:") == 1))
+				{
+					benchTarget = rawParam.SubString(rawParam.Pos(":") + 1, rawParam.Length());
+					if (benchTarget.IsEmpty()) {
+						printf("Error: /target requires a file path.\n");
+						return 1;
+					}
+				}
+				else if (param.Pos("/trace:") == 1 || param.Pos("-trace:") == 1)
+				{
+					if (CommandModeIn(commandMode, COMMAND_MODES_BULK | COMMAND_MODE_SCRIPTHOST | COMMAND_MODE_BATCH |
+						COMMAND_MODE_GRAPH | COMMAND_MODE_SUPERVISE | COMMAND_MODE_ADJUST)) {
+						printf("Error: /trace cannot be used with /audit, /fileops, /aclreset, /regimport, /scripthost, /batch, /graph, /supervise, or /adjust.\n");
+						return 1;
+					}
+
+					// Path trace diambil dari parameter asli (UTF-16)
+					tracePath = rawParam.SubString(rawParam.Pos(":") + 1, rawParam.Length());
+					if (tracePath.IsEmpty()) {
+						printf("Error: /trace requires a file path.\n");
+						return 1;
+					}
+				}
+				else if (param.Pos("/sessions:") == 1 || param.Pos("-sessions:") == 1)
+				{
+					if (commandMode != COMMAND_MODE_LAUNCH) {
+						printf("Error: /sessions can only be used when running an executable.\n");
+						return 1;
+					}
+
+					String sessionsStr = rawParam.SubString(rawParam.Pos(":") + 1, rawParam.Length());
+					if (!ParseSessionSelection(std::wstring(sessionsStr.c_str(), sessionsStr.Length()), sessionSelection)) {
+						printf("Error: /sessions requires all or a comma-separated list of distinct session IDs.\n");
+						return 1;
+					}
+					sessionsSet = true;
+				}
+				else if (param == "/single" || param == "-single" || param.Pos("/single:") == 1 || param.Pos("-single:") == 1)
+				{
+					if (CommandModeIn(commandMode, COMMAND_MODES_NO_CAPTURE | COMMAND_MODE_SUPERVISE)) {
+						printf("Error: /single can only be used when running an executable or with /batch.\n");
+						return 1;
+					}
+
+					String singleStr = (param.Pos(":") > 0) ? rawParam.SubString(rawParam.Pos(":") + 1, rawParam.Length()) : String();
+					if ((param.Pos(":") > 0 && singleStr.IsEmpty()) ||
+						!ParseSingleInstanceMode(std::wstring(singleStr.c_str(), singleStr.Length()), singleMode)) {
+						printf("Error: /single must be skip or attach.\n");
+						return 1;
+					}
+				}
+				else if (param == "/accounting" || param == "-accounting")
+				{
+					if (CommandModeIn(commandMode, COMMAND_MODES_NO_CAPTURE | COMMAND_MODE_SUPERVISE)) {
+						printf("Error: /accounting requires /capture or /batch.\n");
+						return 1;
+					}
+					captureAccounting = true;
+				}
+				else if (param.Pos("/policy:") == 1 || param.Pos("-policy:") == 1)
+				{
+					// Path policy diambil dari parameter asli (UTF-16)
+					policyPath = rawParam.SubString(rawParam.Pos(":") + 1, rawParam.Length());
+					if (policyPath.IsEmpty()) {
+						printf("Error: /policy requires a file path.\n");
+						return 1;
+					}
 				}
 				else
 				{
 					// ERROR: Parameter tidak dikenal
-					printf("Error: Unknown parameter '%s'. Supported parameters: /priority:N or -priority:N\n", param.c_str());
+					printf("Error: Unknown parameter '%s'. Supported parameters: /priority:N, /allowlist:FILE, /policy:FILE, /trace:FILE, /console:auto|new|inherit|none|hidden, /launchapi:auto|seclogon|asuser, /affinity:HEX, /iopriority:verylow|low|normal, /mempriority:1-5, /jobmemory:MB, /sessions:all|ID,ID, /single[:skip|attach], /accounting (audit: /format:csv|json, /out:FILE, /threads:N; bench: /target:FILE; fileops: /threads:N; aclreset: /sddl:SDDL, /checkpoint:FILE, /threads:N; regimport: FILE..., /dryrun; scripthost: /recycle:N, /timeout:SECONDS; capture: /capture[:console|DIR], /logsize:MB; batch: /parallel:N, /timeout:SECONDS, /out:FILE; graph: /parallel:N, /timeout:SECONDS; supervise: /backoff:SECONDS, /crashloop:N, /metrics:FILE; adjust: PID|NAME|PATH...)\n", param.c_str());
 					return 1; // Exit dengan error code
 				}
 			}
 
 			//==================================================================
-			// EXECUTE CLI MODE
+			// LOAD HASH ALLOWLIST (OPTIONAL)
 			//==================================================================
 
-			// Jalankan executable dan exit dengan return code yang sesuai
-			bool success = RunExecutableFromCommandLine(exePath, priority);
-			return success ? 0 : 1; // 0 = success, 1 = failure
-		}
-		else
-		{
+			// File eksplisit wajib ada; file default hanya dimuat jika ada
+			bool explicitAllowlist = !allowlistPath.IsEmpty();
+			std::wstring allowlistFile = explicitAllowlist ?
+				std::wstring(allowlistPath.c_str(), allowlistPath.Length()) : GetDefaultAllowlistPath();
+
+			if (explicitAllowlist || (!allowlistFile.empty() && FileExists(allowlistFile.c_str())))
+			{
+				size_t errorLine = 0;
+				if (!LoadExecutableAllowlist(allowlistFile, &errorLine))
+				{
+					if (errorLine > 0) {
+						printf("Error: Invalid allowlist entry at line %u: %ls\n", static_cast<unsigned>(errorLine), allowlistFile.c_str());
+					} else {
+						printf("Error: Cannot read allowlist: %ls\n", allowlistFile.c_str());
+					}
+					return 1; // Fail closed
+				}
+			}
+
 			//==================================================================
-			// GUI MODE: Graphical User Interface
+			// LOAD PATH POLICY (OPTIONAL)
 			//==================================================================
 
-			// Inisialisasi VCL Application
-			Application->Initialize();
-			Application->MainFormOnTaskBar = true; // Tampilkan form di taskbar
+			bool explicitPolicy = !policyPath.IsEmpty();
+			std::wstring policyFile = explicitPolicy ?
+				std::wstring(policyPath.c_str(), policyPath.Length()) : GetDefaultPathPolicyPath();
 
-			// Buat dan tampilkan form utama
-			Application->CreateForm(__classid(TMain), &Main);
+			if (explicitPolicy || (!policyFile.empty() && FileExists(policyFile.c_str())))
+			{
+				size_t errorLine = 0;
+				if (!LoadPathPolicy(policyFile, &errorLine))
+				{
+					if (errorLine > 0) {
+						printf("Error: Invalid policy rule at line %u: %ls\n", static_cast<unsigned>(errorLine), policyFile.c_str());
+					} else {
+						printf("Error: Cannot read policy: %ls\n", policyFile.c_str());
+					}
+					return 1; // Fail closed
+				}
+			}
 
-			// Jalankan message loop VCL (blocking call)
-			Application->Run();
-		}
-	}
-	catch (Exception &exception)
-	{
-		// EXCEPTION HANDLING: VCL Exceptions
-		Application->ShowException(&exception);
-	}
-	catch (...)
-	{
-		// EXCEPTION HANDLING: Unknown exceptions
-		try
-		{
-			throw Exception(""); // Convert ke VCL exception
-		}
-		catch (Exception &exception)
-		{
-			Application->ShowException(&exception);
-		}
-	}
+			//==================================================================
+			// EXECUTE AUDIT MODE
+			//==================================================================
 
-	// Normal exit (GUI mode) atau setelah CLI execution
-	return 0;
-}
-//---------------------------------------------------------------------------
+			if (auditMode)
+			{
+				bool audited = RunAuditFromCommandLine(auditTarget, auditFormat, auditOutput, workerThreads);
+				return audited ? 0 : 1;
+			}
+
+			//==================================================================
+			// EXECUTE FILE OPERATIONS MODE
+			//==================================================================
+
+			if (fileopsMode)
+			{
+				bool completed = RunFileOperationsFromCommandLine(fileopsScript, workerThreads);
+				return completed ? 0 : 1;
+			}
+
+			//==================================================================
+			// EXECUTE ACL RESET MODE
+			//==================================================================
+
+			if (aclresetMode)
+			{
+				if (aclresetSddl.IsEmpty()) {
+					printf("Error: /aclreset requires /sddl:SDDL.\n");
+					return 1;
+				}
+				bool completed = RunAclResetFromCommandLine(aclresetRoot, aclresetSddl, aclresetCheckpoint, workerThreads);
+				return completed ? 0 : 1;
+			}
+
+			//==================================================================
+			// EXECUTE REGISTRY IMPORT MODE
+			//==================================================================
+
+			if (regimportMode)
+			{
+				bool imported = RunRegistryImportFromCommandLine(regimportFiles, regimportDryRun);
+				return imported ? 0 : 1;
+			}
+
+			//==================================================================
+			// EXECUTE ADJUST MODE
+			//==================================================================
+
+			if (adjustMode)
+			{
+				ProcessAdjustment adjustment;
+				adjustment.priorityClass = prioritySet ? static_cast<uint32_t>(priority) : 0;
+				adjustment.affinityMask = stageSettings.affinityMask;
+				adjustment.ioPriority = stageSettings.ioPriority;
+				adjustment.memoryPriority = stageSettings.memoryPriority;
+				bool adjusted = RunProcessAdjustFromCommandLine(adjustSelectors, adjustment);
+				return adjusted ? 0 : 1;
+			}
+
+			//==================================================================
+			// EXECUTE SCRIPT HOST MODE
+			//==================================================================
+
+			if (scripthostMode)
+			{
+				bool succeeded = RunScriptHostFromCommandLine(scripthostJobs, scripthostRecycle, jobTimeout, priority);
+				return succeeded ? 0 : 1;
+			}
+
+			//==================================================================
+			// EXECUTE LAUNCH GRAPH MODE
+			//==================================================================
+
+			if (graphMode)
+			{
+				bool succeeded = RunLaunchGraphFromCommandLine(graphManifest, batchParallel, jobTimeout, priority,
+					consoleMode, launchApi);
+				return succeeded ? 0 : 1;
+			}
+
+			//==================================================================
+			// EXECUTE SUPERVISOR MODE
+			//==================================================================
+
+			if (superviseMode)
+			{
+				if (captureLogSize > 0 && captureDirectory.IsEmpty()) {
+					printf("Error: /logsize requires /capture:DIR.\n");
+					return 1;
+				}
+				bool succeeded = RunSupervisorFromCommandLine(superviseList, captureDirectory, captureLogSize,
+					superviseBackoff, superviseCrashLoop, superviseMetrics, priority, consoleMode);
+				return succeeded ? 0 : 1;
+			}
+
+			// Launch biasa tidak menunggu proses keluar, jadi tidak ada accounting akhir
+			if (captureAccounting && !captureMode) {
+				printf("Error: /accounting requires /capture or /batch.\n");
+				return 1;
+			}
+
+			//==================================================================
+			// EXECUTE SESSIONS MODE (satu executable ke banyak session)
+			//==================================================================
+
+			if (sessionsSet)
+			{
+				// Selalu CreateProcessAsUserW: seclogon tidak dapat membuat proses di session lain
+				if (captureMode || !tracePath.IsEmpty() || launchApiSet) {
+					printf("Error: /sessions cannot be used with /capture, /trace, or /launchapi.\n");
+					return 1;
+				}
+				if (singleMode != SINGLE_INSTANCE_OFF) {
+					printf("Error: /single cannot be used with /sessions.\n");
+					return 1;
+				}
+				if (!stageSettings.IsEmpty()) {
+					printf("Error: /affinity, /iopriority, /mempriority, and /jobmemory cannot be used with /sessions.\n");
+					return 1;
+				}
+				if (captureLogSize > 0) {
+					printf("Error: /logsize requires /capture:DIR.\n");
+					return 1;
+				}
+				bool launched = RunSessionLaunchFromCommandLine(exePath, sessionSelection, priority, consoleMode);
+				return launched ? 0 : 1;
+			}
+
+			//==================================================================
+			// EXECUTE CAPTURE MODE (/batch atau satu executable dengan /capture)
+			//==================================================================
+
+			if (captureMode)
+			{
+				// Proses capture dibuat melalui backend capture, bukan jalur launch yang direkam trace
+				if (!tracePath.IsEmpty()) {
+					printf("Error: /trace cannot be used with /capture.\n");
+					return 1;
+				}
+				if (launchApiSet) {
+					printf("Error: /launchapi cannot be used with /capture.\n");
+					return 1;
+				}
+				if (!stageSettings.IsEmpty()) {
+					printf("Error: /affinity, /iopriority, /mempriority, and /jobmemory cannot be used with /capture.\n");
+					return 1;
+				}
+				if (captureLogSize > 0 && captureDirectory.IsEmpty()) {
+					printf("Error: /logsize requires /capture:DIR.\n");
+					return 1;
+				}
+				bool succeeded = RunCaptureFromCommandLine(batchMode ? batchList : exePath, batchMode,
+					captureDirectory, captureLogSize, batchParallel, jobTimeout, priority, consoleMode, singleMode,
+					captureAccounting, batchOutput);
+				return succeeded ? 0 : 1;
+			}
+
+			if (captureLogSize > 0) {
+				printf("Error: /logsize requires /capture:DIR.\n");
+				return 1;
+			}
+
+			//==================================================================
+			// EXECUTE BENCHMARK MODE
+			//==================================================================
+
+			if (benchMode)
+			{
+				bool measured = RunBenchmarkFromCommandLine(benchIterations, benchTarget, priority, consoleMode,
+					launchApi, tracePath);
+				return measured ? 0 : 1;
+			}
+
+			//==================================================================
+			// EXECUTE CLI MODE
+			//==================================================================
+
+			// Jalankan executable dan exit dengan return code yang sesuai
+			bool success = RunExecutableFromCommandLine(exePath, priority, consoleMode, launchApi, stageSettings,
+				tracePath, singleMode);
+			return success ? 0 : 1; // 0 = success, 1 = failure
+		}
+		else
+		{
+			//==================================================================
+			// GUI MODE: Graphical User Interface
+			//==================================================================
+
+			// Inisialisasi VCL Application
+			Application->Initialize();
+			Application->MainFormOnTaskBar = true; // Tampilkan form di taskbar
+
+			// Buat dan tampilkan form utama
+			Application->CreateForm(__classid(TMain), &Main);
+
+			// Jalankan message loop VCL (blocking call)
+			Application->Run();
+		}
+	}
+	catch (Exception &exception)
+	{
+		// EXCEPTION HANDLING: VCL Exceptions
+		Application->ShowException(&exception);
+	}
+	catch (...)
+	{
+		// EXCEPTION HANDLING: Unknown exceptions
+		try
+		{
+			throw Exception(""); // Convert ke VCL exception
+		}
+		catch (Exception &exception)
+		{
+			Application->ShowException(&exception);
+		}
+	}
+
+	// Normal exit (GUI mode) atau setelah CLI execution
+	return 0;
+}
+//---------------------------------------------------------------------------
+
+/**
+ * @brief Rekaman trace backend ke file selama object hidup (/trace:FILE)
+ *
+ * Recorder dipasang di atas backend Win32 saat Open dan dilepas (trace
+ * di-flush) sebelum file ditutup, termasuk pada jalur return lebih awal.
+ */
+class BackendTraceFile {
+private:
+	FILE* file_;
+	std::unique_ptr<ScopedBackendTrace> trace_;
+
+public:
+	BackendTraceFile() : file_(NULL) {}
+	~BackendTraceFile() { Close(); }
+
+	/** @brief Membuat file trace dan mulai merekam (path kosong = tidak merekam) */
+	bool Open(const String& path, const BackendTraceSession& session)
+	{
+		if (path.IsEmpty())
+		{
+			return true;
+		}
+
+		file_ = _wfopen(path.c_str(), L"wb");
+		if (!file_)
+		{
+			printf("Error: Tidak dapat membuat file trace: %ls\n", path.c_str());
+			return false;
+		}
+
+		FILE* file = file_;
+		trace_.reset(new ScopedBackendTrace(session, [file](const uint8_t* data, size_t size) {
+			fwrite(data, 1, size, file);
+		}));
+		return true;
+	}
+
+	/** @brief Melepas recorder, flush, dan menutup file */
+	void Close()
+	{
+		if (trace_)
+		{
+			printf("Trace: %llu panggilan backend direkam\n",
+				static_cast<unsigned long long>(trace_->GetRecordCount()));
+			trace_.reset();
+		}
+		if (file_)
+		{
+			fclose(file_);
+			file_ = NULL;
+		}
+	}
+
+	BackendTraceFile(const BackendTraceFile&) = delete;
+	BackendTraceFile& operator=(const BackendTraceFile&) = delete;
+};
+//---------------------------------------------------------------------------
 
 /**
  * @brief Menjalankan executable dari command line dengan Trusted Installer privileges
@@ -222,12 +1143,20 @@ int WINAPI _tWinMain(HINSTANCE, HINSTANCE, LPTSTR, int)
  *
  * @param exePath Path ke executable yang akan dijalankan
  * @param priority Windows priority class untuk proses baru
+ * @param console Mode console (/console); AUTO = tanpa console untuk image GUI
+ * @param launchApi API launch (/launchapi); AUTO = CreateProcessAsUserW jika privilege tersedia
+ * @param stageSettings Tahap launch pipeline (/affinity, /iopriority, /mempriority, /jobmemory)
+ * @param tracePath File trace backend, atau kosong jika tidak merekam
+ * @param single Perilaku jika executable sudah berjalan (/single); attach menunggu
+ *        instance yang ada dan berhasil jika exit code-nya 0
  * @return true jika berhasil, false jika gagal
  *
  * @note Function ini menggunakan printf untuk output karena dalam konteks CLI
  * @see RunButtonClick untuk versi GUI dengan logic serupa
  */
-bool RunExecutableFromCommandLine(const AnsiString& exePath, int priority)
+bool RunExecutableFromCommandLine(const String& exePath, int priority, ConsoleMode console,
+	ProcessLaunchApi launchApi, const LaunchStageSettings& stageSettings, const String& tracePath,
+	SingleInstanceMode single)
 {
 	// Inisialisasi function pointers untuk dynamic linking
 	ResolveDynamicFunctions();
@@ -236,8 +1165,9 @@ bool RunExecutableFromCommandLine(const AnsiString& exePath, int priority)
 	// INPUT VALIDATION (mirip dengan GUI version)
 	//======================================================================
 
-	AnsiString path = exePath.Trim();
-	if (path.IsEmpty())
+	String text = exePath.Trim();
+	std::wstring path(text.c_str(), text.Length());
+	if (path.empty())
 	{
 		printf("Error: Path executable tidak boleh kosong\n");
 		return false;
@@ -249,9 +1179,41 @@ bool RunExecutableFromCommandLine(const AnsiString& exePath, int priority)
 		return false;
 	}
 
-	if (!ValidateExecutablePath(path))
+	// Rekam validasi + akuisisi + launch (dideklarasikan sebelum handle
+	// validasi agar CloseFile ikut terekam)
+	BackendTraceSession session;
+	session.operation = L"launch";
+	session.target = path;
+	session.priority = static_cast<uint32_t>(priority);
+	session.console = console;
+	session.launchApi = launchApi;
+	session.affinityMask = stageSettings.affinityMask;
+	session.ioPriority = stageSettings.ioPriority;
+	session.memoryPriority = stageSettings.memoryPriority;
+	session.jobMemoryLimit = stageSettings.jobMemoryLimit;
+	BackendTraceFile trace;
+	if (!trace.Open(tracePath, session))
+	{
+		return false;
+	}
+
+	// Handle file tervalidasi tetap terbuka sampai launch
+	ValidatedExecutable validated;
+	if (!ValidateExecutablePath(path, validated))
 	{
-		printf("Error: Path executable tidak aman atau tidak valid: %s\n", path.c_str());
+		printf("Error: Path executable tidak aman atau tidak valid: %ls\n", path.c_str());
+		if (validated.policy.decision == POLICY_DECISION_DENIED)
+		{
+			printf("Lokasi ditolak oleh rule policy baris %u\n", static_cast<unsigned>(validated.policy.ruleLine));
+		}
+		else if (validated.policy.decision == POLICY_DECISION_NOT_ALLOWED)
+		{
+			printf("Lokasi tidak cocok dengan rule allow di policy\n");
+		}
+		else if (validated.hasSha256)
+		{
+			printf("SHA-256 tidak terdaftar di allowlist: %s\n", Sha256ToHex(validated.sha256).c_str());
+		}
 		printf("Pastikan file executable valid dan path tidak mengandung karakter berbahaya\n");
 		return false;
 	}
@@ -267,7 +1229,7 @@ bool RunExecutableFromCommandLine(const AnsiString& exePath, int priority)
 	//======================================================================
 
 	printf("=========================================\n");
-	printf("Menjalankan: %s\n", path.c_str());
+	printf("Menjalankan: %ls\n", validated.path.c_str());
 
 	// Convert priority constant ke nama yang readable untuk display
 	const char* priorityNames[] = {"IDLE", "BELOW NORMAL", "NORMAL", "ABOVE NORMAL", "HIGH", "REALTIME"};
@@ -280,24 +1242,59 @@ bool RunExecutableFromCommandLine(const AnsiString& exePath, int priority)
 	else if (priority == REALTIME_PRIORITY_CLASS) prioIndex = 5;
 
 	printf("Priority: %d - %s\n", prioIndex + 1, priorityNames[prioIndex]);
+	printf("Console: %s\n", GetConsoleModeName(ResolveConsoleMode(console, validated)));
 	printf("\n");
 
 	//======================================================================
-	// STRING CONVERSION: ANSI ke Unicode (sama dengan GUI)
+	// SINGLE INSTANCE CHECK (/single)
 	//======================================================================
 
-	int wPathLen = MultiByteToWideChar(CP_ACP, 0, path.c_str(), -1, NULL, 0);
-	if (wPathLen == 0 || wPathLen > MAX_PATH) {
-		printf("Error: Failed to convert path to wide string or path too long\n");
-		return false;
-	}
-	std::wstring wPath(wPathLen, 0);
-	int result = MultiByteToWideChar(CP_ACP, 0, path.c_str(), -1, &wPath[0], wPathLen);
-	if (result == 0) {
-		printf("Error: Failed to convert path to wide string\n");
-		return false;
+	if (single != SINGLE_INSTANCE_OFF)
+	{
+		// Best effort: tanpa SeDebugPrivilege proses yang tidak dapat dibuka dianggap tidak cocok
+		EnableSupportedPrivilege(false, SeDebugPrivilege);
+
+		IProcessBackend* ps = GetProcessBackend();
+		RunningImageIndex images;
+		uint32_t existing = 0;
+		if (!images.Load(ps, GetFileSystemBackend()))
+		{
+			printf("[-] Gagal mengambil snapshot proses (Error Code: %lu)\n",
+				static_cast<unsigned long>(ps->GetLastErrorCode()));
+			printf("=========================================\n");
+			return false;
+		}
+		if (images.Find(validated, existing))
+		{
+			if (single == SINGLE_INSTANCE_SKIP)
+			{
+				printf("[=] Sudah berjalan sebagai PID %u, launch di-skip\n", static_cast<unsigned>(existing));
+				printf("=========================================\n");
+				return true;
+			}
+
+			// Instance yang sudah keluar sejak snapshot tidak dapat dibuka: launch seperti biasa
+			ScopedBackendObject process(ps, ps->OpenProcessHandle(existing));
+			if (process.IsValid())
+			{
+				printf("[=] Sudah berjalan sebagai PID %u, menunggu instance tersebut selesai...\n",
+					static_cast<unsigned>(existing));
+				uint32_t exitCode = 0;
+				bool exited = ps->WaitForProcessExit(process.Get(), 0xFFFFFFFF, exitCode);
+				if (exited)
+				{
+					printf("Instance selesai dengan exit code %u\n", static_cast<unsigned>(exitCode));
+				}
+				else
+				{
+					printf("[-] Gagal menunggu instance (Error Code: %lu)\n",
+						static_cast<unsigned long>(ps->GetLastErrorCode()));
+				}
+				printf("=========================================\n");
+				return exited && exitCode == 0;
+			}
+		}
 	}
-	wPath.resize(wPathLen - 1);
 
 	//======================================================================
 	// EXECUTE PRIVILEGE ESCALATION
@@ -305,8 +1302,20 @@ bool RunExecutableFromCommandLine(const AnsiString& exePath, int priority)
 
 	printf("[+] Mendapatkan TrustedInstaller token...\n");
 
-	// Jalankan proses dengan Trusted Installer privileges
-	bool success = CreateProcessWithTIToken(wPath.c_str(), priority);
+	// Jalankan file yang sama persis dengan yang sudah divalidasi
+	// Tanpa tahap, pipeline kosong = launch langsung tanpa CREATE_SUSPENDED
+	LaunchPipeline pipeline;
+	ConfigureLaunchPipeline(stageSettings, pipeline);
+	LaunchPipelineResult pipelineResult;
+	ProcessLaunchApi usedApi = LAUNCH_API_AUTO;
+	LARGE_INTEGER frequency, launchStart, launchEnd;
+	QueryPerformanceFrequency(&frequency);
+	QueryPerformanceCounter(&launchStart);
+	bool success = CreateProcessWithTIToken(validated, priority, console, launchApi, &usedApi, &pipeline,
+		&pipelineResult);
+	DWORD launchError = GetLastError(); // QueryPerformanceCounter tidak boleh menimpa error launch
+	QueryPerformanceCounter(&launchEnd);
+	SetLastError(launchError);
 
 	//======================================================================
 	// REPORT RESULTS
@@ -315,14 +1324,1044 @@ bool RunExecutableFromCommandLine(const AnsiString& exePath, int priority)
 	if (success)
 	{
 		printf("[+] Proses berhasil dijalankan sebagai TrustedInstaller!\n");
+		printf("Launch API: %s (%.1f ms termasuk akuisisi token)\n", GetProcessLaunchApiName(usedApi),
+			(launchEnd.QuadPart - launchStart.QuadPart) * 1000.0 / frequency.QuadPart);
 	}
 	else
 	{
 		DWORD errorCode = GetLastError();
 		printf("[-] Gagal menjalankan proses (Error Code: %lu)\n", errorCode);
 	}
+	if (!pipeline.IsEmpty() && !pipelineResult.stages.empty())
+	{
+		printf("Launch pipeline:\n%s", FormatLaunchPipelineResult(pipelineResult).c_str());
+	}
 
 	printf("=========================================\n");
 	return success;
 }
 //---------------------------------------------------------------------------
+
+/**
+ * @brief Menjalankan validasi massal dan menulis report CSV/JSON
+ *
+ * Target berupa direktori di-walk secara rekursif; target berupa file dibaca
+ * sebagai daftar path (UTF-8, satu path per baris). Allowlist dan policy yang
+ * sudah dimuat ikut diterapkan, sehingga report memprediksi hasil launch.
+ *
+ * @param target Direktori atau file daftar path
+ * @param format Format report
+ * @param outputPath File report, atau kosong untuk stdout
+ * @param threadCount Jumlah worker (0 = semua core)
+ * @return true jika audit selesai (walaupun ada path yang ditolak)
+ */
+bool RunAuditFromCommandLine(const String& target, BulkOutputFormat format,
+	const String& outputPath, unsigned threadCount)
+{
+	std::wstring targetPath(target.c_str(), target.Length());
+	if (!SanitizePath(targetPath))
+	{
+		printf("Error: Target audit tidak valid\n");
+		return false;
+	}
+
+	FILE* output = stdout;
+	if (!outputPath.IsEmpty())
+	{
+		output = _wfopen(outputPath.c_str(), L"wb");
+		if (!output)
+		{
+			printf("Error: Tidak dapat membuat file report: %ls\n", outputPath.c_str());
+			return false;
+		}
+	}
+
+	BulkResultWriter writer(format, [output](std::string_view text) {
+		fwrite(text.data(), 1, text.size(), output);
+	});
+
+	BulkValidationOptions options;
+	options.threadCount = threadCount;
+
+	BulkValidationStats stats;
+	if (DirectoryExists(targetPath.c_str()))
+	{
+		stats = ValidateDirectoryTree(targetPath, options, writer);
+	}
+	else
+	{
+		std::vector<std::wstring> paths;
+		if (!ReadPathListFile(targetPath, paths))
+		{
+			printf("Error: Tidak dapat membaca daftar path: %ls\n", targetPath.c_str());
+			if (output != stdout) fclose(output);
+			return false;
+		}
+		stats = ValidatePathList(paths, options, writer);
+	}
+
+	if (output != stdout)
+	{
+		fclose(output);
+	}
+
+	// Ringkasan ke stderr jika report ditulis ke stdout agar report tetap bersih
+	FILE* summary = (output == stdout) ? stderr : stdout;
+	fprintf(summary, "Audit: %llu path, %llu diterima, %llu ditolak, %llu direktori, %u thread\n",
+		static_cast<unsigned long long>(stats.pathsValidated), static_cast<unsigned long long>(stats.accepted),
+		static_cast<unsigned long long>(stats.rejected), static_cast<unsigned long long>(stats.directoriesScanned),
+		stats.threadCount);
+	fprintf(summary, "Throughput: %.1f path/detik (%.2f detik)\n", stats.PathsPerSecond(), stats.elapsedSeconds);
+	return true;
+}
+//---------------------------------------------------------------------------
+
+/**
+ * @brief Mengukur latency launch end-to-end dan mencetak p50/p90/p99/max per fase
+ *
+ * Menjalankan N siklus cold (akuisisi token penuh, hash cache kosong) dan N
+ * siklus warm (token cache) terhadap target trivial. Tanpa /target, target
+ * adalah cmd.exe /c exit di direktori system sehingga setiap proses langsung
+ * selesai. Allowlist dan policy yang dimuat ikut berlaku seperti launch biasa.
+ *
+ * @param iterations Jumlah siklus per jalur token
+ * @param target Executable target, atau kosong untuk cmd.exe
+ * @param priority Windows priority class untuk proses yang dibuat
+ * @param console Mode console proses target (AUTO = dari subsystem PE)
+ * @param launchApi API launch (/launchapi); report mencatat API yang dipakai per jalur
+ * @param tracePath File trace backend, atau kosong jika tidak merekam
+ * @return true jika semua siklus berhasil
+ */
+bool RunBenchmarkFromCommandLine(unsigned iterations, const String& target, int priority,
+	ConsoleMode console, ProcessLaunchApi launchApi, const String& tracePath)
+{
+	ResolveDynamicFunctions();
+
+	LaunchBenchmarkOptions options;
+	options.iterations = iterations;
+	options.priority = static_cast<uint32_t>(priority);
+	options.console = console;
+	options.launchApi = launchApi;
+
+	// Commit charge system sebelum/sesudah launch: termasuk conhost jika console dibuat
+	options.commitProbe = [](uint64_t& bytes) {
+		MEMORYSTATUSEX status = { sizeof(status) };
+		if (!GlobalMemoryStatusEx(&status)) {
+			return false;
+		}
+		bytes = status.ullTotalPageFile - status.ullAvailPageFile;
+		return true;
+	};
+
+	if (target.IsEmpty())
+	{
+		wchar_t systemDirectory[MAX_PATH] = { 0 };
+		UINT length = GetSystemDirectoryW(systemDirectory, MAX_PATH);
+		if (length == 0 || length >= MAX_PATH)
+		{
+			printf("Error: Tidak dapat membaca direktori system\n");
+			return false;
+		}
+		options.targetPath = std::wstring(systemDirectory, length) + L"\\cmd.exe";
+		options.arguments = L"/c exit";
+	}
+	else
+	{
+		String text = target.Trim();
+		options.targetPath.assign(text.c_str(), text.Length());
+		if (!SanitizePath(options.targetPath))
+		{
+			printf("Error: Target benchmark tidak valid\n");
+			return false;
+		}
+	}
+
+	printf("Benchmark: %u siklus cold + %u siklus warm: %ls (console: %s, launch api: %s)\n", iterations,
+		iterations, options.targetPath.c_str(), GetConsoleModeName(console), GetProcessLaunchApiName(launchApi));
+
+	BackendTraceSession session;
+	session.operation = L"bench";
+	session.target = options.targetPath;
+	session.arguments = options.arguments;
+	session.iterations = options.iterations;
+	session.priority = options.priority;
+	session.console = options.console;
+	session.launchApi = options.launchApi;
+	BackendTraceFile trace;
+	if (!trace.Open(tracePath, session))
+	{
+		return false;
+	}
+
+	LaunchBenchmarkReport report;
+	bool success = RunLaunchBenchmark(options, report);
+	std::string text = FormatLaunchBenchmarkReport(report);
+	fwrite(text.data(), 1, text.size(), stdout);
+	return success;
+}
+//---------------------------------------------------------------------------
+
+/**
+ * @brief Menjalankan script /fileops dengan token Trusted Installer
+ *
+ * Script di-parse utuh sebelum token diakuisisi (script rusak tidak pernah
+ * dijalankan sebagian). Setiap worker meng-impersonate token yang sama;
+ * thread utama tetap di security context proses.
+ *
+ * @param scriptPath File script (UTF-8)
+ * @param threadCount Jumlah worker (0 = semua core)
+ * @return true jika semua baris script berhasil penuh
+ */
+bool RunFileOperationsFromCommandLine(const String& scriptPath, unsigned threadCount)
+{
+	ResolveDynamicFunctions();
+
+	std::wstring script(scriptPath.c_str(), scriptPath.Length());
+	std::vector<FileOperationCommand> commands;
+	size_t errorLine = 0;
+	if (!LoadFileOperationScript(script, commands, &errorLine))
+	{
+		if (errorLine > 0) {
+			printf("Error: Invalid file operation at line %u: %ls\n", static_cast<unsigned>(errorLine), script.c_str());
+		} else {
+			printf("Error: Cannot read file operation script: %ls\n", script.c_str());
+		}
+		return false;
+	}
+
+	// Worker meng-impersonate token: SeImpersonatePrivilege wajib aktif di token proses
+	if (!EnableSupportedPrivilege(false, SeImpersonatePrivilege))
+	{
+		printf("[-] Gagal mengaktifkan SeImpersonatePrivilege (Error Code: %lu)\n", GetLastError());
+		return false;
+	}
+
+	IProcessBackend* ps = GetProcessBackend();
+	ScopedBackendObject token(ps, AcquireTrustedInstallerToken());
+	if (!token.IsValid())
+	{
+		printf("[-] Gagal mendapatkan TrustedInstaller token (Error Code: %lu)\n",
+			static_cast<unsigned long>(ps->GetLastErrorCode()));
+		return false;
+	}
+
+	FileOperationOptions options;
+	options.threadCount = threadCount;
+	options.token = token.Get();
+
+	printf("File operations: %u baris: %ls\n", static_cast<unsigned>(commands.size()), script.c_str());
+	FileOperationReport report;
+	bool completed = RunFileOperations(commands, options, report);
+	std::string text = FormatFileOperationReport(report);
+	fwrite(text.data(), 1, text.size(), stdout);
+	return completed;
+}
+//---------------------------------------------------------------------------
+
+/** @brief Di-set oleh Ctrl+C/Ctrl+Break selama /aclreset */
+static std::atomic<bool> gAclResetCancel(false);
+
+/** @brief Console control handler: minta engine berhenti dan menyimpan checkpoint */
+static BOOL WINAPI AclResetCtrlHandler(DWORD ctrlType)
+{
+	if (ctrlType == CTRL_C_EVENT || ctrlType == CTRL_BREAK_EVENT)
+	{
+		gAclResetCancel.store(true);
+		return TRUE;
+	}
+	return FALSE;
+}
+
+/**
+ * @brief Menjalankan /aclreset dengan token Trusted Installer
+ *
+ * SDDL di-parse sebelum token diakuisisi. Ctrl+C menghentikan
+ * worker setelah object yang sedang diproses; sisa pekerjaan disimpan ke
+ * checkpoint sehingga run berikutnya dengan argumen yang sama melanjutkan.
+ *
+ * @param root Direktori (atau file) root
+ * @param sddl Owner + DACL target
+ * @param checkpointPath File checkpoint, atau kosong jika tidak memakai checkpoint
+ * @param threadCount Jumlah worker (0 = semua core)
+ * @return true jika seluruh pohon selesai tanpa object gagal
+ */
+bool RunAclResetFromCommandLine(const String& root, const String& sddl, const String& checkpointPath,
+	unsigned threadCount)
+{
+	ResolveDynamicFunctions();
+
+	std::wstring rootPath(root.c_str(), root.Length());
+	std::wstring target(sddl.c_str(), sddl.Length());
+	if (!NormalizeFileOperationPath(rootPath))
+	{
+		printf("Error: Path root tidak valid: %ls\n", rootPath.c_str());
+		return false;
+	}
+
+	// SDDL rusak ditolak sebelum token diakuisisi
+	AclTemplate parsed;
+	if (!ParseAclTemplate(target, parsed))
+	{
+		printf("Error: SDDL tidak valid atau tidak didukung (hanya O: dan D: dengan ACE A/D): %ls\n", target.c_str());
+		return false;
+	}
+
+	std::wstring checkpoint;
+	if (!checkpointPath.IsEmpty())
+	{
+		checkpoint.assign(checkpointPath.c_str(), checkpointPath.Length());
+		if (!NormalizeFileOperationPath(checkpoint))
+		{
+			printf("Error: Path checkpoint tidak valid: %ls\n", checkpoint.c_str());
+			return false;
+		}
+	}
+
+	// Worker meng-impersonate token: SeImpersonatePrivilege wajib aktif di token proses
+	if (!EnableSupportedPrivilege(false, SeImpersonatePrivilege))
+	{
+		printf("[-] Gagal mengaktifkan SeImpersonatePrivilege (Error Code: %lu)\n", GetLastError());
+		return false;
+	}
+
+	IProcessBackend* ps = GetProcessBackend();
+	ScopedBackendObject token(ps, AcquireTrustedInstallerToken());
+	if (!token.IsValid())
+	{
+		printf("[-] Gagal mendapatkan TrustedInstaller token (Error Code: %lu)\n",
+			static_cast<unsigned long>(ps->GetLastErrorCode()));
+		return false;
+	}
+
+	AclResetOptions options;
+	options.threadCount = threadCount;
+	options.token = token.Get();
+	options.checkpointPath = checkpoint;
+	options.cancel = &gAclResetCancel;
+
+	printf("ACL reset: %ls\n", rootPath.c_str());
+	SetConsoleCtrlHandler(AclResetCtrlHandler, TRUE);
+	AclResetReport report;
+	bool completed = RunAclReset(rootPath, target, options, report);
+	SetConsoleCtrlHandler(AclResetCtrlHandler, FALSE);
+
+	std::string text = FormatAclResetReport(report);
+	fwrite(text.data(), 1, text.size(), stdout);
+	if (report.interrupted && !checkpoint.empty())
+	{
+		printf("Checkpoint disimpan: %ls\n", checkpoint.c_str());
+	}
+	return completed;
+}
+//---------------------------------------------------------------------------
+
+/**
+ * @brief Menjalankan /regimport dengan token Trusted Installer
+ *
+ * Semua file di-parse sebelum token diakuisisi (file rusak membatalkan
+ * seluruh import). File diterapkan berurutan di satu worker yang
+ * meng-impersonate token; dry run juga berjalan di bawah token agar key
+ * yang hanya dapat dibaca Trusted Installer ikut dibandingkan.
+ *
+ * @param files File .reg (urutan command line)
+ * @param dryRun true = hanya laporkan perubahan
+ * @return true jika semua key/value berhasil (atau dapat dibaca untuk dry run)
+ */
+bool RunRegistryImportFromCommandLine(const std::vector<String>& files, bool dryRun)
+{
+	ResolveDynamicFunctions();
+
+	std::vector<std::wstring> paths;
+	std::vector<std::vector<RegistryKeyBlock> > contents(files.size());
+	for (size_t i = 0; i < files.size(); i++)
+	{
+		paths.push_back(std::wstring(files[i].c_str(), files[i].Length()));
+		size_t errorLine = 0;
+		if (!LoadRegistryFile(paths[i], contents[i], &errorLine))
+		{
+			if (errorLine > 0) {
+				printf("Error: Invalid registry file at line %u: %ls\n", static_cast<unsigned>(errorLine), paths[i].c_str());
+			} else {
+				printf("Error: Cannot read registry file: %ls\n", paths[i].c_str());
+			}
+			return false;
+		}
+	}
+
+	// Worker meng-impersonate token: SeImpersonatePrivilege wajib aktif di token proses
+	if (!EnableSupportedPrivilege(false, SeImpersonatePrivilege))
+	{
+		printf("[-] Gagal mengaktifkan SeImpersonatePrivilege (Error Code: %lu)\n", GetLastError());
+		return false;
+	}
+
+	IProcessBackend* ps = GetProcessBackend();
+	ScopedBackendObject token(ps, AcquireTrustedInstallerToken());
+	if (!token.IsValid())
+	{
+		printf("[-] Gagal mendapatkan TrustedInstaller token (Error Code: %lu)\n",
+			static_cast<unsigned long>(ps->GetLastErrorCode()));
+		return false;
+	}
+
+	RegistryImportOptions options;
+	options.token = token.Get();
+	options.dryRun = dryRun;
+
+	bool imported = true;
+	for (size_t i = 0; i < paths.size(); i++)
+	{
+		printf("Registry import%s: %ls\n", dryRun ? " (dry run)" : "", paths[i].c_str());
+		RegistryImportReport report;
+		imported = RunRegistryImport(contents[i], options, report) && imported;
+		std::string text = FormatRegistryImportReport(report);
+		fwrite(text.data(), 1, text.size(), stdout);
+	}
+	return imported;
+}
+//---------------------------------------------------------------------------
+
+/**
+ * @brief Menjalankan /scripthost dengan token Trusted Installer
+ *
+ * Daftar job di-parse sebelum token diakuisisi (baris rusak membatalkan
+ * seluruh daftar). cmd.exe dan powershell.exe diambil dari direktori
+ * system; setiap job dimulai di direktori kerja RasTI saat ini.
+ *
+ * @param jobFile File daftar job (satu script per baris)
+ * @param jobsPerHost Job per host sebelum di-recycle (0 = hanya setelah kegagalan)
+ * @param timeoutSeconds Batas waktu per job (0 = tanpa batas)
+ * @param priority Priority class proses host
+ * @return true jika semua job selesai dengan exit code 0
+ */
+bool RunScriptHostFromCommandLine(const String& jobFile, unsigned jobsPerHost, unsigned timeoutSeconds,
+	int priority)
+{
+	ResolveDynamicFunctions();
+
+	std::wstring listPath(jobFile.c_str(), jobFile.Length());
+	std::vector<ScriptJob> jobs;
+	size_t errorLine = 0;
+	if (!LoadScriptJobList(listPath, jobs, &errorLine))
+	{
+		if (errorLine > 0) {
+			printf("Error: Invalid job at line %u: %ls\n", static_cast<unsigned>(errorLine), listPath.c_str());
+		} else {
+			printf("Error: Cannot read job list: %ls\n", listPath.c_str());
+		}
+		return false;
+	}
+
+	if (!ValidatePriorityValue(priority))
+	{
+		printf("Error: Nilai priority tidak valid\n");
+		return false;
+	}
+
+	wchar_t systemDirectory[MAX_PATH] = { 0 };
+	UINT length = GetSystemDirectoryW(systemDirectory, MAX_PATH);
+	wchar_t currentDirectory[MAX_PATH] = { 0 };
+	DWORD currentLength = GetCurrentDirectoryW(MAX_PATH, currentDirectory);
+	if (length == 0 || length >= MAX_PATH || currentLength == 0 || currentLength >= MAX_PATH)
+	{
+		printf("Error: Tidak dapat membaca direktori system atau direktori kerja\n");
+		return false;
+	}
+
+	ScriptHostOptions options;
+	options.cmdPath = std::wstring(systemDirectory, length) + L"\\cmd.exe";
+	options.powershellPath = std::wstring(systemDirectory, length) + L"\\WindowsPowerShell\\v1.0\\powershell.exe";
+	options.workingDirectory.assign(currentDirectory, currentLength);
+	options.creationFlags = static_cast<uint32_t>(priority);
+	options.jobsPerHost = jobsPerHost;
+	options.timeoutMs = timeoutSeconds * 1000;
+
+	// SeImpersonatePrivilege diperlukan untuk CreateProcessWithTokenW
+	if (!EnableSupportedPrivilege(false, SeImpersonatePrivilege))
+	{
+		printf("[-] Gagal mengaktifkan SeImpersonatePrivilege (Error Code: %lu)\n", GetLastError());
+		return false;
+	}
+
+	IProcessBackend* ps = GetProcessBackend();
+	ScopedBackendObject token(ps, AcquireTrustedInstallerToken());
+	if (!token.IsValid())
+	{
+		printf("[-] Gagal mendapatkan TrustedInstaller token (Error Code: %lu)\n",
+			static_cast<unsigned long>(ps->GetLastErrorCode()));
+		return false;
+	}
+	options.token = token.Get();
+
+	ScriptHostReport report;
+	bool succeeded = RunScriptHost(jobs, options, report);
+	std::string text = FormatScriptHostReport(report);
+	fwrite(text.data(), 1, text.size(), stdout);
+	return succeeded;
+}
+//---------------------------------------------------------------------------
+
+/**
+ * @brief Menjalankan satu executable atau daftar /batch dengan output di-capture
+ *
+ * Daftar launch di-parse sebelum token diakuisisi (baris rusak membatalkan
+ * seluruh daftar). Output diteruskan ke console (diberi tag "[N] " per baris
+ * jika lebih dari satu launch) atau ke satu log file per launch di
+ * logDirectory. Fungsi kembali setelah semua proses keluar.
+ *
+ * @param target Path executable, atau file daftar launch jika listFile
+ * @param listFile true = target adalah file daftar /batch
+ * @param logDirectory Direktori log, atau kosong untuk console
+ * @param logSizeMb Ukuran log sebelum dirotasi (0 = default)
+ * @param maxRunning Proses yang berjalan bersamaan (0 = semua sekaligus)
+ * @param timeoutSeconds Batas waktu per launch (0 = tanpa batas)
+ * @param priority Priority class semua proses
+ * @param console Mode console (AUTO = console tersembunyi, tanpa console untuk image GUI)
+ * @param single Perilaku jika executable sudah berjalan (/single)
+ * @param accounting Baca CPU, peak memory, dan I/O job setiap launch saat selesai (/accounting)
+ * @param outputPath File hasil JSON per launch (kosong = tidak ditulis)
+ * @return true jika semua proses keluar dengan exit code 0 (launch yang di-skip dihitung berhasil)
+ */
+bool RunCaptureFromCommandLine(const String& target, bool listFile, const String& logDirectory,
+	unsigned logSizeMb, unsigned maxRunning, unsigned timeoutSeconds, int priority, ConsoleMode console,
+	SingleInstanceMode single, bool accounting, const String& outputPath)
+{
+	ResolveDynamicFunctions();
+
+	std::vector<CaptureLaunch> launches;
+	if (listFile)
+	{
+		std::wstring listPath(target.c_str(), target.Length());
+		size_t errorLine = 0;
+		if (!LoadCaptureLaunchList(listPath, launches, &errorLine))
+		{
+			if (errorLine > 0) {
+				printf("Error: Invalid launch at line %u: %ls\n", static_cast<unsigned>(errorLine), listPath.c_str());
+			} else {
+				printf("Error: Cannot read launch list: %ls\n", listPath.c_str());
+			}
+			return false;
+		}
+	}
+	else
+	{
+		String text = target.Trim();
+		CaptureLaunch launch;
+		launch.path.assign(text.c_str(), text.Length());
+		if (launch.path.empty() || !SanitizePath(launch.path))
+		{
+			printf("Error: Path tidak valid setelah sanitasi\n");
+			return false;
+		}
+		launches.push_back(launch);
+	}
+
+	if (!ValidatePriorityValue(priority))
+	{
+		printf("Error: Nilai priority tidak valid\n");
+		return false;
+	}
+
+	std::wstring directory;
+	if (!logDirectory.IsEmpty())
+	{
+		directory.assign(logDirectory.c_str(), logDirectory.Length());
+		if (!NormalizeFileOperationPath(directory) || !DirectoryExists(directory.c_str()))
+		{
+			printf("Error: Direktori log tidak valid atau tidak ada: %ls\n", directory.c_str());
+			return false;
+		}
+	}
+
+	// SeImpersonatePrivilege diperlukan untuk CreateProcessWithTokenW
+	if (!EnableSupportedPrivilege(false, SeImpersonatePrivilege))
+	{
+		printf("[-] Gagal mengaktifkan SeImpersonatePrivilege (Error Code: %lu)\n", GetLastError());
+		return false;
+	}
+	if (single != SINGLE_INSTANCE_OFF)
+	{
+		// Best effort: proses yang tidak dapat dibuka dianggap bukan instance yang sama
+		EnableSupportedPrivilege(false, SeDebugPrivilege);
+	}
+
+	IProcessBackend* ps = GetProcessBackend();
+	ScopedBackendObject token(ps, AcquireTrustedInstallerToken());
+	if (!token.IsValid())
+	{
+		printf("[-] Gagal mendapatkan TrustedInstaller token (Error Code: %lu)\n",
+			static_cast<unsigned long>(ps->GetLastErrorCode()));
+		return false;
+	}
+
+	CaptureOptions options;
+	options.token = token.Get();
+	options.creationFlags = static_cast<uint32_t>(priority);
+	options.maxRunning = maxRunning;
+	options.timeoutMs = timeoutSeconds * 1000;
+	options.console = console;
+	options.single = single;
+	options.accounting = accounting;
+
+	// Chunk ditulis langsung dari buffer pump ke stdout/stderr atau log file
+	CaptureConsoleWriter console([](CaptureStream stream, std::string_view data) {
+		fwrite(data.data(), 1, data.size(), (stream == CAPTURE_STREAM_STDERR) ? stderr : stdout);
+	}, launches.size() > 1);
+	std::unique_ptr<CaptureLogWriter> logs;
+	if (!directory.empty())
+	{
+		uint64_t maxBytes = logSizeMb ? static_cast<uint64_t>(logSizeMb) * 1024 * 1024 : CAPTURE_DEFAULT_LOG_SIZE;
+		logs.reset(new CaptureLogWriter(directory, launches, maxBytes));
+	}
+
+	CaptureReport report;
+	bool succeeded = RunCapturedLaunches(launches, options,
+		[&](size_t launch, CaptureStream stream, std::string_view data) {
+			if (logs) {
+				logs->Write(launch, data);
+			} else {
+				console.Write(launch, stream, data);
+			}
+		}, report);
+	console.Finish();
+	fflush(stderr);
+
+	if (logs)
+	{
+		// Accounting dicatat di akhir log launch sebagai catatan audit per proses
+		for (size_t i = 0; i < report.results.size(); i++)
+		{
+			if (report.results[i].hasAccounting)
+			{
+				std::string trailer = "\n[RasTI] " + FormatProcessAccounting(report.results[i].accounting) + "\n";
+				logs->Write(i, trailer);
+			}
+		}
+		logs->Close();
+		if (logs->GetErrorCode() != 0)
+		{
+			printf("[-] Sebagian log gagal ditulis (Error Code: %lu)\n",
+				static_cast<unsigned long>(logs->GetErrorCode()));
+			succeeded = false;
+		}
+	}
+
+	std::string text = FormatCaptureReport(report);
+	fwrite(text.data(), 1, text.size(), stdout);
+
+	if (!outputPath.IsEmpty())
+	{
+		std::string json = FormatCaptureReportJson(report);
+		FILE* file = _wfopen(outputPath.c_str(), L"wb");
+		bool written = file && fwrite(json.data(), 1, json.size(), file) == json.size();
+		written = file && (fclose(file) == 0) && written;
+		if (!written)
+		{
+			printf("[-] Gagal menulis hasil: %ls\n", outputPath.c_str());
+			succeeded = false;
+		}
+	}
+	return succeeded;
+}
+//---------------------------------------------------------------------------
+
+/**
+ * @brief Menjalankan manifest /graph dengan satu token Trusted Installer
+ *
+ * Manifest di-parse sebelum token diakuisisi (baris rusak, node yang tidak
+ * ada, atau siklus membatalkan seluruh graf). Setiap node divalidasi saat
+ * siap dijalankan. Fungsi kembali setelah semua node selesai atau di-skip
+ * lalu mencetak hasil per node dan critical path.
+ *
+ * @param manifestPath File manifest graf
+ * @param maxRunning Proses yang berjalan bersamaan (0 = semua yang siap)
+ * @param timeoutSeconds Timeout node tanpa baris "timeout" (0 = tanpa batas)
+ * @param priority Priority class semua proses
+ * @param console Mode console (AUTO = dari subsystem PE)
+ * @param launchApi API launch semua node
+ * @return true jika semua node keluar dengan exit code 0
+ */
+bool RunLaunchGraphFromCommandLine(const String& manifestPath, unsigned maxRunning, unsigned timeoutSeconds,
+	int priority, ConsoleMode console, ProcessLaunchApi launchApi)
+{
+	ResolveDynamicFunctions();
+
+	std::wstring path(manifestPath.c_str(), manifestPath.Length());
+	LaunchGraph graph;
+	size_t errorLine = 0;
+	if (!LoadLaunchGraph(path, graph, &errorLine))
+	{
+		if (errorLine > 0) {
+			printf("Error: Invalid graph manifest at line %u: %ls\n", static_cast<unsigned>(errorLine), path.c_str());
+		} else {
+			printf("Error: Cannot read graph manifest: %ls\n", path.c_str());
+		}
+		return false;
+	}
+
+	if (!ValidatePriorityValue(priority))
+	{
+		printf("Error: Nilai priority tidak valid\n");
+		return false;
+	}
+
+	// SeImpersonatePrivilege diperlukan untuk CreateProcessWithTokenW
+	if (!EnableSupportedPrivilege(false, SeImpersonatePrivilege))
+	{
+		printf("[-] Gagal mengaktifkan SeImpersonatePrivilege (Error Code: %lu)\n", GetLastError());
+		return false;
+	}
+
+	IProcessBackend* ps = GetProcessBackend();
+	ScopedBackendObject token(ps, AcquireTrustedInstallerToken());
+	if (!token.IsValid())
+	{
+		printf("[-] Gagal mendapatkan TrustedInstaller token (Error Code: %lu)\n",
+			static_cast<unsigned long>(ps->GetLastErrorCode()));
+		return false;
+	}
+
+	LaunchGraphOptions options;
+	options.token = token.Get();
+	options.creationFlags = static_cast<uint32_t>(priority);
+	options.console = console;
+	options.api = launchApi;
+	options.maxRunning = maxRunning;
+	options.timeoutMs = timeoutSeconds * 1000;
+
+	LaunchGraphReport report;
+	bool succeeded = RunLaunchGraph(graph, options, report);
+	std::string text = FormatLaunchGraphReport(graph, report);
+	fwrite(text.data(), 1, text.size(), stdout);
+	return succeeded;
+}
+//---------------------------------------------------------------------------
+
+/** @brief Di-set oleh Ctrl+C/Ctrl+Break selama /supervise */
+static std::atomic<bool> gSuperviseCancel(false);
+
+/** @brief Console control handler: minta supervisor menghentikan semua program */
+static BOOL WINAPI SuperviseCtrlHandler(DWORD ctrlType)
+{
+	if (ctrlType == CTRL_C_EVENT || ctrlType == CTRL_BREAK_EVENT)
+	{
+		gSuperviseCancel.store(true);
+		return TRUE;
+	}
+	return FALSE;
+}
+
+/**
+ * @brief Menulis snapshot metrics JSON lewat file sementara agar pembaca tidak melihat file setengah jadi
+ * @return true jika file tertulis dan di-rename ke path tujuan
+ */
+static bool WriteSupervisorMetricsFile(const std::wstring& path, const std::string& json)
+{
+	std::wstring temporary = path + L".tmp";
+	FILE* file = _wfopen(temporary.c_str(), L"wb");
+	if (!file) {
+		return false;
+	}
+	bool written = fwrite(json.data(), 1, json.size(), file) == json.size();
+	written = (fclose(file) == 0) && written;
+	return written && MoveFileExW(temporary.c_str(), path.c_str(), MOVEFILE_REPLACE_EXISTING) != FALSE;
+}
+
+/**
+ * @brief Menjalankan /supervise sampai Ctrl+C atau semua program menyerah
+ *
+ * Daftar program memakai format /batch. Token Trusted Installer diakuisisi
+ * sekali sebelum program pertama dijalankan dan disimpan di cache; restart
+ * hanya memanggil CreateProcessWithTokenW. Setiap perubahan state dicetak
+ * satu baris dan (dengan /metrics:FILE) snapshot metrics JSON ditulis ulang.
+ *
+ * @param listPath File daftar program
+ * @param logDirectory Direktori log (kosong = output ke console dengan tag per program)
+ * @param logSizeMb Ukuran log sebelum dirotasi (0 = CAPTURE_DEFAULT_LOG_SIZE)
+ * @param backoffSeconds Delay restart pertama (0 = SUPERVISOR_DEFAULT_BACKOFF_MS)
+ * @param crashLoopLimit Kegagalan beruntun sebelum program dihentikan (0 = tanpa batas)
+ * @param metricsPath File snapshot metrics JSON (kosong = tidak ditulis)
+ * @param priority Priority class semua proses
+ * @param console Mode console (AUTO = console tersembunyi, tanpa console untuk image GUI)
+ * @return true jika dihentikan dengan Ctrl+C tanpa program yang menyerah
+ */
+bool RunSupervisorFromCommandLine(const String& listPath, const String& logDirectory, unsigned logSizeMb,
+	unsigned backoffSeconds, unsigned crashLoopLimit, const String& metricsPath, int priority, ConsoleMode console)
+{
+	ResolveDynamicFunctions();
+
+	std::wstring path(listPath.c_str(), listPath.Length());
+	std::vector<CaptureLaunch> programs;
+	size_t errorLine = 0;
+	if (!LoadCaptureLaunchList(path, programs, &errorLine))
+	{
+		if (errorLine > 0) {
+			printf("Error: Invalid program at line %u: %ls\n", static_cast<unsigned>(errorLine), path.c_str());
+		} else {
+			printf("Error: Cannot read program list: %ls\n", path.c_str());
+		}
+		return false;
+	}
+
+	if (!ValidatePriorityValue(priority))
+	{
+		printf("Error: Nilai priority tidak valid\n");
+		return false;
+	}
+
+	std::wstring directory;
+	if (!logDirectory.IsEmpty())
+	{
+		directory.assign(logDirectory.c_str(), logDirectory.Length());
+		if (!NormalizeFileOperationPath(directory) || !DirectoryExists(directory.c_str()))
+		{
+			printf("Error: Direktori log tidak valid atau tidak ada: %ls\n", directory.c_str());
+			return false;
+		}
+	}
+
+	std::wstring metricsFile;
+	if (!metricsPath.IsEmpty())
+	{
+		metricsFile.assign(metricsPath.c_str(), metricsPath.Length());
+		if (!NormalizeFileOperationPath(metricsFile))
+		{
+			printf("Error: Path metrics tidak valid: %ls\n", metricsFile.c_str());
+			return false;
+		}
+	}
+
+	// SeImpersonatePrivilege diperlukan untuk CreateProcessWithTokenW
+	if (!EnableSupportedPrivilege(false, SeImpersonatePrivilege))
+	{
+		printf("[-] Gagal mengaktifkan SeImpersonatePrivilege (Error Code: %lu)\n", GetLastError());
+		return false;
+	}
+
+	// Akuisisi pertama di sini agar kegagalan token terlihat sebelum program apa pun dijalankan
+	TrustedInstallerTokenCache tokens;
+	if (tokens.Acquire() == OS_INVALID_HANDLE)
+	{
+		printf("[-] Gagal mendapatkan TrustedInstaller token (Error Code: %lu)\n",
+			static_cast<unsigned long>(GetProcessBackend()->GetLastErrorCode()));
+		return false;
+	}
+
+	SupervisorMetrics metrics;
+	SupervisorOptions options;
+	options.tokens = &tokens;
+	options.creationFlags = static_cast<uint32_t>(priority);
+	options.console = console;
+	if (backoffSeconds > 0) {
+		options.initialBackoffMs = backoffSeconds * 1000;
+		options.maxBackoffMs = std::max(options.maxBackoffMs, options.initialBackoffMs);
+	}
+	options.crashLoopLimit = crashLoopLimit;
+	options.cancel = &gSuperviseCancel;
+	options.metrics = &metrics;
+
+	CaptureConsoleWriter writer([](CaptureStream stream, std::string_view data) {
+		fwrite(data.data(), 1, data.size(), (stream == CAPTURE_STREAM_STDERR) ? stderr : stdout);
+	}, programs.size() > 1);
+	std::unique_ptr<CaptureLogWriter> logs;
+	if (!directory.empty())
+	{
+		uint64_t maxBytes = logSizeMb ? static_cast<uint64_t>(logSizeMb) * 1024 * 1024 : CAPTURE_DEFAULT_LOG_SIZE;
+		logs.reset(new CaptureLogWriter(directory, programs, maxBytes));
+	}
+
+	// Satu baris per perubahan state; baris output program yang belum selesai ditutup dulu
+	bool metricsFailed = false;
+	SupervisorEventCallback events = [&](size_t program, const SupervisedProgramMetrics& state) {
+		writer.Finish();
+		unsigned number = static_cast<unsigned>(program + 1);
+		if (state.state == SUPERVISED_RUNNING) {
+			printf("[supervise] [%u] started, pid %u (start %llu)\n", number, static_cast<unsigned>(state.processId),
+				static_cast<unsigned long long>(state.starts));
+		} else if (state.state == SUPERVISED_BACKOFF || state.state == SUPERVISED_GAVE_UP) {
+			if (state.validation != VALIDATION_OK) {
+				printf("[supervise] [%u] rejected (%s)", number, GetValidationErrorName(state.validation));
+			} else if (state.lastErrorCode != 0) {
+				printf("[supervise] [%u] launch failed (Error Code: %lu)", number,
+					static_cast<unsigned long>(state.lastErrorCode));
+			} else {
+				printf("[supervise] [%u] exited with code %u after %.1f s", number,
+					static_cast<unsigned>(state.lastExitCode), state.lastRunSeconds);
+			}
+			if (state.state == SUPERVISED_GAVE_UP) {
+				printf(", gave up after %u consecutive failures\n", state.consecutiveFailures);
+			} else {
+				printf(", restart in %.1f s\n", state.backoffSeconds);
+			}
+		}
+		fflush(stdout);
+		if (!metricsFile.empty() && !WriteSupervisorMetricsFile(metricsFile, FormatSupervisorMetricsJson(metrics.Snapshot()))) {
+			metricsFailed = true;
+		}
+	};
+
+	printf("Supervising %u programs (Ctrl+C to stop)\n", static_cast<unsigned>(programs.size()));
+	gSuperviseCancel.store(false);
+	SetConsoleCtrlHandler(SuperviseCtrlHandler, TRUE);
+	SupervisorReport report;
+	bool succeeded = RunSupervisor(programs, options,
+		[&](size_t program, CaptureStream stream, std::string_view data) {
+			if (logs) {
+				logs->Write(program, data);
+			} else {
+				writer.Write(program, stream, data);
+			}
+		}, events, report);
+	SetConsoleCtrlHandler(SuperviseCtrlHandler, FALSE);
+	writer.Finish();
+	fflush(stderr);
+
+	if (logs)
+	{
+		logs->Close();
+		if (logs->GetErrorCode() != 0)
+		{
+			printf("[-] Sebagian log gagal ditulis (Error Code: %lu)\n",
+				static_cast<unsigned long>(logs->GetErrorCode()));
+			succeeded = false;
+		}
+	}
+	if (!metricsFile.empty() && !WriteSupervisorMetricsFile(metricsFile, FormatSupervisorMetricsJson(report.programs))) {
+		metricsFailed = true;
+	}
+	if (metricsFailed)
+	{
+		printf("[-] Snapshot metrics gagal ditulis: %ls\n", metricsFile.c_str());
+		succeeded = false;
+	}
+
+	std::string text = FormatSupervisorReport(report);
+	fwrite(text.data(), 1, text.size(), stdout);
+	return succeeded;
+}
+//---------------------------------------------------------------------------
+
+/**
+ * @brief Menjalankan /adjust di bawah impersonation Trusted Installer
+ *
+ * Selector di-parse sebelum token diakuisisi. Snapshot, OpenProcess, dan
+ * semua pengaturan berjalan di worker RunAsTrustedInstaller; SeDebugPrivilege
+ * diaktifkan di token thread (jika tersedia) agar proses dengan DACL ketat
+ * juga dapat dibuka. Tanpa pengaturan, hanya proses yang cocok yang dilaporkan.
+ *
+ * @param selectors PID, nama image, atau path executable (urutan command line)
+ * @param adjustment Pengaturan dari /priority, /affinity, /iopriority, /mempriority
+ * @return true jika setiap selector cocok dan setiap proses berhasil diubah
+ */
+bool RunProcessAdjustFromCommandLine(const std::vector<String>& selectors, const ProcessAdjustment& adjustment)
+{
+	ResolveDynamicFunctions();
+
+	std::vector<ProcessSelector> parsed(selectors.size());
+	for (size_t i = 0; i < selectors.size(); i++)
+	{
+		std::wstring text(selectors[i].c_str(), selectors[i].Length());
+		if (!ParseProcessSelector(text, parsed[i]))
+		{
+			printf("Error: Invalid process selector: %ls\n", text.c_str());
+			return false;
+		}
+	}
+
+	// Worker meng-impersonate token: SeImpersonatePrivilege wajib aktif di token proses
+	if (!EnableSupportedPrivilege(false, SeImpersonatePrivilege))
+	{
+		printf("[-] Gagal mengaktifkan SeImpersonatePrivilege (Error Code: %lu)\n", GetLastError());
+		return false;
+	}
+
+	IProcessBackend* ps = GetProcessBackend();
+	ProcessAdjustReport report;
+	bool adjusted = false;
+	bool ran = RunAsTrustedInstaller([&]() {
+		EnableSupportedPrivilege(true, SeDebugPrivilege); // Best effort: OpenProcess melewati DACL
+		adjusted = AdjustProcesses(parsed, adjustment, report);
+	});
+	if (!ran)
+	{
+		printf("[-] Gagal mendapatkan TrustedInstaller token (Error Code: %lu)\n",
+			static_cast<unsigned long>(ps->GetLastErrorCode()));
+		return false;
+	}
+
+	printf("Process adjust%s:\n", adjustment.IsEmpty() ? " (list only)" : "");
+	std::string text = FormatProcessAdjustReport(parsed, report);
+	fwrite(text.data(), 1, text.size(), stdout);
+	return adjusted;
+}
+//---------------------------------------------------------------------------
+
+/**
+ * @brief Menjalankan satu executable di setiap session terpilih (/sessions)
+ *
+ * Executable divalidasi dan token Trusted Installer diakuisisi sekali;
+ * setiap session mendapat salinan token yang dipindahkan ke session
+ * tersebut (CreateProcessAsUserW). Session yang gagal tidak menghentikan
+ * session lain dan dilaporkan satu baris per session.
+ *
+ * @param exePath Path ke executable yang akan dijalankan
+ * @param selection "all" (session aktif) atau daftar ID session
+ * @param priority Priority class semua proses
+ * @param console Mode console (AUTO = dari subsystem PE; inherit = new)
+ * @return true jika semua session terpilih berhasil di-launch
+ */
+bool RunSessionLaunchFromCommandLine(const String& exePath, const SessionSelection& selection, int priority,
+	ConsoleMode console)
+{
+	ResolveDynamicFunctions();
+
+	String text = exePath.Trim();
+	std::wstring path(text.c_str(), text.Length());
+	if (path.empty() || !SanitizePath(path))
+	{
+		printf("Error: Path tidak valid setelah sanitasi\n");
+		return false;
+	}
+
+	ValidatedExecutable validated;
+	if (!ValidateExecutablePath(path, validated))
+	{
+		printf("Error: Path executable tidak aman atau tidak valid: %ls\n", path.c_str());
+		return false;
+	}
+
+	if (!ValidatePriorityValue(priority))
+	{
+		printf("Error: Nilai priority tidak valid\n");
+		return false;
+	}
+
+	// SeImpersonatePrivilege diperlukan untuk akuisisi token
+	if (!EnableSupportedPrivilege(false, SeImpersonatePrivilege))
+	{
+		printf("[-] Gagal mengaktifkan SeImpersonatePrivilege (Error Code: %lu)\n", GetLastError());
+		return false;
+	}
+
+	IProcessBackend* ps = GetProcessBackend();
+	ScopedBackendObject token(ps, AcquireTrustedInstallerToken());
+	if (!token.IsValid())
+	{
+		printf("[-] Gagal mendapatkan TrustedInstaller token (Error Code: %lu)\n",
+			static_cast<unsigned long>(ps->GetLastErrorCode()));
+		return false;
+	}
+
+	SessionLaunchOptions options;
+	options.token = token.Get();
+	options.creationFlags = static_cast<uint32_t>(priority);
+	options.console = console;
+
+	printf("Menjalankan di session: %ls\n", validated.path.c_str());
+	SessionLaunchReport report;
+	bool launched = LaunchInSessions(validated, std::vector<std::wstring>(), selection, options, report);
+	std::string output = FormatSessionLaunchReport(report);
+	fwrite(output.data(), 1, output.size(), stdout);
+	return launched;
+}
+//---------------------------------------------------------------------------
@@ -0,0 +1,800 @@
+/**
+ * @file OutputCapture.cpp
+ * @brief Implementasi /capture dan /batch: parser daftar launch, pump event, dan writer output
+ *
+ * Pump menunggu event dari satu completion port dengan timeout terdekat
+ * (timeout launch, batas drain setelah exit, atau pengecekan exit cadangan).
+ * Launch selesai jika proses sudah keluar dan kedua pipe ditutup; pipe yang
+ * masih dipegang proses turunan setelah CAPTURE_DRAIN_TIMEOUT_MS tidak lagi
+ * ditunggu (outputDetached).
+ *
+ * Dengan /single, file setiap launch dicari di RunningImageIndex sebelum
+ * proses dibuat. Instance yang di-attach bukan milik port capture sehingga
+ * ditunggu lewat IProcessBackend setelah pump selesai.
+ *
+ * @author RasTI Development Team
+ * @version 1.2.0.0
+ * @date 2025
+ */
+
+#include "OutputCapture.h"
+#include "TextEncoding.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <map>
+
+//==============================================================================
+// LAUNCH LIST PARSER
+//==============================================================================
+
+static bool IsBlank(wchar_t ch)
+{
+    return ch == L' ' || ch == L'\t' || ch == L'\r';
+}
+
+/** @brief Mengambil satu token (diapit kutip atau dipisah blank) dari awal line */
+static bool NextToken(std::wstring_view& line, std::wstring& token)
+{
+    while (!line.empty() && IsBlank(line.front())) line.remove_prefix(1);
+    if (line.empty()) {
+        return false;
+    }
+
+    size_t end = 0;
+    if (line.front() == L'"') {
+        end = line.find(L'"', 1);
+        if (end == std::wstring_view::npos) {
+            return false; // Kutip tidak ditutup
+        }
+        token.assign(line.substr(1, end - 1));
+        line.remove_prefix(end + 1);
+        return line.empty() || IsBlank(line.front());
+    }
+
+    while (end < line.size() && !IsBlank(line[end])) end++;
+    token.assign(line.substr(0, end));
+    line.remove_prefix(end);
+    return token.find(L'"') == std::wstring::npos;
+}
+
+static bool HasControlCharacter(std::wstring_view text)
+{
+    for (wchar_t ch : text) {
+        if (ch < 0x20 || ch == 0x7F) return true;
+    }
+    return false;
+}
+
+/** @brief Argumen script: cmd.exe mengekspansi % dan ^ bahkan di dalam kutip */
+static bool IsCmdSafe(std::wstring_view text)
+{
+    return text.find_first_of(L"%^\"") == std::wstring_view::npos;
+}
+
+bool ParseCaptureLaunchList(std::string_view text, std::vector<CaptureLaunch>& launches, size_t* errorLine)
+{
+    launches.clear();
+    size_t lineNumber = 0;
+    size_t start = 0;
+    bool valid = true;
+    std::wstring decoded;
+
+    // UTF-8 BOM dari editor Windows
+    if (text.substr(0, 3) == "\xEF\xBB\xBF") {
+        start = 3;
+    }
+
+    while (valid && start < text.size()) {
+        size_t end = text.find('\n', start);
+        if (end == std::string_view::npos) end = text.size();
+        std::string_view rawLine = text.substr(start, end - start);
+        start = end + 1;
+        lineNumber++;
+
+        if (!DecodeUtf8(rawLine, decoded)) {
+            valid = false;
+            break;
+        }
+
+        std::wstring_view line(decoded);
+        while (!line.empty() && IsBlank(line.front())) line.remove_prefix(1);
+        if (line.empty() || line.front() == L'#') continue;
+
+        CaptureLaunch launch;
+        launch.line = static_cast<uint32_t>(lineNumber);
+        valid = NextToken(line, launch.path) && !launch.path.empty() && !HasControlCharacter(launch.path);
+        ExecutableKind kind = valid ? GetExecutableKind(launch.path) : EXECUTABLE_KIND_UNKNOWN;
+        valid = valid && kind != EXECUTABLE_KIND_UNKNOWN;
+
+        std::wstring argument;
+        while (valid) {
+            while (!line.empty() && IsBlank(line.front())) line.remove_prefix(1);
+            if (line.empty()) break;
+            valid = NextToken(line, argument) && !HasControlCharacter(argument) &&
+                    (kind != EXECUTABLE_KIND_SCRIPT || IsCmdSafe(argument));
+            if (valid) {
+                launch.arguments.push_back(argument);
+            }
+        }
+
+        if (valid) {
+            launches.push_back(std::move(launch));
+        }
+    }
+
+    if (!valid) {
+        // Daftar rusak tidak boleh dijalankan sebagian
+        launches.clear();
+        if (errorLine) *errorLine = lineNumber;
+        return false;
+    }
+
+    if (errorLine) *errorLine = 0;
+    return true;
+}
+
+bool LoadCaptureLaunchList(std::wstring_view path, std::vector<CaptureLaunch>& launches, size_t* errorLine)
+{
+    launches.clear();
+    if (errorLine) *errorLine = 0;
+
+    std::string text;
+    if (!ReadSmallFile(GetFileSystemBackend(), std::wstring(path), CAPTURE_MAX_LIST_FILE_SIZE, text)) {
+        return false;
+    }
+    return ParseCaptureLaunchList(text, launches, errorLine);
+}
+
+//==============================================================================
+// COMMAND LINE BUILDER
+//==============================================================================
+
+/**
+ * @brief Request launch capture: BuildValidatedLaunchRequest + console tanpa window
+ */
+static ProcessLaunchRequest BuildLaunchRequest(const ValidatedExecutable& executable,
+                                               const std::vector<std::wstring>& arguments, uint32_t creationFlags,
+                                               ConsoleMode console)
+{
+    ProcessLaunchRequest request = BuildValidatedLaunchRequest(executable, arguments, creationFlags);
+
+    // Output sudah lewat pipe: window console baru tidak berguna, tetapi console
+    // tetap dibuat agar proses turunan script tidak membuka console sendiri
+    ConsoleMode resolved = ResolveConsoleMode(console, executable);
+    if (console == CONSOLE_MODE_AUTO && resolved == CONSOLE_MODE_NEW) {
+        resolved = CONSOLE_MODE_HIDDEN;
+    }
+    ApplyConsoleMode(resolved, request);
+    return request;
+}
+
+//==============================================================================
+// ENGINE
+//==============================================================================
+
+namespace {
+
+typedef std::chrono::steady_clock Clock;
+
+/** @brief State satu proses yang sedang di-capture */
+struct RunningLaunch {
+    size_t index = 0;
+    bool streamOpen[2] = { true, true };
+    bool exited = false;
+    Clock::time_point started;
+    Clock::time_point exitSeen;
+};
+
+/** @brief Instance yang sudah berjalan dan ditunggu (/single:attach) */
+struct AttachedLaunch {
+    size_t index = 0;
+    size_t source = SIZE_MAX;             /**< Launch batch yang sama, atau SIZE_MAX = instance luar */
+    OsHandle process = OS_INVALID_HANDLE; /**< Hanya untuk instance luar */
+    Clock::time_point started;
+};
+
+double SecondsBetween(Clock::time_point from, Clock::time_point to)
+{
+    return std::chrono::duration<double>(to - from).count();
+}
+
+uint64_t MillisecondsBetween(Clock::time_point from, Clock::time_point to)
+{
+    return to > from ? std::chrono::duration_cast<std::chrono::milliseconds>(to - from).count() : 0;
+}
+
+/** @brief Menambahkan accounting satu launch ke total batch (peak memory = maksimum) */
+void AddAccounting(const ProcessAccounting& launch, ProcessAccounting& total)
+{
+    total.userMicroseconds += launch.userMicroseconds;
+    total.kernelMicroseconds += launch.kernelMicroseconds;
+    total.peakMemoryBytes = std::max(total.peakMemoryBytes, launch.peakMemoryBytes);
+    total.readBytes += launch.readBytes;
+    total.writeBytes += launch.writeBytes;
+    total.otherBytes += launch.otherBytes;
+    total.processCount += launch.processCount;
+}
+
+} // namespace
+
+bool RunCapturedLaunches(const std::vector<CaptureLaunch>& launches, const CaptureOptions& options,
+                         const CaptureOutputCallback& output, CaptureReport& report)
+{
+    report = CaptureReport();
+    Clock::time_point started = Clock::now();
+    report.results.resize(launches.size());
+    for (size_t i = 0; i < launches.size(); i++) {
+        report.results[i].line = launches[i].line;
+        report.results[i].path = launches[i].path;
+    }
+
+    IOutputCaptureBackend* backend = GetOutputCaptureBackend();
+    OsHandle port = backend->CreateCapturePort();
+    if (port == OS_INVALID_HANDLE) {
+        uint32_t error = backend->GetLastErrorCode();
+        for (CaptureLaunchResult& result : report.results) {
+            result.status = CAPTURE_LAUNCH_FAILED;
+            result.errorCode = error;
+        }
+        report.launchesFailed = launches.size();
+        report.seconds = SecondsBetween(started, Clock::now());
+        return launches.empty();
+    }
+
+    // Satu snapshot untuk seluruh batch; gagal = launch /single tidak dijalankan
+    IProcessBackend* ps = GetProcessBackend();
+    RunningImageIndex images;
+    uint32_t imagesError = 0;
+    if (options.single != SINGLE_INSTANCE_OFF && !images.Load(ps, GetFileSystemBackend())) {
+        imagesError = ps->GetLastErrorCode();
+    }
+    std::vector<AttachedLaunch> attached;
+    std::map<uint32_t, size_t> launchedIndex; // PID -> launch batch ini (untuk attach ke duplikat)
+
+    std::map<OsHandle, RunningLaunch> running;
+    size_t next = 0;
+
+    // Launch selesai: handle ditutup (proses yang masih berjalan di-terminate) dan hasil dihitung
+    auto finish = [&](std::map<OsHandle, RunningLaunch>::iterator it, CaptureLaunchStatus status, Clock::time_point now) {
+        CaptureLaunchResult& result = report.results[it->second.index];
+        result.status = status;
+        result.outputDetached = status == CAPTURE_LAUNCH_COMPLETED &&
+                                (it->second.streamOpen[0] || it->second.streamOpen[1]);
+        result.seconds = SecondsBetween(it->second.started, now);
+        // Job (dan counter-nya) hilang saat handle terakhir ditutup
+        if (options.accounting && backend->QueryCapturedAccounting(it->first, result.accounting)) {
+            result.hasAccounting = true;
+            AddAccounting(result.accounting, report.accounting);
+            report.launchesAccounted++;
+        }
+        backend->CloseCapturedProcess(it->first);
+        if (options.single != SINGLE_INSTANCE_OFF) {
+            images.Remove(result.processId);
+        }
+        if (result.Succeeded()) report.launchesSucceeded++; else report.launchesFailed++;
+        return running.erase(it);
+    };
+
+    auto startPending = [&]() {
+        while (next < launches.size() && (options.maxRunning == 0 || running.size() < options.maxRunning)) {
+            const CaptureLaunch& launch = launches[next];
+            CaptureLaunchResult& result = report.results[next];
+            size_t index = next++;
+
+            // Handle validasi tetap terbuka sampai proses dibuat
+            ValidatedExecutable validated;
+            result.validation = ValidateExecutable(launch.path, validated);
+            result.kind = validated.kind;
+            if (result.validation != VALIDATION_OK) {
+                result.status = CAPTURE_LAUNCH_REJECTED;
+                report.launchesFailed++;
+                continue;
+            }
+            result.path = validated.path;
+
+            if (options.single != SINGLE_INSTANCE_OFF) {
+                uint32_t existing = 0;
+                if (imagesError != 0) {
+                    result.status = CAPTURE_LAUNCH_FAILED;
+                    result.errorCode = imagesError;
+                    report.launchesFailed++;
+                    continue;
+                }
+                if (images.Find(validated, existing)) {
+                    if (options.single == SINGLE_INSTANCE_SKIP) {
+                        result.status = CAPTURE_LAUNCH_SKIPPED;
+                        result.processId = existing;
+                        report.launchesSkipped++;
+                        report.launchesSucceeded++;
+                        continue;
+                    }
+                    // Duplikat di batch ini memakai hasil launch sebelumnya. Instance luar:
+                    // handle dibuka sekarang agar PID tidak dipakai ulang sebelum ditunggu;
+                    // instance yang sudah keluar sejak snapshot di-launch seperti biasa
+                    AttachedLaunch attach;
+                    auto source = launchedIndex.find(existing);
+                    if (source != launchedIndex.end()) {
+                        attach.source = source->second;
+                    } else {
+                        attach.process = ps->OpenProcessHandle(existing);
+                    }
+                    if (attach.source != SIZE_MAX || attach.process != OS_INVALID_HANDLE) {
+                        attach.index = index;
+                        attach.started = Clock::now();
+                        attached.push_back(attach);
+                        result.processId = existing;
+                        report.launchesSkipped++;
+                        continue;
+                    }
+                }
+            }
+
+            ProcessLaunchRequest request = BuildLaunchRequest(validated, launch.arguments, options.creationFlags,
+                                                              options.console);
+            uint32_t processId = 0;
+            OsHandle process = backend->StartCapturedProcess(port, options.token, request, processId);
+            if (process == OS_INVALID_HANDLE) {
+                result.status = CAPTURE_LAUNCH_FAILED;
+                result.errorCode = backend->GetLastErrorCode();
+                report.launchesFailed++;
+                continue;
+            }
+
+            result.processId = processId;
+            if (options.single != SINGLE_INSTANCE_OFF) {
+                images.Add(processId, validated.identity);
+                launchedIndex[processId] = index;
+            }
+            RunningLaunch& state = running[process];
+            state.index = index;
+            state.started = Clock::now();
+            report.peakRunning = std::max<uint64_t>(report.peakRunning, running.size());
+        }
+    };
+
+    startPending();
+    Clock::time_point lastExitCheck = Clock::now();
+    while (!running.empty()) {
+        // Timeout tunggu = deadline terdekat dari semua proses
+        Clock::time_point now = Clock::now();
+        uint64_t wait = CAPTURE_EXIT_CHECK_MS;
+        for (const auto& entry : running) {
+            if (entry.second.exited) {
+                Clock::time_point drainEnd = entry.second.exitSeen + std::chrono::milliseconds(CAPTURE_DRAIN_TIMEOUT_MS);
+                wait = std::min(wait, MillisecondsBetween(now, drainEnd));
+            }
+            if (options.timeoutMs) {
+                Clock::time_point deadline = entry.second.started + std::chrono::milliseconds(options.timeoutMs);
+                wait = std::min(wait, MillisecondsBetween(now, deadline));
+            }
+        }
+
+        CaptureEvent event;
+        bool pumpFailed = false;
+        if (backend->WaitCaptureEvent(port, static_cast<uint32_t>(wait), event)) {
+            report.events++;
+            auto it = running.find(event.process);
+            if (it != running.end()) {
+                CaptureLaunchResult& result = report.results[it->second.index];
+                if (event.type == CAPTURE_EVENT_OUTPUT) {
+                    (event.stream == CAPTURE_STREAM_STDERR ? result.stderrBytes : result.stdoutBytes) += event.size;
+                    report.bytesCaptured += event.size;
+                    if (output) {
+                        output(it->second.index, event.stream, std::string_view(event.data, event.size));
+                    }
+                } else if (event.type == CAPTURE_EVENT_END_OF_STREAM) {
+                    it->second.streamOpen[event.stream] = false;
+                } else if (!it->second.exited && backend->QueryCapturedExit(it->first, result.exitCode)) {
+                    it->second.exited = true;
+                    it->second.exitSeen = Clock::now();
+                }
+            }
+        } else if (backend->GetLastErrorCode() != OS_ERROR_WAIT_TIMEOUT) {
+            pumpFailed = true;
+        }
+
+        now = Clock::now();
+        bool checkExit = MillisecondsBetween(lastExitCheck, now) >= CAPTURE_EXIT_CHECK_MS;
+        if (checkExit) lastExitCheck = now;
+
+        for (auto it = running.begin(); it != running.end();) {
+            RunningLaunch& state = it->second;
+            CaptureLaunchResult& result = report.results[state.index];
+            bool streamsClosed = !state.streamOpen[0] && !state.streamOpen[1];
+
+            // Exit langsung dicek saat pipe tertutup atau berkala (notifikasi job tidak dijamin)
+            if (!state.exited && (streamsClosed || checkExit) && backend->QueryCapturedExit(it->first, result.exitCode)) {
+                state.exited = true;
+                state.exitSeen = now;
+            }
+
+            if (pumpFailed) {
+                result.errorCode = backend->GetLastErrorCode();
+                it = finish(it, CAPTURE_LAUNCH_FAILED, now);
+            } else if (state.exited &&
+                       (streamsClosed || MillisecondsBetween(state.exitSeen, now) >= CAPTURE_DRAIN_TIMEOUT_MS)) {
+                it = finish(it, CAPTURE_LAUNCH_COMPLETED, now);
+            } else if (options.timeoutMs && MillisecondsBetween(state.started, now) >= options.timeoutMs) {
+                it = finish(it, CAPTURE_LAUNCH_TIMED_OUT, now);
+            } else {
+                ++it;
+            }
+        }
+
+        if (pumpFailed) {
+            // Launch yang belum dimulai tidak dapat dilayani tanpa pump
+            for (; next < launches.size(); next++) {
+                report.results[next].status = CAPTURE_LAUNCH_FAILED;
+                report.results[next].errorCode = backend->GetLastErrorCode();
+                report.launchesFailed++;
+            }
+            break;
+        }
+        startPending();
+    }
+
+    backend->CloseCapturePort(port);
+
+    for (const AttachedLaunch& attach : attached) {
+        CaptureLaunchResult& result = report.results[attach.index];
+        if (attach.source != SIZE_MAX) {
+            const CaptureLaunchResult& source = report.results[attach.source];
+            result.status = source.status == CAPTURE_LAUNCH_COMPLETED ? CAPTURE_LAUNCH_ATTACHED : source.status;
+            result.exitCode = source.exitCode;
+            result.errorCode = source.errorCode;
+            result.seconds = source.seconds;
+            if (result.Succeeded()) report.launchesSucceeded++; else report.launchesFailed++;
+            continue;
+        }
+
+        uint32_t wait = 0xFFFFFFFF;
+        if (options.timeoutMs) {
+            Clock::time_point deadline = attach.started + std::chrono::milliseconds(options.timeoutMs);
+            wait = static_cast<uint32_t>(MillisecondsBetween(Clock::now(), deadline));
+        }
+        if (ps->WaitForProcessExit(attach.process, wait, result.exitCode)) {
+            result.status = CAPTURE_LAUNCH_ATTACHED;
+        } else if (ps->GetLastErrorCode() == OS_ERROR_WAIT_TIMEOUT) {
+            result.status = CAPTURE_LAUNCH_TIMED_OUT; // Bukan milik RasTI: tidak di-terminate
+        } else {
+            result.status = CAPTURE_LAUNCH_FAILED;
+            result.errorCode = ps->GetLastErrorCode();
+        }
+        result.seconds = SecondsBetween(attach.started, Clock::now());
+        ps->CloseObject(attach.process);
+        if (result.Succeeded()) report.launchesSucceeded++; else report.launchesFailed++;
+    }
+
+    report.singleInstance = images.GetStats();
+    report.seconds = SecondsBetween(started, Clock::now());
+    return report.launchesFailed == 0;
+}
+
+//==============================================================================
+// REPORT
+//==============================================================================
+
+const char* GetCaptureLaunchStatusName(CaptureLaunchStatus status)
+{
+    switch (status)
+    {
+    case CAPTURE_LAUNCH_COMPLETED: return "completed";
+    case CAPTURE_LAUNCH_REJECTED:  return "rejected";
+    case CAPTURE_LAUNCH_FAILED:    return "failed";
+    case CAPTURE_LAUNCH_TIMED_OUT: return "timed-out";
+    case CAPTURE_LAUNCH_SKIPPED:   return "skipped";
+    case CAPTURE_LAUNCH_ATTACHED:  return "attached";
+    default:                       return "unknown";
+    }
+}
+
+std::string FormatCaptureReport(const CaptureReport& report)
+{
+    std::string text;
+    char line[256];
+
+    for (size_t i = 0; i < report.results.size(); i++) {
+        const CaptureLaunchResult& result = report.results[i];
+        if (result.status == CAPTURE_LAUNCH_REJECTED) {
+            snprintf(line, sizeof(line), "[%u] rejected (%s): ",
+                     static_cast<unsigned>(i + 1), GetValidationErrorName(result.validation));
+        } else if (result.status == CAPTURE_LAUNCH_FAILED) {
+            snprintf(line, sizeof(line), "[%u] failed (error %u): ",
+                     static_cast<unsigned>(i + 1), static_cast<unsigned>(result.errorCode));
+        } else if (result.status == CAPTURE_LAUNCH_TIMED_OUT) {
+            snprintf(line, sizeof(line), "[%u] timed-out after %.3f s, pid %u: ",
+                     static_cast<unsigned>(i + 1), result.seconds, static_cast<unsigned>(result.processId));
+        } else if (result.status == CAPTURE_LAUNCH_SKIPPED) {
+            snprintf(line, sizeof(line), "[%u] skipped, already running as pid %u: ",
+                     static_cast<unsigned>(i + 1), static_cast<unsigned>(result.processId));
+        } else if (result.status == CAPTURE_LAUNCH_ATTACHED) {
+            snprintf(line, sizeof(line), "[%u] attached to pid %u, exit %u, %.3f s: ",
+                     static_cast<unsigned>(i + 1), static_cast<unsigned>(result.processId),
+                     static_cast<unsigned>(result.exitCode), result.seconds);
+        } else {
+            snprintf(line, sizeof(line), "[%u] exit %u, %.3f s, pid %u, %llu+%llu bytes%s: ",
+                     static_cast<unsigned>(i + 1), static_cast<unsigned>(result.exitCode), result.seconds,
+                     static_cast<unsigned>(result.processId),
+                     static_cast<unsigned long long>(result.stdoutBytes),
+                     static_cast<unsigned long long>(result.stderrBytes),
+                     result.outputDetached ? " (pipe held by descendant)" : "");
+        }
+        text += line;
+        AppendUtf8(result.path, text);
+        text += '\n';
+        if (result.hasAccounting) {
+            text += "    ";
+            text += FormatProcessAccounting(result.accounting);
+            text += '\n';
+        }
+    }
+
+    snprintf(line, sizeof(line), "%llu/%llu launches succeeded, %llu failed, %.3f s\n",
+             static_cast<unsigned long long>(report.launchesSucceeded),
+             static_cast<unsigned long long>(report.results.size()),
+             static_cast<unsigned long long>(report.launchesFailed), report.seconds);
+    text += line;
+    snprintf(line, sizeof(line), "%llu bytes captured in %llu pump events, peak %llu running\n",
+             static_cast<unsigned long long>(report.bytesCaptured),
+             static_cast<unsigned long long>(report.events),
+             static_cast<unsigned long long>(report.peakRunning));
+    text += line;
+    if (report.singleInstance.lookups > 0) {
+        const RunningImageStats& stats = report.singleInstance;
+        snprintf(line, sizeof(line),
+                 "%llu already running; %llu processes indexed in %.3f s, %llu lookups, %llu opened, %llu unverified\n",
+                 static_cast<unsigned long long>(report.launchesSkipped),
+                 static_cast<unsigned long long>(stats.processesIndexed), stats.scanSeconds,
+                 static_cast<unsigned long long>(stats.lookups),
+                 static_cast<unsigned long long>(stats.candidatesOpened),
+                 static_cast<unsigned long long>(stats.unverified));
+        text += line;
+    }
+    if (report.launchesAccounted > 0) {
+        snprintf(line, sizeof(line), "%llu launches accounted: ",
+                 static_cast<unsigned long long>(report.launchesAccounted));
+        text += line;
+        text += FormatProcessAccounting(report.accounting);
+        text += '\n';
+    }
+    return text;
+}
+
+std::string FormatProcessAccounting(const ProcessAccounting& accounting)
+{
+    char line[256];
+    snprintf(line, sizeof(line),
+             "cpu %.3f s user + %.3f s kernel, peak %.1f MB, io %llu read %llu write %llu other bytes, %u processes",
+             accounting.userMicroseconds / 1e6, accounting.kernelMicroseconds / 1e6,
+             accounting.peakMemoryBytes / (1024.0 * 1024.0),
+             static_cast<unsigned long long>(accounting.readBytes),
+             static_cast<unsigned long long>(accounting.writeBytes),
+             static_cast<unsigned long long>(accounting.otherBytes),
+             static_cast<unsigned>(accounting.processCount));
+    return line;
+}
+
+static void AppendJsonAccounting(const ProcessAccounting& accounting, std::string& text)
+{
+    char number[256];
+    snprintf(number, sizeof(number),
+             "{\"userMicroseconds\":%llu,\"kernelMicroseconds\":%llu,\"peakMemoryBytes\":%llu,"
+             "\"readBytes\":%llu,\"writeBytes\":%llu,\"otherBytes\":%llu,\"processCount\":%u}",
+             static_cast<unsigned long long>(accounting.userMicroseconds),
+             static_cast<unsigned long long>(accounting.kernelMicroseconds),
+             static_cast<unsigned long long>(accounting.peakMemoryBytes),
+             static_cast<unsigned long long>(accounting.readBytes),
+             static_cast<unsigned long long>(accounting.writeBytes),
+             static_cast<unsigned long long>(accounting.otherBytes),
+             static_cast<unsigned>(accounting.processCount));
+    text += number;
+}
+
+std::string FormatCaptureReportJson(const CaptureReport& report)
+{
+    std::string text = "{\"launches\":[";
+    char number[384];
+    for (size_t i = 0; i < report.results.size(); i++) {
+        const CaptureLaunchResult& result = report.results[i];
+        text += i ? ",{\"path\":" : "{\"path\":";
+        AppendJsonString(result.path, text);
+        snprintf(number, sizeof(number),
+                 ",\"line\":%u,\"status\":\"%s\",\"validation\":\"%s\",\"pid\":%u,\"exitCode\":%u,"
+                 "\"errorCode\":%u,\"stdoutBytes\":%llu,\"stderrBytes\":%llu,\"seconds\":%.3f",
+                 static_cast<unsigned>(result.line), GetCaptureLaunchStatusName(result.status),
+                 GetValidationErrorName(result.validation), static_cast<unsigned>(result.processId),
+                 static_cast<unsigned>(result.exitCode), static_cast<unsigned>(result.errorCode),
+                 static_cast<unsigned long long>(result.stdoutBytes),
+                 static_cast<unsigned long long>(result.stderrBytes), result.seconds);
+        text += number;
+        if (result.hasAccounting) {
+            text += ",\"accounting\":";
+            AppendJsonAccounting(result.accounting, text);
+        }
+        text += '}';
+    }
+    snprintf(number, sizeof(number),
+             "],\"succeeded\":%llu,\"failed\":%llu,\"skipped\":%llu,\"seconds\":%.3f,\"accounted\":%llu",
+             static_cast<unsigned long long>(report.launchesSucceeded),
+             static_cast<unsigned long long>(report.launchesFailed),
+             static_cast<unsigned long long>(report.launchesSkipped), report.seconds,
+             static_cast<unsigned long long>(report.launchesAccounted));
+    text += number;
+    if (report.launchesAccounted > 0) {
+        text += ",\"accounting\":";
+        AppendJsonAccounting(report.accounting, text);
+    }
+    text += "}\n";
+    return text;
+}
+
+//==============================================================================
+// CONSOLE WRITER
+//==============================================================================
+
+CaptureConsoleWriter::CaptureConsoleWriter(Sink sink, bool tagLines)
+    : sink_(std::move(sink)), tagLines_(tagLines)
+{
+}
+
+void CaptureConsoleWriter::Write(size_t launch, CaptureStream stream, std::string_view data)
+{
+    if (!tagLines_) {
+        sink_(stream, data);
+        return;
+    }
+
+    // Baris launch lain yang belum selesai ditutup agar tag tetap di awal baris
+    if (!atLineStart_ && (launch != lastLaunch_ || stream != lastStream_)) {
+        sink_(lastStream_, "\n");
+        atLineStart_ = true;
+    }
+    lastLaunch_ = launch;
+    lastStream_ = stream;
+
+    char tag[32];
+    int tagLength = snprintf(tag, sizeof(tag), "[%u] ", static_cast<unsigned>(launch + 1));
+    while (!data.empty()) {
+        if (atLineStart_) {
+            sink_(stream, std::string_view(tag, static_cast<size_t>(tagLength)));
+        }
+        size_t newline = data.find('\n');
+        size_t length = (newline == std::string_view::npos) ? data.size() : newline + 1;
+        sink_(stream, data.substr(0, length));
+        atLineStart_ = newline != std::string_view::npos;
+        data.remove_prefix(length);
+    }
+}
+
+void CaptureConsoleWriter::Finish()
+{
+    if (!atLineStart_) {
+        sink_(lastStream_, "\n");
+        atLineStart_ = true;
+    }
+}
+
+//==============================================================================
+// LOG WRITER
+//==============================================================================
+
+/** @brief Nama file dari path (tanpa direktori) */
+static std::wstring_view FileNamePart(std::wstring_view path)
+{
+    size_t slash = path.find_last_of(L"\\/");
+    return slash == std::wstring_view::npos ? path : path.substr(slash + 1);
+}
+
+CaptureLogWriter::CaptureLogWriter(const std::wstring& directory, const std::vector<CaptureLaunch>& launches,
+                                   uint64_t maxBytes, unsigned rotations)
+    : backend_(GetOutputCaptureBackend()), maxBytes_(maxBytes ? maxBytes : 1), rotations_(rotations)
+{
+    std::wstring prefix = directory;
+    if (!prefix.empty() && prefix.back() != L'\\' && prefix.back() != L'/') {
+        prefix += L'\\';
+    }
+
+    logs_.resize(launches.size());
+    for (size_t i = 0; i < launches.size(); i++) {
+        logs_[i].base = prefix + std::to_wstring(i + 1) + L"-";
+        logs_[i].base += FileNamePart(launches[i].path);
+    }
+}
+
+CaptureLogWriter::~CaptureLogWriter()
+{
+    Close();
+}
+
+std::wstring CaptureLogWriter::GetLogPath(size_t launch) const
+{
+    return launch < logs_.size() ? logs_[launch].base + L".log" : std::wstring();
+}
+
+bool CaptureLogWriter::Fail(LogFile& log)
+{
+    if (!error_) error_ = backend_->GetLastErrorCode();
+    backend_->CloseLogFile(log.file);
+    log.file = OS_INVALID_HANDLE;
+    log.failed = true;
+    return false;
+}
+
+/** @brief NAMA.log -> NAMA.1.log, NAMA.1.log -> NAMA.2.log, ...; lalu NAMA.log baru */
+bool CaptureLogWriter::Rotate(LogFile& log)
+{
+    backend_->CloseLogFile(log.file);
+    log.file = OS_INVALID_HANDLE;
+
+    if (rotations_ > 0) {
+        for (unsigned k = rotations_; k > 1; k--) {
+            std::wstring older = log.base + L"." + std::to_wstring(k - 1) + L".log";
+            std::wstring newer = log.base + L"." + std::to_wstring(k) + L".log";
+            if (!backend_->RenameLogFile(older, newer) && backend_->GetLastErrorCode() != OS_ERROR_FILE_NOT_FOUND) {
+                return Fail(log);
+            }
+        }
+        if (!backend_->RenameLogFile(log.base + L".log", log.base + L".1.log")) {
+            return Fail(log);
+        }
+    }
+
+    rotationCount_++;
+    log.size = 0;
+    log.file = backend_->CreateLogFile(log.base + L".log");
+    return log.file != OS_INVALID_HANDLE || Fail(log);
+}
+
+bool CaptureLogWriter::Write(size_t launch, std::string_view data)
+{
+    if (launch >= logs_.size()) {
+        return false;
+    }
+    LogFile& log = logs_[launch];
+    if (log.failed) {
+        return false;
+    }
+    if (log.file == OS_INVALID_HANDLE) {
+        log.file = backend_->CreateLogFile(log.base + L".log");
+        log.size = 0;
+        if (log.file == OS_INVALID_HANDLE) {
+            return Fail(log);
+        }
+    }
+
+    while (!data.empty()) {
+        size_t take = data.size();
+        bool full = log.size + take > maxBytes_;
+        if (full) {
+            // Potong di newline terakhir yang muat; baris yang tidak muat pindah ke file baru
+            take = static_cast<size_t>(maxBytes_ - log.size);
+            size_t newline = data.substr(0, take).rfind('\n');
+            if (newline != std::string_view::npos) {
+                take = newline + 1;
+            } else if (log.size > 0) {
+                take = 0;
+            }
+        }
+
+        if (take > 0) {
+            if (!backend_->WriteLogFile(log.file, data.data(), take)) {
+                return Fail(log);
+            }
+            log.size += take;
+            data.remove_prefix(take);
+        }
+        if (full && !Rotate(log)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void CaptureLogWriter::Close()
+{
+    for (LogFile& log : logs_) {
+        backend_->CloseLogFile(log.file);
+        log.file = OS_INVALID_HANDLE;
+    }
+}
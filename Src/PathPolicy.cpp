@@ -0,0 +1,382 @@
+/**
+ * @file PathPolicy.cpp
+ * @brief Implementasi kompilasi dan evaluasi policy path allow/deny
+ *
+ * Pattern dan path dinormalisasi dengan cara yang sama (uppercase, '/' -> '\',
+ * prefix "\\?\" dihapus) lalu dipecah per komponen. Evaluasi mensimulasikan
+ * automaton non-deterministik di atas trie: himpunan state aktif hanya
+ * bertambah pada komponen wildcard atau "**", sehingga path yang hanya cocok
+ * dengan rule literal cukup satu lookup hash map per komponen.
+ *
+ * @author RasTI Development Team
+ * @version 1.2.0.0
+ * @date 2025
+ */
+
+#include "PathPolicy.h"
+#include "Backend.h"
+#include "TextEncoding.h"
+#include <cwctype>
+
+//==============================================================================
+// ACTIVE POLICY
+//==============================================================================
+
+/** @brief Policy yang dipasang secara eksplisit (NULL = tidak ada pemeriksaan policy) */
+static const PathPolicy* gPathPolicy = nullptr;
+
+void SetPathPolicy(const PathPolicy* policy)
+{
+    gPathPolicy = policy;
+}
+
+const PathPolicy* GetPathPolicy()
+{
+    return gPathPolicy;
+}
+
+//==============================================================================
+// INTERNAL HELPERS
+//==============================================================================
+
+/** @brief Komponen khusus yang mewakili root UNC ("\\server\share") */
+static const wchar_t UNC_ROOT_SEGMENT[] = L"\\\\";
+
+static wchar_t FoldCase(wchar_t ch)
+{
+    if (ch < 0x80) {
+        return (ch >= L'a' && ch <= L'z') ? static_cast<wchar_t>(ch - L'a' + L'A') : ch;
+    }
+    return static_cast<wchar_t>(std::towupper(static_cast<std::wint_t>(ch)));
+}
+
+/**
+ * @brief Normalisasi path/pattern: uppercase, '/' -> '\', hapus prefix extended-length
+ */
+static void NormalizePolicyPath(std::wstring_view path, std::wstring& normalized)
+{
+    normalized.clear();
+
+    if (path.substr(0, 8) == L"\\\\?\\UNC\\") {
+        normalized.assign(L"\\\\");
+        path.remove_prefix(8);
+    } else if (path.substr(0, 4) == L"\\\\?\\") {
+        path.remove_prefix(4);
+    }
+
+    normalized.reserve(normalized.size() + path.size());
+    for (wchar_t ch : path) {
+        normalized.push_back(ch == L'/' ? L'\\' : FoldCase(ch));
+    }
+}
+
+/**
+ * @brief Mengambil komponen path berikutnya mulai dari pos
+ *
+ * Separator berulang dilewati. Path yang diawali "\\" menghasilkan komponen
+ * UNC_ROOT_SEGMENT terlebih dahulu agar root UNC tidak tertukar dengan drive.
+ */
+static bool NextSegment(std::wstring_view path, size_t& pos, std::wstring_view& segment)
+{
+    if (pos == 0 && path.size() >= 2 && path[0] == L'\\' && path[1] == L'\\') {
+        segment = std::wstring_view(UNC_ROOT_SEGMENT, 2);
+        pos = 2;
+        return true;
+    }
+
+    while (pos < path.size() && path[pos] == L'\\') pos++;
+    if (pos >= path.size()) return false;
+
+    size_t end = path.find(L'\\', pos);
+    if (end == std::wstring_view::npos) end = path.size();
+    segment = path.substr(pos, end - pos);
+    pos = end;
+    return true;
+}
+
+static bool HasWildcard(std::wstring_view segment)
+{
+    return segment.find_first_of(L"*?") != std::wstring_view::npos;
+}
+
+/**
+ * @brief Mencocokkan satu komponen dengan glob ('*' dan '?') tanpa rekursi
+ */
+static bool GlobMatch(std::wstring_view pattern, std::wstring_view text)
+{
+    size_t p = 0, t = 0;
+    size_t starPattern = std::wstring_view::npos, starText = 0;
+
+    while (t < text.size()) {
+        if (p < pattern.size() && (pattern[p] == L'?' || pattern[p] == text[t])) {
+            p++;
+            t++;
+        } else if (p < pattern.size() && pattern[p] == L'*') {
+            starPattern = p++;
+            starText = t;
+        } else if (starPattern != std::wstring_view::npos) {
+            p = starPattern + 1;
+            t = ++starText;
+        } else {
+            return false;
+        }
+    }
+
+    while (p < pattern.size() && pattern[p] == L'*') p++;
+    return p == pattern.size();
+}
+
+static bool IsBlank(wchar_t ch)
+{
+    return ch == L' ' || ch == L'\t' || ch == L'\r';
+}
+
+//==============================================================================
+// COMPILATION
+//==============================================================================
+
+void PathPolicy::Clear()
+{
+    nodes_.assign(1, Node());
+    segments_.clear();
+    ruleLines_.clear();
+    allowCount_ = 0;
+}
+
+uint32_t PathPolicy::AddChild(uint32_t parent, std::wstring_view segment)
+{
+    uint32_t child = static_cast<uint32_t>(nodes_.size());
+
+    if (segment == L"**") {
+        if (nodes_[parent].isRecursive) {
+            return parent; // "**\**" sama dengan "**"
+        }
+        if (nodes_[parent].recursive != NONE) {
+            return nodes_[parent].recursive;
+        }
+        nodes_.push_back(Node());
+        nodes_[child].isRecursive = true;
+        nodes_[parent].recursive = child;
+        return child;
+    }
+
+    if (HasWildcard(segment)) {
+        for (const auto& glob : nodes_[parent].globs) {
+            if (glob.first == segment) return glob.second;
+        }
+        segments_.emplace_back(segment);
+        nodes_.push_back(Node());
+        nodes_[parent].globs.emplace_back(std::wstring_view(segments_.back()), child);
+        return child;
+    }
+
+    auto it = nodes_[parent].literals.find(segment);
+    if (it != nodes_[parent].literals.end()) {
+        return it->second;
+    }
+    segments_.emplace_back(segment);
+    nodes_.push_back(Node());
+    nodes_[parent].literals.emplace(std::wstring_view(segments_.back()), child);
+    return child;
+}
+
+bool PathPolicy::AddRuleAtLine(PathPolicyAction action, std::wstring_view pattern, uint32_t line)
+{
+    std::wstring normalized;
+    NormalizePolicyPath(pattern, normalized);
+    if (!normalized.empty() && normalized.back() == L'\\') {
+        normalized += L"**"; // "C:\Tools\" = semua isi direktori
+    }
+
+    // Validasi dulu agar rule yang ditolak tidak meninggalkan node setengah jadi
+    size_t pos = 0;
+    size_t segmentCount = 0;
+    std::wstring_view segment;
+    while (NextSegment(normalized, pos, segment)) {
+        if (segment == L"." || segment == L"..") return false;
+        segmentCount++;
+    }
+    if (segmentCount == 0) return false;
+
+    uint32_t node = 0;
+    pos = 0;
+    while (NextSegment(normalized, pos, segment)) {
+        node = AddChild(node, segment);
+    }
+
+    uint32_t ruleIndex = static_cast<uint32_t>(ruleLines_.size());
+    ruleLines_.push_back(line);
+
+    // Rule lebih awal menang untuk pelaporan jika beberapa rule identik
+    uint32_t& slot = (action == POLICY_ACTION_DENY) ? nodes_[node].denyRule : nodes_[node].allowRule;
+    if (slot == NONE) slot = ruleIndex;
+    if (action == POLICY_ACTION_ALLOW) allowCount_++;
+    return true;
+}
+
+bool PathPolicy::AddRule(PathPolicyAction action, std::wstring_view pattern)
+{
+    return AddRuleAtLine(action, pattern, static_cast<uint32_t>(ruleLines_.size() + 1));
+}
+
+bool PathPolicy::LoadFromText(std::string_view text, size_t* errorLine)
+{
+    size_t lineNumber = 0;
+    size_t start = 0;
+    bool valid = true;
+    std::wstring decoded;
+
+    // UTF-8 BOM dari editor Windows
+    if (text.substr(0, 3) == "\xEF\xBB\xBF") {
+        start = 3;
+    }
+
+    while (valid && start < text.size()) {
+        size_t end = text.find('\n', start);
+        if (end == std::string_view::npos) end = text.size();
+        std::string_view rawLine = text.substr(start, end - start);
+        start = end + 1;
+        lineNumber++;
+
+        if (!DecodeUtf8(rawLine, decoded)) {
+            valid = false;
+            break;
+        }
+
+        std::wstring_view line(decoded);
+        while (!line.empty() && IsBlank(line.front())) line.remove_prefix(1);
+        while (!line.empty() && IsBlank(line.back())) line.remove_suffix(1);
+        if (line.empty() || line.front() == L'#') continue;
+
+        size_t keywordEnd = 0;
+        while (keywordEnd < line.size() && !IsBlank(line[keywordEnd])) keywordEnd++;
+
+        std::wstring keyword;
+        for (wchar_t ch : line.substr(0, keywordEnd)) keyword.push_back(FoldCase(ch));
+
+        std::wstring_view pattern = line.substr(keywordEnd);
+        while (!pattern.empty() && IsBlank(pattern.front())) pattern.remove_prefix(1);
+        if (pattern.size() >= 2 && pattern.front() == L'"' && pattern.back() == L'"') {
+            pattern = pattern.substr(1, pattern.size() - 2);
+        }
+
+        if (keyword == L"ALLOW") {
+            valid = AddRuleAtLine(POLICY_ACTION_ALLOW, pattern, static_cast<uint32_t>(lineNumber));
+        } else if (keyword == L"DENY") {
+            valid = AddRuleAtLine(POLICY_ACTION_DENY, pattern, static_cast<uint32_t>(lineNumber));
+        } else {
+            valid = false;
+        }
+    }
+
+    if (!valid) {
+        // SECURITY: Policy rusak tidak boleh diterapkan sebagian
+        Clear();
+        AddRuleAtLine(POLICY_ACTION_DENY, L"**", static_cast<uint32_t>(lineNumber));
+        if (errorLine) *errorLine = lineNumber;
+        return false;
+    }
+
+    if (errorLine) *errorLine = 0;
+    return true;
+}
+
+bool PathPolicy::LoadFromFile(std::wstring_view path, size_t* errorLine)
+{
+    if (errorLine) *errorLine = 0;
+
+    std::string text;
+    if (!ReadSmallFile(GetFileSystemBackend(), std::wstring(path), PATH_POLICY_MAX_FILE_SIZE, text)) {
+        Clear();
+        AddRuleAtLine(POLICY_ACTION_DENY, L"**", 0);
+        return false;
+    }
+
+    Clear();
+    return LoadFromText(text, errorLine);
+}
+
+//==============================================================================
+// EVALUATION
+//==============================================================================
+
+void PathPolicy::AddState(std::vector<uint32_t>& states, uint32_t node) const
+{
+    // Epsilon-closure: "**" juga boleh cocok dengan nol komponen
+    while (node != NONE) {
+        for (uint32_t existing : states) {
+            if (existing == node) return;
+        }
+        states.push_back(node);
+        node = nodes_[node].recursive;
+    }
+}
+
+PathPolicyDecision PathPolicy::Evaluate(std::wstring_view path, PathPolicyMatch* match) const
+{
+    std::wstring normalized;
+    NormalizePolicyPath(path, normalized);
+
+    std::vector<uint32_t> current;
+    std::vector<uint32_t> next;
+    current.reserve(8);
+    next.reserve(8);
+    AddState(current, 0);
+
+    size_t pos = 0;
+    std::wstring_view segment;
+    while (!current.empty() && NextSegment(normalized, pos, segment)) {
+        next.clear();
+        for (uint32_t state : current) {
+            const Node& node = nodes_[state];
+
+            if (node.isRecursive) {
+                AddState(next, state);
+            }
+
+            auto it = node.literals.find(segment);
+            if (it != node.literals.end()) {
+                AddState(next, it->second);
+            }
+
+            for (const auto& glob : node.globs) {
+                if (GlobMatch(glob.first, segment)) {
+                    AddState(next, glob.second);
+                }
+            }
+        }
+        current.swap(next);
+    }
+
+    uint32_t allowRule = NONE;
+    uint32_t denyRule = NONE;
+    for (uint32_t state : current) {
+        if (nodes_[state].allowRule < allowRule) allowRule = nodes_[state].allowRule;
+        if (nodes_[state].denyRule < denyRule) denyRule = nodes_[state].denyRule;
+    }
+
+    PathPolicyMatch result;
+    if (denyRule != NONE) {
+        result.decision = POLICY_DECISION_DENIED;
+        result.ruleLine = ruleLines_[denyRule];
+    } else if (allowCount_ > 0 && allowRule == NONE) {
+        result.decision = POLICY_DECISION_NOT_ALLOWED;
+    } else {
+        result.decision = POLICY_DECISION_ALLOWED;
+        result.ruleLine = (allowRule != NONE) ? ruleLines_[allowRule] : 0;
+    }
+
+    if (match) *match = result;
+    return result.decision;
+}
+
+const char* GetPathPolicyDecisionName(PathPolicyDecision decision)
+{
+    switch (decision)
+    {
+    case POLICY_DECISION_ALLOWED:     return "allowed";
+    case POLICY_DECISION_DENIED:      return "denied";
+    case POLICY_DECISION_NOT_ALLOWED: return "not-allowed";
+    default:                          return "unknown";
+    }
+}
@@ -0,0 +1,331 @@
+/**
+ * @file ProcessAdjust.cpp
+ * @brief Implementasi /adjust: tabel proses berindeks dan pengaturan massal
+ *
+ * Pencocokan selector hanya memakai indeks (tanpa syscall) kecuali untuk
+ * selector path, yang membuka kandidat bernama sama untuk membaca path
+ * lengkapnya. Kandidat path yang tidak dapat dibuka tetap dilaporkan
+ * sebagai gagal: proses tersebut tidak dapat diverifikasi maupun diubah.
+ *
+ * @author RasTI Development Team
+ * @version 1.2.0.0
+ * @date 2025
+ */
+
+#include "ProcessAdjust.h"
+#include "TextEncoding.h"
+#include <chrono>
+#include <cstdio>
+
+//==============================================================================
+// SELECTORS
+//==============================================================================
+
+static wchar_t FoldCase(wchar_t ch)
+{
+    return (ch >= L'a' && ch <= L'z') ? static_cast<wchar_t>(ch - L'a' + L'A') : ch;
+}
+
+static std::wstring FoldString(std::wstring_view text)
+{
+    std::wstring folded;
+    folded.reserve(text.size());
+    for (wchar_t ch : text) folded.push_back(FoldCase(ch));
+    return folded;
+}
+
+/** @brief Path sama, case-insensitive dan '/' = '\' */
+static bool EqualPath(std::wstring_view a, std::wstring_view b)
+{
+    if (a.size() != b.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < a.size(); i++) {
+        wchar_t x = a[i] == L'/' ? L'\\' : FoldCase(a[i]);
+        wchar_t y = b[i] == L'/' ? L'\\' : FoldCase(b[i]);
+        if (x != y) return false;
+    }
+    return true;
+}
+
+bool ParseProcessSelector(std::wstring_view text, ProcessSelector& selector)
+{
+    selector = ProcessSelector();
+    if (text.empty()) {
+        return false;
+    }
+    selector.text.assign(text);
+
+    bool digits = true;
+    for (wchar_t ch : text) {
+        if (ch < L'0' || ch > L'9') {
+            digits = false;
+            break;
+        }
+    }
+    if (digits) {
+        uint64_t value = 0;
+        for (wchar_t ch : text) {
+            value = value * 10 + static_cast<uint64_t>(ch - L'0');
+            if (value > 0xFFFFFFFFull) {
+                return false;
+            }
+        }
+        selector.kind = PROCESS_SELECT_ID;
+        selector.processId = static_cast<uint32_t>(value);
+        return value != 0; // PID 0 = System Idle Process
+    }
+
+    size_t separator = text.find_last_of(L"\\/");
+    if (separator == std::wstring_view::npos) {
+        selector.kind = PROCESS_SELECT_NAME;
+        return true;
+    }
+    selector.kind = PROCESS_SELECT_PATH;
+    return separator + 1 < text.size(); // Harus diakhiri nama file
+}
+
+//==============================================================================
+// PROCESS TABLE
+//==============================================================================
+
+bool ProcessTable::Load(IProcessBackend* backend)
+{
+    byId_.clear();
+    byName_.clear();
+    if (!backend->EnumerateProcesses(entries_)) {
+        entries_.clear();
+        return false;
+    }
+
+    byId_.reserve(entries_.size());
+    for (size_t i = 0; i < entries_.size(); i++) {
+        byId_[entries_[i].processId] = i;
+        byName_[FoldString(entries_[i].imageName)].push_back(i);
+    }
+    return true;
+}
+
+size_t ProcessTable::FindById(uint32_t processId) const
+{
+    auto it = byId_.find(processId);
+    return it == byId_.end() ? SIZE_MAX : it->second;
+}
+
+const std::vector<size_t>& ProcessTable::FindByName(std::wstring_view imageName) const
+{
+    auto it = byName_.find(FoldString(imageName));
+    return it == byName_.end() ? none_ : it->second;
+}
+
+//==============================================================================
+// ENGINE
+//==============================================================================
+
+bool ProcessAdjustResult::Succeeded() const
+{
+    if (openError != 0) {
+        return false;
+    }
+    for (const ProcessSettingResult& setting : settings) {
+        if (setting.errorCode != 0) return false;
+    }
+    return true;
+}
+
+namespace {
+
+typedef std::chrono::steady_clock Clock;
+
+double SecondsBetween(Clock::time_point from, Clock::time_point to)
+{
+    return std::chrono::duration<double>(to - from).count();
+}
+
+/** @brief Proses yang cocok, dengan handle jika sudah dibuka saat verifikasi path */
+struct AdjustTarget {
+    bool matched = false;
+    OsHandle process = OS_INVALID_HANDLE;
+    uint32_t openError = 0;
+    std::wstring path;
+};
+
+/** @brief Pengaturan yang diatur, dalam urutan penerapan */
+std::vector<std::pair<ProcessSetting, uint64_t>> ListSettings(const ProcessAdjustment& adjustment)
+{
+    std::vector<std::pair<ProcessSetting, uint64_t>> settings;
+    if (adjustment.priorityClass != 0) {
+        settings.push_back(std::make_pair(PROCESS_SETTING_PRIORITY_CLASS, adjustment.priorityClass));
+    }
+    if (adjustment.affinityMask != 0) {
+        settings.push_back(std::make_pair(PROCESS_SETTING_AFFINITY, adjustment.affinityMask));
+    }
+    if (adjustment.ioPriority != LAUNCH_SETTING_UNSET) {
+        settings.push_back(std::make_pair(PROCESS_SETTING_IO_PRIORITY, adjustment.ioPriority));
+    }
+    if (adjustment.memoryPriority != LAUNCH_SETTING_UNSET) {
+        settings.push_back(std::make_pair(PROCESS_SETTING_MEMORY_PRIORITY, adjustment.memoryPriority));
+    }
+    return settings;
+}
+
+} // namespace
+
+bool AdjustProcesses(const std::vector<ProcessSelector>& selectors, const ProcessAdjustment& adjustment,
+                     ProcessAdjustReport& report)
+{
+    IProcessBackend* ps = GetProcessBackend();
+    Clock::time_point started = Clock::now();
+    report = ProcessAdjustReport();
+
+    // STEP 1: Satu snapshot untuk semua selector
+    ProcessTable table;
+    bool loaded = table.Load(ps);
+    report.scanSeconds = SecondsBetween(started, Clock::now());
+    if (!loaded) {
+        report.errorCode = ps->GetLastErrorCode();
+        report.seconds = report.scanSeconds;
+        return false;
+    }
+    const std::vector<ProcessEntry>& entries = table.GetEntries();
+    report.processesScanned = entries.size();
+
+    // STEP 2: Cocokkan selector lewat indeks; target per entri mencegah duplikasi
+    std::vector<AdjustTarget> targets(entries.size());
+    for (size_t s = 0; s < selectors.size(); s++) {
+        const ProcessSelector& selector = selectors[s];
+        bool found = false;
+
+        if (selector.kind == PROCESS_SELECT_ID) {
+            size_t index = table.FindById(selector.processId);
+            if (index != SIZE_MAX) {
+                targets[index].matched = true;
+                found = true;
+            }
+        } else if (selector.kind == PROCESS_SELECT_NAME) {
+            for (size_t index : table.FindByName(selector.text)) {
+                targets[index].matched = true;
+                found = true;
+            }
+        } else {
+            std::wstring_view fileName(selector.text);
+            fileName.remove_prefix(fileName.find_last_of(L"\\/") + 1);
+            for (size_t index : table.FindByName(fileName)) {
+                AdjustTarget& target = targets[index];
+                if (target.process == OS_INVALID_HANDLE && target.openError == 0) {
+                    target.process = ps->OpenProcessHandle(entries[index].processId);
+                    if (target.process == OS_INVALID_HANDLE) {
+                        target.openError = ps->GetLastErrorCode();
+                    } else if (!ps->QueryProcessImagePath(target.process, target.path)) {
+                        target.openError = ps->GetLastErrorCode();
+                        ps->CloseObject(target.process);
+                        target.process = OS_INVALID_HANDLE;
+                    }
+                }
+                if (target.openError != 0 || EqualPath(target.path, selector.text)) {
+                    target.matched = true;
+                    found = true;
+                }
+            }
+        }
+
+        if (!found) {
+            report.unmatchedSelectors.push_back(s);
+        }
+    }
+
+    // STEP 3: Terapkan pengaturan ke setiap proses yang cocok (urutan snapshot)
+    std::vector<std::pair<ProcessSetting, uint64_t>> settings = ListSettings(adjustment);
+    for (size_t index = 0; index < entries.size(); index++) {
+        AdjustTarget& target = targets[index];
+        if (!target.matched) {
+            if (target.process != OS_INVALID_HANDLE) {
+                ps->CloseObject(target.process); // Kandidat path yang tidak cocok
+            }
+            continue;
+        }
+
+        ProcessAdjustResult result;
+        result.processId = entries[index].processId;
+        result.imageName = entries[index].imageName;
+        result.path = target.path;
+        result.openError = target.openError;
+        if (!settings.empty() && target.process == OS_INVALID_HANDLE && target.openError == 0) {
+            target.process = ps->OpenProcessHandle(result.processId);
+            if (target.process == OS_INVALID_HANDLE) {
+                result.openError = ps->GetLastErrorCode();
+            }
+        }
+        if (target.process != OS_INVALID_HANDLE) {
+            for (const auto& setting : settings) {
+                ProcessSettingResult applied;
+                applied.setting = setting.first;
+                if (!ps->SetProcessSetting(target.process, setting.first, setting.second)) {
+                    applied.errorCode = ps->GetLastErrorCode();
+                }
+                result.settings.push_back(applied);
+            }
+            ps->CloseObject(target.process);
+        }
+
+        report.matched++;
+        if (result.Succeeded()) {
+            report.adjusted++;
+        } else {
+            report.failed++;
+        }
+        report.results.push_back(std::move(result));
+    }
+
+    report.seconds = SecondsBetween(started, Clock::now());
+    return report.unmatchedSelectors.empty() && report.failed == 0;
+}
+
+//==============================================================================
+// REPORT
+//==============================================================================
+
+std::string FormatProcessAdjustReport(const std::vector<ProcessSelector>& selectors,
+                                      const ProcessAdjustReport& report)
+{
+    std::string text;
+    char line[256];
+
+    for (const ProcessAdjustResult& result : report.results) {
+        snprintf(line, sizeof(line), "  %6u ", static_cast<unsigned>(result.processId));
+        text += line;
+        AppendUtf8(result.path.empty() ? result.imageName : result.path, text);
+        if (result.openError != 0) {
+            snprintf(line, sizeof(line), "  FAILED (open error %u)", static_cast<unsigned>(result.openError));
+            text += line;
+        }
+        for (const ProcessSettingResult& setting : result.settings) {
+            if (setting.errorCode == 0) {
+                snprintf(line, sizeof(line), "  %s ok", GetProcessSettingName(setting.setting));
+            } else {
+                snprintf(line, sizeof(line), "  %s FAILED (error %u)", GetProcessSettingName(setting.setting),
+                         static_cast<unsigned>(setting.errorCode));
+            }
+            text += line;
+        }
+        text += '\n';
+    }
+    for (size_t index : report.unmatchedSelectors) {
+        text += "No process matches ";
+        if (index < selectors.size()) {
+            AppendUtf8(selectors[index].text, text);
+        }
+        text += '\n';
+    }
+    if (report.errorCode != 0) {
+        snprintf(line, sizeof(line), "Process snapshot failed (error %u)\n", static_cast<unsigned>(report.errorCode));
+        text += line;
+    }
+    snprintf(line, sizeof(line), "%llu processes scanned in %.3f s, %llu matched, %llu adjusted, %llu failed, %.3f s\n",
+             static_cast<unsigned long long>(report.processesScanned), report.scanSeconds,
+             static_cast<unsigned long long>(report.matched),
+             static_cast<unsigned long long>(report.adjusted),
+             static_cast<unsigned long long>(report.failed), report.seconds);
+    text += line;
+    return text;
+}
@@ -0,0 +1,367 @@
+/**
+ * @file RasTIApi.cpp
+ * @brief Implementasi C ABI RasTI di atas modul Core portable
+ *
+ * Setiap function hanya menerjemahkan tipe C (UTF-8, struct POD, handle
+ * opaque) ke modul yang juga dipakai RasTI.exe: Validation, HashAllowlist,
+ * PathPolicy, dan TrustedInstaller. Tidak ada dependency VCL; panggilan OS
+ * melalui backend aktif (BackendWin32.cpp di Windows), sehingga C ABI dapat
+ * diuji dengan backend palsu di Linux.
+ *
+ * @author RasTI Development Team
+ * @version 1.2.0.0
+ * @date 2025
+ */
+
+#include "RasTIApi.h"
+#include "HashAllowlist.h"
+#include "PathPolicy.h"
+#include "TextEncoding.h"
+#include "TrustedInstaller.h"
+#include "Validation.h"
+#include <algorithm>
+#include <cstring>
+#include <mutex>
+#include <new>
+
+#ifdef _WIN32
+void ResolveDynamicFunctions(); // Core.cpp - RtlAdjustPrivilege, LogonUserExExW
+#endif
+
+//==============================================================================
+// HANDLES AND ERROR STATE
+//==============================================================================
+
+/** @brief Token Trusted Installer beserta backend yang membukanya */
+struct RastiToken_ {
+    IProcessBackend* backend;
+    OsHandle handle;
+    TrustedInstallerLauncher launcher; /**< Pilihan API launch diingat per token */
+
+    RastiToken_(IProcessBackend* owner, OsHandle token) : backend(owner), handle(token) {}
+};
+
+/** @brief Handle proses beserta backend yang membukanya */
+struct RastiProcess_ {
+    IProcessBackend* backend;
+    OsHandle handle;
+};
+
+/** @brief Detail operasi terakhir per thread (pengganti GetLastError) */
+static thread_local RastiError gLastError = { RASTI_PHASE_NONE, 0, 0 };
+
+/** @brief Mencatat kegagalan dan mengembalikan 0 untuk return langsung */
+static int Fail(RastiPhase phase, uint32_t code, uint32_t validation = VALIDATION_OK)
+{
+    gLastError.phase = phase;
+    gLastError.code = code;
+    gLastError.validation = validation;
+    return 0;
+}
+
+/** @brief Mencatat kegagalan dengan kode error backend proses, atau fallback jika 0 */
+static int FailWithBackendError(RastiPhase phase, uint32_t fallback)
+{
+    uint32_t code = GetProcessBackend()->GetLastErrorCode();
+    return Fail(phase, code != 0 ? code : fallback);
+}
+
+/** @brief Mengosongkan detail error setelah operasi berhasil */
+static int Succeed()
+{
+    gLastError.phase = RASTI_PHASE_NONE;
+    gLastError.code = 0;
+    gLastError.validation = VALIDATION_OK;
+    return 1;
+}
+
+/** @brief Decode parameter UTF-8 wajib (NULL atau tidak valid = false) */
+static bool DecodeArgument(const char* text, std::wstring& decoded)
+{
+    return text && DecodeUtf8(std::string_view(text, strlen(text)), decoded);
+}
+
+/** @brief Priority class Win32 yang diterima (sama dengan ValidatePriorityValue) */
+static bool IsSupportedPriority(uint32_t priority)
+{
+    switch (priority) {
+    case 0x00000040: // IDLE_PRIORITY_CLASS
+    case 0x00004000: // BELOW_NORMAL_PRIORITY_CLASS
+    case 0x00000020: // NORMAL_PRIORITY_CLASS
+    case 0x00008000: // ABOVE_NORMAL_PRIORITY_CLASS
+    case 0x00000080: // HIGH_PRIORITY_CLASS
+    case 0x00000100: // REALTIME_PRIORITY_CLASS
+        return true;
+    default:
+        return false;
+    }
+}
+
+/**
+ * @brief Sanitasi + pipeline validasi yang sama dengan RasTI.exe "path"
+ *
+ * @return 1 jika valid; jika tidak, error RASTI_PHASE_VALIDATE sudah dicatat
+ */
+static int ValidateArgument(const char* path, ValidatedExecutable& validated)
+{
+    std::wstring widePath;
+    if (!DecodeArgument(path, widePath)) {
+        return Fail(RASTI_PHASE_ARGUMENT, OS_ERROR_INVALID_PARAMETER);
+    }
+
+    ValidationError result = SanitizePath(widePath) ? ValidateExecutable(widePath, validated)
+                                                    : VALIDATION_UNSAFE_PATH;
+    if (result != VALIDATION_OK) {
+        return Fail(RASTI_PHASE_VALIDATE, 0, result);
+    }
+    return 1;
+}
+
+//==============================================================================
+// CONFIGURATION
+//==============================================================================
+
+/**
+ * @brief Kode error kegagalan load: 0 untuk parse error (lihat errorLine),
+ *        selain itu GetLastError dari open/read file
+ */
+static uint32_t ConfigErrorCode(const size_t* errorLine)
+{
+    return (errorLine && *errorLine != 0) ? 0 : GetProcessBackend()->GetLastErrorCode();
+}
+
+/** @brief Allowlist dan policy milik library (terpisah dari RasTI.exe) */
+static std::mutex gConfigMutex;
+static HashAllowlist gApiAllowlist;
+static PathPolicy gApiPolicy;
+
+extern "C" uint32_t RASTI_CALL RastiGetApiVersion(void)
+{
+    return RASTI_API_VERSION;
+}
+
+extern "C" int RASTI_CALL RastiLoadAllowlist(const char* path, size_t* errorLine)
+{
+    if (errorLine) {
+        *errorLine = 0;
+    }
+    std::lock_guard<std::mutex> lock(gConfigMutex);
+    if (!path) {
+        SetExecutableAllowlist(NULL);
+        return Succeed();
+    }
+
+    std::wstring widePath;
+    if (!DecodeArgument(path, widePath)) {
+        return Fail(RASTI_PHASE_ARGUMENT, OS_ERROR_INVALID_PARAMETER);
+    }
+
+    // SECURITY: Aktifkan walaupun gagal - allowlist kosong menolak semua executable
+    bool loaded = gApiAllowlist.LoadFromFile(widePath, errorLine);
+    SetExecutableAllowlist(&gApiAllowlist);
+    return loaded ? Succeed() : Fail(RASTI_PHASE_CONFIG, ConfigErrorCode(errorLine));
+}
+
+extern "C" int RASTI_CALL RastiLoadPolicy(const char* path, size_t* errorLine)
+{
+    if (errorLine) {
+        *errorLine = 0;
+    }
+    std::lock_guard<std::mutex> lock(gConfigMutex);
+    if (!path) {
+        SetPathPolicy(NULL);
+        return Succeed();
+    }
+
+    std::wstring widePath;
+    if (!DecodeArgument(path, widePath)) {
+        return Fail(RASTI_PHASE_ARGUMENT, OS_ERROR_INVALID_PARAMETER);
+    }
+
+    // SECURITY: Aktifkan walaupun gagal - policy gagal berisi "deny **"
+    bool loaded = gApiPolicy.LoadFromFile(widePath, errorLine);
+    SetPathPolicy(&gApiPolicy);
+    return loaded ? Succeed() : Fail(RASTI_PHASE_CONFIG, ConfigErrorCode(errorLine));
+}
+
+//==============================================================================
+// TOKEN
+//==============================================================================
+
+extern "C" int RASTI_CALL RastiAcquireToken(RastiToken* token)
+{
+    if (!token) {
+        return Fail(RASTI_PHASE_ARGUMENT, OS_ERROR_INVALID_PARAMETER);
+    }
+    *token = NULL;
+
+#ifdef _WIN32
+    static std::once_flag resolved;
+    std::call_once(resolved, ResolveDynamicFunctions);
+#endif
+
+    // SeImpersonatePrivilege diperlukan oleh CreateProcessWithTokenW di RastiLaunch
+    if (!EnableSupportedPrivilege(false, SeImpersonatePrivilege)) {
+        return FailWithBackendError(RASTI_PHASE_PRIVILEGE, OS_ERROR_PRIVILEGE_NOT_HELD);
+    }
+
+    IProcessBackend* ps = GetProcessBackend();
+    OsHandle handle = AcquireTrustedInstallerToken();
+    if (handle == OS_INVALID_HANDLE) {
+        return FailWithBackendError(RASTI_PHASE_ACQUIRE, OS_ERROR_PRIVILEGE_NOT_HELD);
+    }
+
+    *token = new (std::nothrow) RastiToken_(ps, handle);
+    if (!*token) {
+        ps->CloseObject(handle);
+        return Fail(RASTI_PHASE_ACQUIRE, OS_ERROR_NOT_ENOUGH_MEMORY);
+    }
+    return Succeed();
+}
+
+extern "C" void RASTI_CALL RastiReleaseToken(RastiToken token)
+{
+    if (token) {
+        token->backend->CloseObject(token->handle);
+        delete token;
+    }
+}
+
+//==============================================================================
+// VALIDATION AND LAUNCH
+//==============================================================================
+
+extern "C" int RASTI_CALL RastiValidate(const char* path, RastiValidationInfo* info)
+{
+    if (info && info->size < sizeof(RastiValidationInfo)) {
+        return Fail(RASTI_PHASE_ARGUMENT, OS_ERROR_INVALID_PARAMETER);
+    }
+
+    ValidatedExecutable validated;
+    if (!ValidateArgument(path, validated)) {
+        return 0;
+    }
+
+    if (info) {
+        info->kind = static_cast<uint32_t>(validated.kind);
+        info->machine = validated.image.machine;
+        info->subsystem = validated.image.subsystem;
+        info->is64Bit = validated.image.is64Bit ? 1 : 0;
+
+        // Potong di batas karakter UTF-8 agar output tetap valid
+        std::string utf8Path;
+        AppendUtf8(validated.path, utf8Path);
+        size_t length = std::min(utf8Path.size(), sizeof(info->path) - 1);
+        while (length > 0 && length < utf8Path.size() && (utf8Path[length] & 0xC0) == 0x80) {
+            length--;
+        }
+        memcpy(info->path, utf8Path.data(), length);
+        info->path[length] = '\0';
+    }
+    return Succeed();
+}
+
+extern "C" int RASTI_CALL RastiLaunch(RastiToken token, const RastiLaunchOptions* options,
+                                      RastiProcess* process, uint32_t* processId)
+{
+    if (process) {
+        *process = NULL;
+    }
+    if (!token || !options || options->size < sizeof(RastiLaunchOptions)) {
+        return Fail(RASTI_PHASE_ARGUMENT, OS_ERROR_INVALID_PARAMETER);
+    }
+
+    uint32_t priority = options->priority != 0 ? options->priority : 0x00000020; // NORMAL_PRIORITY_CLASS
+    std::wstring arguments;
+    if (!IsSupportedPriority(priority) || (options->arguments && !DecodeArgument(options->arguments, arguments))) {
+        return Fail(RASTI_PHASE_ARGUMENT, OS_ERROR_INVALID_PARAMETER);
+    }
+
+    // Handle validasi tetap terbuka sampai proses dibuat (anti TOCTOU)
+    ValidatedExecutable validated;
+    if (!ValidateArgument(options->path, validated)) {
+        return 0;
+    }
+
+    // Command line dan lpApplicationName sama dengan LaunchValidatedExecutable
+    std::wstring commandLine = L"\"" + validated.path + L"\"";
+    if (!arguments.empty()) {
+        commandLine += L" " + arguments;
+    }
+    std::wstring applicationName;
+    if (validated.kind == EXECUTABLE_KIND_PE_IMAGE) {
+        applicationName = ToExtendedLengthPath(validated.path);
+    }
+
+    OsHandle processHandle = OS_INVALID_HANDLE;
+    if (!LaunchWithToken(token->handle, applicationName, commandLine, priority, processId,
+                         process ? &processHandle : NULL, CONSOLE_MODE_NEW, &token->launcher)) {
+        return FailWithBackendError(RASTI_PHASE_LAUNCH, OS_ERROR_INVALID_HANDLE);
+    }
+
+    if (process) {
+        // Proses sudah berjalan; tanpa memori hanya handle yang dilepas
+        *process = new (std::nothrow) RastiProcess_{token->backend, processHandle};
+        if (!*process) {
+            token->backend->CloseObject(processHandle);
+            return Fail(RASTI_PHASE_LAUNCH, OS_ERROR_NOT_ENOUGH_MEMORY);
+        }
+    }
+    return Succeed();
+}
+
+extern "C" int RASTI_CALL RastiWait(RastiProcess process, uint32_t timeoutMs, uint32_t* exitCode)
+{
+    if (!process) {
+        return Fail(RASTI_PHASE_ARGUMENT, OS_ERROR_INVALID_PARAMETER);
+    }
+
+    uint32_t code = 0;
+    if (!process->backend->WaitForProcessExit(process->handle, timeoutMs, code)) {
+        uint32_t error = process->backend->GetLastErrorCode();
+        return Fail(RASTI_PHASE_WAIT, error != 0 ? error : OS_ERROR_INVALID_HANDLE);
+    }
+    if (exitCode) {
+        *exitCode = code;
+    }
+    return Succeed();
+}
+
+extern "C" void RASTI_CALL RastiCloseProcess(RastiProcess process)
+{
+    if (process) {
+        process->backend->CloseObject(process->handle);
+        delete process;
+    }
+}
+
+//==============================================================================
+// ERRORS
+//==============================================================================
+
+extern "C" void RASTI_CALL RastiGetLastError(RastiError* error)
+{
+    if (error) {
+        *error = gLastError;
+    }
+}
+
+extern "C" const char* RASTI_CALL RastiGetPhaseName(uint32_t phase)
+{
+    switch (phase) {
+    case RASTI_PHASE_NONE:      return "none";
+    case RASTI_PHASE_ARGUMENT:  return "argument";
+    case RASTI_PHASE_CONFIG:    return "config";
+    case RASTI_PHASE_VALIDATE:  return "validate";
+    case RASTI_PHASE_PRIVILEGE: return "privilege";
+    case RASTI_PHASE_ACQUIRE:   return "acquire";
+    case RASTI_PHASE_LAUNCH:    return "launch";
+    case RASTI_PHASE_WAIT:      return "wait";
+    default:                    return "unknown";
+    }
+}
+
+extern "C" const char* RASTI_CALL RastiGetValidationErrorName(uint32_t validation)
+{
+    return GetValidationErrorName(static_cast<ValidationError>(validation));
+}
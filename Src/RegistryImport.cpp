@@ -0,0 +1,1105 @@
+/**
+ * @file RegistryImport.cpp
+ * @brief Implementasi /regimport: parser .reg streaming, cache handle key, dan engine apply/dry run
+ *
+ * Parser memotong byte menjadi baris fisik sebelum decode (newline tidak
+ * pernah muncul di tengah sequence UTF-8 maupun code unit UTF-16LE), jadi
+ * batas chunk tidak pernah jatuh di tengah karakter. Engine berjalan di satu
+ * worker dari RunImpersonatedWorkers karena urutan baris .reg bermakna
+ * ([-KEY] lalu [KEY] berbeda dengan sebaliknya).
+ *
+ * @author RasTI Development Team
+ * @version 1.2.0.0
+ * @date 2025
+ */
+
+#include "RegistryImport.h"
+#include "FileOperations.h"
+#include "TextEncoding.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <list>
+#include <map>
+#include <set>
+#include <unordered_map>
+
+//==============================================================================
+// TEXT HELPERS
+//==============================================================================
+
+static bool IsBlank(wchar_t ch)
+{
+    return ch == L' ' || ch == L'\t';
+}
+
+static std::wstring_view Trim(std::wstring_view text)
+{
+    while (!text.empty() && IsBlank(text.front())) text.remove_prefix(1);
+    while (!text.empty() && IsBlank(text.back())) text.remove_suffix(1);
+    return text;
+}
+
+static wchar_t FoldCase(wchar_t ch)
+{
+    return (ch >= L'a' && ch <= L'z') ? static_cast<wchar_t>(ch - L'a' + L'A') : ch;
+}
+
+static bool EqualsNoCase(std::wstring_view a, std::wstring_view b)
+{
+    if (a.size() != b.size()) return false;
+    for (size_t i = 0; i < a.size(); i++) {
+        if (FoldCase(a[i]) != FoldCase(b[i])) return false;
+    }
+    return true;
+}
+
+static bool StartsWithNoCase(std::wstring_view text, std::wstring_view prefix)
+{
+    return text.size() >= prefix.size() && EqualsNoCase(text.substr(0, prefix.size()), prefix);
+}
+
+/** @brief Nilai digit hex, atau -1 */
+static int HexDigit(wchar_t ch)
+{
+    if (ch >= L'0' && ch <= L'9') return ch - L'0';
+    if (ch >= L'a' && ch <= L'f') return ch - L'a' + 10;
+    if (ch >= L'A' && ch <= L'F') return ch - L'A' + 10;
+    return -1;
+}
+
+/** @brief Parse 1..maxDigits digit hex (seluruh text) */
+static bool ParseHexNumber(std::wstring_view text, size_t maxDigits, uint32_t& value)
+{
+    if (text.empty() || text.size() > maxDigits) return false;
+    value = 0;
+    for (wchar_t ch : text) {
+        int digit = HexDigit(ch);
+        if (digit < 0) return false;
+        value = (value << 4) | static_cast<uint32_t>(digit);
+    }
+    return true;
+}
+
+/** @brief Menambahkan text sebagai UTF-16LE (code point > U+FFFF menjadi surrogate pair) */
+static void AppendUtf16Le(std::wstring_view text, std::vector<uint8_t>& data)
+{
+    auto unit = [&data](uint32_t value) {
+        data.push_back(static_cast<uint8_t>(value & 0xFF));
+        data.push_back(static_cast<uint8_t>((value >> 8) & 0xFF));
+    };
+    for (wchar_t ch : text) {
+        uint32_t codePoint = static_cast<uint32_t>(ch);
+        if (codePoint > 0xFFFF) {
+            codePoint -= 0x10000;
+            unit(0xD800 + (codePoint >> 10));
+            unit(0xDC00 + (codePoint & 0x3FF));
+        } else {
+            unit(codePoint);
+        }
+    }
+}
+
+/**
+ * @brief Parse string "..." mulai dari text[pos] (escape \\ dan \")
+ * @param pos Posisi kutip pembuka; output posisi setelah kutip penutup
+ */
+static bool ParseQuoted(std::wstring_view text, size_t& pos, std::wstring& value)
+{
+    value.clear();
+    if (pos >= text.size() || text[pos] != L'"') return false;
+    pos++;
+    while (pos < text.size()) {
+        wchar_t ch = text[pos];
+        if (ch == L'"') {
+            pos++;
+            return true;
+        }
+        if (ch == L'\\') {
+            if (pos + 1 >= text.size() || (text[pos + 1] != L'\\' && text[pos + 1] != L'"')) {
+                return false;
+            }
+            ch = text[pos + 1];
+            pos++;
+        }
+        value.push_back(ch);
+        pos++;
+    }
+    return false; // Kutip tidak ditutup
+}
+
+/** @brief Parse daftar byte hex "aa,bb,..." (kosong = data kosong) */
+static bool ParseHexList(std::wstring_view text, std::vector<uint8_t>& data)
+{
+    data.clear();
+    text = Trim(text);
+    if (text.empty()) return true;
+
+    while (true) {
+        size_t comma = text.find(L',');
+        uint32_t byte = 0;
+        if (!ParseHexNumber(Trim(text.substr(0, comma)), 2, byte)) {
+            return false; // Termasuk token kosong ("aa,,bb" atau koma di akhir)
+        }
+        data.push_back(static_cast<uint8_t>(byte));
+        if (comma == std::wstring_view::npos) return true;
+        text.remove_prefix(comma + 1);
+    }
+}
+
+//==============================================================================
+// ROOTS AND TYPES
+//==============================================================================
+
+/**
+ * @brief Nama root yang diterima di [KEY] (nama lengkap dan singkatan)
+ */
+struct RegistryRootName {
+    const wchar_t* name;
+    const wchar_t* shortName;
+    RegistryRoot root;
+};
+
+static const RegistryRootName kRegistryRoots[] = {
+    { L"HKEY_CLASSES_ROOT", L"HKCR", REGISTRY_ROOT_CLASSES_ROOT },
+    { L"HKEY_CURRENT_USER", L"HKCU", REGISTRY_ROOT_CURRENT_USER },
+    { L"HKEY_LOCAL_MACHINE", L"HKLM", REGISTRY_ROOT_LOCAL_MACHINE },
+    { L"HKEY_USERS", L"HKU", REGISTRY_ROOT_USERS },
+    { L"HKEY_CURRENT_CONFIG", L"HKCC", REGISTRY_ROOT_CURRENT_CONFIG },
+};
+
+static bool ParseRoot(std::wstring_view text, RegistryRoot& root)
+{
+    for (const RegistryRootName& entry : kRegistryRoots) {
+        if (EqualsNoCase(text, entry.name) || EqualsNoCase(text, entry.shortName)) {
+            root = entry.root;
+            return true;
+        }
+    }
+    return false;
+}
+
+const wchar_t* GetRegistryRootName(RegistryRoot root)
+{
+    for (const RegistryRootName& entry : kRegistryRoots) {
+        if (entry.root == root) return entry.name;
+    }
+    return L"?";
+}
+
+const char* GetRegistryTypeName(uint32_t type)
+{
+    switch (type) {
+    case REGISTRY_TYPE_NONE: return "REG_NONE";
+    case REGISTRY_TYPE_SZ: return "REG_SZ";
+    case REGISTRY_TYPE_EXPAND_SZ: return "REG_EXPAND_SZ";
+    case REGISTRY_TYPE_BINARY: return "REG_BINARY";
+    case REGISTRY_TYPE_DWORD: return "REG_DWORD";
+    case 5: return "REG_DWORD_BIG_ENDIAN";
+    case 6: return "REG_LINK";
+    case REGISTRY_TYPE_MULTI_SZ: return "REG_MULTI_SZ";
+    case 8: return "REG_RESOURCE_LIST";
+    case 9: return "REG_FULL_RESOURCE_DESCRIPTOR";
+    case 10: return "REG_RESOURCE_REQUIREMENTS_LIST";
+    case REGISTRY_TYPE_QWORD: return "REG_QWORD";
+    default: return nullptr;
+    }
+}
+
+//==============================================================================
+// STREAMING PARSER
+//==============================================================================
+
+bool RegistryFileParser::Fail(uint32_t line)
+{
+    errorLine_ = line != 0 ? line : 1;
+    return false;
+}
+
+void RegistryFileParser::FlushBlock()
+{
+    if (hasBlock_) {
+        blocks_.push_back(std::move(block_));
+        block_ = RegistryKeyBlock();
+        hasBlock_ = false;
+    }
+}
+
+void RegistryFileParser::TakeBlocks(std::vector<RegistryKeyBlock>& blocks)
+{
+    if (blocks.empty()) {
+        blocks.swap(blocks_);
+    } else {
+        std::move(blocks_.begin(), blocks_.end(), std::back_inserter(blocks));
+    }
+    blocks_.clear();
+}
+
+/**
+ * @brief Menentukan encoding dari BOM dan membuang BOM
+ * @param final true jika tidak ada byte lagi (file lebih pendek dari BOM)
+ * @return false jika byte yang ada masih bisa menjadi awal BOM
+ */
+bool RegistryFileParser::DetectEncoding(bool final)
+{
+    const unsigned char* bytes = reinterpret_cast<const unsigned char*>(pending_.data());
+    size_t size = pending_.size();
+
+    if (size >= 2 && bytes[0] == 0xFF && bytes[1] == 0xFE) {
+        encoding_ = ENCODING_UTF16LE;
+        pending_.erase(0, 2);
+        return true;
+    }
+    if (size >= 3 && bytes[0] == 0xEF && bytes[1] == 0xBB && bytes[2] == 0xBF) {
+        encoding_ = ENCODING_UTF8;
+        pending_.erase(0, 3);
+        return true;
+    }
+    if (!final) {
+        if (size == 0 || (size == 1 && (bytes[0] == 0xFF || bytes[0] == 0xEF)) ||
+            (size == 2 && bytes[0] == 0xEF && bytes[1] == 0xBB)) {
+            return false;
+        }
+    }
+    encoding_ = ENCODING_UTF8; // Tanpa BOM: REGEDIT4 ASCII/UTF-8
+    return true;
+}
+
+bool RegistryFileParser::Feed(const char* data, size_t size)
+{
+    if (errorLine_ != 0 || finished_) {
+        return false;
+    }
+
+    pending_.append(data, size);
+    if (encoding_ == ENCODING_UNKNOWN && !DetectEncoding(false)) {
+        return true;
+    }
+
+    size_t start = 0;
+    while (true) {
+        size_t end = std::string::npos;
+        if (encoding_ == ENCODING_UTF8) {
+            const void* found = memchr(pending_.data() + scanned_, '\n', pending_.size() - scanned_);
+            if (found) end = static_cast<size_t>(static_cast<const char*>(found) - pending_.data());
+        } else {
+            for (size_t i = scanned_; i + 1 < pending_.size(); i += 2) {
+                if (pending_[i] == '\n' && pending_[i + 1] == '\0') {
+                    end = i;
+                    break;
+                }
+            }
+        }
+
+        if (end == std::string::npos) {
+            // UTF-16LE: lanjutkan pencarian di batas code unit berikutnya
+            scanned_ = (encoding_ == ENCODING_UTF8) ? pending_.size() :
+                       start + ((pending_.size() - start) & ~static_cast<size_t>(1));
+            break;
+        }
+        if (!ProcessPhysicalLine(pending_.data() + start, end - start)) {
+            return false;
+        }
+        start = end + (encoding_ == ENCODING_UTF8 ? 1 : 2);
+        scanned_ = start;
+    }
+
+    pending_.erase(0, start);
+    scanned_ -= start;
+    return true;
+}
+
+bool RegistryFileParser::Finish()
+{
+    if (errorLine_ != 0 || finished_) {
+        return false;
+    }
+    finished_ = true;
+
+    if (encoding_ == ENCODING_UNKNOWN) {
+        DetectEncoding(true);
+    }
+    if (!pending_.empty()) {
+        if (!ProcessPhysicalLine(pending_.data(), pending_.size())) {
+            return false;
+        }
+        pending_.clear();
+    }
+    if (continuing_) {
+        continuing_ = false; // '\' di baris terakhir file
+        if (!ProcessLogicalLine()) {
+            return false;
+        }
+    }
+    if (!headerSeen_) {
+        return Fail(1); // File kosong atau bukan file .reg
+    }
+    FlushBlock();
+    return true;
+}
+
+/**
+ * @brief Decode satu baris fisik (tanpa '\n') lalu gabungkan ke baris logis
+ */
+bool RegistryFileParser::ProcessPhysicalLine(const char* data, size_t size)
+{
+    lineNumber_++;
+    if (encoding_ == ENCODING_UTF8) {
+        if (!DecodeUtf8(std::string_view(data, size), decoded_)) {
+            return Fail(lineNumber_);
+        }
+    } else {
+        if (size % 2 != 0) {
+            return Fail(lineNumber_); // Byte sisa di akhir file UTF-16LE
+        }
+        const unsigned char* bytes = reinterpret_cast<const unsigned char*>(data);
+        decoded_.clear();
+        decoded_.reserve(size / 2);
+        for (size_t i = 0; i < size; i += 2) {
+            decoded_.push_back(static_cast<wchar_t>(bytes[i] | (bytes[i + 1] << 8)));
+        }
+    }
+
+    std::wstring_view line(decoded_);
+    if (!line.empty() && line.back() == L'\r') line.remove_suffix(1);
+
+    if (continuing_) {
+        while (!line.empty() && IsBlank(line.front())) line.remove_prefix(1);
+        logical_.append(line);
+    } else {
+        logical_.assign(line);
+        logicalLine_ = lineNumber_;
+    }
+
+    // '\' di akhir baris value: data hex berlanjut ke baris berikutnya
+    size_t first = logical_.find_first_not_of(L" \t");
+    size_t last = logical_.find_last_not_of(L" \t");
+    if (last != std::wstring::npos && logical_[last] == L'\\' &&
+        logical_[first] != L';' && logical_[first] != L'[') {
+        logical_.resize(last);
+        continuing_ = true;
+        return true;
+    }
+    continuing_ = false;
+    return ProcessLogicalLine();
+}
+
+bool RegistryFileParser::ProcessLogicalLine()
+{
+    std::wstring_view text = Trim(logical_);
+    if (text.empty()) {
+        return true;
+    }
+
+    if (!headerSeen_) {
+        if (text == L"REGEDIT4") {
+            regedit4_ = true;
+        } else if (text != L"Windows Registry Editor Version 5.00") {
+            return Fail(logicalLine_);
+        }
+        headerSeen_ = true;
+        return true;
+    }
+
+    if (text.front() == L';') {
+        return true;
+    }
+    if (text.front() == L'[') {
+        return ParseKeyLine(text);
+    }
+    return ParseValueLine(text);
+}
+
+bool RegistryFileParser::ParseKeyLine(std::wstring_view text)
+{
+    if (text.size() < 2 || text.back() != L']') {
+        return Fail(logicalLine_);
+    }
+    std::wstring_view inner = text.substr(1, text.size() - 2);
+    bool remove = !inner.empty() && inner.front() == L'-';
+    if (remove) inner.remove_prefix(1);
+
+    size_t separator = inner.find(L'\\');
+    RegistryRoot root = REGISTRY_ROOT_LOCAL_MACHINE;
+    if (!ParseRoot(inner.substr(0, separator), root)) {
+        return Fail(logicalLine_);
+    }
+
+    std::wstring_view path;
+    if (separator != std::wstring_view::npos) {
+        path = inner.substr(separator + 1);
+        if (!path.empty() && path.back() == L'\\') path.remove_suffix(1);
+    }
+
+    size_t depth = 0;
+    for (size_t begin = 0; !path.empty();) {
+        size_t end = path.find(L'\\', begin);
+        size_t length = (end == std::wstring_view::npos ? path.size() : end) - begin;
+        if (length == 0 || length > REGIMPORT_MAX_KEY_NAME || ++depth > REGIMPORT_MAX_KEY_DEPTH) {
+            return Fail(logicalLine_);
+        }
+        if (end == std::wstring_view::npos) break;
+        begin = end + 1;
+    }
+
+    // Root dan hive yang di-mount sistem (HKLM\SYSTEM, HKU\S-1-5-18, ...) tidak pernah dihapus
+    if (remove && (depth == 0 ||
+        (depth == 1 && (root == REGISTRY_ROOT_LOCAL_MACHINE || root == REGISTRY_ROOT_USERS)))) {
+        return Fail(logicalLine_);
+    }
+
+    FlushBlock();
+    block_.root = root;
+    block_.path.assign(path);
+    block_.remove = remove;
+    block_.line = logicalLine_;
+    hasBlock_ = true;
+    return true;
+}
+
+bool RegistryFileParser::ParseValueLine(std::wstring_view text)
+{
+    if (!hasBlock_ || block_.remove) {
+        return Fail(logicalLine_); // Value tanpa key, atau di bawah [-KEY]
+    }
+
+    RegistryValue value;
+    value.line = logicalLine_;
+
+    size_t pos = 0;
+    if (text.front() == L'@') {
+        pos = 1;
+    } else if (!ParseQuoted(text, pos, value.name) || value.name.size() > REGIMPORT_MAX_VALUE_NAME) {
+        return Fail(logicalLine_);
+    }
+
+    while (pos < text.size() && IsBlank(text[pos])) pos++;
+    if (pos >= text.size() || text[pos] != L'=') {
+        return Fail(logicalLine_);
+    }
+    std::wstring_view data = Trim(text.substr(pos + 1));
+
+    if (data == L"-") {
+        value.remove = true;
+    } else if (!data.empty() && data.front() == L'"') {
+        std::wstring string;
+        size_t end = 0;
+        if (!ParseQuoted(data, end, string) || end != data.size()) {
+            return Fail(logicalLine_);
+        }
+        value.type = REGISTRY_TYPE_SZ;
+        AppendUtf16Le(string, value.data);
+        value.data.push_back(0);
+        value.data.push_back(0);
+    } else if (StartsWithNoCase(data, L"dword:")) {
+        uint32_t number = 0;
+        if (!ParseHexNumber(data.substr(6), 8, number)) {
+            return Fail(logicalLine_);
+        }
+        value.type = REGISTRY_TYPE_DWORD;
+        for (int i = 0; i < 4; i++) {
+            value.data.push_back(static_cast<uint8_t>((number >> (8 * i)) & 0xFF));
+        }
+    } else if (StartsWithNoCase(data, L"hex")) {
+        data.remove_prefix(3);
+        value.type = REGISTRY_TYPE_BINARY;
+        if (!data.empty() && data.front() == L'(') {
+            size_t close = data.find(L')');
+            if (close == std::wstring_view::npos || !ParseHexNumber(data.substr(1, close - 1), 8, value.type)) {
+                return Fail(logicalLine_);
+            }
+            data.remove_prefix(close + 1);
+        }
+        if (data.empty() || data.front() != L':' || !ParseHexList(data.substr(1), value.data)) {
+            return Fail(logicalLine_);
+        }
+
+        // REGEDIT4: string hex berupa byte ANSI, ditulis sebagai UTF-16LE
+        if (regedit4_ && (value.type == REGISTRY_TYPE_SZ || value.type == REGISTRY_TYPE_EXPAND_SZ ||
+                          value.type == REGISTRY_TYPE_MULTI_SZ)) {
+            std::vector<uint8_t> wide;
+            wide.reserve(value.data.size() * 2);
+            for (uint8_t byte : value.data) {
+                wide.push_back(byte);
+                wide.push_back(0);
+            }
+            value.data.swap(wide);
+        }
+    } else {
+        return Fail(logicalLine_);
+    }
+
+    block_.values.push_back(std::move(value));
+    return true;
+}
+
+bool ParseRegistryFile(std::string_view bytes, std::vector<RegistryKeyBlock>& blocks, size_t* errorLine)
+{
+    blocks.clear();
+    if (errorLine) *errorLine = 0;
+
+    RegistryFileParser parser;
+    if (!parser.Feed(bytes.data(), bytes.size()) || !parser.Finish()) {
+        if (errorLine) *errorLine = parser.GetErrorLine();
+        return false;
+    }
+    parser.TakeBlocks(blocks);
+    return true;
+}
+
+bool LoadRegistryFile(std::wstring_view path, std::vector<RegistryKeyBlock>& blocks, size_t* errorLine)
+{
+    blocks.clear();
+    if (errorLine) *errorLine = 0;
+
+    IFileSystemBackend* fs = GetFileSystemBackend();
+    ScopedBackendFile file(fs, fs->OpenFileForValidation(std::wstring(path)));
+    FileIdentity identity;
+    if (!file.IsValid() || !fs->QueryFileIdentity(file.Get(), identity) || identity.isDirectory ||
+        identity.fileSize > REGIMPORT_MAX_FILE_SIZE) {
+        return false;
+    }
+
+    RegistryFileParser parser;
+    std::vector<char> buffer(static_cast<size_t>(std::min<uint64_t>(identity.fileSize, REGIMPORT_READ_CHUNK)));
+    uint64_t offset = 0;
+    while (offset < identity.fileSize) {
+        uint32_t size = static_cast<uint32_t>(std::min<uint64_t>(identity.fileSize - offset, REGIMPORT_READ_CHUNK));
+        uint32_t bytesRead = 0;
+        if (!fs->ReadFileAt(file.Get(), offset, buffer.data(), size, bytesRead) || bytesRead == 0) {
+            blocks.clear();
+            return false;
+        }
+        if (!parser.Feed(buffer.data(), bytesRead)) {
+            break;
+        }
+        parser.TakeBlocks(blocks);
+        offset += bytesRead;
+    }
+
+    if (offset < identity.fileSize || !parser.Finish()) {
+        if (errorLine) *errorLine = parser.GetErrorLine();
+        blocks.clear();
+        return false;
+    }
+    parser.TakeBlocks(blocks);
+    return true;
+}
+
+//==============================================================================
+// KEY HANDLE CACHE
+//==============================================================================
+
+/** @brief true jika key adalah base atau berada di bawah base (nama sudah di-fold) */
+static bool IsSameOrUnder(const std::wstring& key, const std::wstring& base)
+{
+    return key.compare(0, base.size(), base) == 0 &&
+           (key.size() == base.size() || key[base.size()] == L'\\');
+}
+
+/**
+ * @brief Cache LRU handle key terbuka, dikunci dengan nama lengkap key (case-folded)
+ *
+ * Handle ditutup saat dikeluarkan dari cache, saat key (atau parent-nya)
+ * dihapus, dan saat cache dihancurkan.
+ */
+class RegistryKeyCache {
+public:
+    RegistryKeyCache(IRegistryBackend* backend, size_t capacity)
+        : backend_(backend), capacity_(std::max<size_t>(capacity, 1)) {}
+
+    ~RegistryKeyCache() {
+        for (const Entry& entry : entries_) backend_->CloseKey(entry.second);
+    }
+
+    /** @brief Handle dari cache (menjadi yang terbaru dipakai), atau OS_INVALID_HANDLE */
+    OsHandle Find(const std::wstring& key) {
+        auto it = index_.find(key);
+        if (it == index_.end()) return OS_INVALID_HANDLE;
+        entries_.splice(entries_.begin(), entries_, it->second);
+        return it->second->second;
+    }
+
+    /** @brief Menyimpan handle baru; handle yang paling lama tidak dipakai ditutup */
+    void Insert(const std::wstring& key, OsHandle handle) {
+        entries_.emplace_front(key, handle);
+        index_[key] = entries_.begin();
+        while (entries_.size() > capacity_) {
+            backend_->CloseKey(entries_.back().second);
+            index_.erase(entries_.back().first);
+            entries_.pop_back();
+        }
+    }
+
+    /** @brief Menutup handle key dan semua subkey-nya (sebelum/sesudah key dihapus) */
+    void EvictTree(const std::wstring& key) {
+        for (auto it = entries_.begin(); it != entries_.end();) {
+            if (IsSameOrUnder(it->first, key)) {
+                backend_->CloseKey(it->second);
+                index_.erase(it->first);
+                it = entries_.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+
+    RegistryKeyCache(const RegistryKeyCache&) = delete;
+    RegistryKeyCache& operator=(const RegistryKeyCache&) = delete;
+
+private:
+    typedef std::pair<std::wstring, OsHandle> Entry;
+
+    IRegistryBackend* backend_;
+    size_t capacity_;
+    std::list<Entry> entries_;
+    std::unordered_map<std::wstring, std::list<Entry>::iterator> index_;
+};
+
+//==============================================================================
+// ENGINE
+//==============================================================================
+
+/**
+ * @brief State satu import: backend, cache, dan model registry virtual untuk dry run
+ *
+ * Dry run tidak menulis, sehingga efek baris sebelumnya dicatat di sini:
+ * key yang dihapus (deleted_) dan dibuat (created_) secara virtual, serta
+ * value yang sudah "ditulis" per key (overlay_). Key di created_ tidak
+ * punya value di backend.
+ */
+class RegistryImportRun {
+public:
+    RegistryImportRun(const RegistryImportOptions& options, RegistryImportReport& report)
+        : backend_(GetRegistryBackend()), report_(report), cache_(backend_, options.keyCacheSize) {}
+
+    void Apply(const RegistryKeyBlock& block);
+    void Simulate(const RegistryKeyBlock& block);
+
+private:
+    enum KeyState { KEY_MISSING, KEY_PRESENT, KEY_FAILED };
+
+    /** @brief Value dry run: present = false untuk value yang sudah dihapus */
+    struct VirtualValue {
+        bool present = false;
+        uint32_t type = REGISTRY_TYPE_NONE;
+        std::vector<uint8_t> data;
+    };
+
+    KeyState Lookup(RegistryRoot root, const std::wstring& path, const std::wstring& key, OsHandle& handle,
+                    uint32_t& code);
+    bool IsDeleted(const std::wstring& key) const;
+    void AddError(uint32_t line, RegistryImportStep step, const std::wstring& key, const std::wstring& name,
+                  uint32_t code);
+    void AddChange(RegistryChangeKind kind, uint32_t line, const std::wstring& key, const std::wstring& name,
+                   uint32_t type);
+
+    static const std::wstring& KeyOf(const std::wstring& key) { return key; }
+    template <typename Value>
+    static const std::wstring& KeyOf(const std::pair<const std::wstring, Value>& entry) { return entry.first; }
+
+    /** @brief Menghapus key dan semua subkey-nya dari set/map terurut */
+    template <typename Container>
+    static void EraseTree(Container& container, const std::wstring& key) {
+        for (auto it = container.lower_bound(key);
+             it != container.end() && KeyOf(*it).compare(0, key.size(), key) == 0;) {
+            it = IsSameOrUnder(KeyOf(*it), key) ? container.erase(it) : std::next(it);
+        }
+    }
+
+    IRegistryBackend* backend_;
+    RegistryImportReport& report_;
+    RegistryKeyCache cache_;
+    std::set<std::wstring> deleted_;
+    std::set<std::wstring> created_;
+    std::map<std::wstring, std::map<std::wstring, VirtualValue>> overlay_;
+    uint32_t type_ = 0;                  /**< Buffer QueryValue dipakai ulang */
+    std::vector<uint8_t> data_;
+};
+
+/** @brief Nama lengkap key untuk report ("HKEY_LOCAL_MACHINE\...") */
+static std::wstring FullKeyName(const RegistryKeyBlock& block)
+{
+    std::wstring name = GetRegistryRootName(block.root);
+    if (!block.path.empty()) {
+        name += L'\\';
+        name += block.path;
+    }
+    return name;
+}
+
+/** @brief Kunci cache/model: nama lengkap dengan huruf ASCII di-fold */
+static std::wstring FoldKey(const std::wstring& name)
+{
+    std::wstring key = name;
+    for (wchar_t& ch : key) ch = FoldCase(ch);
+    return key;
+}
+
+void RegistryImportRun::AddError(uint32_t line, RegistryImportStep step, const std::wstring& key,
+                                 const std::wstring& name, uint32_t code)
+{
+    report_.errorCount++;
+    if (report_.errors.size() < REGIMPORT_MAX_REPORTED_ERRORS) {
+        RegistryImportError error;
+        error.line = line;
+        error.step = step;
+        error.key = key;
+        error.name = name;
+        error.code = code;
+        report_.errors.push_back(std::move(error));
+    }
+}
+
+void RegistryImportRun::AddChange(RegistryChangeKind kind, uint32_t line, const std::wstring& key,
+                                  const std::wstring& name, uint32_t type)
+{
+    report_.changeCount++;
+    if (report_.changes.size() < REGIMPORT_MAX_REPORTED_CHANGES) {
+        RegistryImportChange change;
+        change.kind = kind;
+        change.line = line;
+        change.key = key;
+        change.name = name;
+        change.type = type;
+        report_.changes.push_back(std::move(change));
+    }
+}
+
+/**
+ * @brief Menerapkan satu blok: satu handle (dari cache atau CreateKey) untuk semua value
+ */
+void RegistryImportRun::Apply(const RegistryKeyBlock& block)
+{
+    report_.keyBlocks++;
+    std::wstring name = FullKeyName(block);
+    std::wstring key = FoldKey(name);
+
+    if (block.remove) {
+        cache_.EvictTree(key);
+        if (backend_->DeleteKeyTree(block.root, block.path)) {
+            report_.keysDeleted++;
+            return;
+        }
+        uint32_t code = backend_->GetLastErrorCode();
+        if (code != OS_ERROR_FILE_NOT_FOUND) {
+            AddError(block.line, REGIMPORT_STEP_DELETE_KEY, name, std::wstring(), code);
+            report_.keysFailed++;
+        }
+        return;
+    }
+
+    bool created = false;
+    OsHandle handle = cache_.Find(key);
+    if (handle != OS_INVALID_HANDLE) {
+        report_.keyCacheHits++;
+    } else {
+        report_.keyOpens++;
+        handle = backend_->CreateKey(block.root, block.path, created);
+        if (handle == OS_INVALID_HANDLE) {
+            AddError(block.line, REGIMPORT_STEP_OPEN_KEY, name, std::wstring(), backend_->GetLastErrorCode());
+            report_.keysFailed++;
+            report_.valuesFailed += block.values.size();
+            return;
+        }
+        cache_.Insert(key, handle);
+        if (created) report_.keysCreated++;
+    }
+
+    std::set<std::wstring> written; // Key baru: value yang sudah ditulis di blok ini
+    for (const RegistryValue& value : block.values) {
+        if (value.remove) {
+            if (created) written.insert(FoldKey(value.name));
+            if (backend_->DeleteValue(handle, value.name)) {
+                report_.valuesDeleted++;
+                continue;
+            }
+            uint32_t code = backend_->GetLastErrorCode();
+            if (code == OS_ERROR_FILE_NOT_FOUND) {
+                report_.valuesUnchanged++;
+            } else {
+                AddError(value.line, REGIMPORT_STEP_DELETE_VALUE, name, value.name, code);
+                report_.valuesFailed++;
+            }
+            continue;
+        }
+
+        // Key baru belum punya value: tulis tanpa query kecuali nama yang sama muncul lagi
+        bool fresh = created && written.insert(FoldKey(value.name)).second;
+        if (!fresh && backend_->QueryValue(handle, value.name, type_, data_) &&
+            type_ == value.type && data_ == value.data) {
+            report_.valuesUnchanged++;
+            continue;
+        }
+        if (backend_->SetValue(handle, value.name, value.type, value.data)) {
+            report_.valuesSet++;
+        } else {
+            AddError(value.line, REGIMPORT_STEP_SET_VALUE, name, value.name, backend_->GetLastErrorCode());
+            report_.valuesFailed++;
+        }
+    }
+}
+
+/** @brief true jika key atau salah satu parent-nya sudah dihapus secara virtual */
+bool RegistryImportRun::IsDeleted(const std::wstring& key) const
+{
+    if (deleted_.empty()) return false;
+    for (size_t pos = key.find(L'\\'); pos != std::wstring::npos; pos = key.find(L'\\', pos + 1)) {
+        if (deleted_.count(key.substr(0, pos))) return true;
+    }
+    return deleted_.count(key) != 0;
+}
+
+/**
+ * @brief Status key di model dry run; handle read-only diisi jika key ada di backend
+ */
+RegistryImportRun::KeyState RegistryImportRun::Lookup(RegistryRoot root, const std::wstring& path,
+                                                      const std::wstring& key, OsHandle& handle, uint32_t& code)
+{
+    handle = OS_INVALID_HANDLE;
+    code = 0;
+    if (created_.count(key)) return KEY_PRESENT;
+    if (IsDeleted(key)) return KEY_MISSING;
+
+    handle = cache_.Find(key);
+    if (handle != OS_INVALID_HANDLE) {
+        report_.keyCacheHits++;
+        return KEY_PRESENT;
+    }
+    report_.keyOpens++;
+    handle = backend_->OpenKey(root, path, false);
+    if (handle != OS_INVALID_HANDLE) {
+        cache_.Insert(key, handle);
+        return KEY_PRESENT;
+    }
+    code = backend_->GetLastErrorCode();
+    return code == OS_ERROR_FILE_NOT_FOUND ? KEY_MISSING : KEY_FAILED;
+}
+
+/**
+ * @brief Dry run satu blok: bandingkan dengan registry + model virtual, catat perubahan
+ */
+void RegistryImportRun::Simulate(const RegistryKeyBlock& block)
+{
+    report_.keyBlocks++;
+    std::wstring name = FullKeyName(block);
+    std::wstring key = FoldKey(name);
+
+    OsHandle handle = OS_INVALID_HANDLE;
+    uint32_t code = 0;
+    KeyState state = Lookup(block.root, block.path, key, handle, code);
+    if (state == KEY_FAILED) {
+        AddError(block.line, REGIMPORT_STEP_OPEN_KEY, name, std::wstring(), code);
+        report_.keysFailed++;
+        report_.valuesFailed += block.values.size();
+        return;
+    }
+
+    if (block.remove) {
+        if (state == KEY_PRESENT) {
+            report_.keysDeleted++;
+            AddChange(REGIMPORT_CHANGE_DELETE_KEY, block.line, name, std::wstring(), REGISTRY_TYPE_NONE);
+        }
+        cache_.EvictTree(key);
+        EraseTree(created_, key);
+        EraseTree(overlay_, key);
+        deleted_.insert(key);
+        return;
+    }
+
+    if (state == KEY_MISSING) {
+        report_.keysCreated++;
+        AddChange(REGIMPORT_CHANGE_CREATE_KEY, block.line, name, std::wstring(), REGISTRY_TYPE_NONE);
+        created_.insert(key);
+
+        // CreateKey juga membuat parent yang belum ada
+        size_t rootLength = key.size() - block.path.size() - (block.path.empty() ? 0 : 1);
+        for (size_t pos = key.rfind(L'\\'); pos != std::wstring::npos && pos > rootLength; pos = key.rfind(L'\\', pos - 1)) {
+            std::wstring parent = key.substr(0, pos);
+            OsHandle parentHandle = OS_INVALID_HANDLE;
+            uint32_t parentCode = 0;
+            if (Lookup(block.root, block.path.substr(0, pos - rootLength - 1), parent, parentHandle, parentCode) !=
+                KEY_MISSING) {
+                break;
+            }
+            created_.insert(parent);
+        }
+    }
+
+    std::map<std::wstring, VirtualValue>& values = overlay_[key];
+    for (const RegistryValue& value : block.values) {
+        std::wstring valueKey = FoldKey(value.name);
+        bool present = false;
+        uint32_t type = REGISTRY_TYPE_NONE;
+        const std::vector<uint8_t>* data = &data_;
+
+        auto it = values.find(valueKey);
+        if (it != values.end()) {
+            present = it->second.present;
+            type = it->second.type;
+            data = &it->second.data;
+        } else if (handle != OS_INVALID_HANDLE) {
+            if (backend_->QueryValue(handle, value.name, type_, data_)) {
+                present = true;
+                type = type_;
+            } else if ((code = backend_->GetLastErrorCode()) != OS_ERROR_FILE_NOT_FOUND) {
+                AddError(value.line, REGIMPORT_STEP_QUERY_VALUE, name, value.name, code);
+                report_.valuesFailed++;
+                continue;
+            }
+        }
+
+        if (value.remove) {
+            if (present) {
+                report_.valuesDeleted++;
+                AddChange(REGIMPORT_CHANGE_DELETE_VALUE, value.line, name, value.name, REGISTRY_TYPE_NONE);
+            } else {
+                report_.valuesUnchanged++;
+            }
+            VirtualValue& next = values[valueKey];
+            next.present = false;
+            next.type = REGISTRY_TYPE_NONE;
+            next.data.clear();
+            continue;
+        }
+
+        if (present && type == value.type && *data == value.data) {
+            report_.valuesUnchanged++;
+        } else {
+            report_.valuesSet++;
+            AddChange(present ? REGIMPORT_CHANGE_MODIFY_VALUE : REGIMPORT_CHANGE_ADD_VALUE, value.line, name,
+                      value.name, value.type);
+        }
+        VirtualValue& next = values[valueKey];
+        next.present = true;
+        next.type = value.type;
+        next.data = value.data;
+    }
+}
+
+//==============================================================================
+// RUN AND REPORT
+//==============================================================================
+
+bool RunRegistryImport(const std::vector<RegistryKeyBlock>& blocks, const RegistryImportOptions& options,
+                       RegistryImportReport& report)
+{
+    auto start = std::chrono::steady_clock::now();
+    report = RegistryImportReport();
+    report.dryRun = options.dryRun;
+
+    RunImpersonatedWorkers(1, options.token, [&](unsigned, uint32_t impersonationError) {
+        RegistryImportRun run(options, report);
+        if (impersonationError != 0) {
+            // Tanpa impersonation tidak ada yang ditulis dengan security context proses
+            report.errorCount++;
+            RegistryImportError error;
+            error.step = REGIMPORT_STEP_OPEN_KEY;
+            error.code = impersonationError;
+            report.errors.push_back(std::move(error));
+            report.keysFailed = blocks.size();
+            return;
+        }
+        for (const RegistryKeyBlock& block : blocks) {
+            if (options.dryRun) {
+                run.Simulate(block);
+            } else {
+                run.Apply(block);
+            }
+        }
+    });
+
+    report.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return report.errorCount == 0;
+}
+
+const char* GetRegistryImportStepName(RegistryImportStep step)
+{
+    switch (step) {
+    case REGIMPORT_STEP_OPEN_KEY: return "open key";
+    case REGIMPORT_STEP_DELETE_KEY: return "delete key";
+    case REGIMPORT_STEP_QUERY_VALUE: return "query value";
+    case REGIMPORT_STEP_SET_VALUE: return "set value";
+    case REGIMPORT_STEP_DELETE_VALUE: return "delete value";
+    default: return "unknown";
+    }
+}
+
+/** @brief Menambahkan KEY atau KEY "name" / KEY @ ke report */
+static void AppendKeyAndValue(const std::wstring& key, const std::wstring* name, std::string& text)
+{
+    AppendUtf8(key, text);
+    if (!name) return;
+    if (name->empty()) {
+        text += " @";
+        return;
+    }
+    text += " \"";
+    AppendUtf8(*name, text);
+    text += '"';
+}
+
+std::string FormatRegistryImportReport(const RegistryImportReport& report)
+{
+    std::string text;
+    char line[256];
+
+    snprintf(line, sizeof(line), "%s: %llu key blocks, %llu keys %screated, %llu %sdeleted, %llu failed\n",
+             report.dryRun ? "dry run" : "import", static_cast<unsigned long long>(report.keyBlocks),
+             static_cast<unsigned long long>(report.keysCreated), report.dryRun ? "to be " : "",
+             static_cast<unsigned long long>(report.keysDeleted), report.dryRun ? "to be " : "",
+             static_cast<unsigned long long>(report.keysFailed));
+    text += line;
+    snprintf(line, sizeof(line), "%llu values %sset, %llu unchanged, %llu %sdeleted, %llu failed\n",
+             static_cast<unsigned long long>(report.valuesSet), report.dryRun ? "to be " : "",
+             static_cast<unsigned long long>(report.valuesUnchanged),
+             static_cast<unsigned long long>(report.valuesDeleted), report.dryRun ? "to be " : "",
+             static_cast<unsigned long long>(report.valuesFailed));
+    text += line;
+    snprintf(line, sizeof(line), "%llu key opens, %llu cache hits, %.0f values/s, %.3f s\n",
+             static_cast<unsigned long long>(report.keyOpens), static_cast<unsigned long long>(report.keyCacheHits),
+             report.ValuesPerSecond(), report.seconds);
+    text += line;
+
+    static const char* const kChangeNames[] = {
+        "create key", "delete key", "add value", "modify value", "delete value"
+    };
+    for (const RegistryImportChange& change : report.changes) {
+        snprintf(line, sizeof(line), "line %u: would %s ", static_cast<unsigned>(change.line),
+                 kChangeNames[change.kind]);
+        text += line;
+        bool isValue = change.kind >= REGIMPORT_CHANGE_ADD_VALUE;
+        AppendKeyAndValue(change.key, isValue ? &change.name : nullptr, text);
+        if (change.kind == REGIMPORT_CHANGE_ADD_VALUE || change.kind == REGIMPORT_CHANGE_MODIFY_VALUE) {
+            const char* typeName = GetRegistryTypeName(change.type);
+            if (typeName) {
+                snprintf(line, sizeof(line), " (%s)", typeName);
+            } else {
+                snprintf(line, sizeof(line), " (hex(%x))", static_cast<unsigned>(change.type));
+            }
+            text += line;
+        }
+        text += '\n';
+    }
+    if (report.changeCount > report.changes.size()) {
+        snprintf(line, sizeof(line), "... %llu more changes\n",
+                 static_cast<unsigned long long>(report.changeCount - report.changes.size()));
+        text += line;
+    }
+
+    for (const RegistryImportError& error : report.errors) {
+        snprintf(line, sizeof(line), "line %u: %s failed (error %u): ", static_cast<unsigned>(error.line),
+                 GetRegistryImportStepName(error.step), static_cast<unsigned>(error.code));
+        text += line;
+        bool isValue = error.step >= REGIMPORT_STEP_QUERY_VALUE;
+        AppendKeyAndValue(error.key, isValue ? &error.name : nullptr, text);
+        text += '\n';
+    }
+    if (report.errorCount > report.errors.size()) {
+        snprintf(line, sizeof(line), "... %llu more errors\n",
+                 static_cast<unsigned long long>(report.errorCount - report.errors.size()));
+        text += line;
+    }
+    return text;
+}
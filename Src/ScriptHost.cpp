@@ -0,0 +1,606 @@
+/**
+ * @file ScriptHost.cpp
+ * @brief Implementasi /scripthost: parser daftar job, protokol marker, dan recycle host
+ *
+ * Setiap job ditulis ke stdin host sebagai beberapa baris command yang
+ * diakhiri pencetakan marker "__RASTI_<nonce>_<urutan>__ <exit code>".
+ * Engine membaca output host sampai marker job tersebut muncul; marker
+ * boleh berada di tengah baris (output script tanpa newline terakhir).
+ * Nonce acak per host mencegah output script memalsukan marker.
+ *
+ * @author RasTI Development Team
+ * @version 1.2.0.0
+ * @date 2025
+ */
+
+#include "ScriptHost.h"
+#include "TextEncoding.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+
+//==============================================================================
+// JOB LIST PARSER
+//==============================================================================
+
+static bool IsBlank(wchar_t ch)
+{
+    return ch == L' ' || ch == L'\t' || ch == L'\r';
+}
+
+/** @brief Mengambil satu token (diapit kutip atau dipisah blank) dari awal line */
+static bool NextToken(std::wstring_view& line, std::wstring& token)
+{
+    while (!line.empty() && IsBlank(line.front())) line.remove_prefix(1);
+    if (line.empty()) {
+        return false;
+    }
+
+    size_t end = 0;
+    if (line.front() == L'"') {
+        end = line.find(L'"', 1);
+        if (end == std::wstring_view::npos) {
+            return false; // Kutip tidak ditutup
+        }
+        token.assign(line.substr(1, end - 1));
+        line.remove_prefix(end + 1);
+        return line.empty() || IsBlank(line.front());
+    }
+
+    while (end < line.size() && !IsBlank(line[end])) end++;
+    token.assign(line.substr(0, end));
+    line.remove_prefix(end);
+    return token.find(L'"') == std::wstring::npos;
+}
+
+/** @brief Karakter kontrol tidak dapat dikirim dengan aman melalui satu baris command */
+static bool HasControlCharacter(std::wstring_view text)
+{
+    for (wchar_t ch : text) {
+        if (ch < 0x20 || ch == 0x7F) return true;
+    }
+    return false;
+}
+
+/**
+ * @brief Teks yang dapat diletakkan di baris command cmd.exe tanpa diekspansi
+ *
+ * % diekspansi bahkan di dalam kutip, dan CALL menggandakan ^ di dalam kutip.
+ * Delayed expansion (!) dimatikan dengan /V:OFF.
+ */
+static bool IsCmdSafe(std::wstring_view text)
+{
+    return text.find_first_of(L"%^\"") == std::wstring_view::npos && !HasControlCharacter(text);
+}
+
+bool ParseScriptJobList(std::string_view text, std::vector<ScriptJob>& jobs, size_t* errorLine)
+{
+    jobs.clear();
+    size_t lineNumber = 0;
+    size_t start = 0;
+    bool valid = true;
+    std::wstring decoded;
+
+    // UTF-8 BOM dari editor Windows
+    if (text.substr(0, 3) == "\xEF\xBB\xBF") {
+        start = 3;
+    }
+
+    while (valid && start < text.size()) {
+        size_t end = text.find('\n', start);
+        if (end == std::string_view::npos) end = text.size();
+        std::string_view rawLine = text.substr(start, end - start);
+        start = end + 1;
+        lineNumber++;
+
+        if (!DecodeUtf8(rawLine, decoded)) {
+            valid = false;
+            break;
+        }
+
+        std::wstring_view line(decoded);
+        while (!line.empty() && IsBlank(line.front())) line.remove_prefix(1);
+        if (line.empty() || line.front() == L'#') continue;
+
+        ScriptJob job;
+        job.line = static_cast<uint32_t>(lineNumber);
+        valid = NextToken(line, job.path) && !job.path.empty() && !HasControlCharacter(job.path);
+        ExecutableKind kind = valid ? GetScriptKind(job.path) : EXECUTABLE_KIND_UNKNOWN;
+        valid = valid && kind != EXECUTABLE_KIND_UNKNOWN;
+
+        std::wstring argument;
+        while (valid) {
+            while (!line.empty() && IsBlank(line.front())) line.remove_prefix(1);
+            if (line.empty()) break;
+            valid = NextToken(line, argument) && !HasControlCharacter(argument) &&
+                    (kind != EXECUTABLE_KIND_SCRIPT || IsCmdSafe(argument));
+            if (valid) {
+                job.arguments.push_back(argument);
+            }
+        }
+
+        if (valid) {
+            jobs.push_back(std::move(job));
+        }
+    }
+
+    if (!valid) {
+        // Daftar rusak tidak boleh dijalankan sebagian
+        jobs.clear();
+        if (errorLine) *errorLine = lineNumber;
+        return false;
+    }
+
+    if (errorLine) *errorLine = 0;
+    return true;
+}
+
+bool LoadScriptJobList(std::wstring_view path, std::vector<ScriptJob>& jobs, size_t* errorLine)
+{
+    jobs.clear();
+    if (errorLine) *errorLine = 0;
+
+    std::string text;
+    if (!ReadSmallFile(GetFileSystemBackend(), std::wstring(path), SCRIPTHOST_MAX_JOB_FILE_SIZE, text)) {
+        return false;
+    }
+    return ParseScriptJobList(text, jobs, errorLine);
+}
+
+//==============================================================================
+// COMMAND BUILDERS
+//==============================================================================
+
+/** @brief Argumen cmd diberi kutip hanya jika berisi pemisah/operator */
+static void AppendCmdArgument(std::wstring_view argument, std::wstring& command)
+{
+    bool quote = argument.empty() || argument.find_first_of(L" \t&|<>(),;=") != std::wstring_view::npos;
+    if (quote) command += L'"';
+    command += argument;
+    if (quote) command += L'"';
+}
+
+/** @brief String literal PowerShell berkutip tunggal (semua varian kutip tunggal digandakan) */
+static void AppendPowerShellLiteral(std::wstring_view text, std::wstring& command)
+{
+    command += L'\'';
+    for (wchar_t ch : text) {
+        if (ch == L'\'' || (ch >= 0x2018 && ch <= 0x201B)) {
+            command += ch;
+        }
+        command += ch;
+    }
+    command += L'\'';
+}
+
+/**
+ * @brief Command untuk satu job (atau probe siap jika script kosong)
+ */
+static std::string BuildJobCommand(ExecutableKind kind, const std::wstring& marker, const std::wstring& script,
+                                   const std::vector<std::wstring>& arguments, const std::wstring& directory)
+{
+    std::wstring command;
+    if (kind == EXECUTABLE_KIND_POWERSHELL) {
+        // Satu baris: -Command - mengeksekusi per statement lengkap
+        command += L"$LASTEXITCODE = 0; $rastiExit = 0; try { ";
+        if (!directory.empty()) {
+            command += L"Set-Location -LiteralPath ";
+            AppendPowerShellLiteral(directory, command);
+            command += L"; ";
+        }
+        if (!script.empty()) {
+            command += L"& ";
+            AppendPowerShellLiteral(script, command);
+            for (const std::wstring& argument : arguments) {
+                command += L' ';
+                AppendPowerShellLiteral(argument, command);
+            }
+            command += L" 2>&1 | Out-Host; if ($LASTEXITCODE) { $rastiExit = $LASTEXITCODE } ";
+        }
+        command += L"} catch { $_ | Out-Host; $rastiExit = 1 }; [Console]::Out.Write('";
+        command += marker;
+        command += L" ' + $rastiExit + [char]10); [Console]::Out.Flush()\r\n";
+    } else {
+        // '@' menahan echo baris command meskipun script menyalakan echo
+        if (!directory.empty()) {
+            command += L"@cd /d \"" + directory + L"\"\r\n";
+        }
+        if (!script.empty()) {
+            command += L"@(call )\r\n@call \"" + script + L"\"";
+            for (const std::wstring& argument : arguments) {
+                command += L' ';
+                AppendCmdArgument(argument, command);
+            }
+            command += L" <nul\r\n";
+        }
+        command += L"@echo " + marker + L" %ERRORLEVEL%\r\n";
+    }
+
+    std::string bytes;
+    AppendUtf8(command, bytes);
+    return bytes;
+}
+
+//==============================================================================
+// HOST SESSION
+//==============================================================================
+
+namespace {
+
+/** @brief Hasil menunggu marker */
+enum MarkerWait {
+    MARKER_FOUND = 0,
+    MARKER_HOST_EXITED,
+    MARKER_TIMED_OUT,
+    MARKER_PIPE_FAILED
+};
+
+/**
+ * @brief Satu proses interpreter beserta state protokol marker-nya
+ */
+class ScriptHostSession {
+private:
+    IScriptHostBackend* backend_;
+    ExecutableKind kind_;
+    OsHandle host_ = OS_INVALID_HANDLE;
+    std::wstring nonce_;
+    uint64_t sequence_ = 0;
+    unsigned jobs_ = 0;
+    std::string pending_;     /**< Output yang belum dipindai habis */
+
+    std::wstring NextMarker()
+    {
+        return L"__RASTI_" + nonce_ + L"_" + std::to_wstring(++sequence_) + L"__";
+    }
+
+    /** @brief Memindahkan output ke hasil job dengan batas SCRIPTHOST_MAX_OUTPUT */
+    static void TakeOutput(std::string_view data, ScriptJobResult* result)
+    {
+        if (!result) return;
+        result->outputBytes += data.size();
+        size_t room = SCRIPTHOST_MAX_OUTPUT - result->output.size();
+        result->output.append(data.substr(0, room));
+    }
+
+    /**
+     * @brief Membaca output sampai marker + exit code + newline diterima
+     *
+     * Output sebelum marker diberikan ke result (NULL = dibuang). Pipe yang
+     * masih terbuka oleh proses turunan tidak membuat engine menunggu host
+     * yang sudah keluar: setiap SCRIPTHOST_POLL_INTERVAL_MS status host dicek.
+     */
+    MarkerWait WaitMarker(const std::wstring& marker, uint32_t timeoutMs, uint32_t& code, ScriptJobResult* result)
+    {
+        std::string token;
+        AppendUtf8(marker, token);
+        token += ' ';
+
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutMs);
+        size_t scanned = 0;
+        for (;;) {
+            size_t found = pending_.find(token, scanned);
+            if (found != std::string::npos) {
+                size_t newline = pending_.find('\n', found + token.size());
+                if (newline != std::string::npos) {
+                    std::string value = pending_.substr(found + token.size(), newline - found - token.size());
+                    while (!value.empty() && (value.back() == '\r' || value.back() == ' ')) value.pop_back();
+                    code = static_cast<uint32_t>(strtoll(value.c_str(), nullptr, 10));
+                    TakeOutput(std::string_view(pending_).substr(0, found), result);
+                    pending_.erase(0, newline + 1);
+                    return MARKER_FOUND;
+                }
+                scanned = found;
+            } else if (pending_.size() > SCRIPTHOST_MAX_OUTPUT + token.size()) {
+                // Output panjang tanpa marker: simpan ke hasil, pertahankan ekor untuk marker yang terpotong
+                size_t keep = token.size();
+                TakeOutput(std::string_view(pending_).substr(0, pending_.size() - keep), result);
+                pending_.erase(0, pending_.size() - keep);
+                scanned = 0;
+            } else {
+                scanned = (pending_.size() > token.size()) ? pending_.size() - token.size() : 0;
+            }
+
+            uint32_t wait = SCRIPTHOST_POLL_INTERVAL_MS;
+            if (timeoutMs) {
+                auto now = std::chrono::steady_clock::now();
+                if (now >= deadline) {
+                    return MARKER_TIMED_OUT;
+                }
+                uint64_t remaining = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - now).count();
+                if (remaining < wait) wait = static_cast<uint32_t>(remaining ? remaining : 1);
+            }
+
+            if (backend_->ReadHostOutput(host_, wait, pending_)) {
+                continue;
+            }
+
+            uint32_t error = backend_->GetLastErrorCode();
+            if (error != OS_ERROR_WAIT_TIMEOUT && error != OS_ERROR_BROKEN_PIPE) {
+                code = error;
+                return MARKER_PIPE_FAILED;
+            }
+            uint32_t exitTimeout = (error == OS_ERROR_BROKEN_PIPE) ? SCRIPTHOST_EXIT_TIMEOUT_MS : 0;
+            if (backend_->WaitHostExit(host_, exitTimeout, code)) {
+                TakeOutput(pending_, result);
+                pending_.clear();
+                return MARKER_HOST_EXITED;
+            }
+            if (error == OS_ERROR_BROKEN_PIPE) {
+                code = error;
+                return MARKER_PIPE_FAILED;
+            }
+        }
+    }
+
+public:
+    ScriptHostSession(IScriptHostBackend* backend, ExecutableKind kind) : backend_(backend), kind_(kind) {}
+    ~ScriptHostSession() { Stop(false); }
+
+    bool IsRunning() const { return host_ != OS_INVALID_HANDLE; }
+    unsigned JobCount() const { return jobs_; }
+
+    /**
+     * @brief Menjalankan host lalu menunggu probe marker pertama (membuang banner)
+     * @param error Output kode error jika gagal
+     */
+    bool Start(const ScriptHostOptions& options, uint32_t& error)
+    {
+        ProcessLaunchRequest request;
+        if (kind_ == EXECUTABLE_KIND_POWERSHELL) {
+            request.applicationName = options.powershellPath;
+            request.commandLine = L"\"" + options.powershellPath +
+                L"\" -NoLogo -NoProfile -NonInteractive -ExecutionPolicy Bypass -Command -";
+        } else {
+            request.applicationName = options.cmdPath;
+            request.commandLine = L"\"" + options.cmdPath + L"\" /D /Q /V:OFF";
+        }
+        request.creationFlags = options.creationFlags;
+
+        host_ = backend_->StartHost(options.token, request);
+        if (host_ == OS_INVALID_HANDLE) {
+            error = backend_->GetLastErrorCode();
+            return false;
+        }
+
+        std::random_device random;
+        wchar_t nonce[17];
+        swprintf(nonce, 17, L"%08X%08X", static_cast<unsigned>(random()), static_cast<unsigned>(random()));
+        nonce_ = nonce;
+        sequence_ = 0;
+        jobs_ = 0;
+        pending_.clear();
+
+        // Encoding UTF-8 untuk path/argumen non-ASCII di stdin dan output
+        std::string setup = (kind_ == EXECUTABLE_KIND_POWERSHELL) ?
+            "[Console]::InputEncoding = New-Object Text.UTF8Encoding $false; "
+            "[Console]::OutputEncoding = New-Object Text.UTF8Encoding $false\r\n" :
+            "@chcp 65001>nul\r\n";
+        std::wstring marker = NextMarker();
+        setup += BuildJobCommand(kind_, marker, std::wstring(), std::vector<std::wstring>(), std::wstring());
+
+        uint32_t code = 0;
+        MarkerWait wait = MARKER_PIPE_FAILED;
+        if (!backend_->WriteHostInput(host_, setup)) {
+            code = backend_->GetLastErrorCode();
+        } else {
+            wait = WaitMarker(marker, SCRIPTHOST_START_TIMEOUT_MS, code, nullptr);
+        }
+        if (wait != MARKER_FOUND) {
+            error = (wait == MARKER_TIMED_OUT) ? OS_ERROR_WAIT_TIMEOUT :
+                    (wait == MARKER_HOST_EXITED) ? OS_ERROR_BROKEN_PIPE : code;
+            Stop(false);
+            return false;
+        }
+        return true;
+    }
+
+    /**
+     * @brief Menjalankan satu script tervalidasi dan mengisi status, exit code, dan output
+     */
+    void Run(const ValidatedExecutable& script, const ScriptJob& job, const ScriptHostOptions& options,
+             ScriptJobResult& result)
+    {
+        jobs_++;
+        std::wstring marker = NextMarker();
+        // Direktori yang tidak aman untuk baris cmd tidak di-reset (host tetap di direktori awalnya)
+        bool resetDirectory = kind_ == EXECUTABLE_KIND_POWERSHELL || IsCmdSafe(options.workingDirectory);
+        std::string command = BuildJobCommand(kind_, marker, script.path, job.arguments,
+                                              resetDirectory ? options.workingDirectory : std::wstring());
+        if (!backend_->WriteHostInput(host_, command)) {
+            // Host sudah keluar (misalnya job sebelumnya) - laporkan sebagai kegagalan host
+            result.status = SCRIPTJOB_HOST_FAILED;
+            result.errorCode = backend_->GetLastErrorCode();
+            return;
+        }
+
+        uint32_t code = 0;
+        switch (WaitMarker(marker, options.timeoutMs, code, &result))
+        {
+        case MARKER_FOUND:
+            result.status = SCRIPTJOB_COMPLETED;
+            result.exitCode = code;
+            break;
+        case MARKER_HOST_EXITED:
+            result.status = SCRIPTJOB_HOST_EXITED;
+            result.exitCode = code;
+            break;
+        case MARKER_TIMED_OUT:
+            TakeOutput(pending_, &result);
+            pending_.clear();
+            result.status = SCRIPTJOB_TIMED_OUT;
+            break;
+        default:
+            result.status = SCRIPTJOB_HOST_FAILED;
+            result.errorCode = code;
+            break;
+        }
+    }
+
+    /**
+     * @brief Menghentikan host
+     * @param graceful true = kirim "exit" dan tunggu sebentar sebelum terminate
+     */
+    void Stop(bool graceful)
+    {
+        if (host_ == OS_INVALID_HANDLE) return;
+
+        if (graceful && backend_->WriteHostInput(host_, "exit\r\n")) {
+            uint32_t code = 0;
+            backend_->WaitHostExit(host_, SCRIPTHOST_EXIT_TIMEOUT_MS, code);
+        }
+        backend_->CloseHost(host_); // Terminate jika masih berjalan
+        host_ = OS_INVALID_HANDLE;
+        pending_.clear();
+    }
+};
+
+} // namespace
+
+//==============================================================================
+// ENGINE
+//==============================================================================
+
+bool RunScriptHost(const std::vector<ScriptJob>& jobs, const ScriptHostOptions& options, ScriptHostReport& report)
+{
+    report = ScriptHostReport();
+    auto started = std::chrono::steady_clock::now();
+
+    IScriptHostBackend* backend = GetScriptHostBackend();
+    ScriptHostSession cmdHost(backend, EXECUTABLE_KIND_SCRIPT);
+    ScriptHostSession powershellHost(backend, EXECUTABLE_KIND_POWERSHELL);
+
+    report.results.reserve(jobs.size());
+    for (const ScriptJob& job : jobs) {
+        report.results.push_back(ScriptJobResult());
+        ScriptJobResult& result = report.results.back();
+        result.line = job.line;
+        result.path = job.path;
+        auto jobStarted = std::chrono::steady_clock::now();
+
+        // Handle tervalidasi tetap terbuka sampai script selesai (TOCTOU)
+        ValidatedExecutable script;
+        result.validation = ValidateScript(job.path, script);
+        if (result.validation == VALIDATION_OK && script.kind == EXECUTABLE_KIND_SCRIPT &&
+            !IsCmdSafe(script.path)) {
+            result.validation = VALIDATION_UNSAFE_PATH;
+        }
+        if (result.validation != VALIDATION_OK) {
+            result.status = SCRIPTJOB_REJECTED;
+            report.jobsFailed++;
+            continue;
+        }
+        result.path = script.path;
+        result.kind = script.kind;
+
+        ScriptHostSession& host = (script.kind == EXECUTABLE_KIND_POWERSHELL) ? powershellHost : cmdHost;
+        if (!host.IsRunning()) {
+            auto hostStarted = std::chrono::steady_clock::now();
+            bool ready = host.Start(options, result.errorCode);
+            report.hostStartSeconds +=
+                std::chrono::duration<double>(std::chrono::steady_clock::now() - hostStarted).count();
+            report.hostsStarted++;
+            if (!ready) {
+                result.status = SCRIPTJOB_HOST_FAILED;
+                report.jobsFailed++;
+                continue;
+            }
+        }
+
+        host.Run(script, job, options, result);
+        script.file.Reset();
+        result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - jobStarted).count();
+
+        bool succeeded = result.Succeeded();
+        if (succeeded) {
+            report.jobsSucceeded++;
+        } else {
+            report.jobsFailed++;
+        }
+
+        // State host setelah kegagalan tidak dapat dipercaya; batas job membatasi state yang bocor
+        bool recycle = !succeeded || result.status != SCRIPTJOB_COMPLETED ||
+                       (options.jobsPerHost && host.JobCount() >= options.jobsPerHost);
+        if (recycle && host.IsRunning()) {
+            host.Stop(result.status == SCRIPTJOB_COMPLETED);
+            report.hostsRecycled++;
+        }
+    }
+
+    cmdHost.Stop(true);
+    powershellHost.Stop(true);
+    report.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+    return report.jobsFailed == 0;
+}
+
+//==============================================================================
+// REPORT
+//==============================================================================
+
+const char* GetScriptJobStatusName(ScriptJobStatus status)
+{
+    switch (status)
+    {
+    case SCRIPTJOB_COMPLETED:   return "completed";
+    case SCRIPTJOB_REJECTED:    return "rejected";
+    case SCRIPTJOB_HOST_EXITED: return "host-exited";
+    case SCRIPTJOB_TIMED_OUT:   return "timed-out";
+    case SCRIPTJOB_HOST_FAILED: return "host-failed";
+    default:                    return "unknown";
+    }
+}
+
+std::string FormatScriptHostReport(const ScriptHostReport& report)
+{
+    std::string text;
+    char line[256];
+
+    for (const ScriptJobResult& result : report.results) {
+        if (result.status == SCRIPTJOB_REJECTED) {
+            snprintf(line, sizeof(line), "line %u: rejected (%s): ",
+                     static_cast<unsigned>(result.line), GetValidationErrorName(result.validation));
+        } else if (result.status == SCRIPTJOB_HOST_FAILED) {
+            snprintf(line, sizeof(line), "line %u: host-failed (error %u): ",
+                     static_cast<unsigned>(result.line), static_cast<unsigned>(result.errorCode));
+        } else if (result.status == SCRIPTJOB_TIMED_OUT) {
+            snprintf(line, sizeof(line), "line %u: timed-out after %.3f s: ",
+                     static_cast<unsigned>(result.line), result.seconds);
+        } else {
+            snprintf(line, sizeof(line), "line %u: %s, exit %u, %.3f s: ",
+                     static_cast<unsigned>(result.line), GetScriptJobStatusName(result.status),
+                     static_cast<unsigned>(result.exitCode), result.seconds);
+        }
+        text += line;
+        AppendUtf8(result.path, text);
+        text += '\n';
+
+        // Output diberi indent per baris agar tidak tertukar dengan baris status
+        size_t start = 0;
+        while (start < result.output.size()) {
+            size_t end = result.output.find('\n', start);
+            if (end == std::string::npos) end = result.output.size();
+            size_t length = end - start;
+            if (length > 0 && result.output[start + length - 1] == '\r') length--;
+            text += "  | ";
+            text.append(result.output, start, length);
+            text += '\n';
+            start = end + 1;
+        }
+        if (result.outputBytes > result.output.size()) {
+            snprintf(line, sizeof(line), "  ... %llu more output bytes\n",
+                     static_cast<unsigned long long>(result.outputBytes - result.output.size()));
+            text += line;
+        }
+    }
+
+    snprintf(line, sizeof(line), "%llu/%llu jobs succeeded, %llu failed, %.3f s\n",
+             static_cast<unsigned long long>(report.jobsSucceeded),
+             static_cast<unsigned long long>(report.results.size()),
+             static_cast<unsigned long long>(report.jobsFailed), report.seconds);
+    text += line;
+    snprintf(line, sizeof(line), "%llu hosts started (%.3f s startup), %llu recycled\n",
+             static_cast<unsigned long long>(report.hostsStarted), report.hostStartSeconds,
+             static_cast<unsigned long long>(report.hostsRecycled));
+    text += line;
+    return text;
+}
@@ -0,0 +1,243 @@
+/**
+ * @file SessionLaunch.cpp
+ * @brief Implementasi /sessions: enumerasi session dan launch paralel per session
+ *
+ * Target dipilih dari satu enumerasi, lalu worker mengambil session
+ * berikutnya dari counter atomic sampai semua target selesai. Request dasar
+ * dibangun sekali; setiap worker hanya menyalin request dan mengisi
+ * sessionId, sehingga biaya per session = duplikasi token + CreateProcessAsUserW.
+ *
+ * @author RasTI Development Team
+ * @version 1.2.0.0
+ * @date 2025
+ */
+
+#include "SessionLaunch.h"
+#include "TextEncoding.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <thread>
+
+//==============================================================================
+// SELECTION
+//==============================================================================
+
+bool ParseSessionSelection(std::wstring_view text, SessionSelection& selection)
+{
+    selection = SessionSelection();
+    if (text.size() == 3 && (text[0] == L'a' || text[0] == L'A') && (text[1] == L'l' || text[1] == L'L') &&
+        (text[2] == L'l' || text[2] == L'L')) {
+        selection.all = true;
+        return true;
+    }
+
+    size_t position = 0;
+    while (position <= text.size()) {
+        size_t comma = text.find(L',', position);
+        std::wstring_view item = text.substr(position, comma == std::wstring_view::npos ? std::wstring_view::npos
+                                                                                           : comma - position);
+        if (item.empty() || item.size() > 10) {
+            return false;
+        }
+        uint64_t value = 0;
+        for (wchar_t ch : item) {
+            if (ch < L'0' || ch > L'9') {
+                return false;
+            }
+            value = value * 10 + static_cast<uint64_t>(ch - L'0');
+        }
+        // 0xFFFFFFFF = PROCESS_SESSION_CALLER, bukan ID session
+        if (value >= PROCESS_SESSION_CALLER) {
+            return false;
+        }
+        uint32_t sessionId = static_cast<uint32_t>(value);
+        if (std::find(selection.sessionIds.begin(), selection.sessionIds.end(), sessionId) !=
+                selection.sessionIds.end() ||
+            selection.sessionIds.size() >= SESSION_LAUNCH_MAX_IDS) {
+            return false;
+        }
+        selection.sessionIds.push_back(sessionId);
+
+        if (comma == std::wstring_view::npos) {
+            break;
+        }
+        position = comma + 1;
+    }
+    return !selection.sessionIds.empty();
+}
+
+//==============================================================================
+// ENGINE
+//==============================================================================
+
+namespace {
+
+typedef std::chrono::steady_clock Clock;
+
+double SecondsBetween(Clock::time_point from, Clock::time_point to)
+{
+    return std::chrono::duration<double>(to - from).count();
+}
+
+} // namespace
+
+bool LaunchInSessions(const ValidatedExecutable& executable, const std::vector<std::wstring>& arguments,
+                      const SessionSelection& selection, const SessionLaunchOptions& options,
+                      SessionLaunchReport& report)
+{
+    IProcessBackend* ps = GetProcessBackend();
+    Clock::time_point started = Clock::now();
+    report = SessionLaunchReport();
+
+    // STEP 1: Satu enumerasi untuk semua target
+    std::vector<SessionEntry> sessions;
+    bool enumerated = ps->EnumerateSessions(sessions);
+    report.enumerateSeconds = SecondsBetween(started, Clock::now());
+    if (!enumerated) {
+        report.errorCode = ps->GetLastErrorCode();
+        report.seconds = report.enumerateSeconds;
+        return false;
+    }
+    report.sessionsFound = sessions.size();
+
+    // STEP 2: Pilih target; ID eksplisit yang tidak ada langsung dicatat NOT_FOUND
+    std::vector<size_t> pending; // Indeks report.results yang akan di-launch
+    auto addTarget = [&](const SessionEntry& session) {
+        SessionLaunchResult result;
+        result.sessionId = session.sessionId;
+        result.stationName = session.stationName;
+        result.userName = session.userName;
+        result.status = SESSION_LAUNCH_FAILED;
+        pending.push_back(report.results.size());
+        report.results.push_back(result);
+    };
+    if (selection.all) {
+        for (const SessionEntry& session : sessions) {
+            if (session.active && session.sessionId != 0) {
+                addTarget(session);
+            }
+        }
+    } else {
+        for (uint32_t sessionId : selection.sessionIds) {
+            auto it = std::find_if(sessions.begin(), sessions.end(), [sessionId](const SessionEntry& session) {
+                return session.sessionId == sessionId;
+            });
+            if (it != sessions.end()) {
+                addTarget(*it);
+            } else {
+                SessionLaunchResult result;
+                result.sessionId = sessionId;
+                report.results.push_back(result);
+                report.notFound++;
+            }
+        }
+    }
+
+    // STEP 3: Request dasar sekali; console pemanggil tidak ada di session lain
+    ConsoleMode console = ResolveConsoleMode(options.console, executable);
+    if (console == CONSOLE_MODE_INHERIT) {
+        console = CONSOLE_MODE_NEW;
+    }
+    ProcessLaunchRequest base = BuildValidatedLaunchRequest(executable, arguments, options.creationFlags);
+    ApplyConsoleMode(console, base);
+
+    // STEP 4: Worker paralel dengan satu launcher (probe privilege hanya sekali)
+    TrustedInstallerLauncher launcher(LAUNCH_API_AS_USER);
+    std::atomic<size_t> next{0};
+    auto worker = [&]() {
+        for (size_t i = next++; i < pending.size(); i = next++) {
+            SessionLaunchResult& result = report.results[pending[i]];
+            ProcessLaunchRequest request = base;
+            request.sessionId = result.sessionId;
+
+            Clock::time_point launchStarted = Clock::now();
+            uint32_t processId = 0;
+            if (launcher.Launch(options.token, request, &processId)) {
+                result.status = SESSION_LAUNCH_STARTED;
+                result.processId = processId;
+            } else {
+                result.errorCode = ps->GetLastErrorCode();
+            }
+            result.seconds = SecondsBetween(launchStarted, Clock::now());
+        }
+    };
+
+    unsigned limit = options.maxParallel ? options.maxParallel : SESSION_LAUNCH_MAX_THREADS;
+    report.threadCount = static_cast<unsigned>(std::min<size_t>(limit, pending.size()));
+    // Worker 0 berjalan di thread pemanggil
+    std::vector<std::thread> threads;
+    for (unsigned i = 1; i < report.threadCount; i++) {
+        threads.emplace_back(worker);
+    }
+    if (report.threadCount > 0) {
+        worker();
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
+    for (size_t index : pending) {
+        if (report.results[index].status == SESSION_LAUNCH_STARTED) {
+            report.launched++;
+        } else {
+            report.failed++;
+        }
+    }
+    report.seconds = SecondsBetween(started, Clock::now());
+    return !pending.empty() && report.failed == 0 && report.notFound == 0;
+}
+
+const char* GetSessionLaunchStatusName(SessionLaunchStatus status)
+{
+    switch (status)
+    {
+    case SESSION_LAUNCH_STARTED:   return "started";
+    case SESSION_LAUNCH_FAILED:    return "failed";
+    case SESSION_LAUNCH_NOT_FOUND: return "not-found";
+    default:                       return "unknown";
+    }
+}
+
+//==============================================================================
+// REPORT
+//==============================================================================
+
+std::string FormatSessionLaunchReport(const SessionLaunchReport& report)
+{
+    std::string text;
+    char line[256];
+
+    for (const SessionLaunchResult& result : report.results) {
+        snprintf(line, sizeof(line), "  session %u ", static_cast<unsigned>(result.sessionId));
+        text += line;
+        AppendUtf8(result.stationName.empty() ? std::wstring_view(L"-") : std::wstring_view(result.stationName),
+                   text);
+        text += ' ';
+        AppendUtf8(result.userName.empty() ? std::wstring_view(L"-") : std::wstring_view(result.userName), text);
+        if (result.status == SESSION_LAUNCH_STARTED) {
+            snprintf(line, sizeof(line), ": started, pid %u (%.3f s)\n", static_cast<unsigned>(result.processId),
+                     result.seconds);
+        } else if (result.status == SESSION_LAUNCH_FAILED) {
+            snprintf(line, sizeof(line), ": FAILED (error %u)\n", static_cast<unsigned>(result.errorCode));
+        } else {
+            snprintf(line, sizeof(line), ": %s\n", GetSessionLaunchStatusName(result.status));
+        }
+        text += line;
+    }
+    if (report.errorCode != 0) {
+        snprintf(line, sizeof(line), "Session enumeration failed (error %u)\n", static_cast<unsigned>(report.errorCode));
+        text += line;
+    } else if (report.results.empty()) {
+        text += "No active user sessions\n";
+    }
+    snprintf(line, sizeof(line),
+             "%llu sessions enumerated in %.3f s, %llu launched, %llu failed, %llu not found, %u threads, %.3f s\n",
+             static_cast<unsigned long long>(report.sessionsFound), report.enumerateSeconds,
+             static_cast<unsigned long long>(report.launched),
+             static_cast<unsigned long long>(report.failed),
+             static_cast<unsigned long long>(report.notFound), report.threadCount, report.seconds);
+    text += line;
+    return text;
+}
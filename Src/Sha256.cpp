@@ -0,0 +1,311 @@
+/**
+ * @file Sha256.cpp
+ * @brief Implementasi SHA-256 (FIPS 180-4) dengan dispatch SHA-NI saat runtime
+ *
+ * Fungsi kompresi dipilih satu kali: versi SHA-NI jika CPU melaporkan SHA
+ * extensions (CPUID leaf 7, EBX bit 29) beserta SSSE3/SSE4.1, selain itu versi
+ * scalar. Kedua versi memproses banyak blok sekaligus agar overhead dispatch
+ * hanya terjadi sekali per Update.
+ *
+ * @author RasTI Development Team
+ * @version 1.2.0.0
+ * @date 2025
+ */
+
+#include "Sha256.h"
+#include <cstring>
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define RASTI_SHA256_SHANI 1
+#include <cpuid.h>
+#include <immintrin.h>
+#endif
+
+//==============================================================================
+// CONSTANTS
+//==============================================================================
+
+/** @brief Round constants K (FIPS 180-4 section 4.2.2) */
+alignas(16) static const uint32_t SHA256_K[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+};
+
+/** @brief Initial hash value H(0) */
+static const uint32_t SHA256_INITIAL_STATE[8] = {
+    0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19
+};
+
+/** @brief Fungsi kompresi: memproses sejumlah blok 64-byte berturut-turut */
+typedef void (*Sha256BlockFunction)(uint32_t state[8], const uint8_t* data, size_t blocks);
+
+//==============================================================================
+// SCALAR IMPLEMENTATION
+//==============================================================================
+
+static inline uint32_t RotateRight(uint32_t value, int bits)
+{
+    return (value >> bits) | (value << (32 - bits));
+}
+
+static inline uint32_t ReadBe32(const uint8_t* p)
+{
+    return (static_cast<uint32_t>(p[0]) << 24) | (static_cast<uint32_t>(p[1]) << 16) |
+           (static_cast<uint32_t>(p[2]) << 8) | static_cast<uint32_t>(p[3]);
+}
+
+static void Sha256BlocksScalar(uint32_t state[8], const uint8_t* data, size_t blocks)
+{
+    uint32_t w[64];
+
+    while (blocks--) {
+        for (int i = 0; i < 16; i++) {
+            w[i] = ReadBe32(data + i * 4);
+        }
+        for (int i = 16; i < 64; i++) {
+            uint32_t s0 = RotateRight(w[i - 15], 7) ^ RotateRight(w[i - 15], 18) ^ (w[i - 15] >> 3);
+            uint32_t s1 = RotateRight(w[i - 2], 17) ^ RotateRight(w[i - 2], 19) ^ (w[i - 2] >> 10);
+            w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+        }
+
+        uint32_t a = state[0], b = state[1], c = state[2], d = state[3];
+        uint32_t e = state[4], f = state[5], g = state[6], h = state[7];
+
+        for (int i = 0; i < 64; i++) {
+            uint32_t s1 = RotateRight(e, 6) ^ RotateRight(e, 11) ^ RotateRight(e, 25);
+            uint32_t ch = (e & f) ^ (~e & g);
+            uint32_t temp1 = h + s1 + ch + SHA256_K[i] + w[i];
+            uint32_t s0 = RotateRight(a, 2) ^ RotateRight(a, 13) ^ RotateRight(a, 22);
+            uint32_t maj = (a & b) ^ (a & c) ^ (b & c);
+            uint32_t temp2 = s0 + maj;
+
+            h = g; g = f; f = e; e = d + temp1;
+            d = c; c = b; b = a; a = temp1 + temp2;
+        }
+
+        state[0] += a; state[1] += b; state[2] += c; state[3] += d;
+        state[4] += e; state[5] += f; state[6] += g; state[7] += h;
+        data += SHA256_BLOCK_SIZE;
+    }
+}
+
+//==============================================================================
+// SHA-NI IMPLEMENTATION (x86 SHA EXTENSIONS)
+//==============================================================================
+
+#ifdef RASTI_SHA256_SHANI
+
+/**
+ * @brief Kompresi blok dengan _mm_sha256rnds2_epu32 (4 round per iterasi)
+ *
+ * State disimpan dalam susunan ABEF/CDGH yang dibutuhkan instruksi SHA256RNDS2.
+ * Message schedule dihitung bergulir di 4 register: group r+4 dibentuk dari
+ * group r..r+3 dengan SHA256MSG1/SHA256MSG2.
+ */
+__attribute__((target("sha,sse4.1,ssse3")))
+static void Sha256BlocksShaNi(uint32_t state[8], const uint8_t* data, size_t blocks)
+{
+    const __m128i byteSwapMask = _mm_set_epi64x(0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+
+    __m128i tmp = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&state[0]));
+    __m128i state1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&state[4]));
+    tmp = _mm_shuffle_epi32(tmp, 0xB1);                 // CDAB
+    state1 = _mm_shuffle_epi32(state1, 0x1B);           // EFGH
+    __m128i state0 = _mm_alignr_epi8(tmp, state1, 8);   // ABEF
+    state1 = _mm_blend_epi16(state1, tmp, 0xF0);        // CDGH
+
+    while (blocks--) {
+        __m128i abefSave = state0;
+        __m128i cdghSave = state1;
+
+        __m128i w[4];
+        for (int i = 0; i < 4; i++) {
+            w[i] = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i * 16)), byteSwapMask);
+        }
+
+        for (int group = 0; group < 16; group++) {
+            __m128i msg = _mm_add_epi32(w[group & 3],
+                                        _mm_load_si128(reinterpret_cast<const __m128i*>(&SHA256_K[group * 4])));
+            state1 = _mm_sha256rnds2_epu32(state1, state0, msg);
+
+            if (group < 12) {
+                // W[t..t+3] untuk group + 4 = msg2(msg1(W0, W1) + W[9..12], W3)
+                __m128i next = _mm_sha256msg1_epu32(w[group & 3], w[(group + 1) & 3]);
+                next = _mm_add_epi32(next, _mm_alignr_epi8(w[(group + 3) & 3], w[(group + 2) & 3], 4));
+                w[group & 3] = _mm_sha256msg2_epu32(next, w[(group + 3) & 3]);
+            }
+
+            msg = _mm_shuffle_epi32(msg, 0x0E);
+            state0 = _mm_sha256rnds2_epu32(state0, state1, msg);
+        }
+
+        state0 = _mm_add_epi32(state0, abefSave);
+        state1 = _mm_add_epi32(state1, cdghSave);
+        data += SHA256_BLOCK_SIZE;
+    }
+
+    tmp = _mm_shuffle_epi32(state0, 0x1B);              // FEBA
+    state1 = _mm_shuffle_epi32(state1, 0xB1);           // DCHG
+    state0 = _mm_blend_epi16(tmp, state1, 0xF0);        // DCBA
+    state1 = _mm_alignr_epi8(state1, tmp, 8);           // HGFE
+
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(&state[0]), state0);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(&state[4]), state1);
+}
+
+/**
+ * @brief Deteksi SHA extensions + SSSE3/SSE4.1 melalui CPUID
+ */
+static bool CpuSupportsShaNi()
+{
+    unsigned int eax = 0, ebx = 0, ecx = 0, edx = 0;
+    if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx)) return false;
+    bool ssse3 = (ecx & (1u << 9)) != 0;
+    bool sse41 = (ecx & (1u << 19)) != 0;
+
+    if (__get_cpuid_max(0, NULL) < 7) return false;
+    __cpuid_count(7, 0, eax, ebx, ecx, edx);
+    bool sha = (ebx & (1u << 29)) != 0;
+
+    return ssse3 && sse41 && sha;
+}
+
+#endif
+
+//==============================================================================
+// DISPATCH
+//==============================================================================
+
+/**
+ * @brief Memilih fungsi kompresi satu kali (thread-safe static init)
+ */
+static Sha256BlockFunction GetBlockFunction()
+{
+#ifdef RASTI_SHA256_SHANI
+    static const Sha256BlockFunction selected = CpuSupportsShaNi() ? Sha256BlocksShaNi : Sha256BlocksScalar;
+    return selected;
+#else
+    return Sha256BlocksScalar;
+#endif
+}
+
+bool Sha256::IsHardwareAccelerated()
+{
+    return GetBlockFunction() != Sha256BlocksScalar;
+}
+
+//==============================================================================
+// STREAMING HASHER
+//==============================================================================
+
+void Sha256::Reset()
+{
+    memcpy(state_, SHA256_INITIAL_STATE, sizeof(state_));
+    bufferLength_ = 0;
+    totalLength_ = 0;
+}
+
+void Sha256::Update(const void* data, size_t size)
+{
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    totalLength_ += size;
+    Sha256BlockFunction compress = GetBlockFunction();
+
+    // Lengkapi blok parsial dari Update sebelumnya
+    if (bufferLength_ > 0) {
+        size_t take = SHA256_BLOCK_SIZE - bufferLength_;
+        if (take > size) take = size;
+        memcpy(buffer_ + bufferLength_, bytes, take);
+        bufferLength_ += take;
+        bytes += take;
+        size -= take;
+
+        if (bufferLength_ < SHA256_BLOCK_SIZE) return;
+        compress(state_, buffer_, 1);
+        bufferLength_ = 0;
+    }
+
+    // Blok penuh diproses langsung dari buffer pemanggil (tanpa copy)
+    size_t blocks = size / SHA256_BLOCK_SIZE;
+    if (blocks > 0) {
+        compress(state_, bytes, blocks);
+        bytes += blocks * SHA256_BLOCK_SIZE;
+        size -= blocks * SHA256_BLOCK_SIZE;
+    }
+
+    if (size > 0) {
+        memcpy(buffer_, bytes, size);
+        bufferLength_ = size;
+    }
+}
+
+Sha256Digest Sha256::Final()
+{
+    uint64_t bitLength = totalLength_ * 8;
+
+    // Padding: 0x80, nol, lalu panjang 64-bit big-endian di akhir blok
+    uint8_t padding[SHA256_BLOCK_SIZE * 2] = { 0x80 };
+    size_t padLength = (bufferLength_ < 56) ? (56 - bufferLength_) : (120 - bufferLength_);
+    for (int i = 0; i < 8; i++) {
+        padding[padLength + i] = static_cast<uint8_t>(bitLength >> (56 - i * 8));
+    }
+    Update(padding, padLength + 8);
+
+    Sha256Digest digest;
+    for (int i = 0; i < 8; i++) {
+        digest[i * 4] = static_cast<uint8_t>(state_[i] >> 24);
+        digest[i * 4 + 1] = static_cast<uint8_t>(state_[i] >> 16);
+        digest[i * 4 + 2] = static_cast<uint8_t>(state_[i] >> 8);
+        digest[i * 4 + 3] = static_cast<uint8_t>(state_[i]);
+    }
+    return digest;
+}
+
+//==============================================================================
+// HELPERS
+//==============================================================================
+
+Sha256Digest ComputeSha256(const void* data, size_t size)
+{
+    Sha256 hasher;
+    hasher.Update(data, size);
+    return hasher.Final();
+}
+
+std::string Sha256ToHex(const Sha256Digest& digest)
+{
+    static const char hexDigits[] = "0123456789abcdef";
+    std::string hex(SHA256_DIGEST_SIZE * 2, '0');
+    for (size_t i = 0; i < SHA256_DIGEST_SIZE; i++) {
+        hex[i * 2] = hexDigits[digest[i] >> 4];
+        hex[i * 2 + 1] = hexDigits[digest[i] & 0x0F];
+    }
+    return hex;
+}
+
+static int HexValue(char ch)
+{
+    if (ch >= '0' && ch <= '9') return ch - '0';
+    if (ch >= 'a' && ch <= 'f') return ch - 'a' + 10;
+    if (ch >= 'A' && ch <= 'F') return ch - 'A' + 10;
+    return -1;
+}
+
+bool ParseSha256Hex(std::string_view hex, Sha256Digest& digest)
+{
+    if (hex.size() != SHA256_DIGEST_SIZE * 2) return false;
+
+    for (size_t i = 0; i < SHA256_DIGEST_SIZE; i++) {
+        int high = HexValue(hex[i * 2]);
+        int low = HexValue(hex[i * 2 + 1]);
+        if (high < 0 || low < 0) return false;
+        digest[i] = static_cast<uint8_t>((high << 4) | low);
+    }
+    return true;
+}
@@ -0,0 +1,189 @@
+/**
+ * @file SingleInstance.cpp
+ * @brief Implementasi /single: indeks identitas image proses yang berjalan
+ *
+ * Pencocokan memakai identitas file (volume serial + file index): path
+ * image kandidat dibaca dari prosesnya lalu dibuka lewat backend filesystem.
+ * Kandidat dari snapshot hanya dibuka saat Find pertama untuk nama file
+ * tersebut; hasilnya (termasuk kegagalan) di-cache per PID.
+ *
+ * @author RasTI Development Team
+ * @version 1.2.0.0
+ * @date 2025
+ */
+
+#include "SingleInstance.h"
+#include <chrono>
+
+//==============================================================================
+// MODE
+//==============================================================================
+
+/** @brief Huruf ASCII ke uppercase dan '/' ke '\' */
+static wchar_t FoldPathChar(wchar_t ch)
+{
+    if (ch == L'/') return L'\\';
+    return (ch >= L'a' && ch <= L'z') ? static_cast<wchar_t>(ch - L'a' + L'A') : ch;
+}
+
+static std::wstring FoldPath(std::wstring_view path)
+{
+    std::wstring folded;
+    folded.reserve(path.size());
+    for (wchar_t ch : path) folded.push_back(FoldPathChar(ch));
+    return folded;
+}
+
+bool ParseSingleInstanceMode(std::wstring_view text, SingleInstanceMode& mode)
+{
+    std::wstring folded = FoldPath(text);
+    if (folded.empty() || folded == L"SKIP") {
+        mode = SINGLE_INSTANCE_SKIP;
+        return true;
+    }
+    if (folded == L"ATTACH") {
+        mode = SINGLE_INSTANCE_ATTACH;
+        return true;
+    }
+    return false;
+}
+
+const char* GetSingleInstanceModeName(SingleInstanceMode mode)
+{
+    switch (mode)
+    {
+    case SINGLE_INSTANCE_OFF:    return "off";
+    case SINGLE_INSTANCE_SKIP:   return "skip";
+    case SINGLE_INSTANCE_ATTACH: return "attach";
+    default:                     return "unknown";
+    }
+}
+
+//==============================================================================
+// RUNNING IMAGE INDEX
+//==============================================================================
+
+/** @brief Nama yang tidak dapat dicocokkan dengan lipatan ASCII (alias 8.3 atau non-ASCII) */
+static bool IsUnfoldedName(std::wstring_view name)
+{
+    for (wchar_t ch : name) {
+        if (ch == L'~' || ch > 0x7F) return true;
+    }
+    return false;
+}
+
+bool RunningImageIndex::Load(IProcessBackend* backend, IFileSystemBackend* files)
+{
+    std::chrono::steady_clock::time_point started = std::chrono::steady_clock::now();
+    backend_ = backend;
+    files_ = files;
+    unfoldedNames_.clear();
+    snapshotImages_.clear();
+    launched_.clear();
+    stats_ = RunningImageStats();
+
+    bool loaded = table_.Load(backend);
+    const std::vector<ProcessEntry>& entries = table_.GetEntries();
+    for (size_t i = 0; i < entries.size(); i++) {
+        if (IsUnfoldedName(entries[i].imageName)) {
+            unfoldedNames_.push_back(i);
+        }
+    }
+    stats_.processesIndexed = entries.size();
+    stats_.scanSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+    return loaded;
+}
+
+bool RunningImageIndex::ResolveImage(uint32_t processId, SnapshotImage& image)
+{
+    // Proses -> path image -> file -> identitas; gagal di tahap mana pun = unverified
+    std::wstring imagePath;
+    FileIdentity identity = {};
+    OsHandle process = backend_->OpenProcessHandle(processId);
+    stats_.candidatesOpened++;
+    if (process != OS_INVALID_HANDLE && backend_->QueryProcessImagePath(process, imagePath)) {
+        OsHandle file = files_->OpenFileForValidation(imagePath);
+        if (file != OS_INVALID_HANDLE) {
+            image.verified = files_->QueryFileIdentity(file, identity);
+            files_->CloseFile(file);
+        }
+    }
+    if (process != OS_INVALID_HANDLE) {
+        backend_->CloseObject(process);
+    }
+    if (!image.verified) {
+        stats_.unverified++;
+        return false;
+    }
+    image.key = ImageKey(identity.volumeSerial, identity.fileIndex);
+    return true;
+}
+
+bool RunningImageIndex::Find(const ValidatedExecutable& executable, uint32_t& processId)
+{
+    stats_.lookups++;
+    ImageKey key(executable.identity.volumeSerial, executable.identity.fileIndex);
+
+    // STEP 1: Proses yang di-launch selama batch (belum ada di snapshot)
+    auto launched = launched_.find(key);
+    if (launched != launched_.end()) {
+        processId = launched->second;
+        stats_.hits++;
+        return true;
+    }
+
+    // STEP 2: Kandidat snapshot; identitas image dibaca sekali per PID
+    size_t separator = executable.path.find_last_of(L"\\/");
+    std::wstring_view fileName(executable.path);
+    fileName.remove_prefix(separator == std::wstring::npos ? 0 : separator + 1);
+    if (fileName.empty() || backend_ == NULL || files_ == NULL) {
+        return false;
+    }
+
+    const std::vector<ProcessEntry>& entries = table_.GetEntries();
+    auto matches = [&](size_t index) {
+        uint32_t candidate = entries[index].processId;
+        auto cached = snapshotImages_.find(candidate);
+        if (cached == snapshotImages_.end()) {
+            SnapshotImage image;
+            ResolveImage(candidate, image);
+            cached = snapshotImages_.emplace(candidate, image).first;
+        }
+        if (cached->second.verified && cached->second.key == key) {
+            processId = candidate;
+            stats_.hits++;
+            return true;
+        }
+        return false;
+    };
+
+    // Alias 8.3 atau nama non-ASCII: nama snapshot tidak dapat dipakai sebagai saringan
+    if (IsUnfoldedName(fileName)) {
+        for (size_t index = 0; index < entries.size(); index++) {
+            if (matches(index)) return true;
+        }
+        return false;
+    }
+    for (size_t index : table_.FindByName(fileName)) {
+        if (matches(index)) return true;
+    }
+    for (size_t index : unfoldedNames_) {
+        if (matches(index)) return true;
+    }
+    return false;
+}
+
+void RunningImageIndex::Add(uint32_t processId, const FileIdentity& identity)
+{
+    launched_[ImageKey(identity.volumeSerial, identity.fileIndex)] = processId;
+}
+
+void RunningImageIndex::Remove(uint32_t processId)
+{
+    for (auto it = launched_.begin(); it != launched_.end(); ++it) {
+        if (it->second == processId) {
+            launched_.erase(it);
+            return;
+        }
+    }
+}
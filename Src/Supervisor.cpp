@@ -0,0 +1,430 @@
+/**
+ * @file Supervisor.cpp
+ * @brief Implementasi /supervise: restart dengan backoff, batas crash loop, dan metrics
+ *
+ * Pump menunggu event dari satu completion port tanpa timeout berkala:
+ * timeout hanya dipakai untuk deadline restart terdekat, batas drain
+ * setelah exit, pengecekan flag cancel, dan pengecekan exit langsung untuk
+ * proses yang pipe-nya sudah tertutup tanpa notifikasi job. Setiap run yang
+ * berakhir (proses keluar, validasi gagal, atau launch gagal) dihitung
+ * sebagai kegagalan kecuali run tersebut bertahan minimal stableRunMs.
+ *
+ * @author RasTI Development Team
+ * @version 1.2.0.0
+ * @date 2025
+ */
+
+#include "Supervisor.h"
+#include "TextEncoding.h"
+#include <algorithm>
+#include <cstdio>
+
+//==============================================================================
+// METRICS
+//==============================================================================
+
+void SupervisorMetrics::Publish(size_t index, const SupervisedProgramMetrics& metrics,
+                                std::chrono::steady_clock::time_point runStarted)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (entries_.size() <= index) {
+        entries_.resize(index + 1);
+    }
+    entries_[index].metrics = metrics;
+    entries_[index].runStarted = runStarted;
+}
+
+std::vector<SupervisedProgramMetrics> SupervisorMetrics::Snapshot() const
+{
+    std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::vector<SupervisedProgramMetrics> programs;
+    programs.reserve(entries_.size());
+    for (const Entry& entry : entries_) {
+        programs.push_back(entry.metrics);
+        if (entry.metrics.state == SUPERVISED_RUNNING) {
+            double uptime = std::chrono::duration<double>(now - entry.runStarted).count();
+            programs.back().uptimeSeconds = uptime;
+            programs.back().totalUptimeSeconds += uptime;
+        }
+    }
+    return programs;
+}
+
+const char* GetSupervisedStateName(SupervisedState state)
+{
+    switch (state)
+    {
+    case SUPERVISED_STARTING: return "starting";
+    case SUPERVISED_RUNNING:  return "running";
+    case SUPERVISED_BACKOFF:  return "backoff";
+    case SUPERVISED_GAVE_UP:  return "gave-up";
+    case SUPERVISED_STOPPED:  return "stopped";
+    default:                  return "unknown";
+    }
+}
+
+std::string FormatSupervisorMetrics(const std::vector<SupervisedProgramMetrics>& programs)
+{
+    std::string text;
+    char line[256];
+
+    for (size_t i = 0; i < programs.size(); i++) {
+        const SupervisedProgramMetrics& program = programs[i];
+        snprintf(line, sizeof(line), "[%u] %s, pid %u, %llu starts, %llu restarts, uptime %.1f s (total %.1f s)",
+                 static_cast<unsigned>(i + 1), GetSupervisedStateName(program.state),
+                 static_cast<unsigned>(program.processId),
+                 static_cast<unsigned long long>(program.starts),
+                 static_cast<unsigned long long>(program.restarts),
+                 program.uptimeSeconds, program.totalUptimeSeconds);
+        text += line;
+        if (program.consecutiveFailures > 0) {
+            snprintf(line, sizeof(line), ", %u consecutive failures, last exit %u",
+                     program.consecutiveFailures, static_cast<unsigned>(program.lastExitCode));
+            text += line;
+        }
+        if (program.validation != VALIDATION_OK) {
+            snprintf(line, sizeof(line), ", rejected (%s)", GetValidationErrorName(program.validation));
+            text += line;
+        } else if (program.lastErrorCode != 0) {
+            snprintf(line, sizeof(line), ", launch error %u", static_cast<unsigned>(program.lastErrorCode));
+            text += line;
+        }
+        if (program.state == SUPERVISED_BACKOFF) {
+            snprintf(line, sizeof(line), ", restart in %.1f s", program.backoffSeconds);
+            text += line;
+        }
+        text += ": ";
+        AppendUtf8(program.path, text);
+        text += '\n';
+    }
+    return text;
+}
+
+std::string FormatSupervisorMetricsJson(const std::vector<SupervisedProgramMetrics>& programs)
+{
+    std::string text = "{\"programs\":[";
+    char number[384];
+
+    for (size_t i = 0; i < programs.size(); i++) {
+        const SupervisedProgramMetrics& program = programs[i];
+        text += (i == 0) ? "{\"path\":" : ",{\"path\":";
+        AppendJsonString(program.path, text);
+        snprintf(number, sizeof(number),
+                 ",\"state\":\"%s\",\"pid\":%u,\"starts\":%llu,\"restarts\":%llu,\"consecutiveFailures\":%u,"
+                 "\"lastExitCode\":%u,\"lastErrorCode\":%u,\"validation\":\"%s\",\"uptimeSeconds\":%.3f,"
+                 "\"lastRunSeconds\":%.3f,\"totalUptimeSeconds\":%.3f,\"backoffSeconds\":%.3f}",
+                 GetSupervisedStateName(program.state), static_cast<unsigned>(program.processId),
+                 static_cast<unsigned long long>(program.starts),
+                 static_cast<unsigned long long>(program.restarts), program.consecutiveFailures,
+                 static_cast<unsigned>(program.lastExitCode), static_cast<unsigned>(program.lastErrorCode),
+                 GetValidationErrorName(program.validation), program.uptimeSeconds, program.lastRunSeconds,
+                 program.totalUptimeSeconds, program.backoffSeconds);
+        text += number;
+    }
+    text += "]}\n";
+    return text;
+}
+
+//==============================================================================
+// COMMAND LINE BUILDER
+//==============================================================================
+
+/**
+ * @brief Request launch supervisor: BuildValidatedLaunchRequest + console tanpa window
+ */
+static ProcessLaunchRequest BuildLaunchRequest(const ValidatedExecutable& executable,
+                                               const std::vector<std::wstring>& arguments, uint32_t creationFlags,
+                                               ConsoleMode console)
+{
+    ProcessLaunchRequest request = BuildValidatedLaunchRequest(executable, arguments, creationFlags);
+
+    // Sama dengan /batch: output lewat pipe, console tetap dibuat tetapi tersembunyi
+    ConsoleMode resolved = ResolveConsoleMode(console, executable);
+    if (console == CONSOLE_MODE_AUTO && resolved == CONSOLE_MODE_NEW) {
+        resolved = CONSOLE_MODE_HIDDEN;
+    }
+    ApplyConsoleMode(resolved, request);
+    return request;
+}
+
+//==============================================================================
+// ENGINE
+//==============================================================================
+
+namespace {
+
+typedef std::chrono::steady_clock Clock;
+
+/** @brief Tunggu tanpa batas (INFINITE) */
+const uint64_t WAIT_FOREVER = 0xFFFFFFFF;
+
+/** @brief State satu program yang diawasi */
+struct SupervisedProgram {
+    SupervisedProgramMetrics metrics;
+    OsHandle process = OS_INVALID_HANDLE;   /**< Handle capture run saat ini */
+    bool streamOpen[2] = { true, true };
+    bool exited = false;
+    Clock::time_point runStarted;
+    Clock::time_point exitSeen;
+    Clock::time_point restartAt;            /**< Deadline state BACKOFF */
+};
+
+double SecondsBetween(Clock::time_point from, Clock::time_point to)
+{
+    return std::chrono::duration<double>(to - from).count();
+}
+
+uint64_t MillisecondsBetween(Clock::time_point from, Clock::time_point to)
+{
+    return to > from ? std::chrono::duration_cast<std::chrono::milliseconds>(to - from).count() : 0;
+}
+
+} // namespace
+
+uint32_t GetSupervisorBackoffMs(const SupervisorOptions& options, unsigned consecutiveFailures)
+{
+    if (consecutiveFailures == 0) {
+        return 0;
+    }
+    // Dihitung 64-bit dan shift dibatasi agar tidak overflow pada kegagalan ke-33 dan seterusnya
+    uint64_t delay = static_cast<uint64_t>(options.initialBackoffMs) << std::min(consecutiveFailures - 1, 32u);
+    return static_cast<uint32_t>(std::min<uint64_t>(delay, options.maxBackoffMs));
+}
+
+bool RunSupervisor(const std::vector<CaptureLaunch>& programs, const SupervisorOptions& options,
+                   const CaptureOutputCallback& output, const SupervisorEventCallback& events,
+                   SupervisorReport& report)
+{
+    report = SupervisorReport();
+    Clock::time_point started = Clock::now();
+    std::vector<SupervisedProgram> state(programs.size());
+    for (size_t i = 0; i < programs.size(); i++) {
+        state[i].metrics.path = programs[i].path;
+    }
+
+    auto publish = [&](size_t index) {
+        if (options.metrics) {
+            options.metrics->Publish(index, state[index].metrics, state[index].runStarted);
+        }
+        if (events) {
+            events(index, state[index].metrics);
+        }
+    };
+
+    IOutputCaptureBackend* backend = GetOutputCaptureBackend();
+    OsHandle port = backend->CreateCapturePort();
+    if (port == OS_INVALID_HANDLE) {
+        report.errorCode = backend->GetLastErrorCode();
+        for (size_t i = 0; i < state.size(); i++) {
+            state[i].metrics.state = SUPERVISED_STOPPED;
+            state[i].metrics.lastErrorCode = report.errorCode;
+            publish(i);
+            report.programs.push_back(state[i].metrics);
+        }
+        report.seconds = SecondsBetween(started, Clock::now());
+        return false;
+    }
+
+    // Run berakhir: hitung kegagalan beruntun lalu jadwalkan restart atau menyerah
+    auto scheduleRestart = [&](size_t index, double runSeconds, Clock::time_point now) {
+        SupervisedProgramMetrics& metrics = state[index].metrics;
+        bool stable = runSeconds * 1000.0 >= options.stableRunMs;
+        metrics.consecutiveFailures = stable ? 1 : metrics.consecutiveFailures + 1;
+        if (options.crashLoopLimit != 0 && metrics.consecutiveFailures >= options.crashLoopLimit) {
+            metrics.state = SUPERVISED_GAVE_UP;
+            metrics.backoffSeconds = 0.0;
+            report.gaveUp++;
+        } else {
+            uint32_t delay = GetSupervisorBackoffMs(options, metrics.consecutiveFailures);
+            metrics.state = SUPERVISED_BACKOFF;
+            metrics.backoffSeconds = delay / 1000.0;
+            state[index].restartAt = now + std::chrono::milliseconds(delay);
+        }
+        publish(index);
+    };
+
+    auto startProgram = [&](size_t index) {
+        SupervisedProgram& program = state[index];
+        SupervisedProgramMetrics& metrics = program.metrics;
+        const CaptureLaunch& launch = programs[index];
+        if (metrics.state != SUPERVISED_STARTING) {
+            metrics.restarts++;
+            report.restarts++;
+        }
+
+        // Divalidasi ulang setiap start: file dapat diganti selama program berjalan
+        ValidatedExecutable validated;
+        metrics.validation = ValidateExecutable(launch.path, validated);
+        metrics.lastErrorCode = 0;
+        if (metrics.validation != VALIDATION_OK) {
+            scheduleRestart(index, 0.0, Clock::now());
+            return;
+        }
+        metrics.path = validated.path;
+
+        OsHandle token = OS_INVALID_HANDLE;
+        if (options.tokens) {
+            token = options.tokens->Acquire();
+            if (token == OS_INVALID_HANDLE) {
+                metrics.lastErrorCode = GetProcessBackend()->GetLastErrorCode();
+            }
+        } else {
+            metrics.lastErrorCode = OS_ERROR_INVALID_PARAMETER;
+        }
+
+        uint32_t processId = 0;
+        if (token != OS_INVALID_HANDLE) {
+            ProcessLaunchRequest request = BuildLaunchRequest(validated, launch.arguments, options.creationFlags,
+                                                              options.console);
+            program.process = backend->StartCapturedProcess(port, token, request, processId);
+            if (program.process == OS_INVALID_HANDLE) {
+                // Token mungkin tidak lagi valid: restart berikutnya mengakuisisi ulang
+                metrics.lastErrorCode = backend->GetLastErrorCode();
+                options.tokens->Invalidate();
+            }
+        }
+        if (program.process == OS_INVALID_HANDLE) {
+            scheduleRestart(index, 0.0, Clock::now());
+            return;
+        }
+
+        program.streamOpen[0] = program.streamOpen[1] = true;
+        program.exited = false;
+        program.runStarted = Clock::now();
+        metrics.state = SUPERVISED_RUNNING;
+        metrics.processId = processId;
+        metrics.starts++;
+        metrics.backoffSeconds = 0.0;
+        report.starts++;
+        publish(index);
+    };
+
+    // Proses keluar dan pipe selesai di-drain: tutup handle lalu jadwalkan restart
+    auto finishRun = [&](size_t index, Clock::time_point now) {
+        SupervisedProgram& program = state[index];
+        double runSeconds = SecondsBetween(program.runStarted, program.exitSeen);
+        backend->CloseCapturedProcess(program.process);
+        program.process = OS_INVALID_HANDLE;
+        program.metrics.lastRunSeconds = runSeconds;
+        program.metrics.totalUptimeSeconds += runSeconds;
+        scheduleRestart(index, runSeconds, now);
+    };
+
+    for (size_t i = 0; i < state.size(); i++) {
+        startProgram(i);
+    }
+
+    while (report.gaveUp < state.size()) {
+        if (options.cancel && options.cancel->load()) {
+            report.cancelled = true;
+            break;
+        }
+
+        // Timeout tunggu = deadline terdekat; tanpa deadline pump menunggu event berikutnya
+        Clock::time_point now = Clock::now();
+        uint64_t wait = options.cancel ? SUPERVISOR_CANCEL_CHECK_MS : WAIT_FOREVER;
+        for (const SupervisedProgram& program : state) {
+            if (program.metrics.state == SUPERVISED_BACKOFF) {
+                wait = std::min(wait, MillisecondsBetween(now, program.restartAt));
+            } else if (program.process != OS_INVALID_HANDLE && program.exited) {
+                Clock::time_point drainEnd = program.exitSeen + std::chrono::milliseconds(CAPTURE_DRAIN_TIMEOUT_MS);
+                wait = std::min(wait, MillisecondsBetween(now, drainEnd));
+            } else if (program.process != OS_INVALID_HANDLE && !program.streamOpen[0] && !program.streamOpen[1]) {
+                // Pipe tertutup sebelum proses keluar dan notifikasi job mungkin tidak ada
+                wait = std::min<uint64_t>(wait, CAPTURE_EXIT_CHECK_MS);
+            }
+        }
+
+        CaptureEvent event;
+        if (backend->WaitCaptureEvent(port, static_cast<uint32_t>(wait), event)) {
+            report.events++;
+            for (size_t i = 0; i < state.size(); i++) {
+                SupervisedProgram& program = state[i];
+                if (program.process != event.process || program.process == OS_INVALID_HANDLE) {
+                    continue;
+                }
+                if (event.type == CAPTURE_EVENT_OUTPUT) {
+                    if (output) {
+                        output(i, event.stream, std::string_view(event.data, event.size));
+                    }
+                } else if (event.type == CAPTURE_EVENT_END_OF_STREAM) {
+                    program.streamOpen[event.stream] = false;
+                } else if (!program.exited && backend->QueryCapturedExit(program.process, program.metrics.lastExitCode)) {
+                    program.exited = true;
+                    program.exitSeen = Clock::now();
+                }
+                break;
+            }
+        } else if (backend->GetLastErrorCode() != OS_ERROR_WAIT_TIMEOUT) {
+            report.errorCode = backend->GetLastErrorCode();
+            break;
+        }
+
+        now = Clock::now();
+        for (size_t i = 0; i < state.size(); i++) {
+            SupervisedProgram& program = state[i];
+            if (program.process != OS_INVALID_HANDLE) {
+                bool streamsClosed = !program.streamOpen[0] && !program.streamOpen[1];
+                // Cadangan tanpa notifikasi job: exit dicek langsung setelah kedua pipe tertutup
+                if (!program.exited && streamsClosed &&
+                    backend->QueryCapturedExit(program.process, program.metrics.lastExitCode)) {
+                    program.exited = true;
+                    program.exitSeen = now;
+                }
+                if (program.exited &&
+                    (streamsClosed || MillisecondsBetween(program.exitSeen, now) >= CAPTURE_DRAIN_TIMEOUT_MS)) {
+                    finishRun(i, now);
+                }
+            } else if (program.metrics.state == SUPERVISED_BACKOFF && now >= program.restartAt) {
+                startProgram(i);
+            }
+        }
+    }
+
+    // Berhenti: proses yang masih berjalan di-terminate beserta turunannya
+    Clock::time_point stopped = Clock::now();
+    for (size_t i = 0; i < state.size(); i++) {
+        SupervisedProgram& program = state[i];
+        if (program.process != OS_INVALID_HANDLE) {
+            backend->CloseCapturedProcess(program.process);
+            program.process = OS_INVALID_HANDLE;
+            program.metrics.lastRunSeconds = SecondsBetween(program.runStarted, stopped);
+            program.metrics.totalUptimeSeconds += program.metrics.lastRunSeconds;
+        }
+        if (program.metrics.state != SUPERVISED_GAVE_UP) {
+            program.metrics.state = SUPERVISED_STOPPED;
+            program.metrics.backoffSeconds = 0.0;
+            publish(i);
+        }
+        report.programs.push_back(program.metrics);
+    }
+
+    backend->CloseCapturePort(port);
+    report.seconds = SecondsBetween(started, Clock::now());
+    return report.cancelled && report.gaveUp == 0 && report.errorCode == 0;
+}
+
+//==============================================================================
+// REPORT
+//==============================================================================
+
+std::string FormatSupervisorReport(const SupervisorReport& report)
+{
+    std::string text = FormatSupervisorMetrics(report.programs);
+    char line[256];
+
+    snprintf(line, sizeof(line), "%llu programs, %llu starts, %llu restarts, %llu gave up, %.3f s%s\n",
+             static_cast<unsigned long long>(report.programs.size()),
+             static_cast<unsigned long long>(report.starts),
+             static_cast<unsigned long long>(report.restarts),
+             static_cast<unsigned long long>(report.gaveUp), report.seconds,
+             report.cancelled ? ", stopped by cancel" : "");
+    text += line;
+    if (report.errorCode != 0) {
+        snprintf(line, sizeof(line), "Supervisor stopped: capture pump failed (error %u)\n",
+                 static_cast<unsigned>(report.errorCode));
+        text += line;
+    }
+    return text;
+}
@@ -0,0 +1,132 @@
+/**
+ * @file TextEncoding.cpp
+ * @brief Implementasi konversi UTF-8 <-> wide string
+ *
+ * @author RasTI Development Team
+ * @version 1.2.0.0
+ * @date 2025
+ */
+
+#include "TextEncoding.h"
+#include <cstdint>
+#include <cstdio>
+
+//==============================================================================
+// UTF-8 DECODING
+//==============================================================================
+
+bool DecodeUtf8(std::string_view text, std::wstring& decoded)
+{
+    decoded.clear();
+    decoded.reserve(text.size());
+
+    size_t i = 0;
+    while (i < text.size()) {
+        uint8_t lead = static_cast<uint8_t>(text[i]);
+        uint32_t codePoint;
+        size_t length;
+
+        if (lead < 0x80)                { codePoint = lead;        length = 1; }
+        else if ((lead & 0xE0) == 0xC0) { codePoint = lead & 0x1F; length = 2; }
+        else if ((lead & 0xF0) == 0xE0) { codePoint = lead & 0x0F; length = 3; }
+        else if ((lead & 0xF8) == 0xF0) { codePoint = lead & 0x07; length = 4; }
+        else return false;
+
+        if (i + length > text.size()) return false;
+        for (size_t k = 1; k < length; k++) {
+            uint8_t next = static_cast<uint8_t>(text[i + k]);
+            if ((next & 0xC0) != 0x80) return false;
+            codePoint = (codePoint << 6) | (next & 0x3F);
+        }
+        i += length;
+
+        // Tolak overlong encoding, surrogate, dan nilai di luar Unicode
+        static const uint32_t minimum[5] = { 0, 0, 0x80, 0x800, 0x10000 };
+        if (codePoint < minimum[length] || codePoint > 0x10FFFF ||
+            (codePoint >= 0xD800 && codePoint <= 0xDFFF)) {
+            return false;
+        }
+
+        if (sizeof(wchar_t) == 2 && codePoint >= 0x10000) {
+            codePoint -= 0x10000;
+            decoded.push_back(static_cast<wchar_t>(0xD800 + (codePoint >> 10)));
+            decoded.push_back(static_cast<wchar_t>(0xDC00 + (codePoint & 0x3FF)));
+        } else {
+            decoded.push_back(static_cast<wchar_t>(codePoint));
+        }
+    }
+    return true;
+}
+
+//==============================================================================
+// UTF-8 ENCODING
+//==============================================================================
+
+void AppendUtf8(std::wstring_view text, std::string& output)
+{
+    output.reserve(output.size() + text.size());
+
+    for (size_t i = 0; i < text.size(); i++) {
+        uint32_t codePoint = static_cast<uint32_t>(text[i]);
+
+        if (sizeof(wchar_t) == 2 && codePoint >= 0xD800 && codePoint <= 0xDFFF) {
+            // Gabungkan surrogate pair UTF-16; surrogate tunggal diganti U+FFFD
+            uint32_t low = (i + 1 < text.size()) ? static_cast<uint32_t>(text[i + 1]) : 0;
+            if (codePoint <= 0xDBFF && low >= 0xDC00 && low <= 0xDFFF) {
+                codePoint = 0x10000 + ((codePoint - 0xD800) << 10) + (low - 0xDC00);
+                i++;
+            } else {
+                codePoint = 0xFFFD;
+            }
+        } else if (codePoint > 0x10FFFF || (codePoint >= 0xD800 && codePoint <= 0xDFFF)) {
+            codePoint = 0xFFFD;
+        }
+
+        if (codePoint < 0x80) {
+            output.push_back(static_cast<char>(codePoint));
+        } else if (codePoint < 0x800) {
+            output.push_back(static_cast<char>(0xC0 | (codePoint >> 6)));
+            output.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+        } else if (codePoint < 0x10000) {
+            output.push_back(static_cast<char>(0xE0 | (codePoint >> 12)));
+            output.push_back(static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F)));
+            output.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+        } else {
+            output.push_back(static_cast<char>(0xF0 | (codePoint >> 18)));
+            output.push_back(static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F)));
+            output.push_back(static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F)));
+            output.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+        }
+    }
+}
+
+//==============================================================================
+// JSON STRING
+//==============================================================================
+
+void AppendJsonString(std::wstring_view value, std::string& line)
+{
+    std::string utf8;
+    AppendUtf8(value, utf8);
+
+    line.push_back('"');
+    for (char ch : utf8) {
+        switch (ch)
+        {
+        case '"':  line += "\\\""; break;
+        case '\\': line += "\\\\"; break;
+        case '\n': line += "\\n"; break;
+        case '\r': line += "\\r"; break;
+        case '\t': line += "\\t"; break;
+        default:
+            if (static_cast<unsigned char>(ch) < 0x20) {
+                char escaped[8];
+                snprintf(escaped, sizeof(escaped), "\\u%04x", static_cast<unsigned>(ch));
+                line += escaped;
+            } else {
+                line.push_back(ch);
+            }
+        }
+    }
+    line.push_back('"');
+}
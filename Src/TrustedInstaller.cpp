@@ -0,0 +1,757 @@
+/**
+ * @file TrustedInstaller.cpp
+ * @brief Implementasi akuisisi token Trusted Installer di atas IProcessBackend
+ *
+ * Semua panggilan OS melewati GetProcessBackend(), sehingga file ini portable
+ * dan urutan langkahnya dapat diverifikasi dengan backend palsu.
+ *
+ * @author RasTI Development Team
+ * @version 1.2.0.0
+ * @date 2025
+ */
+
+#include "TrustedInstaller.h"
+#include "LaunchPipeline.h"
+#include <memory>
+
+//==============================================================================
+// PRIVILEGES
+//==============================================================================
+
+bool EnableSupportedPrivilege(bool impersonating, int privilege)
+{
+    // SECURITY: Validasi privilege value - hanya izinkan privilege yang diketahui aman
+    // Ini mencegah abuse dengan privilege arbitrer yang berpotensi berbahaya
+    switch (privilege) {
+    case SE_TCB_PRIVILEGE:         // Trusted Computing Base - akses sistem terbatas
+    case SE_DEBUG_PRIVILEGE:       // Debug privilege - akses process debugging
+    case SE_IMPERSONATE_PRIVILEGE: // Impersonation - meniru security context lain
+    case SE_ASSIGNPRIMARYTOKEN_PRIVILEGE: // Assign primary token/quota - CreateProcessAsUserW
+    case SE_INCREASE_QUOTA_PRIVILEGE:
+    case SE_BACKUP_PRIVILEGE:      // Backup/restore/take ownership - owner dan DACL (/aclreset)
+    case SE_RESTORE_PRIVILEGE:
+    case SE_TAKE_OWNERSHIP_PRIVILEGE:
+        break;
+    default:
+        return false; // Privilege tidak dikenal atau berbahaya - tolak
+    }
+
+    return GetProcessBackend()->AdjustPrivilege(privilege, impersonating);
+}
+
+bool ImpersonateSystemToken()
+{
+    IProcessBackend* ps = GetProcessBackend();
+
+    // STEP 1: Cari winlogon.exe (selalu berjalan sebagai LocalSystem)
+    uint32_t processId = 0;
+    if (!ps->FindProcessByName(SYSTEM_TOKEN_SOURCE_PROCESS, processId) || processId == 0) {
+        return false;
+    }
+
+    // STEP 2: Ambil token proses tersebut (memerlukan SeDebugPrivilege)
+    ScopedBackendObject token(ps, ps->OpenProcessToken(processId));
+    if (!token.IsValid()) {
+        return false;
+    }
+
+    // STEP 3: Thread ini sekarang berjalan dengan LocalSystem privileges
+    return ps->ImpersonateToken(token.Get());
+}
+
+//==============================================================================
+// TOKEN ACQUISITION
+//==============================================================================
+
+OsHandle AcquireTrustedInstallerToken()
+{
+    IProcessBackend* ps = GetProcessBackend();
+    bool impersonating = false;
+    OsHandle token = OS_INVALID_HANDLE;
+
+    do {
+        // STEP 1: Pastikan kita memiliki TCB privilege - langsung, atau melalui
+        // SeDebugPrivilege + impersonation winlogon.exe sebagai fallback
+        if (!EnableSupportedPrivilege(false, SeTcbPrivilege)) {
+            if (!EnableSupportedPrivilege(false, SeDebugPrivilege)) {
+                break;
+            }
+
+            impersonating = ImpersonateSystemToken();
+            if (!impersonating || !EnableSupportedPrivilege(true, SeTcbPrivilege)) {
+                break;
+            }
+        }
+
+        // STEP 2: Logon SYSTEM dengan group Trusted Installer
+        token = ps->LogonTrustedInstaller(impersonating);
+    } while (false);
+
+    // Pertahankan error tahap yang gagal melewati RevertToSelf
+    uint32_t error = ps->GetLastErrorCode();
+    if (impersonating) {
+        ps->RevertImpersonation(); // Kembali ke security context asli
+    }
+    ps->SetLastErrorCode(error);
+
+    return token;
+}
+
+//==============================================================================
+// CONSOLE MODE
+//==============================================================================
+
+/** @brief Nama mode, diindeks dengan ConsoleMode */
+static const char* const CONSOLE_MODE_NAMES[] = { "auto", "new", "inherit", "none", "hidden" };
+
+bool ParseConsoleMode(std::string_view name, ConsoleMode& mode)
+{
+    for (size_t i = 0; i < sizeof(CONSOLE_MODE_NAMES) / sizeof(CONSOLE_MODE_NAMES[0]); i++) {
+        std::string_view candidate(CONSOLE_MODE_NAMES[i]);
+        if (name.size() != candidate.size()) {
+            continue;
+        }
+        bool equal = true;
+        for (size_t j = 0; equal && j < name.size(); j++) {
+            char ch = name[j];
+            if (ch >= 'A' && ch <= 'Z') ch = ch - 'A' + 'a';
+            equal = (ch == candidate[j]);
+        }
+        if (equal) {
+            mode = static_cast<ConsoleMode>(i);
+            return true;
+        }
+    }
+    return false;
+}
+
+const char* GetConsoleModeName(ConsoleMode mode)
+{
+    if (mode < CONSOLE_MODE_AUTO || mode > CONSOLE_MODE_HIDDEN) {
+        return "unknown";
+    }
+    return CONSOLE_MODE_NAMES[mode];
+}
+
+ConsoleMode ResolveConsoleMode(ConsoleMode mode, const ValidatedExecutable& executable)
+{
+    if (mode != CONSOLE_MODE_AUTO) {
+        return mode;
+    }
+
+    // Image GUI tidak membuka console; CREATE_NEW_CONSOLE hanya membuang waktu
+    if (executable.kind == EXECUTABLE_KIND_PE_IMAGE && executable.image.subsystem == PROCESS_SUBSYSTEM_GUI) {
+        return CONSOLE_MODE_NONE;
+    }
+    return CONSOLE_MODE_NEW;
+}
+
+void ApplyConsoleMode(ConsoleMode mode, ProcessLaunchRequest& request)
+{
+    request.creationFlags &= ~(PROCESS_CREATE_NEW_CONSOLE | PROCESS_DETACHED);
+    request.startupFlags &= ~PROCESS_STARTF_USESHOWWINDOW;
+    request.showWindow = 0;
+
+    switch (mode) {
+    case CONSOLE_MODE_INHERIT:
+        break;
+    case CONSOLE_MODE_NONE:
+        request.creationFlags |= PROCESS_DETACHED;
+        break;
+    case CONSOLE_MODE_HIDDEN:
+        request.creationFlags |= PROCESS_CREATE_NEW_CONSOLE;
+        request.startupFlags |= PROCESS_STARTF_USESHOWWINDOW;
+        request.showWindow = PROCESS_SHOW_HIDDEN;
+        break;
+    default: // NEW, dan AUTO yang belum di-resolve
+        request.creationFlags |= PROCESS_CREATE_NEW_CONSOLE;
+        break;
+    }
+}
+
+//==============================================================================
+// LAUNCH API
+//==============================================================================
+
+/** @brief Nama API, diindeks dengan ProcessLaunchApi */
+static const char* const LAUNCH_API_NAMES[] = { "auto", "seclogon", "asuser" };
+
+bool ParseProcessLaunchApi(std::string_view name, ProcessLaunchApi& api)
+{
+    for (size_t i = 0; i < sizeof(LAUNCH_API_NAMES) / sizeof(LAUNCH_API_NAMES[0]); i++) {
+        std::string_view candidate(LAUNCH_API_NAMES[i]);
+        if (name.size() != candidate.size()) {
+            continue;
+        }
+        bool equal = true;
+        for (size_t j = 0; equal && j < name.size(); j++) {
+            char ch = name[j];
+            if (ch >= 'A' && ch <= 'Z') ch = ch - 'A' + 'a';
+            equal = (ch == candidate[j]);
+        }
+        if (equal) {
+            api = static_cast<ProcessLaunchApi>(i);
+            return true;
+        }
+    }
+    return false;
+}
+
+const char* GetProcessLaunchApiName(ProcessLaunchApi api)
+{
+    if (api < LAUNCH_API_AUTO || api >= LAUNCH_API_COUNT) {
+        return "unknown";
+    }
+    return LAUNCH_API_NAMES[api];
+}
+
+/** @brief Mengaktifkan privilege CreateProcessAsUserW di token proses atau thread */
+static bool EnableAsUserPrivileges(bool impersonating)
+{
+    return EnableSupportedPrivilege(impersonating, SE_ASSIGNPRIMARYTOKEN_PRIVILEGE) &&
+           EnableSupportedPrivilege(impersonating, SE_INCREASE_QUOTA_PRIVILEGE) &&
+           EnableSupportedPrivilege(impersonating, SE_TCB_PRIVILEGE);
+}
+
+OsHandle TrustedInstallerLauncher::OpenSystemToken(IProcessBackend* ps)
+{
+    // Sama seperti ImpersonateSystemToken, tetapi token disimpan untuk launch berikutnya
+    uint32_t processId = 0;
+    if (!EnableSupportedPrivilege(false, SE_DEBUG_PRIVILEGE) ||
+        !ps->FindProcessByName(SYSTEM_TOKEN_SOURCE_PROCESS, processId) || processId == 0) {
+        return OS_INVALID_HANDLE;
+    }
+    return ps->OpenProcessToken(processId);
+}
+
+bool TrustedInstallerLauncher::LaunchAsUser(IProcessBackend* ps, PrivilegeScope scope, OsHandle systemToken,
+                                            OsHandle token, const ProcessLaunchRequest& request,
+                                            uint32_t& processId, OsHandle* process)
+{
+    if (scope == SCOPE_PROCESS) {
+        return ps->CreateProcessAsUser(token, request, processId, process);
+    }
+
+    // SCOPE_SYSTEM_THREAD: privilege hanya ada di token winlogon.exe. Impersonation
+    // pemanggil (host C ABI, callback RunAsTrustedInstaller) dipulihkan setelahnya
+    OsHandle callerToken = OS_INVALID_HANDLE;
+    if (!ps->OpenThreadToken(callerToken)) {
+        return false;
+    }
+    if (!ps->ImpersonateToken(systemToken)) {
+        if (callerToken != OS_INVALID_HANDLE) {
+            uint32_t error = ps->GetLastErrorCode();
+            ps->CloseObject(callerToken);
+            ps->SetLastErrorCode(error);
+        }
+        return false;
+    }
+    bool success = EnableAsUserPrivileges(true) &&
+                   ps->CreateProcessAsUser(token, request, processId, process);
+
+    // Pertahankan error tahap yang gagal melewati RevertToSelf; jika token pemanggil
+    // tidak dapat dipasang ulang, thread tetap di-revert (jangan tertinggal sebagai SYSTEM)
+    uint32_t error = ps->GetLastErrorCode();
+    if (callerToken == OS_INVALID_HANDLE) {
+        ps->RevertImpersonation();
+    } else {
+        if (!ps->ImpersonateToken(callerToken)) {
+            ps->RevertImpersonation();
+        }
+        ps->CloseObject(callerToken);
+    }
+    ps->SetLastErrorCode(error);
+    return success;
+}
+
+bool TrustedInstallerLauncher::Launch(OsHandle token, const ProcessLaunchRequest& request, uint32_t* processId,
+                                      OsHandle* process, ProcessLaunchApi* usedApi)
+{
+    IProcessBackend* ps = GetProcessBackend();
+    ProcessLaunchApi api;
+    PrivilegeScope scope;
+    OsHandle systemToken = OS_INVALID_HANDLE;
+
+    // Probe hanya di bawah lock; launch sendiri berjalan paralel
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (backend_ != ps) {
+            ResetLocked();
+            backend_ = ps;
+        }
+        api = api_;
+        if (api != LAUNCH_API_SECLOGON && scope_ == SCOPE_UNKNOWN) {
+            // Privilege proses yang sudah aktif tetap aktif untuk launch berikutnya
+            scope_ = EnableAsUserPrivileges(false) ? SCOPE_PROCESS : SCOPE_SYSTEM_THREAD;
+        }
+        if (api != LAUNCH_API_SECLOGON && scope_ == SCOPE_SYSTEM_THREAD) {
+            if (systemToken_ == OS_INVALID_HANDLE) {
+                systemToken_ = OpenSystemToken(ps);
+            }
+            if (systemToken_ == OS_INVALID_HANDLE) {
+                scope_ = SCOPE_UNAVAILABLE;
+            }
+            systemToken = systemToken_;
+        }
+        scope = scope_;
+    }
+
+    uint32_t newProcessId = 0;
+    bool attempted = (api != LAUNCH_API_SECLOGON && scope != SCOPE_UNAVAILABLE);
+    bool success = attempted && LaunchAsUser(ps, scope, systemToken, token, request, newProcessId, process);
+    ProcessLaunchApi used = LAUNCH_API_AS_USER;
+
+    if (!success && api == LAUNCH_API_AS_USER) {
+        if (!attempted) {
+            ps->SetLastErrorCode(OS_ERROR_PRIVILEGE_NOT_HELD);
+        }
+        return false;
+    }
+
+    if (!success) {
+        success = ps->CreateProcessWithToken(token, request, newProcessId, process);
+        used = LAUNCH_API_SECLOGON;
+
+        // CreateProcessAsUserW gagal tetapi seclogon berhasil: jalur cepat tidak
+        // tersedia di host ini - jangan probe ulang di setiap launch. Token
+        // winlogon.exe tetap terbuka sampai Reset: launch lain yang sudah
+        // menyalinnya mungkin sedang meng-impersonate handle tersebut
+        if (success && attempted) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (backend_ == ps && scope_ == scope) {
+                scope_ = SCOPE_UNAVAILABLE;
+            }
+        }
+    }
+
+    if (success) {
+        if (processId) {
+            *processId = newProcessId;
+        }
+        if (usedApi) {
+            *usedApi = used;
+        }
+    }
+    return success;
+}
+
+ProcessLaunchApi TrustedInstallerLauncher::GetSelectedApi() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (api_ != LAUNCH_API_AUTO) {
+        return api_;
+    }
+    switch (scope_) {
+    case SCOPE_PROCESS:
+    case SCOPE_SYSTEM_THREAD:
+        return LAUNCH_API_AS_USER;
+    case SCOPE_UNAVAILABLE:
+        return LAUNCH_API_SECLOGON;
+    default:
+        return LAUNCH_API_AUTO;
+    }
+}
+
+void TrustedInstallerLauncher::ResetLocked()
+{
+    if (systemToken_ != OS_INVALID_HANDLE) {
+        backend_->CloseObject(systemToken_);
+        systemToken_ = OS_INVALID_HANDLE;
+    }
+    scope_ = SCOPE_UNKNOWN;
+    backend_ = NULL;
+}
+
+void TrustedInstallerLauncher::Reset()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    ResetLocked();
+}
+
+//==============================================================================
+// LAUNCH
+//==============================================================================
+
+bool LaunchWithTrustedInstaller(const std::wstring& applicationName,
+                                const std::wstring& commandLine, uint32_t priority,
+                                ConsoleMode console, ProcessLaunchApi api, ProcessLaunchApi* usedApi,
+                                const LaunchPipeline* pipeline, LaunchPipelineResult* pipelineResult)
+{
+    IProcessBackend* ps = GetProcessBackend();
+
+    // STEP 1: SeImpersonatePrivilege diperlukan untuk CreateProcessWithTokenW
+    if (!EnableSupportedPrivilege(false, SeImpersonatePrivilege)) {
+        return false;
+    }
+
+    // STEP 2: Dapatkan Trusted Installer token
+    ScopedBackendObject token(ps, AcquireTrustedInstallerToken());
+    if (!token.IsValid()) {
+        return false;
+    }
+
+    // STEP 3: Buat proses dengan token TI (default di console baru)
+    TrustedInstallerLauncher launcher(api);
+    bool success = LaunchWithToken(token.Get(), applicationName, commandLine, priority, NULL, NULL, console,
+                                   &launcher, usedApi, pipeline, pipelineResult);
+
+    // Pertahankan error code launch melewati CloseHandle token dan token winlogon.exe
+    uint32_t error = ps->GetLastErrorCode();
+    launcher.Reset();
+    token.Reset();
+    ps->SetLastErrorCode(error);
+    return success;
+}
+
+bool LaunchWithToken(OsHandle token, const std::wstring& applicationName,
+                     const std::wstring& commandLine, uint32_t priority, uint32_t* processId,
+                     OsHandle* process, ConsoleMode console, TrustedInstallerLauncher* launcher,
+                     ProcessLaunchApi* usedApi, const LaunchPipeline* pipeline,
+                     LaunchPipelineResult* pipelineResult)
+{
+    ProcessLaunchRequest request;
+    request.applicationName = applicationName;
+    request.commandLine = commandLine;
+    request.creationFlags = priority;
+    ApplyConsoleMode(console, request);
+
+    // Pipeline kosong = launch langsung, tanpa CREATE_SUSPENDED dan resume
+    bool staged = pipeline && !pipeline->IsEmpty();
+    if (launcher) {
+        return staged ? pipeline->Launch(*launcher, token, request, processId, process, usedApi, pipelineResult)
+                      : launcher->Launch(token, request, processId, process, usedApi);
+    }
+
+    IProcessBackend* ps = GetProcessBackend();
+    TrustedInstallerLauncher local;
+    bool success = staged ? pipeline->Launch(local, token, request, processId, process, usedApi, pipelineResult)
+                          : local.Launch(token, request, processId, process, usedApi);
+
+    // Pertahankan error code launch melewati penutupan token winlogon.exe
+    uint32_t error = ps->GetLastErrorCode();
+    local.Reset();
+    ps->SetLastErrorCode(error);
+    return success;
+}
+
+bool LaunchValidatedExecutable(const ValidatedExecutable& executable, uint32_t priority,
+                               ConsoleMode console, ProcessLaunchApi api, ProcessLaunchApi* usedApi,
+                               const LaunchPipeline* pipeline, LaunchPipelineResult* pipelineResult)
+{
+    // SECURITY: Tanpa handle terbuka, tidak ada jaminan file masih sama
+    if (!executable.file.IsValid() || executable.path.empty()) {
+        GetProcessBackend()->SetLastErrorCode(OS_ERROR_INVALID_HANDLE);
+        return false;
+    }
+
+    // Quote path agar path dengan spasi tidak dipecah menjadi argumen
+    std::wstring commandLine = L"\"" + executable.path + L"\"";
+
+    // Script (.bat/.cmd) dijalankan melalui command line - CreateProcess
+    // memilih cmd.exe sendiri; PE image langsung lewat lpApplicationName
+    // Path >= MAX_PATH diberikan dengan prefix "\\?\"; argv[0] tetap path asli
+    std::wstring applicationName;
+    if (executable.kind == EXECUTABLE_KIND_PE_IMAGE) {
+        applicationName = ToExtendedLengthPath(executable.path);
+    }
+
+    return LaunchWithTrustedInstaller(applicationName, commandLine, priority,
+                                      ResolveConsoleMode(console, executable), api, usedApi, pipeline,
+                                      pipelineResult);
+}
+
+/** @brief Argumen PE mengikuti aturan CommandLineToArgvW (backslash sebelum kutip digandakan) */
+static void AppendProgramArgument(std::wstring_view argument, std::wstring& commandLine)
+{
+    if (!argument.empty() && argument.find_first_of(L" \t\"") == std::wstring_view::npos) {
+        commandLine += argument;
+        return;
+    }
+
+    commandLine += L'"';
+    size_t backslashes = 0;
+    for (wchar_t ch : argument) {
+        if (ch == L'\\') {
+            backslashes++;
+            continue;
+        }
+        commandLine.append(ch == L'"' ? backslashes * 2 + 1 : backslashes, L'\\');
+        backslashes = 0;
+        commandLine += ch;
+    }
+    commandLine.append(backslashes * 2, L'\\');
+    commandLine += L'"';
+}
+
+/** @brief Argumen script diberi kutip hanya jika berisi pemisah/operator cmd */
+static void AppendScriptArgument(std::wstring_view argument, std::wstring& commandLine)
+{
+    bool quote = argument.empty() || argument.find_first_of(L" \t&|<>(),;=") != std::wstring_view::npos;
+    if (quote) commandLine += L'"';
+    commandLine += argument;
+    if (quote) commandLine += L'"';
+}
+
+ProcessLaunchRequest BuildValidatedLaunchRequest(const ValidatedExecutable& executable,
+                                                 const std::vector<std::wstring>& arguments,
+                                                 uint32_t creationFlags)
+{
+    ProcessLaunchRequest request;
+    if (executable.kind == EXECUTABLE_KIND_PE_IMAGE) {
+        request.applicationName = ToExtendedLengthPath(executable.path);
+    }
+    request.commandLine = L"\"" + executable.path + L"\"";
+    for (const std::wstring& argument : arguments) {
+        request.commandLine += L' ';
+        if (executable.kind == EXECUTABLE_KIND_SCRIPT) {
+            AppendScriptArgument(argument, request.commandLine);
+        } else {
+            AppendProgramArgument(argument, request.commandLine);
+        }
+    }
+    request.creationFlags = creationFlags;
+    return request;
+}
+
+//==============================================================================
+// PRIVILEGE CHECKING
+//==============================================================================
+
+bool HasElevatedPrivileges()
+{
+    IProcessBackend* ps = GetProcessBackend();
+
+    // TCB privilege menunjukkan proses sudah berjalan sebagai Trusted Installer
+    if (ps->IsPrivilegeEnabled(SE_TCB_PRIVILEGE)) {
+        return true;
+    }
+
+    // Admin tradisional: member Administrators DAN token elevated (UAC)
+    return ps->IsElevatedAdministrator();
+}
+
+//==============================================================================
+// TOKEN CACHE
+//==============================================================================
+
+OsHandle TrustedInstallerTokenCache::Acquire(bool* cacheHit)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (cacheHit) {
+        *cacheHit = (token_ != OS_INVALID_HANDLE);
+    }
+    if (token_ == OS_INVALID_HANDLE) {
+        token_ = AcquireTrustedInstallerToken();
+        backend_ = GetProcessBackend();
+    }
+    return token_;
+}
+
+void TrustedInstallerTokenCache::Invalidate()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (token_ != OS_INVALID_HANDLE) {
+        backend_->CloseObject(token_);
+        token_ = OS_INVALID_HANDLE;
+    }
+    backend_ = NULL;
+}
+
+bool TrustedInstallerTokenCache::HasToken() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return token_ != OS_INVALID_HANDLE;
+}
+
+//==============================================================================
+// IN-PROCESS EXECUTION
+//==============================================================================
+
+TrustedInstallerWorker::TrustedInstallerWorker(TrustedInstallerTokenCache& cache)
+    : cache_(cache), stopping_(false), impersonated_(OS_INVALID_HANDLE), workerId_(std::thread::id())
+{
+    thread_ = std::thread(&TrustedInstallerWorker::WorkerLoop, this);
+}
+
+TrustedInstallerWorker::~TrustedInstallerWorker()
+{
+    Stop();
+}
+
+void TrustedInstallerWorker::Stop()
+{
+    // Dari callback worker (Shutdown di dalam callback): pemanggil segera menutup
+    // token cache, jadi sisa antrian dibatalkan agar tidak mengakuisisi token baru
+    bool onWorker = (std::this_thread::get_id() == workerId_.load());
+    std::deque<Task> aborted;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+        if (onWorker) {
+            aborted.swap(queue_);
+        }
+    }
+    for (Task& task : aborted) {
+        task.done.set_value(OS_ERROR_OPERATION_ABORTED);
+    }
+    wake_.notify_one();
+    // Thread worker tidak dapat join dirinya sendiri; destructor di thread lain yang join
+    if (thread_.joinable() && !onWorker) {
+        thread_.join();
+    }
+}
+
+std::future<uint32_t> TrustedInstallerWorker::Submit(std::function<void()> callback)
+{
+    Task task;
+    task.callback = std::move(callback);
+    std::future<uint32_t> done = task.done.get_future();
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (stopping_) {
+            task.done.set_value(OS_ERROR_OPERATION_ABORTED);
+            return done;
+        }
+        queue_.push_back(std::move(task));
+    }
+    wake_.notify_one();
+    return done;
+}
+
+bool TrustedInstallerWorker::Run(const std::function<void()>& callback)
+{
+    // Callback worker yang memanggil Run lagi: thread ini sudah impersonating
+    if (std::this_thread::get_id() == workerId_.load()) {
+        callback();
+        return true;
+    }
+
+    uint32_t error = Submit(callback).get(); // Exception callback dilempar ulang di sini
+    if (error != 0) {
+        GetProcessBackend()->SetLastErrorCode(error);
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Memastikan thread worker meng-impersonate token cache saat ini
+ *
+ * @return 0 jika siap, atau kode error tahap yang gagal
+ */
+uint32_t TrustedInstallerWorker::PrepareToken()
+{
+    IProcessBackend* ps = GetProcessBackend();
+
+    // Cache hit hanya mengambil mutex; token baru (setelah Invalidate)
+    // diakuisisi dari konteks proses lalu di-impersonate ulang
+    if (impersonated_ != OS_INVALID_HANDLE && !cache_.HasToken()) {
+        ps->RevertImpersonation();
+        impersonated_ = OS_INVALID_HANDLE;
+    }
+    if (impersonated_ == OS_INVALID_HANDLE && !EnableSupportedPrivilege(false, SeImpersonatePrivilege)) {
+        uint32_t error = ps->GetLastErrorCode();
+        return error != 0 ? error : OS_ERROR_PRIVILEGE_NOT_HELD;
+    }
+
+    bool cacheHit = false;
+    OsHandle token = cache_.Acquire(&cacheHit);
+    if (!cacheHit) {
+        // Rantai akuisisi di host impersonation sudah revert thread ini, dan
+        // nilai handle token baru dapat sama dengan token lama yang ditutup
+        impersonated_ = OS_INVALID_HANDLE;
+    }
+    if (token == OS_INVALID_HANDLE) {
+        uint32_t error = ps->GetLastErrorCode();
+        return error != 0 ? error : OS_ERROR_PRIVILEGE_NOT_HELD;
+    }
+    if (token == impersonated_) {
+        return 0;
+    }
+
+    if (!ps->ImpersonateToken(token)) {
+        uint32_t error = ps->GetLastErrorCode();
+        impersonated_ = OS_INVALID_HANDLE;
+        return error != 0 ? error : OS_ERROR_INVALID_HANDLE;
+    }
+    impersonated_ = token;
+    return 0;
+}
+
+void TrustedInstallerWorker::WorkerLoop()
+{
+    workerId_.store(std::this_thread::get_id());
+    for (;;) {
+        Task task;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            wake_.wait(lock, [this] { return stopping_ || !queue_.empty(); });
+            if (queue_.empty()) {
+                break; // Berhenti setelah antrian habis
+            }
+            task = std::move(queue_.front());
+            queue_.pop_front();
+        }
+
+        uint32_t error = PrepareToken();
+        if (error != 0) {
+            task.done.set_value(error);
+            continue;
+        }
+
+        try {
+            task.callback();
+            task.done.set_value(0);
+        } catch (...) {
+            task.done.set_exception(std::current_exception());
+        }
+    }
+
+    if (impersonated_ != OS_INVALID_HANDLE) {
+        GetProcessBackend()->RevertImpersonation();
+        impersonated_ = OS_INVALID_HANDLE;
+    }
+}
+
+/** @brief Worker dan cache bersama (sengaja tidak dihancurkan saat exit) */
+static std::mutex gSharedWorkerMutex;
+static TrustedInstallerTokenCache* gSharedTokenCache = NULL;
+static std::shared_ptr<TrustedInstallerWorker>* gSharedWorker = NULL;
+
+bool RunAsTrustedInstaller(const std::function<void()>& callback)
+{
+    // Pemanggil memegang referensi sendiri sehingga Shutdown yang berjalan
+    // bersamaan tidak menghancurkan worker di tengah Run
+    std::shared_ptr<TrustedInstallerWorker> worker;
+    {
+        std::lock_guard<std::mutex> lock(gSharedWorkerMutex);
+        if (!gSharedTokenCache) {
+            gSharedTokenCache = new TrustedInstallerTokenCache();
+            gSharedWorker = new std::shared_ptr<TrustedInstallerWorker>();
+        }
+        if (!*gSharedWorker) {
+            gSharedWorker->reset(new TrustedInstallerWorker(*gSharedTokenCache));
+        }
+        worker = *gSharedWorker;
+    }
+    return worker->Run(callback);
+}
+
+void ShutdownTrustedInstallerWorker()
+{
+    std::shared_ptr<TrustedInstallerWorker> worker;
+    {
+        std::lock_guard<std::mutex> lock(gSharedWorkerMutex);
+        if (!gSharedWorker) {
+            return;
+        }
+        worker.swap(*gSharedWorker);
+    }
+
+    // Menjalankan sisa antrian dan revert sebelum token ditutup (kecuali dipanggil
+    // dari callback worker: sisa antrian dibatalkan, worker di-join setelah callback kembali)
+    if (worker) {
+        worker->Stop();
+    }
+    gSharedTokenCache->Invalidate();
+}
@@ -0,0 +1,707 @@
+/**
+ * @file Validation.cpp
+ * @brief Implementasi pipeline validasi executable berbasis satu handle
+ *
+ * Semua akses filesystem dilakukan melalui IFileSystemBackend sehingga
+ * jumlah syscall per validasi dapat diukur dan diuji di unit test.
+ *
+ * @author RasTI Development Team
+ * @version 1.2.0.0
+ * @date 2025
+ */
+
+#include "Validation.h"
+#include "HashAllowlist.h"
+#include <vector>
+
+//==============================================================================
+// PE FORMAT CONSTANTS
+//==============================================================================
+
+/** @brief Offset e_lfanew di IMAGE_DOS_HEADER */
+static const size_t DOS_LFANEW_OFFSET = 0x3C;
+
+/** @brief Ukuran IMAGE_FILE_HEADER + signature "PE\0\0" */
+static const size_t NT_FILE_HEADER_END = 24;
+
+/** @brief Offset field Subsystem di optional header (sama untuk PE32 dan PE32+) */
+static const size_t OPTIONAL_SUBSYSTEM_OFFSET = 68;
+
+/** @brief Bytes minimum dari awal NT headers untuk membaca field Subsystem */
+static const size_t NT_HEADERS_MIN_SIZE = NT_FILE_HEADER_END + OPTIONAL_SUBSYSTEM_OFFSET + 2;
+
+/** @brief Batas wajar e_lfanew - nilai lebih besar dianggap header rusak */
+static const uint32_t MAX_NT_HEADER_OFFSET = 16 * 1024 * 1024;
+
+static const uint16_t IMAGE_FILE_EXECUTABLE_IMAGE_FLAG = 0x0002;
+static const uint16_t IMAGE_FILE_DLL_FLAG = 0x2000;
+static const uint16_t PE32_MAGIC = 0x10B;
+static const uint16_t PE32_PLUS_MAGIC = 0x20B;
+
+//==============================================================================
+// INTERNAL HELPERS
+//==============================================================================
+
+static uint16_t ReadLe16(const uint8_t* p)
+{
+    return static_cast<uint16_t>(p[0] | (p[1] << 8));
+}
+
+static uint32_t ReadLe32(const uint8_t* p)
+{
+    return static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8) |
+           (static_cast<uint32_t>(p[2]) << 16) | (static_cast<uint32_t>(p[3]) << 24);
+}
+
+static bool IsPathSeparator(wchar_t ch)
+{
+    return ch == L'\\' || ch == L'/';
+}
+
+static wchar_t ToLowerAscii(wchar_t ch)
+{
+    return (ch >= L'A' && ch <= L'Z') ? static_cast<wchar_t>(ch - L'A' + L'a') : ch;
+}
+
+/**
+ * @brief Mengambil nama file (komponen terakhir) dari path
+ */
+static std::wstring_view GetFileNamePart(std::wstring_view path)
+{
+    size_t pos = path.find_last_of(L"\\/");
+    return (pos == std::wstring_view::npos) ? path : path.substr(pos + 1);
+}
+
+/**
+ * @brief Mengambil extension (termasuk titik) dari nama file, kosong jika tidak ada
+ */
+static std::wstring_view GetExtensionPart(std::wstring_view path)
+{
+    std::wstring_view name = GetFileNamePart(path);
+    size_t pos = name.find_last_of(L'.');
+    return (pos == std::wstring_view::npos) ? std::wstring_view() : name.substr(pos);
+}
+
+/**
+ * @brief Parse NT headers (dimulai dari signature "PE\0\0")
+ */
+static bool ParseNtHeaders(const uint8_t* nt, size_t size, PeImageInfo& info)
+{
+    if (size < NT_HEADERS_MIN_SIZE) return false;
+    if (nt[0] != 'P' || nt[1] != 'E' || nt[2] != 0 || nt[3] != 0) return false;
+
+    info.machine = ReadLe16(nt + 4);
+    uint16_t optionalHeaderSize = ReadLe16(nt + 20);
+    info.characteristics = ReadLe16(nt + 22);
+
+    // Harus executable image, bukan DLL
+    if (!(info.characteristics & IMAGE_FILE_EXECUTABLE_IMAGE_FLAG)) return false;
+    if (info.characteristics & IMAGE_FILE_DLL_FLAG) return false;
+    if (optionalHeaderSize < OPTIONAL_SUBSYSTEM_OFFSET + 2) return false;
+
+    const uint8_t* optional = nt + NT_FILE_HEADER_END;
+    uint16_t magic = ReadLe16(optional);
+    if (magic != PE32_MAGIC && magic != PE32_PLUS_MAGIC) return false;
+
+    info.is64Bit = (magic == PE32_PLUS_MAGIC);
+    info.subsystem = ReadLe16(optional + OPTIONAL_SUBSYSTEM_OFFSET);
+    return true;
+}
+
+/**
+ * @brief Membaca dan memeriksa PE header dari handle yang sudah terbuka
+ *
+ * Biasanya hanya satu read (PE_HEADER_PROBE_SIZE bytes). Read kedua hanya
+ * dilakukan jika NT headers berada di luar blok pertama.
+ */
+static ValidationError InspectPeImage(IFileSystemBackend* fs, OsHandle file,
+                                      uint64_t fileSize, PeImageInfo& info)
+{
+    uint8_t header[PE_HEADER_PROBE_SIZE];
+    uint32_t bytesRead = 0;
+    if (!fs->ReadFileAt(file, 0, header, sizeof(header), bytesRead)) {
+        return VALIDATION_IO_ERROR;
+    }
+
+    if (ParsePeImageHeader(header, bytesRead, info)) {
+        return VALIDATION_OK;
+    }
+
+    // NT headers di luar blok pertama: baca ulang tepat di e_lfanew
+    if (bytesRead < DOS_LFANEW_OFFSET + 4 || header[0] != 'M' || header[1] != 'Z') {
+        return VALIDATION_NOT_PE_IMAGE;
+    }
+
+    uint32_t ntOffset = ReadLe32(header + DOS_LFANEW_OFFSET);
+    if (ntOffset > MAX_NT_HEADER_OFFSET || ntOffset + NT_HEADERS_MIN_SIZE <= bytesRead ||
+        ntOffset + NT_HEADERS_MIN_SIZE > fileSize) {
+        return VALIDATION_NOT_PE_IMAGE; // Header sudah terbaca penuh tetapi tidak valid
+    }
+
+    uint8_t ntHeaders[NT_HEADERS_MIN_SIZE];
+    if (!fs->ReadFileAt(file, ntOffset, ntHeaders, sizeof(ntHeaders), bytesRead)) {
+        return VALIDATION_IO_ERROR;
+    }
+
+    return ParseNtHeaders(ntHeaders, bytesRead, info) ? VALIDATION_OK : VALIDATION_NOT_PE_IMAGE;
+}
+
+/**
+ * @brief Mencocokkan SHA-256 file dengan allowlist aktif (jika ada)
+ *
+ * Hash dihitung dari handle validasi yang menolak write, sehingga isi yang
+ * di-hash sama dengan isi yang akan di-launch.
+ */
+static ValidationError CheckAllowlist(IFileSystemBackend* fs, ValidatedExecutable& result)
+{
+    result.hasSha256 = false;
+
+    const HashAllowlist* allowlist = GetExecutableAllowlist();
+    if (!allowlist) {
+        return VALIDATION_OK;
+    }
+
+    if (!GetCachedFileSha256(fs, result.file.Get(), result.identity, result.sha256)) {
+        return VALIDATION_IO_ERROR;
+    }
+    result.hasSha256 = true;
+
+    return allowlist->Contains(result.sha256) ? VALIDATION_OK : VALIDATION_NOT_ALLOWLISTED;
+}
+
+/**
+ * @brief Mencocokkan lokasi final file dengan policy path aktif (jika ada)
+ *
+ * Dijalankan pada path hasil canonicalization/PATH search, sehingga rule
+ * berlaku untuk file yang benar-benar dibuka, bukan string input user.
+ */
+static ValidationError CheckPathPolicy(ValidatedExecutable& result)
+{
+    result.policy = PathPolicyMatch();
+
+    const PathPolicy* policy = GetPathPolicy();
+    if (!policy) {
+        return VALIDATION_OK;
+    }
+
+    return (policy->Evaluate(result.path, &result.policy) == POLICY_DECISION_ALLOWED) ?
+        VALIDATION_OK : VALIDATION_POLICY_DENIED;
+}
+
+/**
+ * @brief Menjalankan pemeriksaan policy, identitas, dan isi file dari handle terbuka
+ *
+ * @param scriptHost true untuk ValidateScript (.bat/.cmd/.ps1 saja)
+ */
+static ValidationError InspectOpenedFile(IFileSystemBackend* fs, ValidatedExecutable& result,
+                                         bool scriptHost = false)
+{
+    ValidationError policyError = CheckPathPolicy(result);
+    if (policyError != VALIDATION_OK) {
+        return policyError;
+    }
+
+    if (!fs->QueryFileIdentity(result.file.Get(), result.identity)) {
+        return VALIDATION_IO_ERROR;
+    }
+
+    if (result.identity.isDirectory) {
+        return VALIDATION_IS_DIRECTORY;
+    }
+
+    result.kind = scriptHost ? GetScriptKind(result.path) : GetExecutableKind(result.path);
+    if (result.kind == EXECUTABLE_KIND_UNKNOWN) {
+        return VALIDATION_BAD_EXTENSION;
+    }
+
+    if (result.kind == EXECUTABLE_KIND_PE_IMAGE) {
+        ValidationError error = InspectPeImage(fs, result.file.Get(), result.identity.fileSize, result.image);
+        if (error != VALIDATION_OK) {
+            return error;
+        }
+    }
+    // Script (.bat/.cmd/.ps1) tidak memiliki header yang dapat diverifikasi
+
+    return CheckAllowlist(fs, result);
+}
+
+/**
+ * @brief Memecah nilai PATH menjadi daftar direktori (dengan separator akhir)
+ *
+ * Whitespace dan quote di sekitar setiap entry dibuang; entry kosong dilewati.
+ */
+static void SplitSearchPath(const std::wstring& pathVariable, std::vector<std::wstring>& directories)
+{
+    directories.clear();
+
+    size_t start = 0;
+    while (start <= pathVariable.size()) {
+        size_t end = pathVariable.find(L';', start);
+        if (end == std::wstring::npos) end = pathVariable.size();
+
+        size_t first = start;
+        size_t last = end;
+        while (first < last && (pathVariable[first] == L' ' || pathVariable[first] == L'"')) first++;
+        while (last > first && (pathVariable[last - 1] == L' ' || pathVariable[last - 1] == L'"')) last--;
+
+        if (last > first) {
+            std::wstring directory(pathVariable, first, last - first);
+            if (!IsPathSeparator(directory.back())) {
+                directory += L'\\';
+            }
+            directories.push_back(std::move(directory));
+        }
+
+        start = end + 1;
+    }
+}
+
+/**
+ * @brief Key index PATH: nama file lowercase ASCII (pencocokan case-insensitive)
+ */
+static std::wstring MakeSearchIndexKey(std::wstring_view fileName)
+{
+    std::wstring key(fileName);
+    for (wchar_t& ch : key) {
+        ch = ToLowerAscii(ch);
+    }
+    return key;
+}
+
+/**
+ * @brief Membuka candidate path jika aman; true jika file ada
+ */
+static bool TryOpenCandidate(IFileSystemBackend* fs, const std::wstring& candidate, ValidatedExecutable& result)
+{
+    // Entry PATH yang tidak aman dilewati tanpa menyentuh filesystem
+    if (candidate.size() > VALIDATION_MAX_PATH || !IsPathTraversalSafe(candidate)) {
+        return false;
+    }
+
+    OsHandle handle = fs->OpenFileForValidation(candidate);
+    if (handle == OS_INVALID_HANDLE) {
+        return false;
+    }
+    result.file = ScopedBackendFile(fs, handle);
+    result.path = candidate;
+    return true;
+}
+
+/**
+ * @brief Mencari dan membuka file di direktori-direktori PATH
+ *
+ * Open langsung digunakan sebagai existence probe sehingga tidak ada
+ * pemanggilan FileExists terpisah untuk setiap direktori. Jika index PATH
+ * terpasang, lokasi diambil dari index (satu open) tanpa membaca PATH.
+ *
+ * @return true jika file ditemukan; result.path dan result.file terisi
+ */
+static bool OpenFromSearchPath(IFileSystemBackend* fs, const std::wstring& fileName,
+                               ValidatedExecutable& result)
+{
+    const PathSearchIndex* index = GetPathSearchIndex();
+    if (index) {
+        std::wstring indexed;
+        if (!index->Find(fileName, indexed)) {
+            return false; // Snapshot index: tidak ada di direktori PATH mana pun
+        }
+        if (TryOpenCandidate(fs, indexed, result)) {
+            return true;
+        }
+        // File berubah sejak index dibangun - lanjutkan dengan pencarian biasa
+    }
+
+    std::wstring pathVariable;
+    if (!fs->GetEnvironmentValue(L"PATH", pathVariable)) {
+        return false;
+    }
+
+    std::vector<std::wstring> directories;
+    SplitSearchPath(pathVariable, directories);
+
+    for (const std::wstring& directory : directories) {
+        if (TryOpenCandidate(fs, directory + fileName, result)) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+//==============================================================================
+// PATH SEARCH INDEX
+//==============================================================================
+
+/** @brief Index PATH yang dipasang secara eksplisit (NULL = baca PATH setiap pencarian) */
+static const PathSearchIndex* gPathSearchIndex = nullptr;
+
+void SetPathSearchIndex(const PathSearchIndex* index)
+{
+    gPathSearchIndex = index;
+}
+
+const PathSearchIndex* GetPathSearchIndex()
+{
+    return gPathSearchIndex;
+}
+
+bool PathSearchIndex::Build(IFileSystemBackend* fs)
+{
+    entries_.clear();
+
+    std::wstring pathVariable;
+    if (!fs->GetEnvironmentValue(L"PATH", pathVariable)) {
+        return false;
+    }
+
+    std::vector<std::wstring> directories;
+    SplitSearchPath(pathVariable, directories);
+
+    std::vector<DirectoryEntry> listing;
+    for (const std::wstring& directory : directories) {
+        if (!IsPathTraversalSafe(directory) || !fs->EnumerateDirectory(directory, listing)) {
+            continue;
+        }
+        for (const DirectoryEntry& entry : listing) {
+            if (entry.isDirectory || GetExecutableKind(entry.name) == EXECUTABLE_KIND_UNKNOWN) {
+                continue;
+            }
+            // Direktori PATH pertama menang, sama seperti pencarian biasa
+            entries_.emplace(MakeSearchIndexKey(entry.name), directory + entry.name);
+        }
+    }
+    return true;
+}
+
+bool PathSearchIndex::Find(std::wstring_view fileName, std::wstring& fullPath) const
+{
+    auto it = entries_.find(MakeSearchIndexKey(fileName));
+    if (it == entries_.end()) {
+        return false;
+    }
+    fullPath = it->second;
+    return true;
+}
+
+//==============================================================================
+// PUBLIC API
+//==============================================================================
+
+bool IsPathTraversalSafe(std::wstring_view path)
+{
+    // Prefix "\\?\" mengandung '?' yang sah - periksa sisa path saja
+    std::wstring_view prefix(EXTENDED_PATH_PREFIX);
+    if (path.substr(0, prefix.size()) == prefix) {
+        path.remove_prefix(prefix.size());
+    }
+
+    if (path.find(L"..\\") != std::wstring_view::npos || path.find(L"../") != std::wstring_view::npos) return false;
+    if (path.find(L"\\..") != std::wstring_view::npos || path.find(L"/..") != std::wstring_view::npos) return false;
+
+    return path.find_first_of(L"<>\"|?*") == std::wstring_view::npos;
+}
+
+bool SanitizePath(std::wstring& path)
+{
+    // Trim whitespace
+    size_t first = path.find_first_not_of(L" \t\r\n");
+    if (first == std::wstring::npos) {
+        path.clear();
+        return false;
+    }
+    size_t last = path.find_last_not_of(L" \t\r\n");
+    path = path.substr(first, last - first + 1);
+
+    bool isAbsolute = (path.size() >= 2 && path[1] == L':') ||
+                      path[0] == L'\\' || path[0] == L'/';
+
+    // Nama file saja dibiarkan - ValidateExecutable menangani PATH search;
+    // relative path dengan komponen direktori diberi prefix current directory
+    if (!isAbsolute && path.find_first_of(L"\\/") != std::wstring::npos) {
+        std::wstring currentDir;
+        if (GetFileSystemBackend()->GetCurrentDirectoryPath(currentDir) && !currentDir.empty()) {
+            path = currentDir + L"\\" + path;
+        }
+    }
+
+    for (wchar_t& ch : path) {
+        if (ch == L'/') ch = L'\\';
+    }
+
+    // Prefix "\\?\" dan awalan UNC "\\" dipertahankan, sisanya tanpa separator ganda
+    std::wstring_view prefix(EXTENDED_PATH_PREFIX);
+    size_t keep = 0;
+    if (path.compare(0, prefix.size(), prefix) == 0) {
+        keep = prefix.size();
+    } else if (path.compare(0, 2, L"\\\\") == 0) {
+        keep = 2;
+    }
+
+    std::wstring normalized(path, 0, keep);
+    normalized.reserve(path.size());
+    for (size_t i = keep; i < path.size(); i++) {
+        if (path[i] == L'\\' && !normalized.empty() && normalized.back() == L'\\') continue;
+        normalized += path[i];
+    }
+    path.swap(normalized);
+
+    return !path.empty();
+}
+
+std::wstring GetCanonicalPath(std::wstring_view path)
+{
+    if (path.empty() || path.size() > VALIDATION_MAX_PATH) {
+        return std::wstring();
+    }
+
+    std::wstring canonicalPath;
+    if (!GetFileSystemBackend()->GetFullPath(std::wstring(path), canonicalPath)) {
+        return std::wstring();
+    }
+
+    for (wchar_t& ch : canonicalPath) {
+        if (ch == L'/') ch = L'\\';
+    }
+
+    // Hapus trailing backslash kecuali untuk root drive (misalnya "C:\")
+    while (canonicalPath.size() > 3 && canonicalPath.back() == L'\\') {
+        canonicalPath.pop_back();
+    }
+
+    return canonicalPath;
+}
+
+std::wstring ToExtendedLengthPath(std::wstring_view path)
+{
+    std::wstring_view prefix(EXTENDED_PATH_PREFIX);
+    if (path.size() < LEGACY_MAX_PATH || path.substr(0, prefix.size()) == prefix) {
+        return std::wstring(path);
+    }
+
+    std::wstring extended;
+    if (path.size() >= 2 && path[0] == L'\\' && path[1] == L'\\') {
+        // UNC: "\\server\share" -> "\\?\UNC\server\share"
+        extended.reserve(path.size() + 6);
+        extended.append(prefix);
+        extended.append(L"UNC");
+        extended.append(path.substr(1));
+    } else {
+        extended.reserve(path.size() + prefix.size());
+        extended.append(prefix);
+        extended.append(path);
+    }
+    return extended;
+}
+
+bool IsValidExecutable(std::wstring_view path)
+{
+    ValidatedExecutable validated;
+    return InspectExecutableFile(path, validated) == VALIDATION_OK;
+}
+
+std::wstring FindExecutableInPath(std::wstring_view exeName)
+{
+    if (exeName.empty() || exeName.size() > VALIDATION_MAX_PATH) {
+        return std::wstring();
+    }
+
+    std::wstring fileName(exeName);
+    if (GetExtensionPart(fileName).empty()) {
+        fileName += L".exe";
+    }
+
+    ValidatedExecutable found;
+    if (!OpenFromSearchPath(GetFileSystemBackend(), fileName, found)) {
+        return std::wstring();
+    }
+
+    // Open hanya digunakan sebagai existence probe
+    found.file.Reset();
+    return found.path;
+}
+
+ExecutableKind GetExecutableKind(std::wstring_view path)
+{
+    std::wstring_view ext = GetExtensionPart(path);
+    if (ext.size() != 4) return EXECUTABLE_KIND_UNKNOWN;
+
+    wchar_t lower[4];
+    for (size_t i = 0; i < 4; i++) {
+        lower[i] = ToLowerAscii(ext[i]);
+    }
+    std::wstring_view normalized(lower, 4);
+
+    if (normalized == L".exe" || normalized == L".com") return EXECUTABLE_KIND_PE_IMAGE;
+    if (normalized == L".bat" || normalized == L".cmd") return EXECUTABLE_KIND_SCRIPT;
+    return EXECUTABLE_KIND_UNKNOWN;
+}
+
+ExecutableKind GetScriptKind(std::wstring_view path)
+{
+    ExecutableKind kind = GetExecutableKind(path);
+    if (kind == EXECUTABLE_KIND_SCRIPT) return kind;
+
+    std::wstring_view ext = GetExtensionPart(path);
+    if (ext.size() == 4 && ToLowerAscii(ext[1]) == L'p' && ToLowerAscii(ext[2]) == L's' && ext[3] == L'1') {
+        return EXECUTABLE_KIND_POWERSHELL;
+    }
+    return EXECUTABLE_KIND_UNKNOWN;
+}
+
+bool ParsePeImageHeader(const uint8_t* data, size_t size, PeImageInfo& info)
+{
+    if (!data || size < DOS_LFANEW_OFFSET + 4) return false;
+    if (data[0] != 'M' || data[1] != 'Z') return false;
+
+    uint32_t ntOffset = ReadLe32(data + DOS_LFANEW_OFFSET);
+    if (ntOffset > size || size - ntOffset < NT_HEADERS_MIN_SIZE) return false;
+
+    return ParseNtHeaders(data + ntOffset, size - ntOffset, info);
+}
+
+ValidationError InspectExecutableFile(std::wstring_view canonicalPath, ValidatedExecutable& result)
+{
+    if (canonicalPath.empty()) return VALIDATION_EMPTY_PATH;
+
+    IFileSystemBackend* fs = GetFileSystemBackend();
+    result.path.assign(canonicalPath.data(), canonicalPath.size());
+
+    OsHandle handle = fs->OpenFileForValidation(result.path);
+    if (handle == OS_INVALID_HANDLE) {
+        return VALIDATION_NOT_FOUND;
+    }
+    result.file = ScopedBackendFile(fs, handle);
+
+    ValidationError error = InspectOpenedFile(fs, result);
+    if (error != VALIDATION_OK) {
+        result.file.Reset(); // Jangan biarkan handle file yang ditolak tetap terbuka
+    }
+    return error;
+}
+
+ValidationError ValidateExecutable(std::wstring_view path, ValidatedExecutable& result)
+{
+    //======================================================================
+    // STEP 1: PEMERIKSAAN STRING (tanpa syscall)
+    //======================================================================
+
+    if (path.empty()) return VALIDATION_EMPTY_PATH;
+    if (path.size() > VALIDATION_MAX_PATH) return VALIDATION_PATH_TOO_LONG;
+    if (!IsPathTraversalSafe(path)) return VALIDATION_UNSAFE_PATH;
+
+    // Nama tanpa extension dicari sebagai "<nama>.exe" di PATH; extension lain
+    // yang tidak diizinkan ditolak sebelum menyentuh filesystem
+    bool hasExtension = !GetExtensionPart(path).empty();
+    if (hasExtension && GetExecutableKind(path) == EXECUTABLE_KIND_UNKNOWN) {
+        return VALIDATION_BAD_EXTENSION;
+    }
+
+    //======================================================================
+    // STEP 2: CANONICALIZATION (satu kali)
+    //======================================================================
+
+    IFileSystemBackend* fs = GetFileSystemBackend();
+
+    std::wstring canonicalPath;
+    if (!fs->GetFullPath(std::wstring(path), canonicalPath) || canonicalPath.empty()) {
+        return VALIDATION_CANONICALIZE_FAILED;
+    }
+    if (canonicalPath.size() > VALIDATION_MAX_PATH) return VALIDATION_PATH_TOO_LONG;
+    if (!IsPathTraversalSafe(canonicalPath)) return VALIDATION_UNSAFE_PATH;
+
+    //======================================================================
+    // STEP 3: OPEN SATU KALI (sekaligus existence check)
+    //======================================================================
+
+    result.file.Reset();
+    if (hasExtension) {
+        OsHandle handle = fs->OpenFileForValidation(canonicalPath);
+        if (handle != OS_INVALID_HANDLE) {
+            result.file = ScopedBackendFile(fs, handle);
+            result.path = canonicalPath;
+        }
+    }
+
+    if (!result.file.IsValid()) {
+        // Fallback: cari nama file di direktori PATH
+        std::wstring fileName(GetFileNamePart(canonicalPath));
+        if (!hasExtension) {
+            fileName += L".exe";
+        }
+
+        if (!OpenFromSearchPath(fs, fileName, result)) {
+            return VALIDATION_NOT_FOUND;
+        }
+
+        // Entry PATH bisa relative - normalisasi lokasi yang ditemukan
+        std::wstring canonicalFound;
+        if (!fs->GetFullPath(result.path, canonicalFound) || !IsPathTraversalSafe(canonicalFound)) {
+            result.file.Reset();
+            return VALIDATION_UNSAFE_PATH;
+        }
+        result.path = canonicalFound;
+    }
+
+    //======================================================================
+    // STEP 4-7: POLICY, IDENTITAS, PE CHECK, DAN HASH DARI HANDLE YANG SAMA
+    //======================================================================
+
+    ValidationError error = InspectOpenedFile(fs, result);
+    if (error != VALIDATION_OK) {
+        result.file.Reset();
+    }
+    return error;
+}
+
+ValidationError ValidateScript(std::wstring_view path, ValidatedExecutable& result)
+{
+    result.file.Reset();
+
+    if (path.empty()) return VALIDATION_EMPTY_PATH;
+    if (path.size() > VALIDATION_MAX_PATH) return VALIDATION_PATH_TOO_LONG;
+    if (!IsPathTraversalSafe(path)) return VALIDATION_UNSAFE_PATH;
+    if (GetScriptKind(path) == EXECUTABLE_KIND_UNKNOWN) return VALIDATION_BAD_EXTENSION;
+
+    IFileSystemBackend* fs = GetFileSystemBackend();
+
+    std::wstring canonicalPath;
+    if (!fs->GetFullPath(std::wstring(path), canonicalPath) || canonicalPath.empty()) {
+        return VALIDATION_CANONICALIZE_FAILED;
+    }
+    if (canonicalPath.size() > VALIDATION_MAX_PATH) return VALIDATION_PATH_TOO_LONG;
+    if (!IsPathTraversalSafe(canonicalPath)) return VALIDATION_UNSAFE_PATH;
+
+    // Script selalu ditunjuk dengan path - tidak ada pencarian PATH
+    OsHandle handle = fs->OpenFileForValidation(canonicalPath);
+    if (handle == OS_INVALID_HANDLE) {
+        return VALIDATION_NOT_FOUND;
+    }
+    result.file = ScopedBackendFile(fs, handle);
+    result.path = canonicalPath;
+
+    ValidationError error = InspectOpenedFile(fs, result, true);
+    if (error != VALIDATION_OK) {
+        result.file.Reset();
+    }
+    return error;
+}
+
+const char* GetValidationErrorName(ValidationError error)
+{
+    switch (error)
+    {
+    case VALIDATION_OK:                  return "ok";
+    case VALIDATION_EMPTY_PATH:          return "empty-path";
+    case VALIDATION_PATH_TOO_LONG:       return "path-too-long";
+    case VALIDATION_UNSAFE_PATH:         return "unsafe-path";
+    case VALIDATION_CANONICALIZE_FAILED: return "canonicalize-failed";
+    case VALIDATION_BAD_EXTENSION:       return "bad-extension";
+    case VALIDATION_NOT_FOUND:           return "not-found";
+    case VALIDATION_IS_DIRECTORY:        return "is-directory";
+    case VALIDATION_IO_ERROR:            return "io-error";
+    case VALIDATION_NOT_PE_IMAGE:        return "not-pe-image";
+    case VALIDATION_NOT_ALLOWLISTED:     return "not-allowlisted";
+    case VALIDATION_POLICY_DENIED:       return "policy-denied";
+    default:                             return "unknown";
+    }
+}
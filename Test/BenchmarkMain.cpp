@@ -0,0 +1,142 @@
+/**
+ * @file BenchmarkMain.cpp
+ * @brief Runner microbenchmark portable (Linux/GCC/Clang) untuk RasTI Core
+ *
+ * Usage:
+ *   rasti_bench [--filter=TEXT] [--min-time=MS] [--save=FILE]
+ *               [--compare=FILE] [--threshold=PERCENT]
+ *
+ * --save menulis baseline JSON; --compare membaca baseline dan keluar dengan
+ * exit code 1 jika ada case yang melambat melebihi threshold (default 10%)
+ * atau alokasi/op bertambah.
+ *
+ * @author RasTI Development Team
+ * @version 1.2.0.0
+ * @date 2025
+ */
+
+#include "Microbenchmark.h"
+#include <atomic>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <new>
+#include <sstream>
+
+//==============================================================================
+// ALLOCATION COUNTER
+//==============================================================================
+
+/** @brief Jumlah alokasi heap melalui operator new sejak program mulai */
+static std::atomic<long> gAllocationCount(0);
+
+void* operator new(size_t size)
+{
+    gAllocationCount++;
+    void* memory = malloc(size ? size : 1);
+    if (!memory) throw std::bad_alloc();
+    return memory;
+}
+
+void operator delete(void* memory) noexcept
+{
+    free(memory);
+}
+
+void operator delete(void* memory, size_t) noexcept
+{
+    free(memory);
+}
+
+//==============================================================================
+// ENTRY POINT
+//==============================================================================
+
+/** @brief Nilai argumen "--key=value" jika arg diawali prefix */
+static bool ReadOption(const std::string& arg, const char* prefix, std::string& value)
+{
+    std::string key(prefix);
+    if (arg.compare(0, key.size(), key) != 0) {
+        return false;
+    }
+    value = arg.substr(key.size());
+    return true;
+}
+
+int main(int argc, char* argv[]) {
+    std::string filter;
+    std::string savePath;
+    std::string comparePath;
+    double thresholdPercent = 10.0;
+
+    MicrobenchmarkOptions options;
+    options.allocationCounter = []() { return gAllocationCount.load(); };
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        std::string value;
+        if (ReadOption(arg, "--filter=", value)) {
+            filter = value;
+        } else if (ReadOption(arg, "--min-time=", value)) {
+            options.minBatchMs = atof(value.c_str());
+        } else if (ReadOption(arg, "--save=", value)) {
+            savePath = value;
+        } else if (ReadOption(arg, "--compare=", value)) {
+            comparePath = value;
+        } else if (ReadOption(arg, "--threshold=", value)) {
+            thresholdPercent = atof(value.c_str());
+        } else {
+            std::cerr << "Unknown option: " << arg << std::endl;
+            std::cerr << "Usage: rasti_bench [--filter=TEXT] [--min-time=MS] [--save=FILE] "
+                         "[--compare=FILE] [--threshold=PERCENT]" << std::endl;
+            return 2;
+        }
+    }
+    if (options.minBatchMs <= 0.0 || thresholdPercent < 0.0) {
+        std::cerr << "Invalid --min-time or --threshold" << std::endl;
+        return 2;
+    }
+
+    std::vector<MicrobenchmarkResult> results;
+    {
+        std::vector<MicrobenchmarkCase> cases = CreateCoreMicrobenchmarks();
+        for (const MicrobenchmarkCase& benchmark : cases) {
+            if (!filter.empty() && benchmark.name.find(filter) == std::string::npos) {
+                continue;
+            }
+            results.push_back(RunMicrobenchmark(benchmark, options));
+        }
+    }
+    PrintMicrobenchmarkResults(results, std::cout);
+
+    if (!savePath.empty()) {
+        std::ofstream file(savePath, std::ios::binary);
+        file << FormatMicrobenchmarkBaseline(results);
+        if (!file) {
+            std::cerr << "Cannot write baseline: " << savePath << std::endl;
+            return 2;
+        }
+        std::cout << std::endl << "Baseline saved: " << savePath << std::endl;
+    }
+
+    if (!comparePath.empty()) {
+        std::ifstream file(comparePath, std::ios::binary);
+        std::stringstream contents;
+        contents << file.rdbuf();
+
+        std::vector<MicrobenchmarkResult> baseline;
+        if (!file || !ParseMicrobenchmarkBaseline(contents.str(), baseline)) {
+            std::cerr << "Cannot read baseline: " << comparePath << std::endl;
+            return 2;
+        }
+
+        std::cout << std::endl << "Compared with " << comparePath << " (threshold " << thresholdPercent << "%)" << std::endl;
+        int regressions = PrintMicrobenchmarkComparison(CompareMicrobenchmarks(results, baseline, thresholdPercent), std::cout);
+        if (regressions > 0) {
+            std::cout << regressions << " regression(s)" << std::endl;
+            return 1;
+        }
+        std::cout << "No regressions" << std::endl;
+    }
+    return 0;
+}
@@ -0,0 +1,75 @@
+/**
+ * @file CApiSmokeMain.c
+ * @brief Smoke test C ABI: RasTIApi.h dikompilasi sebagai C dan di-link ke rasti_shared
+ *
+ * Memastikan header dapat dipakai dari C murni dan simbol RASTI_API diekspor
+ * dari shared library. Hanya memeriksa jalur yang hasilnya sama di semua
+ * backend (argumen tidak valid, file yang tidak ada); urutan akuisisi dan
+ * launch diuji dengan backend palsu di TestCApi (PortableTests.cpp).
+ *
+ * @author RasTI Development Team
+ * @version 1.2.0.0
+ * @date 2025
+ */
+
+#include "RasTIApi.h"
+#include <stdio.h>
+#include <string.h>
+
+/** @brief Mencetak kegagalan dan mengembalikan 1 */
+static int Check(int condition, const char* message)
+{
+    if (!condition) {
+        fprintf(stderr, "FAILED: %s\n", message);
+        return 1;
+    }
+    return 0;
+}
+
+int main(void)
+{
+    int failures = 0;
+    RastiError error;
+    RastiValidationInfo info;
+    RastiLaunchOptions options;
+    RastiToken token = NULL;
+    RastiProcess process = NULL;
+
+    failures += Check(RastiGetApiVersion() == RASTI_API_VERSION, "API version matches header");
+
+    /* Argumen NULL ditolak sebelum menyentuh OS */
+    failures += Check(!RastiAcquireToken(NULL), "NULL token output rejected");
+    RastiGetLastError(&error);
+    failures += Check(error.phase == RASTI_PHASE_ARGUMENT, "NULL token output reports argument phase");
+
+    memset(&options, 0, sizeof(options));
+    options.size = sizeof(options);
+    options.path = "C:\\Windows\\System32\\cmd.exe";
+    failures += Check(!RastiLaunch(NULL, &options, &process, NULL), "launch without token rejected");
+    failures += Check(process == NULL, "failed launch returns no process");
+
+    failures += Check(!RastiWait(NULL, RASTI_WAIT_INFINITE, NULL), "wait without process rejected");
+
+    /* Struct dari versi ABI yang lebih kecil ditolak */
+    memset(&info, 0, sizeof(info));
+    info.size = 4;
+    failures += Check(!RastiValidate("tool.exe", &info), "short validation struct rejected");
+
+    /* Extension yang tidak diizinkan gagal di tahap validasi */
+    info.size = sizeof(info);
+    failures += Check(!RastiValidate("C:\\Tools\\notes.txt", &info), "bad extension rejected");
+    RastiGetLastError(&error);
+    failures += Check(error.phase == RASTI_PHASE_VALIDATE, "bad extension reports validate phase");
+    failures += Check(strcmp(RastiGetValidationErrorName(error.validation), "bad-extension") == 0,
+                      "validation error name available");
+    failures += Check(strcmp(RastiGetPhaseName(RASTI_PHASE_ACQUIRE), "acquire") == 0, "phase names available");
+
+    /* Release/close NULL aman */
+    RastiReleaseToken(token);
+    RastiCloseProcess(process);
+
+    if (failures == 0) {
+        printf("C ABI smoke test passed (API version %u)\n", (unsigned)RastiGetApiVersion());
+    }
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,218 @@
+/**
+ * @file CoreBenchmarks.cpp
+ * @brief Microbenchmark portable untuk function Core di atas backend palsu
+ *
+ * Input set meniru apa yang diterima RasTI dari GUI/CLI: path absolute
+ * dengan spasi, separator campuran, path relative, UNC, path panjang
+ * (> MAX_PATH), nama file saja (PATH search), dan input yang ditolak.
+ * Backend palsu in-memory menghilangkan biaya I/O sehingga ns/op mengukur
+ * logika Core itu sendiri; alokasi/op termasuk bookkeeping backend palsu
+ * (satu node map per open) yang konstan antar run.
+ *
+ * @author RasTI Development Team
+ * @version 1.2.0.0
+ * @date 2025
+ */
+
+#include "Microbenchmark.h"
+#include "TestSupport.h"
+#include <memory>
+
+//==============================================================================
+// FIXTURE
+//==============================================================================
+
+/** @brief Mencegah compiler membuang hasil operasi yang diukur */
+static volatile size_t gBenchmarkSink = 0;
+
+/**
+ * @brief Host simulasi yang dibagi oleh semua case
+ */
+struct CoreBenchmarkFixture {
+    FakeFileSystemBackend fs;
+    FakeProcessBackend directTcbHost;       /**< Admin dengan SeTcbPrivilege langsung */
+    FakeProcessBackend impersonationHost;   /**< Admin biasa: TCB lewat winlogon.exe */
+    PathSearchIndex pathIndex;
+
+    std::vector<std::wstring> sanitizeInputs;
+    std::vector<std::wstring> canonicalInputs;
+    std::vector<std::wstring> traversalInputs;
+    std::vector<std::wstring> searchNames;
+    std::vector<std::wstring> executablePaths;
+    std::vector<std::wstring> validationInputs;
+    std::wstring scratch;                   /**< Buffer SanitizePath (kapasitas dipakai ulang) */
+
+    CoreBenchmarkFixture() {
+        std::wstring deepDirectory = L"C:\\Build\\Artifacts";
+        while (deepDirectory.size() < 300) {
+            deepDirectory += L"\\intermediate-output-directory";
+        }
+        const std::wstring deepExecutable = deepDirectory + L"\\packager.exe";
+
+        // PATH khas workstation: 12 direktori, executable tersebar di tengah/akhir
+        const wchar_t* pathDirectories[] = {
+            L"C:\\Windows\\System32", L"C:\\Windows", L"C:\\Windows\\System32\\Wbem",
+            L"C:\\Windows\\System32\\WindowsPowerShell\\v1.0", L"C:\\Windows\\System32\\OpenSSH",
+            L"C:\\Program Files\\Git\\cmd", L"C:\\Program Files\\dotnet", L"C:\\Program Files\\nodejs",
+            L"C:\\Program Files\\CMake\\bin", L"C:\\Python312\\Scripts", L"C:\\Python312",
+            L"C:\\Users\\admin\\AppData\\Local\\Microsoft\\WindowsApps"
+        };
+        for (const wchar_t* directory : pathDirectories) {
+            if (!fs.pathVariable.empty()) fs.pathVariable += L";";
+            fs.pathVariable += directory;
+        }
+        fs.currentDirectory = L"C:\\Users\\admin\\Projects\\deploy";
+
+        const std::vector<uint8_t> consoleImage = BuildTestPeImage(3);
+        const std::vector<uint8_t> guiImage = BuildTestPeImage(2);
+        fs.files[L"C:\\Windows\\System32\\cmd.exe"] = consoleImage;
+        fs.files[L"C:\\Windows\\System32\\whoami.exe"] = consoleImage;
+        fs.files[L"C:\\Windows\\regedit.exe"] = guiImage;
+        fs.files[L"C:\\Windows\\System32\\WindowsPowerShell\\v1.0\\powershell.exe"] = consoleImage;
+        fs.files[L"C:\\Program Files\\Git\\cmd\\git.exe"] = consoleImage;
+        fs.files[L"C:\\Python312\\python.exe"] = consoleImage;
+        fs.files[L"C:\\Program Files\\Common Files\\installer.exe"] = guiImage;
+        fs.files[L"C:\\Users\\admin\\Projects\\deploy\\tools\\deploy.cmd"] = std::vector<uint8_t>(256, 'x');
+        fs.files[L"C:\\Users\\admin\\Downloads\\readme.exe"] = std::vector<uint8_t>(4096, 'x'); // bukan PE
+        fs.files[deepExecutable] = consoleImage;
+
+        sanitizeInputs = {
+            L"C:\\Windows\\System32\\cmd.exe",
+            L"  C:/Program Files/Common Files/installer.exe ",
+            L"tools\\deploy.cmd",
+            L"C:\\Windows\\\\System32\\\\whoami.exe",
+            L"\\\\fileserver\\share\\tools\\setup.exe",
+            L"powershell",
+            deepExecutable
+        };
+        canonicalInputs = {
+            L"C:\\Windows\\System32\\cmd.exe",
+            L"C:\\Program Files\\Common Files\\installer.exe",
+            L"tools\\deploy.cmd",
+            L"C:\\Windows\\",
+            L"C:/Python312/python.exe",
+            deepExecutable
+        };
+        traversalInputs = {
+            L"C:\\Windows\\System32\\cmd.exe",
+            L"C:\\Program Files\\Common Files\\installer.exe",
+            L"\\\\?\\C:\\Build\\packager.exe",
+            L"C:\\Tools\\..\\Windows\\System32\\cmd.exe",
+            L"C:\\Tools\\app<1>.exe",
+            deepExecutable
+        };
+        searchNames = { L"cmd", L"whoami.exe", L"powershell.exe", L"git", L"python.exe", L"missing-tool.exe" };
+        executablePaths = {
+            L"C:\\Windows\\System32\\cmd.exe",
+            L"C:\\Windows\\regedit.exe",
+            L"C:\\Users\\admin\\Projects\\deploy\\tools\\deploy.cmd",
+            L"C:\\Users\\admin\\Downloads\\readme.exe",
+            L"C:\\Windows\\System32\\missing.exe",
+            deepExecutable
+        };
+        validationInputs = {
+            L"C:\\Windows\\System32\\cmd.exe",
+            L"C:\\Program Files\\Common Files\\installer.exe",
+            L"cmd.exe",
+            L"tools\\deploy.cmd",
+            L"C:\\Users\\admin\\Downloads\\readme.exe",
+            L"C:\\Tools\\..\\Windows\\System32\\cmd.exe",
+            L"C:\\Windows\\System32\\drivers\\etc\\hosts",
+            deepExecutable
+        };
+
+        FakeProcessBackend::ConfigureDirectTcbHost(directTcbHost);
+        FakeProcessBackend::ConfigureImpersonationHost(impersonationHost);
+        directTcbHost.recordCalls = false;
+        impersonationHost.recordCalls = false;
+
+        pathIndex.Build(&fs);
+    }
+
+    /** @brief Pasang backend palsu; index PATH opsional */
+    void InstallFileSystem(const PathSearchIndex* index) {
+        SetFileSystemBackend(&fs);
+        SetPathSearchIndex(index);
+    }
+
+    static void Uninstall() {
+        SetPathSearchIndex(NULL);
+        SetFileSystemBackend(NULL);
+        SetProcessBackend(NULL);
+    }
+};
+
+//==============================================================================
+// CASES
+//==============================================================================
+
+/** @brief Case filesystem-only dengan fixture bersama */
+static MicrobenchmarkCase FileSystemCase(const std::shared_ptr<CoreBenchmarkFixture>& fixture, const char* name,
+                                         bool useIndex, std::function<void(uint64_t)> body)
+{
+    MicrobenchmarkCase benchmark;
+    benchmark.name = name;
+    benchmark.setup = [fixture, useIndex]() { fixture->InstallFileSystem(useIndex ? &fixture->pathIndex : NULL); };
+    benchmark.body = std::move(body);
+    benchmark.teardown = []() { CoreBenchmarkFixture::Uninstall(); };
+    return benchmark;
+}
+
+/** @brief Case akuisisi token TI tersimulasi (setara GetTrustedInstallerToken) */
+static MicrobenchmarkCase TokenAcquisitionCase(const std::shared_ptr<CoreBenchmarkFixture>& fixture, const char* name,
+                                               FakeProcessBackend* host)
+{
+    MicrobenchmarkCase benchmark;
+    benchmark.name = name;
+    benchmark.setup = [host]() { SetProcessBackend(host); };
+    benchmark.body = [fixture, host](uint64_t) {
+        OsHandle token = AcquireTrustedInstallerToken();
+        gBenchmarkSink = gBenchmarkSink + static_cast<size_t>(token);
+        host->CloseObject(token);
+    };
+    benchmark.teardown = []() { CoreBenchmarkFixture::Uninstall(); };
+    return benchmark;
+}
+
+std::vector<MicrobenchmarkCase> CreateCoreMicrobenchmarks()
+{
+    std::shared_ptr<CoreBenchmarkFixture> fx = std::make_shared<CoreBenchmarkFixture>();
+    CoreBenchmarkFixture* f = fx.get();
+    std::vector<MicrobenchmarkCase> cases;
+
+    cases.push_back(FileSystemCase(fx, "SanitizePath", false, [f](uint64_t i) {
+        f->scratch.assign(f->sanitizeInputs[i % f->sanitizeInputs.size()]);
+        gBenchmarkSink = gBenchmarkSink + SanitizePath(f->scratch) + f->scratch.size();
+    }));
+
+    cases.push_back(FileSystemCase(fx, "GetCanonicalPath", false, [f](uint64_t i) {
+        gBenchmarkSink = gBenchmarkSink + GetCanonicalPath(f->canonicalInputs[i % f->canonicalInputs.size()]).size();
+    }));
+
+    cases.push_back(FileSystemCase(fx, "IsPathTraversalSafe", false, [f](uint64_t i) {
+        gBenchmarkSink = gBenchmarkSink + IsPathTraversalSafe(f->traversalInputs[i % f->traversalInputs.size()]);
+    }));
+
+    cases.push_back(FileSystemCase(fx, "FindExecutableInPath/scan", false, [f](uint64_t i) {
+        gBenchmarkSink = gBenchmarkSink + FindExecutableInPath(f->searchNames[i % f->searchNames.size()]).size();
+    }));
+
+    cases.push_back(FileSystemCase(fx, "FindExecutableInPath/indexed", true, [f](uint64_t i) {
+        gBenchmarkSink = gBenchmarkSink + FindExecutableInPath(f->searchNames[i % f->searchNames.size()]).size();
+    }));
+
+    cases.push_back(FileSystemCase(fx, "IsValidExecutable", false, [f](uint64_t i) {
+        gBenchmarkSink = gBenchmarkSink + IsValidExecutable(f->executablePaths[i % f->executablePaths.size()]);
+    }));
+
+    // ValidateExecutablePath (Core.cpp) adalah wrapper langsung pipeline ini
+    cases.push_back(FileSystemCase(fx, "ValidateExecutable", false, [f](uint64_t i) {
+        ValidatedExecutable validated;
+        gBenchmarkSink = gBenchmarkSink + ValidateExecutable(f->validationInputs[i % f->validationInputs.size()], validated);
+    }));
+
+    cases.push_back(TokenAcquisitionCase(fx, "GetTrustedInstallerToken/direct-tcb", &f->directTcbHost));
+    cases.push_back(TokenAcquisitionCase(fx, "GetTrustedInstallerToken/impersonation", &f->impersonationHost));
+
+    return cases;
+}
@@ -0,0 +1,196 @@
+/**
+ * @file LaunchBenchmarkMain.cpp
+ * @brief Benchmark latency launch end-to-end di Linux dengan backend palsu
+ *
+ * Padanan RasTI.exe /bench:N: menjalankan RunLaunchBenchmark di atas
+ * FakeFileSystemBackend dan FakeProcessBackend. Latency buatan per langkah
+ * mensimulasikan host pelanggan (tabel proses besar, seclogon lambat, hook
+ * antivirus pada open/CreateProcess).
+ *
+ * --console=MODE memilih console proses target seperti /console:MODE.
+ * --console-latency-us dan --console-commit-kb memodelkan biaya conhost untuk
+ * setiap CREATE_NEW_CONSOLE, sehingga new dan none dapat dibandingkan; tabel
+ * memori dicetak jika model commit diberikan.
+ *
+ * --launch-api=API memilih CreateProcessAsUserW atau seclogon seperti
+ * /launchapi:API; --seclogon-latency-us memodelkan RPC ke service seclogon
+ * yang hanya dibayar CreateProcessWithTokenW.
+ *
+ * --trace=FILE merekam semua panggilan backend ke trace biner (format sama
+ * dengan RasTI.exe /trace:FILE) untuk diputar ulang dengan rasti_trace_replay.
+ *
+ * Usage:
+ *   rasti_launch_bench [--iterations=N] [--host=direct|impersonation]
+ *                      [--open-latency-us=N] [--lookup-latency-us=N]
+ *                      [--logon-latency-us=N] [--create-latency-us=N]
+ *                      [--console=auto|new|inherit|none|hidden]
+ *                      [--console-latency-us=N] [--process-commit-kb=N]
+ *                      [--console-commit-kb=N] [--launch-api=auto|seclogon|asuser]
+ *                      [--seclogon-latency-us=N] [--trace=FILE]
+ *
+ * @author RasTI Development Team
+ * @version 1.2.0.0
+ * @date 2025
+ */
+
+#include "TestSupport.h"
+#include "LaunchBenchmark.h"
+#include "BackendTrace.h"
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <memory>
+
+/** @brief Nilai argumen "--key=value" jika arg diawali prefix */
+static bool ReadOption(const std::string& arg, const char* prefix, std::string& value)
+{
+    std::string key(prefix);
+    if (arg.compare(0, key.size(), key) != 0) {
+        return false;
+    }
+    value = arg.substr(key.size());
+    return true;
+}
+
+/** @brief Parse latency mikrodetik non-negatif */
+static bool ParseLatency(const std::string& value, std::chrono::microseconds& latency)
+{
+    char* end = NULL;
+    long parsed = strtol(value.c_str(), &end, 10);
+    if (value.empty() || *end != '\0' || parsed < 0 || parsed > 10 * 1000 * 1000) {
+        return false;
+    }
+    latency = std::chrono::microseconds(parsed);
+    return true;
+}
+
+/** @brief Parse ukuran KB non-negatif ke bytes */
+static bool ParseKilobytes(const std::string& value, uint64_t& bytes)
+{
+    char* end = NULL;
+    long parsed = strtol(value.c_str(), &end, 10);
+    if (value.empty() || *end != '\0' || parsed < 0 || parsed > 1024 * 1024) {
+        return false;
+    }
+    bytes = static_cast<uint64_t>(parsed) * 1024;
+    return true;
+}
+
+int main(int argc, char* argv[]) {
+    FakeFileSystemBackend fs;
+    FakeProcessBackend ps;
+    bool impersonationHost = false;
+    std::string tracePath;
+
+    LaunchBenchmarkOptions options;
+    options.targetPath = L"C:\\Windows\\System32\\cmd.exe";
+    options.arguments = L"/c exit";
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        std::string value;
+        bool valid = true;
+        if (ReadOption(arg, "--iterations=", value)) {
+            long iterations = strtol(value.c_str(), NULL, 10);
+            valid = iterations >= 1 && iterations <= 1000000;
+            options.iterations = static_cast<uint32_t>(iterations);
+        } else if (ReadOption(arg, "--host=", value)) {
+            valid = (value == "direct" || value == "impersonation");
+            impersonationHost = (value == "impersonation");
+        } else if (ReadOption(arg, "--open-latency-us=", value)) {
+            valid = ParseLatency(value, fs.openLatency);
+        } else if (ReadOption(arg, "--lookup-latency-us=", value)) {
+            valid = ParseLatency(value, ps.lookupLatency);
+        } else if (ReadOption(arg, "--logon-latency-us=", value)) {
+            valid = ParseLatency(value, ps.logonLatency);
+        } else if (ReadOption(arg, "--create-latency-us=", value)) {
+            valid = ParseLatency(value, ps.createLatency);
+        } else if (ReadOption(arg, "--console=", value)) {
+            valid = ParseConsoleMode(value, options.console);
+        } else if (ReadOption(arg, "--console-latency-us=", value)) {
+            valid = ParseLatency(value, ps.consoleLatency);
+        } else if (ReadOption(arg, "--process-commit-kb=", value)) {
+            valid = ParseKilobytes(value, ps.processCommitBytes);
+        } else if (ReadOption(arg, "--console-commit-kb=", value)) {
+            valid = ParseKilobytes(value, ps.consoleCommitBytes);
+        } else if (ReadOption(arg, "--launch-api=", value)) {
+            valid = ParseProcessLaunchApi(value, options.launchApi);
+        } else if (ReadOption(arg, "--seclogon-latency-us=", value)) {
+            valid = ParseLatency(value, ps.seclogonLatency);
+        } else if (ReadOption(arg, "--trace=", value)) {
+            tracePath = value;
+            valid = !value.empty();
+        } else {
+            valid = false;
+        }
+
+        if (!valid) {
+            std::cerr << "Invalid option: " << arg << std::endl;
+            std::cerr << "Usage: rasti_launch_bench [--iterations=N] [--host=direct|impersonation] "
+                         "[--open-latency-us=N] [--lookup-latency-us=N] [--logon-latency-us=N] "
+                         "[--create-latency-us=N] [--console=auto|new|inherit|none|hidden] "
+                         "[--console-latency-us=N] [--process-commit-kb=N] [--console-commit-kb=N] "
+                         "[--launch-api=auto|seclogon|asuser] [--seclogon-latency-us=N] [--trace=FILE]" << std::endl;
+            return 2;
+        }
+    }
+
+    fs.files[options.targetPath] = BuildTestPeImage(3);
+    if (impersonationHost) {
+        FakeProcessBackend::ConfigureImpersonationHost(ps);
+        // Token winlogon.exe (SYSTEM) juga memegang privilege CreateProcessAsUserW
+        ps.impersonatedPrivileges.insert(SE_ASSIGNPRIMARYTOKEN_PRIVILEGE);
+        ps.impersonatedPrivileges.insert(SE_INCREASE_QUOTA_PRIVILEGE);
+    } else {
+        FakeProcessBackend::ConfigureDirectTcbHost(ps);
+    }
+    ps.recordCalls = false;
+    if (ps.processCommitBytes > 0 || ps.consoleCommitBytes > 0) {
+        options.commitProbe = [&ps](uint64_t& bytes) {
+            bytes = ps.committedBytes;
+            return true;
+        };
+    }
+
+    SetFileSystemBackend(&fs);
+    SetProcessBackend(&ps);
+
+    // Recorder dipasang di atas backend palsu; ditutup sebelum file di-flush
+    std::ofstream traceFile;
+    std::unique_ptr<ScopedBackendTrace> trace;
+    if (!tracePath.empty()) {
+        traceFile.open(tracePath.c_str(), std::ios::binary | std::ios::trunc);
+        if (!traceFile) {
+            std::cerr << "Cannot create trace file: " << tracePath << std::endl;
+            return 2;
+        }
+        BackendTraceSession session;
+        session.operation = L"bench";
+        session.target = options.targetPath;
+        session.arguments = options.arguments;
+        session.iterations = options.iterations;
+        session.priority = options.priority;
+        session.console = options.console;
+        session.launchApi = options.launchApi;
+        trace.reset(new ScopedBackendTrace(session, [&traceFile](const uint8_t* data, size_t size) {
+            traceFile.write(reinterpret_cast<const char*>(data), size);
+        }));
+    }
+
+    std::cout << "console: " << GetConsoleModeName(options.console)
+              << ", launch api: " << GetProcessLaunchApiName(options.launchApi) << std::endl;
+    LaunchBenchmarkReport report;
+    bool success = RunLaunchBenchmark(options, report);
+    std::cout << FormatLaunchBenchmarkReport(report);
+
+    if (trace) {
+        std::cout << trace->GetRecordCount() << " backend calls recorded to " << tracePath << std::endl;
+        trace.reset();
+        traceFile.close();
+        success = success && !traceFile.fail();
+    }
+
+    SetProcessBackend(NULL);
+    SetFileSystemBackend(NULL);
+    return success ? 0 : 1;
+}
@@ -0,0 +1,256 @@
+/**
+ * @file Microbenchmark.cpp
+ * @brief Implementasi harness microbenchmark dan baseline JSON
+ *
+ * @author RasTI Development Team
+ * @version 1.2.0.0
+ * @date 2025
+ */
+
+#include "Microbenchmark.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <sstream>
+
+//==============================================================================
+// EXECUTION
+//==============================================================================
+
+/** @brief Batas iterasi per batch (mencegah loop tak berujung pada case kosong) */
+static const uint64_t MAX_BATCH_ITERATIONS = 1ull << 30;
+
+/** @brief Menjalankan body sebanyak iterations kali; mengembalikan durasi ns */
+static double TimeBatch(const MicrobenchmarkCase& benchmark, uint64_t iterations, uint64_t& counter)
+{
+    auto start = std::chrono::steady_clock::now();
+    for (uint64_t i = 0; i < iterations; i++) {
+        benchmark.body(counter++);
+    }
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(end - start).count();
+}
+
+MicrobenchmarkResult RunMicrobenchmark(const MicrobenchmarkCase& benchmark, const MicrobenchmarkOptions& options)
+{
+    MicrobenchmarkResult result;
+    result.name = benchmark.name;
+    result.allocationsPerOp = -1.0;
+
+    if (benchmark.setup) {
+        benchmark.setup();
+    }
+
+    // Kalibrasi: perbesar batch sampai mencapai minBatchMs (sekaligus warmup
+    // cache dan lazy state seperti PATH index atau hash cache)
+    const double minBatchNs = options.minBatchMs * 1e6;
+    uint64_t counter = 0;
+    uint64_t iterations = 1;
+    for (;;) {
+        double elapsed = TimeBatch(benchmark, iterations, counter);
+        if (elapsed >= minBatchNs || iterations >= MAX_BATCH_ITERATIONS) {
+            break;
+        }
+
+        // Estimasi dari durasi terakhir dengan margin 20%, minimal dua kali lipat
+        double estimate = elapsed > 0.0 ? iterations * (minBatchNs / elapsed) * 1.2 : iterations * 10.0;
+        uint64_t next = static_cast<uint64_t>(std::min(estimate, static_cast<double>(MAX_BATCH_ITERATIONS)));
+        iterations = std::max(iterations * 2, next);
+    }
+
+    // Batch terukur: ns/op terbaik (noise scheduler/frekuensi CPU hanya
+    // memperlambat), alokasi total dibagi total operasi
+    std::vector<double> samples;
+    long allocations = 0;
+    int batches = std::max(1, options.batches);
+    for (int batch = 0; batch < batches; batch++) {
+        long before = options.allocationCounter ? options.allocationCounter() : 0;
+        double elapsed = TimeBatch(benchmark, iterations, counter);
+        long after = options.allocationCounter ? options.allocationCounter() : 0;
+
+        samples.push_back(elapsed / static_cast<double>(iterations));
+        allocations += after - before;
+    }
+
+    if (benchmark.teardown) {
+        benchmark.teardown();
+    }
+
+    result.iterations = iterations;
+    result.nsPerOp = *std::min_element(samples.begin(), samples.end());
+    if (options.allocationCounter) {
+        result.allocationsPerOp = static_cast<double>(allocations) / (static_cast<double>(iterations) * batches);
+    }
+    return result;
+}
+
+void PrintMicrobenchmarkResults(const std::vector<MicrobenchmarkResult>& results, std::ostream& out)
+{
+    std::ios::fmtflags flags = out.flags();
+    out << std::left << std::setw(40) << "Benchmark" << std::right
+        << std::setw(14) << "ns/op" << std::setw(12) << "allocs/op" << std::setw(14) << "iterations" << std::endl;
+    for (const MicrobenchmarkResult& result : results) {
+        out << std::left << std::setw(40) << result.name << std::right << std::fixed
+            << std::setw(14) << std::setprecision(1) << result.nsPerOp;
+        if (result.allocationsPerOp < 0.0) {
+            out << std::setw(12) << "-";
+        } else {
+            out << std::setw(12) << std::setprecision(2) << result.allocationsPerOp;
+        }
+        out << std::setw(14) << result.iterations << std::endl;
+    }
+    out.flags(flags);
+}
+
+//==============================================================================
+// BASELINE JSON
+//==============================================================================
+
+/** @brief Escape minimal string JSON (nama benchmark ASCII) */
+static void AppendJsonString(std::ostringstream& out, const std::string& text)
+{
+    out << '"';
+    for (char ch : text) {
+        if (ch == '"' || ch == '\\') {
+            out << '\\';
+        }
+        out << ch;
+    }
+    out << '"';
+}
+
+std::string FormatMicrobenchmarkBaseline(const std::vector<MicrobenchmarkResult>& results)
+{
+    std::ostringstream out;
+    out << "{\n  \"version\": 1,\n  \"benchmarks\": [\n";
+    for (size_t i = 0; i < results.size(); i++) {
+        const MicrobenchmarkResult& result = results[i];
+        out << "    {\"name\": ";
+        AppendJsonString(out, result.name);
+        out << std::fixed << std::setprecision(3)
+            << ", \"ns_per_op\": " << result.nsPerOp
+            << ", \"allocs_per_op\": " << result.allocationsPerOp
+            << ", \"iterations\": " << result.iterations << "}"
+            << (i + 1 < results.size() ? ",\n" : "\n");
+    }
+    out << "  ]\n}\n";
+    return out.str();
+}
+
+/** @brief Membaca nilai numerik key di dalam object [begin, end) */
+static bool FindJsonNumber(const std::string& json, size_t begin, size_t end, const char* key, double& value)
+{
+    std::string quoted = std::string("\"") + key + "\"";
+    size_t position = json.find(quoted, begin);
+    if (position == std::string::npos || position >= end) {
+        return false;
+    }
+    position = json.find(':', position + quoted.size());
+    if (position == std::string::npos || position >= end) {
+        return false;
+    }
+
+    const char* start = json.c_str() + position + 1;
+    char* parsed = NULL;
+    value = strtod(start, &parsed);
+    return parsed != start;
+}
+
+bool ParseMicrobenchmarkBaseline(const std::string& json, std::vector<MicrobenchmarkResult>& results)
+{
+    results.clear();
+
+    // Format sendiri: setiap case adalah object datar {"name": ..., ...}
+    size_t position = 0;
+    while ((position = json.find("\"name\"", position)) != std::string::npos) {
+        size_t objectEnd = json.find('}', position);
+        size_t open = json.find('"', json.find(':', position) + 1);
+        if (objectEnd == std::string::npos || open == std::string::npos || open > objectEnd) {
+            break;
+        }
+
+        MicrobenchmarkResult result;
+        size_t cursor = open + 1;
+        while (cursor < objectEnd && json[cursor] != '"') {
+            if (json[cursor] == '\\' && cursor + 1 < objectEnd) {
+                cursor++;
+            }
+            result.name += json[cursor++];
+        }
+
+        double iterations = 0.0;
+        bool valid = FindJsonNumber(json, cursor, objectEnd, "ns_per_op", result.nsPerOp);
+        if (!FindJsonNumber(json, cursor, objectEnd, "allocs_per_op", result.allocationsPerOp)) {
+            result.allocationsPerOp = -1.0;
+        }
+        if (FindJsonNumber(json, cursor, objectEnd, "iterations", iterations)) {
+            result.iterations = static_cast<uint64_t>(iterations);
+        }
+        if (valid && !result.name.empty()) {
+            results.push_back(result);
+        }
+        position = objectEnd;
+    }
+    return !results.empty();
+}
+
+//==============================================================================
+// COMPARISON
+//==============================================================================
+
+std::vector<MicrobenchmarkComparison> CompareMicrobenchmarks(const std::vector<MicrobenchmarkResult>& current,
+                                                             const std::vector<MicrobenchmarkResult>& baseline,
+                                                             double thresholdPercent)
+{
+    std::vector<MicrobenchmarkComparison> comparison;
+    for (const MicrobenchmarkResult& result : current) {
+        auto it = std::find_if(baseline.begin(), baseline.end(), [&](const MicrobenchmarkResult& entry) {
+            return entry.name == result.name;
+        });
+        if (it == baseline.end()) {
+            continue;
+        }
+
+        MicrobenchmarkComparison entry;
+        entry.name = result.name;
+        entry.baselineNsPerOp = it->nsPerOp;
+        entry.currentNsPerOp = result.nsPerOp;
+        entry.changePercent = it->nsPerOp > 0.0 ? (result.nsPerOp - it->nsPerOp) / it->nsPerOp * 100.0 : 0.0;
+        entry.baselineAllocationsPerOp = it->allocationsPerOp;
+        entry.currentAllocationsPerOp = result.allocationsPerOp;
+
+        // Alokasi hanya dibandingkan jika kedua sisi mengukurnya
+        bool moreAllocations = it->allocationsPerOp >= 0.0 && result.allocationsPerOp >= 0.0 &&
+                               result.allocationsPerOp > it->allocationsPerOp + 0.05;
+        entry.regression = entry.changePercent > thresholdPercent || moreAllocations;
+        comparison.push_back(entry);
+    }
+    return comparison;
+}
+
+int PrintMicrobenchmarkComparison(const std::vector<MicrobenchmarkComparison>& comparison, std::ostream& out)
+{
+    std::ios::fmtflags flags = out.flags();
+    int regressions = 0;
+    out << std::left << std::setw(40) << "Benchmark" << std::right
+        << std::setw(14) << "base ns/op" << std::setw(14) << "ns/op" << std::setw(10) << "change"
+        << std::setw(16) << "allocs/op" << std::endl;
+    for (const MicrobenchmarkComparison& entry : comparison) {
+        std::ostringstream allocations;
+        allocations << std::fixed << std::setprecision(2)
+                    << entry.baselineAllocationsPerOp << "->" << entry.currentAllocationsPerOp;
+
+        out << std::left << std::setw(40) << entry.name << std::right << std::fixed << std::setprecision(1)
+            << std::setw(14) << entry.baselineNsPerOp << std::setw(14) << entry.currentNsPerOp
+            << std::setw(9) << std::showpos << entry.changePercent << std::noshowpos << "%"
+            << std::setw(16) << allocations.str()
+            << (entry.regression ? "  REGRESSION" : "") << std::endl;
+        if (entry.regression) {
+            regressions++;
+        }
+    }
+    out.flags(flags);
+    return regressions;
+}
@@ -0,0 +1,137 @@
+/**
+ * @file Microbenchmark.h
+ * @brief Harness microbenchmark per function: ns/op, alokasi/op, baseline JSON
+ *
+ * Setiap case dijalankan dalam batch yang dikalibrasi sampai durasi batch
+ * cukup panjang untuk resolusi steady_clock, lalu ns/op diambil dari batch
+ * tercepat (noise hanya dapat memperlambat, sehingga minimum paling stabil).
+ * Alokasi dihitung melalui counter operator new milik runner (Test.cpp atau
+ * BenchmarkMain.cpp) sehingga harness tidak mengganti operator new sendiri.
+ *
+ * Hasil dapat disimpan sebagai baseline JSON dan dibandingkan dengan run
+ * berikutnya; case yang melambat melebihi threshold atau menambah alokasi
+ * ditandai sebagai regresi.
+ *
+ * Header ini portable (tidak bergantung pada Windows.h maupun VCL).
+ *
+ * @author RasTI Development Team
+ * @version 1.2.0.0
+ * @date 2025
+ */
+
+#ifndef RASTI_MICROBENCHMARK_H
+#define RASTI_MICROBENCHMARK_H
+
+#include <cstdint>
+#include <functional>
+#include <ostream>
+#include <string>
+#include <vector>
+
+//==============================================================================
+// BENCHMARK CASES
+//==============================================================================
+
+/**
+ * @brief Satu microbenchmark: satu function Core dengan satu set input
+ *
+ * body dipanggil sekali per operasi dengan nomor iterasi, sehingga case dapat
+ * berputar di atas set input realistis tanpa alokasi di harness.
+ */
+struct MicrobenchmarkCase {
+    std::string name;                        /**< Nama unik, misalnya "SanitizePath" */
+    std::function<void()> setup;             /**< Pasang backend/fixture (opsional) */
+    std::function<void(uint64_t)> body;      /**< Satu operasi */
+    std::function<void()> teardown;          /**< Lepas backend/fixture (opsional) */
+};
+
+/** @brief Opsi eksekusi microbenchmark */
+struct MicrobenchmarkOptions {
+    double minBatchMs = 20.0;                /**< Durasi minimum satu batch terukur */
+    int batches = 5;                         /**< Jumlah batch; ns/op = batch tercepat */
+    std::function<long()> allocationCounter; /**< Total alokasi operator new (opsional) */
+};
+
+/** @brief Hasil satu microbenchmark */
+struct MicrobenchmarkResult {
+    std::string name;
+    uint64_t iterations = 0;                 /**< Operasi per batch */
+    double nsPerOp = 0.0;                    /**< ns/op batch tercepat */
+    double allocationsPerOp = 0.0;           /**< Alokasi heap per operasi (-1 jika tidak diukur) */
+};
+
+/**
+ * @brief Menjalankan satu case: warmup, kalibrasi jumlah iterasi, lalu batch terukur
+ */
+MicrobenchmarkResult RunMicrobenchmark(const MicrobenchmarkCase& benchmark, const MicrobenchmarkOptions& options);
+
+/**
+ * @brief Menulis tabel hasil (nama, ns/op, alokasi/op, iterasi)
+ */
+void PrintMicrobenchmarkResults(const std::vector<MicrobenchmarkResult>& results, std::ostream& out);
+
+//==============================================================================
+// BASELINE AND COMPARISON
+//==============================================================================
+
+/**
+ * @brief Serialisasi hasil sebagai baseline JSON (satu object per case)
+ */
+std::string FormatMicrobenchmarkBaseline(const std::vector<MicrobenchmarkResult>& results);
+
+/**
+ * @brief Membaca baseline JSON yang ditulis FormatMicrobenchmarkBaseline
+ *
+ * @param json Isi file baseline
+ * @param results Output hasil baseline
+ * @return false jika tidak ada case yang dapat dibaca
+ */
+bool ParseMicrobenchmarkBaseline(const std::string& json, std::vector<MicrobenchmarkResult>& results);
+
+/** @brief Perbandingan satu case terhadap baseline */
+struct MicrobenchmarkComparison {
+    std::string name;
+    double baselineNsPerOp = 0.0;
+    double currentNsPerOp = 0.0;
+    double changePercent = 0.0;              /**< (current - baseline) / baseline * 100 */
+    double baselineAllocationsPerOp = 0.0;
+    double currentAllocationsPerOp = 0.0;
+    bool regression = false;                 /**< Lebih lambat dari threshold atau alokasi bertambah */
+};
+
+/**
+ * @brief Membandingkan hasil run saat ini dengan baseline
+ *
+ * Case yang tidak ada di baseline dilewati. Alokasi/op bersifat deterministik,
+ * sehingga setiap kenaikan (lebih dari pembulatan) dianggap regresi.
+ *
+ * @param current Hasil run saat ini
+ * @param baseline Hasil baseline
+ * @param thresholdPercent Perlambatan maksimum yang ditoleransi (persen)
+ * @return Satu entry per case yang ada di kedua sisi
+ */
+std::vector<MicrobenchmarkComparison> CompareMicrobenchmarks(const std::vector<MicrobenchmarkResult>& current,
+                                                             const std::vector<MicrobenchmarkResult>& baseline,
+                                                             double thresholdPercent);
+
+/**
+ * @brief Menulis tabel perbandingan; mengembalikan jumlah regresi
+ */
+int PrintMicrobenchmarkComparison(const std::vector<MicrobenchmarkComparison>& comparison, std::ostream& out);
+
+//==============================================================================
+// CORE BENCHMARKS (CoreBenchmarks.cpp)
+//==============================================================================
+
+/**
+ * @brief Microbenchmark portable untuk function Core di atas backend palsu
+ *
+ * Mencakup SanitizePath, GetCanonicalPath, IsPathTraversalSafe,
+ * FindExecutableInPath (PATH scan dan index), IsValidExecutable,
+ * ValidateExecutable, dan akuisisi token Trusted Installer tersimulasi
+ * (host TCB langsung dan host impersonation). Fixture dibagi antar case dan
+ * hidup selama salah satu case masih ada.
+ */
+std::vector<MicrobenchmarkCase> CreateCoreMicrobenchmarks();
+
+#endif
@@ -0,0 +1,87 @@
+/**
+ * @file PortableMain.cpp
+ * @brief Test runner portable (Linux/GCC/Clang) untuk RasTI Core
+ *
+ * Menjalankan test di PortableTests.cpp terhadap backend palsu tanpa
+ * Windows maupun VCL. Dibangun oleh CMakeLists.txt dan dijalankan dengan
+ * ctest; exit code 0 jika semua test pass.
+ *
+ * Suite lengkap (termasuk test yang memanggil Win32 API) tetap berada di
+ * Test.cpp dan dibangun dengan Test.cbproj.
+ *
+ * @author RasTI Development Team
+ * @version 1.2.0.0
+ * @date 2025
+ */
+
+#include "TestSupport.h"
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+/** @brief Satu test portable yang didaftarkan di runner */
+struct PortableTest {
+    const char* name;   /**< Nama test (sama dengan Test.cpp) */
+    bool (*func)();     /**< Test function */
+};
+
+int main(int argc, char* argv[]) {
+    // Filter opsional: hanya jalankan test yang namanya mengandung argv[1]
+    std::string filter = argc > 1 ? argv[1] : "";
+
+    const std::vector<PortableTest> tests = {
+        {"ValidationSyscallCount", TestValidationSyscallCount},
+        {"LongPathValidation", TestLongPathValidation},
+        {"Sha256KnownVectors", TestSha256KnownVectors},
+        {"HashAllowlistValidation", TestHashAllowlistValidation},
+        {"HashCacheBenchmark", TestHashCacheBenchmark},
+        {"PathPolicyEngine", TestPathPolicyEngine},
+        {"PathPolicyBenchmark", TestPathPolicyBenchmark},
+        {"BulkValidationOutput", TestBulkValidationOutput},
+        {"BulkValidationThroughput", TestBulkValidationThroughput},
+        {"WorkStealingScheduler", TestWorkStealingScheduler},
+        {"FileOperations", TestFileOperations},
+        {"AclReset", TestAclReset},
+        {"RegistryImport", TestRegistryImport},
+        {"ScriptHost", TestScriptHost},
+        {"OutputCapture", TestOutputCapture},
+        {"TrustedInstallerAcquisition", TestTrustedInstallerAcquisition},
+        {"RunAsTrustedInstaller", TestRunAsTrustedInstaller},
+        {"CApi", TestCApi},
+        {"MicrobenchmarkBaseline", TestMicrobenchmarkBaseline},
+        {"LaunchBenchmark", TestLaunchBenchmark},
+        {"ConsoleModeLaunch", TestConsoleModeLaunch},
+        {"LaunchApiSelection", TestLaunchApiSelection},
+        {"BackendTraceReplay", TestBackendTraceReplay},
+        {"LaunchPipeline", TestLaunchPipeline},
+        {"LaunchGraph", TestLaunchGraph},
+        {"Supervisor", TestSupervisor},
+        {"ProcessAdjust", TestProcessAdjust},
+        {"SessionLaunch", TestSessionLaunch},
+        {"SingleInstance", TestSingleInstance},
+        {"CaptureAccounting", TestCaptureAccounting}
+    };
+
+    int passed = 0;
+    int run = 0;
+    for (const PortableTest& test : tests) {
+        if (!filter.empty() && std::string(test.name).find(filter) == std::string::npos) {
+            continue;
+        }
+
+        std::cout << "[ RUN  ] " << test.name << std::endl;
+        auto start = std::chrono::steady_clock::now();
+        bool result = test.func();
+        double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+        std::cout << (result ? "[ PASS ] " : "[ FAIL ] ") << test.name
+                  << " (" << std::fixed << std::setprecision(1) << ms << " ms)" << std::endl;
+        run++;
+        if (result) passed++;
+    }
+
+    std::cout << std::endl << passed << "/" << run << " portable tests passed" << std::endl;
+    return (run > 0 && passed == run) ? 0 : 1;
+}
@@ -0,0 +1,3892 @@
+/**
+ * @file PortableTests.cpp
+ * @brief Unit test portable untuk pipeline validasi dan akuisisi Trusted Installer
+ *
+ * Semua test di file ini hanya memakai backend palsu dari TestSupport.h,
+ * sehingga hasilnya deterministik dan dapat dijalankan di Windows (Test.cpp)
+ * maupun Linux (PortableMain.cpp, ctest).
+ *
+ * @author RasTI Development Team
+ * @version 1.2.0.0
+ * @date 2025
+ */
+
+#include "TestSupport.h"
+#include "HashAllowlist.h"
+#include "PathPolicy.h"
+#include "BulkValidation.h"
+#include "WorkStealingScheduler.h"
+#include "FileOperations.h"
+#include "AclReset.h"
+#include "RegistryImport.h"
+#include "ScriptHost.h"
+#include "OutputCapture.h"
+#include "Sha256.h"
+#include "Microbenchmark.h"
+#include "LaunchBenchmark.h"
+#include "LaunchPipeline.h"
+#include "LaunchGraph.h"
+#include "Supervisor.h"
+#include "ProcessAdjust.h"
+#include "SessionLaunch.h"
+#include "SingleInstance.h"
+#include "BackendTrace.h"
+#include "RasTIApi.h"
+#include <atomic>
+#include <cmath>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+
+//==============================================================================
+// VALIDATION PIPELINE TESTS
+//==============================================================================
+
+/**
+ * @brief Test jumlah syscall pipeline validasi satu handle (REGRESSION GUARD)
+ *
+ * Menggunakan FakeFileSystemBackend untuk memastikan ValidateExecutable
+ * canonicalize satu kali, membuka file satu kali, dan menjalankan identity +
+ * PE check dari handle yang sama. Angka yang di-assert adalah budget syscall:
+ * jika bertambah, ada tahap yang kembali me-resolve path.
+ */
+bool TestValidationSyscallCount() {
+    std::cout << "Testing single-handle validation syscall budget..." << std::endl;
+
+    FakeFileSystemBackend fake;
+    fake.files[L"C:\\Tools\\app.exe"] = BuildTestPeImage(3);
+    fake.files[L"C:\\Tools\\run.cmd"] = std::vector<uint8_t>(16, 'x');
+    fake.files[L"C:\\Tools\\fake.exe"] = std::vector<uint8_t>(512, 'x');
+    fake.files[L"C:\\Bin\\tool.exe"] = BuildTestPeImage(2);
+    fake.pathVariable = L"C:\\Missing; \"C:\\Bin\"";
+    SetFileSystemBackend(&fake);
+
+    // TEST 1: Absolute PE path = 1 canonicalize + 1 open + 1 identity + 1 read
+    {
+        ValidatedExecutable validated;
+        ValidationError result = ValidateExecutable(L"C:\\Tools\\app.exe", validated);
+        TEST_ASSERT(result == VALIDATION_OK, "Absolute PE path should validate");
+        TEST_ASSERT(fake.fullPathCalls == 1 && fake.openCalls == 1,
+                    "Absolute path should be canonicalized and opened once");
+        TEST_ASSERT(fake.identityCalls == 1 && fake.readCalls == 1,
+                    "Identity and header should be read once from the open handle");
+        TEST_ASSERT(fake.TotalCalls() == 4, "Absolute PE path should take four syscalls");
+        TEST_ASSERT(validated.image.subsystem == 3 && validated.image.is64Bit,
+                    "PE header should give the subsystem and bitness");
+
+        // Handle harus tetap terbuka selama ValidatedExecutable hidup (anti-TOCTOU)
+        TEST_ASSERT(fake.openHandles == 1 && validated.file.IsValid(),
+                    "Handle should stay open while the validated executable lives");
+    }
+    TEST_ASSERT(fake.openHandles == 0, "Handle should close with the validated executable");
+
+    // TEST 2: Extension tidak diizinkan ditolak tanpa menyentuh filesystem
+    fake.ResetCounters();
+    {
+        ValidatedExecutable validated;
+        TEST_ASSERT(ValidateExecutable(L"C:\\Tools\\readme.txt", validated) == VALIDATION_BAD_EXTENSION,
+                    "Disallowed extension should be rejected");
+        TEST_ASSERT(fake.TotalCalls() == 0, "Disallowed extension should not touch the filesystem");
+    }
+
+    // TEST 3: Script tidak memerlukan PE read
+    fake.ResetCounters();
+    {
+        ValidatedExecutable validated;
+        TEST_ASSERT(ValidateExecutable(L"C:\\Tools\\run.cmd", validated) == VALIDATION_OK, "Script should validate");
+        TEST_ASSERT(validated.kind == EXECUTABLE_KIND_SCRIPT, "Script should be classified as a script");
+        TEST_ASSERT(fake.readCalls == 0 && fake.TotalCalls() == 3, "Script should skip the PE read");
+    }
+
+    // TEST 4: PATH fallback - open langsung dipakai sebagai existence probe
+    fake.ResetCounters();
+    {
+        ValidatedExecutable validated;
+        TEST_ASSERT(ValidateExecutable(L"tool.exe", validated) == VALIDATION_OK, "PATH fallback should validate");
+        TEST_ASSERT(validated.path == L"C:\\Bin\\tool.exe",
+                    "PATH fallback should resolve through the quoted PATH entry");
+        // canonicalize input + open cwd + PATH env + 2 open PATH + canonicalize hasil + identity + read
+        TEST_ASSERT(fake.openCalls == 3 && fake.environmentCalls == 1, "PATH fallback should probe by opening");
+        TEST_ASSERT(fake.TotalCalls() == 8, "PATH fallback should stay within eight syscalls");
+    }
+
+    // TEST 5: File .exe tanpa PE header ditolak dan handle langsung ditutup
+    fake.ResetCounters();
+    {
+        ValidatedExecutable validated;
+        TEST_ASSERT(ValidateExecutable(L"C:\\Tools\\fake.exe", validated) == VALIDATION_NOT_PE_IMAGE,
+                    "Executable without a PE header should be rejected");
+        TEST_ASSERT(!validated.file.IsValid() && fake.openHandles == 0, "Rejected executable should close its handle");
+    }
+
+    // TEST 6: Alur CLI/GUI (SanitizePath + pipeline) menggunakan backend yang sama;
+    // path absolute tidak membaca current directory
+    fake.ResetCounters();
+    {
+        std::wstring path = L"  C:/Tools//app.exe ";
+        ValidatedExecutable validated;
+        TEST_ASSERT(SanitizePath(path) && (path == L"C:\\Tools\\app.exe"), "Sanitized path should be normalized");
+        TEST_ASSERT(ValidateExecutable(path, validated) == VALIDATION_OK, "Sanitized path should validate");
+        TEST_ASSERT(fake.TotalCalls() == 4, "Sanitized absolute path should take four syscalls");
+        TEST_ASSERT(ValidateExecutable(L"C:\\Tools\\missing.exe", validated) != VALIDATION_OK,
+                    "Missing executable should be rejected");
+    }
+
+    // TEST 7: Relative path dengan direktori memakai current directory dari backend
+    fake.ResetCounters();
+    {
+        std::wstring path = L"Tools\\app.exe";
+        fake.currentDirectory = L"C:\\";
+        TEST_ASSERT(SanitizePath(path) && (path == L"C:\\Tools\\app.exe"),
+                    "Relative path should be resolved against the current directory");
+        TEST_ASSERT(fake.currentDirectoryCalls == 1, "Relative path should read the current directory once");
+        fake.currentDirectory = L"C:\\Work";
+    }
+
+    SetFileSystemBackend(NULL);
+
+    TEST_PASS("Single-handle validation pipeline syscall budget holds");
+}
+
+/**
+ * @brief Test long path (> MAX_PATH) dan nama file non-ANSI di pipeline UTF-16
+ *
+ * Sebelumnya path > MAX_PATH ditolak dan nama file di luar code page ANSI
+ * rusak menjadi '?' saat konversi. Pipeline wide harus menerima keduanya.
+ */
+bool TestLongPathValidation() {
+    std::cout << "Testing long path and Unicode validation..." << std::endl;
+
+    // TEST 1: ToExtendedLengthPath hanya mengubah path >= MAX_PATH
+    std::wstring deepDir = L"C:\\Deep";
+    while (deepDir.size() < 400) {
+        deepDir += L"\\segment0123456789";
+    }
+    std::wstring longExe = deepDir + L"\\app.exe";
+    std::wstring longUnc = L"\\\\server\\share" + deepDir.substr(2) + L"\\app.exe";
+
+    TEST_ASSERT(ToExtendedLengthPath(L"C:\\Tools\\app.exe") == L"C:\\Tools\\app.exe",
+                "Short paths should not be prefixed");
+    TEST_ASSERT(ToExtendedLengthPath(longExe) == L"\\\\?\\" + longExe,
+                "Long drive paths should get the \\\\?\\ prefix");
+    TEST_ASSERT(ToExtendedLengthPath(longUnc) == L"\\\\?\\UNC" + longUnc.substr(1),
+                "Long UNC paths should become \\\\?\\UNC\\server\\share");
+    TEST_ASSERT(ToExtendedLengthPath(L"\\\\?\\" + longExe) == L"\\\\?\\" + longExe,
+                "Already prefixed paths should be unchanged");
+
+    // TEST 2: Prefix \\?\ bukan karakter berbahaya, tetapi traversal tetap ditolak
+    TEST_ASSERT(IsPathTraversalSafe(L"\\\\?\\C:\\Tools\\app.exe"), "Extended-length prefix should be allowed");
+    TEST_ASSERT(!IsPathTraversalSafe(L"\\\\?\\C:\\Tools\\..\\app.exe"), "Traversal after prefix should be rejected");
+    TEST_ASSERT(!IsPathTraversalSafe(L"C:\\Tools\\?\\app.exe"), "Wildcard outside prefix should be rejected");
+
+    FakeFileSystemBackend fake;
+    std::wstring unicodeExe = L"C:\\Tools\\\u30c4\u30fc\u30eb\\\u00e9diteur.exe";
+    fake.files[longExe] = BuildTestPeImage(2);
+    fake.files[unicodeExe] = BuildTestPeImage(2);
+    SetFileSystemBackend(&fake);
+
+    bool passed = true;
+
+    // TEST 3: Path 400+ karakter lolos pipeline dengan budget syscall yang sama
+    {
+        ValidatedExecutable validated;
+        passed = passed && (ValidateExecutable(longExe, validated) == VALIDATION_OK);
+        passed = passed && (validated.path == longExe && fake.TotalCalls() == 4);
+    }
+
+    // TEST 4: Nama file non-ANSI tidak melewati konversi code page
+    fake.ResetCounters();
+    {
+        ValidatedExecutable validated;
+        passed = passed && (ValidateExecutable(unicodeExe, validated) == VALIDATION_OK);
+        passed = passed && (validated.path == unicodeExe);
+    }
+
+    SetFileSystemBackend(NULL);
+    TEST_ASSERT(passed, "Long and non-ANSI paths should validate through the UTF-16 pipeline");
+
+    TEST_PASS("Long path and Unicode validation works correctly");
+}
+
+/**
+ * @brief Test SHA-256 terhadap test vector FIPS 180-4 dan hashing streaming
+ */
+bool TestSha256KnownVectors() {
+    std::cout << "Testing SHA-256 implementation..." << std::endl;
+    std::cout << "SHA-NI acceleration: " << (Sha256::IsHardwareAccelerated() ? "yes" : "no") << std::endl;
+
+    TEST_ASSERT(Sha256ToHex(ComputeSha256("", 0)) ==
+                "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855", "Empty input digest");
+    TEST_ASSERT(Sha256ToHex(ComputeSha256("abc", 3)) ==
+                "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad", "\"abc\" digest");
+
+    const char* twoBlocks = "abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq";
+    TEST_ASSERT(Sha256ToHex(ComputeSha256(twoBlocks, strlen(twoBlocks))) ==
+                "248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1", "Two-block message digest");
+
+    // Satu juta 'a' di-hash dengan ukuran chunk tidak rata harus sama dengan one-shot
+    std::vector<uint8_t> million(1000000, 'a');
+    Sha256 hasher;
+    size_t offset = 0;
+    for (size_t chunk = 1; offset < million.size(); chunk = (chunk * 7 + 3) % 997) {
+        size_t take = std::min(chunk, million.size() - offset);
+        hasher.Update(million.data() + offset, take);
+        offset += take;
+    }
+    std::string expected = "cdc76e5c9914fb9281a1c7e284d73e67f1809a48a497200e046d39ccc7112cd0";
+    TEST_ASSERT(Sha256ToHex(hasher.Final()) == expected, "Streaming digest should match FIPS vector");
+    TEST_ASSERT(Sha256ToHex(ComputeSha256(million.data(), million.size())) == expected, "One-shot digest should match FIPS vector");
+
+    Sha256Digest parsed;
+    TEST_ASSERT(ParseSha256Hex("BA7816BF8F01CFEA414140DE5DAE2223B00361A396177A9CB410FF61F20015AD", parsed), "Uppercase hex should parse");
+    TEST_ASSERT(parsed == ComputeSha256("abc", 3), "Parsed digest should round-trip");
+    TEST_ASSERT(!ParseSha256Hex("ba7816bf", parsed), "Short hex should be rejected");
+
+    TEST_PASS("SHA-256 matches FIPS 180-4 test vectors");
+}
+
+/**
+ * @brief Test penerapan allowlist SHA-256 di pipeline validasi
+ */
+bool TestHashAllowlistValidation() {
+    std::cout << "Testing SHA-256 executable allowlist..." << std::endl;
+
+    FakeFileSystemBackend fake;
+    fake.files[L"C:\\Tools\\approved.exe"] = BuildTestPeImage(2);
+    fake.files[L"C:\\Tools\\other.exe"] = BuildTestPeImage(3);
+    std::string approvedHex = Sha256ToHex(ComputeSha256(fake.files[L"C:\\Tools\\approved.exe"].data(),
+                                                       fake.files[L"C:\\Tools\\approved.exe"].size()));
+
+    // TEST 1: Format sha256sum, komentar, dan baris kosong
+    HashAllowlist allowlist;
+    size_t errorLine = 0;
+    std::string text = "# Approved tools\n\n" + approvedHex + "  C:\\Tools\\approved.exe\r\n";
+    TEST_ASSERT(allowlist.LoadFromText(text, &errorLine), "Valid allowlist should load");
+    TEST_ASSERT(allowlist.Size() == 1, "Allowlist should contain one digest");
+
+    // TEST 2: Baris rusak membuat seluruh allowlist kosong (fail closed)
+    HashAllowlist broken;
+    TEST_ASSERT(!broken.LoadFromText(approvedHex + "\nnot-a-hash\n", &errorLine), "Malformed allowlist should fail");
+    TEST_ASSERT(errorLine == 2 && broken.Size() == 0, "Malformed allowlist should report the line and stay empty");
+
+    GetFileHashCache().Clear();
+    SetFileSystemBackend(&fake);
+    SetExecutableAllowlist(&allowlist);
+
+    bool passed = true;
+
+    // TEST 3: Hash terdaftar diterima, hash lain ditolak
+    {
+        ValidatedExecutable validated;
+        passed = passed && (ValidateExecutable(L"C:\\Tools\\approved.exe", validated) == VALIDATION_OK);
+        passed = passed && validated.hasSha256 && (Sha256ToHex(validated.sha256) == approvedHex);
+    }
+    {
+        ValidatedExecutable validated;
+        passed = passed && (ValidateExecutable(L"C:\\Tools\\other.exe", validated) == VALIDATION_NOT_ALLOWLISTED);
+        passed = passed && !validated.file.IsValid();
+    }
+
+    // TEST 4: Tanpa allowlist tidak ada hashing sama sekali
+    SetExecutableAllowlist(NULL);
+    fake.ResetCounters();
+    {
+        ValidatedExecutable validated;
+        passed = passed && (ValidateExecutable(L"C:\\Tools\\other.exe", validated) == VALIDATION_OK);
+        passed = passed && !validated.hasSha256 && (fake.mapCalls == 0);
+    }
+
+    SetFileSystemBackend(NULL);
+    GetFileHashCache().Clear();
+    TEST_ASSERT(passed, "Allowlist should gate validation on the SHA-256 of the opened file");
+
+    TEST_PASS("SHA-256 allowlist enforced through the validation pipeline");
+}
+
+/**
+ * @brief Benchmark hash cache: launch ulang binary yang tidak berubah tidak di-hash ulang
+ *
+ * Menggunakan file 64MB di backend palsu. Hash pertama (cold) membaca seluruh
+ * file melalui MapFileView; hash kedua (warm) harus berasal dari cache tanpa
+ * mapping. Mengubah waktu modifikasi harus memaksa hash ulang.
+ */
+bool TestHashCacheBenchmark() {
+    std::cout << "Benchmarking SHA-256 hash cache..." << std::endl;
+
+    const std::wstring installer = L"C:\\Setup\\installer.exe";
+    FakeFileSystemBackend fake;
+    std::vector<uint8_t> image = BuildTestPeImage(2);
+    image.resize(64 * 1024 * 1024, 0xA5);
+    fake.files[installer] = image;
+    fake.lastWriteTimes[installer] = 1000;
+
+    HashAllowlist allowlist;
+    allowlist.Add(ComputeSha256(image.data(), image.size()));
+
+    GetFileHashCache().Clear();
+    SetFileSystemBackend(&fake);
+    SetExecutableAllowlist(&allowlist);
+
+    bool passed = true;
+
+    // Cold: hash seluruh file
+    auto coldStart = std::chrono::high_resolution_clock::now();
+    {
+        ValidatedExecutable validated;
+        passed = passed && (ValidateExecutable(installer, validated) == VALIDATION_OK);
+    }
+    auto coldEnd = std::chrono::high_resolution_clock::now();
+    int coldMaps = fake.mapCalls;
+
+    // Warm: identitas sama - hash dari cache
+    fake.ResetCounters();
+    auto warmStart = std::chrono::high_resolution_clock::now();
+    {
+        ValidatedExecutable validated;
+        passed = passed && (ValidateExecutable(installer, validated) == VALIDATION_OK);
+    }
+    auto warmEnd = std::chrono::high_resolution_clock::now();
+    int warmMaps = fake.mapCalls;
+
+    // File ditulis ulang (waktu modifikasi berubah) - wajib hash ulang dan ditolak
+    fake.files[installer][image.size() - 1] ^= 0xFF;
+    fake.lastWriteTimes[installer] = 2000;
+    fake.ResetCounters();
+    {
+        ValidatedExecutable validated;
+        passed = passed && (ValidateExecutable(installer, validated) == VALIDATION_NOT_ALLOWLISTED);
+        passed = passed && (fake.mapCalls > 0);
+    }
+
+    SetExecutableAllowlist(NULL);
+    SetFileSystemBackend(NULL);
+    GetFileHashCache().Clear();
+
+    double coldMs = std::chrono::duration<double, std::milli>(coldEnd - coldStart).count();
+    double warmMs = std::chrono::duration<double, std::milli>(warmEnd - warmStart).count();
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "  Cold (64 MB hashed): " << coldMs << " ms, " << (coldMs > 0 ? 64.0 * 1000.0 / coldMs : 0.0)
+              << " MB/s, " << coldMaps << " map calls" << std::endl;
+    std::cout << "  Warm (cache hit)   : " << warmMs << " ms, " << warmMaps << " map calls" << std::endl;
+
+    TEST_ASSERT(passed, "Hash cache should serve unchanged files and re-hash modified ones");
+    TEST_ASSERT(coldMaps == 1 && warmMaps == 0, "Warm validation should not map the file again");
+
+    TEST_PASS("Hash cache skips re-hashing unchanged binaries");
+}
+
+/**
+ * @brief Test engine policy path: trie literal, glob, "**", dan prioritas deny
+ */
+bool TestPathPolicyEngine() {
+    std::cout << "Testing path policy engine..." << std::endl;
+
+    PathPolicy policy;
+    size_t errorLine = 0;
+    std::string text =
+        "# Tools yang disetujui\n"
+        "allow C:\\Tools\\**\n"
+        "allow C:\\Windows\\System32\\*.exe\n"
+        "allow \"\\\\fileserver\\deploy\\\"\n"
+        "deny  C:\\Users\\*\\AppData\\**\n"
+        "deny  **\\Temp\\**\n"
+        "allow C:\\Users\\*\\AppData\\Local\\Approved\\tool.exe\n";
+    TEST_ASSERT(policy.LoadFromText(text, &errorLine), "Valid policy should load");
+    TEST_ASSERT(policy.RuleCount() == 6, "Policy should contain six rules");
+
+    // TEST 1: Prefix "**" dan case-insensitive
+    PathPolicyMatch match;
+    TEST_ASSERT(policy.Evaluate(L"C:\\Tools\\bin\\app.exe", &match) == POLICY_DECISION_ALLOWED && match.ruleLine == 2,
+                "Recursive prefix rule should allow nested files");
+    TEST_ASSERT(policy.Evaluate(L"c:/tools/APP.EXE") == POLICY_DECISION_ALLOWED, "Matching should ignore case and slash style");
+    TEST_ASSERT(policy.Evaluate(L"C:\\ToolsX\\app.exe") == POLICY_DECISION_NOT_ALLOWED, "Prefix must match whole components");
+
+    // TEST 2: Glob satu komponen tidak melewati separator
+    TEST_ASSERT(policy.Evaluate(L"C:\\Windows\\System32\\cmd.exe") == POLICY_DECISION_ALLOWED, "Glob should match file name");
+    TEST_ASSERT(policy.Evaluate(L"C:\\Windows\\System32\\drivers\\x.exe") == POLICY_DECISION_NOT_ALLOWED,
+                "Single-component glob must not cross directories");
+    TEST_ASSERT(policy.Evaluate(L"C:\\Windows\\System32\\cmd.com") == POLICY_DECISION_NOT_ALLOWED, "Glob suffix must match");
+
+    // TEST 3: Deny menang atas allow, termasuk "**" di awal pattern
+    TEST_ASSERT(policy.Evaluate(L"C:\\Users\\bob\\AppData\\Local\\Approved\\tool.exe", &match) == POLICY_DECISION_DENIED &&
+                match.ruleLine == 5, "Deny should win over a more specific allow");
+    TEST_ASSERT(policy.Evaluate(L"C:\\Tools\\Temp\\app.exe") == POLICY_DECISION_DENIED, "Leading ** deny should match anywhere");
+
+    // TEST 4: UNC dan prefix extended-length dinormalisasi
+    TEST_ASSERT(policy.Evaluate(L"\\\\?\\UNC\\FileServer\\Deploy\\setup.exe") == POLICY_DECISION_ALLOWED,
+                "\\\\?\\UNC\\ path should match UNC rule");
+    TEST_ASSERT(policy.Evaluate(L"\\\\?\\C:\\Tools\\app.exe") == POLICY_DECISION_ALLOWED, "\\\\?\\ path should match drive rule");
+    TEST_ASSERT(policy.Evaluate(L"C:\\fileserver\\deploy\\setup.exe") == POLICY_DECISION_NOT_ALLOWED,
+                "UNC rule must not match a drive path");
+
+    // TEST 5: Tanpa rule allow, hanya deny yang berlaku
+    PathPolicy denyOnly;
+    TEST_ASSERT(denyOnly.AddRule(POLICY_ACTION_DENY, L"C:\\Users\\"), "Trailing separator rule should compile");
+    TEST_ASSERT(denyOnly.Evaluate(L"D:\\Games\\game.exe") == POLICY_DECISION_ALLOWED, "Deny-only policy should allow other paths");
+    TEST_ASSERT(denyOnly.Evaluate(L"C:\\Users\\bob\\x.exe") == POLICY_DECISION_DENIED, "Trailing separator should deny subtree");
+    TEST_ASSERT(!denyOnly.AddRule(POLICY_ACTION_ALLOW, L"C:\\Tools\\..\\Windows"), "Dot-dot component should be rejected");
+
+    // TEST 6: Baris rusak membuat policy menolak semua (fail closed)
+    PathPolicy broken;
+    TEST_ASSERT(!broken.LoadFromText("allow C:\\Tools\\**\npermit C:\\Other\n", &errorLine), "Unknown keyword should fail");
+    TEST_ASSERT(errorLine == 2, "Broken policy should report the bad line");
+    TEST_ASSERT(broken.Evaluate(L"C:\\Tools\\app.exe") == POLICY_DECISION_DENIED, "Broken policy should deny everything");
+
+    // TEST 7: Pipeline validasi menolak lokasi sebelum membaca isi file
+    FakeFileSystemBackend fake;
+    fake.files[L"C:\\Tools\\app.exe"] = BuildTestPeImage(2);
+    fake.files[L"C:\\Users\\bob\\AppData\\Roaming\\evil.exe"] = BuildTestPeImage(2);
+    SetFileSystemBackend(&fake);
+    SetPathPolicy(&policy);
+
+    bool passed = true;
+    {
+        ValidatedExecutable validated;
+        passed = passed && (ValidateExecutable(L"C:\\Tools\\app.exe", validated) == VALIDATION_OK);
+    }
+    fake.ResetCounters();
+    {
+        ValidatedExecutable validated;
+        passed = passed && (ValidateExecutable(L"C:\\Users\\bob\\AppData\\Roaming\\evil.exe", validated) == VALIDATION_POLICY_DENIED);
+        passed = passed && (validated.policy.ruleLine == 5) && !validated.file.IsValid();
+        passed = passed && (fake.readCalls == 0) && (fake.openHandles == 0);
+    }
+
+    SetPathPolicy(NULL);
+    SetFileSystemBackend(NULL);
+    TEST_ASSERT(passed, "Validation pipeline should enforce the active path policy");
+
+    TEST_PASS("Path policy engine evaluates allow/deny rules correctly");
+}
+
+/**
+ * @brief Benchmark policy path: biaya evaluasi tidak bergantung jumlah rule
+ *
+ * Membandingkan 10 rule dengan 10.000 rule (campuran prefix literal, glob,
+ * dan deny "**"). Engine linear akan ~1000x lebih lambat di policy besar;
+ * trie harus tetap dalam faktor kecil.
+ */
+bool TestPathPolicyBenchmark() {
+    std::cout << "Benchmarking path policy engine..." << std::endl;
+
+    auto buildPolicy = [](PathPolicy& policy, int ruleCount) {
+        for (int i = 0; i < ruleCount; i++) {
+            std::wstring vendor = L"C:\\Apps\\Vendor" + std::to_wstring(i);
+            switch (i % 10) {
+            case 0:  policy.AddRule(POLICY_ACTION_DENY, vendor + L"\\*\\Temp*\\**"); break;
+            case 1:  policy.AddRule(POLICY_ACTION_ALLOW, L"D:\\Share" + std::to_wstring(i) + L"\\*.exe"); break;
+            default: policy.AddRule(POLICY_ACTION_ALLOW, vendor + L"\\Product" + std::to_wstring(i % 37) + L"\\**"); break;
+            }
+        }
+        policy.AddRule(POLICY_ACTION_DENY, L"**\\AppData\\**");
+    };
+
+    std::vector<std::wstring> paths;
+    for (int i = 0; i < 1000; i++) {
+        int vendor = 2 + (i * 7919) % 8; // Vendor2-9 memiliki rule allow Product<n>\**
+        paths.push_back(L"C:\\Apps\\Vendor" + std::to_wstring(vendor) + L"\\Product" + std::to_wstring(vendor % 37) +
+                        L"\\bin\\x64\\tool" + std::to_wstring(i) + L".exe");
+    }
+    paths.push_back(L"C:\\Users\\bob\\AppData\\Local\\evil.exe");
+
+    auto measure = [&paths](const PathPolicy& policy, int iterations, size_t& allowed) {
+        allowed = 0;
+        auto start = std::chrono::high_resolution_clock::now();
+        for (int iter = 0; iter < iterations; iter++) {
+            for (const std::wstring& path : paths) {
+                if (policy.Evaluate(path) == POLICY_DECISION_ALLOWED) allowed++;
+            }
+        }
+        auto end = std::chrono::high_resolution_clock::now();
+        return std::chrono::duration<double, std::nano>(end - start).count() / (iterations * paths.size());
+    };
+
+    PathPolicy small;
+    buildPolicy(small, 10);
+
+    PathPolicy large;
+    auto compileStart = std::chrono::high_resolution_clock::now();
+    buildPolicy(large, 10000);
+    auto compileEnd = std::chrono::high_resolution_clock::now();
+    double compileMs = std::chrono::duration<double, std::milli>(compileEnd - compileStart).count();
+
+    const int iterations = 20;
+    size_t smallAllowed = 0, largeAllowed = 0;
+    measure(large, 1, largeAllowed); // warm-up
+    double smallNs = measure(small, iterations, smallAllowed);
+    double largeNs = measure(large, iterations, largeAllowed);
+    double ratio = (smallNs > 0) ? largeNs / smallNs : 0.0;
+
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << "  Compile 10k rules : " << compileMs << " ms, " << large.NodeCount() << " trie states" << std::endl;
+    std::cout << "  10 rules          : " << smallNs << " ns per path" << std::endl;
+    std::cout << "  10k rules         : " << largeNs << " ns per path (" << std::setprecision(2) << ratio << "x)" << std::endl;
+
+    // Semua path vendor cocok dengan allow; AppData selalu di-deny
+    TEST_ASSERT(smallAllowed == largeAllowed && largeAllowed == iterations * (paths.size() - 1),
+                "Both policies should allow the same vendor paths and deny AppData");
+    TEST_ASSERT(ratio < 10.0, "Evaluation cost should not scale with rule count");
+
+    TEST_PASS("Path policy evaluation cost is independent of rule count");
+}
+
+/**
+ * @brief Test validasi massal: hasil sama dengan validasi tunggal, output CSV/JSON valid
+ */
+bool TestBulkValidationOutput() {
+    std::cout << "Testing bulk validation API..." << std::endl;
+
+    FakeFileSystemBackend fake;
+    fake.files[L"C:\\Fleet\\app.exe"] = BuildTestPeImage(2);
+    fake.files[L"C:\\Fleet\\tool, v2.exe"] = BuildTestPeImage(3);
+    fake.files[L"C:\\Fleet\\readme.txt"] = std::vector<uint8_t>(16, 'x');
+    fake.files[L"C:\\Fleet\\Sub\\fake.exe"] = std::vector<uint8_t>(64, 0);
+    fake.files[L"C:\\Fleet\\Sub\\Deeper\\run.cmd"] = std::vector<uint8_t>(8, 'e');
+    fake.files[L"C:\\Bin\\helper.exe"] = BuildTestPeImage(3);
+    fake.pathVariable = L"C:\\Bin";
+    SetFileSystemBackend(&fake);
+
+    BulkValidationOptions options;
+    options.threadCount = 4;
+
+    // TEST 1: Walk direktori (rekursif) dalam CSV
+    std::string csv;
+    BulkResultWriter csvWriter(BULK_OUTPUT_CSV, [&csv](std::string_view text) { csv.append(text); });
+    BulkValidationStats treeStats = ValidateDirectoryTree(L"C:\\Fleet", options, csvWriter);
+
+    bool passed = true;
+    passed = passed && (treeStats.pathsValidated == 4) && (treeStats.accepted == 3) && (treeStats.rejected == 1);
+    passed = passed && (treeStats.directoriesScanned == 3) && (treeStats.filesSkipped == 1);
+    passed = passed && (csv.compare(0, 9, "input,pat") == 0);
+    passed = passed && (csv.find("\"C:\\Fleet\\tool, v2.exe\",\"C:\\Fleet\\tool, v2.exe\",ok,pe-image,3,") != std::string::npos);
+    passed = passed && (csv.find("C:\\Fleet\\Sub\\fake.exe,C:\\Fleet\\Sub\\fake.exe,not-pe-image,pe-image") != std::string::npos);
+    passed = passed && (csv.find(",ok,script,") != std::string::npos);
+    passed = passed && (fake.openHandles == 0);
+
+    // TEST 2: Daftar path dalam JSON - nama file saja memakai index PATH bersama
+    std::vector<std::wstring> list = {
+        L"C:\\Fleet\\app.exe", L"helper.exe", L"helper.exe", L"missing.exe", L"C:\\Fleet\\readme.txt"
+    };
+    fake.ResetCounters();
+    std::string json;
+    BulkResultWriter jsonWriter(BULK_OUTPUT_JSON, [&json](std::string_view text) { json.append(text); });
+    BulkValidationStats listStats = ValidatePathList(list, options, jsonWriter);
+
+    passed = passed && (listStats.pathsValidated == list.size()) && (listStats.accepted == 3);
+    passed = passed && (fake.environmentCalls == 1) && (fake.enumerateCalls == 1);
+    passed = passed && (json.compare(0, 2, "[\n") == 0) && (json.compare(json.size() - 3, 3, "\n]\n") == 0);
+    passed = passed && (std::count(json.begin(), json.end(), '{') == 5);
+    passed = passed && (json.find("\"input\":\"helper.exe\",\"path\":\"C:\\\\Bin\\\\helper.exe\",\"result\":\"ok\"") != std::string::npos);
+    passed = passed && (json.find("\"input\":\"missing.exe\",\"path\":\"\",\"result\":\"not-found\"") != std::string::npos);
+    passed = passed && (json.find("\"result\":\"bad-extension\"") != std::string::npos);
+    passed = passed && (GetPathSearchIndex() == NULL) && (fake.openHandles == 0);
+
+    SetFileSystemBackend(NULL);
+    TEST_ASSERT(passed, "Bulk validation should match single-path results and emit valid CSV/JSON");
+
+    TEST_PASS("Bulk validation API produces correct streamed reports");
+}
+
+/**
+ * @brief Benchmark validasi massal: throughput naik dengan jumlah thread
+ *
+ * Setiap open di backend palsu diberi latency 1ms (mensimulasikan disk/SMB),
+ * sehingga throughput dibatasi oleh I/O seperti pada audit image sungguhan.
+ * Direktori sengaja tidak seimbang agar work stealing diperlukan.
+ */
+bool TestBulkValidationThroughput() {
+    std::cout << "Benchmarking bulk validation throughput..." << std::endl;
+
+    FakeFileSystemBackend fake;
+    std::vector<uint8_t> image = BuildTestPeImage(2);
+    for (int i = 0; i < 160; i++) {
+        fake.files[L"C:\\Image\\Big\\app" + std::to_wstring(i) + L".exe"] = image;
+    }
+    for (int i = 0; i < 40; i++) {
+        fake.files[L"C:\\Image\\Small" + std::to_wstring(i % 8) + L"\\tool" + std::to_wstring(i) + L".exe"] = image;
+    }
+    fake.openLatency = std::chrono::microseconds(1000);
+    SetFileSystemBackend(&fake);
+
+    auto run = [](unsigned threads, BulkValidationStats& stats) {
+        BulkValidationOptions options;
+        options.threadCount = threads;
+        BulkResultWriter writer(BULK_OUTPUT_CSV, [](std::string_view) {});
+        stats = ValidateDirectoryTree(L"C:\\Image", options, writer);
+    };
+
+    BulkValidationStats single, parallel;
+    run(1, single);
+    run(8, parallel);
+    SetFileSystemBackend(NULL);
+
+    double speedup = (single.PathsPerSecond() > 0) ? parallel.PathsPerSecond() / single.PathsPerSecond() : 0.0;
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << "  1 thread : " << single.PathsPerSecond() << " paths/sec (" << single.pathsValidated << " paths)" << std::endl;
+    std::cout << "  8 threads: " << parallel.PathsPerSecond() << " paths/sec, " << parallel.tasksStolen
+              << " tasks stolen (" << std::setprecision(2) << speedup << "x)" << std::endl;
+
+    TEST_ASSERT(single.pathsValidated == 200 && parallel.pathsValidated == 200 && parallel.accepted == 200,
+                "Every file should be validated exactly once");
+    TEST_ASSERT(parallel.tasksStolen > 0, "Idle workers should steal work from the busy one");
+    TEST_ASSERT(speedup > 1.5, "Parallel validation should scale with worker count");
+
+    TEST_PASS("Bulk validation scales across workers with work stealing");
+}
+
+/**
+ * @brief Test worker idle dan exception di WorkStealingScheduler
+ *
+ * Worker tanpa task harus dibangunkan oleh Push dari task yang masih berjalan
+ * (bukan hanya saat semua selesai), dan task yang melempar exception tetap
+ * di-Complete sehingga worker lain berhenti.
+ */
+bool TestWorkStealingScheduler() {
+    std::cout << "Testing work-stealing scheduler wakeups and exceptions..." << std::endl;
+
+    // TEST 1: Task panjang mem-push child lalu menunggunya - hanya worker lain yang dapat menjalankannya
+    WorkStealingScheduler<int> scheduler(2);
+    scheduler.Push(0, 1);
+    std::promise<void> childRan;
+    std::future<void> childDone = childRan.get_future();
+    std::atomic<unsigned> parentWorker(99), childWorker(99);
+    std::atomic<bool> childInTime(false);
+    auto runWorker = [&](unsigned worker) {
+        scheduler.RunWorker(worker, [&](int task) {
+            if (task == 1) {
+                parentWorker = worker;
+                scheduler.Push(worker, 2);
+                childInTime = childDone.wait_for(std::chrono::seconds(10)) == std::future_status::ready;
+            } else {
+                childWorker = worker;
+                childRan.set_value();
+            }
+        });
+    };
+    std::thread second(runWorker, 1);
+    runWorker(0);
+    second.join();
+    TEST_ASSERT(childInTime && childWorker.load() != parentWorker.load() && scheduler.Idle(),
+                "An idle worker should be woken to run a task pushed by a busy worker");
+
+    // TEST 2: Task yang melempar tetap selesai - worker lain menjalankan sisa task lalu berhenti
+    WorkStealingScheduler<int> throwing(3);
+    for (int i = 0; i < 30; i++) {
+        throwing.Push(static_cast<unsigned>(i % 3), std::move(i));
+    }
+    std::atomic<int> ran(0), thrown(0);
+    auto runThrowing = [&](unsigned worker) {
+        try {
+            throwing.RunWorker(worker, [&](int task) {
+                if (task == 7) {
+                    throwing.Push(worker, 100); // Child di-push sebelum exception tetap dijalankan
+                    throw std::runtime_error("task failed");
+                }
+                ran++;
+            });
+        } catch (const std::runtime_error&) {
+            thrown++;
+        }
+    };
+    std::vector<std::thread> workers;
+    for (unsigned worker = 1; worker < 3; worker++) {
+        workers.emplace_back(runThrowing, worker);
+    }
+    runThrowing(0);
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+    TEST_ASSERT(thrown == 1 && ran == 30 && throwing.Idle(),
+                "A throwing task should still complete so the other workers finish the queue and stop");
+
+    TEST_PASS("Idle workers park until new work arrives and failed tasks still complete");
+}
+
+//==============================================================================
+// FILE OPERATION ENGINE TESTS
+//==============================================================================
+
+/**
+ * @brief Test engine /fileops di atas direktori sementara yang nyata
+ *
+ * Parser menolak script yang tidak aman secara utuh; plan membuat direktori
+ * parent dulu, menghapus child dulu, dan memisahkan file besar; eksekusi
+ * paralel menyalin isi yang identik, melaporkan error per item, berhenti
+ * sebelum baris yang bergantung pada baris gagal, dan setiap worker
+ * meng-impersonate token yang diberikan.
+ */
+bool TestFileOperations() {
+    std::cout << "Testing parallel file operation engine on a temp directory..." << std::endl;
+
+    TempDirFileOperationBackend fo("rasti_fileops");
+    SetFileOperationBackend(&fo);
+
+    // TEST 1: Parser - kutip, '/', separator akhir, BOM, CRLF, komentar
+    std::vector<FileOperationCommand> commands;
+    size_t errorLine = 99;
+    bool parsed = ParseFileOperationScript("\xEF\xBB\xBF# Deploy\r\n\r\nCOPY \"T:\\src dir\" T:/dst\r\n"
+                                           "move T:\\a.txt  T:\\b.txt\n  delete T:\\old\\\n", commands, &errorLine);
+    TEST_ASSERT(parsed && errorLine == 0 && commands.size() == 3, "Valid script should parse");
+    TEST_ASSERT(commands[0].kind == FILEOPS_COPY && commands[0].source == L"T:\\src dir" &&
+                commands[0].destination == L"T:\\dst" && commands[0].line == 3,
+                "Quoted paths and forward slashes should be normalized");
+    TEST_ASSERT(commands[1].kind == FILEOPS_MOVE && commands[2].kind == FILEOPS_DELETE &&
+                commands[2].source == L"T:\\old" && commands[2].destination.empty() && commands[2].line == 5,
+                "Trailing separators should be removed and line numbers kept");
+
+    auto rejects = [&](const char* text, size_t expectedLine) {
+        size_t line = 0;
+        std::vector<FileOperationCommand> parsedCommands(1);
+        return !ParseFileOperationScript(text, parsedCommands, &line) && parsedCommands.empty() &&
+               line == expectedLine;
+    };
+    TEST_ASSERT(rejects("delete T:\\ok\ncopy T:\\a\n", 2), "Missing destination should be rejected");
+    TEST_ASSERT(rejects("copy Work\\a T:\\b", 1), "Relative paths should be rejected");
+    TEST_ASSERT(rejects("delete T:\\", 1) && rejects("delete \\\\server\\share", 1),
+                "Volume and share roots should be rejected");
+    TEST_ASSERT(rejects("delete T:\\a\\..\\b", 1) && rejects("delete T:\\a\\\\b", 1),
+                "Dot components and empty components should be rejected");
+    TEST_ASSERT(rejects("delete T:\\a:stream", 1) && rejects("delete T:\\*.tmp", 1),
+                "Streams and wildcards should be rejected");
+    TEST_ASSERT(rejects("copy T:\\a T:\\A\\sub", 1) && rejects("move T:\\a T:\\a", 1),
+                "Destination inside source should be rejected");
+    TEST_ASSERT(rejects("rename T:\\a T:\\b", 1) && rejects("delete T:\\a extra", 1) &&
+                rejects("delete \"T:\\a", 1), "Unknown keywords and stray tokens should be rejected");
+
+    // Pohon sumber: 40 file kecil di 4 level, 2 file besar, 1 direktori kosong, 1 symlink direktori
+    std::map<std::wstring, std::string> expected;
+    for (int i = 0; i < 40; i++) {
+        const wchar_t* directories[] = { L"", L"\\a", L"\\a\\b", L"\\a\\b\\c" };
+        std::wstring relative = std::wstring(directories[i % 4]) + L"\\file" + std::to_wstring(i) + L".dat";
+        expected[relative] = std::string(100 + i * 37, static_cast<char>('a' + i % 26));
+    }
+    expected[L"\\a\\large1.bin"] = std::string(64 * 1024, 'L');
+    expected[L"\\a\\b\\large2.bin"] = std::string(80 * 1024, 'M');
+    uint64_t totalBytes = 0;
+    for (const auto& file : expected) {
+        fo.WriteFile(L"T:\\src" + file.first, file.second);
+        totalBytes += file.second.size();
+    }
+    std::filesystem::create_directories(fo.Map(L"T:\\src\\e"));
+    std::filesystem::create_directory_symlink(fo.Map(L"T:\\src\\a"), fo.Map(L"T:\\src\\link"));
+
+    FileOperationOptions options;
+    options.threadCount = 4;
+    options.largeFileThreshold = 16 * 1024;
+    options.copyBatchSize = 8;
+
+    // TEST 2: Plan copy - mkdir per kedalaman, file besar terpisah, link dilewati
+    FileOperationCommand copy;
+    copy.kind = FILEOPS_COPY;
+    copy.source = L"T:\\src";
+    copy.destination = L"T:\\dst";
+    copy.line = 1;
+    FileOperationPlan plan;
+    TEST_ASSERT(PlanFileOperation(copy, options, plan) && plan.errors.empty(), "Copy plan should succeed");
+    TEST_ASSERT(plan.directoriesScanned == 5 && plan.reparsePointsSkipped == 1,
+                "Walk should scan every real directory and skip the directory link");
+    TEST_ASSERT(plan.stages.size() == 5 && plan.itemCount == 1 + 4 + expected.size() &&
+                plan.totalBytes == totalBytes, "Plan should contain 4 mkdir levels and one copy stage");
+    TEST_ASSERT(plan.stages[0].tasks.size() == 1 && plan.stages[0].tasks[0].items[0].destination == L"T:\\dst" &&
+                plan.stages[1].tasks[0].items.size() == 2, "Destination root should be created before children");
+    size_t unbufferedTasks = 0;
+    bool batchesBounded = true;
+    for (const FileOperationTask& task : plan.stages[4].tasks) {
+        batchesBounded = batchesBounded && !task.items.empty() && task.items.size() <= options.copyBatchSize;
+        if (task.items[0].unbuffered && task.items.size() == 1) unbufferedTasks++;
+    }
+    TEST_ASSERT(batchesBounded && unbufferedTasks == 2, "Large files should be separate unbuffered tasks");
+
+    // TEST 3: Eksekusi copy paralel - isi identik, throughput dilaporkan
+    FileOperationReport report;
+    TEST_ASSERT(RunFileOperations({ copy }, options, report), "Copy should succeed");
+    bool identical = true;
+    for (const auto& file : expected) {
+        identical = identical && fo.ReadFile(L"T:\\dst" + file.first) == file.second;
+    }
+    TEST_ASSERT(identical && fo.Exists(L"T:\\dst\\e") && !fo.Exists(L"T:\\dst\\link"),
+                "Every file should be copied exactly and links should not be followed");
+    TEST_ASSERT(report.commandsCompleted == 1 && report.itemsFailed == 0 &&
+                report.itemsSucceeded == report.itemsPlanned && report.bytesCopied == totalBytes &&
+                report.unbufferedCopies == 2 && fo.unbufferedCopies == 2, "Report should count every item");
+    std::cout << "  copy: " << report.itemsSucceeded << " items, " << std::fixed << std::setprecision(1)
+              << report.BytesPerSecond() / (1024.0 * 1024.0) << " MB/s, " << std::setprecision(0)
+              << report.ItemsPerSecond() << " items/s, " << report.tasksStolen << " tasks stolen" << std::endl;
+
+    // TEST 4: Plan delete - file dulu, direktori terdalam dulu, root terakhir
+    FileOperationCommand remove;
+    remove.kind = FILEOPS_DELETE;
+    remove.source = L"T:\\dst";
+    remove.line = 1;
+    TEST_ASSERT(PlanFileOperation(remove, options, plan), "Delete plan should succeed");
+    const FileOperationStage& last = plan.stages.back();
+    TEST_ASSERT(plan.stages.front().tasks[0].items[0].step == FILEOPS_STEP_DELETE_FILE &&
+                last.tasks.size() == 1 && last.tasks[0].items.size() == 1 &&
+                last.tasks[0].items[0].step == FILEOPS_STEP_REMOVE_DIRECTORY &&
+                last.tasks[0].items[0].source == L"T:\\dst" &&
+                plan.stages[plan.stages.size() - 2].tasks[0].items.size() == 2,
+                "Directories should be removed children first");
+
+    // TEST 5: Script lengkap - delete link tanpa menyentuh target, move file ke direktori, move direktori
+    std::string script = "delete T:\\dst\ndelete T:\\src\\link\nmove T:\\src\\file0.dat T:\\src\\e\n"
+                         "move T:\\src\\a T:\\moved\n";
+    TEST_ASSERT(ParseFileOperationScript(script, commands) && RunFileOperations(commands, options, report),
+                "Delete and move script should succeed");
+    TEST_ASSERT(!fo.Exists(L"T:\\dst") && !fo.Exists(L"T:\\src\\link") && !fo.Exists(L"T:\\src\\a") &&
+                fo.ReadFile(L"T:\\moved\\b\\large2.bin") == expected[L"\\a\\b\\large2.bin"] &&
+                fo.ReadFile(L"T:\\src\\e\\file0.dat") == expected[L"\\file0.dat"],
+                "Delete should remove only the link and move should rename in place");
+    TEST_ASSERT(report.commandsCompleted == 4, "All commands should complete");
+
+    // TEST 6: Error per item - item lain tetap berjalan, baris berikutnya tidak dijalankan
+    fo.WriteFile(L"T:\\conflict\\b", "not a directory");
+    script = "copy T:\\moved T:\\conflict\ndelete T:\\moved\n";
+    TEST_ASSERT(ParseFileOperationScript(script, commands), "Conflict script should parse");
+    TEST_ASSERT(!RunFileOperations(commands, options, report), "Copy with conflicts should fail");
+    TEST_ASSERT(report.commandsCompleted == 0 && report.itemsFailed > 0 && report.itemsSucceeded > 0 &&
+                fo.Exists(L"T:\\moved") && fo.ReadFile(L"T:\\conflict\\large1.bin") == expected[L"\\a\\large1.bin"],
+                "Unaffected items should be copied and the dependent delete should not run");
+    TEST_ASSERT(report.errors[0].line == 1 && report.errorCount == report.itemsFailed &&
+                FormatFileOperationReport(report).find("mkdir failed (error 183): T:\\conflict\\b") != std::string::npos,
+                "Report should list the failing item with its line and error code");
+
+    TEST_ASSERT(ParseFileOperationScript("copy T:\\missing T:\\x", commands) &&
+                !RunFileOperations(commands, options, report) && report.errors.size() == 1 &&
+                report.errors[0].step == FILEOPS_STEP_LIST && report.errors[0].code == OS_ERROR_FILE_NOT_FOUND,
+                "Missing source should fail during planning");
+
+    // TEST 7: Setiap worker meng-impersonate token; impersonation gagal = semua item gagal
+    FakeProcessBackend ps;
+    SetProcessBackend(&ps);
+    options.token = 0x1234;
+    copy.source = L"T:\\moved";
+    copy.destination = L"T:\\impersonated";
+    TEST_ASSERT(RunFileOperations({ copy }, options, report) && fo.Exists(L"T:\\impersonated\\b\\c"),
+                "Impersonated copy should succeed");
+    TEST_ASSERT(ps.CountCalls("ImpersonateToken") > 0 &&
+                ps.CountCalls("ImpersonateToken") == ps.CountCalls("RevertImpersonation") && !ps.impersonating,
+                "Every worker should impersonate and revert");
+
+    ps.canImpersonate = false;
+    copy.destination = L"T:\\denied";
+    TEST_ASSERT(!RunFileOperations({ copy }, options, report) && !fo.Exists(L"T:\\denied") &&
+                report.errors.size() == 1 && report.errors[0].code == 5,
+                "Work should not run outside the impersonated context");
+
+    SetProcessBackend(NULL);
+    SetFileOperationBackend(NULL);
+
+    TEST_PASS("File operation engine plans, schedules, and reports parallel copy/move/delete");
+}
+
+//==============================================================================
+// ACL RESET ENGINE TESTS
+//==============================================================================
+
+/**
+ * @brief Test engine /aclreset di atas direktori sementara dengan security di memory
+ *
+ * Parser SDDL menolak bagian yang tidak didukung; pewarisan ACE mengikuti
+ * aturan OI/CI/NP/IO dan stabil setelah dua level; seluruh pohon memakai
+ * descriptor yang di-intern; object yang sudah sesuai tidak ditulis; run
+ * yang dihentikan dilanjutkan dari checkpoint tanpa memindai ulang
+ * direktori yang sudah selesai.
+ */
+bool TestAclReset() {
+    std::cout << "Testing ACL reset engine with descriptor interning and checkpoints..." << std::endl;
+
+    // TEST 1: Parser SDDL - alias hak akses, flag, deny, dan bagian yang ditolak
+    AclTemplate acl;
+    TEST_ASSERT(ParseAclTemplate(L"O:BAD:PAI(A;OICI;FA;;;SY)(A;CI;GR;;;BU)(A;OI;0x1200a9;;;AU)"
+                                 L"(D;OICINP;WDWO;;;S-1-5-32-545)", acl), "Valid SDDL should parse");
+    TEST_ASSERT(acl.owner == L"BA" && acl.isProtected && acl.entries.size() == 4 &&
+                acl.entries[0].mask == 0x1F01FF && acl.entries[1].mask == 0x80000000 &&
+                acl.entries[2].mask == 0x1200A9 && acl.entries[3].deny && acl.entries[3].mask == 0xC0000 &&
+                acl.entries[3].flags == (ACL_ACE_OBJECT_INHERIT | ACL_ACE_CONTAINER_INHERIT | ACL_ACE_NO_PROPAGATE) &&
+                acl.entries[3].sid == L"S-1-5-32-545", "Rights, flags, and SIDs should be decoded");
+    AclTemplate roundTrip;
+    TEST_ASSERT(ParseAclTemplate(FormatAclTemplate(acl), roundTrip) && roundTrip.entries == acl.entries &&
+                roundTrip.owner == acl.owner && roundTrip.isProtected, "Formatted SDDL should round-trip");
+    TEST_ASSERT(!ParseAclTemplate(L"D:P(A;;FA;;;SY)", acl) && !ParseAclTemplate(L"O:BAG:SYD:P", acl) &&
+                !ParseAclTemplate(L"O:BAD:P(OA;;RP;bf967aba-0de6-11d0-a285-00aa003049e2;;SY)", acl) &&
+                !ParseAclTemplate(L"O:BAD:P(A;SA;FA;;;SY)", acl) && !ParseAclTemplate(L"O:BAD:NO_ACCESS_CONTROL", acl) &&
+                !ParseAclTemplate(L"O:BAD:P(XA;;FA;;;WD;(Member_of {SID(BA)}))", acl) &&
+                !ParseAclTemplate(L"O:BAD:P(A;;XX;;;SY)", acl), "Group, SACL, object, audit, and conditional ACEs should be rejected");
+
+    // TEST 2: Pewarisan - file menerima OI, direktori CI + inherit-only, NP berhenti, generic dipecah
+    ParseAclTemplate(L"O:BAD:P(A;OICI;FA;;;SY)(A;CI;GR;;;BU)(A;OI;0x1200a9;;;AU)(D;OICINP;WD;;;S-1-5-32-545)", acl);
+    AclTemplate file, directory, grandchild, stable;
+    DeriveInheritedAcl(acl, false, file);
+    TEST_ASSERT(file.owner == L"BA" && !file.isProtected && file.entries.size() == 3 &&
+                file.entries[0].flags == ACL_ACE_INHERITED && file.entries[1].sid == L"AU" &&
+                file.entries[2].deny && file.entries[2].flags == ACL_ACE_INHERITED,
+                "Files should inherit only object-inherit ACEs");
+    DeriveInheritedAcl(acl, true, directory);
+    TEST_ASSERT(directory.entries.size() == 5 &&
+                directory.entries[0].flags == (ACL_ACE_OBJECT_INHERIT | ACL_ACE_CONTAINER_INHERIT | ACL_ACE_INHERITED) &&
+                directory.entries[1].mask == 0x120089 && directory.entries[1].flags == ACL_ACE_INHERITED &&
+                directory.entries[2].mask == 0x80000000 &&
+                directory.entries[2].flags == (ACL_ACE_CONTAINER_INHERIT | ACL_ACE_INHERIT_ONLY | ACL_ACE_INHERITED) &&
+                directory.entries[3].flags == (ACL_ACE_OBJECT_INHERIT | ACL_ACE_INHERIT_ONLY | ACL_ACE_INHERITED) &&
+                directory.entries[4].deny && directory.entries[4].flags == ACL_ACE_INHERITED,
+                "Directories should split generic ACEs and keep object-inherit ACEs inherit-only");
+    DeriveInheritedAcl(directory, true, grandchild);
+    DeriveInheritedAcl(grandchild, true, stable);
+    TEST_ASSERT(grandchild.entries.size() == 4 && stable.entries == grandchild.entries,
+                "No-propagate ACEs should stop after one level and derivation should converge");
+
+    // Pohon: 4 direktori x 50 file, 1 direktori kosong, 1 symlink direktori
+    TempDirFileOperationBackend fo("rasti_aclreset");
+    SetFileOperationBackend(&fo);
+    const wchar_t* directories[] = { L"", L"\\a", L"\\a\\b", L"\\a\\b\\c" };
+    for (const wchar_t* name : directories) {
+        for (int i = 0; i < 50; i++) {
+            fo.WriteFile(L"T:\\tree" + std::wstring(name) + L"\\file" + std::to_wstring(i) + L".txt", "x");
+        }
+    }
+    std::filesystem::create_directories(fo.Map(L"T:\\tree\\d"));
+    std::filesystem::create_directory_symlink(fo.Map(L"T:\\tree\\a"), fo.Map(L"T:\\tree\\link"));
+    const uint64_t objectCount = 1 + 4 + 200;
+
+    // Descriptor yang diharapkan per level, dalam bentuk normalisasi backend ("FA")
+    auto expected = [](const std::wstring& sddl, int depth, bool isDirectory) {
+        AclTemplate level;
+        ParseAclTemplate(sddl, level);
+        level.isProtected = true;
+        for (int i = 1; i <= depth; i++) {
+            AclTemplate next;
+            DeriveInheritedAcl(level, isDirectory || i < depth, next);
+            level = next;
+        }
+        std::wstring text = FormatAclTemplate(level);
+        for (size_t pos = 0; (pos = text.find(L";0x1f01ff;", pos)) != std::wstring::npos;) text.replace(pos, 10, L";FA;");
+        return text;
+    };
+    auto treeMatches = [&](const std::wstring& sddl) {
+        bool matches = fo.Security(L"T:\\tree") == expected(sddl, 0, true) &&
+                       fo.Security(L"T:\\tree\\d") == expected(sddl, 1, true) &&
+                       fo.Security(L"T:\\tree\\link") == fo.defaultSecurity;
+        for (int depth = 0; depth < 4; depth++) {
+            std::wstring directory = std::wstring(L"T:\\tree") + directories[depth];
+            matches = matches && (depth == 0 || fo.Security(directory) == expected(sddl, depth, true));
+            for (int i = 0; i < 50; i++) {
+                matches = matches && fo.Security(directory + L"\\file" + std::to_wstring(i) + L".txt") ==
+                                     expected(sddl, depth + 1, false);
+            }
+        }
+        return matches;
+    };
+
+    // TEST 3: Reset pohon - 4 descriptor unik, object yang sudah sesuai dilewati, link tidak disentuh
+    std::wstring sddl = L"O:BAD:P(A;OICI;FA;;;SY)(A;OICI;0x1f01ff;;;BA)(A;CI;GR;;;BU)(A;OINP;FR;;;AU)";
+    fo.SetSecurity(L"T:\\tree\\a\\b\\file7.txt", expected(sddl, 3, false));
+    AclResetOptions options;
+    options.threadCount = 4;
+    AclResetReport report;
+    TEST_ASSERT(RunAclReset(L"T:\\tree", sddl, options, report) && report.completed, "ACL reset should succeed");
+    TEST_ASSERT(treeMatches(sddl), "Every object should receive the inherited owner and DACL");
+    TEST_ASSERT(report.objectsVisited == objectCount && report.objectsSkipped == 1 &&
+                report.objectsUpdated == objectCount - 1 && report.objectsFailed == 0 && report.linksSkipped == 1 &&
+                report.directoriesScanned == 5, "Report should count every object once");
+    TEST_ASSERT(report.descriptorsBuilt == 4 && fo.descriptorBuilds == 4,
+                "Each distinct descriptor should be built once");
+    std::cout << "  reset: " << report.objectsVisited << " objects, " << report.descriptorsBuilt
+              << " descriptors, " << std::fixed << std::setprecision(0) << report.ObjectsPerSecond()
+              << " objects/s" << std::endl;
+
+    // TEST 4: Run ulang - semua object sudah sesuai, tidak ada penulisan
+    int writesBefore = fo.securityWrites;
+    TEST_ASSERT(RunAclReset(L"T:\\tree", sddl, options, report) && report.objectsSkipped == objectCount &&
+                report.objectsUpdated == 0 && fo.securityWrites == writesBefore,
+                "Matching objects should not be rewritten");
+
+    // TEST 5: Cancel menyimpan checkpoint; resume melanjutkan tanpa memindai ulang direktori selesai
+    std::wstring changed = L"O:SYD:P(A;OICI;FA;;;SY)(A;CI;0x1200a9;;;BU)";
+    std::atomic<bool> cancel(false);
+    options.threadCount = 1;
+    options.checkpointPath = L"T:\\reset.checkpoint";
+    options.checkpointSeconds = 0.0;
+    options.cancel = &cancel;
+    writesBefore = fo.securityWrites;
+    fo.onWriteSecurity = [&]() { if (fo.securityWrites - writesBefore >= 120) cancel = true; };
+    TEST_ASSERT(!RunAclReset(L"T:\\tree", changed, options, report) && report.interrupted && !report.completed &&
+                report.checkpointsWritten > 0 && fo.Exists(L"T:\\reset.checkpoint"),
+                "Cancelled reset should leave a checkpoint");
+    uint64_t firstScanned = report.directoriesScanned;
+    uint64_t firstUpdated = report.objectsUpdated;
+
+    fo.onWriteSecurity = nullptr;
+    cancel = false;
+    int listsBefore = fo.listCalls;
+    TEST_ASSERT(RunAclReset(L"T:\\tree", changed, options, report) && report.completed && report.resumed &&
+                report.directoriesResumed > 0 && !fo.Exists(L"T:\\reset.checkpoint") &&
+                !fo.Exists(L"T:\\reset.checkpoint.tmp"), "Resumed reset should complete and remove the checkpoint");
+    TEST_ASSERT(treeMatches(changed) && firstUpdated + report.objectsUpdated >= objectCount - 1,
+                "Resumed reset should finish every object");
+    TEST_ASSERT(static_cast<uint64_t>(fo.listCalls - listsBefore) == report.directoriesScanned &&
+                report.directoriesScanned < 5 && firstScanned + report.directoriesScanned <= 5 + 1,
+                "Completed directories should not be scanned again");
+
+    // TEST 6: Checkpoint untuk SDDL lain ditolak tanpa menyentuh pohon
+    fo.onWriteSecurity = [&]() { cancel = true; };
+    TEST_ASSERT(!RunAclReset(L"T:\\tree", sddl, options, report) && fo.Exists(L"T:\\reset.checkpoint"),
+                "Interrupted reset should leave a checkpoint");
+    fo.onWriteSecurity = nullptr;
+    cancel = false;
+    writesBefore = fo.securityWrites;
+    TEST_ASSERT(!RunAclReset(L"T:\\tree", changed, options, report) && fo.securityWrites == writesBefore &&
+                report.errors.size() == 1 && report.errors[0].step == ACLRESET_STEP_CHECKPOINT &&
+                fo.Exists(L"T:\\reset.checkpoint"), "Mismatched checkpoint should be rejected and kept");
+
+    // TEST 7: Worker meng-impersonate token dan mengaktifkan privilege backup/restore/take ownership
+    FakeProcessBackend ps;
+    SetProcessBackend(&ps);
+    options = AclResetOptions();
+    options.threadCount = 2;
+    options.token = 0x1234;
+    TEST_ASSERT(RunAclReset(L"T:\\tree\\a", sddl, options, report) && report.completed,
+                "Impersonated reset should succeed");
+    TEST_ASSERT(ps.CountCalls("AdjustPrivilege(17,thread)") > 0 && ps.CountCalls("AdjustPrivilege(18,thread)") > 0 &&
+                ps.CountCalls("AdjustPrivilege(9,thread)") > 0 &&
+                ps.CountCalls("ImpersonateToken") == ps.CountCalls("RevertImpersonation") && !ps.impersonating,
+                "Workers should enable restore privileges under impersonation");
+    TEST_ASSERT(!RunAclReset(L"T:\\missing", sddl, options, report) && report.objectsFailed == 1 &&
+                report.errors[0].code == OS_ERROR_FILE_NOT_FOUND &&
+                !RunAclReset(L"T:\\", sddl, options, report), "Missing or volume roots should be rejected");
+
+    SetProcessBackend(NULL);
+    SetFileOperationBackend(NULL);
+
+    TEST_PASS("ACL reset engine interns descriptors, skips matching objects, and resumes from checkpoints");
+}
+
+//==============================================================================
+// REGISTRY IMPORT TESTS
+//==============================================================================
+
+/** @brief Teks .reg sebagai file UTF-16LE dengan BOM (format regedit) */
+static std::string RegFileUtf16(const std::wstring& text)
+{
+    std::string bytes("\xFF\xFE", 2);
+    for (wchar_t ch : text) {
+        bytes.push_back(static_cast<char>(ch & 0xFF));
+        bytes.push_back(static_cast<char>((ch >> 8) & 0xFF));
+    }
+    return bytes;
+}
+
+/** @brief Data REG_SZ: UTF-16LE + terminator */
+static std::vector<uint8_t> RegString(const std::wstring& text)
+{
+    std::vector<uint8_t> data;
+    for (wchar_t ch : text) {
+        data.push_back(static_cast<uint8_t>(ch & 0xFF));
+        data.push_back(static_cast<uint8_t>((ch >> 8) & 0xFF));
+    }
+    data.push_back(0);
+    data.push_back(0);
+    return data;
+}
+
+/**
+ * @brief Test parser .reg streaming dan engine /regimport di atas registry palsu
+ *
+ * Parser menghasilkan blok yang sama di mana pun chunk dipotong dan menolak
+ * baris tidak valid dengan nomor barisnya; engine memakai satu handle per
+ * blok dari cache LRU, tidak menulis value yang sudah sama, dan dry run
+ * melaporkan perubahan yang sama dengan import nyata tanpa menulis apa pun.
+ */
+bool TestRegistryImport() {
+    std::cout << "Testing in-process registry import with streaming parser and key cache..." << std::endl;
+
+    // TEST 1: UTF-16LE regedit 5 - komentar, escape, dword, hex(2) lanjutan, hapus value/key
+    std::string file = RegFileUtf16(
+        L"Windows Registry Editor Version 5.00\r\n"                 // 1
+        L"\r\n"                                                     // 2
+        L"; RasTI settings\r\n"                                     // 3
+        L"[HKEY_LOCAL_MACHINE\\SOFTWARE\\RasTI]\r\n"                // 4
+        L"@=\"default\"\r\n"                                        // 5
+        L"\"Path\"=\"C:\\\\Tools\"\r\n"                             // 6
+        L"\"Say \\\"hi\\\"\"=\"x\"\r\n"                             // 7
+        L"\"Count\"=dword:0000002A\r\n"                             // 8
+        L"\"Expand\"=hex(2):25,00,41,00,\\\r\n"                     // 9
+        L"  00,00\r\n"                                              // 10
+        L"\"Old\"=-\r\n"                                            // 11
+        L"\r\n"                                                     // 12
+        L"[-HKCU\\Software\\Stale\\]\r\n");                         // 13
+    std::vector<RegistryKeyBlock> blocks;
+    size_t errorLine = 99;
+    TEST_ASSERT(ParseRegistryFile(file, blocks, &errorLine) && errorLine == 0 && blocks.size() == 2,
+                "UTF-16 .reg file should parse into two key blocks");
+    const RegistryKeyBlock& settings = blocks[0];
+    TEST_ASSERT(settings.root == REGISTRY_ROOT_LOCAL_MACHINE && settings.path == L"SOFTWARE\\RasTI" &&
+                !settings.remove && settings.line == 4 && settings.values.size() == 6,
+                "Key line should be decoded with its line number");
+    TEST_ASSERT(settings.values[0].name.empty() && settings.values[0].data == RegString(L"default") &&
+                settings.values[1].name == L"Path" && settings.values[1].data == RegString(L"C:\\Tools") &&
+                settings.values[2].name == L"Say \"hi\"" && settings.values[2].type == REGISTRY_TYPE_SZ,
+                "Default value and escaped names/strings should be decoded");
+    TEST_ASSERT(settings.values[3].type == REGISTRY_TYPE_DWORD &&
+                settings.values[3].data == std::vector<uint8_t>({ 0x2A, 0, 0, 0 }) &&
+                settings.values[4].type == REGISTRY_TYPE_EXPAND_SZ && settings.values[4].line == 9 &&
+                settings.values[4].data == std::vector<uint8_t>({ 0x25, 0, 0x41, 0, 0, 0 }) &&
+                settings.values[5].remove && settings.values[5].line == 11,
+                "DWORD, continued hex(2), and value deletion should be decoded");
+    TEST_ASSERT(blocks[1].remove && blocks[1].root == REGISTRY_ROOT_CURRENT_USER &&
+                blocks[1].path == L"Software\\Stale" && blocks[1].line == 13 && blocks[1].values.empty(),
+                "Key deletion with short root name and trailing separator should be decoded");
+
+    // TEST 2: Hasil identik untuk setiap ukuran chunk (batas baris, BOM, dan unit UTF-16 terpotong)
+    bool sameForEveryChunk = true;
+    for (size_t chunk = 1; chunk <= 17 && sameForEveryChunk; chunk++) {
+        RegistryFileParser parser;
+        std::vector<RegistryKeyBlock> streamed;
+        for (size_t offset = 0; offset < file.size(); offset += chunk) {
+            sameForEveryChunk = sameForEveryChunk && parser.Feed(file.data() + offset, std::min(chunk, file.size() - offset));
+            parser.TakeBlocks(streamed);
+        }
+        sameForEveryChunk = sameForEveryChunk && parser.Finish();
+        parser.TakeBlocks(streamed);
+        sameForEveryChunk = sameForEveryChunk && streamed == blocks;
+    }
+    TEST_ASSERT(sameForEveryChunk, "Streaming parse should not depend on chunk boundaries");
+
+    // TEST 3: REGEDIT4 (UTF-8/ANSI) - string hex diperlebar ke UTF-16, hex kosong
+    TEST_ASSERT(ParseRegistryFile("REGEDIT4\n\n[HKEY_CURRENT_USER\\Software\\Ras]\n\"Name\"=hex(1):41,42,00\n"
+                                  "\"Bin\"=hex:\n", blocks) && blocks.size() == 1 &&
+                blocks[0].values[0].type == REGISTRY_TYPE_SZ && blocks[0].values[0].data == RegString(L"AB") &&
+                blocks[0].values[1].type == REGISTRY_TYPE_BINARY && blocks[0].values[1].data.empty(),
+                "REGEDIT4 string data should be widened to UTF-16");
+
+    // TEST 4: Baris tidak valid dilaporkan dengan nomornya, tanpa blok parsial
+    struct InvalidFile {
+        const char* text;
+        size_t line;
+    };
+    const InvalidFile invalid[] = {
+        { "", 1 },
+        { "REGEDIT5\n[HKLM\\A]\n", 1 },
+        { "REGEDIT4\n\"v\"=\"x\"\n", 2 },
+        { "REGEDIT4\n[HKXX\\A]\n", 2 },
+        { "REGEDIT4\n[HKLM\\A\\\\B]\n", 2 },
+        { "REGEDIT4\n[-HKEY_LOCAL_MACHINE\\SOFTWARE]\n", 2 },
+        { "REGEDIT4\n[-HKEY_CURRENT_USER]\n", 2 },
+        { "REGEDIT4\n[HKLM\\A]\n\"v\"=dword:123456789\n", 3 },
+        { "REGEDIT4\n[HKLM\\A]\n\"v\"=hex:01,,02\n", 3 },
+        { "REGEDIT4\n[HKLM\\A]\n\"v\"=\"x\" trailing\n", 3 },
+        { "REGEDIT4\n[-HKLM\\A\\B]\n\"v\"=\"x\"\n", 3 },
+    };
+    bool allRejected = true;
+    for (const InvalidFile& entry : invalid) {
+        bool parsed = ParseRegistryFile(entry.text, blocks, &errorLine);
+        if (parsed || errorLine != entry.line || !blocks.empty()) {
+            std::cout << "  Unexpected result for: " << entry.text << " (line " << errorLine << ")" << std::endl;
+            allRejected = false;
+        }
+    }
+    TEST_ASSERT(allRejected, "Invalid lines, unknown roots, and hive root deletion should be rejected");
+
+    // Registry awal: HKLM\SOFTWARE\RasTI berisi Keep dan Old, HKCU\Software\Stale punya subkey
+    FakeRegistryBackend reg;
+    SetRegistryBackend(&reg);
+    reg.Put(REGISTRY_ROOT_LOCAL_MACHINE, L"SOFTWARE\\RasTI", L"Keep", REGISTRY_TYPE_DWORD, { 1, 0, 0, 0 });
+    reg.Put(REGISTRY_ROOT_LOCAL_MACHINE, L"SOFTWARE\\RasTI", L"Old", REGISTRY_TYPE_SZ, RegString(L"x"));
+    reg.Put(REGISTRY_ROOT_CURRENT_USER, L"Software\\Stale\\Child", L"v", REGISTRY_TYPE_DWORD, { 7, 0, 0, 0 });
+
+    TEST_ASSERT(ParseRegistryFile(RegFileUtf16(
+        L"Windows Registry Editor Version 5.00\r\n"                 // 1
+        L"\r\n"                                                     // 2
+        L"[HKEY_LOCAL_MACHINE\\SOFTWARE\\RasTI]\r\n"                // 3
+        L"\"keep\"=dword:00000001\r\n"                              // 4
+        L"\"Old\"=-\r\n"                                            // 5
+        L"\"New\"=\"value\"\r\n"                                    // 6
+        L"\r\n"                                                     // 7
+        L"[-HKEY_CURRENT_USER\\Software\\Stale]\r\n"                // 8
+        L"\r\n"                                                     // 9
+        L"[HKEY_LOCAL_MACHINE\\SOFTWARE\\RasTI\\Sub\\Deep]\r\n"     // 10
+        L"\"A\"=dword:00000002\r\n"                                 // 11
+        L"\"A\"=dword:00000003\r\n"                                 // 12
+        L"\r\n"                                                     // 13
+        L"[HKEY_LOCAL_MACHINE\\Software\\RASTI]\r\n"                // 14
+        L"\"New\"=\"value\"\r\n"), blocks),                         // 15
+        "Import file should parse");
+
+    // TEST 5: Dry run - perubahan dilaporkan (termasuk efek baris sebelumnya), tidak ada yang ditulis
+    RegistryImportOptions options;
+    options.dryRun = true;
+    RegistryImportReport dry;
+    TEST_ASSERT(RunRegistryImport(blocks, options, dry) && dry.dryRun, "Dry run should succeed");
+    TEST_ASSERT(reg.createCalls == 0 && reg.setCalls == 0 && reg.deleteValueCalls == 0 && reg.deleteKeyCalls == 0 &&
+                reg.OpenHandles() == 0 && reg.HasKey(REGISTRY_ROOT_CURRENT_USER, L"Software\\Stale\\Child"),
+                "Dry run should only open keys read-only and close them");
+    TEST_ASSERT(dry.keyBlocks == 4 && dry.keysCreated == 1 && dry.keysDeleted == 1 && dry.valuesSet == 3 &&
+                dry.valuesUnchanged == 2 && dry.valuesDeleted == 1 && dry.changeCount == 6 && dry.changes.size() == 6,
+                "Dry run should count keys and values that would change");
+    TEST_ASSERT(dry.changes[0].kind == REGIMPORT_CHANGE_DELETE_VALUE && dry.changes[0].line == 5 &&
+                dry.changes[2].kind == REGIMPORT_CHANGE_DELETE_KEY &&
+                dry.changes[3].kind == REGIMPORT_CHANGE_CREATE_KEY &&
+                dry.changes[5].kind == REGIMPORT_CHANGE_MODIFY_VALUE && dry.changes[5].line == 12,
+                "Changes should be reported in file order");
+    std::string text = FormatRegistryImportReport(dry);
+    TEST_ASSERT(text.find("line 6: would add value HKEY_LOCAL_MACHINE\\SOFTWARE\\RasTI \"New\" (REG_SZ)") != std::string::npos &&
+                text.find("line 8: would delete key HKEY_CURRENT_USER\\Software\\Stale") != std::string::npos &&
+                text.find("dry run: 4 key blocks, 1 keys to be created") == 0,
+                "Dry run report should list each change");
+
+    // TEST 6: Import nyata - satu handle per blok, value yang sama tidak ditulis, cache hit untuk key berulang
+    options.dryRun = false;
+    RegistryImportReport report;
+    TEST_ASSERT(RunRegistryImport(blocks, options, report) && report.errorCount == 0, "Import should succeed");
+    TEST_ASSERT(report.keysCreated == dry.keysCreated && report.keysDeleted == dry.keysDeleted &&
+                report.valuesSet == dry.valuesSet && report.valuesUnchanged == dry.valuesUnchanged &&
+                report.valuesDeleted == dry.valuesDeleted, "Import should make exactly the changes the dry run predicted");
+    TEST_ASSERT(report.keyOpens == 2 && report.keyCacheHits == 1 && reg.createCalls == 2 &&
+                reg.setCalls == 3 && reg.OpenHandles() == 0, "Repeated key should reuse the cached handle");
+    const FakeRegistryBackend::Value* keep = reg.Find(REGISTRY_ROOT_LOCAL_MACHINE, L"SOFTWARE\\RasTI", L"Keep");
+    const FakeRegistryBackend::Value* deep = reg.Find(REGISTRY_ROOT_LOCAL_MACHINE, L"SOFTWARE\\RasTI\\Sub\\Deep", L"A");
+    TEST_ASSERT(keep && keep->data == std::vector<uint8_t>({ 1, 0, 0, 0 }) &&
+                !reg.Find(REGISTRY_ROOT_LOCAL_MACHINE, L"SOFTWARE\\RasTI", L"Old") &&
+                reg.Find(REGISTRY_ROOT_LOCAL_MACHINE, L"SOFTWARE\\RasTI", L"New") &&
+                deep && deep->data == std::vector<uint8_t>({ 3, 0, 0, 0 }) &&
+                reg.HasKey(REGISTRY_ROOT_LOCAL_MACHINE, L"SOFTWARE\\RasTI\\Sub") &&
+                !reg.HasKey(REGISTRY_ROOT_CURRENT_USER, L"Software\\Stale") &&
+                !reg.HasKey(REGISTRY_ROOT_CURRENT_USER, L"Software\\Stale\\Child") &&
+                reg.HasKey(REGISTRY_ROOT_CURRENT_USER, L"Software"),
+                "Registry should contain the imported keys and values");
+
+    options.dryRun = true;
+    TEST_ASSERT(RunRegistryImport(blocks, options, dry) && dry.keysCreated == 0 && dry.keysDeleted == 0 &&
+                dry.valuesDeleted == 0 && dry.valuesSet == 2 && dry.valuesUnchanged == 4,
+                "Dry run after import should only report the value the file changes twice");
+
+    // TEST 7: [-KEY] lalu [KEY] di file yang sama - dry run menganggap key sudah hilang
+    TEST_ASSERT(ParseRegistryFile("REGEDIT4\n[-HKLM\\SOFTWARE\\RasTI]\n[HKLM\\SOFTWARE\\RasTI\\Sub]\n"
+                                  "\"Keep\"=dword:1\n", blocks) &&
+                RunRegistryImport(blocks, options, dry) && dry.keysDeleted == 1 && dry.keysCreated == 1 &&
+                dry.changes.size() == 3 && dry.changes[2].kind == REGIMPORT_CHANGE_ADD_VALUE,
+                "Dry run should account for keys deleted earlier in the file");
+
+    // TEST 8: Cache LRU - kapasitas 2 untuk pola A B C A membuka ulang A, kapasitas 3 tidak
+    TEST_ASSERT(ParseRegistryFile("REGEDIT4\n[HKLM\\K\\A]\n[HKLM\\K\\B]\n[HKLM\\K\\C]\n[HKLM\\K\\A]\n", blocks),
+                "Cache test file should parse");
+    options = RegistryImportOptions();
+    options.keyCacheSize = 2;
+    TEST_ASSERT(RunRegistryImport(blocks, options, report) && report.keyOpens == 4 && report.keyCacheHits == 0,
+                "Least recently used handle should be evicted");
+    options.keyCacheSize = 3;
+    TEST_ASSERT(RunRegistryImport(blocks, options, report) && report.keyOpens == 3 && report.keyCacheHits == 1 &&
+                reg.OpenHandles() == 0, "Handles within capacity should be reused and closed at the end");
+
+    // TEST 9: Key yang ditolak dilaporkan, blok berikutnya tetap diterapkan
+    reg.deniedKeys.insert(FakeRegistryBackend::KeyName(REGISTRY_ROOT_LOCAL_MACHINE, L"SOFTWARE\\Locked"));
+    TEST_ASSERT(ParseRegistryFile("REGEDIT4\n[HKLM\\SOFTWARE\\Locked]\n\"a\"=\"b\"\n[HKLM\\SOFTWARE\\Open]\n"
+                                  "\"a\"=\"b\"\n", blocks) &&
+                !RunRegistryImport(blocks, options, report) && report.keysFailed == 1 && report.valuesFailed == 1 &&
+                report.valuesSet == 1 && report.errors.size() == 1 && report.errors[0].line == 2 &&
+                report.errors[0].step == REGIMPORT_STEP_OPEN_KEY && report.errors[0].code == OS_ERROR_ACCESS_DENIED &&
+                FormatRegistryImportReport(report).find("line 2: open key failed (error 5): HKEY_LOCAL_MACHINE\\SOFTWARE\\Locked") !=
+                std::string::npos, "Denied key should be reported without stopping the import");
+
+    // TEST 10: Worker meng-impersonate token; tanpa impersonation tidak ada yang ditulis
+    FakeProcessBackend ps;
+    SetProcessBackend(&ps);
+    bool outsideImpersonation = false;
+    reg.onAccess = [&]() { outsideImpersonation = outsideImpersonation || !ps.impersonating; };
+    options.token = 0x1234;
+    TEST_ASSERT(ParseRegistryFile("REGEDIT4\n[HKLM\\SOFTWARE\\Ti]\n\"a\"=\"b\"\n", blocks) &&
+                RunRegistryImport(blocks, options, report) && !outsideImpersonation &&
+                ps.CountCalls("ImpersonateToken") == 1 && ps.CountCalls("RevertImpersonation") == 1 && !ps.impersonating,
+                "Import should run on one impersonating worker");
+    ps.canImpersonate = false;
+    int setsBefore = reg.setCalls;
+    TEST_ASSERT(!RunRegistryImport(blocks, options, report) && reg.setCalls == setsBefore && report.keysFailed == 1 &&
+                report.errors.size() == 1 && report.errors[0].code == 5,
+                "Import should not run outside the impersonated context");
+    reg.onAccess = nullptr;
+    SetProcessBackend(NULL);
+
+    // TEST 11: LoadRegistryFile membaca melalui backend filesystem
+    FakeFileSystemBackend fs;
+    SetFileSystemBackend(&fs);
+    fs.files[L"C:\\Work\\settings.reg"] = std::vector<uint8_t>(file.begin(), file.end());
+    std::vector<RegistryKeyBlock> loaded;
+    ParseRegistryFile(file, blocks);
+    TEST_ASSERT(LoadRegistryFile(L"C:\\Work\\settings.reg", loaded, &errorLine) && loaded == blocks &&
+                !LoadRegistryFile(L"C:\\Work\\missing.reg", loaded, &errorLine) && errorLine == 0 && loaded.empty() &&
+                fs.openHandles == 0, "Registry file should load through the filesystem backend");
+    SetFileSystemBackend(NULL);
+    SetRegistryBackend(NULL);
+
+    TEST_PASS("Registry import parses .reg files in chunks, caches key handles, and dry-runs changes");
+}
+
+//==============================================================================
+// SCRIPT HOST TESTS
+//==============================================================================
+
+/**
+ * @brief Test daftar job dan engine /scripthost di atas interpreter palsu
+ *
+ * Satu host per jenis melayani banyak script; banner dibuang, output dan
+ * exit code dipisah per job dengan marker, host di-recycle setelah N job
+ * atau setelah job yang gagal, dan script yang ditolak validasi tidak
+ * pernah menyalakan host.
+ */
+bool TestScriptHost() {
+    std::cout << "Testing persistent script host with marker protocol and recycling..." << std::endl;
+
+    // TEST 1: Daftar job - komentar, BOM, kutip, argumen; baris tidak valid dengan nomornya
+    std::vector<ScriptJob> jobs;
+    size_t errorLine = 99;
+    TEST_ASSERT(ParseScriptJobList("\xEF\xBB\xBF# nightly\n\nC:\\Jobs\\a.cmd one \"two words\"\r\n"
+                                   "  \"C:\\Jobs\\b b.ps1\" it's\n", jobs, &errorLine) && errorLine == 0 &&
+                jobs.size() == 2 && jobs[0].line == 3 && jobs[0].path == L"C:\\Jobs\\a.cmd" &&
+                jobs[0].arguments == std::vector<std::wstring>({ L"one", L"two words" }) &&
+                jobs[1].line == 4 && jobs[1].path == L"C:\\Jobs\\b b.ps1" &&
+                jobs[1].arguments == std::vector<std::wstring>({ L"it's" }),
+                "Job list should parse paths, quoted arguments, and line numbers");
+    struct InvalidList {
+        const char* text;
+        size_t line;
+    };
+    const InvalidList invalid[] = {
+        { "C:\\Jobs\\tool.exe\n", 1 },          // Bukan script
+        { "a.cmd\n\"b.cmd\n", 2 },               // Kutip tidak ditutup
+        { "a.cmd 50%\n", 1 },                    // % diekspansi cmd
+        { "a.bat x^y\n", 1 },                    // ^ digandakan CALL
+        { "a.ps1 ok\nb.ps1 \"a\tb\"\n", 2 },     // Karakter kontrol
+        { "a.cmd\n\xFF.cmd\n", 2 }               // UTF-8 tidak valid
+    };
+    for (const InvalidList& list : invalid) {
+        TEST_ASSERT(!ParseScriptJobList(list.text, jobs, &errorLine) && errorLine == list.line && jobs.empty(),
+                    "Invalid job line should be rejected with its line number");
+    }
+    TEST_ASSERT(ParseScriptJobList("a.ps1 50% x^y\n", jobs) && jobs[0].arguments.size() == 2,
+                "PowerShell arguments are quoted literally and may contain % and ^");
+
+    // TEST 2: ValidateScript menerima .ps1, ValidateExecutable tetap menolaknya
+    FakeFileSystemBackend fs;
+    SetFileSystemBackend(&fs);
+    fs.files[L"C:\\Jobs\\a.cmd"] = std::vector<uint8_t>({ '@', 'e', 'c', 'h', 'o' });
+    fs.files[L"C:\\Jobs\\b b.ps1"] = std::vector<uint8_t>({ 'W', 'r' });
+    fs.files[L"C:\\Jobs\\fail.bat"] = std::vector<uint8_t>({ 'x' });
+    fs.files[L"C:\\Jobs\\quit.cmd"] = std::vector<uint8_t>({ 'x' });
+    fs.files[L"C:\\Jobs\\hang.cmd"] = std::vector<uint8_t>({ 'x' });
+    fs.files[L"C:\\Jobs\\100%.cmd"] = std::vector<uint8_t>({ 'x' });
+    fs.files[L"C:\\Jobs\\tool.exe"] = BuildTestPeImage(3);
+    ValidatedExecutable script;
+    TEST_ASSERT(ValidateScript(L"C:\\Jobs\\b b.ps1", script) == VALIDATION_OK &&
+                script.kind == EXECUTABLE_KIND_POWERSHELL && script.file.IsValid(),
+                "PowerShell script should validate for the script host");
+    TEST_ASSERT(ValidateScript(L"C:\\Jobs\\tool.exe", script) == VALIDATION_BAD_EXTENSION && !script.file.IsValid() &&
+                ValidateScript(L"C:\\Jobs\\none.cmd", script) == VALIDATION_NOT_FOUND &&
+                ValidateExecutable(L"C:\\Jobs\\b b.ps1", script) == VALIDATION_BAD_EXTENSION,
+                "Script host validation should reject images and missing files; launch validation rejects .ps1");
+    script.file.Reset();
+
+    // TEST 3: Satu host per jenis untuk semua job, banner dibuang, output/exit code per job
+    FakeScriptHostBackend hosts;
+    SetScriptHostBackend(&hosts);
+    hosts.scripts[L"C:\\Jobs\\a.cmd"].output = "alpha\r\n";
+    hosts.scripts[L"C:\\Jobs\\b b.ps1"].output = "no newline";
+    TEST_ASSERT(ParseScriptJobList("C:\\Jobs\\a.cmd one \"two words\"\n\"C:\\Jobs\\b b.ps1\" it's\n"
+                                   "C:\\Jobs\\a.cmd\n\"C:\\Jobs\\b b.ps1\"\nC:\\Jobs\\a.cmd x=1\n", jobs),
+                "Job list should parse");
+    ScriptHostOptions options;
+    options.cmdPath = L"C:\\Windows\\System32\\cmd.exe";
+    options.powershellPath = L"C:\\Windows\\System32\\WindowsPowerShell\\v1.0\\powershell.exe";
+    options.workingDirectory = L"C:\\Work";
+    ScriptHostReport report;
+    TEST_ASSERT(RunScriptHost(jobs, options, report) && report.jobsSucceeded == 5 && report.jobsFailed == 0 &&
+                report.hostsStarted == 2 && report.hostsRecycled == 0 && hosts.starts.size() == 2,
+                "Five jobs should share one cmd host and one PowerShell host");
+    TEST_ASSERT(hosts.starts[0].commandLine == L"\"C:\\Windows\\System32\\cmd.exe\" /D /Q /V:OFF" &&
+                hosts.starts[1].commandLine.find(L"-NoProfile -NonInteractive -ExecutionPolicy Bypass -Command -") !=
+                std::wstring::npos, "Hosts should start without AutoRun, profiles, or delayed expansion");
+    TEST_ASSERT(report.results[0].status == SCRIPTJOB_COMPLETED && report.results[0].output == "alpha\r\n" &&
+                report.results[1].output == "no newline" && report.results[1].kind == EXECUTABLE_KIND_POWERSHELL &&
+                report.results[4].line == 5 && hosts.executed.size() == 5 && hosts.RunningHosts() == 0 &&
+                hosts.closeCalls == 2 && hosts.terminated == 0 && fs.openHandles == 0,
+                "Output should be split per job and hosts should exit cleanly at the end");
+    auto hasLine = [&](const std::string& line) {
+        return std::find(hosts.lines.begin(), hosts.lines.end(), line) != hosts.lines.end();
+    };
+    bool quotedPowerShell = false;
+    for (const std::string& line : hosts.lines) {
+        quotedPowerShell = quotedPowerShell ||
+            line.find("& 'C:\\Jobs\\b b.ps1' 'it''s' 2>&1 | Out-Host") != std::string::npos;
+    }
+    TEST_ASSERT(hasLine("@call \"C:\\Jobs\\a.cmd\" one \"two words\" <nul") &&
+                hasLine("@call \"C:\\Jobs\\a.cmd\" \"x=1\" <nul") && hasLine("@cd /d \"C:\\Work\"") &&
+                quotedPowerShell && hosts.lastDirectory == L"C:\\Work",
+                "Arguments should be quoted for each interpreter and the directory reset per job");
+
+    // TEST 4: Recycle setelah N job
+    options.jobsPerHost = 2;
+    hosts.starts.clear();
+    TEST_ASSERT(RunScriptHost(jobs, options, report) && report.hostsStarted == 3 && report.hostsRecycled == 2 &&
+                hosts.terminated == 0, "Each host should be recycled after two jobs");
+    options.jobsPerHost = SCRIPTHOST_DEFAULT_JOBS_PER_HOST;
+
+    // TEST 5: Exit code bukan 0, host yang keluar, dan script yang ditolak
+    hosts.scripts[L"C:\\Jobs\\fail.bat"].exitCode = 2;
+    hosts.scripts[L"C:\\Jobs\\fail.bat"].output = "boom\r\n";
+    hosts.scripts[L"C:\\Jobs\\quit.cmd"].exitCode = 3;
+    hosts.scripts[L"C:\\Jobs\\quit.cmd"].exitsHost = true;
+    TEST_ASSERT(ParseScriptJobList("C:\\Jobs\\fail.bat\nC:\\Jobs\\a.cmd\nC:\\Jobs\\quit.cmd\nC:\\Jobs\\a.cmd\n"
+                                   "C:\\Jobs\\none.cmd\nC:\\Jobs\\100%.cmd\n", jobs), "Failure job list should parse");
+    hosts.starts.clear();
+    size_t executedBefore = hosts.executed.size();
+    TEST_ASSERT(!RunScriptHost(jobs, options, report) && report.jobsSucceeded == 2 && report.jobsFailed == 4 &&
+                report.hostsStarted == 3 && report.hostsRecycled == 2 && hosts.terminated == 0 &&
+                hosts.executed.size() == executedBefore + 4, "Each failed job should get a fresh host");
+    TEST_ASSERT(report.results[0].status == SCRIPTJOB_COMPLETED && report.results[0].exitCode == 2 &&
+                report.results[0].output == "boom\r\n" && !report.results[0].Succeeded() &&
+                report.results[2].status == SCRIPTJOB_HOST_EXITED && report.results[2].exitCode == 3 &&
+                report.results[4].status == SCRIPTJOB_REJECTED && report.results[4].validation == VALIDATION_NOT_FOUND &&
+                report.results[5].status == SCRIPTJOB_REJECTED && report.results[5].validation == VALIDATION_UNSAFE_PATH,
+                "Exit codes, host exits, and rejected scripts should be reported per job");
+    std::string text = FormatScriptHostReport(report);
+    TEST_ASSERT(text.find("line 1: completed, exit 2, ") == 0 && text.find("  | boom\n") != std::string::npos &&
+                text.find("line 3: host-exited, exit 3, ") != std::string::npos &&
+                text.find("line 5: rejected (not-found): C:\\Jobs\\none.cmd\n") != std::string::npos &&
+                text.find("2/6 jobs succeeded, 4 failed") != std::string::npos &&
+                text.find("3 hosts started") != std::string::npos,
+                "Report should list each job with its output and a summary");
+
+    // TEST 6: Timeout men-terminate host; job berikutnya memakai host baru
+    hosts.scripts[L"C:\\Jobs\\hang.cmd"].hangs = true;
+    TEST_ASSERT(ParseScriptJobList("C:\\Jobs\\hang.cmd\nC:\\Jobs\\a.cmd\n", jobs), "Timeout job list should parse");
+    options.timeoutMs = 20;
+    int terminatedBefore = hosts.terminated;
+    TEST_ASSERT(!RunScriptHost(jobs, options, report) && report.results[0].status == SCRIPTJOB_TIMED_OUT &&
+                report.results[1].Succeeded() && report.hostsStarted == 2 && report.hostsRecycled == 1 &&
+                hosts.terminated == terminatedBefore + 1 && hosts.RunningHosts() == 0,
+                "Hung script should be killed and the next job should run on a new host");
+    options.timeoutMs = 0;
+
+    // TEST 7: Host yang tidak dapat dijalankan
+    hosts.startError = OS_ERROR_FILE_NOT_FOUND;
+    TEST_ASSERT(!RunScriptHost(jobs, options, report) && report.results[1].status == SCRIPTJOB_HOST_FAILED &&
+                report.results[1].errorCode == OS_ERROR_FILE_NOT_FOUND && report.hostsStarted == 2 &&
+                fs.openHandles == 0, "Host start failure should be reported per job");
+    hosts.startError = 0;
+
+    // TEST 8: LoadScriptJobList membaca melalui backend filesystem
+    std::string list = "C:\\Jobs\\a.cmd\n";
+    fs.files[L"C:\\Jobs\\nightly.txt"] = std::vector<uint8_t>(list.begin(), list.end());
+    TEST_ASSERT(LoadScriptJobList(L"C:\\Jobs\\nightly.txt", jobs, &errorLine) && jobs.size() == 1 &&
+                !LoadScriptJobList(L"C:\\Jobs\\missing.txt", jobs, &errorLine) && errorLine == 0 && jobs.empty(),
+                "Job list should load through the filesystem backend");
+    SetScriptHostBackend(NULL);
+    SetFileSystemBackend(NULL);
+
+    TEST_PASS("Script host runs many scripts per interpreter, splits output by marker, and recycles hosts");
+}
+
+//==============================================================================
+// OUTPUT CAPTURE TESTS
+//==============================================================================
+
+/**
+ * @brief Test daftar launch, pump capture, dan writer console/log di atas proses palsu
+ *
+ * Output beberapa proses yang saling menyela diteruskan per launch tanpa
+ * salinan, maxRunning membatasi proses paralel, timeout men-terminate
+ * proses, pipe yang dipegang turunan tidak menahan launch, dan log file
+ * dirotasi di batas baris.
+ */
+bool TestOutputCapture() {
+    std::cout << "Testing output capture pump with console and rotating log writers..." << std::endl;
+
+    // TEST 1: Daftar launch - komentar, kutip, argumen; baris tidak valid dengan nomornya
+    std::vector<CaptureLaunch> launches;
+    size_t errorLine = 99;
+    TEST_ASSERT(ParseCaptureLaunchList("\xEF\xBB\xBF# servicing\n\nC:\\Tools\\a.exe /q \"two words\"\r\n"
+                                       "  \"C:\\Tools\\b b.cmd\" x=1\n", launches, &errorLine) && errorLine == 0 &&
+                launches.size() == 2 && launches[0].line == 3 && launches[0].path == L"C:\\Tools\\a.exe" &&
+                launches[0].arguments == std::vector<std::wstring>({ L"/q", L"two words" }) &&
+                launches[1].line == 4 && launches[1].path == L"C:\\Tools\\b b.cmd",
+                "Launch list should parse paths, quoted arguments, and line numbers");
+    struct InvalidList {
+        const char* text;
+        size_t line;
+    };
+    const InvalidList invalid[] = {
+        { "C:\\Tools\\run.ps1\n", 1 },          // Bukan executable launch
+        { "a.exe\n\"b.exe\n", 2 },               // Kutip tidak ditutup
+        { "a.exe\nb.cmd 50%\n", 2 },             // % diekspansi cmd
+        { "a.exe \"a\tb\"\n", 1 },               // Karakter kontrol
+        { "a.exe\n\xFF.exe\n", 2 }               // UTF-8 tidak valid
+    };
+    for (const InvalidList& list : invalid) {
+        TEST_ASSERT(!ParseCaptureLaunchList(list.text, launches, &errorLine) && errorLine == list.line &&
+                    launches.empty(), "Invalid launch line should be rejected with its line number");
+    }
+    TEST_ASSERT(ParseCaptureLaunchList("a.exe 50% x^y\n", launches) && launches[0].arguments.size() == 2,
+                "Program arguments may contain % and ^");
+
+    // TEST 2: Tiga proses paralel, output saling menyela diteruskan per launch tanpa salinan
+    FakeFileSystemBackend fs;
+    SetFileSystemBackend(&fs);
+    fs.files[L"C:\\Tools\\a.exe"] = BuildTestPeImage(3);
+    fs.files[L"C:\\Tools\\b.exe"] = BuildTestPeImage(3);
+    fs.files[L"C:\\Tools\\c c.cmd"] = std::vector<uint8_t>({ '@', 'e', 'c', 'h', 'o' });
+    fs.files[L"C:\\Tools\\hang.exe"] = BuildTestPeImage(3);
+    fs.files[L"C:\\Tools\\daemon.exe"] = BuildTestPeImage(3);
+    FakeOutputCaptureBackend capture;
+    SetOutputCaptureBackend(&capture);
+    capture.programs[L"C:\\Tools\\a.exe"].chunks = {
+        { CAPTURE_STREAM_STDOUT, "a1\r\na2" }, { CAPTURE_STREAM_STDOUT, "\r\n" } };
+    capture.programs[L"C:\\Tools\\b.exe"].chunks = {
+        { CAPTURE_STREAM_STDERR, "b-error\n" }, { CAPTURE_STREAM_STDOUT, "b-out\n" } };
+    capture.programs[L"C:\\Tools\\b.exe"].exitCode = 4;
+    capture.programs[L"C:\\Tools\\c c.cmd"].chunks = { { CAPTURE_STREAM_STDOUT, "c\n" } };
+    capture.programs[L"C:\\Tools\\c c.cmd"].notifyExit = false;
+    TEST_ASSERT(ParseCaptureLaunchList("C:\\Tools\\a.exe \"two words\" tail\\ \"C:\\dir with\\\"\n"
+                                       "C:\\Tools\\b.exe\n\"C:\\Tools\\c c.cmd\" x=1 plain\n", launches),
+                "Launch list should parse");
+
+    std::map<size_t, std::string> received[2];
+    bool zeroCopy = true;
+    CaptureOutputCallback collect = [&](size_t launch, CaptureStream stream, std::string_view data) {
+        zeroCopy = zeroCopy && data.data() == capture.lastData;
+        received[stream][launch].append(data);
+    };
+    CaptureOptions options;
+    options.creationFlags = 0x20;
+    CaptureReport report;
+    TEST_ASSERT(!RunCapturedLaunches(launches, options, collect, report) && report.launchesSucceeded == 2 &&
+                report.launchesFailed == 1 && report.peakRunning == 3 && capture.starts.size() == 3 &&
+                capture.closeCalls == 3 && capture.terminated == 0 && capture.openPorts == 0 && fs.openHandles == 0,
+                "Three launches should run together and close cleanly");
+    TEST_ASSERT(zeroCopy && received[CAPTURE_STREAM_STDOUT][0] == "a1\r\na2\r\n" &&
+                received[CAPTURE_STREAM_STDERR][1] == "b-error\n" && received[CAPTURE_STREAM_STDOUT][1] == "b-out\n" &&
+                received[CAPTURE_STREAM_STDOUT][2] == "c\n" && report.bytesCaptured == 24 &&
+                report.results[1].stderrBytes == 8 && report.results[1].stdoutBytes == 6,
+                "Chunks should be delivered per launch and stream straight from the backend buffer");
+    TEST_ASSERT(report.results[0].Succeeded() && report.results[1].status == CAPTURE_LAUNCH_COMPLETED &&
+                report.results[1].exitCode == 4 && report.results[2].Succeeded() &&
+                report.results[2].kind == EXECUTABLE_KIND_SCRIPT && report.results[0].processId != 0 &&
+                !report.results[0].outputDetached, "Exit codes should come from job notifications or direct checks");
+    TEST_ASSERT(capture.starts[0].applicationName == L"C:\\Tools\\a.exe" &&
+                capture.starts[0].commandLine ==
+                L"\"C:\\Tools\\a.exe\" \"two words\" tail\\ \"C:\\dir with\\\\\"" &&
+                capture.starts[2].applicationName.empty() &&
+                capture.starts[2].commandLine == L"\"C:\\Tools\\c c.cmd\" \"x=1\" plain" &&
+                capture.starts[0].creationFlags == (0x20 | PROCESS_CREATE_NEW_CONSOLE) &&
+                capture.starts[0].startupFlags == PROCESS_STARTF_USESHOWWINDOW &&
+                capture.starts[0].showWindow == PROCESS_SHOW_HIDDEN,
+                "Command lines should follow argv quoting for images and cmd quoting for scripts");
+    std::string text = FormatCaptureReport(report);
+    TEST_ASSERT(text.find("[1] exit 0, ") == 0 && text.find("[2] exit 4, ") != std::string::npos &&
+                text.find("2/3 launches succeeded, 1 failed") != std::string::npos &&
+                text.find("24 bytes captured") != std::string::npos,
+                "Report should list each launch and a summary");
+
+    // TEST 3: maxRunning membatasi proses paralel; launch ditolak dan gagal dilaporkan per launch
+    std::vector<CaptureLaunch> many(5);
+    for (size_t i = 0; i < many.size(); i++) {
+        many[i].path = (i == 3) ? L"C:\\Tools\\missing.exe" : L"C:\\Tools\\a.exe";
+    }
+    capture.peakRunning = 0;
+    options.maxRunning = 2;
+    TEST_ASSERT(!RunCapturedLaunches(many, options, CaptureOutputCallback(), report) &&
+                report.launchesSucceeded == 4 && report.peakRunning == 2 && capture.peakRunning == 2 &&
+                report.results[3].status == CAPTURE_LAUNCH_REJECTED &&
+                report.results[3].validation == VALIDATION_NOT_FOUND,
+                "maxRunning should cap concurrent processes and missing files should be rejected");
+    capture.startError = OS_ERROR_ACCESS_DENIED;
+    TEST_ASSERT(!RunCapturedLaunches(many, options, CaptureOutputCallback(), report) &&
+                report.launchesFailed == 5 && report.results[0].status == CAPTURE_LAUNCH_FAILED &&
+                report.results[0].errorCode == OS_ERROR_ACCESS_DENIED && capture.openPorts == 0,
+                "Start failures should be reported per launch");
+    capture.startError = 0;
+    options.maxRunning = 0;
+
+    // TEST 4: Timeout men-terminate proses; pipe yang dipegang turunan tidak menahan launch
+    capture.programs[L"C:\\Tools\\hang.exe"].hangs = true;
+    capture.programs[L"C:\\Tools\\daemon.exe"].chunks = { { CAPTURE_STREAM_STDOUT, "started\n" } };
+    capture.programs[L"C:\\Tools\\daemon.exe"].holdsPipe = true;
+    TEST_ASSERT(ParseCaptureLaunchList("C:\\Tools\\hang.exe\nC:\\Tools\\a.exe\n", launches), "Timeout list should parse");
+    options.timeoutMs = 30;
+    int terminatedBefore = capture.terminated;
+    TEST_ASSERT(!RunCapturedLaunches(launches, options, CaptureOutputCallback(), report) &&
+                report.results[0].status == CAPTURE_LAUNCH_TIMED_OUT && report.results[1].Succeeded() &&
+                capture.terminated == terminatedBefore + 1 && capture.RunningProcesses() == 0,
+                "Hung process should be terminated while other launches complete");
+    options.timeoutMs = 0;
+    TEST_ASSERT(ParseCaptureLaunchList("C:\\Tools\\daemon.exe\n", launches), "Daemon list should parse");
+    TEST_ASSERT(RunCapturedLaunches(launches, options, CaptureOutputCallback(), report) &&
+                report.results[0].outputDetached && report.results[0].stdoutBytes == 8 &&
+                report.results[0].seconds >= CAPTURE_DRAIN_TIMEOUT_MS / 1000.0 - 0.1,
+                "Launch should complete after the drain timeout when a descendant keeps the pipe open");
+
+    // TEST 5: Console writer memberi tag per baris dan menutup baris yang disela launch lain
+    std::string console[2];
+    CaptureConsoleWriter tagged([&](CaptureStream stream, std::string_view data) {
+        console[stream].append(data);
+    }, true);
+    tagged.Write(0, CAPTURE_STREAM_STDOUT, "one\ntw");
+    tagged.Write(1, CAPTURE_STREAM_STDOUT, "x\n");
+    tagged.Write(0, CAPTURE_STREAM_STDOUT, "o\n");
+    tagged.Write(1, CAPTURE_STREAM_STDERR, "bad");
+    tagged.Finish();
+    TEST_ASSERT(console[CAPTURE_STREAM_STDOUT] == "[1] one\n[1] tw\n[2] x\n[1] o\n" &&
+                console[CAPTURE_STREAM_STDERR] == "[2] bad\n",
+                "Tagged console output should keep each line to one launch");
+    std::string plain;
+    CaptureConsoleWriter untagged([&](CaptureStream, std::string_view data) { plain.append(data); }, false);
+    untagged.Write(0, CAPTURE_STREAM_STDOUT, "par");
+    untagged.Write(0, CAPTURE_STREAM_STDERR, "tial");
+    untagged.Finish();
+    TEST_ASSERT(plain == "partial", "Untagged console output should pass chunks through unchanged");
+
+    // TEST 6: Log per launch dibuat saat output pertama dan dirotasi di batas baris
+    TEST_ASSERT(ParseCaptureLaunchList("C:\\Tools\\a.exe\nC:\\Tools\\b.exe\n", launches), "Log list should parse");
+    {
+        CaptureLogWriter logs(L"D:\\Logs", launches, 10, 2);
+        TEST_ASSERT(logs.GetLogPath(0) == L"D:\\Logs\\1-a.exe.log" && capture.files.empty(),
+                    "Log path should be numbered per launch and created lazily");
+        TEST_ASSERT(logs.Write(0, "111\n222\n") && logs.Write(0, "333\n") && logs.Write(0, "444\n555\n666\n") &&
+                    logs.Write(0, "0123456789abc") && logs.GetRotationCount() == 4 && logs.GetErrorCode() == 0,
+                    "Writes should rotate when the file would exceed its limit");
+        TEST_ASSERT(capture.files[L"D:\\Logs\\1-a.exe.log"] == "abc" &&
+                    capture.files[L"D:\\Logs\\1-a.exe.1.log"] == "0123456789" &&
+                    capture.files[L"D:\\Logs\\1-a.exe.2.log"] == "555\n666\n" &&
+                    capture.files.count(L"D:\\Logs\\1-a.exe.3.log") == 0 && capture.files.count(L"D:\\Logs\\2-b.exe.log") == 0,
+                    "Rotation should cut at line boundaries and keep only the configured history");
+    }
+    TEST_ASSERT(capture.OpenLogFiles() == 0, "Log files should be closed when the writer is destroyed");
+    capture.logError = OS_ERROR_ACCESS_DENIED;
+    CaptureLogWriter denied(L"D:\\Logs", launches);
+    TEST_ASSERT(!denied.Write(1, "x") && denied.GetErrorCode() == OS_ERROR_ACCESS_DENIED, "Log create failure should be reported");
+    capture.logError = 0;
+    TEST_ASSERT(!denied.Write(1, "y") && denied.Write(0, "z") && capture.files[L"D:\\Logs\\1-a.exe.log"] == "z",
+                "Log failure should disable only that launch's log");
+
+    // TEST 7: LoadCaptureLaunchList membaca melalui backend filesystem
+    std::string list = "C:\\Tools\\a.exe\n";
+    fs.files[L"C:\\Tools\\batch.txt"] = std::vector<uint8_t>(list.begin(), list.end());
+    TEST_ASSERT(LoadCaptureLaunchList(L"C:\\Tools\\batch.txt", launches, &errorLine) && launches.size() == 1 &&
+                !LoadCaptureLaunchList(L"C:\\Tools\\missing.txt", launches, &errorLine) && errorLine == 0 &&
+                launches.empty(), "Launch list should load through the filesystem backend");
+    SetOutputCaptureBackend(NULL);
+    SetFileSystemBackend(NULL);
+
+    TEST_PASS("Output capture pumps many processes, writes tagged console output, and rotates per-launch logs");
+}
+
+//==============================================================================
+// TRUSTED INSTALLER ACQUISITION TESTS
+//==============================================================================
+
+/**
+ * @brief Test rantai akuisisi token TI dan launch di atas FakeProcessBackend
+ *
+ * Memverifikasi urutan langkah (TCB langsung vs impersonation winlogon.exe),
+ * bahwa impersonation selalu di-revert, semua token ditutup, dan kode error
+ * tahap yang gagal tetap tersedia bagi pemanggil.
+ */
+bool TestTrustedInstallerAcquisition() {
+    std::cout << "Testing Trusted Installer acquisition chain..." << std::endl;
+
+    FakeProcessBackend fake;
+    SetProcessBackend(&fake);
+
+    // TEST 1: Privilege di luar whitelist ditolak tanpa memanggil backend
+    {
+        TEST_ASSERT(!EnableSupportedPrivilege(false, SE_LOAD_DRIVER_PRIVILEGE),
+                    "Privileges outside the whitelist should be rejected");
+        TEST_ASSERT(fake.calls.empty(), "Rejected privileges should not reach the backend");
+    }
+
+    // TEST 2: Host SYSTEM dengan SeTcbPrivilege - tanpa impersonation, dan
+    // CreateProcessAsUserW langsung karena privilege-nya ada di token proses
+    FakeProcessBackend::ConfigureDirectTcbHost(fake);
+    fake.ResetCalls();
+    {
+        TEST_ASSERT(LaunchWithTrustedInstaller(L"", L"\"C:\\Tools\\app.exe\"", 0x20), "Direct TCB host should launch");
+        std::vector<std::string> expected = {
+            "AdjustPrivilege(29,process)", "AdjustPrivilege(7,process)", "LogonTrustedInstaller(process)",
+            "AdjustPrivilege(3,process)", "AdjustPrivilege(5,process)", "AdjustPrivilege(7,process)",
+            "CreateProcessAsUser", "CloseObject"};
+        TEST_ASSERT(fake.calls == expected, "Direct TCB host should skip impersonation and use CreateProcessAsUserW");
+        TEST_ASSERT(fake.launches.size() == 1, "Direct TCB host should launch once");
+        TEST_ASSERT(fake.launches[0].creationFlags == (0x20 | PROCESS_CREATE_NEW_CONSOLE),
+                    "New console flag should be added to the creation flags");
+        TEST_ASSERT(fake.launches[0].desktop == L"winsta0\\default", "Launch should target the interactive desktop");
+        TEST_ASSERT(fake.openObjects == 0, "Direct TCB launch should close every handle");
+    }
+
+    // TEST 3: Host tanpa TCB - impersonation winlogon.exe lalu TCB di token thread
+    fake.ResetCalls();
+    FakeProcessBackend::ConfigureImpersonationHost(fake);
+    {
+        OsHandle token = AcquireTrustedInstallerToken();
+        std::vector<std::string> expected = {
+            "AdjustPrivilege(7,process)", "AdjustPrivilege(20,process)", "FindProcessByName",
+            "OpenProcessToken", "ImpersonateToken", "CloseObject", "AdjustPrivilege(7,thread)",
+            "LogonTrustedInstaller(thread)", "RevertImpersonation"};
+        TEST_ASSERT(token != OS_INVALID_HANDLE, "Impersonation host should acquire the TI token");
+        TEST_ASSERT(fake.calls == expected, "Impersonation host should borrow TCB from winlogon.exe");
+        TEST_ASSERT(!fake.impersonating, "Acquisition should revert the impersonation");
+        fake.CloseObject(token);
+        TEST_ASSERT(fake.openObjects == 0, "Acquisition should close every handle but the token");
+    }
+
+    // TEST 4: LogonUserExExW gagal - revert tetap dilakukan dan error dipertahankan
+    fake.ResetCalls();
+    fake.logonError = 1385; // ERROR_LOGON_TYPE_NOT_GRANTED
+    {
+        TEST_ASSERT(AcquireTrustedInstallerToken() == OS_INVALID_HANDLE, "Failed logon should return no token");
+        TEST_ASSERT(fake.CountCalls("RevertImpersonation") == 1, "Failed logon should still revert");
+        TEST_ASSERT(!fake.impersonating, "Failed logon should leave the thread unimpersonated");
+        TEST_ASSERT(fake.GetLastErrorCode() == 1385, "Failed logon should keep its error code");
+    }
+    fake.logonError = 0;
+
+    // TEST 5: winlogon.exe tidak ditemukan - tidak ada logon maupun revert
+    fake.processes.clear();
+    fake.ResetCalls();
+    {
+        TEST_ASSERT(AcquireTrustedInstallerToken() == OS_INVALID_HANDLE, "Missing winlogon.exe should return no token");
+        TEST_ASSERT(fake.CountCalls("LogonTrustedInstaller") == 0, "Missing winlogon.exe should skip the logon");
+        TEST_ASSERT(fake.CountCalls("RevertImpersonation") == 0, "Missing winlogon.exe should not revert");
+    }
+    FakeProcessBackend::ConfigureImpersonationHost(fake);
+
+    // TEST 6: CreateProcessWithTokenW gagal - error tidak tertimpa CloseHandle token
+    fake.ResetCalls();
+    fake.createProcessError = 740; // ERROR_ELEVATION_REQUIRED
+    {
+        TEST_ASSERT(!LaunchWithTrustedInstaller(L"", L"\"C:\\Tools\\app.exe\"", 0x20),
+                    "Failed CreateProcessWithTokenW should fail the launch");
+        TEST_ASSERT(fake.GetLastErrorCode() == 740, "CreateProcessWithTokenW error should survive closing the token");
+        TEST_ASSERT(fake.openObjects == 0, "Failed launch should close every handle");
+    }
+    fake.createProcessError = 0;
+
+    // TEST 7: Executable tanpa handle terbuka ditolak sebelum akuisisi token
+    fake.ResetCalls();
+    {
+        ValidatedExecutable closed;
+        closed.path = L"C:\\Tools\\app.exe";
+        closed.kind = EXECUTABLE_KIND_PE_IMAGE;
+        TEST_ASSERT(!LaunchValidatedExecutable(closed, 0x20), "Executable without an open handle should be rejected");
+        TEST_ASSERT(fake.calls.empty(), "Closed executable should be rejected before token acquisition");
+        TEST_ASSERT(fake.GetLastErrorCode() == OS_ERROR_INVALID_HANDLE,
+                    "Closed executable should report an invalid handle");
+    }
+
+    // TEST 8: Executable tervalidasi - PE image lewat lpApplicationName, path di-quote
+    FakeFileSystemBackend fs;
+    fs.files[L"C:\\Program Files\\Tools\\app.exe"] = BuildTestPeImage(2);
+    fs.files[L"C:\\Tools\\fix.cmd"] = std::vector<uint8_t>(16, 'x');
+    SetFileSystemBackend(&fs);
+    fake.ResetCalls();
+    {
+        ValidatedExecutable exe;
+        ValidatedExecutable script;
+        TEST_ASSERT(ValidateExecutable(L"C:\\Program Files\\Tools\\app.exe", exe) == VALIDATION_OK,
+                    "PE image with a space in its path should validate");
+        TEST_ASSERT(ValidateExecutable(L"C:\\Tools\\fix.cmd", script) == VALIDATION_OK, "Script should validate");
+        TEST_ASSERT(LaunchValidatedExecutable(exe, 0x20) && LaunchValidatedExecutable(script, 0x20),
+                    "Validated PE image and script should launch");
+        TEST_ASSERT(fake.launches.size() == 2, "Both validated executables should launch");
+        TEST_ASSERT(fake.launches[0].applicationName == L"C:\\Program Files\\Tools\\app.exe",
+                    "PE image should be passed as lpApplicationName");
+        TEST_ASSERT(fake.launches[0].commandLine == L"\"C:\\Program Files\\Tools\\app.exe\"",
+                    "PE image path should be quoted in the command line");
+        TEST_ASSERT(fake.launches[1].applicationName.empty(), "Script should launch without lpApplicationName");
+    }
+    SetFileSystemBackend(NULL);
+
+    // TEST 9: Deteksi privilege - TCB enabled atau admin elevated
+    {
+        TEST_ASSERT(!HasElevatedPrivileges(), "Unprivileged host should not be elevated");
+        fake.elevatedAdministrator = true;
+        TEST_ASSERT(HasElevatedPrivileges(), "Elevated administrator should count as elevated");
+        fake.elevatedAdministrator = false;
+        fake.enabledPrivileges = {SE_TCB_PRIVILEGE};
+        TEST_ASSERT(HasElevatedPrivileges(), "Enabled TCB privilege should count as elevated");
+    }
+
+    SetProcessBackend(NULL);
+
+    TEST_PASS("Trusted Installer acquisition chain works against the fake process backend");
+}
+
+/**
+ * @brief Test RunAsTrustedInstaller: callback in-process di bawah token TI
+ *
+ * Ribuan callback hanya memicu satu rantai akuisisi dan satu impersonation;
+ * error akuisisi dikembalikan ke pemanggil tanpa menjalankan callback,
+ * exception callback diteruskan, dan impersonation di-revert saat berhenti.
+ */
+bool TestRunAsTrustedInstaller() {
+    std::cout << "Testing in-process RunAsTrustedInstaller worker..." << std::endl;
+
+    FakeProcessBackend fake;
+    FakeProcessBackend::ConfigureImpersonationHost(fake);
+    SetProcessBackend(&fake);
+
+    TrustedInstallerTokenCache cache;
+    {
+        TrustedInstallerWorker worker(cache);
+
+        // TEST 1: 1000 callback sinkron - satu logon, satu impersonation TI
+        const int operations = 1000;
+        int counter = 0;
+        bool alwaysImpersonating = true;
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < operations; i++) {
+            TEST_ASSERT(worker.Run([&] {
+                counter++;
+                alwaysImpersonating = alwaysImpersonating && fake.impersonating;
+            }), "Synchronous callbacks should run");
+        }
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        std::cout << "  " << operations << " callbacks: " << std::fixed << std::setprecision(0)
+                  << operations / std::max(seconds, 1e-9) << " ops/s" << std::endl;
+        TEST_ASSERT((counter == operations) && alwaysImpersonating,
+                    "Every callback should run under the TI impersonation");
+        TEST_ASSERT(fake.CountCalls("LogonTrustedInstaller") == 1, "Callbacks should share one logon");
+        TEST_ASSERT(fake.CountCalls("ImpersonateToken") == 2, // winlogon.exe + TI
+                    "Callbacks should share one TI impersonation");
+
+        // TEST 2: Submit asinkron - urutan antrian dipertahankan
+        std::vector<int> order;
+        std::vector<std::future<uint32_t>> results;
+        for (int i = 0; i < 16; i++) {
+            results.push_back(worker.Submit([&order, i] { order.push_back(i); }));
+        }
+        for (auto& result : results) {
+            TEST_ASSERT(result.get() == 0, "Submitted tasks should complete without error");
+        }
+        TEST_ASSERT(order.size() == 16, "Every submitted task should run");
+        for (size_t i = 0; i < order.size(); i++) {
+            TEST_ASSERT(order[i] == static_cast<int>(i), "Submitted tasks should run in queue order");
+        }
+
+        // TEST 3: Exception callback sampai ke pemanggil, worker tetap berjalan
+        bool caught = false;
+        try {
+            worker.Run([] { throw std::runtime_error("callback failed"); });
+        } catch (const std::runtime_error&) {
+            caught = true;
+        }
+        TEST_ASSERT(caught && worker.Run([&] { counter++; }),
+                    "Callback exception should reach the caller and the worker should keep running");
+
+        // TEST 4: Run bersarang dijalankan langsung di thread worker (tanpa deadlock)
+        bool nested = false;
+        TEST_ASSERT(worker.Run([&] {
+            nested = worker.Run([&] { nested = fake.impersonating; }) && nested;
+        }), "Nested Run should execute inline on the worker thread");
+        TEST_ASSERT(nested, "Nested Run should stay impersonated");
+
+        // TEST 5: Token diganti - akuisisi ulang dari konteks proses lalu impersonate ulang
+        cache.Invalidate();
+        fake.ResetCalls();
+        TEST_ASSERT(worker.Run([&] { counter++; }), "Worker should reacquire an invalidated token");
+        TEST_ASSERT(fake.calls.size() > 0 && fake.calls[0] == "RevertImpersonation",
+                    "Reacquisition should revert before logging on");
+        TEST_ASSERT(fake.CountCalls("LogonTrustedInstaller") == 1, "Reacquisition should log on once");
+        TEST_ASSERT(fake.CountCalls("ImpersonateToken") == 2,
+                    "Reacquisition should impersonate winlogon.exe and the new token");
+
+        // TEST 6: Akuisisi gagal - callback tidak dijalankan, error sampai ke pemanggil
+        cache.Invalidate();
+        fake.logonError = 1385; // ERROR_LOGON_TYPE_NOT_GRANTED
+        int before = counter;
+        TEST_ASSERT(!worker.Run([&] { counter++; }), "Run should fail when acquisition fails");
+        TEST_ASSERT(counter == before, "Callback should not run without a token");
+        TEST_ASSERT(fake.GetLastErrorCode() == 1385, "Acquisition error should reach the caller");
+        TEST_ASSERT(!fake.impersonating, "Failed acquisition should leave the worker unimpersonated");
+        fake.logonError = 0;
+        TEST_ASSERT(worker.Run([&] { counter++; }) && (counter == before + 1),
+                    "Worker should recover once logon succeeds again");
+
+        // TEST 7: Setelah Stop impersonation di-revert dan Submit ditolak
+        worker.Stop();
+        TEST_ASSERT(!fake.impersonating, "Stop should revert the impersonation");
+        TEST_ASSERT(worker.Submit([&] { counter++; }).get() == OS_ERROR_OPERATION_ABORTED,
+                    "Submit after Stop should be aborted");
+        TEST_ASSERT(!worker.Run([&] { counter++; }), "Run after Stop should fail");
+        TEST_ASSERT(counter == before + 1, "Tasks after Stop should not run");
+    }
+    cache.Invalidate();
+    TEST_ASSERT(fake.openObjects == 0, "Worker should close every handle");
+
+    // TEST 8: API global - worker bersama dibuat saat pemanggilan pertama
+    {
+        int calls = 0;
+        TEST_ASSERT(RunAsTrustedInstaller([&] { calls++; }) && RunAsTrustedInstaller([&] { calls++; }),
+                    "Global worker should run callbacks");
+        TEST_ASSERT(calls == 2, "Global worker should run both callbacks");
+        ShutdownTrustedInstallerWorker();
+        TEST_ASSERT(!fake.impersonating && (fake.openObjects == 0),
+                    "Shutdown should revert and close the global worker");
+
+        // TEST 9: Shutdown dari callback worker - tidak join diri sendiri, worker baru dibuat berikutnya
+        bool shutdownFromCallback = false;
+        try {
+            shutdownFromCallback = RunAsTrustedInstaller([&] { ShutdownTrustedInstallerWorker(); calls++; });
+        } catch (const std::exception&) {
+            shutdownFromCallback = false;
+        }
+        TEST_ASSERT(shutdownFromCallback && RunAsTrustedInstaller([&] { calls++; }) && (calls == 4),
+                    "Shutdown from a callback should not join itself and a new worker should start");
+        ShutdownTrustedInstallerWorker();
+        TEST_ASSERT(!fake.impersonating && (fake.openObjects == 0),
+                    "Second shutdown should revert and close the global worker");
+    }
+
+    // TEST 10: Stop + Invalidate dari callback (seperti Shutdown) - task yang masih antri
+    // dibatalkan, bukan dijalankan dengan token TI baru yang tidak pernah ditutup
+    {
+        int queuedRuns = 0;
+        std::future<uint32_t> queued;
+        int logons = 0;
+        {
+            TrustedInstallerWorker worker(cache);
+            TEST_ASSERT(worker.Run([] {}), "Worker should start");
+            logons = fake.CountCalls("LogonTrustedInstaller");
+            TEST_ASSERT(worker.Run([&] {
+                queued = worker.Submit([&] { queuedRuns++; });
+                worker.Stop();
+                cache.Invalidate();
+            }), "Callback that stops its worker should complete");
+        }
+        TEST_ASSERT((queued.get() == OS_ERROR_OPERATION_ABORTED) && (queuedRuns == 0),
+                    "Queued task should be aborted when its worker stops");
+        TEST_ASSERT(fake.CountCalls("LogonTrustedInstaller") == logons, "Aborted task should not log on again");
+        TEST_ASSERT(!cache.HasToken() && !fake.impersonating && (fake.openObjects == 0),
+                    "Stopped worker should not leave a token open");
+    }
+
+    SetProcessBackend(NULL);
+
+    TEST_PASS("RunAsTrustedInstaller runs callbacks in-process under the Trusted Installer token");
+}
+
+/**
+ * @brief Test C ABI (RasTIApi.h) di atas backend palsu
+ *
+ * Satu token melayani banyak launch tanpa akuisisi ulang; setiap kegagalan
+ * melaporkan tahap dan kode error yang tepat; handle token dan proses
+ * ditutup oleh RastiReleaseToken/RastiCloseProcess.
+ */
+bool TestCApi() {
+    std::cout << "Testing embeddable C ABI..." << std::endl;
+
+    FakeFileSystemBackend fs;
+    FakeProcessBackend ps;
+    FakeProcessBackend::ConfigureDirectTcbHost(ps);
+    fs.files[L"C:\\Tools\\app.exe"] = BuildTestPeImage(2);
+    fs.files[L"C:\\Tools\\other.exe"] = BuildTestPeImage(3);
+    SetFileSystemBackend(&fs);
+    SetProcessBackend(&ps);
+    RastiError error = {};
+
+    // TEST 1: Akuisisi sekali - token milik pemanggil
+    RastiToken token = NULL;
+    TEST_ASSERT(RastiAcquireToken(&token) && token != NULL, "Token should be acquired");
+    TEST_ASSERT((ps.CountCalls("LogonTrustedInstaller") == 1) && (ps.openObjects == 1),
+                "Token should be acquired with one logon and owned by the caller");
+
+    // TEST 2: Validasi mengisi detail executable
+    RastiValidationInfo info = {};
+    info.size = sizeof(info);
+    TEST_ASSERT(RastiValidate("C:\\Tools\\app.exe", &info), "Executable should validate through the C ABI");
+    TEST_ASSERT((info.kind == 1) && (std::string(info.path) == "C:\\Tools\\app.exe"),
+                "Validation info should carry the kind and path");
+
+    // TEST 3: Launch dengan argumen dan priority, lalu wait dengan exit code
+    RastiLaunchOptions options = {};
+    options.size = sizeof(options);
+    options.path = "C:\\Tools\\app.exe";
+    options.arguments = "/quiet";
+    options.priority = 0x80; // HIGH_PRIORITY_CLASS
+    RastiProcess process = NULL;
+    uint32_t processId = 0;
+    ps.processExitCode = 3;
+    TEST_ASSERT(RastiLaunch(token, &options, &process, &processId) && process != NULL && processId != 0,
+                "Launch should return the process and its ID");
+    TEST_ASSERT(ps.launches.size() == 1, "One process should be launched");
+    TEST_ASSERT(ps.launches[0].commandLine == L"\"C:\\Tools\\app.exe\" /quiet",
+                "Arguments should be appended to the quoted path");
+    TEST_ASSERT(ps.launches[0].creationFlags == (0x80 | PROCESS_CREATE_NEW_CONSOLE),
+                "Priority class should be kept with a new console");
+    uint32_t exitCode = 0;
+    TEST_ASSERT(RastiWait(process, RASTI_WAIT_INFINITE, &exitCode) && (exitCode == 3),
+                "Wait should return the exit code");
+
+    // TEST 4: Timeout wait dilaporkan dengan tahap dan kode WAIT_TIMEOUT
+    ps.waitError = OS_ERROR_WAIT_TIMEOUT;
+    TEST_ASSERT(!RastiWait(process, 10, &exitCode), "Wait should time out");
+    RastiGetLastError(&error);
+    TEST_ASSERT((error.phase == RASTI_PHASE_WAIT) && (error.code == OS_ERROR_WAIT_TIMEOUT),
+                "Wait timeout should report the wait phase and WAIT_TIMEOUT");
+    ps.waitError = 0;
+    RastiCloseProcess(process);
+
+    // TEST 5: Banyak launch memakai token yang sama tanpa akuisisi ulang
+    options.arguments = NULL;
+    options.priority = 0;
+    for (int i = 0; i < 100; i++) {
+        TEST_ASSERT(RastiLaunch(token, &options, NULL, NULL), "Repeated launches should succeed");
+    }
+    TEST_ASSERT((ps.CountCalls("LogonTrustedInstaller") == 1) && (ps.launches.size() == 101),
+                "Repeated launches should reuse one token");
+    TEST_ASSERT(ps.launches.back().creationFlags == (0x20 | PROCESS_CREATE_NEW_CONSOLE),
+                "Default priority should launch with a new console");
+
+    // TEST 6: Priority di luar priority class ditolak sebelum validasi
+    ps.ResetCalls();
+    options.priority = PROCESS_CREATE_NEW_CONSOLE;
+    TEST_ASSERT(!RastiLaunch(token, &options, NULL, NULL), "Non-priority flags should be rejected");
+    RastiGetLastError(&error);
+    TEST_ASSERT((error.phase == RASTI_PHASE_ARGUMENT) && ps.calls.empty(),
+                "Invalid priority should fail in the argument phase before any backend call");
+    options.priority = 0;
+
+    // TEST 7: Kegagalan validasi dan CreateProcessWithTokenW membawa tahapnya
+    options.path = "C:\\Tools\\missing.exe";
+    TEST_ASSERT(!RastiLaunch(token, &options, NULL, NULL), "Missing executable should fail");
+    RastiGetLastError(&error);
+    TEST_ASSERT((error.phase == RASTI_PHASE_VALIDATE) && (error.validation == VALIDATION_NOT_FOUND),
+                "Missing executable should fail in the validate phase");
+    options.path = "C:\\Tools\\app.exe";
+    ps.createProcessError = 740; // ERROR_ELEVATION_REQUIRED
+    TEST_ASSERT(!RastiLaunch(token, &options, NULL, NULL), "Failed CreateProcessWithTokenW should fail the launch");
+    RastiGetLastError(&error);
+    TEST_ASSERT((error.phase == RASTI_PHASE_LAUNCH) && (error.code == 740),
+                "Failed launch should report the launch phase and its error");
+    ps.createProcessError = 0;
+
+    // TEST 8: Allowlist dari file - hash lain ditolak, NULL menonaktifkan
+    Sha256Digest approved = ComputeSha256(fs.files[L"C:\\Tools\\app.exe"].data(), fs.files[L"C:\\Tools\\app.exe"].size());
+    std::string allowlistText = Sha256ToHex(approved) + "\n";
+    fs.files[L"C:\\Config\\RasTI.allowlist"] = std::vector<uint8_t>(allowlistText.begin(), allowlistText.end());
+    GetFileHashCache().Clear();
+    TEST_ASSERT(RastiLoadAllowlist("C:\\Config\\RasTI.allowlist", NULL), "Allowlist file should load");
+    TEST_ASSERT(RastiValidate("C:\\Tools\\app.exe", NULL) && !RastiValidate("C:\\Tools\\other.exe", NULL),
+                "Allowlist should accept the approved hash and reject others");
+    RastiGetLastError(&error);
+    TEST_ASSERT(error.validation == VALIDATION_NOT_ALLOWLISTED, "Rejected hash should report NOT_ALLOWLISTED");
+    TEST_ASSERT(RastiLoadAllowlist(NULL, NULL) && RastiValidate("C:\\Tools\\other.exe", NULL),
+                "Clearing the allowlist should accept any executable");
+
+    // TEST 9: Release menutup semua handle
+    RastiReleaseToken(token);
+    TEST_ASSERT(ps.openObjects == 0, "Release should close every handle");
+
+    // TEST 10: Akuisisi gagal - tahap acquire dengan kode LogonUserExExW
+    ps.logonError = 1385; // ERROR_LOGON_TYPE_NOT_GRANTED
+    token = NULL;
+    TEST_ASSERT(!RastiAcquireToken(&token) && token == NULL, "Failed logon should return no token");
+    RastiGetLastError(&error);
+    TEST_ASSERT((error.phase == RASTI_PHASE_ACQUIRE) && (error.code == 1385),
+                "Failed logon should report the acquire phase and its error");
+    TEST_ASSERT(std::string(RastiGetPhaseName(error.phase)) == "acquire", "acquire should format as its phase name");
+    ps.logonError = 0;
+
+    SetProcessBackend(NULL);
+    SetFileSystemBackend(NULL);
+
+    TEST_PASS("C ABI acquires, validates, launches, and waits through the fake backends");
+}
+
+//==============================================================================
+// MICROBENCHMARK HARNESS TESTS
+//==============================================================================
+
+/**
+ * @brief Test baseline JSON microbenchmark dan deteksi regresi
+ *
+ * Baseline harus round trip tanpa kehilangan data; compare menandai case yang
+ * melambat melebihi threshold atau menambah alokasi/op, dan mengabaikan case
+ * yang tidak ada di baseline.
+ */
+bool TestMicrobenchmarkBaseline() {
+    std::cout << "Testing microbenchmark baseline and compare..." << std::endl;
+
+    std::vector<MicrobenchmarkResult> baseline(3);
+    baseline[0].name = "SanitizePath";
+    baseline[0].nsPerOp = 100.0;
+    baseline[0].allocationsPerOp = 1.0;
+    baseline[0].iterations = 200000;
+    baseline[1].name = "FindExecutableInPath/\"scan\"";
+    baseline[1].nsPerOp = 2000.0;
+    baseline[1].allocationsPerOp = 12.5;
+    baseline[1].iterations = 10000;
+    baseline[2].name = "GetTrustedInstallerToken/direct-tcb";
+    baseline[2].nsPerOp = 350.0;
+    baseline[2].allocationsPerOp = 0.0;
+    baseline[2].iterations = 60000;
+
+    bool passed = true;
+
+    // TEST 1: Round trip Format -> Parse
+    std::vector<MicrobenchmarkResult> parsed;
+    passed = passed && ParseMicrobenchmarkBaseline(FormatMicrobenchmarkBaseline(baseline), parsed);
+    passed = passed && (parsed.size() == baseline.size());
+    for (size_t i = 0; passed && i < parsed.size(); i++) {
+        passed = passed && (parsed[i].name == baseline[i].name);
+        passed = passed && (std::fabs(parsed[i].nsPerOp - baseline[i].nsPerOp) < 0.01);
+        passed = passed && (std::fabs(parsed[i].allocationsPerOp - baseline[i].allocationsPerOp) < 0.01);
+        passed = passed && (parsed[i].iterations == baseline[i].iterations);
+    }
+
+    // TEST 2: Regresi waktu dan alokasi ditandai; perlambatan kecil tidak
+    std::vector<MicrobenchmarkResult> current = baseline;
+    current[0].nsPerOp = 105.0;              // +5% - di bawah threshold
+    current[1].nsPerOp = 2600.0;             // +30% - regresi
+    current[2].allocationsPerOp = 1.0;       // alokasi baru - regresi
+    MicrobenchmarkResult added;
+    added.name = "NewBenchmark";
+    added.nsPerOp = 1.0;
+    current.push_back(added);                // tidak ada di baseline - dilewati
+
+    std::vector<MicrobenchmarkComparison> comparison = CompareMicrobenchmarks(current, baseline, 10.0);
+    passed = passed && (comparison.size() == 3);
+    passed = passed && !comparison[0].regression;
+    passed = passed && comparison[1].regression && std::fabs(comparison[1].changePercent - 30.0) < 0.01;
+    passed = passed && comparison[2].regression;
+
+    std::ostringstream report;
+    passed = passed && (PrintMicrobenchmarkComparison(comparison, report) == 2);
+
+    // TEST 3: Input yang bukan baseline ditolak
+    passed = passed && !ParseMicrobenchmarkBaseline("{\"version\": 1}", parsed);
+
+    TEST_ASSERT(passed, "Baseline should round trip and compare should flag only real regressions");
+
+    TEST_PASS("Microbenchmark baseline and compare work");
+}
+
+//==============================================================================
+// LAUNCH LATENCY BENCHMARK TESTS
+//==============================================================================
+
+/**
+ * @brief Test benchmark launch end-to-end terhadap backend palsu
+ *
+ * Memeriksa perhitungan percentile nearest-rank, jumlah sampel per fase,
+ * bahwa jalur warm memakai token cache (satu logon untuk semua siklus warm),
+ * dan bahwa kegagalan melaporkan fase serta kode error yang benar.
+ */
+bool TestLaunchBenchmark() {
+    std::cout << "Testing end-to-end launch latency benchmark..." << std::endl;
+
+    // TEST 1: Nearest-rank percentile pada 1..100
+    std::vector<double> samples;
+    for (int i = 100; i >= 1; i--) samples.push_back(i);
+    LatencyPercentiles stats = ComputeLatencyPercentiles(samples);
+    TEST_ASSERT(stats.samples == 100 && stats.p50Us == 50.0 && stats.p90Us == 90.0,
+                "Percentiles should use the nearest rank");
+    TEST_ASSERT(stats.p99Us == 99.0 && stats.maxUs == 100.0, "Tail percentiles should use the nearest rank");
+
+    std::vector<double> single(1, 7.0);
+    stats = ComputeLatencyPercentiles(single);
+    TEST_ASSERT(stats.p50Us == 7.0 && stats.p99Us == 7.0 && stats.maxUs == 7.0,
+                "Single sample should give every percentile");
+
+    // TEST 2: Cold = akuisisi penuh per siklus, warm = token cache
+    FakeFileSystemBackend fs;
+    FakeProcessBackend ps;
+    FakeProcessBackend::ConfigureImpersonationHost(ps);
+    fs.files[L"C:\\Windows\\System32\\cmd.exe"] = BuildTestPeImage(3);
+    ps.logonLatency = std::chrono::microseconds(200);
+    SetFileSystemBackend(&fs);
+    SetProcessBackend(&ps);
+
+    LaunchBenchmarkOptions options;
+    options.targetPath = L"C:\\Windows\\System32\\cmd.exe";
+    options.arguments = L"/c exit";
+    options.iterations = 10;
+
+    LaunchBenchmarkReport report;
+    TEST_ASSERT(RunLaunchBenchmark(options, report) && !report.failed, "Benchmark should succeed");
+    TEST_ASSERT(report.cold.completed == 10 && report.warm.completed == 10,
+                "Every cold and warm iteration should complete");
+    for (int phase = 0; phase < LAUNCH_PHASE_COUNT; phase++) {
+        TEST_ASSERT(report.cold.phases[phase].samples == 10 && report.warm.phases[phase].samples == 10,
+                    "Every phase should have one sample per iteration");
+        TEST_ASSERT(report.cold.phases[phase].p50Us <= report.cold.phases[phase].p90Us, "Median should not exceed p90");
+        TEST_ASSERT(report.cold.phases[phase].p99Us <= report.cold.phases[phase].maxUs,
+                    "p99 should not exceed the maximum");
+    }
+    TEST_ASSERT(ps.CountCalls("LogonTrustedInstaller") == 11, // 10 cold + 1 pemanasan warm
+                "Cold cycles should log on each time and warm once");
+    TEST_ASSERT(ps.CountCalls("CreateProcessWithToken") == 21, "Every launch should go through seclogon");
+    // Host ini tanpa privilege CreateProcessAsUserW: setiap launcher baru mem-probe
+    // sekali lewat impersonation lalu jatuh ke seclogon (10 cold + 1 warm)
+    TEST_ASSERT(ps.CountCalls("RevertImpersonation") == 22, "Each new launcher should probe CreateProcessAsUserW once");
+    TEST_ASSERT(ps.CountCalls("CreateProcessAsUser") == 0,
+                "Host without the privileges should never call CreateProcessAsUserW");
+    TEST_ASSERT(report.cold.launchesByApi[LAUNCH_API_SECLOGON] == 10, "Cold launches should be counted under seclogon");
+    TEST_ASSERT(report.warm.launchesByApi[LAUNCH_API_SECLOGON] == 10, "Warm launches should be counted under seclogon");
+    TEST_ASSERT(ps.openObjects == 0 && fs.openHandles == 0 && !ps.impersonating,
+                "Benchmark should close every handle and revert");
+    TEST_ASSERT(report.cold.phases[LAUNCH_PHASE_ACQUIRE].p50Us >= 200.0,
+                "Cold acquire should include the logon latency");
+    TEST_ASSERT(report.warm.phases[LAUNCH_PHASE_ACQUIRE].maxUs < report.cold.phases[LAUNCH_PHASE_ACQUIRE].p50Us,
+                "Warm acquire should be faster than cold acquire");
+    TEST_ASSERT(ps.launches.size() == 21 && ps.launches[0].commandLine == L"\"C:\\Windows\\System32\\cmd.exe\" /c exit",
+                "Benchmark should launch the target with its arguments");
+
+    std::cout << FormatLaunchBenchmarkReport(report);
+
+    // TEST 3: Logon gagal - berhenti di fase acquire dengan error LSA
+    ps.ResetCalls();
+    ps.logonLatency = std::chrono::microseconds(0);
+    ps.logonError = 1385; // ERROR_LOGON_TYPE_NOT_GRANTED
+    TEST_ASSERT(!RunLaunchBenchmark(options, report), "Benchmark should fail when logon fails");
+    TEST_ASSERT(report.failed && report.failedPhase == LAUNCH_PHASE_ACQUIRE && report.errorCode == 1385,
+                "Failed logon should stop in the acquire phase with its error");
+    TEST_ASSERT(report.cold.completed == 0 && ps.CountCalls("CreateProcessWithToken") == 0,
+                "Failed logon should not launch anything");
+
+    // TEST 4: Target tidak ada - berhenti di fase validate
+    ps.logonError = 0;
+    options.targetPath = L"C:\\Windows\\System32\\missing.exe";
+    TEST_ASSERT(!RunLaunchBenchmark(options, report), "Benchmark should fail for a missing target");
+
+    SetProcessBackend(NULL);
+    SetFileSystemBackend(NULL);
+    TEST_ASSERT(report.failedPhase == LAUNCH_PHASE_VALIDATE && report.errorCode != VALIDATION_OK,
+                "Missing target should stop in the validate phase");
+
+    TEST_PASS("Launch latency benchmark reports per-phase percentiles");
+}
+
+/**
+ * @brief Test mode console (/console) dan biayanya di benchmark launch
+ *
+ * AUTO mengikuti subsystem PE (GUI tanpa console), setiap mode memetakan ke
+ * flag CreateProcess/STARTUPINFO yang sesuai, dan benchmark melaporkan
+ * latency serta commit tambahan untuk console baru dibanding tanpa console.
+ */
+bool TestConsoleModeLaunch() {
+    std::cout << "Testing console modes and their launch cost..." << std::endl;
+
+    // TEST 1: Parse nama mode (case-insensitive) dan tolak yang tidak dikenal
+    ConsoleMode mode = CONSOLE_MODE_AUTO;
+    TEST_ASSERT(ParseConsoleMode("hidden", mode) && mode == CONSOLE_MODE_HIDDEN, "Console mode names should parse");
+    TEST_ASSERT(ParseConsoleMode("None", mode) && mode == CONSOLE_MODE_NONE,
+                "Mode names should parse case-insensitively");
+    TEST_ASSERT(!ParseConsoleMode("detached", mode) && !ParseConsoleMode("", mode) && mode == CONSOLE_MODE_NONE,
+                "Unknown and empty mode names should be rejected and leave the value unchanged");
+    TEST_ASSERT(std::string(GetConsoleModeName(CONSOLE_MODE_INHERIT)) == "inherit",
+                "inherit should format as its name");
+
+    // TEST 2: AUTO - GUI tanpa console, console/script mendapat console baru
+    ValidatedExecutable gui;
+    gui.kind = EXECUTABLE_KIND_PE_IMAGE;
+    gui.image.subsystem = PROCESS_SUBSYSTEM_GUI;
+    ValidatedExecutable cui;
+    cui.kind = EXECUTABLE_KIND_PE_IMAGE;
+    cui.image.subsystem = 3;
+    ValidatedExecutable script;
+    script.kind = EXECUTABLE_KIND_SCRIPT;
+    TEST_ASSERT(ResolveConsoleMode(CONSOLE_MODE_AUTO, gui) == CONSOLE_MODE_NONE,
+                "AUTO should give GUI images no console");
+    TEST_ASSERT(ResolveConsoleMode(CONSOLE_MODE_AUTO, cui) == CONSOLE_MODE_NEW,
+                "AUTO should give console images a new console");
+    TEST_ASSERT(ResolveConsoleMode(CONSOLE_MODE_AUTO, script) == CONSOLE_MODE_NEW,
+                "AUTO should give scripts a new console");
+    TEST_ASSERT(ResolveConsoleMode(CONSOLE_MODE_HIDDEN, gui) == CONSOLE_MODE_HIDDEN,
+                "Explicit mode should override the subsystem");
+
+    // TEST 3: Flag per mode; flag console sebelumnya selalu diganti, priority dipertahankan
+    ProcessLaunchRequest request;
+    request.creationFlags = 0x80 | PROCESS_CREATE_NEW_CONSOLE | PROCESS_DETACHED;
+    request.startupFlags = PROCESS_STARTF_USESHOWWINDOW;
+    ApplyConsoleMode(CONSOLE_MODE_INHERIT, request);
+    TEST_ASSERT(request.creationFlags == 0x80 && request.startupFlags == 0, "inherit should clear the console flags");
+    ApplyConsoleMode(CONSOLE_MODE_NONE, request);
+    TEST_ASSERT(request.creationFlags == (0x80 | PROCESS_DETACHED) && request.startupFlags == 0,
+                "none should launch detached");
+    ApplyConsoleMode(CONSOLE_MODE_HIDDEN, request);
+    TEST_ASSERT(request.creationFlags == (0x80 | PROCESS_CREATE_NEW_CONSOLE), "hidden should create a new console");
+    TEST_ASSERT(request.startupFlags == PROCESS_STARTF_USESHOWWINDOW && request.showWindow == PROCESS_SHOW_HIDDEN,
+                "hidden should hide the console window");
+    ApplyConsoleMode(CONSOLE_MODE_NEW, request);
+    TEST_ASSERT(request.creationFlags == (0x80 | PROCESS_CREATE_NEW_CONSOLE) && request.startupFlags == 0,
+                "new should create a visible console and keep the priority class");
+
+    // TEST 4: Launch end-to-end - GUI tanpa console, /console eksplisit menang
+    FakeFileSystemBackend fs;
+    FakeProcessBackend ps;
+    FakeProcessBackend::ConfigureImpersonationHost(ps);
+    fs.files[L"C:\\Tools\\viewer.exe"] = BuildTestPeImage(PROCESS_SUBSYSTEM_GUI);
+    fs.files[L"C:\\Windows\\System32\\cmd.exe"] = BuildTestPeImage(3);
+    SetFileSystemBackend(&fs);
+    SetProcessBackend(&ps);
+
+    ValidatedExecutable validated;
+    TEST_ASSERT(ValidateExecutable(L"C:\\Tools\\viewer.exe", validated) == VALIDATION_OK,
+                "GUI executable should validate");
+    TEST_ASSERT(LaunchValidatedExecutable(validated, 0x20), "GUI executable should launch");
+    TEST_ASSERT(LaunchValidatedExecutable(validated, 0x20, CONSOLE_MODE_HIDDEN),
+                "Hidden console launch should succeed");
+    validated.file.Reset();
+    TEST_ASSERT(ps.launches.size() == 2 && ps.launches[0].creationFlags == (0x20 | PROCESS_DETACHED),
+                "GUI executable should launch detached by default");
+    TEST_ASSERT(ps.launches[1].creationFlags == (0x20 | PROCESS_CREATE_NEW_CONSOLE),
+                "Explicit hidden mode should create a console");
+    TEST_ASSERT(ps.launches[1].startupFlags == PROCESS_STARTF_USESHOWWINDOW,
+                "Explicit hidden mode should set the show-window flag");
+
+    // TEST 5: Benchmark new vs none - conhost menambah latency dan commit per launch
+    ps.ResetCalls();
+    ps.launches.clear();
+    ps.consoleLatency = std::chrono::microseconds(2000);
+    ps.processCommitBytes = 100 * 1024;
+    ps.consoleCommitBytes = 400 * 1024;
+
+    LaunchBenchmarkOptions options;
+    options.targetPath = L"C:\\Windows\\System32\\cmd.exe";
+    options.arguments = L"/c exit";
+    options.iterations = 5;
+    options.commitProbe = [&ps](uint64_t& bytes) {
+        bytes = ps.committedBytes;
+        return true;
+    };
+
+    LaunchBenchmarkReport withConsole;
+    TEST_ASSERT(RunLaunchBenchmark(options, withConsole) && !withConsole.failed,
+                "Benchmark with a new console should succeed");
+    TEST_ASSERT(withConsole.warm.commitKb.samples == 5 && withConsole.warm.commitKb.p50Us == 500.0,
+                "New console should add conhost commit per launch");
+    TEST_ASSERT(withConsole.warm.phases[LAUNCH_PHASE_LAUNCH].p50Us >= 2000.0, "New console should add conhost latency");
+
+    options.console = CONSOLE_MODE_NONE;
+    LaunchBenchmarkReport withoutConsole;
+    TEST_ASSERT(RunLaunchBenchmark(options, withoutConsole) && !withoutConsole.failed,
+                "Benchmark without a console should succeed");
+    TEST_ASSERT(withoutConsole.cold.commitKb.maxUs == 100.0 && withoutConsole.warm.commitKb.p50Us == 100.0,
+                "No console should only commit the process itself");
+    TEST_ASSERT(withoutConsole.warm.phases[LAUNCH_PHASE_LAUNCH].p50Us <
+                withConsole.warm.phases[LAUNCH_PHASE_LAUNCH].p50Us,
+                "No console should launch faster than a new console");
+    TEST_ASSERT((ps.launches.back().creationFlags & PROCESS_CREATE_NEW_CONSOLE) == 0,
+                "No console benchmark should not create a console");
+
+    std::string text = FormatLaunchBenchmarkReport(withoutConsole);
+    TEST_ASSERT(text.find("commit") != std::string::npos, "Benchmark report should include commit");
+    std::cout << text;
+
+    // TEST 6: Mode console ikut tersimpan di session trace
+    BackendTraceSession session;
+    session.operation = L"bench";
+    session.target = options.targetPath;
+    session.console = CONSOLE_MODE_HIDDEN;
+    std::string data;
+    {
+        ScopedBackendTrace trace(session, [&data](const uint8_t* bytes, size_t size) {
+            data.append(reinterpret_cast<const char*>(bytes), size);
+        });
+    }
+    BackendTrace trace;
+
+    SetProcessBackend(NULL);
+    SetFileSystemBackend(NULL);
+    TEST_ASSERT(trace.Load(data) && trace.session.console == CONSOLE_MODE_HIDDEN,
+                "Session trace should keep the console mode");
+
+    TEST_PASS("Console modes map to launch flags and their cost is measured");
+}
+
+/**
+ * @brief Test pemilihan API launch (CreateProcessAsUserW vs seclogon)
+ *
+ * Memverifikasi bahwa launcher memakai CreateProcessAsUserW jika privilege
+ * tersedia (di token proses atau token winlogon.exe), jatuh ke seclogon dan
+ * mengingat pilihan itu jika tidak (tanpa menutup token winlogon.exe yang
+ * mungkin sedang dipakai launch paralel), dan bahwa benchmark melaporkan API
+ * yang membuat proses di setiap jalur.
+ */
+bool TestLaunchApiSelection() {
+    std::cout << "Testing launch API selection and seclogon fallback..." << std::endl;
+
+    const std::wstring commandLine = L"\"C:\\Tools\\app.exe\"";
+
+    // TEST 1: Parse nama API (case-insensitive) dan tolak yang tidak dikenal
+    ProcessLaunchApi api = LAUNCH_API_AUTO;
+    TEST_ASSERT(ParseProcessLaunchApi("AsUser", api) && api == LAUNCH_API_AS_USER,
+                "API names should parse case-insensitively");
+    TEST_ASSERT(ParseProcessLaunchApi("seclogon", api) && api == LAUNCH_API_SECLOGON, "seclogon should parse");
+    TEST_ASSERT(!ParseProcessLaunchApi("createprocess", api) && api == LAUNCH_API_SECLOGON,
+                "Unknown API names should be rejected and leave the value unchanged");
+    TEST_ASSERT(std::string(GetProcessLaunchApiName(LAUNCH_API_AS_USER)) == "asuser",
+                "asuser should format as its lowercase name");
+
+    // TEST 2: Admin biasa - privilege ada di token winlogon.exe; token itu dibuka
+    // sekali dan setiap launch meng-impersonate lalu revert
+    FakeProcessBackend ps;
+    FakeProcessBackend::ConfigureImpersonationHost(ps);
+    ps.impersonatedPrivileges = {SE_TCB_PRIVILEGE, SE_ASSIGNPRIMARYTOKEN_PRIVILEGE, SE_INCREASE_QUOTA_PRIVILEGE};
+    SetProcessBackend(&ps);
+    OsHandle token = AcquireTrustedInstallerToken();
+    ps.ResetCalls();
+    {
+        TrustedInstallerLauncher launcher;
+        ProcessLaunchApi used = LAUNCH_API_AUTO;
+        TEST_ASSERT(LaunchWithToken(token, L"", commandLine, 0x20, NULL, NULL, CONSOLE_MODE_NEW, &launcher, &used),
+                    "First launch should succeed on an impersonation host");
+        TEST_ASSERT(used == LAUNCH_API_AS_USER && launcher.GetSelectedApi() == LAUNCH_API_AS_USER,
+                    "First launch should use CreateProcessAsUserW");
+        used = LAUNCH_API_AUTO;
+        TEST_ASSERT(LaunchWithToken(token, L"", commandLine, 0x20, NULL, NULL, CONSOLE_MODE_NEW, &launcher, &used),
+                    "Second launch should succeed");
+        TEST_ASSERT(used == LAUNCH_API_AS_USER, "Second launch should keep CreateProcessAsUserW");
+        TEST_ASSERT(ps.CountCalls("OpenProcessToken") == 1 && ps.CountCalls("CreateProcessAsUser") == 2,
+                    "winlogon.exe token should be opened once for both launches");
+        TEST_ASSERT(ps.CountCalls("RevertImpersonation") == 2 && !ps.impersonating,
+                    "Each launch should revert its impersonation");
+        TEST_ASSERT(ps.CountCalls("CreateProcessWithToken") == 0 && ps.launches.size() == 2,
+                    "No launch should fall back to seclogon");
+    }
+    // Hanya token TI; token winlogon.exe ditutup launcher
+    TEST_ASSERT(ps.openObjects == 1, "Launcher should close the winlogon.exe token");
+
+    // TEST 3: Privilege tidak tersedia - fallback ke seclogon, lalu tanpa probe ulang
+    ps.impersonatedPrivileges = {SE_TCB_PRIVILEGE};
+    ps.ResetCalls();
+    {
+        TrustedInstallerLauncher launcher;
+        ProcessLaunchApi used = LAUNCH_API_AUTO;
+        TEST_ASSERT(LaunchWithToken(token, L"", commandLine, 0x20, NULL, NULL, CONSOLE_MODE_NEW, &launcher, &used),
+                    "Launch should fall back when privileges are missing");
+        TEST_ASSERT(used == LAUNCH_API_SECLOGON && launcher.GetSelectedApi() == LAUNCH_API_SECLOGON,
+                    "Missing privileges should select seclogon");
+        TEST_ASSERT(ps.CountCalls("CreateProcessAsUser") == 0 && ps.openObjects == 2 && !ps.impersonating,
+                    "Fallback should not try CreateProcessAsUserW and should keep the winlogon.exe token open");
+
+        ps.ResetCalls();
+        TEST_ASSERT(LaunchWithToken(token, L"", commandLine, 0x20, NULL, NULL, CONSOLE_MODE_NEW, &launcher, &used),
+                    "Launch after fallback should succeed");
+        std::vector<std::string> expected = {"CreateProcessWithToken"};
+        TEST_ASSERT(ps.calls == expected, "Launch after fallback should not probe CreateProcessAsUserW again");
+    }
+
+    // TEST 4: CreateProcessAsUserW gagal meski privilege ada - fallback juga diingat
+    FakeProcessBackend::ConfigureDirectTcbHost(ps);
+    ps.asUserError = OS_ERROR_PRIVILEGE_NOT_HELD;
+    ps.ResetCalls();
+    {
+        TrustedInstallerLauncher launcher;
+        ProcessLaunchApi used = LAUNCH_API_AUTO;
+        TEST_ASSERT(LaunchWithToken(token, L"", commandLine, 0x20, NULL, NULL, CONSOLE_MODE_NEW, &launcher, &used),
+                    "Launch should fall back when CreateProcessAsUserW fails");
+        TEST_ASSERT(used == LAUNCH_API_SECLOGON && launcher.GetSelectedApi() == LAUNCH_API_SECLOGON,
+                    "CreateProcessAsUserW failure should select seclogon");
+        TEST_ASSERT(ps.CountCalls("CreateProcessAsUser") == 1 && ps.CountCalls("CreateProcessWithToken") == 1,
+                    "CreateProcessAsUserW failure should be tried once before seclogon");
+    }
+
+    // TEST 5: API dipaksa - asuser tanpa fallback (error dipertahankan), seclogon tanpa probe
+    ps.ResetCalls();
+    {
+        TrustedInstallerLauncher asUser(LAUNCH_API_AS_USER);
+        TEST_ASSERT(!LaunchWithToken(token, L"", commandLine, 0x20, NULL, NULL, CONSOLE_MODE_NEW, &asUser),
+                    "Forced asuser launch should fail without fallback");
+        TEST_ASSERT(ps.GetLastErrorCode() == OS_ERROR_PRIVILEGE_NOT_HELD,
+                    "Forced asuser launch should keep the privilege error");
+        TEST_ASSERT(ps.CountCalls("CreateProcessWithToken") == 0, "Forced asuser launch should not call seclogon");
+
+        ps.ResetCalls();
+        TrustedInstallerLauncher seclogon(LAUNCH_API_SECLOGON);
+        TEST_ASSERT(LaunchWithToken(token, L"", commandLine, 0x20, NULL, NULL, CONSOLE_MODE_NEW, &seclogon),
+                    "Forced seclogon launch should succeed");
+        std::vector<std::string> expected = {"CreateProcessWithToken"};
+        TEST_ASSERT(ps.calls == expected, "Forced seclogon launch should not probe CreateProcessAsUserW");
+    }
+    ps.asUserError = 0;
+
+    // TEST 6: Dua launch paralel, satu fallback ke seclogon. Launch kedua sudah menyalin
+    // token winlogon.exe sebelum fallback; handle itu harus tetap valid sampai launcher dihapus.
+    // Urutan dipaksa hook: launch fallback berjalan sampai selesai tepat sebelum launch
+    // kedua meng-impersonate salinan handle-nya
+    FakeProcessBackend::ConfigureImpersonationHost(ps);
+    ps.impersonatedPrivileges = {SE_TCB_PRIVILEGE, SE_ASSIGNPRIMARYTOKEN_PRIVILEGE, SE_INCREASE_QUOTA_PRIVILEGE};
+    ps.asUserErrors[L"fallback.exe"] = OS_ERROR_PRIVILEGE_NOT_HELD;
+    ps.ResetCalls();
+    {
+        TrustedInstallerLauncher launcher;
+        ProcessLaunchApi firstUsed = LAUNCH_API_AUTO;
+        ProcessLaunchApi secondUsed = LAUNCH_API_AUTO;
+        bool first = false;
+        bool fallbackRan = false;
+        std::thread::id secondThread = std::this_thread::get_id();
+        ps.beforeImpersonate = [&](OsHandle) {
+            if (std::this_thread::get_id() != secondThread || fallbackRan) {
+                return;
+            }
+            fallbackRan = true;
+            std::thread fallback([&] {
+                first = LaunchWithToken(token, L"", L"\"C:\\Tools\\fallback.exe\"", 0x20, NULL, NULL,
+                                        CONSOLE_MODE_NEW, &launcher, &firstUsed);
+            });
+            fallback.join();
+        };
+        bool second = LaunchWithToken(token, L"", commandLine, 0x20, NULL, NULL, CONSOLE_MODE_NEW, &launcher,
+                                      &secondUsed);
+        ps.beforeImpersonate = nullptr;
+        TEST_ASSERT(fallbackRan && first && firstUsed == LAUNCH_API_SECLOGON && second &&
+                    secondUsed == LAUNCH_API_AS_USER,
+                    "Fallback and concurrent asuser launches should both succeed with their own API");
+        TEST_ASSERT(launcher.GetSelectedApi() == LAUNCH_API_SECLOGON && ps.CountCalls("OpenProcessToken") == 1 &&
+                    ps.openObjects == 2 && !ps.impersonating,
+                    "Concurrent fallback should keep the copied winlogon.exe token valid");
+    }
+    ps.asUserErrors.clear();
+
+    // TEST 7: Pemanggil sudah impersonating (callback RunAsTrustedInstaller, host C ABI) -
+    // token pemanggil dipasang kembali setelah impersonation winlogon.exe, bukan di-revert
+    OsHandle callerToken = ps.OpenProcessToken(4);
+    TEST_ASSERT(ps.ImpersonateToken(callerToken), "Test thread should impersonate the caller token");
+    ps.ResetCalls();
+    {
+        TrustedInstallerLauncher launcher;
+        ProcessLaunchApi used = LAUNCH_API_AUTO;
+        TEST_ASSERT(LaunchWithToken(token, L"", commandLine, 0x20, NULL, NULL, CONSOLE_MODE_NEW, &launcher, &used),
+                    "Launch from an impersonating thread should succeed");
+        TEST_ASSERT(used == LAUNCH_API_AS_USER && ps.CurrentThreadToken() == callerToken,
+                    "Caller impersonation should be restored after the launch");
+        TEST_ASSERT(ps.CountCalls("OpenThreadToken") == 1 && ps.CountCalls("RevertImpersonation") == 0,
+                    "Caller impersonation should be queried once and not reverted");
+    }
+    ps.RevertImpersonation();
+    ps.CloseObject(callerToken);
+    TEST_ASSERT(ps.openObjects == 1 && !ps.impersonating, "Caller token should be closed after the test reverts");
+
+    FakeProcessBackend::ConfigureDirectTcbHost(ps);
+    ps.CloseObject(token);
+    TEST_ASSERT(ps.openObjects == 0, "All launch handles should be closed");
+
+    // TEST 8: Benchmark - asuser melewati latency seclogon dan report mencatat API per jalur
+    FakeFileSystemBackend fs;
+    fs.files[L"C:\\Windows\\System32\\cmd.exe"] = BuildTestPeImage(3);
+    SetFileSystemBackend(&fs);
+    ps.seclogonLatency = std::chrono::microseconds(2000);
+
+    LaunchBenchmarkOptions options;
+    options.targetPath = L"C:\\Windows\\System32\\cmd.exe";
+    options.arguments = L"/c exit";
+    options.iterations = 5;
+
+    LaunchBenchmarkReport fast;
+    TEST_ASSERT(RunLaunchBenchmark(options, fast) && !fast.failed,
+                "Benchmark should launch through CreateProcessAsUserW");
+    TEST_ASSERT(fast.cold.launchesByApi[LAUNCH_API_AS_USER] == 5 && fast.warm.launchesByApi[LAUNCH_API_AS_USER] == 5,
+                "Every benchmark launch should use CreateProcessAsUserW");
+
+    options.launchApi = LAUNCH_API_SECLOGON;
+    LaunchBenchmarkReport slow;
+    TEST_ASSERT(RunLaunchBenchmark(options, slow) && !slow.failed, "Forced seclogon benchmark should succeed");
+    TEST_ASSERT(slow.warm.launchesByApi[LAUNCH_API_SECLOGON] == 5 && slow.warm.launchesByApi[LAUNCH_API_AS_USER] == 0,
+                "Every forced seclogon launch should use seclogon");
+    TEST_ASSERT(slow.warm.phases[LAUNCH_PHASE_LAUNCH].p50Us >= 2000.0,
+                "seclogon latency should show in the launch phase");
+    TEST_ASSERT(fast.warm.phases[LAUNCH_PHASE_LAUNCH].p50Us < slow.warm.phases[LAUNCH_PHASE_LAUNCH].p50Us,
+                "asuser launches should be faster than seclogon launches");
+    TEST_ASSERT(ps.openObjects == 0 && fs.openHandles == 0, "Benchmark should close every handle");
+
+    std::string text = FormatLaunchBenchmarkReport(fast);
+    TEST_ASSERT(text.find("launch api: asuser 5") != std::string::npos, "Benchmark report should list the launch API");
+    std::cout << text;
+
+    // TEST 9: API launch ikut tersimpan di session trace
+    BackendTraceSession session;
+    session.operation = L"bench";
+    session.target = options.targetPath;
+    session.launchApi = LAUNCH_API_AS_USER;
+    std::string data;
+    {
+        ScopedBackendTrace trace(session, [&data](const uint8_t* bytes, size_t size) {
+            data.append(reinterpret_cast<const char*>(bytes), size);
+        });
+    }
+    BackendTrace trace;
+
+    SetProcessBackend(NULL);
+    SetFileSystemBackend(NULL);
+    TEST_ASSERT(trace.Load(data) && trace.session.launchApi == LAUNCH_API_AS_USER,
+                "Session trace should keep the launch API");
+
+    TEST_PASS("Launch API selection prefers CreateProcessAsUserW and falls back to seclogon");
+}
+
+/**
+ * @brief Test record/replay trace backend
+ *
+ * Merekam validasi + launch di atas backend palsu, lalu memutar ulang trace
+ * di TraceReplayBackend: hasil, kode error, dan urutan panggilan harus sama
+ * persis dan durasi tercatat ikut direproduksi.
+ */
+bool TestBackendTraceReplay() {
+    std::cout << "Testing backend trace record/replay..." << std::endl;
+
+    const std::wstring target = L"C:\\Tools\\setup.exe";
+
+    FakeFileSystemBackend fs;
+    FakeProcessBackend ps;
+    FakeProcessBackend::ConfigureImpersonationHost(ps);
+    fs.files[target] = BuildTestPeImage(2);
+    ps.logonLatency = std::chrono::microseconds(3000);
+    SetFileSystemBackend(&fs);
+    SetProcessBackend(&ps);
+
+    // TEST 1: Record satu launch - decorator meneruskan hasil backend asli
+    BackendTraceSession session;
+    session.operation = L"launch";
+    session.target = target;
+    session.priority = 0x80;
+
+    std::string data;
+    uint64_t recorded = 0;
+    {
+        ScopedBackendTrace trace(session, [&data](const uint8_t* bytes, size_t size) {
+            data.append(reinterpret_cast<const char*>(bytes), size);
+        });
+        TEST_ASSERT(GetFileSystemBackend() != &fs && GetProcessBackend() != &ps,
+                    "Recording should install tracing decorators");
+
+        ValidatedExecutable validated;
+        TEST_ASSERT(ValidateExecutable(target, validated) == VALIDATION_OK,
+                    "Executable should validate while recording");
+        TEST_ASSERT(LaunchValidatedExecutable(validated, session.priority), "Launch should succeed while recording");
+        validated.file.Reset();
+        recorded = trace.GetRecordCount();
+    }
+    TEST_ASSERT(GetFileSystemBackend() == &fs && GetProcessBackend() == &ps,
+                "Recording scope should restore the original backends");
+    TEST_ASSERT(ps.launches.size() == 1 && recorded > 0,
+                "Recording should pass the launch through and capture records");
+
+    // TEST 2: Parse - session dan jumlah record per jenis panggilan
+    BackendTrace trace;
+    TEST_ASSERT(trace.Load(data), "Recorded trace should load");
+    TEST_ASSERT(trace.session.operation == L"launch" && trace.session.target == target,
+                "Trace should keep the session operation and target");
+    TEST_ASSERT(trace.session.priority == 0x80 && trace.records.size() == recorded,
+                "Trace should keep the priority and every record");
+    size_t logons = 0;
+    size_t creates = 0;
+    for (const BackendTraceRecord& record : trace.records) {
+        if (record.call == TRACE_PS_LOGON_TRUSTED_INSTALLER) logons++;
+        if (record.call == TRACE_PS_CREATE_PROCESS) creates++;
+    }
+    TEST_ASSERT(logons == 1 && creates == 1, "Trace should record one logon and one process creation");
+    TEST_ASSERT(trace.GetTotalDurationNs() >= 3000000ull, "Trace should keep the logon latency");
+    std::string summary = FormatBackendTraceSummary(trace);
+    TEST_ASSERT(summary.find("LogonTrustedInstaller") < summary.find("CreateProcessWithToken"),
+                "Summary should list calls in recorded order");
+    std::cout << summary;
+
+    // TEST 3: Replay dengan latency asli - semua panggilan cocok, tidak ada sisa
+    TraceReplayBackend replay(trace);
+    SetFileSystemBackend(&replay);
+    SetProcessBackend(&replay);
+
+    auto start = std::chrono::steady_clock::now();
+    ValidatedExecutable replayed;
+    TEST_ASSERT(ValidateExecutable(target, replayed) == VALIDATION_OK, "Replay validation should succeed");
+    TEST_ASSERT(replayed.kind == EXECUTABLE_KIND_PE_IMAGE && replayed.identity.fileSize == fs.files[target].size(),
+                "Replay should reproduce the validated image identity");
+    TEST_ASSERT(LaunchValidatedExecutable(replayed, session.priority), "Replay launch should succeed");
+    replayed.file.Reset();
+    double elapsedMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    BackendReplayStats stats = replay.GetStats();
+    TEST_ASSERT(stats.matched == recorded && stats.unmatched == 0 && stats.unconsumed == 0,
+                "Replay should consume every record exactly");
+    TEST_ASSERT(elapsedMs >= 3.0, "Replay should reproduce the recorded latency");
+
+    // TEST 4: Panggilan yang tidak ada di trace gagal dengan NOT_SUPPORTED
+    replay.Rewind();
+    uint32_t processId = 0;
+    TEST_ASSERT(!replay.FindProcessByName(L"lsass.exe", processId), "Call missing from the trace should fail");
+    TEST_ASSERT(replay.GetLastErrorCode() == OS_ERROR_NOT_SUPPORTED && replay.GetStats().unmatched == 1,
+                "Missing call should report NOT_SUPPORTED and count as unmatched");
+
+    // TEST 5: Kegagalan tercatat direproduksi dengan kode error yang sama
+    SetFileSystemBackend(&fs);
+    SetProcessBackend(&ps);
+    ps.logonLatency = std::chrono::microseconds(0);
+    ps.createProcessError = 5; // ERROR_ACCESS_DENIED
+    data.clear();
+    {
+        ScopedBackendTrace recorder(session, [&data](const uint8_t* bytes, size_t size) {
+            data.append(reinterpret_cast<const char*>(bytes), size);
+        });
+        ValidatedExecutable validated;
+        TEST_ASSERT(ValidateExecutable(target, validated) == VALIDATION_OK,
+                    "Executable should validate while recording a failure");
+        TEST_ASSERT(!LaunchValidatedExecutable(validated, session.priority),
+                    "Launch should fail with the recorded error");
+    }
+    TEST_ASSERT(trace.Load(data), "Failing trace should load");
+
+    TraceReplayBackend failing(trace, 0.0);
+    SetFileSystemBackend(&failing);
+    SetProcessBackend(&failing);
+    ValidatedExecutable again;
+    TEST_ASSERT(ValidateExecutable(target, again) == VALIDATION_OK,
+                "Replay validation of the failing trace should succeed");
+    TEST_ASSERT(!LaunchValidatedExecutable(again, session.priority), "Replayed launch should fail");
+    TEST_ASSERT(failing.GetLastErrorCode() == 5, "Replayed failure should keep its error code");
+    again.file.Reset();
+    TEST_ASSERT(failing.GetStats().unmatched == 0 && failing.GetStats().unconsumed == 0,
+                "Failing replay should consume every record exactly");
+
+    SetProcessBackend(NULL);
+    SetFileSystemBackend(NULL);
+
+    // TEST 6: Trace terpotong atau magic salah ditolak
+    size_t errorOffset = 0;
+    TEST_ASSERT(!trace.Load(data.substr(0, data.size() - 1), &errorOffset), "Truncated trace should be rejected");
+    TEST_ASSERT(errorOffset > 5 && errorOffset < data.size() && trace.records.empty(),
+                "Truncated trace should report the error offset and clear the records");
+    TEST_ASSERT(!trace.Load("RTRX" + data.substr(4)), "Trace with a wrong magic should be rejected");
+
+    TEST_PASS("Backend trace record/replay reproduces the recorded sequence");
+}
+
+/**
+ * @brief Test launch pipeline (CREATE_SUSPENDED + tahap + resume)
+ *
+ * Memverifikasi bahwa semua tahap diterapkan saat proses masih suspended,
+ * urutan dan timing per tahap tercatat, tahap yang gagal me-rollback launch
+ * (terminate, object ditutup, error dipertahankan), dan pipeline kosong
+ * tetap memakai launch langsung.
+ */
+bool TestLaunchPipeline() {
+    std::cout << "Testing suspended launch pipeline..." << std::endl;
+
+    const std::wstring commandLine = L"\"C:\\Tools\\app.exe\"";
+
+    FakeProcessBackend ps;
+    FakeProcessBackend::ConfigureDirectTcbHost(ps);
+    SetProcessBackend(&ps);
+    OsHandle token = AcquireTrustedInstallerToken();
+
+    // TEST 1: Parse prioritas I/O dan susunan pipeline dari pengaturan (job pertama)
+    uint32_t ioPriority = LAUNCH_SETTING_UNSET;
+    TEST_ASSERT(ParseIoPriority("VeryLow", ioPriority) && ioPriority == 0,
+                "I/O priority names should parse case-insensitively");
+    TEST_ASSERT(!ParseIoPriority("high", ioPriority) && ioPriority == 0,
+                "Unknown I/O priorities should be rejected and leave the value unchanged");
+
+    LaunchStageSettings settings;
+    LaunchPipeline empty;
+    ConfigureLaunchPipeline(settings, empty);
+    TEST_ASSERT(settings.IsEmpty() && empty.IsEmpty(), "Empty settings should build an empty pipeline");
+
+    settings.affinityMask = 0x3;
+    settings.ioPriority = 1;
+    settings.memoryPriority = 2;
+    settings.jobMemoryLimit = 64 * 1024 * 1024;
+    LaunchPipeline pipeline;
+    ConfigureLaunchPipeline(settings, pipeline);
+    TEST_ASSERT(pipeline.GetStageCount() == 4, "Settings should build job, affinity, I/O, and memory priority stages");
+
+    // TEST 2: Semua tahap diterapkan sebelum resume, timing per tahap tercatat
+    ps.ResetCalls();
+    {
+        LaunchPipelineResult result;
+        OsHandle process = OS_INVALID_HANDLE;
+        uint32_t processId = 0;
+        TEST_ASSERT(LaunchWithToken(token, L"", commandLine, 0x20, &processId, &process, CONSOLE_MODE_NEW,
+                                    NULL, NULL, &pipeline, &result), "Pipelined launch should succeed");
+        std::vector<std::string> expected = {"AdjustPrivilege(3,process)", "AdjustPrivilege(5,process)",
+                                             "AdjustPrivilege(7,process)", "CreateProcessAsUser", "CreateJob",
+                                             "AssignProcessToJob", "SetProcessSetting(1)", "SetProcessSetting(2)",
+                                             "SetProcessSetting(3)", "ResumeProcess", "CloseObject"};
+        TEST_ASSERT(ps.calls == expected, "Stages should run between the suspended create and the resume");
+        TEST_ASSERT(ps.launches.size() == 1 && (ps.launches[0].creationFlags & PROCESS_CREATE_SUSPENDED),
+                    "Process should be created suspended");
+        TEST_ASSERT(processId != 0 && process != OS_INVALID_HANDLE && !ps.suspended.count(process),
+                    "Process should be resumed and returned to the caller");
+        TEST_ASSERT(ps.suspendedSettings[process].size() == 3 &&
+                    ps.suspendedSettings[process][PROCESS_SETTING_AFFINITY] == 0x3 &&
+                    ps.suspendedSettings[process][PROCESS_SETTING_IO_PRIORITY] == 1 &&
+                    ps.suspendedSettings[process][PROCESS_SETTING_MEMORY_PRIORITY] == 2,
+                    "Every process setting should be applied while suspended");
+        TEST_ASSERT(ps.jobOf.count(process) && ps.jobs[ps.jobOf[process]].processMemoryLimit == 64 * 1024 * 1024,
+                    "Process should be assigned to a job with the memory limit");
+
+        const char* stageNames[] = {"create", "job", "affinity", "io-priority", "memory-priority", "resume"};
+        TEST_ASSERT(result.stages.size() == 6 && result.failedStage.empty() && !result.rolledBack,
+                    "Result should record six successful stages");
+        for (size_t i = 0; i < result.stages.size(); i++) {
+            TEST_ASSERT(result.stages[i].name == stageNames[i] && result.stages[i].succeeded &&
+                        result.stages[i].microseconds >= 0.0, "Stages should run in order and record their timing");
+        }
+        std::cout << FormatLaunchPipelineResult(result);
+
+        // Job ditutup setelah resume; hanya token TI dan handle proses yang tersisa
+        TEST_ASSERT(ps.openObjects == 2, "Job should be closed after resume");
+        ps.CloseObject(process);
+    }
+
+    // TEST 3: Tahap gagal - rollback, terminate sebelum resume, error tahap dipertahankan
+    ps.settingErrors[PROCESS_SETTING_IO_PRIORITY] = OS_ERROR_PRIVILEGE_NOT_HELD;
+    ps.ResetCalls();
+    {
+        LaunchPipelineResult result;
+        OsHandle process = OS_INVALID_HANDLE;
+        TEST_ASSERT(!LaunchWithToken(token, L"", commandLine, 0x20, NULL, &process, CONSOLE_MODE_NEW,
+                                     NULL, NULL, &pipeline, &result), "Launch with a failing stage should fail");
+        TEST_ASSERT(ps.GetLastErrorCode() == OS_ERROR_PRIVILEGE_NOT_HELD, "Failing stage error should be kept");
+        TEST_ASSERT(result.failedStage == "io-priority" && result.errorCode == OS_ERROR_PRIVILEGE_NOT_HELD,
+                    "Result should name the failed stage");
+        TEST_ASSERT(result.rolledBack && result.stages.size() == 4 && !result.stages.back().succeeded,
+                    "Failed stage should roll back");
+        TEST_ASSERT(ps.CountCalls("ResumeProcess") == 0 && ps.CountCalls("TerminateProcess") == 1,
+                    "Failed stage should terminate instead of resuming");
+        TEST_ASSERT(ps.CountCalls("SetProcessSetting(3)") == 0 && process == OS_INVALID_HANDLE,
+                    "Later stages should be skipped and no process returned");
+        TEST_ASSERT(ps.terminated.size() == 1 && ps.suspendedSettings[*ps.terminated.begin()].size() == 1,
+                    "Terminated process should have only the stages before the failure");
+        // Job dan proses ditutup
+        TEST_ASSERT(ps.openObjects == 1, "Rollback should close the job and the process");
+
+        std::string text = FormatLaunchPipelineResult(result);
+        TEST_ASSERT(text.find("FAILED in io-priority stage") != std::string::npos,
+                    "Result text should name the failed stage");
+    }
+    ps.settingErrors.clear();
+
+    // TEST 4: Resume gagal dan job gagal juga di-rollback tanpa object bocor
+    ps.resumeError = OS_ERROR_INVALID_HANDLE;
+    {
+        LaunchPipelineResult result;
+        TEST_ASSERT(!LaunchWithToken(token, L"", commandLine, 0x20, NULL, NULL, CONSOLE_MODE_NEW,
+                                     NULL, NULL, &pipeline, &result), "Launch with a failing resume should fail");
+        TEST_ASSERT(result.failedStage == "resume" && ps.GetLastErrorCode() == OS_ERROR_INVALID_HANDLE,
+                    "Failed resume should be reported as the resume stage");
+    }
+    ps.resumeError = 0;
+    ps.jobError = 1455; // ERROR_COMMITMENT_LIMIT
+    {
+        LaunchPipelineResult result;
+        TEST_ASSERT(!LaunchWithToken(token, L"", commandLine, 0x20, NULL, NULL, CONSOLE_MODE_NEW,
+                                     NULL, NULL, &pipeline, &result), "Launch with a failing job should fail");
+        TEST_ASSERT(result.failedStage == "job" && ps.GetLastErrorCode() == 1455,
+                    "Failed job should be reported as the job stage");
+    }
+    ps.jobError = 0;
+    TEST_ASSERT(ps.openObjects == 1, "Failed stages should not leak objects");
+
+    // TEST 5: Pipeline kosong - launch langsung tanpa CREATE_SUSPENDED dan resume
+    ps.ResetCalls();
+    {
+        LaunchPipelineResult result;
+        TEST_ASSERT(LaunchWithToken(token, L"", commandLine, 0x20, NULL, NULL, CONSOLE_MODE_NEW,
+                                    NULL, NULL, &empty, &result), "Empty pipeline launch should succeed");
+        TEST_ASSERT(ps.launches.size() == 1 && !(ps.launches[0].creationFlags & PROCESS_CREATE_SUSPENDED),
+                    "Empty pipeline should not create the process suspended");
+        TEST_ASSERT(ps.CountCalls("ResumeProcess") == 0 && result.stages.empty(),
+                    "Empty pipeline should not resume or time stages");
+    }
+
+    // TEST 6: Pengaturan pipeline ikut tersimpan di session trace
+    BackendTraceSession session;
+    session.operation = L"launch";
+    session.affinityMask = settings.affinityMask;
+    session.ioPriority = settings.ioPriority;
+    session.jobMemoryLimit = settings.jobMemoryLimit;
+    std::string data;
+    {
+        ScopedBackendTrace trace(session, [&data](const uint8_t* bytes, size_t size) {
+            data.append(reinterpret_cast<const char*>(bytes), size);
+        });
+    }
+    BackendTrace trace;
+    TEST_ASSERT(trace.Load(data) && trace.session.affinityMask == 0x3 && trace.session.ioPriority == 1,
+                "Session trace should keep affinity and I/O priority");
+    TEST_ASSERT(trace.session.memoryPriority == LAUNCH_SETTING_UNSET &&
+                trace.session.jobMemoryLimit == 64 * 1024 * 1024,
+                "Session trace should keep unset memory priority and the job limit");
+
+    ps.CloseObject(token);
+    SetProcessBackend(NULL);
+    TEST_ASSERT(ps.openObjects == 0, "All pipeline handles should be closed");
+
+    TEST_PASS("Launch pipeline applies timed stages before resume and rolls back on failure");
+}
+
+bool TestLaunchGraph() {
+    std::cout << "Testing launch dependency graph scheduler..." << std::endl;
+
+    // TEST 1: Parse manifest - edge boleh merujuk node berikutnya, urutan topologis
+    const char* manifest =
+        "\xEF\xBB\xBF# servicing\n"
+        "after-exit start patch1 patch2\n"
+        "node stop C:\\Tools\\stop.exe /service wuauserv\n"
+        "node patch1 \"C:\\Tools\\patch1.exe\" /quiet\n"
+        "node patch2 C:\\Tools\\patch2.exe\n"
+        "node start C:\\Tools\\start.exe\n"
+        "after-success patch1 stop\n"
+        "after-success patch2 stop\n"
+        "timeout patch2 600\n";
+    LaunchGraph graph;
+    size_t errorLine = 99;
+    TEST_ASSERT(ParseLaunchGraph(manifest, graph, &errorLine) && errorLine == 0,
+                "Valid manifest should parse without an error line");
+    TEST_ASSERT(graph.nodes.size() == 4 && graph.nodes[0].name == "stop" && graph.nodes[0].line == 3,
+                "Manifest nodes should keep their names and line numbers");
+    TEST_ASSERT(graph.nodes[0].arguments.size() == 2 && graph.nodes[1].path == L"C:\\Tools\\patch1.exe",
+                "Quoted paths and arguments should be split");
+    TEST_ASSERT(graph.nodes[3].dependencies.size() == 2 &&
+                graph.nodes[3].dependencies[0].kind == LAUNCH_AFTER_EXIT &&
+                graph.nodes[3].dependencies[0].line == 2, "Dependencies should keep their kind and line");
+    TEST_ASSERT(graph.nodes[2].timeoutMs == 600000 && graph.nodes[1].timeoutMs == 0,
+                "Timeouts should be converted to milliseconds");
+    TEST_ASSERT(graph.order == std::vector<size_t>({0, 1, 2, 3}), "Nodes should be ordered topologically");
+
+    // TEST 2: Manifest rusak ditolak seluruhnya dengan nomor baris
+    struct InvalidManifest {
+        const char* text;
+        size_t line;
+    } invalid[] = {
+        {"node a C:\\a.exe\nnode a C:\\b.exe\n", 2},                              // Nama ganda
+        {"node a C:\\a.exe\nafter-success a b\n", 2},                             // Dependensi tidak ada
+        {"node a C:\\a.exe\nnode b C:\\b.exe\nafter-exit a b\nafter-success b a\n", 3}, // Siklus
+        {"node a C:\\a.exe\nafter-success a a\n", 2},                             // Bergantung pada diri sendiri
+        {"node a C:\\a.exe\ntimeout a 0\n", 2},
+        {"node a C:\\a.txt\n", 1},
+        {"node a/b C:\\a.exe\n", 1},
+        {"node a C:\\a.exe\nrestart a\n", 2},
+        {"# kosong\n", 2},
+    };
+    for (const InvalidManifest& entry : invalid) {
+        TEST_ASSERT(!ParseLaunchGraph(entry.text, graph, &errorLine) && errorLine == entry.line &&
+                    graph.nodes.empty(), "Invalid manifests should be rejected with the offending line");
+    }
+
+    FakeFileSystemBackend fs;
+    FakeProcessBackend ps;
+    FakeProcessBackend::ConfigureDirectTcbHost(ps);
+    for (const wchar_t* name : {L"stop", L"patch1", L"patch2", L"start", L"audit", L"report"}) {
+        fs.files[std::wstring(L"C:\\Tools\\") + name + L".exe"] = BuildTestPeImage(3);
+    }
+    SetFileSystemBackend(&fs);
+    SetProcessBackend(&ps);
+    OsHandle token = AcquireTrustedInstallerToken();
+
+    LaunchGraphOptions options;
+    options.token = token;
+    options.creationFlags = 0x20;
+
+    // TEST 3: Stop -> patch1 + patch2 paralel -> start; critical path lewat patch terlama
+    ps.runs[L"stop.exe"].runtime = std::chrono::milliseconds(20);
+    ps.runs[L"patch1.exe"].runtime = std::chrono::milliseconds(30);
+    ps.runs[L"patch2.exe"].runtime = std::chrono::milliseconds(80);
+    ps.runs[L"start.exe"].runtime = std::chrono::milliseconds(10);
+    TEST_ASSERT(ParseLaunchGraph(manifest, graph), "Servicing manifest should parse");
+    {
+        LaunchGraphReport report;
+        TEST_ASSERT(RunLaunchGraph(graph, options, report), "Servicing graph should run");
+        TEST_ASSERT(report.nodesSucceeded == 4 && report.nodesFailed == 0 && report.peakRunning == 2,
+                    "All four nodes should succeed with two running at once");
+        TEST_ASSERT(ps.launches.size() == 4 && ps.CountCalls("CreateProcessAsUser") == 4,
+                    "Every node should launch with CreateProcessAsUser");
+        const std::vector<LaunchNodeResult>& r = report.results;
+        TEST_ASSERT(r[1].startSeconds >= r[0].endSeconds && r[2].startSeconds >= r[0].endSeconds,
+                    "Patches should start after stop has exited");
+        TEST_ASSERT(r[3].startSeconds >= r[2].endSeconds && r[2].endSeconds > r[1].endSeconds,
+                    "Start should wait for the slower patch");
+        TEST_ASSERT(r[3].gatedBy == 2 && r[1].gatedBy == 0 && r[0].gatedBy == LAUNCH_GRAPH_NO_NODE,
+                    "Each node should record the dependency that gated it");
+        TEST_ASSERT(report.criticalPath == std::vector<size_t>({0, 2, 3}),
+                    "Critical path should run through the slowest patch");
+        TEST_ASSERT(r[3].endSeconds >= 0.1 && report.seconds >= r[3].endSeconds,
+                    "Graph duration should cover the critical path");
+
+        std::string text = FormatLaunchGraphReport(graph, report);
+        std::cout << text;
+        TEST_ASSERT(text.find("4/4 nodes succeeded") != std::string::npos, "Report should count succeeded nodes");
+        TEST_ASSERT(text.find("critical path") != std::string::npos, "Report should print the critical path");
+    }
+
+    // TEST 4: Patch gagal - turunan after-success di-skip berantai, after-exit tetap berjalan
+    ps.runs[L"patch1.exe"].exitCode = 1603;
+    const char* failing =
+        "node stop C:\\Tools\\stop.exe\n"
+        "node patch1 C:\\Tools\\patch1.exe\n"
+        "node audit C:\\Tools\\audit.exe\n"
+        "node report C:\\Tools\\report.exe\n"
+        "node start C:\\Tools\\start.exe\n"
+        "after-success patch1 stop\n"
+        "after-success audit patch1\n"
+        "after-success report audit\n"
+        "after-exit start report\n";
+    TEST_ASSERT(ParseLaunchGraph(failing, graph), "Failing manifest should parse");
+    ps.ResetCalls();
+    {
+        LaunchGraphReport report;
+        TEST_ASSERT(!RunLaunchGraph(graph, options, report), "Graph with a failing node should report failure");
+        TEST_ASSERT(report.nodesSucceeded == 2 && report.nodesFailed == 1 && report.nodesSkipped == 2,
+                    "Failed patch should skip its after-success chain");
+        TEST_ASSERT(report.results[1].status == LAUNCH_NODE_COMPLETED && report.results[1].exitCode == 1603,
+                    "Failed patch should record its exit code");
+        TEST_ASSERT(report.results[2].status == LAUNCH_NODE_SKIPPED &&
+                    report.results[3].status == LAUNCH_NODE_SKIPPED, "After-success dependents should be skipped");
+        TEST_ASSERT(report.results[4].Succeeded() && ps.launches.size() == 3, "After-exit node should still run");
+        TEST_ASSERT(report.criticalPath == std::vector<size_t>({0, 1, 2, 3, 4}),
+                    "Critical path should follow the skipped chain");
+    }
+    ps.runs[L"patch1.exe"].exitCode = 0;
+
+    // TEST 5: Timeout per node - proses di-terminate, cabang lain tidak tertahan
+    ps.runs[L"patch2.exe"].runtime = std::chrono::milliseconds(5000);
+    TEST_ASSERT(ParseLaunchGraph(manifest, graph), "Manifest should parse for the timeout run");
+    graph.nodes[2].timeoutMs = 40;
+    ps.ResetCalls();
+    {
+        LaunchGraphReport report;
+        TEST_ASSERT(!RunLaunchGraph(graph, options, report), "Graph with a timed-out node should report failure");
+        TEST_ASSERT(report.results[2].status == LAUNCH_NODE_TIMED_OUT && ps.CountCalls("TerminateProcess") == 1,
+                    "Timed-out node should be terminated once");
+        TEST_ASSERT(report.results[1].Succeeded() && report.results[3].Succeeded(),
+                    "Other branches should not wait for the timed-out node"); // after-exit
+        TEST_ASSERT(report.seconds < 2.0, "Timeout should not hold the graph for the full runtime");
+        TEST_ASSERT(FormatLaunchGraphReport(graph, report).find("[patch2] timed-out") != std::string::npos,
+                    "Report should mark the timed-out node");
+    }
+    ps.runs[L"patch2.exe"].runtime = std::chrono::milliseconds(30);
+
+    // TEST 6: Batas paralel - node siap menunggu slot, waktu antri terlihat di report
+    const char* wide =
+        "node stop C:\\Tools\\stop.exe\n"
+        "node patch1 C:\\Tools\\patch1.exe\n"
+        "node patch2 C:\\Tools\\patch2.exe\n"
+        "node audit C:\\Tools\\audit.exe\n";
+    ps.runs[L"audit.exe"].runtime = std::chrono::milliseconds(30);
+    TEST_ASSERT(ParseLaunchGraph(wide, graph), "Wide manifest should parse");
+    options.maxRunning = 2;
+    {
+        LaunchGraphReport report;
+        TEST_ASSERT(RunLaunchGraph(graph, options, report), "Wide graph should run");
+        TEST_ASSERT(report.peakRunning == 2 && report.nodesSucceeded == 4,
+                    "Concurrency cap should limit running nodes to two");
+        TEST_ASSERT(report.results[2].startSeconds >= report.results[0].endSeconds,
+                    "Third node should wait for a free slot");
+        TEST_ASSERT(report.results[2].startSeconds - report.results[2].readySeconds > 0.01,
+                    "Queue time should be visible in the report");
+    }
+    options.maxRunning = 0;
+
+    // TEST 7: Executable yang tidak lolos validasi ditolak; proses gagal dibuat tercatat
+    fs.files.erase(L"C:\\Tools\\patch1.exe");
+    TEST_ASSERT(ParseLaunchGraph(manifest, graph), "Manifest should parse for the rejection run");
+    {
+        LaunchGraphReport report;
+        TEST_ASSERT(!RunLaunchGraph(graph, options, report), "Graph with a rejected node should report failure");
+        TEST_ASSERT(report.results[1].status == LAUNCH_NODE_REJECTED &&
+                    report.results[1].validation != VALIDATION_OK, "Executable failing validation should be rejected");
+        TEST_ASSERT(report.results[3].Succeeded(), "Independent branch should still succeed");
+    }
+    ps.createProcessError = 1450; // ERROR_NO_SYSTEM_RESOURCES
+    {
+        LaunchGraphReport report;
+        TEST_ASSERT(!RunLaunchGraph(graph, options, report),
+                    "Graph with a failed process creation should report failure");
+        TEST_ASSERT(report.results[0].status == LAUNCH_NODE_FAILED && report.results[0].errorCode == 1450,
+                    "CreateProcess failure should be recorded with its error code");
+        TEST_ASSERT(report.nodesSkipped == 2 && report.results[3].status == LAUNCH_NODE_FAILED,
+                    "Failed node should skip after-success dependents");
+    }
+    ps.createProcessError = 0;
+
+    ps.CloseObject(token);
+    SetProcessBackend(NULL);
+    SetFileSystemBackend(NULL);
+    TEST_ASSERT(ps.openObjects == 0, "All graph handles should be closed");
+
+    TEST_PASS("Launch graph schedules dependencies with one token and reports the critical path");
+}
+
+//==============================================================================
+// SUPERVISOR TESTS
+//==============================================================================
+
+bool TestSupervisor() {
+    std::cout << "Testing supervisor restarts with backoff and crash-loop cap..." << std::endl;
+
+    bool passed = true;
+
+    // TEST 1: Backoff eksponensial dibatasi maxBackoffMs, tanpa overflow
+    SupervisorOptions options;
+    options.initialBackoffMs = 100;
+    options.maxBackoffMs = 1000;
+    passed = passed && (GetSupervisorBackoffMs(options, 0) == 0 && GetSupervisorBackoffMs(options, 1) == 100 &&
+                        GetSupervisorBackoffMs(options, 2) == 200 && GetSupervisorBackoffMs(options, 4) == 800 &&
+                        GetSupervisorBackoffMs(options, 5) == 1000 && GetSupervisorBackoffMs(options, 200) == 1000);
+
+    FakeFileSystemBackend fs;
+    FakeProcessBackend ps;
+    FakeProcessBackend::ConfigureDirectTcbHost(ps);
+    for (const wchar_t* name : {L"crash", L"watcher", L"stable"}) {
+        fs.files[std::wstring(L"C:\\Tools\\") + name + L".exe"] = BuildTestPeImage(3);
+    }
+    FakeOutputCaptureBackend capture;
+    SetFileSystemBackend(&fs);
+    SetProcessBackend(&ps);
+    SetOutputCaptureBackend(&capture);
+
+    // crash: langsung keluar; watcher: keluar sekali lalu hidup terus; stable: run panjang berulang
+    capture.programs[L"C:\\Tools\\crash.exe"].exitCode = 3;
+    capture.programs[L"C:\\Tools\\watcher.exe"].exitCode = 1;
+    capture.programs[L"C:\\Tools\\watcher.exe"].runtime = std::chrono::milliseconds(30);
+    capture.programs[L"C:\\Tools\\watcher.exe"].hangAfterStarts = 2;
+    capture.programs[L"C:\\Tools\\watcher.exe"].chunks = { { CAPTURE_STREAM_STDOUT, "watching\n" } };
+    capture.programs[L"C:\\Tools\\stable.exe"].runtime = std::chrono::milliseconds(40);
+    capture.programs[L"C:\\Tools\\stable.exe"].notifyExit = false;
+    std::vector<CaptureLaunch> programs;
+    passed = passed && ParseCaptureLaunchList("C:\\Tools\\crash.exe\nC:\\Tools\\watcher.exe --poll 5\n"
+                                              "C:\\Tools\\stable.exe\nC:\\Tools\\missing.exe\n", programs);
+
+    // TEST 2: Restart berulang dengan satu token; crash loop dan file hilang menyerah
+    TrustedInstallerTokenCache cache;
+    SupervisorMetrics metrics;
+    std::atomic<bool> cancel(false);
+    options.tokens = &cache;
+    options.initialBackoffMs = 10;
+    options.maxBackoffMs = 40;
+    options.stableRunMs = 25;
+    options.crashLoopLimit = 3;
+    options.cancel = &cancel;
+    options.metrics = &metrics;
+
+    std::vector<std::pair<size_t, SupervisedProgramMetrics>> transitions;
+    std::string watcherOutput;
+    SupervisorReport report;
+    bool result = true;
+    std::thread supervisor([&]() {
+        result = RunSupervisor(programs, options,
+            [&](size_t program, CaptureStream, std::string_view data) {
+                if (program == 1) watcherOutput.append(data);
+            },
+            [&](size_t program, const SupervisedProgramMetrics& state) {
+                transitions.emplace_back(program, state);
+            }, report);
+    });
+
+    std::vector<SupervisedProgramMetrics> snapshot;
+    bool settled = false;
+    for (int i = 0; i < 1000 && !settled; i++) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        snapshot = metrics.Snapshot();
+        settled = snapshot.size() == 4 && snapshot[0].state == SUPERVISED_GAVE_UP &&
+                  snapshot[1].state == SUPERVISED_RUNNING && snapshot[1].restarts == 1 &&
+                  snapshot[2].restarts >= 3 && snapshot[3].state == SUPERVISED_GAVE_UP;
+    }
+    passed = passed && settled;
+    passed = passed && (snapshot[1].uptimeSeconds > 0.0 && snapshot[1].lastRunSeconds >= 0.025 &&
+                        snapshot[1].totalUptimeSeconds >= snapshot[1].lastRunSeconds + snapshot[1].uptimeSeconds - 1e-9 &&
+                        snapshot[1].consecutiveFailures == 1 && snapshot[1].lastExitCode == 1);
+    cancel.store(true);
+    supervisor.join();
+
+    passed = passed && (!result && report.cancelled && report.gaveUp == 2 && report.errorCode == 0);
+    passed = passed && (report.programs[0].starts == 3 && report.programs[0].restarts == 2 &&
+                        report.programs[0].consecutiveFailures == 3 && report.programs[0].lastExitCode == 3 &&
+                        capture.startCounts[L"C:\\Tools\\crash.exe"] == 3);
+    passed = passed && (report.programs[1].state == SUPERVISED_STOPPED && report.programs[1].starts == 2 &&
+                        watcherOutput == "watching\nwatching\n");
+    // Run stabil (tanpa notifikasi job, exit dari pipe yang tertutup) tidak menumpuk kegagalan
+    passed = passed && (report.programs[2].consecutiveFailures == 1 && report.programs[2].starts >= 4);
+    passed = passed && (report.programs[3].starts == 0 && report.programs[3].restarts == 2 &&
+                        report.programs[3].validation == VALIDATION_NOT_FOUND);
+    passed = passed && (capture.RunningProcesses() == 0 && capture.openPorts == 0 && fs.openHandles == 0);
+
+    // Delay restart crash: 10 ms lalu 20 ms, kemudian menyerah tanpa delay
+    std::vector<double> crashBackoff;
+    for (const auto& transition : transitions) {
+        if (transition.first == 0 && transition.second.state != SUPERVISED_RUNNING) {
+            crashBackoff.push_back(transition.second.backoffSeconds);
+        }
+    }
+    passed = passed && (crashBackoff == std::vector<double>({0.010, 0.020, 0.0}));
+
+    // TEST 3: Report dan snapshot JSON
+    std::string text = FormatSupervisorReport(report);
+    passed = passed && (text.find("[1] gave-up, pid ") == 0 && text.find("[2] stopped, ") != std::string::npos &&
+                        text.find("rejected (") != std::string::npos &&
+                        text.find("4 programs, ") != std::string::npos &&
+                        text.find("2 gave up") != std::string::npos &&
+                        text.find("stopped by cancel") != std::string::npos);
+    std::string json = FormatSupervisorMetricsJson(report.programs);
+    passed = passed && (json.find("{\"programs\":[{\"path\":\"C:\\\\Tools\\\\crash.exe\",\"state\":\"gave-up\"") == 0 &&
+                        json.find("\"restarts\":2,\"consecutiveFailures\":3,\"lastExitCode\":3") != std::string::npos &&
+                        json.find("]}\n") == json.size() - 3);
+
+    // TEST 4: Launch gagal meng-invalidate token cache; crash loop tanpa cancel mengakhiri supervisor
+    passed = passed && cache.HasToken();
+    capture.startError = OS_ERROR_ACCESS_DENIED;
+    options.cancel = NULL;
+    options.metrics = NULL;
+    options.crashLoopLimit = 2;
+    programs.resize(1);
+    passed = passed && (!RunSupervisor(programs, options, CaptureOutputCallback(), SupervisorEventCallback(), report));
+    passed = passed && (!report.cancelled && report.gaveUp == 1 && report.programs[0].starts == 0 &&
+                        report.programs[0].lastErrorCode == OS_ERROR_ACCESS_DENIED && !cache.HasToken());
+    capture.startError = 0;
+
+    passed = passed && (ps.openObjects == 0);
+    SetOutputCaptureBackend(NULL);
+    SetProcessBackend(NULL);
+    SetFileSystemBackend(NULL);
+
+    TEST_ASSERT(passed, "Supervisor should restart with backoff, stop crash loops, and publish metrics");
+
+    TEST_PASS("Supervisor keeps programs alive with one token and exposes restart metrics");
+}
+
+//==============================================================================
+// PROCESS ADJUST TESTS
+//==============================================================================
+
+bool TestProcessAdjust() {
+    std::cout << "Testing bulk adjustment of running processes..." << std::endl;
+
+    // TEST 1: Parse selector - PID, nama image, atau path
+    ProcessSelector selector;
+    TEST_ASSERT(ParseProcessSelector(L"1234", selector) && selector.kind == PROCESS_SELECT_ID &&
+                selector.processId == 1234, "Numeric selector should select a process ID");
+    TEST_ASSERT(ParseProcessSelector(L"Scanner.EXE", selector) && selector.kind == PROCESS_SELECT_NAME,
+                "Image name selector should select by name");
+    TEST_ASSERT(ParseProcessSelector(L"C:/Tools/agent.exe", selector) && selector.kind == PROCESS_SELECT_PATH,
+                "Path selector should select by path");
+    TEST_ASSERT(!ParseProcessSelector(L"0", selector) && !ParseProcessSelector(L"4294967296", selector) &&
+                !ParseProcessSelector(L"C:\\Tools\\", selector) && !ParseProcessSelector(L"", selector),
+                "Zero, overflowing, directory, and empty selectors should be rejected");
+
+    // Tabel besar: 400 scanner, 2 agent dengan path berbeda, proses terproteksi
+    FakeProcessBackend ps;
+    for (uint32_t i = 0; i < 400; i++) {
+        ProcessEntry entry;
+        entry.processId = 1000 + i * 4;
+        entry.parentProcessId = 4;
+        entry.imageName = (i % 2) ? L"scanner.exe" : L"other.exe";
+        ps.processTable.push_back(entry);
+    }
+    ProcessEntry agent;
+    agent.processId = 9000;
+    agent.imageName = L"agent.exe";
+    ps.processTable.push_back(agent);
+    ps.imagePaths[9000] = L"C:\\Tools\\agent.exe";
+    agent.processId = 9004;
+    agent.imageName = L"Agent.exe";
+    ps.processTable.push_back(agent);
+    ps.imagePaths[9004] = L"D:\\Old\\Agent.exe";
+    agent.processId = 9008;
+    agent.imageName = L"protected.exe";
+    ps.processTable.push_back(agent);
+    ps.openErrors[9008] = OS_ERROR_ACCESS_DENIED;
+    SetProcessBackend(&ps);
+
+    // TEST 2: Indeks tabel - PID dan nama case-insensitive
+    ProcessTable table;
+    TEST_ASSERT(table.Load(&ps), "Process table should load");
+    TEST_ASSERT(table.GetEntries().size() == 403 && table.FindByName(L"SCANNER.exe").size() == 200 &&
+                table.FindByName(L"agent.exe").size() == 2 && table.FindByName(L"none.exe").empty() &&
+                table.FindById(9004) == 401 && table.FindById(7) == SIZE_MAX,
+                "Table should index PIDs and names case-insensitively");
+
+    // TEST 3: Ratusan proses dari satu snapshot; duplikat dan kandidat path yang tidak cocok
+    std::vector<ProcessSelector> selectors(5);
+    TEST_ASSERT(ParseProcessSelector(L"scanner.exe", selectors[0]) &&
+                ParseProcessSelector(L"1000", selectors[1]) &&
+                ParseProcessSelector(L"1004", selectors[2]) &&
+                ParseProcessSelector(L"c:\\tools\\AGENT.exe", selectors[3]) &&
+                ParseProcessSelector(L"missing.exe", selectors[4]), "Selectors should parse");
+    ProcessAdjustment adjustment;
+    adjustment.priorityClass = 0x4000; // BELOW_NORMAL_PRIORITY_CLASS
+    adjustment.ioPriority = 0;
+    ps.ResetCalls();
+    ProcessAdjustReport report;
+    TEST_ASSERT(!AdjustProcesses(selectors, adjustment, report),
+                "Adjust with an unmatched selector should report failure");
+    TEST_ASSERT(report.processesScanned == 403 && report.matched == 202 && report.adjusted == 202 &&
+                report.failed == 0 && report.unmatchedSelectors == std::vector<size_t>{4},
+                "Hundreds of processes should be adjusted and the unmatched selector reported");
+    TEST_ASSERT(ps.CountCalls("EnumerateProcesses") == 1 && ps.CountCalls("OpenProcessHandle") == 203 &&
+                ps.CountCalls("QueryProcessImagePath") == 2 && ps.CountCalls("SetProcessSetting") == 404,
+                "One snapshot should serve every selector and duplicates should be opened once");
+    TEST_ASSERT(report.results[0].processId == 1000 && report.results[1].processId == 1004 &&
+                report.results.back().processId == 9000 &&
+                report.results.back().path == L"C:\\Tools\\agent.exe",
+                "Results should follow the snapshot order with the resolved path");
+    size_t configured = 0;
+    for (const auto& entry : ps.settings) {
+        if (entry.second.size() == 2 && entry.second.at(PROCESS_SETTING_PRIORITY_CLASS) == 0x4000 &&
+            entry.second.at(PROCESS_SETTING_IO_PRIORITY) == 0) {
+            configured++;
+        }
+    }
+    TEST_ASSERT(configured == 202 && ps.openObjects == 0,
+                "Every matched process should get both settings and every handle should be closed");
+
+    // TEST 4: Proses yang tidak dapat dibuka dan setting yang gagal dilaporkan per proses
+    selectors.resize(2);
+    TEST_ASSERT(ParseProcessSelector(L"9008", selectors[0]) && ParseProcessSelector(L"9000", selectors[1]),
+                "Failure selectors should parse");
+    adjustment.memoryPriority = 2;
+    ps.settingErrors[PROCESS_SETTING_IO_PRIORITY] = OS_ERROR_PRIVILEGE_NOT_HELD;
+    TEST_ASSERT(!AdjustProcesses(selectors, adjustment, report), "Adjust with failing processes should report failure");
+    TEST_ASSERT(report.matched == 2 && report.adjusted == 0 && report.failed == 2 &&
+                report.unmatchedSelectors.empty(), "Both failing processes should be counted");
+    TEST_ASSERT(report.results[0].processId == 9000 && report.results[0].settings.size() == 3 &&
+                report.results[0].settings[0].errorCode == 0 &&
+                report.results[0].settings[1].setting == PROCESS_SETTING_IO_PRIORITY &&
+                report.results[0].settings[1].errorCode == OS_ERROR_PRIVILEGE_NOT_HELD &&
+                report.results[0].settings[2].errorCode == 0,
+                "Failed setting should be reported without stopping the others");
+    TEST_ASSERT(report.results[1].openError == OS_ERROR_ACCESS_DENIED && report.results[1].settings.empty(),
+                "Protected process should report its open error");
+    std::string text = FormatProcessAdjustReport(selectors, report);
+    std::cout << text;
+    TEST_ASSERT(text.find("agent.exe  priority ok  io-priority FAILED (error 1314)") != std::string::npos &&
+                text.find("protected.exe  FAILED (open error 5)") != std::string::npos &&
+                text.find("403 processes scanned") != std::string::npos &&
+                text.find("2 matched, 0 adjusted, 2 failed") != std::string::npos,
+                "Report should describe each failure");
+    ps.settingErrors.clear();
+
+    // TEST 5: Tanpa pengaturan hanya daftar; record/replay tabel proses identik
+    BackendTraceSession session;
+    session.operation = L"adjust";
+    std::string data;
+    {
+        ScopedBackendTrace trace(session, [&data](const uint8_t* bytes, size_t size) {
+            data.append(reinterpret_cast<const char*>(bytes), size);
+        });
+        selectors.resize(1);
+        TEST_ASSERT(ParseProcessSelector(L"D:\\Old\\agent.exe", selectors[0]),
+                    "Path selector should parse under tracing");
+        TEST_ASSERT(AdjustProcesses(selectors, ProcessAdjustment(), report), "Listing without settings should succeed");
+    }
+    TEST_ASSERT(report.matched == 1 && report.results[0].processId == 9004 && report.results[0].settings.empty(),
+                "Listing should match the path without changing settings");
+    BackendTrace trace;
+    TEST_ASSERT(trace.Load(data), "Adjust trace should load");
+    TraceReplayBackend replay(trace, 0.0);
+    SetProcessBackend(&replay);
+    ProcessAdjustReport replayed;
+    TEST_ASSERT(AdjustProcesses(selectors, ProcessAdjustment(), replayed), "Replayed adjust should succeed");
+    TEST_ASSERT(replayed.processesScanned == 403 && replayed.matched == 1 &&
+                replayed.results[0].path == L"D:\\Old\\Agent.exe" &&
+                replay.GetStats().unmatched == 0 && replay.GetStats().unconsumed == 0,
+                "Replay should reproduce the process table");
+
+    // TEST 6: Snapshot gagal
+    SetProcessBackend(&ps);
+    ps.enumerateError = OS_ERROR_NOT_ENOUGH_MEMORY;
+    TEST_ASSERT(!AdjustProcesses(selectors, adjustment, report) &&
+                report.errorCode == OS_ERROR_NOT_ENOUGH_MEMORY && report.results.empty(),
+                "Failed snapshot should fail without results");
+
+    SetProcessBackend(NULL);
+    TEST_ASSERT(ps.openObjects == 0, "All adjust handles should be closed");
+
+    TEST_PASS("Adjust applies settings per process and reports each failure");
+}
+
+//==============================================================================
+// SESSION LAUNCH TESTS
+//==============================================================================
+
+/**
+ * @brief Test launch ke banyak session dengan satu token TI
+ *
+ * Memverifikasi parse /sessions, pemilihan session aktif, satu enumerasi dan
+ * satu token untuk semua session, launch paralel, hasil per session, dan
+ * record/replay request yang membawa sessionId.
+ */
+bool TestSessionLaunch() {
+    std::cout << "Testing launch into multiple user sessions..." << std::endl;
+
+    // TEST 1: Parse "all" atau daftar ID
+    SessionSelection selection;
+    TEST_ASSERT(ParseSessionSelection(L"ALL", selection) && selection.all, "all should parse case-insensitively");
+    TEST_ASSERT(ParseSessionSelection(L"3,1,12", selection) && !selection.all &&
+             selection.sessionIds == std::vector<uint32_t>({3, 1, 12}), "Session ID lists should parse in order");
+    for (const wchar_t* text : {L"", L"1,", L",1", L"1,,2", L"1,1", L"x", L"-1", L"4294967295", L"99999999999"}) {
+        TEST_ASSERT(!ParseSessionSelection(text, selection),
+                    "Malformed, duplicate, and out-of-range session lists should be rejected");
+    }
+
+    FakeFileSystemBackend fs;
+    FakeProcessBackend ps;
+    FakeProcessBackend::ConfigureDirectTcbHost(ps);
+    fs.files[L"C:\\Tools\\agent.exe"] = BuildTestPeImage(2);
+    SetFileSystemBackend(&fs);
+    SetProcessBackend(&ps);
+
+    // Session 0 (services), 32 session RDP aktif, satu disconnected, satu listener
+    SessionEntry entry;
+    entry.stationName = L"Services";
+    ps.sessions.push_back(entry);
+    for (uint32_t id = 1; id <= 32; id++) {
+        entry.sessionId = id;
+        entry.active = true;
+        entry.stationName = L"RDP-Tcp#" + std::to_wstring(id);
+        entry.userName = L"user" + std::to_wstring(id);
+        ps.sessions.push_back(entry);
+    }
+    entry.sessionId = 40;
+    entry.active = false;
+    entry.stationName = L"";
+    entry.userName = L"carol";
+    ps.sessions.push_back(entry);
+    entry.sessionId = 65536;
+    entry.stationName = L"RDP-Tcp";
+    entry.userName = L"";
+    ps.sessions.push_back(entry);
+
+    ValidatedExecutable validated;
+    TEST_ASSERT(ValidateExecutable(L"C:\\Tools\\agent.exe", validated) == VALIDATION_OK,
+                "Agent executable should validate");
+    OsHandle token = AcquireTrustedInstallerToken();
+    SessionLaunchOptions options;
+    options.token = token;
+    options.creationFlags = 0x20;
+
+    // TEST 2: "all" - hanya session aktif, paralel, satu enumerasi dan satu token
+    ps.createLatency = std::chrono::milliseconds(40);
+    ps.ResetCalls();
+    TEST_ASSERT(ParseSessionSelection(L"all", selection), "all should parse");
+    {
+        SessionLaunchReport report;
+        TEST_ASSERT(LaunchInSessions(validated, {L"/watch"}, selection, options, report),
+                    "Launch into all sessions should succeed");
+        TEST_ASSERT(report.sessionsFound == 35 && report.launched == 32 && report.failed == 0 &&
+                    report.threadCount == SESSION_LAUNCH_MAX_THREADS && report.results.size() == 32,
+                    "all should launch into the 32 active sessions only");
+        TEST_ASSERT(ps.CountCalls("EnumerateSessions") == 1 && ps.CountCalls("CreateProcessAsUser") == 32 &&
+                    ps.CountCalls("CreateProcessWithToken") == 0 && ps.CountCalls("LogonTrustedInstaller(process)") == 0,
+                    "Sessions should share one enumeration and one token through CreateProcessAsUserW");
+        // Berurutan = 32 x 40 ms; paralel 16 worker = 2 gelombang
+        TEST_ASSERT(report.seconds < 0.8, "Session launches should run in parallel");
+        std::set<uint32_t> launchedSessions;
+        for (const ProcessLaunchRequest& request : ps.launches) {
+            launchedSessions.insert(request.sessionId);
+            TEST_ASSERT(request.commandLine == ps.launches[0].commandLine &&
+                        request.creationFlags == ps.launches[0].creationFlags,
+                        "Every session should get the same command line and flags");
+        }
+        TEST_ASSERT(launchedSessions.size() == 32 && *launchedSessions.begin() == 1 &&
+                    *launchedSessions.rbegin() == 32, "Every active session should get one launch");
+        TEST_ASSERT(ps.launches[0].commandLine.find(L"/watch") != std::wstring::npos,
+                    "Arguments should reach the command line");
+        TEST_ASSERT(report.results[0].sessionId == 1 && report.results[0].userName == L"user1" &&
+                    report.results[0].status == SESSION_LAUNCH_STARTED && report.results[0].processId != 0,
+                    "Results should be ordered by session with the user name");
+    }
+    ps.createLatency = std::chrono::microseconds(0);
+
+    // TEST 3: Daftar eksplisit - disconnected tetap dijalankan, ID tidak ada dan launch gagal per session
+    ps.sessionErrors[2] = OS_ERROR_ACCESS_DENIED;
+    ps.ResetCalls();
+    options.maxParallel = 1; // Kode error fake backend bersifat global
+    TEST_ASSERT(ParseSessionSelection(L"40,2,7,99", selection), "Explicit session list should parse");
+    {
+        SessionLaunchReport report;
+        TEST_ASSERT(!LaunchInSessions(validated, {}, selection, options, report),
+                    "Explicit list with a failing session should report failure");
+        TEST_ASSERT(report.launched == 2 && report.failed == 1 && report.notFound == 1,
+                    "Explicit list should count launched, failed, and missing sessions");
+        TEST_ASSERT(report.results.size() == 4 && report.results[0].sessionId == 40 &&
+                    report.results[0].status == SESSION_LAUNCH_STARTED &&
+                    report.results[1].status == SESSION_LAUNCH_FAILED &&
+                    report.results[1].errorCode == OS_ERROR_ACCESS_DENIED &&
+                    report.results[3].sessionId == 99 && report.results[3].status == SESSION_LAUNCH_NOT_FOUND,
+                    "Per-session results should keep their order, status, and error");
+        TEST_ASSERT(ps.CountCalls("CreateProcessAsUser") == 3, "Missing sessions should not be launched");
+
+        std::string text = FormatSessionLaunchReport(report);
+        std::cout << text;
+        TEST_ASSERT(text.find("session 40 - carol: started") != std::string::npos &&
+                    text.find("session 2 RDP-Tcp#2 user2: FAILED (error 5)") != std::string::npos &&
+                    text.find("session 99 - -: not-found") != std::string::npos &&
+                    text.find("2 launched, 1 failed, 1 not found") != std::string::npos,
+                    "Report should describe every session");
+    }
+    ps.sessionErrors.clear();
+
+    // TEST 4: Seclogon tidak dapat menargetkan session lain
+    {
+        ProcessLaunchRequest request = BuildValidatedLaunchRequest(validated, {}, 0x20);
+        request.sessionId = 3;
+        uint32_t processId = 0;
+        TEST_ASSERT(!ps.CreateProcessWithToken(token, request, processId, NULL) &&
+                    ps.GetLastErrorCode() == OS_ERROR_NOT_SUPPORTED,
+                    "seclogon should refuse to target another session");
+    }
+
+    // TEST 5: Record/replay - key launch membawa sessionId
+    BackendTraceSession session;
+    session.operation = L"sessions";
+    std::string data;
+    TEST_ASSERT(ParseSessionSelection(L"5,6", selection), "Trace session list should parse");
+    {
+        ScopedBackendTrace trace(session, [&data](const uint8_t* bytes, size_t size) {
+            data.append(reinterpret_cast<const char*>(bytes), size);
+        });
+        SessionLaunchReport report;
+        TEST_ASSERT(LaunchInSessions(validated, {}, selection, options, report),
+                    "Recorded session launch should succeed");
+    }
+    BackendTrace trace;
+    TEST_ASSERT(trace.Load(data), "Session trace should load");
+    {
+        TraceReplayBackend replay(trace, 0.0);
+        SetProcessBackend(&replay);
+        SessionLaunchReport report;
+        TEST_ASSERT(LaunchInSessions(validated, {}, selection, options, report),
+                    "Replayed session launch should succeed");
+        TEST_ASSERT(report.launched == 2 && report.results[1].userName == L"user6" &&
+                    replay.GetStats().unmatched == 0 && replay.GetStats().unconsumed == 0,
+                    "Replay should match every session launch key");
+        SetProcessBackend(&ps);
+    }
+
+    // TEST 6: Enumerasi gagal - tidak ada launch
+    ps.sessionsError = OS_ERROR_ACCESS_DENIED;
+    ps.ResetCalls();
+    TEST_ASSERT(ParseSessionSelection(L"all", selection), "all should parse for the enumeration failure");
+    {
+        SessionLaunchReport report;
+        TEST_ASSERT(!LaunchInSessions(validated, {}, selection, options, report) &&
+                    report.errorCode == OS_ERROR_ACCESS_DENIED && report.results.empty() &&
+                    ps.CountCalls("CreateProcessAsUser") == 0, "Failed enumeration should fail without launching");
+    }
+
+    ps.CloseObject(token);
+    validated.file.Reset();
+    SetProcessBackend(NULL);
+    SetFileSystemBackend(NULL);
+    TEST_ASSERT(ps.openObjects == 0 && fs.openHandles == 0, "All session handles should be closed");
+
+    TEST_PASS("Sessions launch in parallel and report each session");
+}
+
+//==============================================================================
+// SINGLE INSTANCE TESTS
+//==============================================================================
+
+/**
+ * @brief Test launch single-instance di atas indeks path image
+ *
+ * Memverifikasi parse /single, satu snapshot per batch, kandidat yang dibuka
+ * paling banyak sekali, pencocokan identitas file (nama 8.3, drive subst,
+ * case non-ASCII), dedup launch di batch yang sama, skip, attach, dan
+ * snapshot yang gagal.
+ */
+bool TestSingleInstance() {
+    std::cout << "Testing single-instance launch with a running image index..." << std::endl;
+
+    // TEST 1: Parse mode
+    SingleInstanceMode mode = SINGLE_INSTANCE_OFF;
+    TEST_ASSERT(ParseSingleInstanceMode(L"", mode) && mode == SINGLE_INSTANCE_SKIP,
+                "Empty mode should default to skip");
+    TEST_ASSERT(ParseSingleInstanceMode(L"Attach", mode) && mode == SINGLE_INSTANCE_ATTACH,
+                "Mode names should parse case-insensitively");
+    TEST_ASSERT(!ParseSingleInstanceMode(L"kill", mode) &&
+                std::string(GetSingleInstanceModeName(SINGLE_INSTANCE_ATTACH)) == "attach",
+                "Unknown modes should be rejected and attach should format by name");
+
+    // Tabel besar: 2000 proses, 500 agent.exe dari direktori lain, satu terproteksi
+    FakeFileSystemBackend fs;
+    SetFileSystemBackend(&fs);
+    std::vector<uint8_t> image = BuildTestPeImage(3);
+    FakeProcessBackend ps;
+    for (uint32_t i = 0; i < 2000; i++) {
+        ProcessEntry entry;
+        entry.processId = 10000 + i * 4;
+        entry.imageName = (i % 4) ? L"svchost.exe" : L"agent.exe";
+        ps.processTable.push_back(entry);
+        ps.imagePaths[entry.processId] = (i % 4) ? L"C:\\Windows\\System32\\svchost.exe"
+                                                 : L"C:\\Old\\" + std::to_wstring(i) + L"\\agent.exe";
+        fs.files[ps.imagePaths[entry.processId]] = image;
+    }
+    ProcessEntry entry;
+    entry.processId = 9000;
+    entry.imageName = L"agent.exe";
+    ps.processTable.push_back(entry);
+    ps.imagePaths[9000] = L"C:\\Tools\\agent.exe";
+    entry.processId = 9004;
+    ps.processTable.push_back(entry);
+    ps.openErrors[9004] = OS_ERROR_ACCESS_DENIED;
+    SetProcessBackend(&ps);
+
+    fs.files[L"C:\\Tools\\agent.exe"] = image;
+    fs.files[L"C:\\Tools\\other\\agent.exe"] = image;
+    fs.files[L"C:\\Tools\\idle.exe"] = image;
+    fs.files[L"C:\\Tools\\new.exe"] = image;
+    fs.aliases[L"c:\\tools\\AGENT.EXE"] = L"C:\\Tools\\agent.exe";
+    ValidatedExecutable agent, agentCase, otherAgent, idle, created;
+    TEST_ASSERT(ValidateExecutable(L"C:\\Tools\\agent.exe", agent) == VALIDATION_OK &&
+                ValidateExecutable(L"c:\\tools\\AGENT.EXE", agentCase) == VALIDATION_OK &&
+                ValidateExecutable(L"C:\\Tools\\other\\agent.exe", otherAgent) == VALIDATION_OK &&
+                ValidateExecutable(L"C:\\Tools\\idle.exe", idle) == VALIDATION_OK &&
+                ValidateExecutable(L"C:\\Tools\\new.exe", created) == VALIDATION_OK,
+                "Test executables should validate");
+
+    // TEST 2: Kandidat bernama sama dibuka sekali (yang terproteksi saat lookup kedua); sisanya dari cache
+    RunningImageIndex images;
+    uint32_t processId = 0;
+    TEST_ASSERT(images.Load(&ps, &fs) && images.GetStats().processesIndexed == 2002,
+                "Snapshot should index every running process");
+    TEST_ASSERT(images.Find(agentCase, processId) && processId == 9000,
+                "Case-different path should match the running instance by identity");
+    int opened = ps.CountCalls("OpenProcessHandle");
+    for (int i = 0; i < 1000; i++) {
+        TEST_ASSERT(images.Find(agent, processId) && processId == 9000,
+                    "Cached lookups should keep finding the running instance");
+        TEST_ASSERT(!images.Find(otherAgent, processId), "Same name from another directory should not match");
+        TEST_ASSERT(!images.Find(idle, processId), "Executable that is not running should not match");
+    }
+    TEST_ASSERT(opened == 501 && ps.CountCalls("OpenProcessHandle") == 502 &&
+                ps.CountCalls("EnumerateProcesses") == 1 && ps.openObjects == 0,
+                "Candidates should be opened once and the snapshot taken once");
+    TEST_ASSERT(images.GetStats().candidatesOpened == 502 && images.GetStats().unverified == 1 &&
+                images.GetStats().lookups == 3001 && images.GetStats().hits == 1001,
+                "Index stats should count candidates, lookups, and hits");
+
+    // TEST 3: Proses yang di-launch selama batch terlihat sampai dihapus
+    images.Add(4242, created.identity);
+    TEST_ASSERT(images.Find(created, processId) && processId == 4242, "Added process should be found");
+    images.Remove(4242);
+    TEST_ASSERT(!images.Find(created, processId), "Removed process should no longer be found");
+
+    // TEST 4: Identitas file, bukan string path - nama 8.3, drive subst, dan case non-ASCII tetap cocok
+    ProcessEntry substituted;
+    substituted.processId = 9100;
+    substituted.imageName = L"\u00C4GENT.EXE";
+    ps.processTable.push_back(substituted);
+    ps.imagePaths[9100] = L"S:\\\u00C4GENT.EXE";
+    fs.aliases[L"S:\\\u00C4GENT.EXE"] = L"C:\\Tools\\\u00E4gent.exe";
+    fs.files[L"C:\\Tools\\\u00E4gent.exe"] = image;
+    ProcessEntry shortName;
+    shortName.processId = 9104;
+    shortName.imageName = L"LONGNA~1.EXE";
+    ps.processTable.push_back(shortName);
+    ps.imagePaths[9104] = L"C:\\TOOLS~1\\LONGNA~1.EXE";
+    fs.aliases[L"C:\\TOOLS~1\\LONGNA~1.EXE"] = L"C:\\Tools\\longname.exe";
+    fs.aliases[L"C:\\TOOLS~1\\AGENT~1.EXE"] = L"C:\\Tools\\agent.exe";
+    fs.files[L"C:\\Tools\\longname.exe"] = image;
+    ValidatedExecutable agentShort, umlaut, longName;
+    TEST_ASSERT(ValidateExecutable(L"C:\\TOOLS~1\\AGENT~1.EXE", agentShort) == VALIDATION_OK &&
+                ValidateExecutable(L"C:\\Tools\\\u00E4gent.exe", umlaut) == VALIDATION_OK &&
+                ValidateExecutable(L"C:\\Tools\\longname.exe", longName) == VALIDATION_OK,
+                "Short, umlaut, and long-name paths should validate");
+    TEST_ASSERT(images.Load(&ps, &fs), "Index should reload");
+    TEST_ASSERT(images.Find(agentShort, processId) && processId == 9000, "8.3 path should match the running instance");
+    TEST_ASSERT(images.Find(umlaut, processId) && processId == 9100, "Substituted drive path should match by identity");
+    TEST_ASSERT(images.Find(longName, processId) && processId == 9104,
+                "Short process image path should match the long executable path");
+    TEST_ASSERT(!images.Find(otherAgent, processId) && ps.openObjects == 0,
+                "Reload should not match other images and should close every handle");
+    ps.processTable.resize(2002);
+    for (ValidatedExecutable* executable : { &agent, &agentCase, &otherAgent, &idle, &created,
+                                             &agentShort, &umlaut, &longName }) {
+        executable->file.Reset();
+    }
+
+    // TEST 5: /batch skip - instance luar dan duplikat di batch yang sama tidak di-launch
+    fs.files[L"C:\\Tools\\a.exe"] = image;
+    fs.files[L"C:\\Tools\\b.exe"] = image;
+    FakeOutputCaptureBackend capture;
+    SetOutputCaptureBackend(&capture);
+    capture.programs[L"C:\\Tools\\a.exe"].runtime = std::chrono::milliseconds(30);
+    std::vector<CaptureLaunch> launches;
+    TEST_ASSERT(ParseCaptureLaunchList("C:\\Tools\\agent.exe\nC:\\Tools\\a.exe\nC:\\Tools\\a.exe /again\n"
+                                       "C:\\Tools\\b.exe\n", launches), "Launch list should parse");
+    CaptureOptions options;
+    options.single = SINGLE_INSTANCE_SKIP;
+    CaptureReport report;
+    ps.ResetCalls();
+    TEST_ASSERT(RunCapturedLaunches(launches, options, CaptureOutputCallback(), report), "Skip batch should succeed");
+    TEST_ASSERT(capture.starts.size() == 2 && report.launchesSucceeded == 4 && report.launchesSkipped == 2 &&
+                report.results[0].status == CAPTURE_LAUNCH_SKIPPED && report.results[0].processId == 9000 &&
+                report.results[1].status == CAPTURE_LAUNCH_COMPLETED &&
+                report.results[2].status == CAPTURE_LAUNCH_SKIPPED &&
+                report.results[2].processId == report.results[1].processId &&
+                report.results[3].status == CAPTURE_LAUNCH_COMPLETED &&
+                ps.CountCalls("EnumerateProcesses") == 1 && report.singleInstance.lookups == 4,
+                "Running and duplicate launches should be skipped");
+    std::string text = FormatCaptureReport(report);
+    TEST_ASSERT(text.find("[1] skipped, already running as pid 9000") == 0 &&
+                text.find("2 already running; 2002 processes indexed") != std::string::npos,
+                "Report should name the running instance");
+
+    // Berurutan: launch pertama sudah selesai sehingga duplikat di-launch lagi
+    options.maxRunning = 1;
+    capture.starts.clear();
+    TEST_ASSERT(RunCapturedLaunches(launches, options, CaptureOutputCallback(), report),
+                "Sequential batch should succeed");
+    TEST_ASSERT(capture.starts.size() == 3 && report.launchesSkipped == 1 &&
+                report.results[2].status == CAPTURE_LAUNCH_COMPLETED,
+                "Sequential batch should relaunch a duplicate that already exited");
+    options.maxRunning = 0;
+
+    // TEST 6: /single:attach - exit code instance luar atau launch sebelumnya, timeout tanpa terminate
+    options.single = SINGLE_INSTANCE_ATTACH;
+    ps.processExitCode = 3;
+    capture.starts.clear();
+    TEST_ASSERT(!RunCapturedLaunches(launches, options, CaptureOutputCallback(), report),
+                "Attach batch should report the failing exit code");
+    TEST_ASSERT(capture.starts.size() == 2 && report.results[0].status == CAPTURE_LAUNCH_ATTACHED &&
+                report.results[0].exitCode == 3 && report.results[0].processId == 9000 &&
+                !report.results[0].Succeeded() && report.results[2].status == CAPTURE_LAUNCH_ATTACHED &&
+                report.results[2].processId == report.results[1].processId &&
+                report.results[2].Succeeded() && report.launchesFailed == 1 && ps.openObjects == 0,
+                "Attach should wait on running instances and earlier launches");
+    TEST_ASSERT(FormatCaptureReport(report).find("[1] attached to pid 9000, exit 3") == 0,
+                "Report should show the attached instance");
+    ps.waitError = OS_ERROR_WAIT_TIMEOUT;
+    options.timeoutMs = 20;
+    ps.ResetCalls();
+    TEST_ASSERT(!RunCapturedLaunches(launches, options, CaptureOutputCallback(), report),
+                "Attach timeout should fail the batch");
+    TEST_ASSERT(report.results[0].status == CAPTURE_LAUNCH_TIMED_OUT &&
+                ps.CountCalls("TerminateProcess") == 0 && ps.openObjects == 0,
+                "Attach timeout should not terminate the instance");
+    ps.waitError = 0;
+    options.timeoutMs = 0;
+
+    // TEST 7: Snapshot gagal - tidak ada launch; OFF tidak mengambil snapshot
+    ps.enumerateError = OS_ERROR_ACCESS_DENIED;
+    capture.starts.clear();
+    TEST_ASSERT(!RunCapturedLaunches(launches, options, CaptureOutputCallback(), report),
+                "Failed snapshot should fail the batch");
+    TEST_ASSERT(capture.starts.empty() && report.launchesFailed == 4 &&
+                report.results[1].status == CAPTURE_LAUNCH_FAILED &&
+                report.results[1].errorCode == OS_ERROR_ACCESS_DENIED, "Failed snapshot should block every launch");
+    options.single = SINGLE_INSTANCE_OFF;
+    ps.ResetCalls();
+    TEST_ASSERT(RunCapturedLaunches(launches, options, CaptureOutputCallback(), report),
+                "Batch without single-instance should succeed");
+
+    SetOutputCaptureBackend(NULL);
+    SetProcessBackend(NULL);
+    SetFileSystemBackend(NULL);
+    TEST_ASSERT(capture.starts.size() == 4 && ps.calls.empty() &&
+                report.singleInstance.lookups == 0 && fs.openHandles == 0,
+                "Single-instance off should not take a snapshot");
+
+    TEST_PASS("Single-instance checks reuse one snapshot and cached image identities");
+}
+
+//==============================================================================
+// CAPTURE ACCOUNTING TESTS
+//==============================================================================
+
+/**
+ * @brief Test accounting job per launch (/accounting)
+ *
+ * Memverifikasi satu query per launch sebelum handle ditutup (termasuk launch
+ * yang timeout), total batch, report teks dan JSON, serta query yang gagal
+ * atau dimatikan.
+ */
+bool TestCaptureAccounting() {
+    std::cout << "Testing job accounting for captured launches..." << std::endl;
+
+    bool passed = true;
+
+    FakeFileSystemBackend fs;
+    SetFileSystemBackend(&fs);
+    fs.files[L"C:\\Tools\\a.exe"] = BuildTestPeImage(3);
+    fs.files[L"C:\\Tools\\b.exe"] = BuildTestPeImage(3);
+    fs.files[L"C:\\Tools\\hang.exe"] = BuildTestPeImage(3);
+    FakeOutputCaptureBackend capture;
+    SetOutputCaptureBackend(&capture);
+    ProcessAccounting& a = capture.programs[L"C:\\Tools\\a.exe"].accounting;
+    a.userMicroseconds = 1500000;
+    a.kernelMicroseconds = 250000;
+    a.peakMemoryBytes = 64ull * 1024 * 1024;
+    a.readBytes = 4096;
+    a.writeBytes = 512;
+    a.otherBytes = 8;
+    a.processCount = 3;
+    ProcessAccounting& b = capture.programs[L"C:\\Tools\\b.exe"].accounting;
+    b.userMicroseconds = 500000;
+    b.peakMemoryBytes = 16ull * 1024 * 1024;
+    b.writeBytes = 100;
+    b.processCount = 1;
+    capture.programs[L"C:\\Tools\\b.exe"].exitCode = 2;
+    capture.programs[L"C:\\Tools\\hang.exe"].hangs = true;
+    capture.programs[L"C:\\Tools\\hang.exe"].accounting.processCount = 1;
+
+    std::vector<CaptureLaunch> launches;
+    passed = passed && ParseCaptureLaunchList("C:\\Tools\\a.exe\nC:\\Tools\\b.exe\nC:\\Tools\\missing.exe\n"
+                                              "C:\\Tools\\hang.exe\n", launches);
+    CaptureOptions options;
+    options.timeoutMs = 20;
+    CaptureReport report;
+
+    // TEST 1: Default tanpa accounting - tidak ada query
+    RunCapturedLaunches(launches, options, CaptureOutputCallback(), report);
+    passed = passed && (capture.accountingQueries == 0 && report.launchesAccounted == 0 &&
+                        !report.results[0].hasAccounting &&
+                        FormatCaptureReport(report).find("cpu ") == std::string::npos &&
+                        FormatCaptureReportJson(report).find("\"accounting\"") == std::string::npos);
+
+    // TEST 2: Satu query per proses (termasuk yang timeout, sebelum di-terminate); rejected tidak
+    options.accounting = true;
+    passed = passed && !RunCapturedLaunches(launches, options, CaptureOutputCallback(), report);
+    passed = passed && (capture.accountingQueries == 3 && report.launchesAccounted == 3 &&
+                        report.results[0].hasAccounting && report.results[0].accounting.readBytes == 4096 &&
+                        report.results[1].hasAccounting && report.results[1].exitCode == 2 &&
+                        !report.results[2].hasAccounting &&
+                        report.results[3].status == CAPTURE_LAUNCH_TIMED_OUT && report.results[3].hasAccounting);
+    passed = passed && (report.accounting.userMicroseconds == 2000000 &&
+                        report.accounting.kernelMicroseconds == 250000 &&
+                        report.accounting.peakMemoryBytes == 64ull * 1024 * 1024 &&
+                        report.accounting.writeBytes == 612 && report.accounting.processCount == 5);
+
+    // TEST 3: Report teks - baris per launch dan total
+    std::string text = FormatCaptureReport(report);
+    passed = passed && (text.find("\n    cpu 1.500 s user + 0.250 s kernel, peak 64.0 MB, "
+                                  "io 4096 read 512 write 8 other bytes, 3 processes\n") != std::string::npos &&
+                        text.find("3 launches accounted: cpu 2.000 s user + 0.250 s kernel, peak 64.0 MB")
+                            != std::string::npos);
+
+    // TEST 4: JSON - path di-escape, accounting hanya untuk launch yang punya
+    std::string json = FormatCaptureReportJson(report);
+    passed = passed && (json.find("{\"launches\":[{\"path\":\"C:\\\\Tools\\\\a.exe\",\"line\":1,"
+                                  "\"status\":\"completed\"") == 0 &&
+                        json.find("\"accounting\":{\"userMicroseconds\":1500000,\"kernelMicroseconds\":250000,"
+                                  "\"peakMemoryBytes\":67108864,\"readBytes\":4096,\"writeBytes\":512,"
+                                  "\"otherBytes\":8,\"processCount\":3}}") != std::string::npos &&
+                        json.find("\"status\":\"rejected\",\"validation\":\"not-found\"") != std::string::npos &&
+                        json.find("\"accounted\":3,\"accounting\":{\"userMicroseconds\":2000000") != std::string::npos &&
+                        json.back() == '\n');
+
+    // TEST 5: Query gagal (misalnya proses di luar job) - launch tetap dilaporkan tanpa accounting
+    capture.accountingError = OS_ERROR_ACCESS_DENIED;
+    launches.resize(1);
+    passed = passed && RunCapturedLaunches(launches, options, CaptureOutputCallback(), report);
+    passed = passed && (report.launchesAccounted == 0 && !report.results[0].hasAccounting &&
+                        report.launchesSucceeded == 1 &&
+                        FormatCaptureReport(report).find("accounted") == std::string::npos);
+    passed = passed && (capture.accountingQueries == 4 && capture.closeCalls == 7 && capture.openPorts == 0 &&
+                        fs.openHandles == 0);
+
+    SetOutputCaptureBackend(NULL);
+    SetFileSystemBackend(NULL);
+
+    TEST_ASSERT(passed, "Captured launches should report job accounting when enabled");
+
+    TEST_PASS("Job accounting is queried once per launch and summarized");
+}
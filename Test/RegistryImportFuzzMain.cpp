@@ -0,0 +1,295 @@
+/**
+ * @file RegistryImportFuzzMain.cpp
+ * @brief Fuzzer parser .reg dan engine /regimport di atas registry palsu
+ *
+ * Setiap input diperiksa dengan dua invariant:
+ * - Parse satu kali (ParseRegistryFile) dan parse streaming dengan chunk
+ *   yang dipotong di posisi berbeda menghasilkan blok, status, dan nomor
+ *   baris error yang sama.
+ * - Jika input valid, dry run di atas FakeRegistryBackend melaporkan jumlah
+ *   key/value yang sama dengan import nyata pada registry awal yang sama,
+ *   dan tidak ada handle key yang bocor.
+ *
+ * Tanpa libFuzzer, program ini adalah mutation fuzzer mandiri: corpus
+ * bawaan (dan file yang diberikan) dimutasi secara acak dengan seed tetap,
+ * sehingga dapat dijalankan sebagai smoke test ctest. Dengan
+ * -DRASTI_LIBFUZZER=ON (Clang), LLVMFuzzerTestOneInput dipakai oleh libFuzzer.
+ *
+ * Usage:
+ *   rasti_regimport_fuzz [--iterations=N] [--seed=N] [FILE...]
+ *
+ * Exit code 0 jika semua input memenuhi invariant, 1 jika ada yang gagal
+ * (input dicetak sebagai hex), 2 jika argumen atau file tidak valid.
+ *
+ * @author RasTI Development Team
+ * @version 1.2.0.0
+ * @date 2025
+ */
+
+#include "RegistryImport.h"
+#include "TestSupport.h"
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iterator>
+#include <random>
+#include <sstream>
+
+//==============================================================================
+// INVARIANTS
+//==============================================================================
+
+/** @brief Registry awal yang sama untuk dry run dan import nyata */
+static void SeedRegistry(FakeRegistryBackend& reg)
+{
+    reg.Put(REGISTRY_ROOT_LOCAL_MACHINE, L"SOFTWARE\\RasTI", L"Keep", REGISTRY_TYPE_DWORD, { 1, 0, 0, 0 });
+    reg.Put(REGISTRY_ROOT_LOCAL_MACHINE, L"SOFTWARE\\RasTI", L"", REGISTRY_TYPE_SZ, { 'x', 0, 0, 0 });
+    reg.Put(REGISTRY_ROOT_LOCAL_MACHINE, L"SOFTWARE\\RasTI\\Sub", L"A", REGISTRY_TYPE_BINARY, { 1, 2, 3 });
+    reg.Put(REGISTRY_ROOT_CURRENT_USER, L"Software\\Stale\\Child", L"v", REGISTRY_TYPE_DWORD, { 7, 0, 0, 0 });
+}
+
+/**
+ * @brief Memeriksa satu input; failure diisi alasan jika invariant dilanggar
+ */
+static bool CheckInput(const uint8_t* data, size_t size, std::string& failure)
+{
+    std::string_view bytes(reinterpret_cast<const char*>(data), size);
+    std::vector<RegistryKeyBlock> blocks;
+    size_t errorLine = 0;
+    bool parsed = ParseRegistryFile(bytes, blocks, &errorLine);
+
+    // Chunk tetap kecil, lalu chunk yang ukurannya bergantung pada input
+    const size_t chunks[] = { 1, 2, 3, 7, 64, 1 + size % 13 };
+    for (size_t chunk : chunks) {
+        RegistryFileParser parser;
+        std::vector<RegistryKeyBlock> streamed;
+        bool ok = true;
+        for (size_t offset = 0; offset < size && ok; offset += chunk) {
+            ok = parser.Feed(bytes.data() + offset, std::min(chunk, size - offset));
+            parser.TakeBlocks(streamed);
+        }
+        ok = ok && parser.Finish();
+        parser.TakeBlocks(streamed);
+        if (ok != parsed || (!ok && parser.GetErrorLine() != errorLine) || (ok && streamed != blocks)) {
+            std::ostringstream text;
+            text << "chunk " << chunk << ": parsed " << ok << "/" << parsed << ", error line "
+                 << parser.GetErrorLine() << "/" << errorLine;
+            failure = text.str();
+            return false;
+        }
+    }
+    if (!parsed || blocks.empty()) {
+        return true;
+    }
+
+    // Dry run dan import nyata dari registry awal yang sama
+    RegistryImportReport dry, real;
+    RegistryImportOptions options;
+    options.keyCacheSize = 4; // Kecil agar eviction ikut teruji
+    {
+        FakeRegistryBackend reg;
+        SeedRegistry(reg);
+        SetRegistryBackend(&reg);
+        options.dryRun = true;
+        RunRegistryImport(blocks, options, dry);
+        SetRegistryBackend(NULL);
+        if (reg.createCalls || reg.setCalls || reg.deleteValueCalls || reg.deleteKeyCalls || reg.OpenHandles()) {
+            failure = "dry run wrote to the registry or leaked a handle";
+            return false;
+        }
+    }
+    {
+        FakeRegistryBackend reg;
+        SeedRegistry(reg);
+        SetRegistryBackend(&reg);
+        options.dryRun = false;
+        RunRegistryImport(blocks, options, real);
+        SetRegistryBackend(NULL);
+        if (reg.OpenHandles()) {
+            failure = "import leaked a key handle";
+            return false;
+        }
+    }
+    if (dry.keyBlocks != real.keyBlocks || dry.keysCreated != real.keysCreated ||
+        dry.keysDeleted != real.keysDeleted || dry.keysFailed != real.keysFailed ||
+        dry.valuesSet != real.valuesSet || dry.valuesUnchanged != real.valuesUnchanged ||
+        dry.valuesDeleted != real.valuesDeleted || dry.valuesFailed != real.valuesFailed) {
+        failure = "dry run and import disagree:\n" + FormatRegistryImportReport(dry) + FormatRegistryImportReport(real);
+        return false;
+    }
+    return true;
+}
+
+#ifdef RASTI_LIBFUZZER
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size)
+{
+    std::string failure;
+    if (!CheckInput(data, size, failure)) {
+        fprintf(stderr, "%s\n", failure.c_str());
+        abort();
+    }
+    return 0;
+}
+
+#else
+
+//==============================================================================
+// STANDALONE MUTATION DRIVER
+//==============================================================================
+
+/** @brief Teks .reg sebagai UTF-16LE dengan BOM */
+static std::string Utf16(const std::string& text)
+{
+    std::string bytes("\xFF\xFE", 2);
+    for (char ch : text) {
+        bytes.push_back(ch);
+        bytes.push_back('\0');
+    }
+    return bytes;
+}
+
+/** @brief Corpus awal: fitur format yang didukung, UTF-8 dan UTF-16LE */
+static std::vector<std::string> BuiltinCorpus()
+{
+    const std::string regedit5 =
+        "Windows Registry Editor Version 5.00\r\n\r\n"
+        "; comment\r\n"
+        "[HKEY_LOCAL_MACHINE\\SOFTWARE\\RasTI]\r\n"
+        "@=\"default\"\r\n"
+        "\"Keep\"=dword:00000001\r\n"
+        "\"Path\"=\"C:\\\\Tools \\\"x\\\"\"\r\n"
+        "\"Expand\"=hex(2):25,00,41,00,\\\r\n  00,00\r\n"
+        "\"Old\"=-\r\n\r\n"
+        "[-HKEY_CURRENT_USER\\Software\\Stale]\r\n\r\n"
+        "[HKEY_LOCAL_MACHINE\\SOFTWARE\\RasTI\\Sub\\Deep]\r\n"
+        "\"A\"=hex:01,02,03\r\n"
+        "\"A\"=hex(b):01,00,00,00,00,00,00,00\r\n"
+        "\"A\"=-\r\n\r\n"
+        "[-HKLM\\SOFTWARE\\RasTI\\Sub]\r\n"
+        "[HKLM\\Software\\rasti\\sub]\r\n"
+        "\"a\"=hex:01,02,03\r\n";
+    const std::string regedit4 =
+        "REGEDIT4\n\n"
+        "[HKEY_CURRENT_USER\\Software\\Stale\\Child]\n"
+        "\"v\"=dword:7\n"
+        "\"Name\"=hex(1):41,42,00\n"
+        "\"Bin\"=hex:\n"
+        "[HKCU\\Software\\Stale]\n"
+        "[-HKCU\\Software\\Stale\\Child]\n"
+        "[HKEY_USERS\\.DEFAULT\\Software\\X]\n"
+        "@=-\n";
+    return { regedit5, Utf16(regedit5), regedit4, "\xEF\xBB\xBF" + regedit4 };
+}
+
+/** @brief Token format .reg yang disisipkan mutator */
+static const char* const kTokens[] = {
+    "[", "]", "[-", "\\", "\"", "=", "@", "-", ",", ";", "\r\n", "\n", "\\\r\n", "dword:", "hex:", "hex(2):",
+    "hex(7):", "00,", "ff", "HKLM\\", "HKEY_CURRENT_USER\\", "SOFTWARE\\RasTI", "\\Sub", "\"Keep\"=", "REGEDIT4\n",
+};
+
+/** @brief Satu sampai empat mutasi acak (byte, token, hapus, duplikasi) */
+static void Mutate(std::string& input, std::mt19937& random)
+{
+    int mutations = 1 + random() % 4;
+    for (int i = 0; i < mutations; i++) {
+        size_t pos = input.empty() ? 0 : random() % (input.size() + 1);
+        switch (random() % 5) {
+        case 0:
+            if (pos < input.size()) input[pos] = static_cast<char>(random());
+            break;
+        case 1:
+            input.insert(pos, kTokens[random() % (sizeof(kTokens) / sizeof(kTokens[0]))]);
+            break;
+        case 2:
+            input.erase(pos, random() % 8);
+            break;
+        case 3:
+            if (pos < input.size()) {
+                std::string copy = input.substr(pos, 1 + random() % 32);
+                input.insert(random() % (input.size() + 1), copy);
+            }
+            break;
+        default:
+            if (pos < input.size()) input[pos] ^= static_cast<char>(1 << (random() % 8));
+            break;
+        }
+    }
+}
+
+/** @brief Nilai argumen "--key=value" jika arg diawali prefix */
+static bool ReadOption(const std::string& arg, const char* prefix, std::string& value)
+{
+    std::string key(prefix);
+    if (arg.compare(0, key.size(), key) != 0) {
+        return false;
+    }
+    value = arg.substr(key.size());
+    return true;
+}
+
+static void PrintInput(const std::string& input)
+{
+    for (size_t i = 0; i < input.size(); i++) {
+        printf("%02x%s", static_cast<unsigned char>(input[i]), (i % 32 == 31) ? "\n" : " ");
+    }
+    printf("\n");
+}
+
+int main(int argc, char* argv[]) {
+    long iterations = 10000;
+    unsigned seed = 1;
+    std::vector<std::string> corpus = BuiltinCorpus();
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        std::string value;
+        if (ReadOption(arg, "--iterations=", value)) {
+            iterations = atol(value.c_str());
+            if (iterations < 0) {
+                fprintf(stderr, "Invalid iteration count: %s\n", value.c_str());
+                return 2;
+            }
+        } else if (ReadOption(arg, "--seed=", value)) {
+            seed = static_cast<unsigned>(strtoul(value.c_str(), NULL, 10));
+        } else if (arg.compare(0, 2, "--") != 0) {
+            std::ifstream file(arg, std::ios::binary);
+            if (!file) {
+                fprintf(stderr, "Cannot read %s\n", arg.c_str());
+                return 2;
+            }
+            corpus.emplace_back(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+        } else {
+            fprintf(stderr, "Usage: rasti_regimport_fuzz [--iterations=N] [--seed=N] [FILE...]\n");
+            return 2;
+        }
+    }
+
+    std::string failure;
+    for (const std::string& input : corpus) {
+        if (!CheckInput(reinterpret_cast<const uint8_t*>(input.data()), input.size(), failure)) {
+            printf("FAILED (corpus input): %s\n", failure.c_str());
+            PrintInput(input);
+            return 1;
+        }
+    }
+
+    std::mt19937 random(seed);
+    long validInputs = 0;
+    for (long i = 0; i < iterations; i++) {
+        std::string input = corpus[random() % corpus.size()];
+        Mutate(input, random);
+        std::vector<RegistryKeyBlock> blocks;
+        validInputs += ParseRegistryFile(input, blocks) ? 1 : 0;
+        if (!CheckInput(reinterpret_cast<const uint8_t*>(input.data()), input.size(), failure)) {
+            printf("FAILED (iteration %ld, seed %u): %s\n", i, seed, failure.c_str());
+            PrintInput(input);
+            return 1;
+        }
+    }
+
+    printf("%ld mutated inputs checked (%ld valid), %zu corpus inputs\n", iterations, validInputs, corpus.size());
+    return 0;
+}
+
+#endif
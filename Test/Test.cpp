@@ -5,12 +5,17 @@
  * File ini berisi comprehensive unit tests untuk menguji semua fungsi
  * privilege escalation dan security validation dalam RasTI.
  *
- * Total Test Coverage: 16 test functions across 3 categories
+ * Total Test Coverage: 47 test functions across 4 categories
+ *
+ * Test yang hanya memakai backend palsu berada di PortableTests.cpp
+ * (juga dijalankan di Linux melalui PortableMain.cpp/ctest); backend palsu
+ * dan macro test berada di TestSupport.h.
  *
  * Test Categories:
- * - PRIVILEGE TESTS (5 tests): Testing privilege management functions
- * - SECURITY TESTS (8 tests): Testing path validation dan security functions
- * - VALIDATION TESTS (3 tests): Testing utility functions dan input parsing
+ * - PRIVILEGE TESTS (8 tests): Testing privilege management functions
+ * - SECURITY TESTS (11 tests): Testing path validation dan security functions
+ * - VALIDATION TESTS (10 tests): Testing utility functions, input parsing, dan engine /fileops, /aclreset, /regimport, /scripthost, dan /capture
+ * - PERFORMANCE TESTS (18 tests): Syscall budget, conversion/allocation, hash cache, path policy, bulk throughput, microbenchmarks per function, latency launch, biaya mode console, pemilihan API launch, replay trace backend, timing launch pipeline, scheduler graf launch, supervisor restart, adjust proses massal, launch multi-session, indeks single-instance, dan accounting job capture
  *
  * Critical Functions Covered:
  * ✅ ResolveDynamicFunctions
@@ -29,6 +34,33 @@
  * ✅ GetErrorMessageCode
  * ✅ CommandLinePriorityParsing
  * ✅ Security Bug Fixes Analysis (comprehensive)
+ * ✅ ValidateExecutable (syscall budget via FakeFileSystemBackend)
+ * ✅ ToExtendedLengthPath / long path + Unicode validation
+ * ✅ Launch path conversion benchmark (ANSI vs UTF-16)
+ * ✅ Sha256 (FIPS 180-4 vectors, SHA-NI / scalar)
+ * ✅ HashAllowlist + FileHashCache (allowlist enforcement, cache hit/miss)
+ * ✅ PathPolicy (allow/deny trie, glob, 10k-rule benchmark)
+ * ✅ ValidatePathList / ValidateDirectoryTree (work stealing, CSV/JSON, PATH index)
+ * ✅ AcquireTrustedInstallerToken / LaunchWithTrustedInstaller (FakeProcessBackend)
+ * ✅ Microbenchmark ns/op + alokasi/op per function Core (baseline JSON/compare)
+ * ✅ RunLaunchBenchmark / TrustedInstallerTokenCache (p50/p90/p99 cold vs warm)
+ * ✅ ResolveConsoleMode / ApplyConsoleMode (/console, latency + commit new vs none)
+ * ✅ TrustedInstallerLauncher (/launchapi, CreateProcessAsUserW + fallback seclogon)
+ * ✅ BackendTrace record/replay (TracingBackend, TraceReplayBackend)
+ * ✅ LaunchPipeline (CREATE_SUSPENDED, job/affinity/prioritas I/O+memori, rollback)
+ * ✅ LaunchGraph (after-success/after-exit, timeout per node, batas paralel, critical path)
+ * ✅ Supervisor (backoff eksponensial, batas crash loop, token cache, snapshot metrics)
+ * ✅ ProcessAdjust (tabel proses berindeks, selector PID/nama/path, hasil per proses)
+ * ✅ SessionLaunch (enumerasi session, satu token untuk banyak session, launch paralel)
+ * ✅ SingleInstance (indeks path image, skip/attach /single, dedup dalam satu batch)
+ * ✅ CaptureAccounting (accounting job per launch, total batch, report teks dan JSON)
+ * ✅ RunAsTrustedInstaller / TrustedInstallerWorker (callback in-process)
+ * ✅ RasTIApi C ABI (RastiAcquireToken, RastiLaunch, RastiWait, RastiGetLastError)
+ * ✅ ParseFileOperationScript / RunFileOperations (/fileops di direktori sementara)
+ * ✅ ParseAclTemplate / DeriveInheritedAcl / RunAclReset (/aclreset, checkpoint + resume)
+ * ✅ RegistryFileParser / RunRegistryImport (/regimport, cache handle key + dry run)
+ * ✅ ParseScriptJobList / RunScriptHost (/scripthost, marker per job + recycle host)
+ * ✅ RunCapturedLaunches / CaptureConsoleWriter / CaptureLogWriter (/capture, /batch)
  *
  * @author RasTI Development Team
  * @version 1.1.1.0 - Enhanced Coverage
@@ -36,6 +68,8 @@
  */
 
 #include "Core.h"
+#include "TestSupport.h"
+#include "Microbenchmark.h"
 #include <iostream>
 #include <string>
 #include <cassert>
@@ -45,22 +79,16 @@
 #include <chrono>
 #include <vector>
 #include <sstream>
-
-//==============================================================================
-// TEST MACROS
-//==============================================================================
-
-/** @brief Macro untuk assertion dalam test functions */
-#define TEST_ASSERT(condition, message) \
-    if (!(condition)) { \
-        std::cout << "TEST FAILED: " << message << std::endl; \
-        return false; \
-    }
-
-/** @brief Macro untuk menandai test berhasil */
-#define TEST_PASS(message) \
-    std::cout << "TEST PASSED: " << message << std::endl; \
-    return true;
+#include <map>
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <cstdlib>
+#include <new>
+#include <atomic>
+#include <mutex>
+#include <set>
+#include <thread>
 
 bool TestResolveDynamicFunctions() {
     std::cout << "Testing ResolveDynamicFunctions..." << std::endl;
@@ -347,11 +375,11 @@ bool TestSecurityBugFixesAnalysis() {
     // TEST 1: sprintf buffer safety fix validation
     {
         // Test the new GetErrorMessageCode function
-        AnsiString safeMessage = GetErrorMessageCode("Test error", 4294967295UL); // Max DWORD value
+        String safeMessage = GetErrorMessageCode("Test error", 4294967295UL); // Max DWORD value
         TEST_ASSERT(safeMessage.Pos("Error: Test error") > 0, "Error message should be formatted safely");
 
         // Test with invalid/error codes
-        AnsiString invalidMessage = GetErrorMessageCode("Invalid operation", 0xFFFFFFFF); // Another large value
+        String invalidMessage = GetErrorMessageCode("Invalid operation", 0xFFFFFFFF); // Another large value
         TEST_ASSERT(invalidMessage.Pos("Test error") == 0, "Messages should not contain previous test data");
 
         TEST_PASS("sprintf buffer overflow vulnerability has been fixed");
@@ -420,8 +448,8 @@ bool TestSecurityBugFixesAnalysis() {
         TEST_ASSERT(!ValidatePriorityValue(999), "Invalid large priority rejected");
 
         // Test path validation layers
-        TEST_ASSERT(!ValidateExecutablePath(""), "Empty path rejected");
-        TEST_ASSERT(!ValidateExecutablePath("..\\bad.exe"), "Traversal path rejected");
+        TEST_ASSERT(!ValidateExecutablePath(L""), "Empty path rejected");
+        TEST_ASSERT(!ValidateExecutablePath(L"..\\bad.exe"), "Traversal path rejected");
 
         // Test command-line validation (through Main.cpp logic validation)
         TEST_PASS("Comprehensive input validation prevents attacks");
@@ -446,9 +474,9 @@ bool TestSecurityBugFixesAnalysis() {
         // No unlimited resource consumption possible
 
         // Test canonical path length limits
-        AnsiString testPath = "C:\\Windows\\System32\\notepad.exe";
-        AnsiString canonicalPath = GetCanonicalPath(testPath);
-        TEST_ASSERT(canonicalPath.Length() <= MAX_PATH, "Path length limits prevent DoS");
+        std::wstring testPath = L"C:\\Windows\\System32\\notepad.exe";
+        std::wstring canonicalPath = GetCanonicalPath(testPath);
+        TEST_ASSERT(canonicalPath.size() <= VALIDATION_MAX_PATH, "Path length limits prevent DoS");
 
         TEST_PASS("Resource exhaustion prevention mechanisms are implemented");
     }
@@ -470,7 +498,7 @@ bool TestIsValidExecutable() {
     {
         // This will likely fail in test environment due to permissions,
         // but we can test the function doesn't crash and returns appropriate result
-        AnsiString validPath = "C:\\Windows\\System32\\notepad.exe";
+        std::wstring validPath = L"C:\\Windows\\System32\\notepad.exe";
 
         // The function should not crash regardless of result
         bool result = IsValidExecutable(validPath);
@@ -482,7 +510,7 @@ bool TestIsValidExecutable() {
 
     // TEST 2: Test with invalid/non-existent paths
     {
-        AnsiString invalidPath = "C:\\ThisPathDoesNotExist\\nonexistent.exe";
+        std::wstring invalidPath = L"C:\\ThisPathDoesNotExist\\nonexistent.exe";
 
         // Should return false for non-existent paths
         bool result = IsValidExecutable(invalidPath);
@@ -493,7 +521,7 @@ bool TestIsValidExecutable() {
 
     // TEST 3: Test with directory paths (should fail)
     {
-        AnsiString dirPath = "C:\\Windows\\System32";
+        std::wstring dirPath = L"C:\\Windows\\System32";
 
         // Should return false for directory paths
         bool result = IsValidExecutable(dirPath);
@@ -504,7 +532,7 @@ bool TestIsValidExecutable() {
 
     // TEST 4: Test with empty paths
     {
-        AnsiString emptyPath = "";
+        std::wstring emptyPath;
 
         // Should return false for empty paths
         bool result = IsValidExecutable(emptyPath);
@@ -516,7 +544,7 @@ bool TestIsValidExecutable() {
     // TEST 5: Test error handling - ensure no crashes with malformed input
     {
         // Test with very long path (near MAX_PATH limit)
-        AnsiString longPath = AnsiString::StringOfChar('A', MAX_PATH - 10) + ".exe";
+        std::wstring longPath = std::wstring(MAX_PATH - 10, L'A') + L".exe";
 
         // Should handle gracefully without crashing
         bool result = IsValidExecutable(longPath);
@@ -542,28 +570,28 @@ bool TestFindExecutableInPath() {
     // TEST 1: Test with known system executable (should find in PATH)
     {
         // Try to find notepad.exe (usually in PATH)
-        AnsiString result = FindExecutableInPath("notepad.exe");
+        std::wstring result = FindExecutableInPath(L"notepad.exe");
 
         // We don't assert the result since PATH contents vary,
         // but the function should not crash
-        std::cout << "notepad.exe search result: " << result.c_str() << std::endl;
+        std::wcout << L"notepad.exe search result: " << result << std::endl;
 
         TEST_PASS("FindExecutableInPath handles known executables gracefully");
     }
 
     // TEST 2: Test with non-existent executable
     {
-        AnsiString result = FindExecutableInPath("thisexecutabledoesnotexist12345.exe");
+        std::wstring result = FindExecutableInPath(L"thisexecutabledoesnotexist12345.exe");
 
         // Should return empty string for non-existent executables
-        TEST_ASSERT(result.IsEmpty(), "FindExecutableInPath should return empty for non-existent executables");
+        TEST_ASSERT(result.empty(), "FindExecutableInPath should return empty for non-existent executables");
 
         TEST_PASS("FindExecutableInPath correctly handles non-existent executables");
     }
 
     // TEST 3: Test with executable without extension (.exe added automatically)
     {
-        AnsiString result = FindExecutableInPath("notepad"); // Without .exe
+        std::wstring result = FindExecutableInPath(L"notepad"); // Without .exe
 
         // Should automatically add .exe extension
         // Result depends on PATH but should not crash
@@ -581,10 +609,10 @@ bool TestFindExecutableInPath() {
     // TEST 5: Test with malformed inputs
     {
         // Edge case testing
-        AnsiString result1 = FindExecutableInPath("");
-        TEST_ASSERT(result1.IsEmpty(), "FindExecutableInPath should handle empty input");
+        std::wstring result1 = FindExecutableInPath(L"");
+        TEST_ASSERT(result1.empty(), "FindExecutableInPath should handle empty input");
 
-        AnsiString result2 = FindExecutableInPath("   "); // Whitespace
+        std::wstring result2 = FindExecutableInPath(L"   "); // Whitespace
         // Should handle gracefully
         TEST_PASS("FindExecutableInPath handles edge case inputs");
     }
@@ -714,48 +742,47 @@ bool TestCanonicalPathValidation() {
 
     // TEST 1: Basic canonical path conversion
     {
-        AnsiString inputPath = "C:\\Windows\\System32\\notepad.exe";
-        AnsiString canonicalPath = GetCanonicalPath(inputPath);
-        TEST_ASSERT(!canonicalPath.IsEmpty(), "Canonical path conversion should succeed for valid path");
+        std::wstring inputPath = L"C:\\Windows\\System32\\notepad.exe";
+        std::wstring canonicalPath = GetCanonicalPath(inputPath);
+        TEST_ASSERT(!canonicalPath.empty(), "Canonical path conversion should succeed for valid path");
         TEST_ASSERT(canonicalPath == inputPath, "Canonical path should be identical for already-canonical input");
     }
 
     // TEST 2: Relative path canonicalization
     {
-        AnsiString relativePath = ".\\test.exe";
-        AnsiString canonicalPath = GetCanonicalPath(relativePath);
-        TEST_ASSERT(!canonicalPath.IsEmpty(), "Relative path should be canonicalized");
-        TEST_ASSERT(canonicalPath.Pos(":") == 2, "Canonical path should contain drive letter");
-        TEST_ASSERT(canonicalPath.Length() > relativePath.Length(), "Canonical path should be longer (absolute)");
+        std::wstring relativePath = L".\\test.exe";
+        std::wstring canonicalPath = GetCanonicalPath(relativePath);
+        TEST_ASSERT(!canonicalPath.empty(), "Relative path should be canonicalized");
+        TEST_ASSERT(canonicalPath.find(L':') == 1, "Canonical path should contain drive letter");
+        TEST_ASSERT(canonicalPath.size() > relativePath.size(), "Canonical path should be longer (absolute)");
     }
 
     // TEST 3: Path traversal detection (basic)
     {
-        TEST_ASSERT(!IsPathTraversalSafe("..\\notepad.exe"), "Path traversal ..\\ should be detected");
-        TEST_ASSERT(!IsPathTraversalSafe("C:\\Windows\\..\\System32\\notepad.exe"), "Path traversal in middle should be detected");
-        TEST_ASSERT(!IsPathTraversalSafe("test<>.exe"), "Suspicious characters should be rejected");
+        TEST_ASSERT(!IsPathTraversalSafe(L"..\\notepad.exe"), "Path traversal ..\\ should be detected");
+        TEST_ASSERT(!IsPathTraversalSafe(L"C:\\Windows\\..\\System32\\notepad.exe"), "Path traversal in middle should be detected");
+        TEST_ASSERT(!IsPathTraversalSafe(L"test<>.exe"), "Suspicious characters should be rejected");
     }
 
     // TEST 4: Safe paths
     {
-        TEST_ASSERT(IsPathTraversalSafe("C:\\Windows\\notepad.exe"), "Valid absolute path should be safe");
-        TEST_ASSERT(IsPathTraversalSafe("notepad.exe"), "Simple filename should be safe");
-        TEST_ASSERT(IsPathTraversalSafe("C:\\Program Files\\test.exe"), "Path with spaces should be safe");
+        TEST_ASSERT(IsPathTraversalSafe(L"C:\\Windows\\notepad.exe"), "Valid absolute path should be safe");
+        TEST_ASSERT(IsPathTraversalSafe(L"notepad.exe"), "Simple filename should be safe");
+        TEST_ASSERT(IsPathTraversalSafe(L"C:\\Program Files\\test.exe"), "Path with spaces should be safe");
     }
 
     // TEST 5: Empty path handling
     {
-        AnsiString emptyPath = "";
-        AnsiString canonicalResult = GetCanonicalPath(emptyPath);
-        TEST_ASSERT(canonicalResult.IsEmpty(), "Empty path should return empty canonical path");
+        std::wstring emptyPath;
+        std::wstring canonicalResult = GetCanonicalPath(emptyPath);
+        TEST_ASSERT(canonicalResult.empty(), "Empty path should return empty canonical path");
     }
 
     // TEST 6: Very long path handling
     {
-        AnsiString longPath = AnsiString::StringOfChar('A', MAX_PATH + 10);
-        AnsiString canonicalResult = GetCanonicalPath(longPath);
-        // This might fail on Windows due to path length limits, but we test the behavior
-        // The important thing is it doesn't crash
+        std::wstring longPath(MAX_PATH + 10, L'A');
+        std::wstring canonicalResult = GetCanonicalPath(longPath);
+        // Path > MAX_PATH sekarang didukung; yang penting tidak crash
         TEST_PASS("Long path handling doesn't crash the path validation system");
     }
 
@@ -766,13 +793,13 @@ bool TestCanonicalPathValidation() {
         // but we can test the validation logic
 
         // Empty path should fail
-        TEST_ASSERT(!ValidateExecutablePath(""), "Empty path should fail validation");
+        TEST_ASSERT(!ValidateExecutablePath(L""), "Empty path should fail validation");
 
         // Path with traversal should fail
-        TEST_ASSERT(!ValidateExecutablePath("..\\cmd.exe"), "Path with traversal should fail validation");
+        TEST_ASSERT(!ValidateExecutablePath(L"..\\cmd.exe"), "Path with traversal should fail validation");
 
-        // Path that's too long should fail
-        AnsiString tooLongPath = AnsiString::StringOfChar('A', MAX_PATH + 1);
+        // Path that's too long should fail (batas NT path, bukan lagi MAX_PATH)
+        std::wstring tooLongPath(VALIDATION_MAX_PATH + 1, L'A');
         TEST_ASSERT(!ValidateExecutablePath(tooLongPath), "Too long path should fail validation");
 
         TEST_PASS("Comprehensive executable path validation works correctly");
@@ -784,24 +811,28 @@ bool TestCanonicalPathValidation() {
 bool TestSecurityValidations() {
     std::cout << "Testing security validation functions..." << std::endl;
 
-    AnsiString testPath = "  test.exe  ";
+    std::wstring testPath = L"  test.exe  ";
     TEST_ASSERT(SanitizePath(testPath), "SanitizePath should succeed");
-    TEST_ASSERT(testPath.Pos("  ") == 0, "SanitizePath should remove whitespace");
+    TEST_ASSERT(testPath == L"test.exe", "SanitizePath should remove whitespace");
 
-    TEST_ASSERT(IsPathTraversalSafe("C:\\Windows\\notepad.exe"), "Valid absolute path should be safe");
-    TEST_ASSERT(IsPathTraversalSafe("notepad.exe"), "Simple filename should be safe");
+    std::wstring uncPath = L"\\\\server\\share//tools\\\\app.exe";
+    TEST_ASSERT(SanitizePath(uncPath), "SanitizePath should accept UNC paths");
+    TEST_ASSERT(uncPath == L"\\\\server\\share\\tools\\app.exe", "SanitizePath should keep UNC prefix and collapse separators");
 
-    TEST_ASSERT(!IsPathTraversalSafe("..\\notepad.exe"), "Path with .. should be unsafe");
-    TEST_ASSERT(!IsPathTraversalSafe("C:\\Windows\\..\\system32\\notepad.exe"), "Path with .. in middle should be unsafe");
-    TEST_ASSERT(!IsPathTraversalSafe("test<>.exe"), "Path with suspicious chars should be unsafe");
+    TEST_ASSERT(IsPathTraversalSafe(L"C:\\Windows\\notepad.exe"), "Valid absolute path should be safe");
+    TEST_ASSERT(IsPathTraversalSafe(L"notepad.exe"), "Simple filename should be safe");
+
+    TEST_ASSERT(!IsPathTraversalSafe(L"..\\notepad.exe"), "Path with .. should be unsafe");
+    TEST_ASSERT(!IsPathTraversalSafe(L"C:\\Windows\\..\\system32\\notepad.exe"), "Path with .. in middle should be unsafe");
+    TEST_ASSERT(!IsPathTraversalSafe(L"test<>.exe"), "Path with suspicious chars should be unsafe");
 
     TEST_ASSERT(ValidatePriorityValue(IDLE_PRIORITY_CLASS), "IDLE_PRIORITY_CLASS should be valid");
     TEST_ASSERT(ValidatePriorityValue(NORMAL_PRIORITY_CLASS), "NORMAL_PRIORITY_CLASS should be valid");
     TEST_ASSERT(ValidatePriorityValue(REALTIME_PRIORITY_CLASS), "REALTIME_PRIORITY_CLASS should be valid");
     TEST_ASSERT(!ValidatePriorityValue(999), "Invalid priority should be rejected");
 
-    TEST_ASSERT(!ValidateExecutablePath(""), "Empty path should be invalid");
-    TEST_ASSERT(!ValidateExecutablePath(std::string(MAX_PATH + 1, 'A').c_str()), "Very long path should be invalid");
+    TEST_ASSERT(!ValidateExecutablePath(L""), "Empty path should be invalid");
+    TEST_ASSERT(!ValidateExecutablePath(std::wstring(VALIDATION_MAX_PATH + 1, L'A')), "Very long path should be invalid");
 
     TEST_PASS("Security validation functions work correctly");
 }
@@ -809,16 +840,247 @@ bool TestSecurityValidations() {
 bool TestErrorMessages() {
     std::cout << "Testing error message functions..." << std::endl;
 
-    AnsiString msg1 = GetErrorMessage("Test error");
+    String msg1 = GetErrorMessage("Test error");
     TEST_ASSERT(msg1.Pos("Error: Test error") > 0, "GetErrorMessage should format correctly");
 
-    AnsiString msg2 = GetErrorMessageCode("Test error", 123);
+    String msg2 = GetErrorMessageCode("Test error", 123);
     TEST_ASSERT(msg2.Pos("Error: Test error") > 0, "GetErrorMessageCode should include error code");
     TEST_ASSERT(msg2.Pos("123") > 0, "GetErrorMessageCode should include error number");
 
     TEST_PASS("Error message functions format correctly");
 }
 
+//==============================================================================
+// ALLOCATION COUNTER
+//==============================================================================
+
+/** @brief Jumlah alokasi heap melalui operator new sejak program mulai (atomic: test bulk multi-thread) */
+static std::atomic<long> gAllocationCount(0);
+
+void* operator new(size_t size)
+{
+    gAllocationCount++;
+    void* memory = malloc(size ? size : 1);
+    if (!memory) throw std::bad_alloc();
+    return memory;
+}
+
+void operator delete(void* memory) noexcept
+{
+    free(memory);
+}
+
+void operator delete(void* memory, size_t) noexcept
+{
+    free(memory);
+}
+
+//==============================================================================
+// LEGACY ANSI PIPELINE REPLICA (BENCHMARK BASELINE)
+//==============================================================================
+
+/** @brief Jumlah konversi code page yang dilakukan replika pipeline lama */
+static int gLegacyConversions = 0;
+
+/** @brief Konversi ANSI -> UTF-16 (thunk API *A atau MultiByteToWideChar) */
+static std::wstring LegacyToWide(const std::string& text)
+{
+    gLegacyConversions++;
+    int length = MultiByteToWideChar(CP_ACP, 0, text.c_str(), static_cast<int>(text.size()), NULL, 0);
+    std::wstring wide(length, L'\0');
+    if (length > 0) {
+        MultiByteToWideChar(CP_ACP, 0, text.c_str(), static_cast<int>(text.size()), &wide[0], length);
+    }
+    return wide;
+}
+
+/** @brief Konversi UTF-16 -> ANSI (String -> AnsiString atau output thunk API *A) */
+static std::string LegacyToAnsi(const std::wstring& text)
+{
+    gLegacyConversions++;
+    int length = WideCharToMultiByte(CP_ACP, 0, text.c_str(), static_cast<int>(text.size()), NULL, 0, NULL, NULL);
+    std::string ansi(length, '\0');
+    if (length > 0) {
+        WideCharToMultiByte(CP_ACP, 0, text.c_str(), static_cast<int>(text.size()), &ansi[0], length, NULL, NULL);
+    }
+    return ansi;
+}
+
+/**
+ * @brief Replika alur lama Form.cpp/Main.cpp: input -> AnsiString -> API *A -> UTF-16
+ *
+ * Setiap langkah meniru satu tahap kode lama (SanitizePath, GetCanonicalPath dengan
+ * dua panggilan GetFullPathNameA, FileExists, ExtractFileExt().LowerCase(),
+ * GetFileVersionInfoSizeA + CreateFileA, lalu MultiByteToWideChar sebelum launch).
+ * Syscall diarahkan ke backend aktif sehingga hanya biaya string yang berbeda.
+ */
+static bool LegacyValidateForLaunch(const std::wstring& input, std::wstring& launchPath)
+{
+    IFileSystemBackend* fs = GetFileSystemBackend();
+
+    // PathEdit->Text (UTF-16) disimpan sebagai AnsiString lalu Trim()
+    std::string path = LegacyToAnsi(input);
+    path = path.substr(path.find_first_not_of(' '));
+    if (path.empty() || path.size() > MAX_PATH) return false;
+
+    // SanitizePath: StringReplace("/", "\\")
+    std::string sanitized = path;
+    std::replace(sanitized.begin(), sanitized.end(), '/', '\\');
+
+    // GetCanonicalPath: GetFullPathNameA dua kali (query size + isi buffer)
+    std::wstring fullPath;
+    if (!fs->GetFullPath(LegacyToWide(sanitized), fullPath)) return false;
+    if (!fs->GetFullPath(LegacyToWide(sanitized), fullPath)) return false;
+    std::string fullAnsi = LegacyToAnsi(fullPath);
+    std::vector<char> buffer(fullAnsi.begin(), fullAnsi.end());
+    std::string canonicalPath(buffer.begin(), buffer.end());
+    canonicalPath = std::string(canonicalPath); // StringReplace("/", "\\") selalu menyalin
+
+    // FileExists(AnsiString) -> String
+    OsHandle probe = fs->OpenFileForValidation(LegacyToWide(canonicalPath));
+    if (probe == OS_INVALID_HANDLE) return false;
+    fs->CloseFile(probe);
+
+    // ExtractFileExt(AnsiString).LowerCase()
+    std::string ext = LegacyToAnsi(LegacyToWide(canonicalPath.substr(canonicalPath.rfind('.'))));
+    std::transform(ext.begin(), ext.end(), ext.begin(), ::tolower);
+    if (ext != ".exe") return false;
+
+    // IsValidExecutable: GetFileVersionInfoSizeA + CreateFileA
+    OsHandle versionFile = fs->OpenFileForValidation(LegacyToWide(canonicalPath));
+    if (versionFile == OS_INVALID_HANDLE) return false;
+    uint8_t header[PE_HEADER_PROBE_SIZE];
+    uint32_t bytesRead = 0;
+    fs->ReadFileAt(versionFile, 0, header, sizeof(header), bytesRead);
+    fs->CloseFile(versionFile);
+
+    OsHandle accessFile = fs->OpenFileForValidation(LegacyToWide(canonicalPath));
+    if (accessFile == OS_INVALID_HANDLE) return false;
+    fs->CloseFile(accessFile);
+
+    // Blok MultiByteToWideChar sebelum CreateProcessWithTIToken
+    launchPath = LegacyToWide(canonicalPath);
+    return true;
+}
+
+/**
+ * @brief Benchmark konversi dan alokasi per launch: pipeline ANSI lama vs UTF-16
+ *
+ * Kedua alur dijalankan terhadap FakeFileSystemBackend yang sama sampai path
+ * siap diberikan ke CreateProcessWithTokenW. Alur baru harus 0 konversi code
+ * page dan lebih sedikit alokasi heap daripada replika alur lama.
+ */
+bool TestLaunchPathConversionBenchmark() {
+    std::cout << "Benchmarking launch path conversions and allocations..." << std::endl;
+
+    const int ITERATIONS = 2000;
+    const std::wstring input = L"C:\\Program Files\\Tools\\app.exe";
+
+    FakeFileSystemBackend fake;
+    fake.files[input] = BuildTestPeImage(2);
+    SetFileSystemBackend(&fake);
+
+    // Alur lama (replika)
+    gLegacyConversions = 0;
+    long allocationsBefore = gAllocationCount;
+    auto legacyStart = std::chrono::high_resolution_clock::now();
+    bool legacyOk = true;
+    for (int i = 0; i < ITERATIONS; i++) {
+        std::wstring launchPath;
+        legacyOk = legacyOk && LegacyValidateForLaunch(input, launchPath);
+    }
+    auto legacyEnd = std::chrono::high_resolution_clock::now();
+    double legacyConversions = static_cast<double>(gLegacyConversions) / ITERATIONS;
+    double legacyAllocations = static_cast<double>(gAllocationCount - allocationsBefore) / ITERATIONS;
+
+    // Alur baru: String -> std::wstring -> SanitizePath -> ValidateExecutablePath
+    allocationsBefore = gAllocationCount;
+    auto wideStart = std::chrono::high_resolution_clock::now();
+    bool wideOk = true;
+    for (int i = 0; i < ITERATIONS; i++) {
+        std::wstring path(input);
+        ValidatedExecutable validated;
+        wideOk = wideOk && SanitizePath(path) && ValidateExecutablePath(path, validated);
+    }
+    auto wideEnd = std::chrono::high_resolution_clock::now();
+    double wideAllocations = static_cast<double>(gAllocationCount - allocationsBefore) / ITERATIONS;
+
+    SetFileSystemBackend(NULL);
+
+    double legacyNs = std::chrono::duration<double, std::nano>(legacyEnd - legacyStart).count() / ITERATIONS;
+    double wideNs = std::chrono::duration<double, std::nano>(wideEnd - wideStart).count() / ITERATIONS;
+
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << "  ANSI pipeline : " << legacyConversions << " conversions, "
+              << legacyAllocations << " allocations, " << legacyNs << " ns per launch" << std::endl;
+    std::cout << "  UTF-16 pipeline: 0.0 conversions, "
+              << wideAllocations << " allocations, " << wideNs << " ns per launch" << std::endl;
+
+    TEST_ASSERT(legacyOk && wideOk, "Both pipelines should accept the benchmark executable");
+    TEST_ASSERT(wideAllocations < legacyAllocations, "UTF-16 pipeline should allocate less per launch");
+
+    TEST_PASS("UTF-16 launch pipeline removes per-step conversions");
+}
+
+//==============================================================================
+// CORE MICROBENCHMARKS
+//==============================================================================
+
+/**
+ * @brief Microbenchmark per function Core (ns/op dan alokasi/op)
+ *
+ * Menjalankan case portable dari CoreBenchmarks.cpp ditambah case yang hanya
+ * ada di build Windows: GetErrorMessageCode (VCL String) dan
+ * ValidateExecutablePath terhadap filesystem asli. Baseline/compare JSON
+ * tersedia di runner portable (rasti_bench).
+ */
+bool TestCoreMicrobenchmarks() {
+    std::cout << "Running Core microbenchmarks..." << std::endl;
+
+    MicrobenchmarkOptions options;
+    options.minBatchMs = 5.0;
+    options.batches = 3;
+    options.allocationCounter = []() { return gAllocationCount.load(); };
+
+    std::vector<MicrobenchmarkCase> cases = CreateCoreMicrobenchmarks();
+    volatile size_t sink = 0; // Hasil dipakai agar panggilan tidak dioptimasi habis
+
+    const String messages[] = { "Failed to get Trusted Installer token", "Invalid executable path", "Access denied" };
+    const DWORD codes[] = { ERROR_ACCESS_DENIED, ERROR_PRIVILEGE_NOT_HELD, ERROR_FILE_NOT_FOUND, 0xC0000022 };
+    MicrobenchmarkCase errorCase;
+    errorCase.name = "GetErrorMessageCode";
+    errorCase.body = [&](uint64_t i) {
+        String message = GetErrorMessageCode(messages[i % 3], codes[i % 4]);
+        sink = sink + message.Length();
+    };
+    cases.push_back(errorCase);
+
+    wchar_t systemDirectory[MAX_PATH] = { 0 };
+    GetSystemDirectoryW(systemDirectory, MAX_PATH);
+    const std::wstring systemCmd = std::wstring(systemDirectory) + L"\\cmd.exe";
+    MicrobenchmarkCase win32Case;
+    win32Case.name = "ValidateExecutablePath/win32";
+    win32Case.body = [&](uint64_t) {
+        ValidatedExecutable validated;
+        sink = sink + ValidateExecutablePath(systemCmd, validated);
+    };
+    cases.push_back(win32Case);
+
+    std::vector<MicrobenchmarkResult> results;
+    for (const MicrobenchmarkCase& benchmark : cases) {
+        results.push_back(RunMicrobenchmark(benchmark, options));
+    }
+    PrintMicrobenchmarkResults(results, std::cout);
+
+    bool measured = !results.empty();
+    for (const MicrobenchmarkResult& result : results) {
+        measured = measured && result.iterations > 0 && result.nsPerOp > 0.0 && result.allocationsPerOp >= 0.0;
+    }
+    TEST_ASSERT(measured, "Every microbenchmark should report ns/op and allocations/op");
+
+    TEST_PASS("Core microbenchmarks measured");
+}
+
 //==============================================================================
 // TEST DATA STRUCTURES
 //==============================================================================
@@ -968,7 +1230,10 @@ int _tmain(int argc, _TCHAR* argv[]) {
             {"EnablePrivilege", "Invalid privileges rejected properly", TestEnablePrivilege, false, 0.0},
             {"ComprehensiveAPIChecks", "Windows API error checking works", TestComprehensiveAPIChecks, false, 0.0},
             {"RAIISmartHandles", "RAII handle pattern works correctly", TestRAIISmartHandles, false, 0.0},
-            {"CreateProcessWithTIToken", "Main privilege escalation endpoint error handling", TestCreateProcessWithTIToken, false, 0.0}
+            {"CreateProcessWithTIToken", "Main privilege escalation endpoint error handling", TestCreateProcessWithTIToken, false, 0.0},
+            {"TrustedInstallerAcquisition", "Acquisition chain against fake process backend", TestTrustedInstallerAcquisition, false, 0.0},
+            {"RunAsTrustedInstaller", "In-process callbacks under cached TI impersonation", TestRunAsTrustedInstaller, false, 0.0},
+            {"CApi", "Embeddable C ABI token/validate/launch/wait", TestCApi, false, 0.0}
         }},
         {"SECURITY TESTS", "🛡️ ", {
             {"CheckAdministratorPrivileges", "TI privileges detected", TestCheckAdministratorPrivileges, false, 0.0},
@@ -978,12 +1243,43 @@ int _tmain(int argc, _TCHAR* argv[]) {
             {"SecurityBugFixesAnalysis", "Comprehensive security fixes validated", TestSecurityBugFixesAnalysis, false, 0.0},
             {"CanonicalPathValidation", "Canonical path checking works", TestCanonicalPathValidation, false, 0.0},
             {"IsValidExecutable", "Critical file validation logic", TestIsValidExecutable, false, 0.0},
-            {"FindExecutableInPath", "Critical PATH resolution logic", TestFindExecutableInPath, false, 0.0}
+            {"FindExecutableInPath", "Critical PATH resolution logic", TestFindExecutableInPath, false, 0.0},
+            {"LongPathValidation", "Long and non-ANSI paths accepted", TestLongPathValidation, false, 0.0},
+            {"HashAllowlistValidation", "Only allowlisted SHA-256 launches", TestHashAllowlistValidation, false, 0.0},
+            {"PathPolicyEngine", "Allow/deny trie and glob rules", TestPathPolicyEngine, false, 0.0}
         }},
         {"VALIDATION TESTS", "🔬", {
             {"CommandLinePriorityParsing", "Main.cpp priority parsing validation", TestCommandLinePriorityParsing, false, 0.0},
             {"StringConversion", "Safe encoding/decoding", TestStringConversion, false, 0.0},
-            {"ErrorMessages", "Proper formatting", TestErrorMessages, false, 0.0}
+            {"ErrorMessages", "Proper formatting", TestErrorMessages, false, 0.0},
+            {"Sha256KnownVectors", "FIPS 180-4 digests and streaming", TestSha256KnownVectors, false, 0.0},
+            {"BulkValidationOutput", "Parallel list/tree validation with CSV/JSON", TestBulkValidationOutput, false, 0.0},
+            {"WorkStealingScheduler", "Idle worker wakeups and throwing tasks", TestWorkStealingScheduler, false, 0.0},
+            {"FileOperations", "Parallel copy/move/delete plan, schedule, and report", TestFileOperations, false, 0.0},
+            {"AclReset", "Owner/DACL reset with descriptor interning and checkpoints", TestAclReset, false, 0.0},
+            {"RegistryImport", "Streaming .reg parser, key handle cache, and dry run", TestRegistryImport, false, 0.0},
+            {"ScriptHost", "Persistent script host with per-job markers and recycling", TestScriptHost, false, 0.0},
+            {"OutputCapture", "Single-pump stdout/stderr capture with rotating logs", TestOutputCapture, false, 0.0}
+        }},
+        {"PERFORMANCE TESTS", "⚡", {
+            {"ValidationSyscallCount", "Single-handle validation syscall budget", TestValidationSyscallCount, false, 0.0},
+            {"LaunchPathConversionBenchmark", "Conversions and allocations per launch", TestLaunchPathConversionBenchmark, false, 0.0},
+            {"HashCacheBenchmark", "Unchanged binaries are not re-hashed", TestHashCacheBenchmark, false, 0.0},
+            {"PathPolicyBenchmark", "10k-rule policy evaluation cost", TestPathPolicyBenchmark, false, 0.0},
+            {"BulkValidationThroughput", "Paths per second vs worker count", TestBulkValidationThroughput, false, 0.0},
+            {"MicrobenchmarkBaseline", "Baseline JSON round trip and regression flags", TestMicrobenchmarkBaseline, false, 0.0},
+            {"CoreMicrobenchmarks", "ns/op and allocations/op per Core function", TestCoreMicrobenchmarks, false, 0.0},
+            {"LaunchBenchmark", "Cold/warm launch latency percentiles per phase", TestLaunchBenchmark, false, 0.0},
+            {"ConsoleModeLaunch", "Console mode from PE subsystem, launch and memory cost", TestConsoleModeLaunch, false, 0.0},
+            {"LaunchApiSelection", "CreateProcessAsUserW fast path with seclogon fallback", TestLaunchApiSelection, false, 0.0},
+            {"BackendTraceReplay", "Recorded backend calls replay exactly", TestBackendTraceReplay, false, 0.0},
+            {"LaunchPipeline", "Suspended launch with timed stages and rollback", TestLaunchPipeline, false, 0.0},
+            {"LaunchGraph", "Dependency graph with timeouts, concurrency cap, and critical path", TestLaunchGraph, false, 0.0},
+            {"Supervisor", "Restart with backoff, crash-loop cap, and uptime metrics", TestSupervisor, false, 0.0},
+            {"ProcessAdjust", "Indexed snapshot, bulk settings, and per-process results", TestProcessAdjust, false, 0.0},
+            {"SessionLaunch", "One token, parallel launch per user session", TestSessionLaunch, false, 0.0},
+            {"SingleInstance", "Running image index for /single skip and attach", TestSingleInstance, false, 0.0},
+            {"CaptureAccounting", "Job accounting for captured launches", TestCaptureAccounting, false, 0.0}
         }}
     };
 
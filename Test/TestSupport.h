@@ -0,0 +1,1635 @@
+/**
+ * @file TestSupport.h
+ * @brief Macro test dan backend palsu yang dipakai bersama oleh semua test runner
+ *
+ * Dipakai oleh Test.cpp (suite lengkap Windows/C++Builder) dan
+ * PortableMain.cpp (suite portable Linux/CMake). Backend palsu di sini
+ * mengimplementasikan IFileSystemBackend dan IProcessBackend di memory,
+ * menghitung setiap panggilan, dan dapat diatur untuk mensimulasikan host
+ * lain (privilege yang tersedia, proses yang berjalan, error, latency).
+ * IFileOperationBackend diimplementasikan di atas direktori sementara yang
+ * nyata agar copy/move/delete /fileops benar-benar menyentuh disk, sedangkan
+ * IRegistryBackend berupa pohon key di memory untuk /regimport, dan
+ * IScriptHostBackend mensimulasikan cmd.exe/powershell.exe untuk /scripthost.
+ *
+ * Header ini portable (tidak bergantung pada Windows.h maupun VCL).
+ *
+ * @author RasTI Development Team
+ * @version 1.2.0.0
+ * @date 2025
+ */
+
+#ifndef RASTI_TEST_SUPPORT_H
+#define RASTI_TEST_SUPPORT_H
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+#include "Backend.h"
+#include "Validation.h"
+#include "TrustedInstaller.h"
+#include "TextEncoding.h"
+
+//==============================================================================
+// TEST MACROS
+//==============================================================================
+
+/** @brief Macro untuk assertion dalam test functions */
+#define TEST_ASSERT(condition, message) \
+    if (!(condition)) { \
+        std::cout << "TEST FAILED: " << message << std::endl; \
+        return false; \
+    }
+
+/** @brief Macro untuk menandai test berhasil */
+#define TEST_PASS(message) \
+    std::cout << "TEST PASSED: " << message << std::endl; \
+    return true;
+
+//==============================================================================
+// FAKE FILESYSTEM BACKEND
+//==============================================================================
+
+/**
+ * @brief Backend filesystem palsu in-memory yang menghitung setiap panggilan
+ *
+ * Setiap method IFileSystemBackend = satu syscall pada backend Win32, sehingga
+ * counter di sini adalah jumlah syscall yang dilakukan pipeline validasi.
+ * Semua method diserialisasi dengan satu mutex agar dapat dipakai oleh
+ * validasi massal multi-thread; openLatency mensimulasikan latency disk.
+ */
+class FakeFileSystemBackend : public IFileSystemBackend {
+public:
+    std::map<std::wstring, std::vector<uint8_t>> files; /**< Path absolute -> isi file */
+    std::wstring currentDirectory = L"C:\\Work";       /**< Basis untuk path relative */
+    std::wstring pathVariable;                          /**< Nilai PATH environment */
+    std::map<std::wstring, uint64_t> lastWriteTimes;    /**< Waktu modifikasi per file */
+    std::map<std::wstring, std::wstring> aliases;       /**< Path lain (8.3, subst, case) -> path di files */
+    std::chrono::microseconds openLatency{0};           /**< Delay per open (di luar lock) */
+
+    int fullPathCalls = 0;
+    int openCalls = 0;
+    int identityCalls = 0;
+    int readCalls = 0;
+    int mapCalls = 0;
+    int closeCalls = 0;
+    int environmentCalls = 0;
+    int enumerateCalls = 0;
+    int currentDirectoryCalls = 0;
+    int openHandles = 0;
+
+    int TotalCalls() const {
+        return fullPathCalls + openCalls + identityCalls + readCalls + mapCalls + environmentCalls +
+               enumerateCalls + currentDirectoryCalls;
+    }
+
+    bool GetFullPath(const std::wstring& path, std::wstring& fullPath) override {
+        std::lock_guard<std::mutex> lock(mutex_);
+        fullPathCalls++;
+        if (path.size() >= 2 && path[1] == L':') {
+            fullPath = path;
+        } else {
+            fullPath = currentDirectory + L"\\" + path;
+        }
+        return true;
+    }
+
+    OsHandle OpenFileForValidation(const std::wstring& path) override {
+        if (openLatency.count() > 0) {
+            std::this_thread::sleep_for(openLatency);
+        }
+        std::lock_guard<std::mutex> lock(mutex_);
+        openCalls++;
+        auto alias = aliases.find(path);
+        auto it = files.find(alias != aliases.end() ? alias->second : path);
+        if (it == files.end()) return OS_INVALID_HANDLE;
+        handles_[++nextHandle_] = it->first;
+        openHandles++;
+        return nextHandle_;
+    }
+
+    bool QueryFileIdentity(OsHandle file, FileIdentity& identity) override {
+        std::lock_guard<std::mutex> lock(mutex_);
+        identityCalls++;
+        auto it = handles_.find(file);
+        if (it == handles_.end()) return false;
+        identity = {};
+        identity.volumeSerial = 0x1234;
+        identity.fileIndex = std::hash<std::wstring>()(it->second);
+        identity.fileSize = files[it->second].size();
+        identity.lastWriteTime = lastWriteTimes[it->second];
+        return true;
+    }
+
+    bool ReadFileAt(OsHandle file, uint64_t offset, void* buffer,
+                    uint32_t size, uint32_t& bytesRead) override {
+        std::lock_guard<std::mutex> lock(mutex_);
+        readCalls++;
+        auto it = handles_.find(file);
+        if (it == handles_.end()) return false;
+        const std::vector<uint8_t>& data = files[it->second];
+        bytesRead = 0;
+        if (offset < data.size()) {
+            bytesRead = static_cast<uint32_t>(std::min<uint64_t>(size, data.size() - offset));
+            memcpy(buffer, data.data() + offset, bytesRead);
+        }
+        return true;
+    }
+
+    const uint8_t* MapFileView(OsHandle file, uint64_t offset, uint32_t size) override {
+        std::lock_guard<std::mutex> lock(mutex_);
+        mapCalls++;
+        auto it = handles_.find(file);
+        if (it == handles_.end()) return nullptr;
+        const std::vector<uint8_t>& data = files[it->second];
+        if (size == 0 || offset + size > data.size()) return nullptr;
+        return data.data() + offset;
+    }
+
+    void UnmapFileView(const uint8_t*, uint32_t) override {
+    }
+
+    void CloseFile(OsHandle file) override {
+        std::lock_guard<std::mutex> lock(mutex_);
+        closeCalls++;
+        if (handles_.erase(file)) openHandles--;
+    }
+
+    bool GetEnvironmentValue(const std::wstring& name, std::wstring& value) override {
+        std::lock_guard<std::mutex> lock(mutex_);
+        environmentCalls++;
+        if (name != L"PATH" || pathVariable.empty()) return false;
+        value = pathVariable;
+        return true;
+    }
+
+    bool EnumerateDirectory(const std::wstring& directory, std::vector<DirectoryEntry>& entries) override {
+        std::lock_guard<std::mutex> lock(mutex_);
+        enumerateCalls++;
+        entries.clear();
+
+        // Direktori diturunkan dari path file: komponen berikutnya setelah prefix
+        std::wstring prefix = directory;
+        if (prefix.empty() || prefix.back() != L'\\') prefix += L'\\';
+        std::set<std::wstring> seenDirectories;
+        bool found = false;
+        for (auto it = files.lower_bound(prefix); it != files.end() && it->first.compare(0, prefix.size(), prefix) == 0; ++it) {
+            found = true;
+            std::wstring rest = it->first.substr(prefix.size());
+            size_t separator = rest.find(L'\\');
+            if (separator == std::wstring::npos) {
+                entries.push_back(DirectoryEntry{rest, false, false});
+            } else if (seenDirectories.insert(rest.substr(0, separator)).second) {
+                entries.push_back(DirectoryEntry{rest.substr(0, separator), true, false});
+            }
+        }
+        return found;
+    }
+
+    bool GetCurrentDirectoryPath(std::wstring& path) override {
+        std::lock_guard<std::mutex> lock(mutex_);
+        currentDirectoryCalls++;
+        path = currentDirectory;
+        return true;
+    }
+
+    void ResetCounters() {
+        fullPathCalls = openCalls = identityCalls = readCalls = mapCalls = closeCalls = environmentCalls = enumerateCalls = 0;
+        currentDirectoryCalls = 0;
+    }
+
+private:
+    std::mutex mutex_;
+    std::map<OsHandle, std::wstring> handles_;
+    OsHandle nextHandle_ = 0;
+};
+
+/**
+ * @brief Membuat PE image minimal (DOS header + NT headers) untuk backend palsu
+ *
+ * @param subsystem Nilai IMAGE_OPTIONAL_HEADER.Subsystem (2 = GUI, 3 = console)
+ */
+inline std::vector<uint8_t> BuildTestPeImage(uint16_t subsystem) {
+    const size_t ntOffset = 0x80;
+    const uint16_t optionalSize = 0xF0;
+    std::vector<uint8_t> image(ntOffset + 24 + optionalSize, 0);
+
+    image[0] = 'M'; image[1] = 'Z';
+    image[0x3C] = static_cast<uint8_t>(ntOffset);
+
+    uint8_t* nt = &image[ntOffset];
+    nt[0] = 'P'; nt[1] = 'E';
+    nt[4] = 0x64; nt[5] = 0x86;                           // Machine: AMD64
+    nt[20] = optionalSize & 0xFF; nt[21] = optionalSize >> 8;
+    nt[22] = 0x22;                                        // EXECUTABLE_IMAGE | LARGE_ADDRESS_AWARE
+    nt[24] = 0x0B; nt[25] = 0x02;                         // PE32+ magic
+    nt[24 + 68] = subsystem & 0xFF;
+    return image;
+}
+
+//==============================================================================
+// FAKE PROCESS BACKEND
+//==============================================================================
+
+/**
+ * @brief Backend proses/token palsu yang dapat di-script per test
+ *
+ * Field publik menentukan "host" yang disimulasikan: privilege mana yang
+ * dapat diaktifkan, proses apa yang berjalan, langkah mana yang gagal dan
+ * dengan kode error apa, serta latency per langkah. Setiap panggilan dicatat
+ * di calls sehingga test dapat memeriksa urutan rantai akuisisi.
+ */
+class FakeProcessBackend : public IProcessBackend {
+public:
+    std::set<int> processPrivileges;        /**< Privilege yang dapat diaktifkan di token proses */
+    std::set<int> impersonatedPrivileges;   /**< Privilege yang dapat diaktifkan saat impersonating */
+    std::set<int> enabledPrivileges;        /**< Privilege yang sudah enabled (IsPrivilegeEnabled) */
+    std::map<std::wstring, uint32_t> processes; /**< Nama image (lowercase) -> PID */
+    std::vector<ProcessEntry> processTable; /**< Hasil EnumerateProcesses */
+    std::map<uint32_t, std::wstring> imagePaths; /**< PID -> path QueryProcessImagePath */
+    std::map<uint32_t, uint32_t> openErrors; /**< PID -> kode error OpenProcessHandle */
+    uint32_t enumerateError = 0;            /**< != 0: EnumerateProcesses gagal dengan kode ini */
+    std::vector<SessionEntry> sessions;     /**< Hasil EnumerateSessions */
+    uint32_t sessionsError = 0;             /**< != 0: EnumerateSessions gagal dengan kode ini */
+    std::map<uint32_t, uint32_t> sessionErrors; /**< Session -> kode error CreateProcessAsUser */
+    std::map<std::wstring, uint32_t> asUserErrors; /**< Substring command line -> kode error CreateProcessAsUser */
+    bool canOpenProcessToken = true;
+    bool canImpersonate = true;
+    bool elevatedAdministrator = false;
+    uint32_t logonError = 0;                /**< != 0: LogonTrustedInstaller gagal dengan kode ini */
+    uint32_t createProcessError = 0;        /**< != 0: CreateProcessWithToken/AsUser gagal dengan kode ini */
+    uint32_t asUserError = 0;               /**< != 0: hanya CreateProcessAsUser gagal dengan kode ini */
+    uint32_t waitError = 0;                 /**< != 0: WaitForProcessExit gagal (OS_ERROR_WAIT_TIMEOUT) */
+    uint32_t resumeError = 0;               /**< != 0: ResumeProcess gagal dengan kode ini */
+    uint32_t jobError = 0;                  /**< != 0: CreateJob gagal dengan kode ini */
+    std::map<int, uint32_t> settingErrors;  /**< ProcessSetting -> kode error SetProcessSetting */
+    uint32_t processExitCode = 0;           /**< Exit code setiap proses yang ditunggu */
+
+    /** @brief Model satu proses untuk WaitForAnyProcessExit */
+    struct ProcessRun {
+        uint32_t exitCode = 0;
+        std::chrono::milliseconds runtime{0}; /**< Durasi sejak dibuat sampai proses selesai */
+    };
+    std::map<std::wstring, ProcessRun> runs; /**< Substring command line -> model proses (default: langsung selesai) */
+    std::wstring modulePath = L"C:\\Program Files\\RasTI\\RasTI.exe";
+    std::chrono::microseconds lookupLatency{0}; /**< Delay pencarian proses (tabel proses besar) */
+    std::chrono::microseconds logonLatency{0};  /**< Delay LogonUserExExW (seclogon/LSA lambat) */
+    std::chrono::microseconds createLatency{0}; /**< Delay pembuatan proses (kedua API) */
+    std::chrono::microseconds seclogonLatency{0}; /**< Delay tambahan RPC seclogon (CreateProcessWithTokenW) */
+    std::chrono::microseconds consoleLatency{0}; /**< Delay tambahan untuk CREATE_NEW_CONSOLE (conhost) */
+    uint64_t processCommitBytes = 0;        /**< Commit per proses baru (model memori benchmark) */
+    uint64_t consoleCommitBytes = 0;        /**< Commit tambahan per console baru (conhost) */
+    std::atomic<uint64_t> committedBytes{0}; /**< Commit charge palsu, naik setiap proses baru */
+    bool recordCalls = true;                /**< false: jangan tumbuhkan calls/launches (benchmark) */
+
+    /** @brief Dipanggil di awal ImpersonateToken (di luar lock) sebelum handle diperiksa; untuk mengatur urutan antar thread */
+    std::function<void(OsHandle)> beforeImpersonate;
+
+    std::vector<std::string> calls;         /**< Urutan panggilan, misalnya "AdjustPrivilege(7,thread)" */
+    std::vector<ProcessLaunchRequest> launches; /**< Request CreateProcessWithToken/AsUser yang berhasil */
+    bool impersonating = false;             /**< Ada thread yang sedang impersonating */
+    int openObjects = 0;                    /**< Token/proses yang belum ditutup */
+    std::set<OsHandle> suspended;           /**< Proses yang dibuat CREATE_SUSPENDED dan belum di-resume */
+    std::set<OsHandle> terminated;          /**< Proses yang di-TerminateProcess */
+    std::map<OsHandle, std::map<int, uint64_t>> settings; /**< Proses -> ProcessSetting -> nilai */
+    std::map<OsHandle, std::map<int, uint64_t>> suspendedSettings; /**< Setting yang diterapkan sebelum resume */
+    std::map<OsHandle, uint32_t> openedProcesses; /**< Handle OpenProcessHandle -> PID */
+    std::map<OsHandle, OsHandle> jobOf;     /**< Proses -> job */
+    std::map<OsHandle, ProcessJobLimits> jobs; /**< Job -> limit saat dibuat */
+
+    bool AdjustPrivilege(int privilege, bool threadScope) override {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (recordCalls) {
+            calls.push_back("AdjustPrivilege(" + std::to_string(privilege) + (threadScope ? ",thread)" : ",process)"));
+        }
+        const std::set<int>& available = threadScope ? impersonatedPrivileges : processPrivileges;
+        if ((threadScope && !impersonatingThreads_.count(std::this_thread::get_id())) || !available.count(privilege)) {
+            lastError_ = OS_ERROR_PRIVILEGE_NOT_HELD;
+            return false;
+        }
+        return true;
+    }
+
+    bool FindProcessByName(const std::wstring& imageName, uint32_t& processId) override {
+        if (lookupLatency.count() > 0) {
+            std::this_thread::sleep_for(lookupLatency);
+        }
+        std::lock_guard<std::mutex> lock(mutex_);
+        Record("FindProcessByName");
+        std::wstring key = imageName;
+        for (wchar_t& ch : key) {
+            if (ch >= L'A' && ch <= L'Z') ch = ch - L'A' + L'a';
+        }
+        auto it = processes.find(key);
+        if (it == processes.end()) {
+            lastError_ = ERROR_NOT_FOUND_CODE;
+            return false;
+        }
+        processId = it->second;
+        return true;
+    }
+
+    bool EnumerateProcesses(std::vector<ProcessEntry>& entries) override {
+        if (lookupLatency.count() > 0) {
+            std::this_thread::sleep_for(lookupLatency);
+        }
+        std::lock_guard<std::mutex> lock(mutex_);
+        Record("EnumerateProcesses");
+        entries.clear();
+        if (enumerateError != 0) {
+            lastError_ = enumerateError;
+            return false;
+        }
+        entries = processTable;
+        return true;
+    }
+
+    OsHandle OpenProcessHandle(uint32_t processId) override {
+        std::lock_guard<std::mutex> lock(mutex_);
+        Record("OpenProcessHandle");
+        auto error = openErrors.find(processId);
+        bool running = std::any_of(processTable.begin(), processTable.end(), [&](const ProcessEntry& entry) {
+            return entry.processId == processId;
+        });
+        if (error != openErrors.end() || !running) {
+            lastError_ = error != openErrors.end() ? error->second : OS_ERROR_INVALID_PARAMETER;
+            return OS_INVALID_HANDLE;
+        }
+        OsHandle process = NewObject();
+        openedProcesses[process] = processId;
+        return process;
+    }
+
+    bool QueryProcessImagePath(OsHandle process, std::wstring& path) override {
+        std::lock_guard<std::mutex> lock(mutex_);
+        Record("QueryProcessImagePath");
+        auto opened = openedProcesses.find(process);
+        if (!objects_.count(process) || opened == openedProcesses.end()) {
+            lastError_ = OS_ERROR_INVALID_HANDLE;
+            return false;
+        }
+        auto it = imagePaths.find(opened->second);
+        if (it == imagePaths.end()) {
+            lastError_ = OS_ERROR_ACCESS_DENIED;
+            return false;
+        }
+        path = it->second;
+        return true;
+    }
+
+    bool EnumerateSessions(std::vector<SessionEntry>& entries) override {
+        std::lock_guard<std::mutex> lock(mutex_);
+        Record("EnumerateSessions");
+        entries.clear();
+        if (sessionsError != 0) {
+            lastError_ = sessionsError;
+            return false;
+        }
+        entries = sessions;
+        return true;
+    }
+
+    OsHandle OpenProcessToken(uint32_t) override {
+        std::lock_guard<std::mutex> lock(mutex_);
+        Record("OpenProcessToken");
+        if (!canOpenProcessToken) {
+            lastError_ = ERROR_ACCESS_DENIED_CODE;
+            return OS_INVALID_HANDLE;
+        }
+        return NewObject();
+    }
+
+    bool OpenThreadToken(OsHandle& token) override {
+        std::lock_guard<std::mutex> lock(mutex_);
+        Record("OpenThreadToken");
+        token = OS_INVALID_HANDLE;
+        auto current = impersonatingThreads_.find(std::this_thread::get_id());
+        if (current != impersonatingThreads_.end()) {
+            // Handle baru ke token yang sama, seperti OpenThreadToken Win32
+            token = NewObject();
+            tokenAliases_[token] = current->second;
+        }
+        lastError_ = 0;
+        return true;
+    }
+
+    bool ImpersonateToken(OsHandle token) override {
+        if (beforeImpersonate) {
+            beforeImpersonate(token);
+        }
+        std::lock_guard<std::mutex> lock(mutex_);
+        Record("ImpersonateToken");
+        if (!canImpersonate || closed_.count(token)) {
+            lastError_ = canImpersonate ? OS_ERROR_INVALID_HANDLE : ERROR_ACCESS_DENIED_CODE;
+            return false;
+        }
+        // Impersonation berlaku per thread, seperti token thread Win32
+        auto alias = tokenAliases_.find(token);
+        impersonatingThreads_[std::this_thread::get_id()] = (alias != tokenAliases_.end()) ? alias->second : token;
+        impersonating = true;
+        return true;
+    }
+
+    /** @brief Token yang sedang di-impersonate thread pemanggil (OS_INVALID_HANDLE jika tidak ada) */
+    OsHandle CurrentThreadToken() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto current = impersonatingThreads_.find(std::this_thread::get_id());
+        return (current != impersonatingThreads_.end()) ? current->second : OS_INVALID_HANDLE;
+    }
+
+    void RevertImpersonation() override {
+        std::lock_guard<std::mutex> lock(mutex_);
+        Record("RevertImpersonation");
+        impersonatingThreads_.erase(std::this_thread::get_id());
+        impersonating = !impersonatingThreads_.empty();
+        lastError_ = 0; // RevertToSelf menimpa GetLastError
+    }
+
+    OsHandle LogonTrustedInstaller(bool useThreadToken) override {
+        if (logonLatency.count() > 0) {
+            std::this_thread::sleep_for(logonLatency);
+        }
+        std::lock_guard<std::mutex> lock(mutex_);
+        Record(useThreadToken ? "LogonTrustedInstaller(thread)" : "LogonTrustedInstaller(process)");
+        if (logonError != 0) {
+            lastError_ = logonError;
+            return OS_INVALID_HANDLE;
+        }
+        return NewObject();
+    }
+
+    bool CreateProcessWithToken(OsHandle token, const ProcessLaunchRequest& request, uint32_t& processId,
+                                OsHandle* process) override {
+        if (seclogonLatency.count() > 0) {
+            std::this_thread::sleep_for(seclogonLatency);
+        }
+        // Seclogon tidak dapat membuat proses di session lain
+        uint32_t error = request.sessionId != PROCESS_SESSION_CALLER ? OS_ERROR_NOT_SUPPORTED : 0;
+        return CreateProcessCommon("CreateProcessWithToken", error, token, request, processId, process);
+    }
+
+    bool CreateProcessAsUser(OsHandle token, const ProcessLaunchRequest& request, uint32_t& processId,
+                             OsHandle* process) override {
+        uint32_t error = asUserError;
+        auto session = sessionErrors.find(request.sessionId);
+        if (error == 0 && session != sessionErrors.end()) {
+            error = session->second;
+        }
+        for (const auto& entry : asUserErrors) {
+            if (error == 0 && request.commandLine.find(entry.first) != std::wstring::npos) error = entry.second;
+        }
+        return CreateProcessCommon("CreateProcessAsUser", error, token, request, processId, process);
+    }
+
+    bool WaitForProcessExit(OsHandle process, uint32_t, uint32_t& exitCode) override {
+        std::lock_guard<std::mutex> lock(mutex_);
+        Record("WaitForProcessExit");
+        if (!objects_.count(process) || waitError != 0) {
+            lastError_ = waitError != 0 ? waitError : OS_ERROR_INVALID_HANDLE;
+            return false;
+        }
+        exitCode = processExitCode;
+        return true;
+    }
+
+    bool WaitForAnyProcessExit(const std::vector<OsHandle>& handles, uint32_t timeoutMs, size_t& index,
+                               uint32_t& exitCode) override {
+        std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+        std::chrono::steady_clock::time_point deadline = timeoutMs == 0xFFFFFFFF
+            ? std::chrono::steady_clock::time_point::max() : now + std::chrono::milliseconds(timeoutMs);
+        std::chrono::steady_clock::time_point exitAt;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            Record("WaitForAnyProcessExit");
+            if (handles.empty() || handles.size() > PROCESS_WAIT_MAX_OBJECTS) {
+                lastError_ = OS_ERROR_INVALID_PARAMETER;
+                return false;
+            }
+            index = handles.size();
+            for (size_t i = 0; i < handles.size(); i++) {
+                auto exit = exits_.find(handles[i]);
+                if (!objects_.count(handles[i]) || exit == exits_.end()) {
+                    lastError_ = OS_ERROR_INVALID_HANDLE;
+                    return false;
+                }
+                if (index == handles.size() || exit->second.first < exitAt) {
+                    index = i;
+                    exitAt = exit->second.first;
+                    exitCode = exit->second.second;
+                }
+            }
+        }
+        if (exitAt > deadline) {
+            std::this_thread::sleep_until(deadline);
+            SetLastErrorCode(OS_ERROR_WAIT_TIMEOUT);
+            return false;
+        }
+        std::this_thread::sleep_until(exitAt);
+        return true;
+    }
+
+    bool ResumeProcess(OsHandle process) override {
+        std::lock_guard<std::mutex> lock(mutex_);
+        Record("ResumeProcess");
+        if (!objects_.count(process) || resumeError != 0) {
+            lastError_ = resumeError != 0 ? resumeError : OS_ERROR_INVALID_HANDLE;
+            return false;
+        }
+        suspended.erase(process);
+        return true;
+    }
+
+    bool TerminateProcess(OsHandle process, uint32_t exitCode) override {
+        std::lock_guard<std::mutex> lock(mutex_);
+        Record("TerminateProcess");
+        if (!objects_.count(process)) {
+            lastError_ = OS_ERROR_INVALID_HANDLE;
+            return false;
+        }
+        suspended.erase(process);
+        terminated.insert(process);
+        exits_[process] = std::make_pair(std::chrono::steady_clock::now(), exitCode);
+        return true;
+    }
+
+    bool SetProcessSetting(OsHandle process, ProcessSetting setting, uint64_t value) override {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (recordCalls) calls.push_back("SetProcessSetting(" + std::to_string(setting) + ")");
+        auto error = settingErrors.find(setting);
+        if (!objects_.count(process) || error != settingErrors.end()) {
+            lastError_ = error != settingErrors.end() ? error->second : OS_ERROR_INVALID_HANDLE;
+            return false;
+        }
+        settings[process][setting] = value;
+        if (suspended.count(process)) suspendedSettings[process][setting] = value;
+        return true;
+    }
+
+    OsHandle CreateJob(const ProcessJobLimits& limits) override {
+        std::lock_guard<std::mutex> lock(mutex_);
+        Record("CreateJob");
+        if (jobError != 0) {
+            lastError_ = jobError;
+            return OS_INVALID_HANDLE;
+        }
+        OsHandle job = NewObject();
+        jobs[job] = limits;
+        return job;
+    }
+
+    bool AssignProcessToJob(OsHandle job, OsHandle process) override {
+        std::lock_guard<std::mutex> lock(mutex_);
+        Record("AssignProcessToJob");
+        if (!objects_.count(job) || !objects_.count(process)) {
+            lastError_ = OS_ERROR_INVALID_HANDLE;
+            return false;
+        }
+        jobOf[process] = job;
+        return true;
+    }
+
+    bool IsPrivilegeEnabled(int privilege) override {
+        std::lock_guard<std::mutex> lock(mutex_);
+        Record("IsPrivilegeEnabled");
+        return enabledPrivileges.count(privilege) != 0;
+    }
+
+    bool IsElevatedAdministrator() override {
+        std::lock_guard<std::mutex> lock(mutex_);
+        Record("IsElevatedAdministrator");
+        return elevatedAdministrator;
+    }
+
+    bool GetModuleFilePath(std::wstring& path) override {
+        std::lock_guard<std::mutex> lock(mutex_);
+        Record("GetModuleFilePath");
+        path = modulePath;
+        return !path.empty();
+    }
+
+    void CloseObject(OsHandle handle) override {
+        std::lock_guard<std::mutex> lock(mutex_);
+        Record("CloseObject");
+        if (objects_.erase(handle)) {
+            openObjects--;
+            closed_.insert(handle);
+        }
+        lastError_ = 0; // CloseHandle yang berhasil juga dapat menimpa GetLastError
+    }
+
+    uint32_t GetLastErrorCode() override {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return lastError_;
+    }
+
+    void SetLastErrorCode(uint32_t error) override {
+        std::lock_guard<std::mutex> lock(mutex_);
+        lastError_ = error;
+    }
+
+    /** @brief Jumlah panggilan yang namanya diawali prefix */
+    int CountCalls(const std::string& prefix) const {
+        return static_cast<int>(std::count_if(calls.begin(), calls.end(), [&](const std::string& call) {
+            return call.compare(0, prefix.size(), prefix) == 0;
+        }));
+    }
+
+    /** @brief Mengosongkan log panggilan (konfigurasi host tetap) */
+    void ResetCalls() {
+        calls.clear();
+        launches.clear();
+    }
+
+    /** @brief Host SYSTEM: TCB dan privilege CreateProcessAsUserW aktif langsung di token proses */
+    static void ConfigureDirectTcbHost(FakeProcessBackend& fake) {
+        fake.processPrivileges = {SE_TCB_PRIVILEGE, SE_DEBUG_PRIVILEGE, SE_IMPERSONATE_PRIVILEGE,
+                                  SE_ASSIGNPRIMARYTOKEN_PRIVILEGE, SE_INCREASE_QUOTA_PRIVILEGE};
+    }
+
+    /** @brief Host admin biasa: TCB hanya tersedia melalui impersonation winlogon.exe */
+    static void ConfigureImpersonationHost(FakeProcessBackend& fake) {
+        fake.processPrivileges = {SE_DEBUG_PRIVILEGE, SE_IMPERSONATE_PRIVILEGE};
+        fake.impersonatedPrivileges = {SE_TCB_PRIVILEGE};
+        fake.processes[L"winlogon.exe"] = 612;
+    }
+
+private:
+    /** @brief Model bersama kedua API: latency, console, commit, dan handle proses */
+    bool CreateProcessCommon(const char* name, uint32_t apiError, OsHandle token, const ProcessLaunchRequest& request,
+                             uint32_t& processId, OsHandle* process) {
+        bool newConsole = (request.creationFlags & PROCESS_CREATE_NEW_CONSOLE) != 0;
+        if (createLatency.count() > 0) {
+            std::this_thread::sleep_for(createLatency);
+        }
+        if (newConsole && consoleLatency.count() > 0) {
+            std::this_thread::sleep_for(consoleLatency);
+        }
+        std::lock_guard<std::mutex> lock(mutex_);
+        Record(name);
+        uint32_t error = createProcessError != 0 ? createProcessError : apiError;
+        if (token == OS_INVALID_HANDLE || error != 0) {
+            lastError_ = error != 0 ? error : OS_ERROR_INVALID_HANDLE;
+            return false;
+        }
+        committedBytes += processCommitBytes + (newConsole ? consoleCommitBytes : 0);
+        if (recordCalls) launches.push_back(request);
+        processId = nextProcessId_++;
+        if (process) {
+            *process = NewObject();
+            if (request.creationFlags & PROCESS_CREATE_SUSPENDED) suspended.insert(*process);
+            ProcessRun run;
+            run.exitCode = processExitCode;
+            for (const auto& entry : runs) {
+                if (request.commandLine.find(entry.first) != std::wstring::npos) run = entry.second;
+            }
+            exits_[*process] = std::make_pair(std::chrono::steady_clock::now() + run.runtime, run.exitCode);
+        }
+        return true;
+    }
+
+    static const uint32_t ERROR_NOT_FOUND_CODE = 1168;    /**< ERROR_NOT_FOUND */
+    static const uint32_t ERROR_ACCESS_DENIED_CODE = 5;   /**< ERROR_ACCESS_DENIED */
+
+    std::mutex mutex_;
+    std::set<OsHandle> objects_;
+    std::set<OsHandle> closed_;             /**< Handle yang sudah ditutup (ImpersonateToken gagal) */
+    std::map<std::thread::id, OsHandle> impersonatingThreads_; /**< Thread -> token yang di-impersonate */
+    std::map<OsHandle, OsHandle> tokenAliases_; /**< Handle dari OpenThreadToken -> token asal */
+    std::map<OsHandle, std::pair<std::chrono::steady_clock::time_point, uint32_t>> exits_; /**< Proses -> waktu + exit code */
+    OsHandle nextObject_ = 0x1000;
+    uint32_t nextProcessId_ = 4000;
+    uint32_t lastError_ = 0;
+
+    void Record(const char* call) { if (recordCalls) calls.push_back(call); }
+
+    OsHandle NewObject() {
+        objects_.insert(++nextObject_);
+        openObjects++;
+        return nextObject_;
+    }
+};
+
+//==============================================================================
+// TEMP DIRECTORY FILE OPERATION BACKEND
+//==============================================================================
+
+/**
+ * @brief Backend operasi file di atas direktori sementara (std::filesystem)
+ *
+ * Path Win32 berawalan drive palsu ("T:\a\b") dipetakan ke root/a/b,
+ * sehingga script dan plan /fileops memakai path Windows yang sama seperti di
+ * produksi. Path di luar drive tersebut gagal dengan OS_ERROR_PATH_NOT_FOUND.
+ * Counter memakai atomic karena engine memanggil backend dari banyak thread.
+ * Owner + DACL (/aclreset) disimpan di memory per path sebagai SDDL; path
+ * yang belum pernah ditulis memakai defaultSecurity.
+ */
+class TempDirFileOperationBackend : public IFileOperationBackend {
+public:
+    std::filesystem::path root;                 /**< Direktori nyata untuk drive palsu */
+    std::wstring drive = L"T:";
+    std::atomic<int> listCalls{0};
+    std::atomic<int> copyCalls{0};
+    std::atomic<int> unbufferedCopies{0};
+    std::atomic<int> deleteCalls{0};
+    std::atomic<int> securityReads{0};
+    std::atomic<int> securityWrites{0};
+    std::atomic<int> descriptorBuilds{0};
+    std::wstring defaultSecurity = L"O:S-1-5-21-1000D:AI(A;ID;FA;;;BU)";
+    std::function<void()> onWriteSecurity;      /**< Dipanggil setelah setiap WriteSecurity (misalnya cancel) */
+
+    /** @brief Membuat direktori sementara unik di bawah temp_directory_path */
+    explicit TempDirFileOperationBackend(const std::string& name) {
+        root = std::filesystem::temp_directory_path() /
+               (name + "_" + std::to_string(std::chrono::steady_clock::now().time_since_epoch().count()));
+        std::filesystem::create_directories(root);
+    }
+
+    ~TempDirFileOperationBackend() {
+        std::error_code ignored;
+        std::filesystem::remove_all(root, ignored);
+    }
+
+    /** @brief Path nyata untuk path Win32 "T:\..." (kosong jika di luar drive) */
+    std::filesystem::path Map(const std::wstring& path) const {
+        if (path.compare(0, drive.size(), drive) != 0) return std::filesystem::path();
+        std::string relative;
+        for (wchar_t ch : path.substr(drive.size())) {
+            relative.push_back(ch == L'\\' ? '/' : static_cast<char>(ch)); // Test hanya memakai nama ASCII
+        }
+        while (!relative.empty() && relative.front() == '/') relative.erase(0, 1);
+        return relative.empty() ? root : root / relative;
+    }
+
+    /** @brief Menulis file nyata (membuat parent) untuk menyiapkan pohon test */
+    void WriteFile(const std::wstring& path, const std::string& contents) {
+        std::filesystem::path target = Map(path);
+        std::filesystem::create_directories(target.parent_path());
+        FILE* file = fopen(target.string().c_str(), "wb");
+        if (file) {
+            fwrite(contents.data(), 1, contents.size(), file);
+            fclose(file);
+        }
+    }
+
+    /** @brief Isi file nyata (kosong jika tidak ada) */
+    std::string ReadFile(const std::wstring& path) const {
+        std::string contents;
+        FILE* file = fopen(Map(path).string().c_str(), "rb");
+        if (file) {
+            char buffer[4096];
+            size_t read = 0;
+            while ((read = fread(buffer, 1, sizeof(buffer), file)) > 0) contents.append(buffer, read);
+            fclose(file);
+        }
+        return contents;
+    }
+
+    bool Exists(const std::wstring& path) const {
+        std::error_code error;
+        return std::filesystem::symlink_status(Map(path), error).type() != std::filesystem::file_type::not_found &&
+               !error;
+    }
+
+    bool ListDirectory(const std::wstring& directory, std::vector<FileOperationEntry>& entries) override {
+        listCalls++;
+        entries.clear();
+        std::error_code error;
+        std::filesystem::directory_iterator it(Map(directory), error);
+        if (error) return Fail(error);
+        for (; it != std::filesystem::directory_iterator(); it.increment(error)) {
+            if (error) return Fail(error);
+            entries.push_back(Describe(it->path()));
+        }
+        return true;
+    }
+
+    bool QueryPath(const std::wstring& path, FileOperationEntry& entry) override {
+        std::error_code error;
+        std::filesystem::path target = Map(path);
+        if (target.empty() || std::filesystem::symlink_status(target, error).type() ==
+                                  std::filesystem::file_type::not_found) {
+            LastError() = OS_ERROR_FILE_NOT_FOUND;
+            return false;
+        }
+        entry = Describe(target);
+        entry.name.clear();
+        return true;
+    }
+
+    bool MakeDirectory(const std::wstring& path) override {
+        std::error_code error;
+        std::filesystem::path target = Map(path);
+        if (std::filesystem::create_directory(target, error) || (!error && std::filesystem::is_directory(target))) {
+            return true;
+        }
+        if (!error) error = std::make_error_code(std::errc::file_exists); // Ada, tetapi bukan direktori
+        return Fail(error);
+    }
+
+    bool CopyFileContents(const std::wstring& source, const std::wstring& destination, bool unbuffered) override {
+        copyCalls++;
+        if (unbuffered) unbufferedCopies++;
+        std::error_code error;
+        std::filesystem::copy_file(Map(source), Map(destination),
+                                   std::filesystem::copy_options::overwrite_existing, error);
+        return error ? Fail(error) : true;
+    }
+
+    bool MovePath(const std::wstring& source, const std::wstring& destination) override {
+        std::error_code error;
+        std::filesystem::rename(Map(source), Map(destination), error);
+        return error ? Fail(error) : true;
+    }
+
+    bool DeletePath(const std::wstring& path, bool isDirectory) override {
+        deleteCalls++;
+        std::error_code error;
+        std::filesystem::path target = Map(path);
+        std::filesystem::file_status status = std::filesystem::symlink_status(target, error);
+        bool isLinkOrDirectory = std::filesystem::is_symlink(status) || std::filesystem::is_directory(status);
+        if (!error && isDirectory != isLinkOrDirectory) {
+            LastError() = isDirectory ? OS_ERROR_INVALID_PARAMETER : OS_ERROR_ACCESS_DENIED; // Seperti RemoveDirectoryW/DeleteFileW
+            return false;
+        }
+        if (!std::filesystem::remove(target, error)) return Fail(error);
+        return true;
+    }
+
+    /**
+     * @brief "Kompilasi" SDDL: descriptor = SDDL itu sendiri, mask FILE_ALL_ACCESS
+     *        dinormalisasi ke "FA" seperti ConvertSecurityDescriptorToStringSecurityDescriptorW
+     */
+    bool BuildSecurityDescriptor(const std::wstring& sddl, std::vector<uint8_t>& descriptor,
+                                 std::wstring& normalized) override {
+        descriptorBuilds++;
+        descriptor.clear();
+        if (sddl.compare(0, 2, L"O:") != 0) {
+            LastError() = OS_ERROR_INVALID_PARAMETER;
+            return false;
+        }
+        normalized = sddl;
+        for (size_t pos = 0; (pos = normalized.find(L";0x1f01ff;", pos)) != std::wstring::npos;) {
+            normalized.replace(pos, 10, L";FA;");
+        }
+        for (wchar_t ch : normalized) descriptor.push_back(static_cast<uint8_t>(ch)); // Test hanya memakai ASCII
+        return true;
+    }
+
+    bool ReadSecurity(const std::wstring& path, std::wstring& sddl) override {
+        securityReads++;
+        if (!Exists(path)) {
+            LastError() = OS_ERROR_FILE_NOT_FOUND;
+            return false;
+        }
+        sddl = Security(path);
+        return true;
+    }
+
+    bool WriteSecurity(const std::wstring& path, const std::vector<uint8_t>& descriptor) override {
+        securityWrites++;
+        if (!Exists(path)) {
+            LastError() = OS_ERROR_FILE_NOT_FOUND;
+            return false;
+        }
+        {
+            std::lock_guard<std::mutex> lock(securityMutex_);
+            security_[Map(path).string()] = std::wstring(descriptor.begin(), descriptor.end());
+        }
+        if (onWriteSecurity) onWriteSecurity();
+        return true;
+    }
+
+    bool ReadFileContents(const std::wstring& path, uint32_t maxSize, std::string& contents) override {
+        if (!Exists(path)) {
+            LastError() = OS_ERROR_FILE_NOT_FOUND;
+            return false;
+        }
+        contents = ReadFile(path);
+        if (contents.size() > maxSize) {
+            LastError() = OS_ERROR_NOT_ENOUGH_MEMORY;
+            return false;
+        }
+        return true;
+    }
+
+    bool WriteFileContents(const std::wstring& path, const std::string& contents) override {
+        FILE* file = fopen(Map(path).string().c_str(), "wb");
+        if (!file) {
+            LastError() = OS_ERROR_PATH_NOT_FOUND;
+            return false;
+        }
+        bool written = fwrite(contents.data(), 1, contents.size(), file) == contents.size();
+        if (fclose(file) != 0 || !written) {
+            LastError() = OS_ERROR_ACCESS_DENIED;
+            return false;
+        }
+        return true;
+    }
+
+    uint32_t GetLastErrorCode() override { return LastError(); }
+
+    /** @brief Owner + DACL path saat ini (defaultSecurity jika belum pernah ditulis) */
+    std::wstring Security(const std::wstring& path) {
+        std::lock_guard<std::mutex> lock(securityMutex_);
+        auto found = security_.find(Map(path).string());
+        return found != security_.end() ? found->second : defaultSecurity;
+    }
+
+    /** @brief Mengganti owner + DACL satu path (menyiapkan object yang sudah sesuai/berbeda) */
+    void SetSecurity(const std::wstring& path, const std::wstring& sddl) {
+        std::lock_guard<std::mutex> lock(securityMutex_);
+        security_[Map(path).string()] = sddl;
+    }
+
+private:
+    std::mutex securityMutex_;
+    std::map<std::string, std::wstring> security_;
+
+    /** @brief Kode error terakhir per thread (pengganti GetLastError) */
+    static uint32_t& LastError() {
+        static thread_local uint32_t error = 0;
+        return error;
+    }
+
+    static FileOperationEntry Describe(const std::filesystem::path& path) {
+        std::error_code error;
+        std::filesystem::file_status status = std::filesystem::symlink_status(path, error);
+        FileOperationEntry entry;
+        entry.name = path.filename().wstring();
+        entry.isReparsePoint = std::filesystem::is_symlink(status);
+        entry.isDirectory = entry.isReparsePoint ? std::filesystem::is_directory(path, error) :
+                                                   std::filesystem::is_directory(status);
+        entry.size = (!entry.isDirectory && std::filesystem::is_regular_file(status)) ?
+                     std::filesystem::file_size(path, error) : 0;
+        return entry;
+    }
+
+    /** @brief Memetakan errno ke kode Win32 yang dipakai engine */
+    static bool Fail(const std::error_code& error) {
+        if (error == std::errc::no_such_file_or_directory) LastError() = OS_ERROR_PATH_NOT_FOUND;
+        else if (error == std::errc::file_exists) LastError() = OS_ERROR_ALREADY_EXISTS;
+        else if (error == std::errc::directory_not_empty) LastError() = OS_ERROR_DIR_NOT_EMPTY;
+        else if (error == std::errc::permission_denied) LastError() = OS_ERROR_ACCESS_DENIED;
+        else LastError() = OS_ERROR_INVALID_PARAMETER;
+        return false;
+    }
+};
+
+//==============================================================================
+// FAKE REGISTRY BACKEND
+//==============================================================================
+
+/**
+ * @brief Registry palsu di memory untuk engine /regimport
+ *
+ * Key disimpan dengan nama "ROOT\path" yang huruf ASCII-nya di-fold ke
+ * lowercase (registry case-insensitive); root selalu ada. CreateKey membuat
+ * parent yang belum ada, dan handle key yang sudah dihapus gagal dengan
+ * OS_ERROR_KEY_DELETED seperti handle registry asli. Setiap panggilan
+ * dihitung dan onAccess dipanggil di awal setiap operasi (misalnya untuk
+ * memastikan worker sedang impersonating).
+ */
+class FakeRegistryBackend : public IRegistryBackend {
+public:
+    struct Value {
+        uint32_t type = 0;
+        std::vector<uint8_t> data;
+    };
+
+    std::map<std::wstring, std::map<std::wstring, Value>> keys; /**< Nama key (folded) -> nama value (folded) -> value */
+    std::set<std::wstring> deniedKeys;  /**< Nama key (folded) yang menolak open/create/delete */
+    std::function<void()> onAccess;
+    int openCalls = 0;
+    int createCalls = 0;
+    int queryCalls = 0;
+    int setCalls = 0;
+    int deleteValueCalls = 0;
+    int deleteKeyCalls = 0;
+    int closeCalls = 0;
+
+    /** @brief Nama key internal untuk root + path */
+    static std::wstring KeyName(RegistryRoot root, const std::wstring& path) {
+        std::wstring name = std::to_wstring(static_cast<int>(root));
+        if (!path.empty()) name += L"\\" + path;
+        return Fold(name);
+    }
+
+    static std::wstring Fold(std::wstring text) {
+        for (wchar_t& c : text) {
+            if (c >= L'A' && c <= L'Z') c = static_cast<wchar_t>(c - L'A' + L'a');
+        }
+        return text;
+    }
+
+    bool HasKey(RegistryRoot root, const std::wstring& path) const {
+        return Exists(KeyName(root, path));
+    }
+
+    /** @brief Value yang tersimpan, atau NULL */
+    const Value* Find(RegistryRoot root, const std::wstring& path, const std::wstring& name) const {
+        auto key = keys.find(KeyName(root, path));
+        if (key == keys.end()) return NULL;
+        auto value = key->second.find(Fold(name));
+        return value == key->second.end() ? NULL : &value->second;
+    }
+
+    /** @brief Menyiapkan value (key dan parent-nya dibuat) tanpa menghitung panggilan */
+    void Put(RegistryRoot root, const std::wstring& path, const std::wstring& name, uint32_t type,
+             const std::vector<uint8_t>& data) {
+        std::wstring key = KeyName(root, path);
+        MakeKey(key);
+        keys[key][Fold(name)] = Value{ type, data };
+    }
+
+    /** @brief Handle yang belum ditutup */
+    size_t OpenHandles() const { return handles_.size(); }
+
+    OsHandle OpenKey(RegistryRoot root, const std::wstring& path, bool writable) override {
+        if (onAccess) onAccess();
+        openCalls++;
+        std::wstring key = KeyName(root, path);
+        if (deniedKeys.count(key)) return FailHandle(OS_ERROR_ACCESS_DENIED);
+        if (!Exists(key)) return FailHandle(OS_ERROR_FILE_NOT_FOUND);
+        return NewHandle(key, writable);
+    }
+
+    OsHandle CreateKey(RegistryRoot root, const std::wstring& path, bool& created) override {
+        if (onAccess) onAccess();
+        createCalls++;
+        created = false;
+        std::wstring key = KeyName(root, path);
+        if (deniedKeys.count(key)) return FailHandle(OS_ERROR_ACCESS_DENIED);
+        created = !Exists(key);
+        MakeKey(key);
+        return NewHandle(key, true);
+    }
+
+    bool QueryValue(OsHandle handle, const std::wstring& name, uint32_t& type, std::vector<uint8_t>& data) override {
+        if (onAccess) onAccess();
+        queryCalls++;
+        auto key = ResolveHandle(handle, false);
+        if (key == keys.end()) return false;
+        auto value = key->second.find(Fold(name));
+        if (value == key->second.end()) return Fail(OS_ERROR_FILE_NOT_FOUND);
+        type = value->second.type;
+        data = value->second.data;
+        return true;
+    }
+
+    bool SetValue(OsHandle handle, const std::wstring& name, uint32_t type, const std::vector<uint8_t>& data) override {
+        if (onAccess) onAccess();
+        setCalls++;
+        auto key = ResolveHandle(handle, true);
+        if (key == keys.end()) return false;
+        key->second[Fold(name)] = Value{ type, data };
+        return true;
+    }
+
+    bool DeleteValue(OsHandle handle, const std::wstring& name) override {
+        if (onAccess) onAccess();
+        deleteValueCalls++;
+        auto key = ResolveHandle(handle, true);
+        if (key == keys.end()) return false;
+        if (!key->second.erase(Fold(name))) return Fail(OS_ERROR_FILE_NOT_FOUND);
+        return true;
+    }
+
+    bool DeleteKeyTree(RegistryRoot root, const std::wstring& path) override {
+        if (onAccess) onAccess();
+        deleteKeyCalls++;
+        std::wstring key = KeyName(root, path);
+        if (path.empty() || deniedKeys.count(key)) return Fail(OS_ERROR_ACCESS_DENIED);
+        if (!keys.count(key)) return Fail(OS_ERROR_FILE_NOT_FOUND);
+        std::wstring prefix = key + L"\\";
+        keys.erase(key);
+        for (auto it = keys.lower_bound(prefix); it != keys.end() && it->first.compare(0, prefix.size(), prefix) == 0;) {
+            it = keys.erase(it);
+        }
+        return true;
+    }
+
+    void CloseKey(OsHandle handle) override {
+        closeCalls++;
+        handles_.erase(handle);
+    }
+
+    uint32_t GetLastErrorCode() override { return lastError_; }
+
+private:
+    struct Handle {
+        std::wstring key;
+        bool writable = false;
+    };
+
+    std::map<OsHandle, Handle> handles_;
+    OsHandle nextHandle_ = 0x3000;
+    uint32_t lastError_ = 0;  /**< Engine memakai registry dari satu worker thread */
+
+    bool Exists(const std::wstring& key) const {
+        return key.find(L'\\') == std::wstring::npos || keys.count(key) != 0;
+    }
+
+    void MakeKey(const std::wstring& key) {
+        for (size_t slash = key.find(L'\\', key.find(L'\\') + 1); slash != std::wstring::npos;
+             slash = key.find(L'\\', slash + 1)) {
+            keys[key.substr(0, slash)];
+        }
+        if (key.find(L'\\') != std::wstring::npos) keys[key];
+    }
+
+    OsHandle NewHandle(const std::wstring& key, bool writable) {
+        OsHandle handle = nextHandle_++;
+        handles_[handle] = Handle{ key, writable };
+        return handle;
+    }
+
+    /** @brief Key untuk handle, atau keys.end() (lastError_ di-set) */
+    std::map<std::wstring, std::map<std::wstring, Value>>::iterator ResolveHandle(OsHandle handle, bool write) {
+        auto entry = handles_.find(handle);
+        if (entry == handles_.end()) {
+            lastError_ = OS_ERROR_INVALID_HANDLE;
+            return keys.end();
+        }
+        if (write && !entry->second.writable) {
+            lastError_ = OS_ERROR_ACCESS_DENIED;
+            return keys.end();
+        }
+        if (entry->second.key.find(L'\\') == std::wstring::npos) {
+            return keys.emplace(entry->second.key, std::map<std::wstring, Value>()).first;
+        }
+        auto key = keys.find(entry->second.key);
+        if (key == keys.end()) lastError_ = OS_ERROR_KEY_DELETED;
+        return key;
+    }
+
+    OsHandle FailHandle(uint32_t error) {
+        lastError_ = error;
+        return OS_INVALID_HANDLE;
+    }
+
+    bool Fail(uint32_t error) {
+        lastError_ = error;
+        return false;
+    }
+};
+
+//==============================================================================
+// FAKE SCRIPT HOST BACKEND
+//==============================================================================
+
+/**
+ * @brief Interpreter palsu untuk engine /scripthost
+ *
+ * Baris yang ditulis ke stdin diproses seperti cmd.exe atau powershell.exe
+ * (dipilih dari applicationName) untuk subset command yang dikirim engine:
+ * cd, (call ), call "script", echo marker, dan exit untuk cmd; satu baris
+ * "& 'script' ... [Console]::Out.Write('marker ...')" untuk PowerShell.
+ * Perilaku setiap script (output, exit code, keluar dari host, hang) diatur
+ * per canonical path.
+ */
+class FakeScriptHostBackend : public IScriptHostBackend {
+public:
+    struct Script {
+        std::string output;
+        uint32_t exitCode = 0;
+        bool exitsHost = false;   /**< "exit N" tanpa /b - host ikut keluar */
+        bool hangs = false;       /**< Tidak pernah selesai (untuk timeout) */
+    };
+
+    std::map<std::wstring, Script> scripts;
+    std::vector<ProcessLaunchRequest> starts;  /**< Request setiap StartHost */
+    std::vector<std::string> lines;            /**< Semua baris command yang diterima */
+    std::vector<std::wstring> executed;        /**< Script yang dijalankan, berurutan */
+    std::wstring lastDirectory;                /**< Direktori dari cd/Set-Location terakhir */
+    uint32_t startError = 0;                   /**< Bukan 0 = StartHost gagal dengan kode ini */
+    int closeCalls = 0;
+    int terminated = 0;                        /**< CloseHost saat host masih berjalan */
+
+    int RunningHosts() const {
+        int count = 0;
+        for (const auto& host : hosts_) count += host.second.running ? 1 : 0;
+        return count;
+    }
+
+    OsHandle StartHost(OsHandle, const ProcessLaunchRequest& request) override {
+        if (startError) {
+            lastError_ = startError;
+            return OS_INVALID_HANDLE;
+        }
+        starts.push_back(request);
+        Host host;
+        host.powershell = request.applicationName.find(L"powershell") != std::wstring::npos;
+        if (!host.powershell) {
+            host.output = "Microsoft Windows [Version 10.0]\r\n(c) Microsoft Corporation.\r\n\r\n";
+        }
+        OsHandle handle = nextHandle_++;
+        hosts_[handle] = host;
+        return handle;
+    }
+
+    bool WriteHostInput(OsHandle handle, const std::string& data) override {
+        Host& host = hosts_.at(handle);
+        if (!host.running) {
+            lastError_ = OS_ERROR_BROKEN_PIPE;
+            return false;
+        }
+        host.input += data;
+        size_t end;
+        while (host.running && !host.hung && (end = host.input.find('\n')) != std::string::npos) {
+            std::string line = host.input.substr(0, end);
+            host.input.erase(0, end + 1);
+            if (!line.empty() && line.back() == '\r') line.pop_back();
+            lines.push_back(line);
+            if (host.powershell) {
+                RunPowerShellLine(host, line);
+            } else {
+                RunCmdLine(host, line);
+            }
+        }
+        return true;
+    }
+
+    bool ReadHostOutput(OsHandle handle, uint32_t timeoutMs, std::string& data) override {
+        Host& host = hosts_.at(handle);
+        if (!host.output.empty()) {
+            data += host.output;
+            host.output.clear();
+            return true;
+        }
+        if (!host.running) {
+            lastError_ = OS_ERROR_BROKEN_PIPE;
+            return false;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(std::min<uint32_t>(timeoutMs, 2)));
+        lastError_ = OS_ERROR_WAIT_TIMEOUT;
+        return false;
+    }
+
+    bool WaitHostExit(OsHandle handle, uint32_t, uint32_t& exitCode) override {
+        Host& host = hosts_.at(handle);
+        if (host.running) {
+            lastError_ = OS_ERROR_WAIT_TIMEOUT;
+            return false;
+        }
+        exitCode = host.exitCode;
+        return true;
+    }
+
+    void CloseHost(OsHandle handle) override {
+        if (handle == OS_INVALID_HANDLE) return;
+        closeCalls++;
+        if (hosts_.at(handle).running) terminated++;
+        hosts_.erase(handle);
+    }
+
+    uint32_t GetLastErrorCode() override { return lastError_; }
+
+private:
+    struct Host {
+        bool powershell = false;
+        bool running = true;
+        bool hung = false;
+        uint32_t exitCode = 0;
+        uint32_t errorLevel = 0;
+        std::string input;
+        std::string output;
+    };
+
+    std::map<OsHandle, Host> hosts_;
+    OsHandle nextHandle_ = 1;
+    uint32_t lastError_ = 0;
+
+    static bool StartsWith(const std::string& text, const char* prefix) {
+        return text.compare(0, strlen(prefix), prefix) == 0;
+    }
+
+    void RunScript(Host& host, const std::string& pathUtf8) {
+        std::wstring path;
+        DecodeUtf8(pathUtf8, path);
+        executed.push_back(path);
+        const Script& script = scripts[path];
+        host.output += script.output;
+        host.errorLevel = script.exitCode;
+        if (script.hangs) {
+            host.hung = true;
+        } else if (script.exitsHost) {
+            host.running = false;
+            host.exitCode = script.exitCode;
+        }
+    }
+
+    void RunCmdLine(Host& host, const std::string& line) {
+        if (StartsWith(line, "@cd /d \"")) {
+            DecodeUtf8(line.substr(8, line.size() - 9), lastDirectory);
+        } else if (line == "@(call )") {
+            host.errorLevel = 0;
+        } else if (StartsWith(line, "@call \"")) {
+            RunScript(host, line.substr(7, line.find('"', 7) - 7));
+        } else if (StartsWith(line, "@echo ")) {
+            std::string text = line.substr(6);
+            size_t variable = text.find("%ERRORLEVEL%");
+            if (variable != std::string::npos) {
+                text.replace(variable, 12, std::to_string(host.errorLevel));
+            }
+            host.output += text + "\r\n";
+        } else if (line == "exit") {
+            host.running = false;
+        }
+    }
+
+    /** @brief Literal berkutip tunggal mulai dari posisi kutip pembuka */
+    static std::string ReadLiteral(const std::string& line, size_t quote) {
+        std::string text;
+        for (size_t i = quote + 1; i < line.size(); i++) {
+            if (line[i] == '\'') {
+                if (i + 1 < line.size() && line[i + 1] == '\'') {
+                    text += '\'';
+                    i++;
+                    continue;
+                }
+                break;
+            }
+            text += line[i];
+        }
+        return text;
+    }
+
+    void RunPowerShellLine(Host& host, const std::string& line) {
+        if (line == "exit") {
+            host.running = false;
+            return;
+        }
+        size_t location = line.find("Set-Location -LiteralPath '");
+        if (location != std::string::npos) {
+            DecodeUtf8(ReadLiteral(line, line.find('\'', location)), lastDirectory);
+        }
+        host.errorLevel = 0;
+        size_t call = line.find("& '");
+        if (call != std::string::npos) {
+            RunScript(host, ReadLiteral(line, call + 2));
+            if (!host.running || host.hung) return;
+        }
+        size_t write = line.find("[Console]::Out.Write('");
+        if (write != std::string::npos) {
+            host.output += ReadLiteral(line, write + 21) + std::to_string(host.errorLevel) + "\n";
+        }
+    }
+};
+
+//==============================================================================
+// FAKE OUTPUT CAPTURE BACKEND
+//==============================================================================
+
+/**
+ * @brief Proses palsu dengan pipe untuk engine /capture dan /batch
+ *
+ * Perilaku setiap program (chunk output, exit code, hang, pipe yang
+ * dipegang turunan) diatur per canonical path (argv[0] di command line).
+ * WaitCaptureEvent melayani proses secara round-robin sehingga output
+ * beberapa proses saling menyela seperti di completion port. Data OUTPUT
+ * menunjuk ke string milik backend (lastData) untuk memeriksa bahwa engine
+ * tidak menyalin chunk. Log file disimpan di map files.
+ */
+class FakeOutputCaptureBackend : public IOutputCaptureBackend {
+public:
+    struct Program {
+        std::vector<std::pair<CaptureStream, std::string>> chunks;
+        uint32_t exitCode = 0;
+        bool hangs = false;           /**< Tidak pernah keluar (untuk timeout) */
+        bool holdsPipe = false;       /**< Proses turunan tetap memegang pipe setelah exit */
+        bool notifyExit = true;       /**< false = tanpa notifikasi job (exit dicek langsung) */
+        std::chrono::milliseconds runtime{0}; /**< Pipe ditutup dan proses keluar setelah durasi ini */
+        unsigned hangAfterStarts = 0; /**< Bukan 0 = start ke-N dan seterusnya tidak pernah keluar */
+        ProcessAccounting accounting; /**< Hasil QueryCapturedAccounting setelah exit */
+    };
+
+    std::map<std::wstring, Program> programs;
+    std::map<std::wstring, unsigned> startCounts; /**< StartCapturedProcess per program */
+    std::vector<ProcessLaunchRequest> starts;  /**< Request setiap StartCapturedProcess */
+    uint32_t startError = 0;                   /**< Bukan 0 = StartCapturedProcess gagal dengan kode ini */
+    uint32_t logError = 0;                     /**< Bukan 0 = CreateLogFile gagal dengan kode ini */
+    size_t peakRunning = 0;
+    int closeCalls = 0;
+    int terminated = 0;                        /**< CloseCapturedProcess saat proses masih berjalan */
+    int openPorts = 0;
+    const char* lastData = nullptr;            /**< Buffer event OUTPUT terakhir */
+    int accountingQueries = 0;
+    uint32_t accountingError = 0;              /**< Bukan 0 = QueryCapturedAccounting gagal dengan kode ini */
+    std::map<std::wstring, std::string> files;
+    std::vector<std::pair<std::wstring, std::wstring>> renames;
+
+    OsHandle CreateCapturePort() override {
+        openPorts++;
+        return 1;
+    }
+
+    OsHandle StartCapturedProcess(OsHandle, OsHandle, const ProcessLaunchRequest& request, uint32_t& processId) override {
+        if (startError) {
+            lastError_ = startError;
+            return OS_INVALID_HANDLE;
+        }
+        starts.push_back(request);
+        size_t end = request.commandLine.find(L'"', 1);
+        std::wstring path = request.commandLine.substr(1, end - 1);
+        unsigned count = ++startCounts[path];
+        Process process;
+        process.program = programs[path];
+        process.program.hangs = process.program.hangs ||
+                                (process.program.hangAfterStarts != 0 && count >= process.program.hangAfterStarts);
+        process.exitAt = std::chrono::steady_clock::now() + process.program.runtime;
+        for (size_t i = 0; i < process.program.chunks.size(); i++) {
+            process.events.push_back(static_cast<int>(i));
+        }
+        if (!process.program.hangs) {
+            if (!process.program.holdsPipe) {
+                process.events.push_back(EVENT_END_STDOUT);
+                process.events.push_back(EVENT_END_STDERR);
+            }
+            process.events.push_back(EVENT_EXIT);
+        }
+        OsHandle handle = nextHandle_++;
+        processes_[handle] = process;
+        order_.push_back(handle);
+        processId = static_cast<uint32_t>(1000 + handle);
+        peakRunning = std::max(peakRunning, RunningProcesses());
+        return handle;
+    }
+
+    bool WaitCaptureEvent(OsHandle port, uint32_t timeoutMs, CaptureEvent& event) override {
+        for (size_t n = 0; n < order_.size(); n++) {
+            OsHandle handle = order_[(cursor_ + n) % order_.size()];
+            Process& process = processes_.at(handle);
+            if (process.events.empty()) continue;
+            if (process.events.front() < 0 && std::chrono::steady_clock::now() < process.exitAt) continue;
+
+            cursor_ = (cursor_ + n + 1) % order_.size();
+            int next = process.events.front();
+            process.events.erase(process.events.begin());
+            event = CaptureEvent();
+            event.process = handle;
+            if (next == EVENT_EXIT) {
+                process.exited = true;
+                if (!process.program.notifyExit) return WaitCaptureEvent(port, timeoutMs, event);
+                event.type = CAPTURE_EVENT_EXITED;
+            } else if (next == EVENT_END_STDOUT || next == EVENT_END_STDERR) {
+                event.type = CAPTURE_EVENT_END_OF_STREAM;
+                event.stream = next == EVENT_END_STDOUT ? CAPTURE_STREAM_STDOUT : CAPTURE_STREAM_STDERR;
+            } else {
+                const std::pair<CaptureStream, std::string>& chunk = process.program.chunks[next];
+                event.type = CAPTURE_EVENT_OUTPUT;
+                event.stream = chunk.first;
+                event.data = chunk.second.data();
+                event.size = chunk.second.size();
+                lastData = event.data;
+            }
+            return true;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(std::min<uint32_t>(timeoutMs, 2)));
+        lastError_ = OS_ERROR_WAIT_TIMEOUT;
+        return false;
+    }
+
+    bool QueryCapturedExit(OsHandle handle, uint32_t& exitCode) override {
+        Process& process = processes_.at(handle);
+        if (!process.exited) {
+            lastError_ = OS_ERROR_WAIT_TIMEOUT;
+            return false;
+        }
+        exitCode = process.program.exitCode;
+        return true;
+    }
+
+    bool QueryCapturedAccounting(OsHandle handle, ProcessAccounting& accounting) override {
+        accountingQueries++;
+        if (accountingError) {
+            lastError_ = accountingError;
+            return false;
+        }
+        accounting = processes_.at(handle).program.accounting;
+        return true;
+    }
+
+    void CloseCapturedProcess(OsHandle handle) override {
+        if (handle == OS_INVALID_HANDLE) return;
+        closeCalls++;
+        if (!processes_.at(handle).exited) terminated++;
+        processes_.erase(handle);
+        order_.erase(std::find(order_.begin(), order_.end(), handle));
+        cursor_ = order_.empty() ? 0 : cursor_ % order_.size();
+    }
+
+    void CloseCapturePort(OsHandle port) override {
+        if (port != OS_INVALID_HANDLE) openPorts--;
+    }
+
+    OsHandle CreateLogFile(const std::wstring& path) override {
+        if (logError) {
+            lastError_ = logError;
+            return OS_INVALID_HANDLE;
+        }
+        files[path].clear();
+        OsHandle handle = nextHandle_++;
+        logs_[handle] = path;
+        return handle;
+    }
+
+    bool WriteLogFile(OsHandle file, const char* data, size_t size) override {
+        files[logs_.at(file)].append(data, size);
+        return true;
+    }
+
+    void CloseLogFile(OsHandle file) override {
+        logs_.erase(file);
+    }
+
+    bool RenameLogFile(const std::wstring& source, const std::wstring& destination) override {
+        auto it = files.find(source);
+        if (it == files.end()) {
+            lastError_ = OS_ERROR_FILE_NOT_FOUND;
+            return false;
+        }
+        renames.emplace_back(source, destination);
+        files[destination] = it->second;
+        files.erase(source);
+        return true;
+    }
+
+    uint32_t GetLastErrorCode() override { return lastError_; }
+
+    size_t RunningProcesses() const {
+        size_t count = 0;
+        for (const auto& process : processes_) count += process.second.exited ? 0 : 1;
+        return count;
+    }
+
+    size_t OpenLogFiles() const { return logs_.size(); }
+
+private:
+    enum { EVENT_END_STDOUT = -1, EVENT_END_STDERR = -2, EVENT_EXIT = -3 };
+
+    struct Process {
+        Program program;
+        std::vector<int> events;  /**< Indeks chunk atau EVENT_* berurutan */
+        bool exited = false;
+        std::chrono::steady_clock::time_point exitAt; /**< EVENT_* ditahan sampai runtime habis */
+    };
+
+    std::map<OsHandle, Process> processes_;
+    std::vector<OsHandle> order_;
+    size_t cursor_ = 0;
+    std::map<OsHandle, std::wstring> logs_;
+    OsHandle nextHandle_ = 1;
+    uint32_t lastError_ = 0;
+};
+
+//==============================================================================
+// PORTABLE TESTS (PortableTests.cpp)
+//==============================================================================
+
+/*
+ * Test yang hanya memakai backend palsu. Dijalankan oleh Test.cpp di Windows
+ * dan oleh PortableMain.cpp (ctest) di Linux.
+ */
+bool TestValidationSyscallCount();
+bool TestLongPathValidation();
+bool TestSha256KnownVectors();
+bool TestHashAllowlistValidation();
+bool TestHashCacheBenchmark();
+bool TestPathPolicyEngine();
+bool TestPathPolicyBenchmark();
+bool TestBulkValidationOutput();
+bool TestBulkValidationThroughput();
+bool TestWorkStealingScheduler();
+bool TestFileOperations();
+bool TestAclReset();
+bool TestRegistryImport();
+bool TestScriptHost();
+bool TestOutputCapture();
+bool TestTrustedInstallerAcquisition();
+bool TestRunAsTrustedInstaller();
+bool TestCApi();
+bool TestMicrobenchmarkBaseline();
+bool TestLaunchBenchmark();
+bool TestConsoleModeLaunch();
+bool TestLaunchApiSelection();
+bool TestBackendTraceReplay();
+bool TestLaunchPipeline();
+bool TestLaunchGraph();
+bool TestSupervisor();
+bool TestProcessAdjust();
+bool TestSessionLaunch();
+bool TestSingleInstance();
+bool TestCaptureAccounting();
+
+#endif
@@ -0,0 +1,197 @@
+/**
+ * @file TraceReplayMain.cpp
+ * @brief Replay trace backend (RasTI.exe /trace:FILE) di Linux
+ *
+ * Membaca trace biner, mencetak ringkasan per jenis panggilan, lalu
+ * menjalankan ulang operasi yang direkam (launch CLI atau /bench:N) di atas
+ * TraceReplayBackend. Setiap panggilan dijawab dengan hasil dan durasi dari
+ * mesin asal, sehingga waktu total dan urutan akuisisi dapat dibandingkan
+ * sebelum dan sesudah optimasi tanpa akses ke mesin tersebut.
+ *
+ * Usage:
+ *   rasti_trace_replay TRACE [--repeat=N] [--speed=X] [--summary]
+ *
+ *   --repeat=N  Jumlah replay (default 1)
+ *   --speed=X   Faktor kecepatan latency (default 1; 0 = tanpa menunggu)
+ *   --summary   Hanya cetak ringkasan trace, tanpa replay
+ *
+ * Exit code 0 jika setiap panggilan dalam setiap replay mendapat pasangan
+ * di trace, 1 jika ada panggilan unmatched atau operasi gagal, 2 jika
+ * argumen atau file trace tidak valid.
+ *
+ * @author RasTI Development Team
+ * @version 1.2.0.0
+ * @date 2025
+ */
+
+#include "BackendTrace.h"
+#include "HashAllowlist.h"
+#include "LaunchBenchmark.h"
+#include "LaunchPipeline.h"
+#include "TrustedInstaller.h"
+#include "Validation.h"
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+/** @brief Nilai argumen "--key=value" jika arg diawali prefix */
+static bool ReadOption(const std::string& arg, const char* prefix, std::string& value)
+{
+    std::string key(prefix);
+    if (arg.compare(0, key.size(), key) != 0) {
+        return false;
+    }
+    value = arg.substr(key.size());
+    return true;
+}
+
+/** @brief Wide string ASCII/UTF-8 untuk output console */
+static std::string Narrow(const std::wstring& text)
+{
+    std::string narrow;
+    for (wchar_t ch : text) {
+        narrow += (ch >= 0x20 && ch < 0x7F) ? static_cast<char>(ch) : '?';
+    }
+    return narrow;
+}
+
+/**
+ * @brief Menjalankan operasi session di atas backend aktif
+ *
+ * @return true jika operasi berhasil seperti di mesin asal
+ */
+static bool RunSession(const BackendTraceSession& session, std::string& output)
+{
+    if (session.operation == L"bench") {
+        LaunchBenchmarkOptions options;
+        options.targetPath = session.target;
+        options.arguments = session.arguments;
+        options.iterations = session.iterations;
+        options.priority = session.priority;
+        options.console = static_cast<ConsoleMode>(session.console);
+        options.launchApi = static_cast<ProcessLaunchApi>(session.launchApi);
+
+        LaunchBenchmarkReport report;
+        bool success = RunLaunchBenchmark(options, report);
+        output = FormatLaunchBenchmarkReport(report);
+        return success;
+    }
+
+    // "launch": validasi + launch satu kali seperti RasTI.exe "path"
+    std::wstring path = session.target;
+    ValidatedExecutable validated;
+    ValidationError validation = SanitizePath(path) ? ValidateExecutable(path, validated) : VALIDATION_UNSAFE_PATH;
+    if (validation != VALIDATION_OK) {
+        output = std::string("validation failed: ") + GetValidationErrorName(validation) + "\n";
+        return false;
+    }
+    LaunchStageSettings settings;
+    settings.affinityMask = session.affinityMask;
+    settings.ioPriority = session.ioPriority;
+    settings.memoryPriority = session.memoryPriority;
+    settings.jobMemoryLimit = session.jobMemoryLimit;
+    LaunchPipeline pipeline;
+    ConfigureLaunchPipeline(settings, pipeline);
+    if (!LaunchValidatedExecutable(validated, session.priority, static_cast<ConsoleMode>(session.console),
+                                   static_cast<ProcessLaunchApi>(session.launchApi), NULL, &pipeline)) {
+        std::ostringstream text;
+        text << "launch failed (error " << GetProcessBackend()->GetLastErrorCode() << ")\n";
+        output = text.str();
+        return false;
+    }
+    output = "launched\n";
+    return true;
+}
+
+int main(int argc, char* argv[]) {
+    std::string tracePath;
+    int repeat = 1;
+    double speed = 1.0;
+    bool summaryOnly = false;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        std::string value;
+        bool valid = true;
+        if (ReadOption(arg, "--repeat=", value)) {
+            repeat = atoi(value.c_str());
+            valid = repeat >= 1 && repeat <= 100000;
+        } else if (ReadOption(arg, "--speed=", value)) {
+            char* end = NULL;
+            speed = strtod(value.c_str(), &end);
+            valid = !value.empty() && *end == '\0' && speed >= 0.0;
+        } else if (arg == "--summary") {
+            summaryOnly = true;
+        } else if (tracePath.empty() && arg.compare(0, 2, "--") != 0) {
+            tracePath = arg;
+        } else {
+            valid = false;
+        }
+
+        if (!valid) {
+            std::cerr << "Invalid option: " << arg << std::endl;
+            tracePath.clear();
+            break;
+        }
+    }
+    if (tracePath.empty()) {
+        std::cerr << "Usage: rasti_trace_replay TRACE [--repeat=N] [--speed=X] [--summary]" << std::endl;
+        return 2;
+    }
+
+    std::ifstream file(tracePath.c_str(), std::ios::binary);
+    std::stringstream contents;
+    contents << file.rdbuf();
+    BackendTrace trace;
+    size_t errorOffset = 0;
+    if (!file || !trace.Load(contents.str(), &errorOffset)) {
+        std::cerr << "Invalid trace file: " << tracePath << " (offset " << errorOffset << ")" << std::endl;
+        return 2;
+    }
+
+    std::cout << "Trace: " << Narrow(trace.session.operation) << " " << Narrow(trace.session.target);
+    if (trace.session.operation == L"bench") {
+        std::cout << " (" << trace.session.iterations << " cycles)";
+    }
+    std::cout << std::endl << FormatBackendTraceSummary(trace);
+    if (summaryOnly) {
+        return 0;
+    }
+    if (trace.session.operation != L"launch" && trace.session.operation != L"bench") {
+        std::cerr << "Unsupported operation in trace" << std::endl;
+        return 2;
+    }
+
+    // Kecepatan 2 = latency setengahnya
+    TraceReplayBackend replay(trace, speed > 0.0 ? 1.0 / speed : 0.0);
+    SetFileSystemBackend(&replay);
+    SetProcessBackend(&replay);
+
+    bool clean = true;
+    for (int run = 1; run <= repeat; run++) {
+        replay.Rewind();
+        GetFileHashCache().Clear();
+
+        std::string output;
+        auto start = std::chrono::steady_clock::now();
+        bool success = RunSession(trace.session, output);
+        double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        BackendReplayStats stats = replay.GetStats();
+
+        if (run == 1) {
+            std::cout << std::endl << output;
+        }
+        std::cout << "replay " << run << ": " << std::fixed << std::setprecision(3) << ms << " ms"
+                  << " (recorded backend time " << stats.replayedNs / 1e6 << " ms), "
+                  << stats.matched << " matched, " << stats.unmatched << " unmatched, "
+                  << stats.unconsumed << " unconsumed" << (success ? "" : ", FAILED") << std::endl;
+        clean = clean && success && stats.unmatched == 0;
+    }
+
+    SetProcessBackend(NULL);
+    SetFileSystemBackend(NULL);
+    return clean ? 0 : 1;
+}